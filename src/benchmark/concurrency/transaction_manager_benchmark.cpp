@@ -0,0 +1,72 @@
+#include "benchmark/benchmark.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+/**
+ * Begins and commits empty transactions. When run with multiple threads, this shows how well registering and
+ * deregistering snapshot commit ids in the TransactionManager scales.
+ */
+static void BM_TransactionBeginCommit(benchmark::State& state) {  // NOLINT
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  for (auto _ : state) {
+    const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+    transaction_context->commit();
+  }
+}
+BENCHMARK(BM_TransactionBeginCommit)->ThreadRange(1, 32)->UseRealTime();
+
+/**
+ * Begins and ends read-only transactions while the lowest active snapshot commit id is queried every 64th iteration,
+ * as the MvccDeletePlugin does in the background.
+ */
+static void BM_TransactionBeginWithLowestSnapshotQuery(benchmark::State& state) {  // NOLINT
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  auto iteration = size_t{0};
+  for (auto _ : state) {
+    if (iteration++ % 64 == 0) {
+      benchmark::DoNotOptimize(transaction_manager.get_lowest_active_snapshot_commit_id());
+    }
+    const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+    benchmark::DoNotOptimize(transaction_context->snapshot_commit_id());
+  }
+}
+BENCHMARK(BM_TransactionBeginWithLowestSnapshotQuery)->ThreadRange(1, 32)->UseRealTime();
+
+/**
+ * Inserts a single row per transaction. When run with multiple threads, transactions that become ready to commit
+ * while another commit is in progress are committed as a group.
+ */
+static void BM_TransactionInsertCommit(benchmark::State& state) {  // NOLINT
+  static const auto table_name = std::string{"transaction_benchmark_table"};
+  static const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}};
+  [[maybe_unused]] static const auto table_created = []() {
+    Hyrise::get().storage_manager.add_table(
+        table_name, std::make_shared<Table>(column_definitions, TableType::Data, Chunk::DEFAULT_SIZE, UseMvcc::Yes));
+    return true;
+  }();
+
+  const auto values = std::make_shared<Table>(column_definitions, TableType::Data);
+  values->append({1});
+  const auto table_wrapper = std::make_shared<TableWrapper>(values);
+  table_wrapper->execute();
+
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  for (auto _ : state) {
+    const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+    const auto insert = std::make_shared<Insert>(table_name, table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+    transaction_context->commit();
+  }
+}
+BENCHMARK(BM_TransactionInsertCommit)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace opossum
@@ -0,0 +1,52 @@
+#include <fstream>
+#include <iostream>
+
+#include <boost/algorithm/string.hpp>
+#include <cxxopts.hpp>
+
+#include "cost_model_calibration.hpp"
+#include "types.hpp"
+
+/**
+ * Calibrates the coefficients of the physical cost model (see CostEstimatorPhysical) on this machine and writes them
+ * to a JSON file. Benchmarks load the file with --cost_model so that the LQPTranslator chooses the physical operators
+ * by their estimated cost.
+ */
+
+using namespace opossum;  // NOLINT
+
+int main(int argc, char* argv[]) {
+  auto cli_options = cxxopts::Options{"Hyrise Cost Model Calibration"};
+
+  // clang-format off
+  cli_options.add_options()
+    ("help", "print a summary of CLI options")
+    ("o,output", "JSON file to write the calibrated coefficients to", cxxopts::value<std::string>()->default_value("cost_model.json")) // NOLINT
+    ("row_counts", "Comma-separated sizes of the generated tables", cxxopts::value<std::string>()->default_value("10000,100000,1000000")) // NOLINT
+    ("r,repetitions", "Executions per measurement, of which the fastest one is used", cxxopts::value<size_t>()->default_value("3")); // NOLINT
+  // clang-format on
+
+  const auto cli_parse_result = cli_options.parse(argc, argv);
+  if (cli_parse_result.count("help")) {
+    std::cout << cli_options.help() << std::endl;
+    return 0;
+  }
+
+  auto row_count_strings = std::vector<std::string>{};
+  boost::algorithm::split(row_count_strings, cli_parse_result["row_counts"].as<std::string>(),
+                          boost::is_any_of(","));
+  auto row_counts = std::vector<size_t>{};
+  for (const auto& row_count_string : row_count_strings) {
+    row_counts.emplace_back(std::stoull(row_count_string));
+  }
+
+  auto calibration = CostModelCalibration{row_counts, cli_parse_result["repetitions"].as<size_t>()};
+  const auto coefficients = calibration.run();
+
+  const auto output_path = cli_parse_result["output"].as<std::string>();
+  auto output_file = std::ofstream{output_path};
+  output_file << coefficients.to_json().dump(2) << std::endl;
+  std::cout << "- Wrote cost model coefficients to " << output_path << std::endl;
+
+  return 0;
+}
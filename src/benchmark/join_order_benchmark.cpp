@@ -1,13 +1,16 @@
+#include <algorithm>
 #include <filesystem>
 
 #include <boost/algorithm/string.hpp>
 #include <cxxopts.hpp>
 
 #include "benchmark_runner.hpp"
+#include "cardinality_estimation_evaluation.hpp"
 #include "cli_config_parser.hpp"
 #include "file_based_benchmark_item_runner.hpp"
 #include "file_based_table_generator.hpp"
 #include "hyrise.hpp"
+#include "storage/table.hpp"
 #include "types.hpp"
 #include "utils/performance_warning.hpp"
 #include "utils/sqlite_add_indices.hpp"
@@ -21,6 +24,30 @@
 using namespace opossum;               // NOLINT
 using namespace std::string_literals;  // NOLINT
 
+namespace {
+
+/**
+ * Every table of the IMDB schema has the primary key "id" (see schema.sql). Declaring it lets the CardinalityEstimator
+ * recognize the joins of foreign keys with it, of which most joins of the JOB consist.
+ */
+class JoinOrderBenchmarkTableGenerator : public FileBasedTableGenerator {
+ public:
+  using FileBasedTableGenerator::FileBasedTableGenerator;
+
+ protected:
+  void _add_constraints(std::unordered_map<std::string, BenchmarkTableInfo>& table_info_by_name) const override {
+    for (const auto& [table_name, table_info] : table_info_by_name) {
+      const auto& table = table_info.table;
+      const auto column_names = table->column_names();
+      if (std::find(column_names.begin(), column_names.end(), "id") == column_names.end()) continue;
+
+      table->add_soft_unique_constraint({table->column_id_by_name("id")}, IsPrimaryKey::Yes);
+    }
+  }
+};
+
+}  // namespace
+
 int main(int argc, char* argv[]) {
   auto cli_options = BenchmarkRunner::get_basic_cli_options("Hyrise Join Order Benchmark");
 
@@ -31,7 +58,10 @@ int main(int argc, char* argv[]) {
   cli_options.add_options()
   ("table_path", "Directory containing the Tables as csv, tbl or binary files. CSV files require meta-files, see csv_meta.hpp or any *.csv.json file.", cxxopts::value<std::string>()->default_value(DEFAULT_TABLE_PATH)) // NOLINT
   ("query_path", "Directory containing the .sql files of the Join Order Benchmark", cxxopts::value<std::string>()->default_value(DEFAULT_QUERY_PATH)) // NOLINT
-  ("q,queries", "Subset of queries to run as a comma separated list", cxxopts::value<std::string>()->default_value("all")); // NOLINT
+  ("q,queries", "Subset of queries to run as a comma separated list", cxxopts::value<std::string>()->default_value("all")) // NOLINT
+  ("join_sampling", "Estimate the cardinalities of joins in large join graphs by executing them on a sample", cxxopts::value<bool>()->default_value("false")) // NOLINT
+  ("column_pair_statistics", "Add statistics on the column pairs that the queries filter on together", cxxopts::value<bool>()->default_value("false")) // NOLINT
+  ("cardinality_estimation_errors", "Report the q-errors of the cardinality estimates after running the benchmark", cxxopts::value<bool>()->default_value("true")); // NOLINT
   // clang-format on
 
   std::shared_ptr<BenchmarkConfig> benchmark_config;
@@ -92,7 +122,7 @@ int main(int argc, char* argv[]) {
 
   // Run the benchmark
   auto context = BenchmarkRunner::create_context(*benchmark_config);
-  auto table_generator = std::make_unique<FileBasedTableGenerator>(benchmark_config, table_path);
+  auto table_generator = std::make_unique<JoinOrderBenchmarkTableGenerator>(benchmark_config, table_path);
   auto benchmark_item_runner =
       std::make_unique<FileBasedBenchmarkItemRunner>(benchmark_config, query_path, non_query_file_names, query_subset);
 
@@ -101,6 +131,16 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  if (cli_parse_result["join_sampling"].as<bool>()) {
+    std::cout << "- Estimating join cardinalities with join sampling" << std::endl;
+    benchmark_item_runner->set_join_sampling_config(JoinSamplingConfig{});
+  }
+
+  auto named_queries = std::vector<std::pair<std::string, std::string>>{};
+  for (const auto item_id : benchmark_item_runner->items()) {
+    named_queries.emplace_back(benchmark_item_runner->item_name(item_id), benchmark_item_runner->item_sql(item_id));
+  }
+
   auto benchmark_runner = std::make_shared<BenchmarkRunner>(*benchmark_config, std::move(benchmark_item_runner),
                                                             std::move(table_generator), context);
   Hyrise::get().benchmark_runner = benchmark_runner;
@@ -109,7 +149,21 @@ int main(int argc, char* argv[]) {
     add_indices_to_sqlite(query_path + "/schema.sql", query_path + "/fkindexes.sql", benchmark_runner->sqlite_wrapper);
   }
 
+  // The tables have been loaded by the BenchmarkRunner
+  if (cli_parse_result["column_pair_statistics"].as<bool>()) {
+    std::cout << "- Adding column pair statistics" << std::endl;
+    auto queries = std::vector<std::string>{};
+    for (const auto& [name, sql] : named_queries) {
+      queries.emplace_back(sql);
+    }
+    add_column_pair_statistics_for_queries(queries);
+  }
+
   std::cout << "done." << std::endl;
 
   benchmark_runner->run();
+
+  if (cli_parse_result["cardinality_estimation_errors"].as<bool>()) {
+    report_cardinality_estimation_errors(named_queries, std::cout);
+  }
 }
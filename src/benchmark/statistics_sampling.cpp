@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include <cxxopts.hpp>
+
+#include "benchmark_config.hpp"
+#include "file_based_table_generator.hpp"
+#include "resolve_type.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+#include "tpch/tpch_table_generator.hpp"
+#include "types.hpp"
+
+/**
+ * Reports the estimation error of statistics built from a sample (see TableStatistics::from_table) against statistics
+ * built from the full tables, together with the time it takes to build them. The tables are either generated TPC-H
+ * tables or loaded from a directory, e.g., the data of the Join Order Benchmark.
+ *
+ * For each column, two errors are reported as q-errors, i.e., max(estimate / actual, actual / estimate):
+ *   - the error of the distinct count, and
+ *   - the mean error of the cardinality estimated for `column <= x`, where x takes the bin maxima of the full
+ *     histogram.
+ */
+
+using namespace opossum;  // NOLINT
+
+namespace {
+
+double q_error(const double estimate, const double actual) {
+  const auto clamped_estimate = std::max(estimate, 1.0);
+  const auto clamped_actual = std::max(actual, 1.0);
+  return std::max(clamped_estimate / clamped_actual, clamped_actual / clamped_estimate);
+}
+
+template <typename T>
+std::shared_ptr<AbstractHistogram<T>> column_histogram(const TableStatistics& table_statistics,
+                                                       const ColumnID column_id) {
+  const auto attribute_statistics =
+      std::dynamic_pointer_cast<AttributeStatistics<T>>(table_statistics.column_statistics[column_id]);
+  return std::dynamic_pointer_cast<AbstractHistogram<T>>(attribute_statistics->histogram);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto cli_options = cxxopts::Options{"Hyrise Statistics Sampling Evaluation"};
+
+  // clang-format off
+  cli_options.add_options()
+    ("help", "print a summary of CLI options")
+    ("s,scale", "TPC-H scale factor", cxxopts::value<float>()->default_value("1")) // NOLINT
+    ("table_path", "Load the tables from this directory (e.g., the JOB data) instead of generating TPC-H", cxxopts::value<std::string>()->default_value("")) // NOLINT
+    ("sample_row_count", "Number of rows sampled per table", cxxopts::value<size_t>()->default_value(std::to_string(DEFAULT_STATISTICS_SAMPLE_ROW_COUNT))); // NOLINT
+  // clang-format on
+
+  const auto cli_parse_result = cli_options.parse(argc, argv);
+  if (cli_parse_result.count("help")) {
+    std::cout << cli_options.help() << std::endl;
+    return 0;
+  }
+
+  const auto table_path = cli_parse_result["table_path"].as<std::string>();
+  const auto sample_row_count = cli_parse_result["sample_row_count"].as<size_t>();
+
+  std::cout << "- Loading tables" << std::endl;
+  auto table_info_by_name = std::unordered_map<std::string, BenchmarkTableInfo>{};
+  if (table_path.empty()) {
+    table_info_by_name = TPCHTableGenerator{cli_parse_result["scale"].as<float>()}.generate();
+  } else {
+    const auto config = std::make_shared<BenchmarkConfig>(BenchmarkConfig::get_default_config());
+    table_info_by_name = FileBasedTableGenerator{config, table_path}.generate();
+  }
+
+  std::cout << std::left << std::setw(40) << "Column" << std::right << std::setw(12) << "Full [ms]" << std::setw(12)
+            << "Sample [ms]" << std::setw(16) << "Distinct q-err" << std::setw(16) << "Range q-err" << std::endl;
+
+  auto max_distinct_q_error = 1.0;
+  auto max_range_q_error = 1.0;
+
+  for (const auto& [table_name, table_info] : table_info_by_name) {
+    const auto& table = *table_info.table;
+
+    const auto full_begin = std::chrono::steady_clock::now();
+    const auto full_statistics = TableStatistics::from_table(table, std::numeric_limits<size_t>::max());
+    const auto full_end = std::chrono::steady_clock::now();
+    const auto sampled_statistics = TableStatistics::from_table(table, sample_row_count);
+    const auto sampled_end = std::chrono::steady_clock::now();
+
+    std::cout << std::left << std::setw(40) << table_name << std::right << std::setw(12)
+              << std::chrono::duration_cast<std::chrono::milliseconds>(full_end - full_begin).count() << std::setw(12)
+              << std::chrono::duration_cast<std::chrono::milliseconds>(sampled_end - full_end).count() << std::endl;
+
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        const auto full_histogram = column_histogram<ColumnDataType>(*full_statistics, column_id);
+        const auto sampled_histogram = column_histogram<ColumnDataType>(*sampled_statistics, column_id);
+        if (!full_histogram || !sampled_histogram) return;
+
+        const auto distinct_q_error =
+            q_error(sampled_histogram->total_distinct_count(), full_histogram->total_distinct_count());
+
+        auto range_q_error_sum = 0.0;
+        for (auto bin_id = BinID{0}; bin_id < full_histogram->bin_count(); ++bin_id) {
+          const auto value = AllTypeVariant{full_histogram->bin_maximum(bin_id)};
+          range_q_error_sum +=
+              q_error(sampled_histogram->estimate_cardinality(PredicateCondition::LessThanEquals, value),
+                      full_histogram->estimate_cardinality(PredicateCondition::LessThanEquals, value));
+        }
+        const auto range_q_error = range_q_error_sum / static_cast<double>(full_histogram->bin_count());
+
+        max_distinct_q_error = std::max(max_distinct_q_error, distinct_q_error);
+        max_range_q_error = std::max(max_range_q_error, range_q_error);
+
+        std::cout << "  " << std::left << std::setw(38) << table.column_name(column_id) << std::right << std::setw(24)
+                  << "" << std::setw(16) << std::setprecision(3) << std::fixed << distinct_q_error << std::setw(16)
+                  << range_q_error << std::endl;
+      });
+    }
+  }
+
+  std::cout << "- Max. distinct q-error: " << max_distinct_q_error << ", max. mean range q-error: " << max_range_q_error
+            << std::endl;
+
+  return 0;
+}
@@ -17,7 +17,8 @@ using namespace opossum;  // NOLINT
  * the de facto standard.
  *
  * Other limitations (that may be removed in the future):
- *  - No primary / foreign keys are used as they are currently unsupported
+ *  - No foreign keys are used as they are currently unsupported; primary keys are only enforced with
+ *    --enforce_primary_keys
  *  - Values that are "retrieved" by the terminal are just selected, but not necessarily materialized
  *  - Data is not persisted as logging is currently unsupported; this means that the durability tests are not executed
  *  - As decimals are not supported, we use floats instead
@@ -41,12 +42,14 @@ int main(int argc, char* argv[]) {
   cli_options.add_options()
     // We use -s instead of -w for consistency with the options of our other TPC-x binaries.
     ("s,scale", "Scale factor (warehouses)", cxxopts::value<size_t>()->default_value("1")) // NOLINT
-    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("enforce_primary_keys", "Enforce the primary keys of all tables when inserting or updating rows", cxxopts::value<bool>()->default_value("false")); // NOLINT
   // clang-format on
 
   std::shared_ptr<BenchmarkConfig> config;
   size_t num_warehouses;
   bool consistency_checks;
+  bool enforce_primary_keys;
 
   // Parse command line args
   const auto cli_parse_result = cli_options.parse(argc, argv);
@@ -55,6 +58,7 @@ int main(int argc, char* argv[]) {
 
   num_warehouses = cli_parse_result["scale"].as<size_t>();
   consistency_checks = cli_parse_result["consistency_checks"].as<bool>();
+  enforce_primary_keys = cli_parse_result["enforce_primary_keys"].as<bool>();
 
   config = std::make_shared<BenchmarkConfig>(CLIConfigParser::parse_cli_options(cli_parse_result));
 
@@ -65,15 +69,16 @@ int main(int argc, char* argv[]) {
   auto context = BenchmarkRunner::create_context(*config);
 
   std::cout << "- TPC-C scale factor (number of warehouses) is " << num_warehouses << std::endl;
+  std::cout << "- Primary keys are " << (enforce_primary_keys ? "" : "not ") << "enforced" << std::endl;
 
   // Add TPC-C-specific information
   context.emplace("scale_factor", num_warehouses);
+  context.emplace("enforce_primary_keys", enforce_primary_keys);
 
   // Run the benchmark
   auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
-  BenchmarkRunner(*config, std::move(item_runner), std::make_unique<TPCCTableGenerator>(num_warehouses, config),
-                  context)
-      .run();
+  auto table_generator = std::make_unique<TPCCTableGenerator>(num_warehouses, config, enforce_primary_keys);
+  BenchmarkRunner(*config, std::move(item_runner), std::move(table_generator), context).run();
 
   if (consistency_checks || config->verify) {
     std::cout << "- Running consistency checks at the end of the benchmark" << std::endl;
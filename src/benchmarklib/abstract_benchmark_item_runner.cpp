@@ -64,7 +64,9 @@ std::tuple<bool, std::vector<SQLPipelineMetrics>, bool> AbstractBenchmarkItemRun
     visualize_prefix = std::move(name);
   }
 
-  BenchmarkSQLExecutor sql_executor(_sqlite_wrapper, visualize_prefix);
+  BenchmarkSQLExecutor sql_executor(_sqlite_wrapper, visualize_prefix,
+                                    _config->query_arena ? UseQueryArena::Yes : UseQueryArena::No);
+  sql_executor.join_sampling_config = _join_sampling_config;
   auto success = _on_execute_item(item_id, sql_executor);
   return {success, std::move(sql_executor.metrics), sql_executor.any_verification_failed};
 }
@@ -73,6 +75,11 @@ void AbstractBenchmarkItemRunner::set_sqlite_wrapper(const std::shared_ptr<SQLit
   _sqlite_wrapper = sqlite_wrapper;
 }
 
+void AbstractBenchmarkItemRunner::set_join_sampling_config(
+    const std::optional<JoinSamplingConfig>& join_sampling_config) {
+  _join_sampling_config = join_sampling_config;
+}
+
 const std::vector<int>& AbstractBenchmarkItemRunner::weights() const {
   static const std::vector<int> empty_vector;
   return empty_vector;
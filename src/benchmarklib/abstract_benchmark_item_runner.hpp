@@ -48,6 +48,9 @@ class AbstractBenchmarkItemRunner {
   // Set the SQLite wrapper used for query verification. `nullptr` disables verification. Default is disabled.
   void set_sqlite_wrapper(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper);
 
+  // Set the JoinSamplingConfig used to optimize the queries. `std::nullopt` (the default) disables join sampling.
+  void set_join_sampling_config(const std::optional<JoinSamplingConfig>& join_sampling_config);
+
   // Returns a mapping from item ID to its relative weight in the execution of the benchmark. Relevant for example in
   // the TPC-C benchmark, where not all transactions are executed equally often.
   virtual const std::vector<int>& weights() const;
@@ -62,6 +65,7 @@ class AbstractBenchmarkItemRunner {
   std::shared_ptr<BenchmarkConfig> _config;
   std::vector<std::shared_ptr<const Table>> _dedicated_expected_results;
   std::shared_ptr<SQLiteWrapper> _sqlite_wrapper;
+  std::optional<JoinSamplingConfig> _join_sampling_config;
 };
 
 }  // namespace opossum
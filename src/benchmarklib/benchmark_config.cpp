@@ -10,7 +10,8 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode init_benchmark_mode, const
                                  const bool init_enable_scheduler, const uint32_t init_cores,
                                  const uint32_t init_clients, const bool init_enable_visualization,
                                  const bool init_verify, const bool init_cache_binary_tables,
-                                 const bool init_sql_metrics)
+                                 const bool init_sql_metrics, const bool init_query_arena,
+                                 const std::optional<std::string>& init_cost_model_path)
     : benchmark_mode(init_benchmark_mode),
       chunk_size(init_chunk_size),
       encoding_config(init_encoding_config),
@@ -25,7 +26,9 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode init_benchmark_mode, const
       enable_visualization(init_enable_visualization),
       verify(init_verify),
       cache_binary_tables(init_cache_binary_tables),
-      sql_metrics(init_sql_metrics) {}
+      sql_metrics(init_sql_metrics),
+      query_arena(init_query_arena),
+      cost_model_path(init_cost_model_path) {}
 
 BenchmarkConfig BenchmarkConfig::get_default_config() { return BenchmarkConfig(); }
 
@@ -23,7 +23,8 @@ class BenchmarkConfig {
                   const Duration& max_duration, const Duration& warmup_duration,
                   const std::optional<std::string>& output_file_path, const bool enable_scheduler, const uint32_t cores,
                   const uint32_t clients, const bool enable_visualization, const bool verify,
-                  const bool cache_binary_tables, const bool sql_metrics);
+                  const bool cache_binary_tables, const bool sql_metrics, const bool query_arena,
+                  const std::optional<std::string>& cost_model_path);
 
   static BenchmarkConfig get_default_config();
 
@@ -42,6 +43,9 @@ class BenchmarkConfig {
   bool verify = false;
   bool cache_binary_tables = false;  // Defaults to false for internal use, but the CLI sets it to true by default
   bool sql_metrics = false;
+  bool query_arena = false;
+  // JSON file with the coefficients of the physical cost model (see CostModelCoefficients)
+  std::optional<std::string> cost_model_path = std::nullopt;
 
  private:
   BenchmarkConfig() = default;
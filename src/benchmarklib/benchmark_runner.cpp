@@ -9,6 +9,7 @@
 
 #include "benchmark_config.hpp"
 #include "constant_mappings.hpp"
+#include "cost_estimation/cost_model_coefficients.hpp"
 #include "hyrise.hpp"
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
@@ -31,6 +32,11 @@ BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config,
   Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
   Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
 
+  if (config.cost_model_path) {
+    Hyrise::get().cost_model_coefficients =
+        std::make_shared<CostModelCoefficients>(CostModelCoefficients::from_json_file(*config.cost_model_path));
+  }
+
   // Initialise the scheduler if the benchmark was requested to run multi-threaded
   if (config.enable_scheduler) {
     Hyrise::get().topology.use_default_topology(config.cores);
@@ -424,7 +430,9 @@ cxxopts::Options BenchmarkRunner::get_basic_cli_options(const std::string& bench
     ("visualize", "Create a visualization image of one LQP and PQP for each query, do not properly run the benchmark", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("verify", "Verify each query by comparing it with the SQLite result", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("dont_cache_binary_tables", "Do not cache tables as binary files for faster loading on subsequent runs", cxxopts::value<bool>()->default_value(default_dont_cache_binary_tables)) // NOLINT
-    ("sql_metrics", "Track SQL metrics (parse time etc.) for each SQL query and add it to the output JSON (see -o)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("sql_metrics", "Track SQL metrics (parse time etc.) for each SQL query and add it to the output JSON (see -o)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("query_arena", "Allocate the intermediate results of read-only queries from a per-query arena", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("cost_model", "JSON file with calibrated cost model coefficients (see hyriseCostModelCalibration) used to choose the physical operators. By default, a fixed preference order is used", cxxopts::value<std::string>()->default_value("")); // NOLINT
   // clang-format on
 
   return cli_options;
@@ -463,6 +471,8 @@ nlohmann::json BenchmarkRunner::create_context(const BenchmarkConfig& config) {
       {"cores", config.cores},
       {"clients", config.clients},
       {"verify", config.verify},
+      {"query_arena", config.query_arena},
+      {"cost_model", config.cost_model_path ? *config.cost_model_path : ""},
       {"time_unit", "ns"},
       {"GIT-HASH", GIT_HEAD_SHA1 + std::string(GIT_IS_DIRTY ? "-dirty" : "")}};
 }
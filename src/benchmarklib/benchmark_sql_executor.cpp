@@ -1,5 +1,6 @@
 #include "benchmark_sql_executor.hpp"
 
+#include "optimizer/optimizer.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "utils/check_table_equal.hpp"
 #include "utils/timer.hpp"
@@ -8,10 +9,12 @@
 
 namespace opossum {
 BenchmarkSQLExecutor::BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper,
-                                           const std::optional<std::string>& visualize_prefix)
+                                           const std::optional<std::string>& visualize_prefix,
+                                           const UseQueryArena use_query_arena)
     : _sqlite_connection(sqlite_wrapper ? std::optional<SQLiteWrapper::Connection>{sqlite_wrapper->new_connection()}
                                         : std::optional<SQLiteWrapper::Connection>{}),
-      _visualize_prefix(visualize_prefix) {
+      _visualize_prefix(visualize_prefix),
+      _use_query_arena(use_query_arena) {
   if (_sqlite_connection) {
     _sqlite_connection->raw_execute_query("BEGIN TRANSACTION");
     _sqlite_transaction_open = true;
@@ -20,8 +23,11 @@ BenchmarkSQLExecutor::BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>&
 
 std::pair<SQLPipelineStatus, std::shared_ptr<const Table>> BenchmarkSQLExecutor::execute(
     const std::string& sql, const std::shared_ptr<const Table>& expected_result_table) {
-  auto pipeline_builder = SQLPipelineBuilder{sql};
+  auto pipeline_builder = SQLPipelineBuilder{sql}.with_query_arena(_use_query_arena);
   if (transaction_context) pipeline_builder.with_transaction_context(transaction_context);
+  if (join_sampling_config) {
+    pipeline_builder.with_optimizer(Optimizer::create_default_optimizer(*join_sampling_config));
+  }
 
   auto pipeline = pipeline_builder.create_pipeline();
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sql/sql_pipeline.hpp"
+#include "statistics/join_sampling.hpp"
 #include "utils/sqlite_wrapper.hpp"
 
 namespace opossum {
@@ -14,8 +15,10 @@ class BenchmarkSQLExecutor {
  public:
   // @param visualize_prefix    Prefix for the filename of the generated query plans (e.g., "TPC-H_6-").
   //                            The suffix will be "LQP/PQP-<statement_idx>.<extension>"
+  // @param use_query_arena     Whether read-only statements allocate their intermediates from a QueryMemoryResource
   BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper,
-                       const std::optional<std::string>& visualize_prefix);
+                       const std::optional<std::string>& visualize_prefix,
+                       const UseQueryArena use_query_arena = UseQueryArena::No);
 
   ~BenchmarkSQLExecutor();
 
@@ -37,6 +40,9 @@ class BenchmarkSQLExecutor {
   // Can optionally be set by the caller. Otherwise, pipelines are auto-committed
   std::shared_ptr<TransactionContext> transaction_context = nullptr;
 
+  // Can optionally be set by the caller. If set, queries are optimized with join sampling (see JoinSamplingConfig)
+  std::optional<JoinSamplingConfig> join_sampling_config;
+
  private:
   void _compare_tables(const std::shared_ptr<const Table>& actual_result_table,
                        const std::shared_ptr<const Table>& expected_result_table,
@@ -48,6 +54,7 @@ class BenchmarkSQLExecutor {
   bool _sqlite_transaction_open{false};
 
   const std::optional<std::string> _visualize_prefix;
+  const UseQueryArena _use_query_arena;
   uint64_t _num_visualized_plans{0};
 };
 
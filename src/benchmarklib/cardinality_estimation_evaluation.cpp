@@ -0,0 +1,163 @@
+#include "cardinality_estimation_evaluation.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_set>
+
+#include "expression/expression_utils.hpp"
+#include "expression/logical_expression.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/abstract_operator.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "statistics/column_pair_statistics.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+double q_error(const double estimate, const double actual) {
+  const auto clamped_estimate = std::max(estimate, 1.0);
+  const auto clamped_actual = std::max(actual, 1.0);
+  return std::max(clamped_estimate / clamped_actual, clamped_actual / clamped_estimate);
+}
+
+// Expects @param sorted_values to be sorted and not empty
+double percentile(const std::vector<double>& sorted_values, const double fraction) {
+  const auto index = std::min(static_cast<size_t>(fraction * static_cast<double>(sorted_values.size())),
+                              sorted_values.size() - 1);
+  return sorted_values[index];
+}
+
+void print_summary(const std::string& label, std::vector<double>& q_errors, std::ostream& stream) {
+  stream << "- " << label << ": ";
+  if (q_errors.empty()) {
+    stream << "none" << std::endl;
+    return;
+  }
+
+  std::sort(q_errors.begin(), q_errors.end());
+  stream << q_errors.size() << " estimates, median q-error " << percentile(q_errors, 0.5) << ", 90th percentile "
+         << percentile(q_errors, 0.9) << ", max. " << q_errors.back() << std::endl;
+}
+
+}  // namespace
+
+namespace opossum {
+
+void add_column_pair_statistics_for_queries(const std::vector<std::string>& queries) {
+  auto column_pairs_by_table = std::map<std::string, std::set<std::pair<ColumnID, ColumnID>>>{};
+
+  for (const auto& query : queries) {
+    const auto& lqps = SQLPipelineBuilder{query}.create_pipeline().get_unoptimized_logical_plans();
+
+    // Columns that are filtered on, per instance of a stored table. Different instances of the same table (e.g., in
+    // self-joins) filter different rows and are thus not combined.
+    auto filtered_columns_by_node = std::map<std::shared_ptr<const AbstractLQPNode>, std::set<ColumnID>>{};
+
+    for (const auto& lqp : lqps) {
+      visit_lqp(lqp, [&](const auto& node) {
+        if (node->type != LQPNodeType::Predicate) return LQPVisitation::VisitInputs;
+
+        const auto& predicate = static_cast<const PredicateNode&>(*node).predicate();
+        for (const auto& conjunct : flatten_logical_expressions(predicate, LogicalOperator::And)) {
+          // Only predicates on a single column are estimated with ColumnPairStatistics, join predicates are not
+          auto column_expressions = std::unordered_set<std::shared_ptr<AbstractExpression>>{};
+          auto has_subquery = false;
+          visit_expression(conjunct, [&](const auto& sub_expression) {
+            if (sub_expression->type == ExpressionType::LQPColumn) column_expressions.emplace(sub_expression);
+            if (sub_expression->type == ExpressionType::LQPSubquery) has_subquery = true;
+            return ExpressionVisitation::VisitArguments;
+          });
+          if (has_subquery || column_expressions.size() != 1) continue;
+
+          const auto& column_expression = static_cast<const LQPColumnExpression&>(**column_expressions.begin());
+          const auto original_node = column_expression.column_reference.original_node();
+          if (original_node->type != LQPNodeType::StoredTable) continue;
+
+          filtered_columns_by_node[original_node].emplace(column_expression.column_reference.original_column_id());
+        }
+
+        return LQPVisitation::VisitInputs;
+      });
+    }
+
+    for (const auto& [node, column_ids] : filtered_columns_by_node) {
+      auto& column_pairs = column_pairs_by_table[static_cast<const StoredTableNode&>(*node).table_name];
+      for (auto first = column_ids.begin(); first != column_ids.end(); ++first) {
+        for (auto second = std::next(first); second != column_ids.end(); ++second) {
+          column_pairs.emplace(*first, *second);
+        }
+      }
+    }
+  }
+
+  auto& storage_manager = Hyrise::get().storage_manager;
+  for (const auto& [table_name, column_pairs] : column_pairs_by_table) {
+    if (column_pairs.empty()) continue;
+
+    add_column_pair_statistics(*storage_manager.get_table(table_name),
+                               std::vector<std::pair<ColumnID, ColumnID>>{column_pairs.begin(), column_pairs.end()});
+  }
+}
+
+void report_cardinality_estimation_errors(const std::vector<std::pair<std::string, std::string>>& named_queries,
+                                          std::ostream& stream) {
+  auto q_errors = std::vector<double>{};
+  auto join_q_errors = std::vector<double>{};
+
+  stream << "- Cardinality estimation errors" << std::endl;
+  stream << std::setprecision(2) << std::fixed;
+
+  for (const auto& [name, sql] : named_queries) {
+    auto pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    const auto [status, table] = pipeline.get_result_table();
+    Assert(status == SQLPipelineStatus::Success, "Query '" + name + "' failed");
+
+    const auto estimator = CardinalityEstimator{};
+    auto query_max_q_error = 1.0;
+
+    // An LQP node might be translated into several operators (e.g., a disjunction into several scans and a union).
+    // Operators are visited top-down, so the first operator of an LQP node is the one that produces its output.
+    auto visited_operators = std::unordered_set<std::shared_ptr<const AbstractOperator>>{};
+    auto visited_nodes = std::unordered_set<std::shared_ptr<const AbstractLQPNode>>{};
+    auto operator_queue = std::vector<std::shared_ptr<const AbstractOperator>>{};
+    for (const auto& physical_plan : pipeline.get_physical_plans()) {
+      operator_queue.emplace_back(physical_plan);
+    }
+
+    for (auto operator_idx = size_t{0}; operator_idx < operator_queue.size(); ++operator_idx) {
+      const auto op = operator_queue[operator_idx];
+      for (const auto& input : {op->input_left(), op->input_right()}) {
+        if (input && visited_operators.emplace(input).second) operator_queue.emplace_back(input);
+      }
+
+      const auto& node = op->lqp_node;
+      if (!node || node->type == LQPNodeType::Root || !op->performance_data().has_output) continue;
+      if (!visited_nodes.emplace(node).second) continue;
+
+      const auto estimate = estimator.estimate_cardinality(std::const_pointer_cast<AbstractLQPNode>(node));
+      const auto operator_q_error = q_error(estimate, static_cast<double>(op->performance_data().output_row_count));
+
+      q_errors.emplace_back(operator_q_error);
+      if (node->type == LQPNodeType::Join) join_q_errors.emplace_back(operator_q_error);
+      query_max_q_error = std::max(query_max_q_error, operator_q_error);
+    }
+
+    stream << "  " << std::left << std::setw(16) << name << std::right << " max. q-error " << query_max_q_error
+           << std::endl;
+  }
+
+  print_summary("All operators", q_errors, stream);
+  print_summary("Joins", join_q_errors, stream);
+}
+
+}  // namespace opossum
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Finds the column pairs of stored tables that @param queries filter on together, i.e., columns of the same table that
+ * predicates of the same query refer to, and adds ColumnPairStatistics for them to the tables. The tables must have
+ * been added to the StorageManager.
+ */
+void add_column_pair_statistics_for_queries(const std::vector<std::string>& queries);
+
+/**
+ * Executes each of @param named_queries (pairs of name and SQL) once and compares the row count of every operator with
+ * the cardinality that the CardinalityEstimator estimates for its LQP node. The errors are reported as q-errors, i.e.,
+ * max(estimate / actual, actual / estimate). For each query, the maximum q-error is printed, followed by the median,
+ * 90th percentile, and maximum over all operators and over all joins.
+ */
+void report_cardinality_estimation_errors(const std::vector<std::pair<std::string, std::string>>& named_queries,
+                                          std::ostream& stream);
+
+}  // namespace opossum
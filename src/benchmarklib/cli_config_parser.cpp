@@ -129,10 +129,25 @@ BenchmarkConfig CLIConfigParser::parse_cli_options(const cxxopts::ParseResult& p
     std::cout << "- Not tracking SQL metrics" << std::endl;
   }
 
+  const auto query_arena = parse_result["query_arena"].as<bool>();
+  if (query_arena) {
+    std::cout << "- Allocating intermediate results from per-query arenas" << std::endl;
+  }
+
+  const auto cost_model_string = parse_result["cost_model"].as<std::string>();
+  auto cost_model_path = std::optional<std::string>{};
+  if (!cost_model_string.empty()) {
+    cost_model_path = cost_model_string;
+    std::cout << "- Choosing physical operators with the cost model from " << cost_model_string << std::endl;
+  } else {
+    std::cout << "- Choosing physical operators by a fixed preference order" << std::endl;
+  }
+
   return BenchmarkConfig{
-      benchmark_mode,  chunk_size,          *encoding_config, indexes, max_runs, timeout_duration,
-      warmup_duration, output_file_path,    enable_scheduler, cores,   clients,  enable_visualization,
-      verify,          cache_binary_tables, sql_metrics};
+      benchmark_mode,  chunk_size,          *encoding_config, indexes,    max_runs, timeout_duration,
+      warmup_duration, output_file_path,    enable_scheduler, cores,      clients,  enable_visualization,
+      verify,          cache_binary_tables, sql_metrics,      query_arena,
+      cost_model_path};
 }
 
 EncodingConfig CLIConfigParser::parse_encoding_config(const std::string& encoding_file_str) {
@@ -0,0 +1,400 @@
+#include "cost_model_calibration.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+
+#include "cost_estimation/cost_estimator_physical.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/aggregate_sort.hpp"
+#include "operators/get_table.hpp"
+#include "operators/index_scan.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/index/group_key/group_key_index.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "synthetic_table_generator.hpp"
+#include "utils/assert.hpp"
+#include "utils/timer.hpp"
+
+namespace {
+
+using namespace opossum;                         // NOLINT
+using namespace opossum::expression_functional;  // NOLINT
+
+constexpr auto SELECTIVITIES = std::array{0.001, 0.01, 0.1, 0.5, 0.9};
+
+// Single int column with uniformly distributed values in [0, max_value]
+std::shared_ptr<Table> generate_int_table(const size_t row_count, const int max_value,
+                                          const EncodingType encoding_type = EncodingType::Unencoded,
+                                          const size_t column_count = 1) {
+  const auto column_specification = ColumnSpecification{ColumnDataDistribution::make_uniform_config(0.0, max_value),
+                                                        DataType::Int, SegmentEncodingSpec{encoding_type}};
+  return SyntheticTableGenerator::generate_table(std::vector<ColumnSpecification>(column_count, column_specification),
+                                                 row_count);
+}
+
+std::shared_ptr<TableWrapper> make_executed_table_wrapper(const std::shared_ptr<const Table>& table) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+}  // namespace
+
+namespace opossum {
+
+CostModelCalibration::CostModelCalibration(const std::vector<size_t>& row_counts, const size_t repetitions)
+    : _row_counts(row_counts), _repetitions(repetitions) {
+  Assert(!_row_counts.empty(), "Expected at least one row count");
+  Assert(_repetitions > 0, "Expected at least one repetition");
+}
+
+CostModelCoefficients CostModelCalibration::run() {
+  auto coefficients = CostModelCoefficients{};
+
+  std::cout << "- Calibrating TableScan" << std::endl;
+  _calibrate_table_scans(coefficients);
+  std::cout << "- Calibrating IndexScan" << std::endl;
+  _calibrate_index_scan(coefficients);
+  std::cout << "- Calibrating joins" << std::endl;
+  _calibrate_joins(coefficients);
+  std::cout << "- Calibrating aggregates" << std::endl;
+  _calibrate_aggregates(coefficients);
+  std::cout << "- Calibrating Sort" << std::endl;
+  _calibrate_sort(coefficients);
+
+  return coefficients;
+}
+
+std::optional<CostFunctionCoefficients> CostModelCalibration::fit_coefficients(
+    const std::vector<std::vector<double>>& features, const std::vector<double>& runtimes) {
+  Assert(features.size() == runtimes.size(), "Expected one runtime per feature vector");
+  if (features.empty()) return std::nullopt;
+
+  const auto feature_count = features.front().size();
+
+  // Features whose coefficients are fixed to zero as the unconstrained fit made them negative
+  auto is_active = std::vector<bool>(feature_count, true);
+
+  while (true) {
+    auto active_feature_ids = std::vector<size_t>{};
+    for (auto feature_id = size_t{0}; feature_id < feature_count; ++feature_id) {
+      if (is_active[feature_id]) active_feature_ids.emplace_back(feature_id);
+    }
+    const auto active_count = active_feature_ids.size();
+    if (active_count == 0 || features.size() < active_count) return std::nullopt;
+
+    // Build the normal equations (AᵀA)x = Aᵀb as an augmented matrix. Each measurement is divided by its runtime so
+    // that the relative error is minimized.
+    auto matrix = std::vector<std::vector<double>>(active_count, std::vector<double>(active_count + 1, 0.0));
+    for (auto measurement_id = size_t{0}; measurement_id < features.size(); ++measurement_id) {
+      const auto weight = 1.0 / std::max(runtimes[measurement_id], 1.0);
+      for (auto row = size_t{0}; row < active_count; ++row) {
+        const auto row_feature = features[measurement_id][active_feature_ids[row]] * weight;
+        for (auto column = size_t{0}; column < active_count; ++column) {
+          matrix[row][column] += row_feature * features[measurement_id][active_feature_ids[column]] * weight;
+        }
+        matrix[row][active_count] += row_feature * runtimes[measurement_id] * weight;
+      }
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (auto pivot = size_t{0}; pivot < active_count; ++pivot) {
+      auto max_row = pivot;
+      for (auto row = pivot + 1; row < active_count; ++row) {
+        if (std::abs(matrix[row][pivot]) > std::abs(matrix[max_row][pivot])) max_row = row;
+      }
+      std::swap(matrix[pivot], matrix[max_row]);
+
+      // The features are linearly dependent if the pivot is (close to) zero
+      const auto column_sum = std::accumulate(matrix.begin(), matrix.end(), 0.0, [&](const auto sum, const auto& row) {
+        return sum + std::abs(row[pivot]);
+      });
+      if (std::abs(matrix[pivot][pivot]) <= 1e-12 * column_sum) return std::nullopt;
+
+      for (auto row = size_t{0}; row < active_count; ++row) {
+        if (row == pivot) continue;
+        const auto factor = matrix[row][pivot] / matrix[pivot][pivot];
+        for (auto column = pivot; column <= active_count; ++column) {
+          matrix[row][column] -= factor * matrix[pivot][column];
+        }
+      }
+    }
+
+    auto coefficients = CostFunctionCoefficients(feature_count, 0.0);
+    auto has_negative_coefficient = false;
+    for (auto row = size_t{0}; row < active_count; ++row) {
+      const auto coefficient = matrix[row][active_count] / matrix[row][row];
+      if (coefficient < 0.0) {
+        is_active[active_feature_ids[row]] = false;
+        has_negative_coefficient = true;
+      }
+      coefficients[active_feature_ids[row]] = coefficient;
+    }
+
+    if (!has_negative_coefficient) return coefficients;
+  }
+}
+
+std::pair<double, size_t> CostModelCalibration::_measure(
+    const std::function<std::shared_ptr<AbstractOperator>()>& make_operator) const {
+  auto min_runtime = std::numeric_limits<double>::max();
+  auto output_row_count = size_t{0};
+
+  for (auto repetition = size_t{0}; repetition < _repetitions; ++repetition) {
+    const auto op = make_operator();
+    auto timer = Timer{};
+    op->execute();
+    min_runtime = std::min(min_runtime, static_cast<double>(timer.lap().count()));
+    output_row_count = op->get_output()->row_count();
+  }
+
+  return {min_runtime, output_row_count};
+}
+
+void CostModelCalibration::_fit(const Measurements& measurements, CostFunctionCoefficients& coefficients) {
+  const auto fitted_coefficients = fit_coefficients(measurements.features, measurements.runtimes);
+  if (!fitted_coefficients) {
+    std::cout << "  Fitting the coefficients failed, keeping the defaults" << std::endl;
+    return;
+  }
+  coefficients = *fitted_coefficients;
+}
+
+void CostModelCalibration::_calibrate_table_scans(CostModelCoefficients& coefficients) const {
+  const auto column = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+
+  for (const auto encoding_type : {EncodingType::Unencoded, EncodingType::Dictionary, EncodingType::RunLength,
+                                   EncodingType::FrameOfReference, EncodingType::LZ4}) {
+    auto measurements = Measurements{};
+
+    for (const auto row_count : _row_counts) {
+      // Few distinct values, so that RunLength encoding has runs to compress
+      for (const auto max_value : {100, 100'000}) {
+        const auto table_wrapper = make_executed_table_wrapper(generate_int_table(row_count, max_value, encoding_type));
+
+        for (const auto selectivity : SELECTIVITIES) {
+          const auto threshold = static_cast<int>(std::ceil(selectivity * max_value));
+          const auto [runtime, output_row_count] =
+              _measure([&]() { return std::make_shared<TableScan>(table_wrapper, less_than_(column, threshold)); });
+
+          measurements.features.push_back({static_cast<double>(row_count), static_cast<double>(output_row_count)});
+          measurements.runtimes.emplace_back(runtime);
+        }
+      }
+    }
+
+    _fit(measurements, coefficients.table_scan[encoding_type]);
+  }
+
+  // Scans on chunks sorted by the scanned column use a binary search instead of looking at every row
+  auto measurements = Measurements{};
+  for (const auto row_count : _row_counts) {
+    const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+    for (auto begin_value = size_t{0}; begin_value < row_count; begin_value += Chunk::DEFAULT_SIZE) {
+      const auto chunk_size = std::min(static_cast<size_t>(Chunk::DEFAULT_SIZE), row_count - begin_value);
+      auto values = pmr_vector<int32_t>(chunk_size);
+      std::iota(values.begin(), values.end(), static_cast<int32_t>(begin_value));
+      table->append_chunk({std::make_shared<ValueSegment<int32_t>>(std::move(values))});
+
+      const auto chunk = table->get_chunk(static_cast<ChunkID>(table->chunk_count() - 1));
+      chunk->finalize();
+      chunk->set_ordered_by({ColumnID{0}, OrderByMode::Ascending});
+    }
+    const auto table_wrapper = make_executed_table_wrapper(table);
+
+    for (const auto selectivity : SELECTIVITIES) {
+      const auto threshold = static_cast<int>(selectivity * static_cast<double>(row_count));
+      const auto [runtime, output_row_count] =
+          _measure([&]() { return std::make_shared<TableScan>(table_wrapper, less_than_(column, threshold)); });
+
+      measurements.features.push_back(
+          {static_cast<double>(table->chunk_count()), static_cast<double>(output_row_count)});
+      measurements.runtimes.emplace_back(runtime);
+    }
+  }
+  _fit(measurements, coefficients.table_scan_sorted);
+}
+
+void CostModelCalibration::_calibrate_index_scan(CostModelCoefficients& coefficients) const {
+  auto measurements = Measurements{};
+
+  for (const auto row_count : _row_counts) {
+    const auto max_value = 100'000;
+    const auto table = generate_int_table(row_count, max_value, EncodingType::Dictionary);
+    table->create_index<GroupKeyIndex>({ColumnID{0}});
+    const auto table_wrapper = make_executed_table_wrapper(table);
+
+    for (const auto selectivity : SELECTIVITIES) {
+      const auto threshold = AllTypeVariant{static_cast<int32_t>(std::ceil(selectivity * max_value))};
+      const auto [runtime, output_row_count] = _measure([&]() {
+        return std::make_shared<IndexScan>(table_wrapper, SegmentIndexType::GroupKey,
+                                           std::vector<ColumnID>{ColumnID{0}}, PredicateCondition::LessThan,
+                                           std::vector<AllTypeVariant>{threshold});
+      });
+
+      measurements.features.push_back(
+          {static_cast<double>(table->chunk_count()), static_cast<double>(output_row_count)});
+      measurements.runtimes.emplace_back(runtime);
+    }
+  }
+
+  _fit(measurements, coefficients.index_scan);
+}
+
+void CostModelCalibration::_calibrate_joins(CostModelCoefficients& coefficients) const {
+  const auto join_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+
+  auto hash_measurements = Measurements{};
+  auto sort_merge_measurements = Measurements{};
+  auto index_measurements = Measurements{};
+
+  for (const auto left_row_count : _row_counts) {
+    for (const auto right_row_count : _row_counts) {
+      // The number of distinct values determines the output size, which is varied from about the size of the larger
+      // input to ten times that size
+      const auto larger_row_count = std::max(left_row_count, right_row_count);
+      const auto smaller_row_count = std::min(left_row_count, right_row_count);
+      for (const auto max_value : {static_cast<int>(larger_row_count),
+                                   std::max(static_cast<int>(smaller_row_count / 10), 1)}) {
+        const auto left_table = generate_int_table(left_row_count, max_value);
+        const auto right_table = generate_int_table(right_row_count, max_value);
+        const auto left_wrapper = make_executed_table_wrapper(left_table);
+        const auto right_wrapper = make_executed_table_wrapper(right_table);
+
+        {
+          const auto [runtime, output_row_count] = _measure([&]() {
+            return std::make_shared<JoinHash>(left_wrapper, right_wrapper, JoinMode::Inner, join_predicate);
+          });
+          hash_measurements.features.emplace_back(CostEstimatorPhysical::join_hash_features(
+              static_cast<double>(smaller_row_count), static_cast<double>(larger_row_count),
+              static_cast<double>(output_row_count)));
+          hash_measurements.runtimes.emplace_back(runtime);
+        }
+
+        {
+          const auto [runtime, output_row_count] = _measure([&]() {
+            return std::make_shared<JoinSortMerge>(left_wrapper, right_wrapper, JoinMode::Inner, join_predicate);
+          });
+          sort_merge_measurements.features.emplace_back(CostEstimatorPhysical::join_sort_merge_features(
+              static_cast<double>(left_row_count), static_cast<double>(right_row_count),
+              static_cast<double>(output_row_count)));
+          sort_merge_measurements.runtimes.emplace_back(runtime);
+        }
+
+        // JoinIndex on a table hash index of the right table, which has to be a stored table for that
+        const auto table_name = std::string{"cost_model_calibration_join_index"};
+        auto& storage_manager = Hyrise::get().storage_manager;
+        storage_manager.add_table(table_name, right_table);
+        right_table->create_table_hash_index({ColumnID{0}});
+        {
+          const auto [runtime, output_row_count] = _measure([&]() {
+            const auto get_table = std::make_shared<GetTable>(table_name);
+            get_table->execute();
+            return std::make_shared<JoinIndex>(left_wrapper, get_table, JoinMode::Inner, join_predicate,
+                                               std::vector<OperatorJoinPredicate>{}, IndexSide::Right);
+          });
+          index_measurements.features.push_back(
+              {static_cast<double>(left_row_count), static_cast<double>(output_row_count)});
+          index_measurements.runtimes.emplace_back(runtime);
+        }
+        storage_manager.drop_table(table_name);
+      }
+    }
+  }
+
+  _fit(hash_measurements, coefficients.join_hash);
+  _fit(sort_merge_measurements, coefficients.join_sort_merge);
+  _fit(index_measurements, coefficients.join_index);
+
+  // The nested loop join compares every pair of rows and is calibrated on small inputs only
+  auto nested_loop_measurements = Measurements{};
+  for (const auto left_row_count : {100, 1'000, 5'000}) {
+    for (const auto right_row_count : {100, 1'000, 5'000}) {
+      for (const auto max_value : {10, 10'000}) {
+        const auto left_wrapper = make_executed_table_wrapper(generate_int_table(left_row_count, max_value));
+        const auto right_wrapper = make_executed_table_wrapper(generate_int_table(right_row_count, max_value));
+
+        const auto [runtime, output_row_count] = _measure([&]() {
+          return std::make_shared<JoinNestedLoop>(left_wrapper, right_wrapper, JoinMode::Inner, join_predicate);
+        });
+        nested_loop_measurements.features.push_back({static_cast<double>(left_row_count) * right_row_count,
+                                                     static_cast<double>(output_row_count)});
+        nested_loop_measurements.runtimes.emplace_back(runtime);
+      }
+    }
+  }
+  _fit(nested_loop_measurements, coefficients.join_nested_loop);
+}
+
+void CostModelCalibration::_calibrate_aggregates(CostModelCoefficients& coefficients) const {
+  auto hash_measurements = Measurements{};
+  auto sort_measurements = Measurements{};
+
+  for (const auto row_count : _row_counts) {
+    // The first column is grouped by, the second one is summed up
+    for (const auto group_count : {10, 1'000, std::max(static_cast<int>(row_count / 2), 1)}) {
+      const auto column_specifications = std::vector<ColumnSpecification>{
+          {ColumnDataDistribution::make_uniform_config(0.0, group_count), DataType::Int},
+          {ColumnDataDistribution::make_uniform_config(0.0, 1'000), DataType::Int}};
+      const auto table_wrapper =
+          make_executed_table_wrapper(SyntheticTableGenerator::generate_table(column_specifications, row_count));
+
+      const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+          sum_(pqp_column_(ColumnID{1}, DataType::Int, false, "b"))};
+      const auto group_by_column_ids = std::vector<ColumnID>{ColumnID{0}};
+
+      {
+        const auto [runtime, output_row_count] = _measure(
+            [&]() { return std::make_shared<AggregateHash>(table_wrapper, aggregates, group_by_column_ids); });
+        hash_measurements.features.push_back({static_cast<double>(row_count), static_cast<double>(output_row_count)});
+        hash_measurements.runtimes.emplace_back(runtime);
+      }
+
+      {
+        const auto [runtime, output_row_count] = _measure(
+            [&]() { return std::make_shared<AggregateSort>(table_wrapper, aggregates, group_by_column_ids); });
+        sort_measurements.features.emplace_back(CostEstimatorPhysical::aggregate_sort_features(
+            static_cast<double>(row_count), static_cast<double>(output_row_count)));
+        sort_measurements.runtimes.emplace_back(runtime);
+      }
+    }
+  }
+
+  _fit(hash_measurements, coefficients.aggregate_hash);
+  _fit(sort_measurements, coefficients.aggregate_sort);
+}
+
+void CostModelCalibration::_calibrate_sort(CostModelCoefficients& coefficients) const {
+  auto measurements = Measurements{};
+
+  for (const auto row_count : _row_counts) {
+    for (const auto max_value : {100, static_cast<int>(row_count)}) {
+      const auto table_wrapper = make_executed_table_wrapper(generate_int_table(row_count, max_value));
+
+      const auto sort_definitions =
+          std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}, OrderByMode::Ascending}};
+      const auto runtime =
+          _measure([&]() { return std::make_shared<Sort>(table_wrapper, sort_definitions); }).first;
+      measurements.features.emplace_back(CostEstimatorPhysical::sort_features(static_cast<double>(row_count)));
+      measurements.runtimes.emplace_back(runtime);
+    }
+  }
+
+  _fit(measurements, coefficients.sort);
+}
+
+}  // namespace opossum
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "cost_estimation/cost_model_coefficients.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class Table;
+
+/**
+ * Calibrates the coefficients of CostEstimatorPhysical on the current machine. For each operator implementation, the
+ * calibration executes the operator on synthetic tables of different sizes, encodings, and selectivities and measures
+ * its runtime. The coefficients of the operator's cost function are then fitted to these measurements. The cost
+ * features are computed from the actual row counts so that errors of the cardinality estimation do not distort the
+ * coefficients.
+ *
+ * The cost function of "other" operators and the TableScan coefficients of FixedStringDictionary (which only supports
+ * strings) are not calibrated and keep their defaults.
+ */
+class CostModelCalibration {
+ public:
+  // @param row_counts are the sizes of the generated tables. Nested loop joins are calibrated on smaller tables.
+  explicit CostModelCalibration(const std::vector<size_t>& row_counts = {10'000, 100'000, 1'000'000},
+                                const size_t repetitions = 3);
+
+  CostModelCoefficients run();
+
+  /**
+   * Fits non-negative coefficients so that their dot product with the features approximates the runtimes. Minimizes the
+   * relative error, as the absolute error would be dominated by the largest measurements. Returns std::nullopt if the
+   * features do not determine the coefficients (e.g., if there are fewer measurements than features).
+   */
+  static std::optional<CostFunctionCoefficients> fit_coefficients(const std::vector<std::vector<double>>& features,
+                                                                  const std::vector<double>& runtimes);
+
+ private:
+  struct Measurements {
+    std::vector<std::vector<double>> features;
+    std::vector<double> runtimes;
+  };
+
+  // Executes the operator created by `make_operator` `_repetitions` times. Returns the lowest runtime in nanoseconds
+  // and the output row count. The inputs of the operator must have been executed.
+  std::pair<double, size_t> _measure(const std::function<std::shared_ptr<AbstractOperator>()>& make_operator) const;
+
+  // Fits the coefficients to the measurements and replaces `coefficients` with them if the fit succeeds
+  static void _fit(const Measurements& measurements, CostFunctionCoefficients& coefficients);
+
+  void _calibrate_table_scans(CostModelCoefficients& coefficients) const;
+  void _calibrate_index_scan(CostModelCoefficients& coefficients) const;
+  void _calibrate_joins(CostModelCoefficients& coefficients) const;
+  void _calibrate_aggregates(CostModelCoefficients& coefficients) const;
+  void _calibrate_sort(CostModelCoefficients& coefficients) const;
+
+  const std::vector<size_t> _row_counts;
+  const size_t _repetitions;
+};
+
+}  // namespace opossum
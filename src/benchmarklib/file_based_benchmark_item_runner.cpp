@@ -58,6 +58,10 @@ std::string FileBasedBenchmarkItemRunner::item_name(const BenchmarkItemID item_i
   return _queries[item_id].name;
 }
 
+const std::string& FileBasedBenchmarkItemRunner::item_sql(const BenchmarkItemID item_id) const {
+  return _queries[item_id].sql;
+}
+
 const std::vector<BenchmarkItemID>& FileBasedBenchmarkItemRunner::items() const { return _items; }
 
 void FileBasedBenchmarkItemRunner::_parse_query_file(
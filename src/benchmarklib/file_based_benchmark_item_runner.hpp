@@ -22,6 +22,8 @@ class FileBasedBenchmarkItemRunner : public AbstractBenchmarkItemRunner {
   std::string item_name(const BenchmarkItemID item_id) const override;
   const std::vector<BenchmarkItemID>& items() const override;
 
+  const std::string& item_sql(const BenchmarkItemID item_id) const;
+
  protected:
   bool _on_execute_item(const BenchmarkItemID item_id, BenchmarkSQLExecutor& sql_executor) override;
 
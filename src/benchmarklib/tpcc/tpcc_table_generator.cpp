@@ -21,8 +21,11 @@
 
 namespace opossum {
 
-TPCCTableGenerator::TPCCTableGenerator(size_t num_warehouses, const std::shared_ptr<BenchmarkConfig>& benchmark_config)
-    : AbstractTableGenerator(benchmark_config), _num_warehouses(num_warehouses) {}
+TPCCTableGenerator::TPCCTableGenerator(size_t num_warehouses, const std::shared_ptr<BenchmarkConfig>& benchmark_config,
+                                       const bool enforce_primary_keys)
+    : AbstractTableGenerator(benchmark_config),
+      _num_warehouses(num_warehouses),
+      _enforce_primary_keys(enforce_primary_keys) {}
 
 TPCCTableGenerator::TPCCTableGenerator(size_t num_warehouses, uint32_t chunk_size)
     : AbstractTableGenerator(create_benchmark_config_with_chunk_size(chunk_size)), _num_warehouses(num_warehouses) {}
@@ -533,6 +536,32 @@ std::unordered_map<std::string, BenchmarkTableInfo> TPCCTableGenerator::generate
                                                               {"NEW_ORDER", BenchmarkTableInfo{new_order_table}}});
 }
 
+void TPCCTableGenerator::_add_constraints(
+    std::unordered_map<std::string, BenchmarkTableInfo>& table_info_by_name) const {
+  if (!_enforce_primary_keys) return;
+
+  // Primary keys as defined in Clause 1.3 of the TPC-C specification. HISTORY does not have a primary key.
+  const auto primary_keys = std::vector<std::pair<std::string, std::vector<std::string>>>{
+      {"WAREHOUSE", {"W_ID"}},
+      {"DISTRICT", {"D_W_ID", "D_ID"}},
+      {"CUSTOMER", {"C_W_ID", "C_D_ID", "C_ID"}},
+      {"NEW_ORDER", {"NO_W_ID", "NO_D_ID", "NO_O_ID"}},
+      {"ORDER", {"O_W_ID", "O_D_ID", "O_ID"}},
+      {"ORDER_LINE", {"OL_W_ID", "OL_D_ID", "OL_O_ID", "OL_NUMBER"}},
+      {"ITEM", {"I_ID"}},
+      {"STOCK", {"S_W_ID", "S_I_ID"}}};
+
+  for (const auto& [table_name, column_names] : primary_keys) {
+    const auto& table = table_info_by_name.at(table_name).table;
+
+    auto column_ids = std::vector<ColumnID>{};
+    for (const auto& column_name : column_names) {
+      column_ids.emplace_back(table->column_id_by_name(column_name));
+    }
+    table->add_unique_constraint(column_ids, IsPrimaryKey::Yes);
+  }
+}
+
 thread_local TPCCRandomGenerator TPCCTableGenerator::_random_gen;  // NOLINT
 
 }  // namespace opossum
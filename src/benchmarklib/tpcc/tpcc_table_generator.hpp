@@ -22,7 +22,10 @@ using TPCCTableGeneratorFunctions = std::unordered_map<std::string, std::functio
 class TPCCTableGenerator : public AbstractTableGenerator {
   // following TPC-C v5.11.0
  public:
-  TPCCTableGenerator(size_t num_warehouses, const std::shared_ptr<BenchmarkConfig>& benchmark_config);
+  // If enforce_primary_keys is set, the primary keys defined by TPC-C are added as enforced unique constraints. This is
+  // used to measure the overhead of constraint checking in the Insert operator.
+  TPCCTableGenerator(size_t num_warehouses, const std::shared_ptr<BenchmarkConfig>& benchmark_config,
+                     const bool enforce_primary_keys = false);
 
   // Convenience constructor for creating a TPCCTableGenerator without a benchmarking context
   explicit TPCCTableGenerator(size_t num_warehouses, uint32_t chunk_size = Chunk::DEFAULT_SIZE);
@@ -55,6 +58,10 @@ class TPCCTableGenerator : public AbstractTableGenerator {
   const time_t _current_date = std::time(nullptr);
 
  protected:
+  void _add_constraints(std::unordered_map<std::string, BenchmarkTableInfo>& table_info_by_name) const override;
+
+  const bool _enforce_primary_keys = false;
+
   template <typename T>
   std::vector<std::optional<T>> _generate_inner_order_line_column(
       std::vector<size_t> indices, OrderLineCounts order_line_counts,
@@ -0,0 +1,77 @@
+#include "cancellation_token.hpp"
+
+#include <utility>
+
+#include "hyrise.hpp"
+#include "utils/assert.hpp"
+#include "utils/settings/integral_setting.hpp"
+
+namespace {
+
+thread_local std::shared_ptr<opossum::CancellationToken> scoped_cancellation_token;
+
+}  // namespace
+
+namespace opossum {
+
+CancellationToken::CancellationToken(const std::chrono::steady_clock::time_point deadline) : _deadline(deadline) {}
+
+std::shared_ptr<CancellationToken> CancellationToken::create_from_settings() {
+  const auto& settings_manager = Hyrise::get().settings_manager;
+  if (!settings_manager.has_setting(STATEMENT_TIMEOUT_SETTING_NAME)) return std::make_shared<CancellationToken>();
+
+  const auto setting =
+      std::dynamic_pointer_cast<IntegralSetting>(settings_manager.get_setting(STATEMENT_TIMEOUT_SETTING_NAME));
+  Assert(setting, std::string{STATEMENT_TIMEOUT_SETTING_NAME} + " is expected to be an IntegralSetting");
+
+  const auto timeout = setting->value();
+  if (timeout <= 0) return std::make_shared<CancellationToken>();
+
+  return std::make_shared<CancellationToken>(std::chrono::steady_clock::now() + std::chrono::milliseconds{timeout});
+}
+
+void CancellationToken::cancel(const CancellationReason reason) {
+  auto expected = uint32_t{0};
+  _cancellation_state.compare_exchange_strong(expected, static_cast<uint32_t>(reason) + 1);
+}
+
+bool CancellationToken::is_cancelled() const {
+  if (_cancellation_state.load(std::memory_order_relaxed) != 0) return true;
+  return _deadline && std::chrono::steady_clock::now() >= *_deadline;
+}
+
+std::optional<CancellationReason> CancellationToken::reason() const {
+  const auto cancellation_state = _cancellation_state.load();
+  if (cancellation_state != 0) return static_cast<CancellationReason>(cancellation_state - 1);
+  if (_deadline && std::chrono::steady_clock::now() >= *_deadline) return CancellationReason::Timeout;
+  return std::nullopt;
+}
+
+std::optional<std::chrono::steady_clock::time_point> CancellationToken::deadline() const { return _deadline; }
+
+std::string CancellationToken::reason_message(const CancellationReason reason) {
+  switch (reason) {
+    case CancellationReason::User:
+      return "canceling statement due to user request";
+    case CancellationReason::Timeout:
+      return "canceling statement due to statement timeout";
+    case CancellationReason::ClientDisconnect:
+      return "canceling statement due to client disconnect";
+  }
+  Fail("Invalid enum value");
+}
+
+CancellationTokenScope::CancellationTokenScope(std::shared_ptr<CancellationToken> cancellation_token)
+    : _previous_cancellation_token(std::exchange(scoped_cancellation_token, std::move(cancellation_token))) {}
+
+CancellationTokenScope::~CancellationTokenScope() {
+  scoped_cancellation_token = std::move(_previous_cancellation_token);
+}
+
+const std::shared_ptr<CancellationToken>& CancellationTokenScope::current() { return scoped_cancellation_token; }
+
+bool CancellationTokenScope::is_cancelled() {
+  return scoped_cancellation_token && scoped_cancellation_token->is_cancelled();
+}
+
+}  // namespace opossum
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+enum class CancellationReason { User, Timeout, ClientDisconnect };
+
+/**
+ * Stops the execution of a query. All tasks of an SQLPipeline share one token: OperatorTasks of a cancelled query are
+ * released without executing their operators, and long-running operators (e.g., JoinNestedLoop and Product) check the
+ * token at chunk boundaries and stop early. The JobTasks that JoinHash and AggregateHash spawn per partition or column
+ * skip their work, too, and the operators then return incomplete results. Other JobTasks do not check the token, as
+ * either later steps rely on their results to be complete (e.g., the materialization and radix partitioning of
+ * JoinHash) or they process a single chunk only (e.g., those of TableScan and Validate). Once the tasks are done, the
+ * SQLPipelineStatement rolls back its transaction and fails.
+ *
+ * A token is cancelled explicitly (e.g., by a PostgreSQL CancelRequest) or once its deadline has passed. The deadline
+ * is configured via the "CancellationToken.statement_timeout_ms" setting, where 0 (the default) disables it. Once
+ * cancelled, a token stays cancelled.
+ */
+class CancellationToken : private Noncopyable {
+ public:
+  static constexpr auto STATEMENT_TIMEOUT_SETTING_NAME = "CancellationToken.statement_timeout_ms";
+
+  CancellationToken() = default;
+  explicit CancellationToken(const std::chrono::steady_clock::time_point deadline);
+
+  // Returns a token whose deadline is the configured statement timeout from now, or a token without deadline
+  static std::shared_ptr<CancellationToken> create_from_settings();
+
+  // Only the first cancellation determines the reason
+  void cancel(const CancellationReason reason);
+
+  bool is_cancelled() const;
+
+  // Returns std::nullopt as long as the token is not cancelled
+  std::optional<CancellationReason> reason() const;
+
+  std::optional<std::chrono::steady_clock::time_point> deadline() const;
+
+  // Human-readable description of the reason, used for error messages
+  static std::string reason_message(const CancellationReason reason);
+
+ private:
+  const std::optional<std::chrono::steady_clock::time_point> _deadline;
+
+  // 0 as long as the token was not cancelled explicitly, the CancellationReason + 1 afterwards
+  std::atomic<uint32_t> _cancellation_state{0};
+};
+
+/**
+ * Sets the token that tasks created by the calling thread get, as long as the scope is alive. AbstractTask::execute()
+ * opens a scope for the token of the task. Thus, JobTasks spawned by an operator, as well as the operator itself,
+ * find the token of their query here. Scopes can be nested, the previous token is restored on destruction.
+ */
+class CancellationTokenScope : private Noncopyable {
+ public:
+  explicit CancellationTokenScope(std::shared_ptr<CancellationToken> cancellation_token);
+  ~CancellationTokenScope();
+
+  // Returns the token of the innermost scope of the calling thread, or nullptr without a scope
+  static const std::shared_ptr<CancellationToken>& current();
+
+  // Short for checking the current token, which operators do at chunk boundaries
+  static bool is_cancelled();
+
+ private:
+  std::shared_ptr<CancellationToken> _previous_cancellation_token;
+};
+
+}  // namespace opossum
@@ -5,25 +5,33 @@
 
 namespace opossum {
 
-CommitContext::CommitContext(const CommitID commit_id) : _commit_id{commit_id}, _pending{false} {}
+CommitContext::CommitContext(const CommitID commit_id) : _commit_id{commit_id} {}
 
 CommitID CommitContext::commit_id() const { return _commit_id; }
 
-bool CommitContext::is_pending() const { return _pending; }
+void CommitContext::add_transaction() { ++_transaction_count; }
+
+size_t CommitContext::transaction_count() const { return _transaction_count; }
+
+bool CommitContext::is_pending() const {
+  return _transaction_count > 0 && _pending_transaction_count == _transaction_count;
+}
 
 void CommitContext::make_pending(const TransactionID transaction_id,
                                  const std::function<void(TransactionID)>& callback) {
+  DebugAssert(_pending_transaction_count < _transaction_count, "More transactions pending than part of the group");
+
   if (callback) {
-    _callback = [callback, transaction_id]() { callback(transaction_id); };
+    _callbacks.emplace_back([callback, transaction_id]() { callback(transaction_id); });
   }
 
-  // This line MUST be AFTER setting the callback. Otherwise we run into a race condition while committing, because this
-  // is 'pending' but the callback is not there yet.
-  _pending = true;
+  ++_pending_transaction_count;
 }
 
-void CommitContext::fire_callback() {
-  if (_callback) _callback();
+void CommitContext::fire_callbacks() {
+  for (const auto& callback : _callbacks) {
+    callback();
+  }
 }
 
 bool CommitContext::has_next() const { return next() != nullptr; }
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "types.hpp"
 
@@ -13,6 +14,11 @@ namespace opossum {
  * Its main purpose is to manage commit ids.
  * It is effectively part of the TransactionContext
  *
+ * Transactions that are ready to commit at the same time form a group that shares a CommitContext and thus a commit
+ * id (group commit). Each transaction writes the commit id to the MVCC data of its rows on its own. Once all of them
+ * are done, the TransactionManager makes the whole group visible by advancing the last commit id once.
+ * All members except for the atomically accessed next context are protected by the TransactionManager's commit mutex.
+ *
  * Should not be used outside the concurrency module!
  */
 class CommitContext : private Noncopyable {
@@ -21,20 +27,30 @@ class CommitContext : private Noncopyable {
 
   CommitID commit_id() const;
 
+  /**
+   * Adds a transaction to the group of transactions committing with this context's commit id
+   */
+  void add_transaction();
+
+  size_t transaction_count() const;
+
+  /**
+   * Returns true if all transactions of the group are pending, i.e., the context is ready to be committed
+   * as soon as all previous contexts have been committed.
+   */
   bool is_pending() const;
 
   /**
-   * Marks the commit context as “pending”, i.e. ready to be committed
-   * as soon as all previous pending have been committed.
+   * Marks one transaction of the group as “pending”. The context becomes pending once all transactions are.
    *
    * @param callback called when transaction is committed
    */
   void make_pending(const TransactionID transaction_id, const std::function<void(TransactionID)>& callback = nullptr);
 
   /**
-   * Calls the callback of make_pending
+   * Calls the callbacks of make_pending
    */
-  void fire_callback();
+  void fire_callbacks();
 
   bool has_next() const;
 
@@ -50,8 +66,9 @@ class CommitContext : private Noncopyable {
 
  private:
   const CommitID _commit_id;
-  std::atomic<bool> _pending;  // true if context is waiting to be committed
+  size_t _transaction_count{0};
+  size_t _pending_transaction_count{0};
   std::shared_ptr<CommitContext> _next;
-  std::function<void()> _callback;
+  std::vector<std::function<void()>> _callbacks;
 };
 }  // namespace opossum
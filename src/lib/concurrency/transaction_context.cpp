@@ -11,13 +11,16 @@
 namespace opossum {
 
 TransactionContext::TransactionContext(const TransactionID transaction_id, const CommitID snapshot_commit_id,
-                                       const AutoCommit is_auto_commit)
+                                       const AutoCommit is_auto_commit, const TransactionMode transaction_mode)
     : _transaction_id{transaction_id},
       _snapshot_commit_id{snapshot_commit_id},
       _is_auto_commit{is_auto_commit},
+      _transaction_mode{transaction_mode},
       _phase{TransactionPhase::Active},
       _num_active_operators{0} {
-  Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
+  DebugAssert(transaction_mode == TransactionMode::ReadWrite || transaction_id == INVALID_TRANSACTION_ID,
+              "Read-only transactions must not hold a transaction id");
+  _snapshot_slot = Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
 }
 
 TransactionContext::~TransactionContext() {
@@ -51,12 +54,13 @@ TransactionContext::~TransactionContext() {
    * Tell the TransactionManager, which keeps track of active snapshot-commit-ids,
    * that this transaction has finished.
    */
-  Hyrise::get().transaction_manager._deregister_transaction(_snapshot_commit_id);
+  Hyrise::get().transaction_manager._deregister_transaction(_snapshot_commit_id, _snapshot_slot);
 }
 
 TransactionID TransactionContext::transaction_id() const { return _transaction_id; }
 CommitID TransactionContext::snapshot_commit_id() const { return _snapshot_commit_id; }
 AutoCommit TransactionContext::is_auto_commit() const { return _is_auto_commit; }
+bool TransactionContext::is_read_only() const { return _transaction_mode == TransactionMode::ReadOnly; }
 
 CommitID TransactionContext::commit_id() const {
   Assert(_commit_context, "TransactionContext cid only available after commit context has been created.");
@@ -150,7 +154,7 @@ void TransactionContext::_prepare_commit() {
 
   _wait_for_active_operators_to_finish();
 
-  _commit_context = Hyrise::get().transaction_manager._new_commit_context();
+  _commit_context = Hyrise::get().transaction_manager._join_commit_context();
 }
 
 void TransactionContext::_mark_as_pending_and_try_commit(const std::function<void(TransactionID)>& callback) {
@@ -163,16 +167,15 @@ void TransactionContext::_mark_as_pending_and_try_commit(const std::function<voi
               "All read/write operators need to have been committed.");
 
   auto context_weak_ptr = std::weak_ptr<TransactionContext>{this->shared_from_this()};
-  _commit_context->make_pending(_transaction_id, [context_weak_ptr, callback](auto transaction_id) {
-    // If the transaction context still exists, set its phase to Committed.
-    if (auto context_ptr = context_weak_ptr.lock()) {
-      context_ptr->_transition(TransactionPhase::Committing, TransactionPhase::Committed);
-    }
-
-    if (callback) callback(transaction_id);
-  });
-
-  Hyrise::get().transaction_manager._try_increment_last_commit_id(_commit_context);
+  Hyrise::get().transaction_manager._make_pending_and_try_commit(
+      _commit_context, _transaction_id, [context_weak_ptr, callback](auto transaction_id) {
+        // If the transaction context still exists, set its phase to Committed.
+        if (auto context_ptr = context_weak_ptr.lock()) {
+          context_ptr->_transition(TransactionPhase::Committing, TransactionPhase::Committed);
+        }
+
+        if (callback) callback(transaction_id);
+      });
 }
 
 void TransactionContext::on_operator_started() { ++_num_active_operators; }
@@ -199,6 +202,21 @@ void TransactionContext::_transition(TransactionPhase from_phase, TransactionPha
               "Auto-commit transactions cannot be manually rolled back");
   const auto success = _phase.compare_exchange_strong(from_phase, to_phase);
   Assert(success, "Illegal phase transition detected.");
+
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  switch (to_phase) {
+    case TransactionPhase::Committed:
+      transaction_manager._committed_count.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case TransactionPhase::RolledBackByUser:
+      transaction_manager._rolled_back_by_user_count.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case TransactionPhase::RolledBackAfterConflict:
+      transaction_manager._rolled_back_after_conflict_count.fetch_add(1, std::memory_order_relaxed);
+      break;
+    default:
+      break;
+  }
 }
 
 std::ostream& operator<<(std::ostream& stream, const TransactionPhase& phase) {
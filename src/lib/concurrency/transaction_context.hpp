@@ -62,7 +62,8 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
   friend class TransactionManager;
 
  public:
-  TransactionContext(TransactionID transaction_id, CommitID snapshot_commit_id, AutoCommit is_auto_commit);
+  TransactionContext(TransactionID transaction_id, CommitID snapshot_commit_id, AutoCommit is_auto_commit,
+                     TransactionMode transaction_mode = TransactionMode::ReadWrite);
   ~TransactionContext();
 
   /**
@@ -88,6 +89,13 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
    */
   AutoCommit is_auto_commit() const;
 
+  /**
+   * Read-only transactions have no transaction id (i.e., INVALID_TRANSACTION_ID) and cannot execute read-write
+   * operators. As they neither lock rows nor see uncommitted changes, the visibility of a row only depends on its
+   * begin and end commit ids.
+   */
+  bool is_read_only() const;
+
   /**
    * Returns the current phase of the transaction
    */
@@ -168,7 +176,8 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
 
   /**
    * Sets transaction phase to Committing.
-   * Creates a new commit context and assigns a new commit id.
+   * Joins a commit context and thereby gets a commit id, which might be
+   * shared with other transactions committing at the same time.
    * All operators within this context must be finished and
    * none of the registered operators should have failed when
    * calling this function.
@@ -179,8 +188,9 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
    * Sets transaction phase to Pending.
    * Tries to commit transaction and all following
    * transactions also marked as “pending”. If there are
-   * uncommitted transaction with a smaller commit id, it
-   * will be committed after those.
+   * uncommitted transaction with a smaller commit id or
+   * transactions in the same commit context that are not
+   * pending yet, it will be committed after those.
    *
    * @param callback called when transaction is committed
    */
@@ -198,7 +208,10 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
  private:
   const TransactionID _transaction_id;
   const CommitID _snapshot_commit_id;
+  // Slot in the TransactionManager in which the snapshot commit id is registered
+  size_t _snapshot_slot;
   const AutoCommit _is_auto_commit;
+  const TransactionMode _transaction_mode;
 
   std::vector<std::shared_ptr<AbstractReadWriteOperator>> _read_write_operators;
 
@@ -1,19 +1,27 @@
 #include "transaction_manager.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include "commit_context.hpp"
+#include "hyrise.hpp"
 #include "storage/mvcc_data.hpp"
 #include "transaction_context.hpp"
 #include "utils/assert.hpp"
+#include "utils/settings/integral_setting.hpp"
 
 namespace opossum {
 
 TransactionManager::TransactionManager()
     : _next_transaction_id{INITIAL_TRANSACTION_ID},
       _last_commit_id{INITIAL_COMMIT_ID},
-      _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)} {}
+      _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)},
+      _last_committed_commit_context{_last_commit_context} {}
 
 TransactionManager::~TransactionManager() {
-  Assert(_active_snapshot_commit_ids.empty(),
+  Assert(std::all_of(_snapshot_slots.cbegin(), _snapshot_slots.cend(),
+                     [](const auto& slot) { return slot.snapshot_commit_id == FREE_SNAPSHOT_SLOT; }) &&
+             _overflow_snapshot_commit_ids.empty(),
          "Some transactions do not seem to have finished yet as they are still registered as active.");
 }
 
@@ -21,103 +29,164 @@ TransactionManager& TransactionManager::operator=(TransactionManager&& transacti
   _next_transaction_id = transaction_manager._next_transaction_id.load();
   _last_commit_id = transaction_manager._last_commit_id.load();
   _last_commit_context = transaction_manager._last_commit_context;
-  _active_snapshot_commit_ids = transaction_manager._active_snapshot_commit_ids;
+  _last_committed_commit_context = transaction_manager._last_committed_commit_context;
+  for (auto slot = size_t{0}; slot < SNAPSHOT_SLOT_COUNT; ++slot) {
+    _snapshot_slots[slot].snapshot_commit_id = transaction_manager._snapshot_slots[slot].snapshot_commit_id.load();
+  }
+  _snapshot_slot_watermark = transaction_manager._snapshot_slot_watermark.load();
+  _overflow_snapshot_commit_ids = transaction_manager._overflow_snapshot_commit_ids;
+  _committed_count = transaction_manager._committed_count.load();
+  _rolled_back_by_user_count = transaction_manager._rolled_back_by_user_count.load();
+  _rolled_back_after_conflict_count = transaction_manager._rolled_back_after_conflict_count.load();
+  _lock_wait_count = transaction_manager._lock_wait_count.load();
+  _failed_lock_wait_count = transaction_manager._failed_lock_wait_count.load();
   return *this;
 }
 
 CommitID TransactionManager::last_commit_id() const { return _last_commit_id; }
 
-std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context(const AutoCommit auto_commit) {
+std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context(
+    const AutoCommit auto_commit, const TransactionMode transaction_mode) {
   const TransactionID snapshot_commit_id = _last_commit_id;
+  if (transaction_mode == TransactionMode::ReadOnly) {
+    return std::make_shared<TransactionContext>(INVALID_TRANSACTION_ID, snapshot_commit_id, auto_commit,
+                                                TransactionMode::ReadOnly);
+  }
   return std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id, auto_commit);
 }
 
-void TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
-  _active_snapshot_commit_ids.insert(snapshot_commit_id);
-}
+size_t TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
+  DebugAssert(snapshot_commit_id != FREE_SNAPSHOT_SLOT, "Snapshot commit ID collides with the free slot marker");
 
-void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
+  // Each thread starts looking for a free slot at a different position. As long as there are fewer threads than slots
+  // and each thread only runs one transaction at a time, every thread finds its preferred slot to be free.
+  static auto next_preferred_slot = std::atomic<size_t>{0};
+  thread_local const auto preferred_slot = next_preferred_slot++ % SNAPSHOT_SLOT_COUNT;
 
-  auto it = std::find(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end(), snapshot_commit_id);
+  for (auto offset = size_t{0}; offset < SNAPSHOT_SLOT_COUNT; ++offset) {
+    const auto slot = (preferred_slot + offset) % SNAPSHOT_SLOT_COUNT;
+    auto& slot_commit_id = _snapshot_slots[slot].snapshot_commit_id;
+    if (slot_commit_id.load(std::memory_order_relaxed) != FREE_SNAPSHOT_SLOT) continue;
 
-  if (it != _active_snapshot_commit_ids.end()) {
-    _active_snapshot_commit_ids.erase(it);
-    return;
+    // Raise the watermark before claiming the slot so that a concurrent scan cannot miss the new snapshot
+    auto watermark = _snapshot_slot_watermark.load();
+    while (watermark <= slot && !_snapshot_slot_watermark.compare_exchange_weak(watermark, slot + 1)) {}
+
+    auto expected_commit_id = FREE_SNAPSHOT_SLOT;
+    if (slot_commit_id.compare_exchange_strong(expected_commit_id, snapshot_commit_id)) return slot;
   }
 
-  Assert(
-      it == _active_snapshot_commit_ids.end(),
-      "Could not find snapshot_commit_id in TransactionManager's _active_snapshot_commit_ids. Therefore, the removal "
-      "failed and the function should not have been called.");
+  std::lock_guard<std::mutex> lock(_mutex_overflow_snapshot_commit_ids);
+  _overflow_snapshot_commit_ids.insert(snapshot_commit_id);
+  return OVERFLOW_SNAPSHOT_SLOT;
 }
 
-std::optional<CommitID> TransactionManager::get_lowest_active_snapshot_commit_id() const {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
-
-  if (_active_snapshot_commit_ids.empty()) {
-    return std::nullopt;
+void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id, const size_t snapshot_slot) {
+  if (snapshot_slot != OVERFLOW_SNAPSHOT_SLOT) {
+    DebugAssert(snapshot_slot < SNAPSHOT_SLOT_COUNT, "Invalid snapshot slot");
+    DebugAssert(_snapshot_slots[snapshot_slot].snapshot_commit_id == snapshot_commit_id,
+                "Snapshot slot is not held by the given snapshot_commit_id");
+    _snapshot_slots[snapshot_slot].snapshot_commit_id = FREE_SNAPSHOT_SLOT;
+    return;
   }
 
-  auto it = std::min_element(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end());
-  return *it;
+  std::lock_guard<std::mutex> lock(_mutex_overflow_snapshot_commit_ids);
+
+  const auto it = _overflow_snapshot_commit_ids.find(snapshot_commit_id);
+  Assert(it != _overflow_snapshot_commit_ids.end(),
+         "Could not find snapshot_commit_id in TransactionManager's _overflow_snapshot_commit_ids. Therefore, the "
+         "removal failed and the function should not have been called.");
+  _overflow_snapshot_commit_ids.erase(it);
 }
 
-/**
- * Logic of the lock-free algorithm
- *
- * Let’s say n threads call this method simultaneously. They all enter the main while-loop.
- * Eventually they reach the point where they try to set the successor of _last_commit_context
- * (pointed to by current_context). Only one of them will succeed and will be able to pass the
- * following if statement. The rest continues with the loop and will now try to get the latest
- * context, which does not have a successor. As long as the thread that succeeded setting
- * the next commit context has not finished updating _last_commit_context, they are stuck in
- * the small while-loop. As soon as it is done, _last_commit_context will point to a commit
- * context with no successor and they will be able to leave this loop.
- */
-std::shared_ptr<CommitContext> TransactionManager::_new_commit_context() {
-  auto current_context = std::atomic_load(&_last_commit_context);
-  auto next_context = std::shared_ptr<CommitContext>();
-
-  auto success = false;
-  while (!success) {
-    while (current_context->has_next()) {
-      current_context = std::atomic_load(&_last_commit_context);
-    }
+std::optional<CommitID> TransactionManager::get_lowest_active_snapshot_commit_id() const {
+  auto lowest_snapshot_commit_id = FREE_SNAPSHOT_SLOT;
 
-    next_context = std::make_shared<CommitContext>(current_context->commit_id() + 1u);
+  const auto watermark = _snapshot_slot_watermark.load();
+  for (auto slot = size_t{0}; slot < watermark; ++slot) {
+    lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, _snapshot_slots[slot].snapshot_commit_id.load());
+  }
 
-    success = current_context->try_set_next(next_context);
+  {
+    std::lock_guard<std::mutex> lock(_mutex_overflow_snapshot_commit_ids);
+    for (const auto snapshot_commit_id : _overflow_snapshot_commit_ids) {
+      lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, snapshot_commit_id);
+    }
+  }
 
-    if (!success) continue;
+  if (lowest_snapshot_commit_id == FREE_SNAPSHOT_SLOT) return std::nullopt;
+  return lowest_snapshot_commit_id;
+}
 
-    /**
-     * Only one thread at a time can ever reach this code since only one thread
-     * succeeds to set _last_commit_context’s successor.
-     */
-    success = std::atomic_compare_exchange_strong(&_last_commit_context, &current_context, next_context);
+std::shared_ptr<CommitContext> TransactionManager::_join_commit_context() {
+  std::lock_guard<std::mutex> lock(_commit_mutex);
 
-    Assert(success, "Invariant violated.");
+  // The context that is committed next (i.e., the successor of the last committed one) is closed, so that new
+  // transactions cannot delay it. All later contexts have to wait for it anyway, so transactions can still join them.
+  if (_last_commit_context->commit_id() > _last_committed_commit_context->commit_id() + 1) {
+    _last_commit_context->add_transaction();
+    return _last_commit_context;
   }
 
+  const auto next_context = std::make_shared<CommitContext>(_last_commit_context->commit_id() + 1u);
+  const auto success = _last_commit_context->try_set_next(next_context);
+  Assert(success, "Invariant violated.");
+
+  _last_commit_context = next_context;
+  next_context->add_transaction();
   return next_context;
 }
 
-void TransactionManager::_try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context) {
-  auto current_context = context;
+void TransactionManager::_make_pending_and_try_commit(const std::shared_ptr<CommitContext>& context,
+                                                      const TransactionID transaction_id,
+                                                      const std::function<void(TransactionID)>& callback) {
+  auto committed_contexts = std::vector<std::shared_ptr<CommitContext>>{};
+
+  {
+    std::lock_guard<std::mutex> lock(_commit_mutex);
+    context->make_pending(transaction_id, callback);
+
+    // All transactions of the committed contexts have written their commit id to the MVCC data before making the
+    // context pending. Acquiring the mutex ensures that these writes become visible before _last_commit_id does.
+    auto next_context = _last_committed_commit_context->next();
+    while (next_context && next_context->is_pending()) {
+      _last_commit_id = next_context->commit_id();
+      _last_committed_commit_context = next_context;
+      committed_contexts.emplace_back(next_context);
+      next_context = next_context->next();
+    }
+  }
+
+  // Callbacks are fired outside of the mutex, as they might start new transactions
+  for (const auto& committed_context : committed_contexts) {
+    committed_context->fire_callbacks();
+  }
+}
 
-  while (current_context->is_pending()) {
-    auto expected_last_commit_id = current_context->commit_id() - 1;
+std::chrono::milliseconds TransactionManager::lock_wait_timeout() const {
+  const auto& settings_manager = Hyrise::get().settings_manager;
+  if (!settings_manager.has_setting(LOCK_WAIT_TIMEOUT_SETTING_NAME)) return std::chrono::milliseconds{0};
 
-    if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, current_context->commit_id())) return;
+  const auto setting =
+      std::dynamic_pointer_cast<IntegralSetting>(settings_manager.get_setting(LOCK_WAIT_TIMEOUT_SETTING_NAME));
+  Assert(setting, std::string{LOCK_WAIT_TIMEOUT_SETTING_NAME} + " is expected to be an IntegralSetting");
 
-    current_context->fire_callback();
+  return std::chrono::milliseconds{std::max(setting->value(), int64_t{0})};
+}
 
-    if (!current_context->has_next()) return;
+TransactionStatistics TransactionManager::statistics() const {
+  auto statistics = TransactionStatistics{};
+  statistics.committed_count = _committed_count.load(std::memory_order_relaxed);
+  statistics.rolled_back_by_user_count = _rolled_back_by_user_count.load(std::memory_order_relaxed);
+  statistics.rolled_back_after_conflict_count = _rolled_back_after_conflict_count.load(std::memory_order_relaxed);
+  statistics.lock_wait_count = _lock_wait_count.load(std::memory_order_relaxed);
+  statistics.failed_lock_wait_count = _failed_lock_wait_count.load(std::memory_order_relaxed);
+  return statistics;
+}
 
-    current_context = current_context->next();
-  }
+void TransactionManager::register_lock_wait(const bool acquired) {
+  _lock_wait_count.fetch_add(1, std::memory_order_relaxed);
+  if (!acquired) _failed_lock_wait_count.fetch_add(1, std::memory_order_relaxed);
 }
 
 }  // namespace opossum
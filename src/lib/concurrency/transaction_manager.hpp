@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_set>
 
 #include "types.hpp"
@@ -34,6 +38,22 @@
  * TransactionContext contains data used by a transaction, mainly its ID, the snapshot commit ID explained above, and,
  * when it enters the commit phase, the TransactionManager gives it a CommitContext, which contains
  * a new commit ID that is used to make its changes visible to others.
+ *
+ * Transactions that enter the commit phase while an earlier commit is still in progress are grouped into the same
+ * CommitContext and share its commit ID (group commit). Thus, the last commit ID is advanced once per group instead
+ * of once per transaction. This does not change visibility, as transactions committing concurrently cannot have
+ * modified the same rows.
+ *
+ * To find out which row versions are no longer visible to any transaction (e.g., for the MvccDeletePlugin), the
+ * TransactionManager tracks the snapshot commit IDs of all active transactions. Each transaction registers its
+ * snapshot commit ID in one of a fixed number of cache-line-sized slots, preferably the one assigned to the current
+ * thread. Thus, beginning and ending a transaction neither takes a lock nor contends with other threads. The lowest
+ * active snapshot commit ID is only computed when it is requested, by scanning the slots.
+ *
+ * Delete locks its rows in the order of their RowIDs, so that concurrent deletes of overlapping rows do not lock them
+ * in opposite orders. If a row is locked by another transaction, the operator fails right away by default. Optionally
+ * (see lock_wait_timeout()), it waits for a while instead, as the other transaction might still roll back and release
+ * the lock.
  */
 
 namespace opossum {
@@ -41,6 +61,16 @@ namespace opossum {
 class CommitContext;
 class TransactionContext;
 
+// Counts of finished transactions and lock waits since the start of the database, see MetaTransactionsTable
+struct TransactionStatistics {
+  uint64_t committed_count{0};
+  uint64_t rolled_back_by_user_count{0};
+  uint64_t rolled_back_after_conflict_count{0};
+  uint64_t lock_wait_count{0};
+  // Waits that timed out or ended with the other transaction committing, i.e., that did not prevent the conflict
+  uint64_t failed_lock_wait_count{0};
+};
+
 /**
  * The TransactionManager is responsible for a consistent assignment of
  * transaction and commit ids. It also keeps track of the last commit id
@@ -58,14 +88,35 @@ class TransactionManager : public Noncopyable {
    * @param is_auto_commit declares whether the transaction is created (and will also commit) automatically. The
    * alternative would be that it was created through a user command (BEGIN). This information is used by the
    * SQLPipelineStatement to auto-commit the transaction - the transaction does not commit itself.
+   * @param transaction_mode declares whether the transaction may modify data. Read-only transactions do not draw a
+   * transaction id, as they never lock rows. Their snapshot commit id is registered nonetheless so that the row
+   * versions they might see are not cleaned up.
    */
-  std::shared_ptr<TransactionContext> new_transaction_context(const AutoCommit auto_commit);
+  std::shared_ptr<TransactionContext> new_transaction_context(
+      const AutoCommit auto_commit, const TransactionMode transaction_mode = TransactionMode::ReadWrite);
 
   /**
-   * Returns the lowest snapshot-commit-id currently used by a transaction.
+   * Returns the lowest snapshot-commit-id currently used by a transaction. As this scans all snapshot slots, it should
+   * not be called for every transaction.
    */
   std::optional<CommitID> get_lowest_active_snapshot_commit_id() const;
 
+  /**
+   * Returns how long an operator waits for a row lock held by another transaction before it gives up and fails. A
+   * timeout of zero (the default) disables waiting.
+   */
+  std::chrono::milliseconds lock_wait_timeout() const;
+
+  static constexpr auto LOCK_WAIT_TIMEOUT_SETTING_NAME = "TransactionManager.lock_wait_timeout_ms";
+
+  TransactionStatistics statistics() const;
+
+  /**
+   * Called by operators that waited for a row lock. @param acquired tells whether the lock was released without the
+   * row being modified, so that the waiting operator could lock it.
+   */
+  void register_lock_wait(const bool acquired);
+
  private:
   TransactionManager();
   ~TransactionManager();
@@ -75,17 +126,29 @@ class TransactionManager : public Noncopyable {
 
   TransactionManager& operator=(TransactionManager&& transaction_manager) noexcept;
 
-  std::shared_ptr<CommitContext> _new_commit_context();
-  void _try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context);
+  /**
+   * Returns the CommitContext that a transaction entering the commit phase belongs to. This is either the last one
+   * (if it waits for earlier ones to be committed anyway) or a new one.
+   */
+  std::shared_ptr<CommitContext> _join_commit_context();
+
+  /**
+   * Marks the transaction as pending in its CommitContext and commits all CommitContexts that are ready, in the
+   * order of their commit ids.
+   */
+  void _make_pending_and_try_commit(const std::shared_ptr<CommitContext>& context, TransactionID transaction_id,
+                                    const std::function<void(TransactionID)>& callback);
 
   /**
    * The TransactionManager keeps track of issued snapshot-commit-ids,
    * which are in use by unfinished transactions.
-   * The following two functions are used to keep the multiset of active
-   * snapshot-commit-ids up to date.
+   * The following two functions are used to keep the set of active
+   * snapshot-commit-ids up to date. _register_transaction returns the slot
+   * in which the snapshot-commit-id was stored, which has to be passed to
+   * _deregister_transaction.
    */
-  void _register_transaction(CommitID snapshot_commit_id);
-  void _deregister_transaction(CommitID snapshot_commit_id);
+  size_t _register_transaction(CommitID snapshot_commit_id);
+  void _deregister_transaction(CommitID snapshot_commit_id, size_t snapshot_slot);
 
   std::atomic<TransactionID> _next_transaction_id;
 
@@ -94,9 +157,39 @@ class TransactionManager : public Noncopyable {
   // been there "from the beginning of time".
   static constexpr auto INITIAL_COMMIT_ID = CommitID{1};
 
-  std::shared_ptr<CommitContext> _last_commit_context;
+  // Protects the chain of CommitContexts and serializes updates of _last_commit_id. Reading _last_commit_id does not
+  // require the mutex.
+  std::mutex _commit_mutex;
 
-  mutable std::mutex _mutex_active_snapshot_commit_ids;
-  std::unordered_multiset<CommitID> _active_snapshot_commit_ids;
+  // The last CommitContext that has been created and the last one that has been committed
+  std::shared_ptr<CommitContext> _last_commit_context;
+  std::shared_ptr<CommitContext> _last_committed_commit_context;
+
+  static constexpr auto FREE_SNAPSHOT_SLOT = std::numeric_limits<CommitID>::max();
+  static constexpr auto SNAPSHOT_SLOT_COUNT = size_t{256};
+  static constexpr auto OVERFLOW_SNAPSHOT_SLOT = std::numeric_limits<size_t>::max();
+
+  // Each slot holds the snapshot commit ID of at most one active transaction. Slots are aligned to cache lines so that
+  // threads registering in neighboring slots do not invalidate each other's caches.
+  struct alignas(64) SnapshotSlot {
+    std::atomic<CommitID> snapshot_commit_id{FREE_SNAPSHOT_SLOT};
+  };
+
+  std::array<SnapshotSlot, SNAPSHOT_SLOT_COUNT> _snapshot_slots;
+
+  // All slots with an index below the watermark might be in use. It only grows, but is usually limited by the number
+  // of threads, which keeps get_lowest_active_snapshot_commit_id() from scanning unused slots.
+  std::atomic<size_t> _snapshot_slot_watermark{0};
+
+  // If more transactions than SNAPSHOT_SLOT_COUNT are active at the same time, the remaining ones are registered here
+  mutable std::mutex _mutex_overflow_snapshot_commit_ids;
+  std::unordered_multiset<CommitID> _overflow_snapshot_commit_ids;
+
+  // Counters for statistics(), updated with relaxed increments as they are only read for monitoring
+  std::atomic<uint64_t> _committed_count{0};
+  std::atomic<uint64_t> _rolled_back_by_user_count{0};
+  std::atomic<uint64_t> _rolled_back_after_conflict_count{0};
+  std::atomic<uint64_t> _lock_wait_count{0};
+  std::atomic<uint64_t> _failed_lock_wait_count{0};
 };
 }  // namespace opossum
@@ -0,0 +1,341 @@
+#include "cost_estimator_physical.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+
+#include "expression/abstract_predicate_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/operator_join_predicate.hpp"
+#include "statistics/abstract_cardinality_estimator.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+double n_log_n(const double row_count) { return row_count * std::log2(std::max(row_count, 1.0)); }
+
+// The stored segments that a TableScan reads, described by the share of rows per encoding in segments that are not
+// sorted by the scanned column, and by the row share and number of chunks that are sorted by it.
+struct ScannedSegments {
+  std::map<EncodingType, double> unsorted_row_shares;
+  double sorted_row_share{0.0};
+  size_t sorted_chunk_count{0};
+};
+
+std::optional<ScannedSegments> get_scanned_segments(const PredicateNode& predicate_node) {
+  const auto predicate = std::dynamic_pointer_cast<AbstractPredicateExpression>(predicate_node.predicate());
+  if (!predicate || predicate->arguments.empty()) return std::nullopt;
+
+  const auto column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(predicate->arguments[0]);
+  if (!column_expression) return std::nullopt;
+
+  const auto stored_table_node =
+      std::dynamic_pointer_cast<const StoredTableNode>(column_expression->column_reference.original_node());
+  if (!stored_table_node || !Hyrise::get().storage_manager.has_table(stored_table_node->table_name)) {
+    return std::nullopt;
+  }
+
+  const auto table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+  const auto column_id = column_expression->column_reference.original_column_id();
+  const auto& pruned_chunk_ids = stored_table_node->pruned_chunk_ids();
+
+  // The TableScan only uses the binary search on data tables, i.e., if it directly follows the StoredTableNode
+  const auto scans_data_table = predicate_node.left_input().get() == stored_table_node.get();
+
+  auto scanned_segments = ScannedSegments{};
+  auto row_count = size_t{0};
+
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk || std::binary_search(pruned_chunk_ids.begin(), pruned_chunk_ids.end(), chunk_id)) continue;
+
+    const auto chunk_size = chunk->size();
+    row_count += chunk_size;
+
+    const auto& ordered_by = chunk->ordered_by();
+    if (scans_data_table && ordered_by && ordered_by->first == column_id) {
+      scanned_segments.sorted_row_share += chunk_size;
+      ++scanned_segments.sorted_chunk_count;
+    } else {
+      const auto encoding_type = get_segment_encoding_spec(chunk->get_segment(column_id)).encoding_type;
+      scanned_segments.unsorted_row_shares[encoding_type] += chunk_size;
+    }
+  }
+
+  if (row_count == 0) return std::nullopt;
+
+  scanned_segments.sorted_row_share /= static_cast<double>(row_count);
+  for (auto& [encoding_type, row_share] : scanned_segments.unsorted_row_shares) {
+    row_share /= static_cast<double>(row_count);
+  }
+
+  return scanned_segments;
+}
+
+}  // namespace
+
+namespace opossum {
+
+CostEstimatorPhysical::CostEstimatorPhysical(
+    const std::shared_ptr<AbstractCardinalityEstimator>& init_cardinality_estimator,
+    const std::shared_ptr<const CostModelCoefficients>& init_coefficients)
+    : AbstractCostEstimator(init_cardinality_estimator), coefficients(init_coefficients) {
+  Assert(coefficients, "CostEstimatorPhysical requires coefficients");
+}
+
+std::shared_ptr<AbstractCostEstimator> CostEstimatorPhysical::new_instance() const {
+  return std::make_shared<CostEstimatorPhysical>(cardinality_estimator->new_instance(), coefficients);
+}
+
+Cost CostEstimatorPhysical::estimate_node_cost(const std::shared_ptr<AbstractLQPNode>& node) const {
+  switch (node->type) {
+    case LQPNodeType::Join: {
+      const auto join_node = std::static_pointer_cast<JoinNode>(node);
+      if (join_node->join_mode == JoinMode::Cross) break;
+
+      auto cost = std::numeric_limits<Cost>::max();
+      for (const auto join_type : supported_join_types(*join_node)) {
+        cost = std::min(cost, estimate_join_cost(join_node, join_type));
+      }
+      if (join_node->table_hash_index_side) {
+        cost = std::min(cost, estimate_join_cost(join_node, OperatorType::JoinIndex));
+      }
+      return cost;
+    }
+
+    case LQPNodeType::Aggregate: {
+      const auto aggregate_node = std::static_pointer_cast<AggregateNode>(node);
+      return std::min(estimate_aggregate_cost(aggregate_node, AggregateOperatorType::Hash),
+                      estimate_aggregate_cost(aggregate_node, AggregateOperatorType::Sort));
+    }
+
+    case LQPNodeType::Predicate: {
+      const auto predicate_node = std::static_pointer_cast<PredicateNode>(node);
+      const auto table_scan_cost = estimate_table_scan_cost(predicate_node);
+      if (predicate_node->scan_type == ScanType::IndexScan) {
+        return std::min(table_scan_cost, estimate_index_scan_cost(predicate_node));
+      }
+      return table_scan_cost;
+    }
+
+    case LQPNodeType::Sort:
+      return apply_cost_function(coefficients->sort,
+                                 sort_features(cardinality_estimator->estimate_cardinality(node->left_input())));
+
+    default:
+      break;
+  }
+
+  const auto left_input_row_count =
+      node->left_input() ? cardinality_estimator->estimate_cardinality(node->left_input()) : 0.0f;
+  const auto right_input_row_count =
+      node->right_input() ? cardinality_estimator->estimate_cardinality(node->right_input()) : 0.0f;
+  const auto output_row_count = cardinality_estimator->estimate_cardinality(node);
+
+  return apply_cost_function(coefficients->other, {left_input_row_count + right_input_row_count, output_row_count});
+}
+
+Cost CostEstimatorPhysical::estimate_join_cost(const std::shared_ptr<JoinNode>& join_node,
+                                               const OperatorType join_type) const {
+  const auto left_row_count = double{cardinality_estimator->estimate_cardinality(join_node->left_input())};
+  const auto right_row_count = double{cardinality_estimator->estimate_cardinality(join_node->right_input())};
+  const auto output_row_count = double{cardinality_estimator->estimate_cardinality(join_node)};
+
+  switch (join_type) {
+    case OperatorType::JoinHash: {
+      // See JoinHash::_on_execute for how the build side is chosen
+      auto build_left = false;
+      if (join_node->join_mode == JoinMode::Inner) {
+        build_left = left_row_count <= right_row_count;
+      } else if (join_node->join_mode == JoinMode::Right) {
+        build_left = true;
+      }
+
+      const auto build_row_count = build_left ? left_row_count : right_row_count;
+      const auto probe_row_count = build_left ? right_row_count : left_row_count;
+      return apply_cost_function(coefficients->join_hash,
+                                 join_hash_features(build_row_count, probe_row_count, output_row_count));
+    }
+
+    case OperatorType::JoinSortMerge:
+      return apply_cost_function(coefficients->join_sort_merge,
+                                 join_sort_merge_features(left_row_count, right_row_count, output_row_count));
+
+    case OperatorType::JoinNestedLoop:
+      return apply_cost_function(coefficients->join_nested_loop, {left_row_count * right_row_count, output_row_count});
+
+    case OperatorType::JoinIndex: {
+      Assert(join_node->table_hash_index_side, "Only joins on a table hash index can be estimated as JoinIndex");
+      const auto probe_row_count = *join_node->table_hash_index_side == IndexSide::Left ? right_row_count
+                                                                                         : left_row_count;
+      return apply_cost_function(coefficients->join_index, {probe_row_count, output_row_count});
+    }
+
+    default:
+      Fail("Unexpected join operator type");
+  }
+}
+
+Cost CostEstimatorPhysical::estimate_aggregate_cost(const std::shared_ptr<AggregateNode>& aggregate_node,
+                                                    const AggregateOperatorType aggregate_type) const {
+  const auto input_row_count = double{cardinality_estimator->estimate_cardinality(aggregate_node->left_input())};
+  const auto output_row_count = double{cardinality_estimator->estimate_cardinality(aggregate_node)};
+
+  switch (aggregate_type) {
+    case AggregateOperatorType::Hash:
+      return apply_cost_function(coefficients->aggregate_hash, {input_row_count, output_row_count});
+    case AggregateOperatorType::Sort:
+      return apply_cost_function(coefficients->aggregate_sort,
+                                 aggregate_sort_features(input_row_count, output_row_count));
+  }
+  Fail("Invalid enum value");
+}
+
+Cost CostEstimatorPhysical::estimate_table_scan_cost(const std::shared_ptr<PredicateNode>& predicate_node) const {
+  const auto input_row_count = double{cardinality_estimator->estimate_cardinality(predicate_node->left_input())};
+  const auto output_row_count = double{cardinality_estimator->estimate_cardinality(predicate_node)};
+
+  const auto& table_scan_coefficients = coefficients->table_scan;
+  const auto& unencoded_coefficients = table_scan_coefficients.at(EncodingType::Unencoded);
+
+  // Scans on anything but a stored column (e.g., on the result of a projection) read unencoded segments
+  const auto scanned_segments = get_scanned_segments(*predicate_node);
+  if (!scanned_segments) return apply_cost_function(unencoded_coefficients, {input_row_count, output_row_count});
+
+  auto cost = Cost{0};
+  for (const auto& [encoding_type, row_share] : scanned_segments->unsorted_row_shares) {
+    const auto coefficients_iter = table_scan_coefficients.find(encoding_type);
+    const auto& encoding_coefficients =
+        coefficients_iter != table_scan_coefficients.end() ? coefficients_iter->second : unencoded_coefficients;
+    cost += apply_cost_function(encoding_coefficients, {input_row_count * row_share, output_row_count * row_share});
+  }
+
+  if (scanned_segments->sorted_chunk_count > 0) {
+    cost += apply_cost_function(coefficients->table_scan_sorted,
+                                {static_cast<double>(scanned_segments->sorted_chunk_count),
+                                 output_row_count * scanned_segments->sorted_row_share});
+  }
+
+  return cost;
+}
+
+Cost CostEstimatorPhysical::estimate_index_scan_cost(const std::shared_ptr<PredicateNode>& predicate_node) const {
+  Assert(predicate_node->left_input()->type == LQPNodeType::StoredTable, "IndexScan must follow a StoredTableNode.");
+  const auto stored_table_node = std::static_pointer_cast<StoredTableNode>(predicate_node->left_input());
+  const auto output_row_count = double{cardinality_estimator->estimate_cardinality(predicate_node)};
+
+  // A table hash index on exactly the columns of the predicate is answered by a single lookup (see LQPTranslator)
+  auto predicate_column_ids = std::set<ColumnID>{};
+  auto predicate_expression = predicate_node->predicate();
+  visit_expression(predicate_expression, [&](const auto& sub_expression) {
+    if (sub_expression->type == ExpressionType::LQPColumn) {
+      predicate_column_ids.emplace(stored_table_node->get_column_id(*sub_expression));
+    }
+    return ExpressionVisitation::VisitArguments;
+  });
+
+  for (const auto& index_column_ids : stored_table_node->table_hash_indexes_column_ids()) {
+    if (std::set<ColumnID>(index_column_ids.begin(), index_column_ids.end()) == predicate_column_ids) {
+      return apply_cost_function(coefficients->index_scan, {1.0, output_row_count});
+    }
+  }
+
+  // Otherwise, the chunks with a GroupKey index on the scanned column are looked up one by one while the remaining
+  // chunks are handled by a TableScan
+  const auto predicate = std::dynamic_pointer_cast<AbstractPredicateExpression>(predicate_node->predicate());
+  Assert(predicate && !predicate->arguments.empty(), "Expected predicate with arguments");
+  const auto column_ids = std::vector<ColumnID>{stored_table_node->get_column_id(*predicate->arguments[0])};
+
+  const auto table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+  auto indexed_chunk_count = size_t{0};
+  auto indexed_row_count = size_t{0};
+  auto row_count = size_t{0};
+
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    row_count += chunk->size();
+    if (chunk->get_index(SegmentIndexType::GroupKey, column_ids)) {
+      ++indexed_chunk_count;
+      indexed_row_count += chunk->size();
+    }
+  }
+
+  const auto indexed_row_share = row_count > 0 ? static_cast<double>(indexed_row_count) / row_count : 0.0;
+  return apply_cost_function(coefficients->index_scan,
+                             {static_cast<double>(indexed_chunk_count), output_row_count * indexed_row_share}) +
+         static_cast<Cost>(1.0 - indexed_row_share) * estimate_table_scan_cost(predicate_node);
+}
+
+std::vector<OperatorType> CostEstimatorPhysical::supported_join_types(const JoinNode& join_node) {
+  Assert(!join_node.join_predicates().empty(), "Expected predicated join");
+
+  const auto& primary_predicate_expression = *join_node.join_predicates().front();
+  const auto primary_join_predicate =
+      OperatorJoinPredicate::from_expression(primary_predicate_expression, *join_node.left_input(),
+                                             *join_node.right_input());
+  Assert(primary_join_predicate, "Couldn't translate join predicate: " + primary_predicate_expression.as_column_name());
+
+  const auto configuration = JoinConfiguration{join_node.join_mode, primary_join_predicate->predicate_condition,
+                                               primary_predicate_expression.arguments[0]->data_type(),
+                                               primary_predicate_expression.arguments[1]->data_type(),
+                                               join_node.join_predicates().size() > 1};
+
+  auto join_types = std::vector<OperatorType>{};
+  if (JoinHash::supports(configuration)) join_types.emplace_back(OperatorType::JoinHash);
+  if (JoinSortMerge::supports(configuration)) join_types.emplace_back(OperatorType::JoinSortMerge);
+  if (JoinNestedLoop::supports(configuration)) join_types.emplace_back(OperatorType::JoinNestedLoop);
+  return join_types;
+}
+
+std::vector<double> CostEstimatorPhysical::join_hash_features(const double build_row_count,
+                                                              const double probe_row_count,
+                                                              const double output_row_count) {
+  return {build_row_count, probe_row_count, output_row_count};
+}
+
+std::vector<double> CostEstimatorPhysical::join_sort_merge_features(const double left_row_count,
+                                                                    const double right_row_count,
+                                                                    const double output_row_count) {
+  return {n_log_n(left_row_count) + n_log_n(right_row_count), left_row_count + right_row_count, output_row_count};
+}
+
+std::vector<double> CostEstimatorPhysical::aggregate_sort_features(const double input_row_count,
+                                                                   const double output_row_count) {
+  return {n_log_n(input_row_count), input_row_count, output_row_count};
+}
+
+std::vector<double> CostEstimatorPhysical::sort_features(const double input_row_count) {
+  return {n_log_n(input_row_count), input_row_count};
+}
+
+Cost CostEstimatorPhysical::apply_cost_function(const CostFunctionCoefficients& coefficients,
+                                                const std::vector<double>& features) {
+  DebugAssert(coefficients.size() == features.size(), "Expected one coefficient per cost feature");
+
+  auto cost = 0.0;
+  for (auto feature_idx = size_t{0}; feature_idx < features.size(); ++feature_idx) {
+    cost += coefficients[feature_idx] * features[feature_idx];
+  }
+  return static_cast<Cost>(cost);
+}
+
+}  // namespace opossum
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "abstract_cost_estimator.hpp"
+#include "cost_model_coefficients.hpp"
+#include "operators/abstract_operator.hpp"
+
+namespace opossum {
+
+class AggregateNode;
+class JoinNode;
+class PredicateNode;
+
+// Both aggregate operators share OperatorType::Aggregate
+enum class AggregateOperatorType { Hash, Sort };
+
+/**
+ * Cost model that predicts the runtime of the physical operators (in nanoseconds) that a node can be translated to.
+ * Each operator implementation has a linear cost function over a few features, mostly the estimated input and output
+ * cardinalities (see CostModelCoefficients). Table scans are further distinguished by the encoding of the scanned
+ * column and by whether its chunks are sorted by it, in which case the TableScan uses a binary search.
+ *
+ * In contrast to CostEstimatorLogical, the cost of a node depends on the operator chosen for it. estimate_node_cost()
+ * returns the cost of the cheapest operator that supports the node, i.e., the one that the LQPTranslator picks when it
+ * is given the same coefficients. The estimate_*_cost() methods return the cost of a specific implementation and are
+ * used by the LQPTranslator to make that choice.
+ */
+class CostEstimatorPhysical : public AbstractCostEstimator {
+ public:
+  CostEstimatorPhysical(const std::shared_ptr<AbstractCardinalityEstimator>& init_cardinality_estimator,
+                        const std::shared_ptr<const CostModelCoefficients>& init_coefficients);
+
+  std::shared_ptr<AbstractCostEstimator> new_instance() const override;
+
+  Cost estimate_node_cost(const std::shared_ptr<AbstractLQPNode>& node) const override;
+
+  // @param join_type is one of JoinHash, JoinSortMerge, JoinNestedLoop, or JoinIndex. The latter is only valid if the
+  // table_hash_index_side of the node is set.
+  Cost estimate_join_cost(const std::shared_ptr<JoinNode>& join_node, const OperatorType join_type) const;
+
+  Cost estimate_aggregate_cost(const std::shared_ptr<AggregateNode>& aggregate_node,
+                               const AggregateOperatorType aggregate_type) const;
+
+  Cost estimate_table_scan_cost(const std::shared_ptr<PredicateNode>& predicate_node) const;
+
+  // Only valid for predicates whose input is a StoredTableNode (see LQPTranslator)
+  Cost estimate_index_scan_cost(const std::shared_ptr<PredicateNode>& predicate_node) const;
+
+  // The join operators out of JoinHash, JoinSortMerge, and JoinNestedLoop that support the (predicated) join
+  static std::vector<OperatorType> supported_join_types(const JoinNode& join_node);
+
+  /**
+   * @defgroup Cost features of the operators whose features are more than just two row counts. They are shared with
+   * CostModelCalibration so that the calibrated coefficients match the estimation.
+   * @{
+   */
+  static std::vector<double> join_hash_features(const double build_row_count, const double probe_row_count,
+                                                const double output_row_count);
+  static std::vector<double> join_sort_merge_features(const double left_row_count, const double right_row_count,
+                                                      const double output_row_count);
+  static std::vector<double> aggregate_sort_features(const double input_row_count, const double output_row_count);
+  static std::vector<double> sort_features(const double input_row_count);
+  /** @} */
+
+  // Dot product of the coefficients and the features
+  static Cost apply_cost_function(const CostFunctionCoefficients& coefficients, const std::vector<double>& features);
+
+  const std::shared_ptr<const CostModelCoefficients> coefficients;
+};
+
+}  // namespace opossum
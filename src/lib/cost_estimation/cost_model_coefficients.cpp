@@ -0,0 +1,99 @@
+#include "cost_model_coefficients.hpp"
+
+#include <fstream>
+
+#include "constant_mappings.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Calls `functor(name, coefficients)` for every cost function but the encoding-specific table scans
+template <typename Coefficients, typename Functor>
+void for_each_cost_function(Coefficients& coefficients, const Functor& functor) {
+  functor("table_scan_sorted", coefficients.table_scan_sorted);
+  functor("index_scan", coefficients.index_scan);
+  functor("join_hash", coefficients.join_hash);
+  functor("join_sort_merge", coefficients.join_sort_merge);
+  functor("join_nested_loop", coefficients.join_nested_loop);
+  functor("join_index", coefficients.join_index);
+  functor("aggregate_hash", coefficients.aggregate_hash);
+  functor("aggregate_sort", coefficients.aggregate_sort);
+  functor("sort", coefficients.sort);
+  functor("other", coefficients.other);
+}
+
+void assign_if_exists(CostFunctionCoefficients& coefficients, const nlohmann::json& json, const std::string& key) {
+  if (json.find(key) == json.end()) return;
+
+  auto new_coefficients = json.at(key).get<CostFunctionCoefficients>();
+  Assert(new_coefficients.size() == coefficients.size(),
+         "Cost model: Expected " + std::to_string(coefficients.size()) + " coefficients for " + key);
+  coefficients = std::move(new_coefficients);
+}
+
+}  // namespace
+
+namespace opossum {
+
+CostModelCoefficients::CostModelCoefficients()
+    : table_scan{{EncodingType::Unencoded, {1.0, 3.0}},       {EncodingType::Dictionary, {0.8, 3.0}},
+                 {EncodingType::RunLength, {0.6, 3.0}},       {EncodingType::FixedStringDictionary, {1.2, 3.0}},
+                 {EncodingType::FrameOfReference, {1.2, 3.0}}, {EncodingType::LZ4, {12.0, 3.0}}},
+      table_scan_sorted{2000.0, 2.0},
+      index_scan{1500.0, 6.0},
+      join_hash{25.0, 12.0, 6.0},
+      join_sort_merge{2.5, 10.0, 6.0},
+      join_nested_loop{1.5, 6.0},
+      join_index{60.0, 10.0},
+      aggregate_hash{18.0, 40.0},
+      aggregate_sort{3.0, 12.0, 20.0},
+      sort{3.0, 10.0},
+      other{2.0, 4.0} {}
+
+CostModelCoefficients CostModelCoefficients::from_json(const nlohmann::json& json) {
+  Assert(json.is_object(), "Cost model: Expected a JSON object");
+
+  auto coefficients = CostModelCoefficients{};
+
+  if (json.find("table_scan") != json.end()) {
+    const auto& table_scan_json = json.at("table_scan");
+    for (auto& [encoding_type, encoding_coefficients] : coefficients.table_scan) {
+      assign_if_exists(encoding_coefficients, table_scan_json, encoding_type_to_string.left.at(encoding_type));
+    }
+  }
+
+  for_each_cost_function(coefficients, [&](const std::string& name, CostFunctionCoefficients& function_coefficients) {
+    assign_if_exists(function_coefficients, json, name);
+  });
+
+  return coefficients;
+}
+
+CostModelCoefficients CostModelCoefficients::from_json_file(const std::string& path) {
+  auto file = std::ifstream{path};
+  Assert(file.good(), "Cost model file does not exist: " + path);
+
+  auto json = nlohmann::json{};
+  file >> json;
+  return from_json(json);
+}
+
+nlohmann::json CostModelCoefficients::to_json() const {
+  auto json = nlohmann::json::object();
+
+  auto table_scan_json = nlohmann::json::object();
+  for (const auto& [encoding_type, encoding_coefficients] : table_scan) {
+    table_scan_json[encoding_type_to_string.left.at(encoding_type)] = encoding_coefficients;
+  }
+  json["table_scan"] = table_scan_json;
+
+  for_each_cost_function(*this, [&](const std::string& name, const CostFunctionCoefficients& function_coefficients) {
+    json[name] = function_coefficients;
+  });
+
+  return json;
+}
+
+}  // namespace opossum
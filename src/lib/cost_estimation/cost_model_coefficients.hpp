@@ -0,0 +1,68 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+#include "storage/encoding_type.hpp"
+
+namespace opossum {
+
+// Coefficients of a linear cost function. The estimated runtime of an operator in nanoseconds is the dot product of
+// these coefficients and the operator's cost features, see CostEstimatorPhysical.
+using CostFunctionCoefficients = std::vector<double>;
+
+/**
+ * Coefficients of the physical cost model (see CostEstimatorPhysical), one cost function per operator implementation.
+ * The comment above each member lists the features that its coefficients are multiplied with.
+ *
+ * The default coefficients are rough figures for a current x86 server. For accurate estimates, calibrate them on the
+ * target machine with CostModelCalibration (e.g., using the hyriseCostModelCalibration binary) and load the resulting
+ * JSON file.
+ */
+struct CostModelCoefficients {
+  CostModelCoefficients();
+
+  // Members that are missing in the JSON object keep their default coefficients
+  static CostModelCoefficients from_json(const nlohmann::json& json);
+  static CostModelCoefficients from_json_file(const std::string& path);
+
+  nlohmann::json to_json() const;
+
+  // TableScan on segments that are not sorted by the scanned column, by the encoding of that column.
+  // Features: input rows, output rows
+  std::map<EncodingType, CostFunctionCoefficients> table_scan;
+
+  // TableScan on segments sorted by the scanned column (binary search). Features: input chunks, output rows
+  CostFunctionCoefficients table_scan_sorted;
+
+  // IndexScan. Features: index lookups (one per indexed chunk or one per table hash index), output rows
+  CostFunctionCoefficients index_scan;
+
+  // Features: build rows, probe rows, output rows
+  CostFunctionCoefficients join_hash;
+
+  // Features: n * log2(n) summed up over both inputs, input rows, output rows
+  CostFunctionCoefficients join_sort_merge;
+
+  // Features: row pairs, output rows
+  CostFunctionCoefficients join_nested_loop;
+
+  // JoinIndex on a table hash index. Features: probe rows, output rows
+  CostFunctionCoefficients join_index;
+
+  // Features: input rows, output rows (i.e., groups)
+  CostFunctionCoefficients aggregate_hash;
+
+  // Features: n * log2(n) of the input, input rows, output rows
+  CostFunctionCoefficients aggregate_sort;
+
+  // Features: n * log2(n) of the input, input rows
+  CostFunctionCoefficients sort;
+
+  // All other operators. Features: input rows, output rows
+  CostFunctionCoefficients other;
+};
+
+}  // namespace opossum
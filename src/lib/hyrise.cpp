@@ -1,5 +1,13 @@
 #include "hyrise.hpp"
 
+#include "concurrency/cancellation_token.hpp"
+#include "import_export/csv/csv_parser.hpp"
+#include "memory/query_memory_budget.hpp"
+#include "optimizer/adaptive_reoptimizer.hpp"
+#include "server/admission_control.hpp"
+#include "statistics/cardinality_feedback.hpp"
+#include "utils/settings/integral_setting.hpp"
+
 namespace opossum {
 
 Hyrise::Hyrise() {
@@ -21,6 +29,36 @@ Hyrise::Hyrise() {
   log_manager = LogManager{};
   topology = Topology{};
   _scheduler = std::make_shared<ImmediateExecutionScheduler>();
+  cardinality_feedback = std::make_shared<CardinalityFeedback>();
+
+  // Settings of core components are added directly, as register_at_settings_manager() would access the Hyrise instance
+  // that is still being constructed.
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      QueryMemoryBudget::SETTING_NAME, 0,
+      "Memory budget per query in bytes. Hash joins and aggregates exceeding it spill to disk. 0 disables the budget"));
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      AdaptiveReoptimizer::SETTING_NAME, 0,
+      "Re-optimize queries once a join or aggregate produces more than this many times more or fewer rows than "
+      "estimated. 0 disables the adaptive re-optimization"));
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      TransactionManager::LOCK_WAIT_TIMEOUT_SETTING_NAME, 0,
+      "Milliseconds that a Delete or Update waits for a row locked by another transaction before it fails. 0 lets "
+      "them fail right away"));
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      CancellationToken::STATEMENT_TIMEOUT_SETTING_NAME, 0,
+      "Milliseconds after which a query is cancelled and its transaction is rolled back. 0 disables the timeout"));
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      AdmissionControl::MAX_CONCURRENT_TRANSACTIONAL_SETTING_NAME, 0,
+      "Maximum number of transactional statements that the server executes concurrently. Further statements are "
+      "queued. 0 disables the limit"));
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      AdmissionControl::MAX_CONCURRENT_ANALYTICAL_SETTING_NAME, 0,
+      "Maximum number of analytical statements that the server executes concurrently. Further statements are queued. "
+      "0 disables the limit"));
+  settings_manager._add(std::make_shared<IntegralSetting>(
+      CsvParser::BUFFER_SIZE_SETTING_NAME, CsvParser::DEFAULT_BUFFER_SIZE,
+      "Bytes of a CSV file that an import reads and parses at once. The buffer is enlarged if it cannot hold a single "
+      "chunk of rows"));
 }
 
 void Hyrise::reset() {
@@ -16,6 +16,8 @@ namespace opossum {
 
 class AbstractScheduler;
 class BenchmarkRunner;
+class CardinalityFeedback;
+struct CostModelCoefficients;
 
 // This should be the only singleton in the src/lib world. It provides a unified way of accessing components like the
 // storage manager, the transaction manager, and more. Encapsulating this in one class avoids the static initialization
@@ -49,6 +51,13 @@ class Hyrise : public Singleton<Hyrise> {
   std::shared_ptr<SQLPhysicalPlanCache> default_pqp_cache;
   std::shared_ptr<SQLLogicalPlanCache> default_lqp_cache;
 
+  // Coefficients of the physical cost model used by the LQPTranslator to choose between operator implementations (see
+  // CostEstimatorPhysical). If nullptr, the LQPTranslator uses a fixed preference order instead.
+  std::shared_ptr<const CostModelCoefficients> cost_model_coefficients;
+
+  // Row counts observed by the adaptive re-optimization, used by the CardinalityEstimator (see CardinalityFeedback)
+  std::shared_ptr<CardinalityFeedback> cardinality_feedback;
+
   // The BenchmarkRunner is available here so that non-benchmark components can add information to the benchmark
   // result JSON.
   std::weak_ptr<BenchmarkRunner> benchmark_runner;
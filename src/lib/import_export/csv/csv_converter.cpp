@@ -41,4 +41,42 @@ std::string BaseCsvConverter::unescape_copy(const std::string& field, const Pars
   return field_copy;
 }
 
+void BaseCsvConverter::unescape_postgres_text(std::string& field) {
+  auto read_position = field.find('\\');
+  if (read_position == std::string::npos) return;
+
+  auto write_position = read_position;
+  while (read_position < field.size()) {
+    auto character = field[read_position++];
+    if (character == '\\' && read_position < field.size()) {
+      character = field[read_position++];
+      switch (character) {
+        case 'b':
+          character = '\b';
+          break;
+        case 'f':
+          character = '\f';
+          break;
+        case 'n':
+          character = '\n';
+          break;
+        case 'r':
+          character = '\r';
+          break;
+        case 't':
+          character = '\t';
+          break;
+        case 'v':
+          character = '\v';
+          break;
+        default:
+          // Any other character following a backslash is taken literally
+          break;
+      }
+    }
+    field[write_position++] = character;
+  }
+  field.resize(write_position);
+}
+
 }  // namespace opossum
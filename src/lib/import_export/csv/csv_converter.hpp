@@ -41,6 +41,9 @@ class BaseCsvConverter {
    */
   static void unescape(std::string& field, const ParseConfig& config = {});
   static std::string unescape_copy(const std::string& field, const ParseConfig& config = {});
+
+  // Resolves the backslash escape sequences of a field in PostgreSQL's text format in-place (e.g., "\t" to a tab).
+  static void unescape_postgres_text(std::string& field);
 };
 
 template <typename T>
@@ -50,12 +53,24 @@ class CsvConverter : public BaseCsvConverter {
       : _parsed_values(size), _null_values(size, false), _is_nullable(is_nullable), _config(config) {}
 
   void insert(std::string& value, ChunkOffset position) override {
+    if (_config.postgres_text_format) {
+      if (value == "\\N") {
+        Assert(_is_nullable, "Null value found in non-nullable column");
+        _null_values[position] = true;
+        return;
+      }
+
+      unescape_postgres_text(value);
+      _parsed_values[position] = _get_conversion_function()(value);
+      return;
+    }
+
     if (_is_nullable && value.length() == 0) {
       _null_values[position] = true;
       return;
     }
 
-    if (boost::to_lower_copy(value) == ParseConfig::NULL_STRING) {
+    if (boost::iequals(value, ParseConfig::NULL_STRING)) {
       Assert(_config.null_handling != NullHandling::RejectNullStrings,
              "Unquoted null found in CSV file. Quote it for string literal \"null\", leave field empty for null "
              "value, or set 'null_handling' to the appropriate strategy in parse config.");
@@ -71,7 +86,8 @@ class CsvConverter : public BaseCsvConverter {
     } else {  // NOLINT
       // clang-format on
       if (_config.reject_quoted_nonstrings) {
-        Assert(value == unescape_copy(value, _config),
+        // Only quoted fields are changed by unescape(), so checking the first character avoids copying every field
+        Assert(value.empty() || value.front() != _config.quote,
                "Unexpected quoted string " + value + " encountered in non-string column");
       } else {
         unescape(value, _config);
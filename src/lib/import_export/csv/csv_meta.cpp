@@ -71,6 +71,7 @@ void from_json(const nlohmann::json& json, CsvMeta& meta) {
     assign_if_exists(config.delimiter_escape, config_json, "delimiter_escape");
     assign_if_exists(config.reject_quoted_nonstrings, config_json, "reject_quoted_nonstrings");
     assign_if_exists(config.rfc_mode, config_json, "rfc_mode");
+    assign_if_exists(config.postgres_text_format, config_json, "postgres_text_format");
 
     if (config_json.find("null_handling") != config_json.end()) {
       config.null_handling = config_json["null_handling"].get<NullHandling>();
@@ -99,7 +100,8 @@ void to_json(nlohmann::json& json, const CsvMeta& meta) {
                                          {"delimiter_escape", std::string(1, meta.config.delimiter_escape)},
                                          {"reject_quoted_nonstrings", meta.config.reject_quoted_nonstrings},
                                          {"null_handling", meta.config.null_handling},
-                                         {"rfc_mode", meta.config.rfc_mode}};
+                                         {"rfc_mode", meta.config.rfc_mode},
+                                         {"postgres_text_format", meta.config.postgres_text_format}};
 
   auto columns = nlohmann::json::parse("[]");
   for (const auto& column_meta : meta.columns) {
@@ -116,9 +118,9 @@ bool operator==(const ColumnMeta& left, const ColumnMeta& right) {
 
 bool operator==(const ParseConfig& left, const ParseConfig& right) {
   return std::tie(left.delimiter, left.separator, left.quote, left.escape, left.delimiter_escape,
-                  left.reject_quoted_nonstrings, left.null_handling, left.rfc_mode) ==
+                  left.reject_quoted_nonstrings, left.null_handling, left.rfc_mode, left.postgres_text_format) ==
          std::tie(right.delimiter, right.separator, right.quote, right.escape, right.delimiter_escape,
-                  right.reject_quoted_nonstrings, right.null_handling, right.rfc_mode);
+                  right.reject_quoted_nonstrings, right.null_handling, right.rfc_mode, right.postgres_text_format);
 }
 
 bool operator==(const CsvMeta& left, const CsvMeta& right) {
@@ -37,6 +37,10 @@ struct ParseConfig {
   // Indicator whether the Csv follows RFC 4180. (see https://tools.ietf.org/html/rfc4180)
   bool rfc_mode = true;
 
+  // Indicator whether the fields follow the text format of PostgreSQL's COPY: Fields are never quoted, special
+  // characters are escaped with a backslash, and \N denotes a null value. Empty fields are empty strings.
+  bool postgres_text_format = false;
+
   static constexpr const char* NULL_STRING = "null";
 };
 
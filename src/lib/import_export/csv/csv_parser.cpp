@@ -1,5 +1,7 @@
 #include "csv_parser.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <list>
 #include <memory>
@@ -15,14 +17,65 @@
 #include "import_export/csv/csv_meta.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/job_task.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 #include "utils/load_table.hpp"
+#include "utils/settings/integral_setting.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of characters that are compared at once when searching for special characters. With 64 characters, the
+// matches fit into one uint64_t bitmask.
+constexpr auto SIMD_BLOCK_SIZE = size_t{64};
+
+/**
+ * Returns a bitmask whose n-th bit is set if the n-th of the @param length (at most SIMD_BLOCK_SIZE) characters
+ * starting at @param characters is one of the three given special characters.
+ */
+uint64_t special_character_mask(const char* characters, const size_t length, const char first, const char second,
+                                 const char third) {
+  auto mask = uint64_t{0};
+
+  // The OpenMP Pragma makes the compiler vectorize the comparisons (see AbstractTableScanImpl). We do not use the
+  // OpenMP runtime, but only the compiler pragmas (look up -fopenmp-simd).
+
+  // This empty block is used to convince clang-format to keep the pragma indented
+  // NOLINTNEXTLINE
+  {}  // clang-format off
+  #pragma omp simd reduction(|:mask) safelen(SIMD_BLOCK_SIZE)
+  // clang-format on
+  for (auto index = size_t{0}; index < length; ++index) {
+    const auto character = characters[index];
+    const auto is_special = (character == first) | (character == second) | (character == third);
+    mask |= static_cast<uint64_t>(is_special) << index;
+  }
+
+  return mask;
+}
+
+size_t buffer_size() {
+  const auto& settings_manager = Hyrise::get().settings_manager;
+  if (!settings_manager.has_setting(CsvParser::BUFFER_SIZE_SETTING_NAME)) return CsvParser::DEFAULT_BUFFER_SIZE;
+
+  const auto setting =
+      std::dynamic_pointer_cast<IntegralSetting>(settings_manager.get_setting(CsvParser::BUFFER_SIZE_SETTING_NAME));
+  Assert(setting, std::string{CsvParser::BUFFER_SIZE_SETTING_NAME} + " is expected to be an IntegralSetting");
+  Assert(setting->value() > 0, std::string{CsvParser::BUFFER_SIZE_SETTING_NAME} + " has to be positive");
+
+  return static_cast<size_t>(setting->value());
+}
+
+}  // namespace
 
 namespace opossum {
 
 std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const ChunkOffset chunk_size,
-                                        const std::optional<CsvMeta>& csv_meta) {
+                                        const std::optional<CsvMeta>& csv_meta,
+                                        const std::optional<SegmentEncodingSpec>& encoding_spec) {
   // If no meta info is given as a parameter, look for a json file
   CsvMeta meta;
   if (csv_meta == std::nullopt) {
@@ -31,11 +84,9 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
     meta = *csv_meta;
   }
 
-  auto escaped_linebreak = std::string(1, meta.config.delimiter_escape) + std::string(1, meta.config.delimiter);
-
   auto table = _create_table_from_meta(chunk_size, meta);
 
-  std::ifstream csvfile{filename};
+  std::ifstream csvfile{filename, std::ios::binary};
 
   // return empty table if input file is empty
   if (!csvfile || csvfile.peek() == EOF || csvfile.peek() == '\r' || csvfile.peek() == '\n') return table;
@@ -45,43 +96,110 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
     std::getline(csvfile, line);
     Assert(line.find('\r') == std::string::npos, "Windows encoding is not supported, use dos2unix");
   }
-
-  /**
-   * Load the whole file(!) into a std::string using the, hopefully, fastest method to do so.
-   * TODO(anybody) Maybe use mmap() in the future. The current approach needs to have the entire file in RAM, mmap might
-   *               be cleverer, dunno.
-   */
-  csvfile.seekg(0, std::ios::end);
-  const auto csvfile_size = csvfile.tellg();
-  std::string content(csvfile_size, ' ');
+  csvfile.clear();
   csvfile.seekg(0);
-  csvfile.read(content.data(), csvfile_size);
 
-  // make sure content ends with a delimiter for better row processing later
-  if (content.back() != meta.config.delimiter) content.push_back(meta.config.delimiter);
+  // The buffer holds the rows of the current block. Large reads bypass the buffer of the ifstream. Small files do not
+  // need a full-sized buffer, the additional byte leaves room for the delimiter appended to the last row.
+  const auto file_size = static_cast<size_t>(std::filesystem::file_size(filename));
+  auto buffer = std::string(std::min(buffer_size(), file_size + 1), '\0');
+  auto buffer_fill_size = size_t{0};
+  auto row_count = size_t{0};
+
+  while (true) {
+    csvfile.read(buffer.data() + buffer_fill_size, static_cast<std::streamsize>(buffer.size() - buffer_fill_size));
+    buffer_fill_size += static_cast<size_t>(csvfile.gcount());
+    const auto is_last_block = csvfile.eof();
+
+    // make sure content ends with a delimiter for better row processing later
+    if (is_last_block && buffer_fill_size > 0 && buffer[buffer_fill_size - 1] != meta.config.delimiter) {
+      buffer.resize(std::max(buffer.size(), buffer_fill_size + 1));
+      buffer[buffer_fill_size++] = meta.config.delimiter;
+    }
 
-  std::string_view content_view{content.c_str(), content.size()};
+    const auto block = std::string_view{buffer.data(), buffer_fill_size};
+    const auto parsed_size = _parse_into_table(block, *table, meta, encoding_spec, is_last_block, row_count);
+
+    if (is_last_block) {
+      Assert(parsed_size == block.size(), "CSV file ends within a quoted field");
+      break;
+    }
+
+    // Move the rows that did not fill a complete chunk to the front. If there are none, the buffer is too small.
+    std::copy(buffer.begin() + parsed_size, buffer.begin() + buffer_fill_size, buffer.begin());
+    buffer_fill_size -= parsed_size;
+    if (parsed_size == 0) buffer.resize(buffer.size() * 2);
+  }
+
+  if (row_count > 0 && table->last_chunk()->is_mutable()) table->last_chunk()->finalize();
+
+  return table;
+}
+
+size_t CsvParser::parse_into_table(std::string_view csv_content, Table& table, const CsvMeta& csv_meta) {
+  DebugAssert(csv_content.empty() || csv_content.back() == csv_meta.config.delimiter,
+              "CSV content has to end with a row delimiter");
+
+  auto row_count = size_t{0};
+  _parse_into_table(csv_content, table, csv_meta, std::nullopt, true, row_count);
+  return row_count;
+}
+
+size_t CsvParser::complete_rows_length(std::string_view csv_content, const ParseConfig& config) {
+  if (config.postgres_text_format) {
+    const auto last_delimiter = csv_content.rfind(config.delimiter);
+    return last_delimiter == std::string_view::npos ? 0 : last_delimiter + 1;
+  }
+
+  const auto search_for = std::string{config.delimiter, config.quote};
+
+  auto length = size_t{0};
+  auto in_quotes = false;
+  for (auto pos = csv_content.find_first_of(search_for); pos != std::string_view::npos;
+       pos = csv_content.find_first_of(search_for, pos + 1)) {
+    if (csv_content[pos] == config.quote) {
+      // Same handling of escaped quotes as in _find_fields_in_chunk()
+      const auto quote_is_escaped =
+          config.quote != config.escape && pos != 0 && csv_content[pos - 1] == config.escape;
+      if (!quote_is_escaped) in_quotes = !in_quotes;
+    } else if (!in_quotes) {
+      length = pos + 1;
+    }
+  }
+
+  return length;
+}
+
+size_t CsvParser::_parse_into_table(std::string_view csv_content, Table& table, const CsvMeta& meta,
+                                     const std::optional<SegmentEncodingSpec>& encoding_spec,
+                                     const bool is_last_block, size_t& row_count) {
+  auto escaped_linebreak = std::string(1, meta.config.delimiter_escape) + std::string(1, meta.config.delimiter);
 
   // Save chunks in list to avoid memory relocation
   std::list<Segments> segments_by_chunks;
   std::vector<std::shared_ptr<AbstractTask>> tasks;
   std::vector<size_t> field_ends;
   std::mutex append_chunk_mutex;
-  while (_find_fields_in_chunk(content_view, *table, field_ends, meta)) {
+  auto parsed_size = size_t{0};
+  while (_find_fields_in_chunk(csv_content.substr(parsed_size), table, field_ends, meta)) {
+    // Rows that do not fill a chunk are parsed together with the next block
+    if (!is_last_block && field_ends.size() < table.target_chunk_size() * table.column_count()) break;
+
     // create empty chunk
     segments_by_chunks.emplace_back();
     auto& segments = segments_by_chunks.back();
 
     // Only pass the part of the string that is actually needed to the parsing task
-    std::string_view relevant_content = content_view.substr(0, field_ends.back());
+    std::string_view relevant_content = csv_content.substr(parsed_size, field_ends.back());
 
     // Remove processed part of the csv content
-    content_view = content_view.substr(field_ends.back() + 1);
+    parsed_size += field_ends.back() + 1;
 
     // create and start parsing task to fill chunk
     tasks.emplace_back(std::make_shared<JobTask>([relevant_content, field_ends, &table, &segments, &meta,
-                                                  &escaped_linebreak, &append_chunk_mutex]() {
-      _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak, append_chunk_mutex);
+                                                  &escaped_linebreak, &encoding_spec, &append_chunk_mutex]() {
+      _parse_into_chunk(relevant_content, field_ends, table, segments, meta, escaped_linebreak, encoding_spec,
+                        append_chunk_mutex);
     }));
     tasks.back()->schedule();
   }
@@ -90,13 +208,23 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
 
   for (auto& segments : segments_by_chunks) {
     DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
-    const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
-    table->append_chunk(segments, mvcc_data);
-  }
+    const auto chunk_size = segments.front()->size();
+    if (table.uses_mvcc() == UseMvcc::Yes) {
+      table.append_chunk(segments, std::make_shared<MvccData>(chunk_size, CommitID{0}));
+    } else {
+      table.append_chunk(segments);
+    }
+    row_count += chunk_size;
 
-  table->last_chunk()->finalize();
+    // Encoded segments cannot be appended to
+    if (encoding_spec) {
+      const auto chunk = table.last_chunk();
+      chunk->finalize();
+      generate_chunk_pruning_statistics(chunk);
+    }
+  }
 
-  return table;
+  return parsed_size;
 }
 
 std::shared_ptr<Table> CsvParser::create_table_from_meta_file(const std::string& filename,
@@ -129,55 +257,70 @@ bool CsvParser::_find_fields_in_chunk(std::string_view csv_content, const Table&
     return false;
   }
 
-  std::string search_for{meta.config.separator, meta.config.delimiter, meta.config.quote};
+  // Fields in PostgreSQL's text format are never quoted. Searching for the separator twice disables the quote.
+  const auto has_quotes = !meta.config.postgres_text_format;
+  const auto quote_to_search = has_quotes ? meta.config.quote : meta.config.separator;
+
+  // The number of field ends that belong to complete rows
+  size_t complete_rows_field_count = 0;
 
-  size_t from = 0;
   unsigned int rows = 0;
   unsigned int field_count = 1;
   bool in_quotes = false;
-  while (rows < table.target_chunk_size()) {
-    // Find either of row separator, column delimiter, quote identifier
-    auto pos = csv_content.find_first_of(search_for, from);
-    if (std::string::npos == pos) {
-      break;
-    }
-    from = pos + 1;
-    const char elem = csv_content[pos];
-
-    // Make sure to "toggle" in_quotes ONLY if the quotes are not part of the string (i.e. escaped)
-    if (elem == meta.config.quote) {
-      bool quote_is_escaped = false;
-      if (meta.config.quote != meta.config.escape) {
-        quote_is_escaped = pos != 0 && csv_content[pos - 1] == meta.config.escape;
+  for (size_t block_begin = 0; block_begin < csv_content.size() && rows < table.target_chunk_size();
+       block_begin += SIMD_BLOCK_SIZE) {
+    // Find all row separators, column delimiters, and quote identifiers within the next block at once
+    const auto block_length = std::min(SIMD_BLOCK_SIZE, csv_content.size() - block_begin);
+    auto mask = special_character_mask(csv_content.data() + block_begin, block_length, meta.config.separator,
+                                       meta.config.delimiter, quote_to_search);
+
+    for (; mask != 0 && rows < table.target_chunk_size(); mask &= mask - 1) {
+      const auto pos = block_begin + __builtin_ctzll(mask);
+      const char elem = csv_content[pos];
+      const bool is_quote = has_quotes && elem == meta.config.quote;
+
+      // Make sure to "toggle" in_quotes ONLY if the quotes are not part of the string (i.e. escaped)
+      if (is_quote) {
+        bool quote_is_escaped = false;
+        if (meta.config.quote != meta.config.escape) {
+          quote_is_escaped = pos != 0 && csv_content[pos - 1] == meta.config.escape;
+        }
+        if (!quote_is_escaped) {
+          in_quotes = !in_quotes;
+        }
       }
-      if (!quote_is_escaped) {
-        in_quotes = !in_quotes;
+
+      // Determine if separator marks end of field or is part of the (string) value
+      if (in_quotes || is_quote) {
+        continue;
       }
-    }
 
-    // Determine if delimiter marks end of row or is part of the (string) value
-    if (elem == meta.config.delimiter && !in_quotes) {
-      DebugAssert(field_count == static_cast<size_t>(table.column_count()),
-                  "Number of CSV fields does not match number of columns.");
-      ++rows;
-      field_count = 0;
-    }
+      field_ends.push_back(pos);
 
-    // Determine if separator marks end of field or is part of the (string) value
-    if (in_quotes || elem == meta.config.quote) {
-      continue;
-    }
+      // Determine if delimiter marks end of row or is part of the (string) value
+      if (elem == meta.config.delimiter) {
+        DebugAssert(field_count == static_cast<size_t>(table.column_count()),
+                    "Number of CSV fields does not match number of columns.");
+        ++rows;
+        field_count = 0;
+        complete_rows_field_count = field_ends.size();
+      }
 
-    ++field_count;
-    field_ends.push_back(pos);
+      ++field_count;
+    }
   }
 
-  return true;
+  // Drop the fields of a row that is not complete, e.g., because the rest of it was not read yet
+  field_ends.resize(complete_rows_field_count);
+
+  return !field_ends.empty();
 }
 
 size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends,
                                     const Table& table, Segments& segments, const CsvMeta& meta,
-                                    const std::string& escaped_linebreak, std::mutex& append_chunk_mutex) {
+                                    const std::string& escaped_linebreak,
+                                    const std::optional<SegmentEncodingSpec>& encoding_spec,
+                                    std::mutex& append_chunk_mutex) {
   // For each csv column, create a CsvConverter which builds up a ValueSegment
   const auto column_count = table.column_count();
   const auto row_count = field_ends.size() / column_count;
@@ -201,11 +344,14 @@ size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vecto
   size_t field_idx = 0;
   ColumnID column_id{0};
 
+  // Reused for all fields so that its memory is only allocated once
+  auto field = std::string{};
+
   try {
     for (; row_id < row_count; ++row_id) {
       for (column_id = ColumnID{0}; column_id < column_count; ++column_id, ++field_idx) {
         const auto end = field_ends[field_idx];
-        auto field = std::string{csv_chunk.substr(start, end - start)};
+        field.assign(csv_chunk.data() + start, end - start);
         start = end + 1;
 
         if (!meta.config.rfc_mode) {
@@ -221,12 +367,21 @@ size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vecto
                            std::to_string(column_id) + ":\n" + exception.what());
   }
 
-  // Transform the field_offsets to segments and add segments to chunk.
+  // Transform the field_offsets to segments. Encoding them here keeps the encoding parallel to the parsing.
+  auto chunk_segments = Segments{};
+  for (column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    std::shared_ptr<BaseSegment> segment = converters[column_id]->finish();
+    // Columns whose data type is not supported by the encoding are left unencoded.
+    if (encoding_spec && encoding_supports_data_type(encoding_spec->encoding_type, table.column_data_type(column_id))) {
+      segment = ChunkEncoder::encode_segment(segment, table.column_data_type(column_id), *encoding_spec);
+    }
+    chunk_segments.push_back(segment);
+  }
+
+  // Add segments to chunk.
   {
     std::lock_guard<std::mutex> lock(append_chunk_mutex);
-    for (auto& converter : converters) {
-      segments.push_back(converter->finish());
-    }
+    segments = std::move(chunk_segments);
   }
 
   return row_count;
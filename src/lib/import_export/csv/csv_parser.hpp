@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/csv/csv_meta.hpp"
+#include "storage/encoding_type.hpp"
 
 namespace opossum {
 
@@ -21,19 +22,42 @@ class Chunk;
  * For non-RFC 4180, all linebreaks within quoted strings are further escaped with an escape character.
  * For the structure of the meta csv file see export_csv.hpp
  *
- * This parser reads the whole csv file and iterates over it to separate the data into chunks that are aligned with the
- * csv rows.
- * Each data chunk is parsed and converted into a opossum chunk. In the end all chunks are combined to the final table.
+ * This parser does not hold the whole csv file in memory. It reads the file in blocks of the size given by the
+ * "CsvParser.buffer_size" setting and separates each block into pieces of one chunk of rows each. The pieces are
+ * parsed in parallel and converted into opossum chunks, which are appended to the table once the block is done. The
+ * rows that do not fill a complete chunk are moved to the front of the buffer and completed by the next block. If
+ * not even one chunk of rows fits into the buffer, the buffer is enlarged.
  */
 class CsvParser {
  public:
+  static constexpr auto BUFFER_SIZE_SETTING_NAME = "CsvParser.buffer_size";
+  static constexpr auto DEFAULT_BUFFER_SIZE = int64_t{256} * 1024 * 1024;
+
   /*
    * @param filename      Path to the input file.
    * @param csv_meta      Custom csv meta information which will be used instead of the default "filename" + ".json" meta.
+   * @param encoding_spec If given, each chunk is encoded right after it was parsed, i.e., by the parsing task.
+   *                      Columns whose data type is not supported by the encoding are left unencoded.
    * @returns             The table that was created from the csv file.
    */
   static std::shared_ptr<Table> parse(const std::string& filename, const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE,
-                                      const std::optional<CsvMeta>& csv_meta = std::nullopt);
+                                      const std::optional<CsvMeta>& csv_meta = std::nullopt,
+                                      const std::optional<SegmentEncodingSpec>& encoding_spec = std::nullopt);
+  /*
+   * Parses @param csv_content in parallel and appends its rows to @param table in chunks of the table's target chunk
+   * size. Only the config of @param csv_meta is used, the columns are taken from @param table. The content has to end
+   * with a row delimiter (or be empty).
+   * @returns             The number of parsed rows.
+   */
+  static size_t parse_into_table(std::string_view csv_content, Table& table, const CsvMeta& csv_meta);
+
+  /*
+   * Returns the length of the longest prefix of @param csv_content that consists of complete rows only, i.e., the
+   * position after its last row delimiter that is not part of a quoted field. Used to parse content that arrives in
+   * pieces, e.g., over the network.
+   */
+  static size_t complete_rows_length(std::string_view csv_content, const ParseConfig& config);
+
   static std::shared_ptr<Table> create_table_from_meta_file(const std::string& filename,
                                                             const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
 
@@ -43,12 +67,22 @@ class CsvParser {
    */
   static std::shared_ptr<Table> _create_table_from_meta(const ChunkOffset chunk_size, const CsvMeta& meta);
 
+  /*
+   * Parses @param csv_content in parallel and appends its rows to @param table in chunks of the table's target chunk
+   * size. Unless @param is_last_block is set, rows that do not fill a complete chunk are left unparsed.
+   * @param[out] row_count   Incremented by the number of parsed rows.
+   * @returns                The length of the parsed prefix of @param csv_content.
+   */
+  static size_t _parse_into_table(std::string_view csv_content, Table& table, const CsvMeta& meta,
+                                  const std::optional<SegmentEncodingSpec>& encoding_spec, const bool is_last_block,
+                                  size_t& row_count);
+
   /*
    * @param      csv_content String_view on the remaining content of the CSV.
    * @param      table       Empty table created by _process_meta_file.
    * @param[out] field_ends  Empty vector, to be filled with positions of the field ends for one chunk found in \p
-   * csv_content.
-   * @returns                False if \p csv_content is empty or chunk_size set to 0, True otherwise.
+   * csv_content. Only complete rows, i.e., rows that end with a delimiter, are considered.
+   * @returns                False if \p csv_content does not contain a complete row, True otherwise.
    */
   static bool _find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends,
                                     const CsvMeta& meta);
@@ -58,10 +92,12 @@ class CsvParser {
    * @param      field_ends Positions of the field ends of the given \p csv_chunk.
    * @param      table      Empty table created by _process_meta_file.
    * @param[out] segments   The segments of the chunk, to be populated with data
+   * @param      encoding_spec If given, the segments are encoded accordingly
    * @returns               The number of rows in the chunk
    */
   static size_t _parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends, const Table& table,
                                   Segments& segments, const CsvMeta& meta, const std::string& escaped_linebreak,
+                                  const std::optional<SegmentEncodingSpec>& encoding_spec,
                                   std::mutex& append_chunk_mutex);
 
   /*
@@ -90,9 +90,11 @@ std::shared_ptr<AbstractLQPNode> AggregateNode::_on_shallow_copy(LQPNodeMapping&
   const auto aggregate_expressions = std::vector<std::shared_ptr<AbstractExpression>>{
       node_expressions.begin() + aggregate_expressions_begin_idx, node_expressions.end()};
 
-  return std::make_shared<AggregateNode>(
+  const auto aggregate_node = std::make_shared<AggregateNode>(
       expressions_copy_and_adapt_to_different_lqp(group_by_expressions, node_mapping),
       expressions_copy_and_adapt_to_different_lqp(aggregate_expressions, node_mapping));
+  aggregate_node->is_group_join = is_group_join;
+  return aggregate_node;
 }
 
 size_t AggregateNode::_on_shallow_hash() const { return aggregate_expressions_begin_idx; }
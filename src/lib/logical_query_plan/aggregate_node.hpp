@@ -30,6 +30,10 @@ class AggregateNode : public EnableMakeForLQPNode<AggregateNode>, public Abstrac
   // node_expression contains both the group_by- and the aggregate_expressions in that order.
   size_t aggregate_expressions_begin_idx;
 
+  // Set by the GroupJoinRule if the aggregate can be executed together with the join below it (see GroupJoin). The
+  // left input of that join is the one whose join column is unique.
+  bool is_group_join{false};
+
  protected:
   size_t _on_shallow_hash() const override;
   std::shared_ptr<AbstractLQPNode> _on_shallow_copy(LQPNodeMapping& node_mapping) const override;
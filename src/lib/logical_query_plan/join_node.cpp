@@ -103,11 +103,12 @@ const std::vector<std::shared_ptr<AbstractExpression>>& JoinNode::join_predicate
 size_t JoinNode::_on_shallow_hash() const { return boost::hash_value(join_mode); }
 
 std::shared_ptr<AbstractLQPNode> JoinNode::_on_shallow_copy(LQPNodeMapping& node_mapping) const {
-  if (!join_predicates().empty()) {
-    return JoinNode::make(join_mode, expressions_copy_and_adapt_to_different_lqp(join_predicates(), node_mapping));
-  } else {
-    return JoinNode::make(join_mode);
-  }
+  if (join_predicates().empty()) return JoinNode::make(join_mode);
+
+  const auto join_node =
+      JoinNode::make(join_mode, expressions_copy_and_adapt_to_different_lqp(join_predicates(), node_mapping));
+  join_node->table_hash_index_side = table_hash_index_side;
+  return join_node;
 }
 
 bool JoinNode::_on_shallow_equals(const AbstractLQPNode& rhs, const LQPNodeMapping& node_mapping) const {
@@ -36,6 +36,10 @@ class JoinNode : public EnableMakeForLQPNode<JoinNode>, public AbstractLQPNode {
 
   JoinMode join_mode;
 
+  // Set by the IndexScanRule if the join can be executed as an index nested loop join that probes the table hash index
+  // (see TableHashIndex) of the stored table on this side.
+  std::optional<IndexSide> table_hash_index_side;
+
  protected:
   size_t _on_shallow_hash() const override;
   std::shared_ptr<AbstractLQPNode> _on_shallow_copy(LQPNodeMapping& node_mapping) const override;
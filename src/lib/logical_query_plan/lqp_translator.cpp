@@ -1,7 +1,12 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <boost/hana/for_each.hpp>
@@ -11,6 +16,7 @@
 #include "aggregate_node.hpp"
 #include "alias_node.hpp"
 #include "change_meta_table_node.hpp"
+#include "cost_estimation/cost_estimator_physical.hpp"
 #include "create_prepared_plan_node.hpp"
 #include "create_table_node.hpp"
 #include "create_view_node.hpp"
@@ -22,6 +28,7 @@
 #include "expression/abstract_expression.hpp"
 #include "expression/abstract_predicate_expression.hpp"
 #include "expression/expression_utils.hpp"
+#include "expression/logical_expression.hpp"
 #include "expression/lqp_column_expression.hpp"
 #include "expression/lqp_subquery_expression.hpp"
 #include "expression/pqp_column_expression.hpp"
@@ -34,15 +41,18 @@
 #include "join_node.hpp"
 #include "limit_node.hpp"
 #include "operators/aggregate_hash.hpp"
+#include "operators/aggregate_sort.hpp"
 #include "operators/alias_operator.hpp"
 #include "operators/change_meta_table.hpp"
 #include "operators/delete.hpp"
 #include "operators/export.hpp"
 #include "operators/get_table.hpp"
+#include "operators/group_join.hpp"
 #include "operators/import.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/insert.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -66,14 +76,92 @@
 #include "projection_node.hpp"
 #include "sort_node.hpp"
 #include "static_table_node.hpp"
+#include "statistics/cardinality_estimator.hpp"
 #include "stored_table_node.hpp"
 #include "union_node.hpp"
 #include "update_node.hpp"
 
 using namespace std::string_literals;  // NOLINT
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename JoinOperator>
+OperatorType join_operator_type() {
+  if constexpr (std::is_same_v<JoinOperator, JoinHash>) return OperatorType::JoinHash;
+  if constexpr (std::is_same_v<JoinOperator, JoinSortMerge>) return OperatorType::JoinSortMerge;
+  if constexpr (std::is_same_v<JoinOperator, JoinNestedLoop>) return OperatorType::JoinNestedLoop;
+  Fail("Unexpected join operator");
+}
+
+// Returns true if the values of @param predicate are only known at runtime (e.g., in a correlated subquery) and the
+// predicate is applied to a stored table without being shared with other consumers, so that the GetTable can prune
+// chunks with it right before its execution.
+bool is_runtime_prunable(const std::shared_ptr<PredicateNode>& node,
+                         const std::shared_ptr<AbstractExpression>& predicate,
+                         const std::shared_ptr<AbstractOperator>& input_operator) {
+  if (!expression_contains_correlated_parameter(predicate) && !expression_contains_placeholder(predicate)) {
+    return false;
+  }
+
+  auto contains_subquery = false;
+  visit_expression(predicate, [&](const auto& sub_expression) {
+    if (sub_expression->type == ExpressionType::PQPSubquery) contains_subquery = true;
+    return contains_subquery ? ExpressionVisitation::DoNotVisitArguments : ExpressionVisitation::VisitArguments;
+  });
+  if (contains_subquery) return false;
+
+  // Only Predicates and Validates, which neither change the column layout nor are consumed elsewhere, may be in between
+  auto lqp_node = node->left_input();
+  while (lqp_node->output_count() == 1 &&
+         (lqp_node->type == LQPNodeType::Predicate || lqp_node->type == LQPNodeType::Validate)) {
+    lqp_node = lqp_node->left_input();
+  }
+  if (lqp_node->type != LQPNodeType::StoredTable || lqp_node->output_count() != 1) return false;
+
+  auto op = std::shared_ptr<const AbstractOperator>{input_operator};
+  while (op->type() == OperatorType::TableScan || op->type() == OperatorType::Validate) {
+    op = op->input_left();
+  }
+  return op->type() == OperatorType::GetTable;
+}
+
+// Copies the TableScans and Validates of @param input_operator down to (and including) their GetTable. Returns the
+// copy of @param input_operator and the copied GetTable.
+std::pair<std::shared_ptr<AbstractOperator>, std::shared_ptr<GetTable>> copy_runtime_pruning_input(
+    const std::shared_ptr<AbstractOperator>& input_operator) {
+  const auto copied_input_operator = input_operator->deep_copy();
+
+  // deep_copy() does not set the LQP nodes, which are needed, e.g., for the cardinality feedback
+  auto op = input_operator;
+  auto copied_op = copied_input_operator;
+  while (copied_op->type() != OperatorType::GetTable) {
+    copied_op->lqp_node = op->lqp_node;
+    op = op->mutable_input_left();
+    copied_op = copied_op->mutable_input_left();
+  }
+  copied_op->lqp_node = op->lqp_node;
+
+  return {copied_input_operator, std::static_pointer_cast<GetTable>(copied_op)};
+}
+
+}  // namespace
+
 namespace opossum {
 
+LQPTranslator::LQPTranslator() : LQPTranslator(Hyrise::get().cost_model_coefficients) {}
+
+LQPTranslator::LQPTranslator(const std::shared_ptr<const CostModelCoefficients>& cost_model_coefficients) {
+  if (!cost_model_coefficients) return;
+
+  _cost_estimator =
+      std::make_shared<CostEstimatorPhysical>(std::make_shared<CardinalityEstimator>(), cost_model_coefficients);
+
+  // The LQP does not change during the translation, so the estimated cardinalities can be cached
+  _cost_estimator->guarantee_bottom_up_construction();
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::translate_node(const std::shared_ptr<AbstractLQPNode>& node) const {
   /**
    * Translate a node (i.e. call `_translate_by_node_type`) only if it hasn't been translated before, otherwise just
@@ -164,6 +252,12 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node(
     case ScanType::TableScan:
       return _translate_predicate_node_to_table_scan(predicate_node, input_operator);
     case ScanType::IndexScan:
+      // The IndexScanRule marks predicates on indexed columns. With a cost model, the index is only used if this is
+      // estimated to be cheaper than scanning the table.
+      if (_cost_estimator && _cost_estimator->estimate_table_scan_cost(predicate_node) <
+                                 _cost_estimator->estimate_index_scan_cost(predicate_node)) {
+        return _translate_predicate_node_to_table_scan(predicate_node, input_operator);
+      }
       return _translate_predicate_node_to_index_scan(predicate_node, input_operator);
   }
 
@@ -184,10 +278,53 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   // Our IndexScan implementation does not work on reference segments yet.
   Assert(node->left_input()->type == LQPNodeType::StoredTable, "IndexScan must follow a StoredTableNode.");
 
+  // A conjunction of equality predicates on exactly the key columns of a table hash index (see IndexScanRule) is
+  // answered by a single lookup in that index
+  {
+    auto lookup_values_by_column_id = std::map<ColumnID, AllParameterVariant>{};
+    auto is_equality_conjunction = true;
+    for (const auto& conjunct : flatten_logical_expressions(node->predicate(), LogicalOperator::And)) {
+      const auto operator_predicates = OperatorScanPredicate::from_expression(*conjunct, *node);
+      if (!operator_predicates || operator_predicates->size() != 1 ||
+          (*operator_predicates)[0].predicate_condition != PredicateCondition::Equals ||
+          is_column_id((*operator_predicates)[0].value)) {
+        is_equality_conjunction = false;
+        break;
+      }
+      lookup_values_by_column_id.emplace((*operator_predicates)[0].column_id, (*operator_predicates)[0].value);
+    }
+
+    const auto stored_table_node = std::static_pointer_cast<StoredTableNode>(node->left_input());
+    for (const auto& index_column_ids : stored_table_node->table_hash_indexes_column_ids()) {
+      if (!is_equality_conjunction || index_column_ids.size() != lookup_values_by_column_id.size()) continue;
+
+      auto lookup_values = std::vector<AllParameterVariant>{};
+      for (const auto index_column_id : index_column_ids) {
+        const auto lookup_value_iter = lookup_values_by_column_id.find(index_column_id);
+        if (lookup_value_iter == lookup_values_by_column_id.end()) break;
+        lookup_values.emplace_back(lookup_value_iter->second);
+      }
+      if (lookup_values.size() != index_column_ids.size()) continue;
+
+      const auto index_scan = std::make_shared<IndexScan>(input_operator, index_column_ids, lookup_values);
+      index_scan->lqp_node = node;
+      return index_scan;
+    }
+  }
+
+  // Conjunctions are only chosen for table hash indexes. If the index was dropped after the LQP was optimized (e.g.,
+  // for an LQP taken from the cache), the predicate is scanned instead.
   const auto predicate = std::dynamic_pointer_cast<AbstractPredicateExpression>(node->predicate());
-  Assert(predicate, "Expected predicate");
+  if (!predicate) return _translate_predicate_node_to_table_scan(node, input_operator);
   Assert(!predicate->arguments.empty(), "Expected arguments");
 
+  // The IndexScanRule also accepts placeholders and correlated parameters (e.g., in the PQP templates of prepared
+  // statements). The chunk indexes need the values when the IndexScan is created, so such predicates are scanned.
+  const auto has_unknown_value =
+      std::any_of(predicate->arguments.begin() + 1, predicate->arguments.end(),
+                  [](const auto& argument) { return argument->type != ExpressionType::Value; });
+  if (has_unknown_value) return _translate_predicate_node_to_table_scan(node, input_operator);
+
   column_id = node->left_input()->get_column_id(*predicate->arguments[0]);
   if (predicate->arguments.size() > 1) {
     const auto value_expression = std::dynamic_pointer_cast<ValueExpression>(predicate->arguments[1]);
@@ -225,7 +362,9 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   auto index_scan = std::make_shared<IndexScan>(input_operator, SegmentIndexType::GroupKey, column_ids,
                                                 predicate->predicate_condition, right_values, right_values2);
 
-  const auto table_scan = _translate_predicate_node_to_table_scan(node, input_operator);
+  // The TableScan must see the same chunks as the IndexScan, so no runtime pruning is added to its input
+  const auto table_scan =
+      std::make_shared<TableScan>(input_operator, _translate_expression(node->predicate(), node->left_input()));
 
   index_scan->included_chunk_ids = indexed_chunks;
   table_scan->excluded_chunk_ids = indexed_chunks;
@@ -239,7 +378,20 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
 
 std::shared_ptr<TableScan> LQPTranslator::_translate_predicate_node_to_table_scan(
     const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const {
-  return std::make_shared<TableScan>(input_operator, _translate_expression(node->predicate(), node->left_input()));
+  const auto predicate = _translate_expression(node->predicate(), node->left_input());
+
+  if (is_runtime_prunable(node, predicate, input_operator)) {
+    // translate_node() shares the operators of structurally equal LQP nodes, e.g., the GetTables of both sides of a
+    // self-join. The predicate must not prune the chunks of the other consumers, so it is added to a copy.
+    const auto [copied_input_operator, get_table] = copy_runtime_pruning_input(input_operator);
+    auto runtime_pruning_predicates = get_table->runtime_pruning_predicates();
+    runtime_pruning_predicates.emplace_back(predicate->deep_copy());
+    get_table->set_runtime_pruning_predicates(runtime_pruning_predicates);
+
+    return std::make_shared<TableScan>(copied_input_operator, predicate);
+  }
+
+  return std::make_shared<TableScan>(input_operator, predicate);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_alias_node(
@@ -296,11 +448,36 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
+  auto join_node = std::dynamic_pointer_cast<JoinNode>(node);
+
+  // With a cost model, the join operator with the lowest estimated cost is chosen. This includes the JoinIndex if the
+  // JoinNode was marked for a join on a table hash index (see IndexScanRule). In case of equal costs, the earlier
+  // operator in the candidate list wins.
+  auto cheapest_join_type = std::optional<OperatorType>{};
+  if (_cost_estimator && join_node->join_mode != JoinMode::Cross) {
+    auto candidate_join_types = CostEstimatorPhysical::supported_join_types(*join_node);
+    if (join_node->table_hash_index_side) {
+      candidate_join_types.insert(candidate_join_types.begin(), OperatorType::JoinIndex);
+    }
+
+    auto cheapest_join_cost = std::numeric_limits<Cost>::max();
+    for (const auto join_type : candidate_join_types) {
+      const auto join_cost = _cost_estimator->estimate_join_cost(join_node, join_type);
+      if (join_cost < cheapest_join_cost) {
+        cheapest_join_cost = join_cost;
+        cheapest_join_type = join_type;
+      }
+    }
+  }
+
+  if (join_node->table_hash_index_side && (!cheapest_join_type || *cheapest_join_type == OperatorType::JoinIndex)) {
+    if (const auto index_join = _translate_join_node_to_index_join(join_node)) return index_join;
+    cheapest_join_type = std::nullopt;
+  }
+
   const auto input_left_operator = translate_node(node->left_input());
   const auto input_right_operator = translate_node(node->right_input());
 
-  auto join_node = std::dynamic_pointer_cast<JoinNode>(node);
-
   if (join_node->join_mode == JoinMode::Cross) {
     PerformanceWarning("CROSS join used");
     return std::make_shared<Product>(input_left_operator, input_right_operator);
@@ -328,7 +505,7 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
   const auto left_data_type = join_node->join_predicates().front()->arguments[0]->data_type();
   const auto right_data_type = join_node->join_predicates().front()->arguments[1]->data_type();
 
-  // Lacking a proper cost model, we assume JoinHash is always faster than JoinSortMerge, which is faster than
+  // Lacking a cost model, we assume JoinHash is always faster than JoinSortMerge, which is faster than
   // JoinNestedLoop and thus check for an operator compatible with the JoinNode in that order
   constexpr auto JOIN_OPERATOR_PREFERENCE_ORDER =
       hana::to_tuple(hana::tuple_t<JoinHash, JoinSortMerge, JoinNestedLoop>);
@@ -337,6 +514,7 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
     using JoinOperator = typename decltype(join_operator_t)::type;
 
     if (join_operator) return;
+    if (cheapest_join_type && *cheapest_join_type != join_operator_type<JoinOperator>()) return;
 
     if (JoinOperator::supports({join_node->join_mode, primary_join_predicate.predicate_condition, left_data_type,
                                 right_data_type, !secondary_join_predicates.empty()})) {
@@ -349,12 +527,52 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
   return join_operator;
 }
 
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node_to_index_join(
+    const std::shared_ptr<JoinNode>& node) const {
+  const auto index_side = *node->table_hash_index_side;
+  const auto& index_side_input = index_side == IndexSide::Left ? node->left_input() : node->right_input();
+  const auto& probe_side_input = index_side == IndexSide::Left ? node->right_input() : node->left_input();
+
+  auto stored_table_node = index_side_input;
+  if (stored_table_node->type == LQPNodeType::Validate) stored_table_node = stored_table_node->left_input();
+  Assert(stored_table_node->type == LQPNodeType::StoredTable, "Index side of a table hash index join must be a table");
+
+  Assert(node->join_predicates().size() == 1, "Table hash index joins support a single join predicate only");
+  const auto join_predicate =
+      OperatorJoinPredicate::from_expression(*node->join_predicates()[0], *node->left_input(), *node->right_input());
+  Assert(join_predicate, "Couldn't translate join predicate: "s + node->join_predicates()[0]->as_column_name());
+
+  /**
+   * The JoinIndex probes the table hash index of the stored table and validates the matching rows itself (see
+   * JoinIndex::_on_execute_with_table_hash_index). Thus, the index side is translated without its ValidateNode, which
+   * would look at every row of the stored table. The other paths of the JoinIndex rely on validated inputs. If the
+   * table hash index is not there (anymore), nullptr is returned and the JoinNode is translated to a regular join.
+   */
+  const auto index_column_id =
+      index_side == IndexSide::Left ? join_predicate->column_ids.first : join_predicate->column_ids.second;
+  const auto indexes_column_ids =
+      std::static_pointer_cast<StoredTableNode>(stored_table_node)->table_hash_indexes_column_ids();
+  if (join_predicate->predicate_condition != PredicateCondition::Equals ||
+      std::find(indexes_column_ids.cbegin(), indexes_column_ids.cend(), std::vector<ColumnID>{index_column_id}) ==
+          indexes_column_ids.cend()) {
+    return nullptr;
+  }
+
+  const auto index_side_operator = translate_node(stored_table_node);
+  const auto probe_side_operator = translate_node(probe_side_input);
+
+  if (index_side == IndexSide::Left) {
+    return std::make_shared<JoinIndex>(index_side_operator, probe_side_operator, node->join_mode, *join_predicate,
+                                       std::vector<OperatorJoinPredicate>{}, index_side);
+  }
+  return std::make_shared<JoinIndex>(probe_side_operator, index_side_operator, node->join_mode, *join_predicate,
+                                     std::vector<OperatorJoinPredicate>{}, index_side);
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto aggregate_node = std::dynamic_pointer_cast<AggregateNode>(node);
 
-  const auto input_operator = translate_node(node->left_input());
-
   std::vector<std::shared_ptr<AggregateExpression>> pqp_aggregate_expressions;
   pqp_aggregate_expressions.reserve(aggregate_node->node_expressions.size() -
                                     aggregate_node->aggregate_expressions_begin_idx);
@@ -385,6 +603,30 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     group_by_column_ids.emplace_back(*column_id);
   }
 
+  // The GroupJoinRule marks aggregates that are executed together with the join below them. The ColumnIDs of the
+  // group by columns and aggregate arguments refer to the output of that join, as expected by the GroupJoin.
+  if (aggregate_node->is_group_join) {
+    const auto join_node = std::dynamic_pointer_cast<JoinNode>(node->left_input());
+    Assert(join_node && join_node->join_predicates().size() == 1, "GroupJoin expects a join with a single predicate");
+
+    const auto join_predicate = OperatorJoinPredicate::from_expression(
+        *join_node->join_predicates()[0], *join_node->left_input(), *join_node->right_input());
+    Assert(join_predicate, "Couldn't translate join predicate: "s + join_node->join_predicates()[0]->as_column_name());
+
+    return std::make_shared<GroupJoin>(translate_node(join_node->left_input()),
+                                       translate_node(join_node->right_input()), *join_predicate,
+                                       pqp_aggregate_expressions, group_by_column_ids);
+  }
+
+  const auto input_operator = translate_node(node->left_input());
+
+  // AggregateHash is used unless the cost model estimates AggregateSort to be cheaper
+  if (_cost_estimator &&
+      _cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateOperatorType::Sort) <
+          _cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateOperatorType::Hash)) {
+    return std::make_shared<AggregateSort>(input_operator, pqp_aggregate_expressions, group_by_column_ids);
+  }
+
   return std::make_shared<AggregateHash>(input_operator, pqp_aggregate_expressions, group_by_column_ids);
 }
 
@@ -12,17 +12,28 @@ namespace opossum {
 class AbstractOperator;
 class TransactionContext;
 class AbstractExpression;
+class CostEstimatorPhysical;
+class JoinNode;
 class PredicateNode;
 class TableScan;
 struct OperatorScanPredicate;
+struct CostModelCoefficients;
 struct OperatorJoinPredicate;
 
 /**
  * Translates an LQP (Logical Query Plan), represented by its root node, into an Operator tree for the execution
  * engine, which in return is represented by its root Operator.
+ *
+ * Where multiple operators can implement a node (joins, aggregates, and predicates marked for an IndexScan), the
+ * translator picks the one with the lowest estimated cost if it is given cost model coefficients (see
+ * CostEstimatorPhysical). Otherwise, it uses a fixed preference order.
  */
 class LQPTranslator {
  public:
+  // Uses the cost model coefficients of the Hyrise singleton (which might be nullptr)
+  LQPTranslator();
+  explicit LQPTranslator(const std::shared_ptr<const CostModelCoefficients>& cost_model_coefficients);
+
   virtual ~LQPTranslator() = default;
 
   virtual std::shared_ptr<AbstractOperator> translate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -41,6 +52,7 @@ class LQPTranslator {
   std::shared_ptr<AbstractOperator> _translate_projection_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_sort_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_join_node(const std::shared_ptr<AbstractLQPNode>& node) const;
+  std::shared_ptr<AbstractOperator> _translate_join_node_to_index_join(const std::shared_ptr<JoinNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_aggregate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_limit_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_insert_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -74,6 +86,9 @@ class LQPTranslator {
       const std::vector<std::shared_ptr<AbstractExpression>>& lqp_expressions,
       const std::shared_ptr<AbstractLQPNode>& node) const;
 
+  // Only set if cost model coefficients are given
+  std::shared_ptr<CostEstimatorPhysical> _cost_estimator;
+
   // Cache operator subtrees by LQP node to avoid redundantly executing
   //   - identical operators (operators below a diamond shape)
   //   - equal but not identical operators
@@ -4,6 +4,7 @@
 #include "hyrise.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/index/index_statistics.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
@@ -128,6 +129,29 @@ std::vector<IndexStatistics> StoredTableNode::indexes_statistics() const {
   return pruned_indexes_statistics;
 }
 
+std::vector<std::vector<ColumnID>> StoredTableNode::table_hash_indexes_column_ids() const {
+  DebugAssert(!left_input() && !right_input(), "StoredTableNode must be a leaf");
+
+  const auto table = Hyrise::get().storage_manager.get_table(table_name);
+  const auto column_id_mapping = column_ids_after_pruning(table->column_count(), _pruned_column_ids);
+
+  auto indexes_column_ids = std::vector<std::vector<ColumnID>>{};
+  for (const auto& table_hash_index : table->table_hash_indexes()) {
+    auto index_column_ids = std::vector<ColumnID>{};
+    for (const auto original_column_id : table_hash_index->column_ids()) {
+      const auto& updated_column_id = column_id_mapping[original_column_id];
+      if (!updated_column_id) break;
+      index_column_ids.emplace_back(*updated_column_id);
+    }
+
+    if (index_column_ids.size() == table_hash_index->column_ids().size()) {
+      indexes_column_ids.emplace_back(std::move(index_column_ids));
+    }
+  }
+
+  return indexes_column_ids;
+}
+
 size_t StoredTableNode::_on_shallow_hash() const {
   size_t hash{0};
   boost::hash_combine(hash, table_name);
@@ -39,6 +39,10 @@ class StoredTableNode : public EnableMakeForLQPNode<StoredTableNode>, public Abs
 
   std::vector<IndexStatistics> indexes_statistics() const;
 
+  // Key columns of the table-level hash indexes (see TableHashIndex) of the stored table, adapted to the pruned
+  // columns. Indexes on pruned columns are omitted.
+  std::vector<std::vector<ColumnID>> table_hash_indexes_column_ids() const;
+
   std::string description(const DescriptionMode mode = DescriptionMode::Short) const override;
   std::vector<std::shared_ptr<AbstractExpression>> column_expressions() const override;
   bool is_column_nullable(const ColumnID column_id) const override;
@@ -5,6 +5,8 @@
 #include <boost/container/pmr/memory_resource.hpp>
 #include <boost/core/no_exceptions_support.hpp>
 
+#include "query_memory_resource.hpp"
+
 namespace boost::container::pmr {
 
 class default_resource_impl : public memory_resource {  // NOLINT
@@ -16,7 +18,7 @@ class default_resource_impl : public memory_resource {  // NOLINT
   [[nodiscard]] bool do_is_equal(const memory_resource& other) const BOOST_NOEXCEPT override { return &other == this; }
 };
 
-memory_resource* get_default_resource() BOOST_NOEXCEPT {
+memory_resource* new_delete_resource() BOOST_NOEXCEPT {
   // Yes, this leaks. We have had SO many problems with the default memory resource going out of scope
   // before the other things were cleaned up that we decided to live with the leak, rather than
   // running into races over and over again.
@@ -24,7 +26,11 @@ memory_resource* get_default_resource() BOOST_NOEXCEPT {
   return default_resource_instance;
 }
 
-memory_resource* new_delete_resource() BOOST_NOEXCEPT { return get_default_resource(); }
+memory_resource* get_default_resource() BOOST_NOEXCEPT {
+  // Operators executed with a per-query arena (see QueryMemoryResource) redirect the default resource of their thread
+  if (auto* scoped_resource = opossum::DefaultMemoryResourceScope::current()) return scoped_resource;
+  return new_delete_resource();
+}
 
 memory_resource* set_default_resource(memory_resource* r) BOOST_NOEXCEPT {
   // Do nothing
@@ -0,0 +1,100 @@
+#include "query_memory_budget.hpp"
+
+#include <algorithm>
+
+#include "hyrise.hpp"
+#include "utils/assert.hpp"
+#include "utils/settings/integral_setting.hpp"
+
+namespace opossum {
+
+QueryMemoryBudget::QueryMemoryBudget(const size_t limit) : _limit(limit) {}
+
+std::shared_ptr<QueryMemoryBudget> QueryMemoryBudget::create_from_settings() {
+  const auto& settings_manager = Hyrise::get().settings_manager;
+  if (!settings_manager.has_setting(SETTING_NAME)) return nullptr;
+
+  const auto setting = std::dynamic_pointer_cast<IntegralSetting>(settings_manager.get_setting(SETTING_NAME));
+  Assert(setting, std::string{SETTING_NAME} + " is expected to be an IntegralSetting");
+
+  const auto limit = setting->value();
+  if (limit <= 0) return nullptr;
+
+  return std::make_shared<QueryMemoryBudget>(static_cast<size_t>(limit));
+}
+
+bool QueryMemoryBudget::try_reserve(const size_t bytes) {
+  auto reserved_bytes = _reserved_bytes.load();
+  do {
+    if (reserved_bytes + bytes > _limit) return false;
+  } while (!_reserved_bytes.compare_exchange_weak(reserved_bytes, reserved_bytes + bytes));
+
+  _update_peak(reserved_bytes + bytes);
+  return true;
+}
+
+void QueryMemoryBudget::reserve(const size_t bytes) { _update_peak(_reserved_bytes += bytes); }
+
+void QueryMemoryBudget::release(const size_t bytes) {
+  const auto previously_reserved_bytes = _reserved_bytes.fetch_sub(bytes);
+  DebugAssert(previously_reserved_bytes >= bytes, "Released more bytes than were reserved");
+}
+
+size_t QueryMemoryBudget::limit() const { return _limit; }
+
+size_t QueryMemoryBudget::reserved_bytes() const { return _reserved_bytes.load(); }
+
+size_t QueryMemoryBudget::peak_reserved_bytes() const { return _peak_reserved_bytes.load(); }
+
+size_t QueryMemoryBudget::available_bytes() const {
+  const auto reserved_bytes = _reserved_bytes.load();
+  return reserved_bytes < _limit ? _limit - reserved_bytes : 0;
+}
+
+void QueryMemoryBudget::_update_peak(const size_t reserved_bytes) {
+  auto peak_reserved_bytes = _peak_reserved_bytes.load();
+  while (reserved_bytes > peak_reserved_bytes &&
+         !_peak_reserved_bytes.compare_exchange_weak(peak_reserved_bytes, reserved_bytes)) {
+  }
+}
+
+MemoryBudgetReservation::MemoryBudgetReservation(const std::shared_ptr<QueryMemoryBudget>& budget, const size_t bytes)
+    : _budget(budget), _bytes(bytes) {}
+
+MemoryBudgetReservation::MemoryBudgetReservation(MemoryBudgetReservation&& other) noexcept
+    : _budget(std::move(other._budget)), _bytes(other._bytes) {
+  other._bytes = 0;
+}
+
+MemoryBudgetReservation& MemoryBudgetReservation::operator=(MemoryBudgetReservation&& other) noexcept {
+  if (this == &other) return *this;
+  if (_budget) _budget->release(_bytes);
+
+  _budget = std::move(other._budget);
+  _bytes = other._bytes;
+  other._budget = nullptr;
+  other._bytes = 0;
+  return *this;
+}
+
+MemoryBudgetReservation::~MemoryBudgetReservation() {
+  if (_budget) _budget->release(_bytes);
+}
+
+std::optional<MemoryBudgetReservation> MemoryBudgetReservation::try_reserve(
+    const std::shared_ptr<QueryMemoryBudget>& budget, const size_t bytes) {
+  if (!budget) return MemoryBudgetReservation{};
+  if (!budget->try_reserve(bytes)) return std::nullopt;
+  return MemoryBudgetReservation{budget, bytes};
+}
+
+MemoryBudgetReservation MemoryBudgetReservation::reserve(const std::shared_ptr<QueryMemoryBudget>& budget,
+                                                         const size_t bytes) {
+  if (!budget) return MemoryBudgetReservation{};
+  budget->reserve(bytes);
+  return MemoryBudgetReservation{budget, bytes};
+}
+
+size_t MemoryBudgetReservation::bytes() const { return _bytes; }
+
+}  // namespace opossum
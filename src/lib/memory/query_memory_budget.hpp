@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Accounts for the memory used by the large intermediate data structures (hash tables, materialized columns, aggregate
+ * results, sort keys, ...) of a single query. All operators of a query share one budget.
+ *
+ * The budget does not track individual allocations. Instead, operators reserve their estimated memory consumption
+ * before they build such a data structure. Operators that can process their input in smaller pieces (JoinHash and
+ * AggregateHash) use try_reserve() and switch to a spilling mode if the reservation fails. All other operators use
+ * reserve(), which always succeeds but reduces the memory left for the following reservations.
+ *
+ * The limit is configured via the "QueryMemoryBudget.bytes" setting, where 0 (the default) disables the budget.
+ */
+class QueryMemoryBudget : private Noncopyable {
+ public:
+  static constexpr auto SETTING_NAME = "QueryMemoryBudget.bytes";
+
+  explicit QueryMemoryBudget(const size_t limit);
+
+  // Returns a budget with the currently configured limit, or nullptr if no limit is configured.
+  static std::shared_ptr<QueryMemoryBudget> create_from_settings();
+
+  // Reserves the given number of bytes if they fit into the budget. Returns false otherwise.
+  bool try_reserve(const size_t bytes);
+
+  // Reserves the given number of bytes, even if this exceeds the budget.
+  void reserve(const size_t bytes);
+
+  void release(const size_t bytes);
+
+  size_t limit() const;
+  size_t reserved_bytes() const;
+  size_t peak_reserved_bytes() const;
+
+  // Bytes left until the limit is reached, zero if the budget is already exceeded
+  size_t available_bytes() const;
+
+ private:
+  void _update_peak(const size_t reserved_bytes);
+
+  const size_t _limit;
+  std::atomic<size_t> _reserved_bytes{0};
+  std::atomic<size_t> _peak_reserved_bytes{0};
+};
+
+/**
+ * RAII reservation that releases its bytes when it goes out of scope. A nullptr budget is allowed and makes all
+ * reservations succeed, so that operators do not have to distinguish between queries with and without a budget.
+ */
+class MemoryBudgetReservation : private Noncopyable {
+ public:
+  MemoryBudgetReservation() = default;
+  MemoryBudgetReservation(MemoryBudgetReservation&& other) noexcept;
+  MemoryBudgetReservation& operator=(MemoryBudgetReservation&& other) noexcept;
+  ~MemoryBudgetReservation();
+
+  // Returns std::nullopt if the budget does not have enough memory left
+  static std::optional<MemoryBudgetReservation> try_reserve(const std::shared_ptr<QueryMemoryBudget>& budget,
+                                                            const size_t bytes);
+
+  static MemoryBudgetReservation reserve(const std::shared_ptr<QueryMemoryBudget>& budget, const size_t bytes);
+
+  size_t bytes() const;
+
+ private:
+  MemoryBudgetReservation(const std::shared_ptr<QueryMemoryBudget>& budget, const size_t bytes);
+
+  std::shared_ptr<QueryMemoryBudget> _budget;
+  size_t _bytes{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,70 @@
+#include "query_memory_resource.hpp"
+
+#include <atomic>
+
+#include "utils/assert.hpp"
+
+namespace {
+
+std::atomic<uint64_t> next_query_memory_resource_id{1};
+
+// Caches the sub-arena that the calling thread used last. As workers usually execute several tasks of the same query
+// in a row, this saves us from taking the lock in QueryMemoryResource::_sub_arena() for most allocations.
+struct CachedSubArena {
+  uint64_t resource_id{0};
+  boost::container::pmr::monotonic_buffer_resource* sub_arena{nullptr};
+};
+
+thread_local CachedSubArena cached_sub_arena;
+
+thread_local boost::container::pmr::memory_resource* scoped_default_memory_resource = nullptr;
+
+}  // namespace
+
+namespace opossum {
+
+QueryMemoryResource::QueryMemoryResource() : _id(next_query_memory_resource_id++) {}
+
+size_t QueryMemoryResource::sub_arena_count() const {
+  const auto lock = std::lock_guard<std::mutex>{_sub_arenas_mutex};
+  return _sub_arenas.size();
+}
+
+void* QueryMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  return _sub_arena().allocate(bytes, alignment);
+}
+
+void QueryMemoryResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+  // Memory is released in bulk when the resource is destroyed.
+}
+
+bool QueryMemoryResource::do_is_equal(const memory_resource& other) const noexcept { return &other == this; }
+
+boost::container::pmr::monotonic_buffer_resource& QueryMemoryResource::_sub_arena() {
+  if (cached_sub_arena.resource_id == _id) return *cached_sub_arena.sub_arena;
+
+  const auto lock = std::lock_guard<std::mutex>{_sub_arenas_mutex};
+  auto& sub_arena = _sub_arenas[std::this_thread::get_id()];
+  if (!sub_arena) {
+    // The upstream resource has to be the global default resource. get_default_resource() might return this very
+    // resource if we are within a DefaultMemoryResourceScope.
+    sub_arena = std::make_unique<boost::container::pmr::monotonic_buffer_resource>(
+        INITIAL_SUB_ARENA_SIZE, boost::container::pmr::new_delete_resource());
+  }
+
+  cached_sub_arena = {_id, sub_arena.get()};
+  return *sub_arena;
+}
+
+DefaultMemoryResourceScope::DefaultMemoryResourceScope(boost::container::pmr::memory_resource* memory_resource)
+    : _previous_memory_resource(scoped_default_memory_resource) {
+  scoped_default_memory_resource = memory_resource;
+}
+
+DefaultMemoryResourceScope::~DefaultMemoryResourceScope() {
+  scoped_default_memory_resource = _previous_memory_resource;
+}
+
+boost::container::pmr::memory_resource* DefaultMemoryResourceScope::current() { return scoped_default_memory_resource; }
+
+}  // namespace opossum
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/container/pmr/memory_resource.hpp>
+#include <boost/container/pmr/monotonic_buffer_resource.hpp>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Monotonic arena used for the intermediate results (position lists, materialized values, hash tables, ...) of a
+ * single query. Deallocation is a no-op, all memory is handed back to the system at once when the resource is
+ * destroyed. Thus, no object allocated from it may outlive the resource. The SQLPipelineStatement takes care of this
+ * by tying the lifetime of the resource to the result table.
+ *
+ * As tasks of the same query run concurrently on different workers, each thread allocates from its own sub-arena.
+ * This way, allocations do not need to be synchronized. Only the first allocation of a thread takes a lock.
+ */
+class QueryMemoryResource : public boost::container::pmr::memory_resource, private Noncopyable {
+ public:
+  QueryMemoryResource();
+
+  // Number of threads that have allocated memory from this resource
+  size_t sub_arena_count() const;
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+  bool do_is_equal(const memory_resource& other) const noexcept override;
+
+ private:
+  boost::container::pmr::monotonic_buffer_resource& _sub_arena();
+
+  // Size of the first block of each sub-arena. Subsequent blocks grow geometrically.
+  static constexpr auto INITIAL_SUB_ARENA_SIZE = size_t{16'384};
+
+  // Identifies the resource in the thread-local sub-arena cache. Unlike the address, it is never reused.
+  const uint64_t _id;
+
+  mutable std::mutex _sub_arenas_mutex;
+  std::unordered_map<std::thread::id, std::unique_ptr<boost::container::pmr::monotonic_buffer_resource>> _sub_arenas;
+};
+
+/**
+ * Redirects the default memory resource of the calling thread (i.e., the resource used by default-constructed
+ * PolymorphicAllocators, see boost_default_memory_resource.cpp) to the given resource while the scope is alive. Passing
+ * a nullptr restores the global default resource. Scopes can be nested, the previous resource is restored on
+ * destruction.
+ */
+class DefaultMemoryResourceScope : private Noncopyable {
+ public:
+  explicit DefaultMemoryResourceScope(boost::container::pmr::memory_resource* memory_resource);
+  ~DefaultMemoryResourceScope();
+
+  // Returns the resource set by the innermost scope of the calling thread, or nullptr if there is none
+  static boost::container::pmr::memory_resource* current();
+
+ private:
+  boost::container::pmr::memory_resource* const _previous_memory_resource;
+};
+
+}  // namespace opossum
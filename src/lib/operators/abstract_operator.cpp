@@ -121,6 +121,15 @@ void AbstractOperator::clear_output() { _output = nullptr; }
 
 std::string AbstractOperator::description(DescriptionMode description_mode) const { return name(); }
 
+const std::shared_ptr<QueryMemoryBudget>& AbstractOperator::memory_budget() const { return _memory_budget; }
+
+void AbstractOperator::set_memory_budget_recursively(const std::shared_ptr<QueryMemoryBudget>& memory_budget) {
+  _memory_budget = memory_budget;
+
+  if (_input_left) mutable_input_left()->set_memory_budget_recursively(memory_budget);
+  if (_input_right) mutable_input_right()->set_memory_budget_recursively(memory_budget);
+}
+
 std::shared_ptr<AbstractOperator> AbstractOperator::deep_copy() const {
   std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>> copied_ops;
   return _deep_copy_impl(copied_ops);
@@ -12,6 +12,7 @@
 namespace opossum {
 
 class OperatorTask;
+class QueryMemoryBudget;
 class Table;
 class TransactionContext;
 
@@ -28,6 +29,7 @@ enum class OperatorType {
   Difference,
   Export,
   GetTable,
+  GroupJoin,
   Import,
   IndexScan,
   Insert,
@@ -98,6 +100,13 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // Calls set_transaction_context on itself and both input operators recursively
   void set_transaction_context_recursively(const std::weak_ptr<TransactionContext>& transaction_context);
 
+  // Memory budget of the query the operator belongs to, might be nullptr. Operators account for their large
+  // intermediates in it (see QueryMemoryBudget). Not copied by deep_copy(), as the copy belongs to another query.
+  const std::shared_ptr<QueryMemoryBudget>& memory_budget() const;
+
+  // Sets the memory budget on itself and both input operators recursively
+  void set_memory_budget_recursively(const std::shared_ptr<QueryMemoryBudget>& memory_budget);
+
   // Returns a new instance of the same operator with the same configuration.
   // Recursively copies the input operators.
   // An operator needs to implement this method in order to be cacheable.
@@ -165,6 +174,8 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // Weak pointer breaks cyclical dependency between operators and context
   std::optional<std::weak_ptr<TransactionContext>> _transaction_context;
 
+  std::shared_ptr<QueryMemoryBudget> _memory_budget;
+
   const std::unique_ptr<OperatorPerformanceData> _performance_data;
 };
 
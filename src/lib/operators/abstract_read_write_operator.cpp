@@ -1,8 +1,13 @@
 #include "abstract_read_write_operator.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include "hyrise.hpp"
+#include "storage/mvcc_data.hpp"
+
 namespace opossum {
 
 AbstractReadWriteOperator::AbstractReadWriteOperator(const OperatorType type,
@@ -15,6 +20,7 @@ void AbstractReadWriteOperator::execute() {
   Assert(static_cast<bool>(transaction_context()),
          "AbstractReadWriteOperator::execute() should never be called without having set the transaction context.");
   DebugAssert(transaction_context()->phase() == TransactionPhase::Active, "Transaction is not active anymore.");
+  Assert(!transaction_context()->is_read_only(), "Read-only transactions cannot execute read-write operators.");
   Assert(_state == ReadWriteOperatorState::Pending, "Operator needs to have state Pending in order to be executed.");
 
   transaction_context()->register_read_write_operator(
@@ -63,6 +69,33 @@ void AbstractReadWriteOperator::_mark_as_failed() {
   _state = ReadWriteOperatorState::Conflicted;
 }
 
+bool AbstractReadWriteOperator::_wait_for_row_lock(const MvccData& mvcc_data, const ChunkOffset chunk_offset,
+                                                   const TransactionID lock_holder,
+                                                   const std::chrono::steady_clock::time_point deadline) {
+  // Most transactions finish quickly, so we start polling with a short pause and back off exponentially
+  constexpr auto MAX_PAUSE = std::chrono::microseconds{1000};
+  auto pause = std::chrono::microseconds{1};
+
+  auto acquired = false;
+  while (true) {
+    // Rows deleted by a committed transaction remain locked (see Delete::_on_commit_records), but have an end_cid
+    if (mvcc_data.get_end_cid(chunk_offset) != MvccData::MAX_COMMIT_ID) break;
+
+    // The lock holder rolled back. Another transaction might have locked the row since, so the caller has to retry.
+    if (mvcc_data.get_tid(chunk_offset) != lock_holder) {
+      acquired = true;
+      break;
+    }
+
+    if (std::chrono::steady_clock::now() >= deadline) break;
+    std::this_thread::sleep_for(pause);
+    pause = std::min(pause * 2, MAX_PAUSE);
+  }
+
+  Hyrise::get().transaction_manager.register_lock_wait(acquired);
+  return acquired;
+}
+
 std::ostream& operator<<(std::ostream& stream, const ReadWriteOperatorState& phase) {
   switch (phase) {
     case ReadWriteOperatorState::Pending:
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -13,6 +14,8 @@
 
 namespace opossum {
 
+class MvccData;
+
 enum class ReadWriteOperatorState {
   Pending,     // The operator has been instantiated.
   Executed,    // Execution succeeded.
@@ -88,6 +91,15 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   void _mark_as_failed();
 
+  /**
+   * Waits until the row is no longer locked by the transaction @param lock_holder or until @param deadline has passed.
+   * Returns true if the lock was released without the row being deleted (i.e., the other transaction rolled back), in
+   * which case locking the row can be retried. Registers the wait at the TransactionManager.
+   */
+  static bool _wait_for_row_lock(const MvccData& mvcc_data, const ChunkOffset chunk_offset,
+                                 const TransactionID lock_holder,
+                                 const std::chrono::steady_clock::time_point deadline);
+
  private:
   ReadWriteOperatorState _state;
 };
@@ -11,9 +11,13 @@
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 
 #include "aggregate/aggregate_traits.hpp"
+#include "concurrency/cancellation_token.hpp"
 #include "constant_mappings.hpp"
 #include "expression/pqp_column_expression.hpp"
 #include "hyrise.hpp"
+#include "memory/query_memory_budget.hpp"
+#include "operators/spilling/grace_partitioning.hpp"
+#include "operators/table_wrapper.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
@@ -274,6 +278,10 @@ void AggregateHash::_aggregate() {
     for (size_t group_column_index = 0; group_column_index < _groupby_column_ids.size(); ++group_column_index) {
       jobs.emplace_back(std::make_shared<JobTask>([&input_table, group_column_index, &keys_per_chunk, chunk_count,
                                                    this]() {
+        // If the query was cancelled, the keys of this column are left unset. They are never read, as the
+        // aggregation phase checks the token before each chunk.
+        if (CancellationTokenScope::is_cancelled()) return;
+
         const auto groupby_column_id = _groupby_column_ids.at(group_column_index);
         const auto data_type = input_table->column_data_type(groupby_column_id);
 
@@ -480,6 +488,9 @@ void AggregateHash::_aggregate() {
   // Process Chunks and perform aggregations
   const auto chunk_count = input_table->chunk_count();
   for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    // A cancelled query fails anyway, so the results of the chunks aggregated so far are written as they are
+    if (CancellationTokenScope::is_cancelled()) break;
+
     const auto chunk_in = input_table->get_chunk(chunk_id);
     if (!chunk_in) continue;
 
@@ -612,6 +623,27 @@ void AggregateHash::_aggregate() {
 }
 
 std::shared_ptr<const Table> AggregateHash::_on_execute() {
+  const auto& input_table = input_table_left();
+
+  // Estimate the working memory of the aggregate keys, the AggregateResultIdMap, and the AggregateResults, assuming
+  // that every row forms its own group. If it does not fit into the query's memory budget, fall back to aggregating
+  // one partition at a time. Without GROUP BY columns, there is only a single group.
+  auto memory_budget_reservation = MemoryBudgetReservation{};
+  if (!_groupby_column_ids.empty() && input_table->row_count() > 0) {
+    const auto groupby_column_count = _groupby_column_ids.size();
+    const auto bytes_per_row = 2 * groupby_column_count * sizeof(AggregateKeyEntry) + sizeof(AggregateResultId) +
+                               std::max(_aggregates.size(), size_t{1}) * sizeof(AggregateResult<int64_t, int64_t>);
+    const auto estimated_bytes = input_table->row_count() * bytes_per_row;
+
+    if (auto reservation = MemoryBudgetReservation::try_reserve(memory_budget(), estimated_bytes)) {
+      memory_budget_reservation = std::move(*reservation);
+    } else {
+      const auto partition_count =
+          GracePartitioning::partition_count_for(estimated_bytes, memory_budget()->available_bytes());
+      return _on_execute_grace(partition_count, estimated_bytes);
+    }
+  }
+
   // We do not want the overhead of a vector with heap storage when we have a limited number of aggregate columns.
   // The reason we only have specializations up to 2 is because every specialization increases the compile time.
   // Also, we need to make sure that there are tests for at least the first case, one array case, and the fallback.
@@ -633,8 +665,6 @@ std::shared_ptr<const Table> AggregateHash::_on_execute() {
       break;
   }
 
-  const auto& input_table = input_table_left();
-
   /**
    * Write group-by columns.
    *
@@ -680,6 +710,46 @@ std::shared_ptr<const Table> AggregateHash::_on_execute() {
   return output;
 }
 
+std::shared_ptr<const Table> AggregateHash::_on_execute_grace(const size_t partition_count,
+                                                              const size_t estimated_bytes) {
+  // All rows of a group end up in the same partition, so the groups of different partitions are disjoint and the
+  // partition results can simply be concatenated.
+  const auto partitioning = GracePartitioning{input_table_left(), _groupby_column_ids, partition_count};
+
+  auto output = std::shared_ptr<Table>{};
+
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    if (partitioning.partition_row_count(partition_id) == 0) continue;
+
+    const auto memory_budget_reservation =
+        MemoryBudgetReservation::reserve(memory_budget(), estimated_bytes / partition_count);
+
+    const auto partition = std::make_shared<TableWrapper>(partitioning.load_partition(partition_id));
+    partition->execute();
+
+    // The partition aggregate does not get a memory budget. Partitioning its input again would not help, as all of its
+    // rows have the same partition id.
+    const auto partition_aggregate = std::make_shared<AggregateHash>(partition, _aggregates, _groupby_column_ids);
+    partition_aggregate->execute();
+
+    const auto& partition_output = partition_aggregate->get_output();
+    if (!output) output = std::make_shared<Table>(partition_output->column_definitions(), TableType::Data);
+
+    const auto chunk_count = partition_output->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = partition_output->get_chunk(chunk_id);
+      auto segments = Segments{};
+      for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+        segments.emplace_back(chunk->get_segment(column_id));
+      }
+      output->append_chunk(segments);
+    }
+  }
+
+  Assert(output, "Expected at least one non-empty partition");
+  return output;
+}
+
 /*
 The following template functions write the aggregated values for the different aggregate functions.
 They are separate and templated to avoid compiler errors for invalid type/function combinations.
@@ -109,6 +109,10 @@ class AggregateHash : public AbstractAggregateOperator {
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
+  // Used if the estimated working memory exceeds the query's memory budget. Partitions the input by the group by
+  // columns, spills the partitions to disk, and aggregates one partition at a time.
+  std::shared_ptr<const Table> _on_execute_grace(const size_t partition_count, const size_t estimated_bytes);
+
   template <typename AggregateKey>
   void _aggregate();
 
@@ -1,13 +1,20 @@
 #include "delete.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
+#include "statistics/table_statistics_maintainer.hpp"
+#include "storage/mvcc_data.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/row_version_store.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
@@ -29,6 +36,8 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
 
   _transaction_id = context->transaction_id();
 
+  // Collect the rows first, so that they can be locked in the order of their RowIDs
+  _row_ids.reserve(_referencing_table->row_count());
   for (ChunkID chunk_id{0}; chunk_id < _referencing_table->chunk_count(); ++chunk_id) {
     const auto chunk = _referencing_table->get_chunk(chunk_id);
 
@@ -48,85 +57,111 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
       }
     }
 
-    for (const auto row_id : *pos_list) {
-      const auto referenced_chunk = first_segment->referenced_table()->get_chunk(row_id.chunk_id);
-      Assert(referenced_chunk, "Referenced chunks are not allowed to be null pointers");
-
-      // Scope for the lock on the MVCC data
-      {
-        auto mvcc_data = referenced_chunk->mvcc_data();
-        DebugAssert(mvcc_data, "Delete cannot operate on a table without MVCC data");
-
-        DebugAssert(
-            Validate::is_row_visible(
-                context->transaction_id(), context->snapshot_commit_id(), mvcc_data->get_tid(row_id.chunk_offset),
-                mvcc_data->get_begin_cid(row_id.chunk_offset), mvcc_data->get_end_cid(row_id.chunk_offset)),
-            "Trying to delete a row that is not visible to the current transaction. Has the input been validated?");
-
-        // Actual row "lock" for delete happens here, making sure that no other transaction can delete this row
-        auto expected = 0u;
-        const auto success = mvcc_data->compare_exchange_tid(row_id.chunk_offset, expected, _transaction_id);
-
-        if (!success) {
-          // If the row has a set TID, it might be a row that our TX inserted
-          // No need to compare-and-swap here, because we can only run into conflicts when two transactions try to
-          // change this row from the initial tid
-
-          if (mvcc_data->get_tid(row_id.chunk_offset) == _transaction_id) {
-            // Make sure that even we don't see it anymore
-            mvcc_data->set_tid(row_id.chunk_offset, INVALID_TRANSACTION_ID);
-          } else {
-            // the row is already locked by someone else and the transaction needs to be rolled back
-            _mark_as_failed();
-            return nullptr;
-          }
+    if (!_referenced_table) _referenced_table = first_segment->referenced_table();
+    Assert(first_segment->referenced_table() == _referenced_table, "Delete can only delete rows of a single table");
+
+    _row_ids.insert(_row_ids.end(), pos_list->begin(), pos_list->end());
+  }
+
+  std::sort(_row_ids.begin(), _row_ids.end());
+  _row_ids.erase(std::unique(_row_ids.begin(), _row_ids.end()), _row_ids.end());
+
+  const auto lock_wait_timeout = Hyrise::get().transaction_manager.lock_wait_timeout();
+
+  for (const auto row_id : _row_ids) {
+    const auto referenced_chunk = _referenced_table->get_chunk(row_id.chunk_id);
+    Assert(referenced_chunk, "Referenced chunks are not allowed to be null pointers");
+
+    // Scope for the lock on the MVCC data
+    {
+      auto mvcc_data = referenced_chunk->mvcc_data();
+      DebugAssert(mvcc_data, "Delete cannot operate on a table without MVCC data");
+
+      DebugAssert(
+          Validate::is_row_visible(
+              context->transaction_id(), context->snapshot_commit_id(), mvcc_data->get_tid(row_id.chunk_offset),
+              mvcc_data->get_begin_cid(row_id.chunk_offset), mvcc_data->get_end_cid(row_id.chunk_offset)),
+          "Trying to delete a row that is not visible to the current transaction. Has the input been validated?");
+
+      // Actual row "lock" for delete happens here, making sure that no other transaction can delete this row
+      const auto success = _try_lock_row(*mvcc_data, row_id.chunk_offset, lock_wait_timeout);
+
+      if (!success) {
+        // If the row has a set TID, it might be a row that our TX inserted
+        // No need to compare-and-swap here, because we can only run into conflicts when two transactions try to
+        // change this row from the initial tid
+
+        if (mvcc_data->get_tid(row_id.chunk_offset) == _transaction_id) {
+          // Make sure that even we don't see it anymore
+          mvcc_data->set_tid(row_id.chunk_offset, INVALID_TRANSACTION_ID);
+        } else {
+          // the row is already locked by someone else and the transaction needs to be rolled back
+          _mark_as_failed();
+          return nullptr;
+        }
+      } else {
+        // Rows that are updated in place are locked by their uncommitted version instead of their TID (see
+        // RowVersionStore). Also, the MVCC data of the chunk might be replaced by a compacted one, which would not
+        // contain the lock (see Chunk::try_compact_mvcc_data()). The fence pairs with the one in Update, so that at
+        // least one of two transactions that concurrently modify the row notices the other.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto row_versions = mvcc_data->row_versions();
+        if (mvcc_data->is_compacting ||
+            (row_versions && row_versions->has_conflicting_version(row_id.chunk_offset, _transaction_id,
+                                                                   context->snapshot_commit_id()))) {
+          mvcc_data->set_tid(row_id.chunk_offset, 0u);
+          _mark_as_failed();
+          return nullptr;
         }
       }
     }
+
+    ++_locked_row_count;
   }
 
   return nullptr;
 }
 
-void Delete::_on_commit_records(const CommitID commit_id) {
-  for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
-       ++referencing_chunk_id) {
-    const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
-    const auto referencing_segment =
-        std::static_pointer_cast<const ReferenceSegment>(referencing_chunk->get_segment(ColumnID{0}));
-    const auto referenced_table = referencing_segment->referenced_table();
-
-    for (const auto row_id : *referencing_segment->pos_list()) {
-      const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
-
-      referenced_chunk->mvcc_data()->set_end_cid(row_id.chunk_offset, commit_id);
-      referenced_chunk->increase_invalid_row_count(1);
-      // We do not unlock the rows so subsequent transactions properly fail when attempting to update these rows.
-    }
+bool Delete::_try_lock_row(MvccData& mvcc_data, const ChunkOffset chunk_offset,
+                           const std::chrono::milliseconds lock_wait_timeout) const {
+  if (mvcc_data.compare_exchange_tid(chunk_offset, 0u, _transaction_id)) return true;
+  if (lock_wait_timeout.count() == 0) return false;
+
+  // The row is locked, but the transaction holding the lock might still roll back
+  const auto deadline = std::chrono::steady_clock::now() + lock_wait_timeout;
+  while (true) {
+    const auto lock_holder = mvcc_data.get_tid(chunk_offset);
+
+    // Rows that the transaction inserted itself are handled by the caller
+    if (lock_holder == _transaction_id) return false;
+
+    if (lock_holder != 0u && !_wait_for_row_lock(mvcc_data, chunk_offset, lock_holder, deadline)) return false;
+    if (mvcc_data.compare_exchange_tid(chunk_offset, 0u, _transaction_id)) return true;
   }
 }
 
-void Delete::_on_rollback_records() {
-  for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
-       ++referencing_chunk_id) {
-    const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
-    const auto referencing_segment =
-        std::static_pointer_cast<const ReferenceSegment>(referencing_chunk->get_segment(ColumnID{0}));
-    const auto referenced_table = referencing_segment->referenced_table();
-
-    for (const auto row_id : *referencing_segment->pos_list()) {
-      auto expected = _transaction_id;
+void Delete::_on_commit_records(const CommitID commit_id) {
+  for (const auto row_id : _row_ids) {
+    const auto referenced_chunk = _referenced_table->get_chunk(row_id.chunk_id);
 
-      const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
+    referenced_chunk->mvcc_data()->set_end_cid(row_id.chunk_offset, commit_id);
+    referenced_chunk->increase_invalid_row_count(1);
+    // We do not unlock the rows so subsequent transactions properly fail when attempting to update these rows.
+  }
 
-      // unlock all rows locked in _on_execute
-      const auto result = referenced_chunk->mvcc_data()->compare_exchange_tid(row_id.chunk_offset, expected, 0u);
+  const auto statistics_maintainer = _referenced_table ? _referenced_table->statistics_maintainer() : nullptr;
+  if (statistics_maintainer && statistics_maintainer->update_row_count(-static_cast<int64_t>(_row_ids.size()))) {
+    TableStatisticsMaintainer::schedule_update(_referenced_table);
+  }
+}
 
-      // If the above operation fails, it means the row is locked by another transaction. This must have been
-      // the reason why the rollback was initiated. Since _on_execute stopped at this row, we can stop
-      // unlocking rows here as well.
-      if (!result) return;
-    }
+void Delete::_on_rollback_records() {
+  // Unlock all rows locked in _on_execute. Rows that the transaction inserted itself have already been unlocked, so
+  // the compare-and-swap fails for them.
+  for (auto row_index = size_t{0}; row_index < _locked_row_count; ++row_index) {
+    const auto row_id = _row_ids[row_index];
+    _referenced_table->get_chunk(row_id.chunk_id)->mvcc_data()->compare_exchange_tid(row_id.chunk_offset,
+                                                                                      _transaction_id, 0u);
   }
 }
 
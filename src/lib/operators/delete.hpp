@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,6 +14,10 @@ namespace opossum {
 /**
  * Operator that marks the rows referenced by its input table as MVCC-expired.
  * Assumption: The input has been validated before.
+ *
+ * The rows are locked in the order of their RowIDs. Thus, two transactions deleting overlapping sets of rows lock the
+ * shared rows in the same order, and the one that comes second fails on the first shared row instead of both failing
+ * halfway through. Rows locked by other transactions can be waited for, see TransactionManager::lock_wait_timeout().
  */
 class Delete : public AbstractReadWriteOperator {
  public:
@@ -30,7 +35,16 @@ class Delete : public AbstractReadWriteOperator {
   void _on_rollback_records() override;
 
  private:
+  // Returns true if the row was locked for this transaction, waiting for other transactions if configured
+  bool _try_lock_row(MvccData& mvcc_data, const ChunkOffset chunk_offset,
+                     const std::chrono::milliseconds lock_wait_timeout) const;
+
   TransactionID _transaction_id;
   std::shared_ptr<const Table> _referencing_table;
+  std::shared_ptr<const Table> _referenced_table;
+
+  // Sorted and without duplicates. Only the first _locked_row_count rows have been locked by _on_execute.
+  std::vector<RowID> _row_ids;
+  size_t _locked_row_count{0};
 };
 }  // namespace opossum
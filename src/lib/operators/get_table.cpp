@@ -7,9 +7,139 @@
 #include <unordered_set>
 #include <vector>
 
+#include "expression/between_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/correlated_parameter_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/pqp_column_expression.hpp"
 #include "hyrise.hpp"
+#include "lossless_cast.hpp"
+#include "resolve_type.hpp"
+#include "statistics/base_attribute_statistics.hpp"
+#include "storage/row_version_store.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
 #include "types.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// A runtime pruning predicate, resolved to the ColumnID in the stored table and values of the column's data type
+struct RuntimePruningPredicate {
+  ColumnID stored_column_id;
+  PredicateCondition predicate_condition;
+  AllTypeVariant value;
+  std::optional<AllTypeVariant> value2;
+};
+
+// Returns the value of a ValueExpression or of a CorrelatedParameterExpression that has been set, cast to
+// @param data_type. Returns std::nullopt if there is no such value, if it is NULL, or if it cannot be cast losslessly.
+std::optional<AllTypeVariant> pruning_value(const AbstractExpression& expression, const DataType data_type) {
+  if (expression.type == ExpressionType::CorrelatedParameter &&
+      !static_cast<const CorrelatedParameterExpression&>(expression).value()) {
+    return std::nullopt;
+  }
+
+  const auto value = expression_get_value_or_parameter(expression);
+  if (!value || variant_is_null(*value)) return std::nullopt;
+
+  return lossless_variant_cast(*value, data_type);
+}
+
+std::optional<RuntimePruningPredicate> resolve_runtime_pruning_predicate(
+    const AbstractExpression& predicate, const std::vector<ColumnID>& unpruned_column_ids,
+    const TableColumnDefinitions& column_definitions) {
+  const auto stored_column_id = [&](const AbstractExpression& expression) -> std::optional<ColumnID> {
+    if (expression.type != ExpressionType::PQPColumn) return std::nullopt;
+    return unpruned_column_ids[static_cast<const PQPColumnExpression&>(expression).column_id];
+  };
+
+  if (const auto* binary_predicate = dynamic_cast<const BinaryPredicateExpression*>(&predicate)) {
+    auto predicate_condition = binary_predicate->predicate_condition;
+    auto column_id = stored_column_id(*binary_predicate->left_operand());
+    auto value_expression = binary_predicate->right_operand();
+    if (!column_id) {
+      // Conditions such as Like cannot be flipped, so their value has to be the right operand
+      column_id = stored_column_id(*binary_predicate->right_operand());
+      if (!column_id || !is_binary_numeric_predicate_condition(predicate_condition)) return std::nullopt;
+
+      value_expression = binary_predicate->left_operand();
+      predicate_condition = flip_predicate_condition(predicate_condition);
+    }
+
+    const auto value = pruning_value(*value_expression, column_definitions[*column_id].data_type);
+    if (!value) return std::nullopt;
+
+    return RuntimePruningPredicate{*column_id, predicate_condition, *value, std::nullopt};
+  }
+
+  if (const auto* between = dynamic_cast<const BetweenExpression*>(&predicate)) {
+    const auto column_id = stored_column_id(*between->value());
+    if (!column_id) return std::nullopt;
+
+    const auto data_type = column_definitions[*column_id].data_type;
+    const auto lower_bound = pruning_value(*between->lower_bound(), data_type);
+    const auto upper_bound = pruning_value(*between->upper_bound(), data_type);
+    if (!lower_bound || !upper_bound) return std::nullopt;
+
+    return RuntimePruningPredicate{*column_id, between->predicate_condition, *lower_bound, *upper_bound};
+  }
+
+  return std::nullopt;
+}
+
+// Copies the first @param chunk_size values of @param segment into a ValueSegment and applies the values of the
+// row versions that are visible to the given transaction.
+std::shared_ptr<BaseSegment> reconstruct_segment(const BaseSegment& segment, const ChunkOffset chunk_size,
+                                                 const TableColumnDefinition& column_definition,
+                                                 const RowVersionStore& row_versions, const ColumnID column_id,
+                                                 const TransactionID transaction_id,
+                                                 const CommitID snapshot_commit_id) {
+  const auto visible_values = row_versions.visible_values(column_id, transaction_id, snapshot_commit_id);
+  auto reconstructed_segment = std::shared_ptr<BaseSegment>{};
+
+  resolve_data_type(column_definition.data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    auto values = pmr_vector<ColumnDataType>(chunk_size);
+    auto null_values = pmr_vector<bool>(column_definition.nullable ? chunk_size : 0);
+
+    segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+      const auto chunk_offset = position.chunk_offset();
+      if (chunk_offset >= chunk_size) return;
+
+      if (position.is_null()) {
+        null_values[chunk_offset] = true;
+      } else {
+        values[chunk_offset] = position.value();
+      }
+    });
+
+    for (const auto& [chunk_offset, value] : visible_values) {
+      if (chunk_offset >= chunk_size) continue;
+
+      if (variant_is_null(value)) {
+        DebugAssert(column_definition.nullable, "Row version contains NULL for a non-nullable column");
+        null_values[chunk_offset] = true;
+      } else {
+        values[chunk_offset] = boost::get<ColumnDataType>(value);
+        if (column_definition.nullable) null_values[chunk_offset] = false;
+      }
+    }
+
+    if (column_definition.nullable) {
+      reconstructed_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+    } else {
+      reconstructed_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+    }
+  });
+
+  return reconstructed_segment;
+}
+
+}  // namespace
+
 namespace opossum {
 
 GetTable::GetTable(const std::string& name) : GetTable(name, {}, {}) {}
@@ -50,6 +180,10 @@ std::string GetTable::description(DescriptionMode description_mode) const {
   stream << _pruned_chunk_ids.size() << "/" << stored_table->chunk_count() << " chunk(s)";
   if (description_mode == DescriptionMode::SingleLine) stream << ",";
   stream << separator << _pruned_column_ids.size() << "/" << stored_table->column_count() << " column(s)";
+  if (!_runtime_pruning_predicates.empty()) {
+    if (description_mode == DescriptionMode::SingleLine) stream << ",";
+    stream << separator << _runtime_pruning_predicates.size() << " runtime pruning predicate(s)";
+  }
 
   return stream.str();
 }
@@ -60,13 +194,53 @@ const std::vector<ChunkID>& GetTable::pruned_chunk_ids() const { return _pruned_
 
 const std::vector<ColumnID>& GetTable::pruned_column_ids() const { return _pruned_column_ids; }
 
+std::vector<ColumnID> GetTable::unpruned_column_ids() const {
+  const auto column_count = Hyrise::get().storage_manager.get_table(_name)->column_count();
+
+  auto unpruned_column_ids = std::vector<ColumnID>{};
+  unpruned_column_ids.reserve(column_count - _pruned_column_ids.size());
+  for (auto stored_column_id = ColumnID{0}; stored_column_id < column_count; ++stored_column_id) {
+    if (!std::binary_search(_pruned_column_ids.begin(), _pruned_column_ids.end(), stored_column_id)) {
+      unpruned_column_ids.emplace_back(stored_column_id);
+    }
+  }
+  return unpruned_column_ids;
+}
+
+void GetTable::set_runtime_pruning_predicates(const std::vector<std::shared_ptr<AbstractExpression>>& predicates) {
+  _runtime_pruning_predicates = predicates;
+}
+
+const std::vector<std::shared_ptr<AbstractExpression>>& GetTable::runtime_pruning_predicates() const {
+  return _runtime_pruning_predicates;
+}
+
+size_t GetTable::runtime_pruned_chunk_count() const { return _runtime_pruned_chunk_count; }
+
+std::optional<ChunkID> GetTable::output_chunk_id(const ChunkID stored_chunk_id) const {
+  if (stored_chunk_id >= _stored_chunk_count) return std::nullopt;
+
+  const auto excluded_chunk_ids_iter =
+      std::lower_bound(_excluded_chunk_ids.begin(), _excluded_chunk_ids.end(), stored_chunk_id);
+  if (excluded_chunk_ids_iter != _excluded_chunk_ids.end() && *excluded_chunk_ids_iter == stored_chunk_id) {
+    return std::nullopt;
+  }
+
+  return ChunkID{static_cast<ChunkID::base_type>(
+      stored_chunk_id - std::distance(_excluded_chunk_ids.begin(), excluded_chunk_ids_iter))};
+}
+
 std::shared_ptr<AbstractOperator> GetTable::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<GetTable>(_name, _pruned_chunk_ids, _pruned_column_ids);
+  const auto copy = std::make_shared<GetTable>(_name, _pruned_chunk_ids, _pruned_column_ids);
+  copy->set_runtime_pruning_predicates(expressions_deep_copy(_runtime_pruning_predicates));
+  return copy;
 }
 
-void GetTable::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
+void GetTable::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  expressions_set_parameters(_runtime_pruning_predicates, parameters);
+}
 
 std::shared_ptr<const Table> GetTable::_on_execute() {
   const auto stored_table = Hyrise::get().storage_manager.get_table(_name);
@@ -90,7 +264,21 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
     }
   }
 
-  auto excluded_chunk_ids = std::vector<ChunkID>{};
+  // Resolve the runtime pruning predicates now that the values of their parameters are known
+  auto runtime_pruning_predicates = std::vector<RuntimePruningPredicate>{};
+  if (!_runtime_pruning_predicates.empty()) {
+    const auto unpruned_column_ids = this->unpruned_column_ids();
+    for (const auto& predicate : _runtime_pruning_predicates) {
+      const auto resolved_predicate =
+          resolve_runtime_pruning_predicate(*predicate, unpruned_column_ids, stored_table->column_definitions());
+      if (resolved_predicate) runtime_pruning_predicates.emplace_back(*resolved_predicate);
+    }
+  }
+  _runtime_pruned_chunk_count = 0;
+
+  _stored_chunk_count = chunk_count;
+  _excluded_chunk_ids.clear();
+  auto& excluded_chunk_ids = _excluded_chunk_ids;
   auto pruned_chunk_ids_iter = _pruned_chunk_ids.begin();
   for (ChunkID stored_chunk_id{0}; stored_chunk_id < chunk_count; ++stored_chunk_id) {
     // Check whether the Chunk is pruned
@@ -120,6 +308,21 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
       excluded_chunk_ids.emplace_back(stored_chunk_id);
       continue;
     }
+
+    // Check whether the pruning statistics of the Chunk rule out one of the runtime pruning predicates
+    const auto& pruning_statistics = chunk->pruning_statistics();
+    if (pruning_statistics) {
+      const auto is_pruned = std::any_of(
+          runtime_pruning_predicates.begin(), runtime_pruning_predicates.end(), [&](const auto& predicate) {
+            return (*pruning_statistics)[predicate.stored_column_id]->does_not_contain(
+                predicate.predicate_condition, predicate.value, predicate.value2);
+          });
+      if (is_pruned) {
+        ++_runtime_pruned_chunk_count;
+        excluded_chunk_ids.emplace_back(stored_chunk_id);
+        continue;
+      }
+    }
   }
 
   // We cannot create a Table without columns - since Chunks rely on their first column to determine their row count
@@ -160,6 +363,13 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
 
   auto excluded_chunk_ids_iter = excluded_chunk_ids.begin();
 
+  // Rows that were updated in place are reconstructed as the transaction sees them (see RowVersionStore). A
+  // transaction sees its own uncommitted updates. Without a transaction, the last committed versions are used.
+  const auto transaction_id =
+      transaction_context_is_set() ? transaction_context()->transaction_id() : INVALID_TRANSACTION_ID;
+  const auto snapshot_commit_id = transaction_context_is_set() ? transaction_context()->snapshot_commit_id()
+                                                               : Hyrise::get().transaction_manager.last_commit_id();
+
   for (ChunkID stored_chunk_id{0}; stored_chunk_id < chunk_count; ++stored_chunk_id) {
     // Skip `stored_chunk_id` if it is in the sorted vector `excluded_chunk_ids`
     if (excluded_chunk_ids_iter != excluded_chunk_ids.end() && *excluded_chunk_ids_iter == stored_chunk_id) {
@@ -175,9 +385,16 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
     const auto& current_chunk_order = stored_chunk->ordered_by();
     std::optional<std::pair<ColumnID, OrderByMode>> adapted_chunk_order;
 
-    if (_pruned_column_ids.empty()) {
+    const auto row_versions = stored_chunk->has_mvcc_data() ? stored_chunk->mvcc_data()->row_versions() : nullptr;
+    const auto has_row_versions = row_versions && !row_versions->empty();
+
+    if (_pruned_column_ids.empty() && !has_row_versions) {
       *output_chunks_iter = stored_chunk;
     } else {
+      // Inserts resize the first segment of a mutable chunk last. Reconstructed segments have a fixed size, so the
+      // first output segment of a mutable chunk is copied as well, which fixes the size of the output chunk.
+      const auto chunk_size = stored_chunk->size();
+
       auto output_segments = Segments{stored_table->column_count() - _pruned_column_ids.size()};
       auto output_segments_iter = output_segments.begin();
       auto output_indexes = Indexes{};
@@ -196,10 +413,18 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
                                  current_chunk_order->second};
         }
 
-        *output_segments_iter = stored_chunk->get_segment(stored_column_id);
-        auto indexes = stored_chunk->get_indexes({*output_segments_iter});
-        if (!indexes.empty()) {
-          output_indexes.insert(std::end(output_indexes), std::begin(indexes), std::end(indexes));
+        const auto& segment = stored_chunk->get_segment(stored_column_id);
+        if (has_row_versions && (row_versions->modifies_column(stored_column_id) ||
+                                 (output_segments_iter == output_segments.begin() && stored_chunk->is_mutable()))) {
+          *output_segments_iter =
+              reconstruct_segment(*segment, chunk_size, stored_table->column_definitions()[stored_column_id],
+                                  *row_versions, stored_column_id, transaction_id, snapshot_commit_id);
+        } else {
+          *output_segments_iter = segment;
+          auto indexes = stored_chunk->get_indexes({*output_segments_iter});
+          if (!indexes.empty()) {
+            output_indexes.insert(std::end(output_indexes), std::begin(indexes), std::end(indexes));
+          }
         }
         ++output_segments_iter;
       }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -10,6 +11,8 @@
 
 namespace opossum {
 
+class AbstractExpression;
+
 // Operator to retrieve a table from the StorageManager by specifying its name. Depending on how the operator was
 // constructed, chunks and columns may be pruned if they are irrelevant for the final result. The returned table is NOT
 // the same table as stored in the StorageManager. If that stored table is changed (most importantly: if a chunk is
@@ -34,6 +37,30 @@ class GetTable : public AbstractReadOnlyOperator {
   const std::vector<ChunkID>& pruned_chunk_ids() const;
   const std::vector<ColumnID>& pruned_column_ids() const;
 
+  // ColumnIDs of the stored table that are part of the output, i.e., that are not pruned
+  std::vector<ColumnID> unpruned_column_ids() const;
+
+  /**
+   * Predicates on the output columns of this GetTable whose values are only known at runtime, e.g., the parameters
+   * of a correlated subquery. Right before the execution, chunks whose pruning statistics guarantee that no row
+   * satisfies one of the predicates are excluded in addition to the chunks pruned by the optimizer. Predicates that
+   * are not of the form `column <condition> value/parameter` or `column BETWEEN ...` are ignored. The predicates are
+   * not evaluated on the rows, so they have to be applied by a following TableScan.
+   */
+  void set_runtime_pruning_predicates(const std::vector<std::shared_ptr<AbstractExpression>>& predicates);
+  const std::vector<std::shared_ptr<AbstractExpression>>& runtime_pruning_predicates() const;
+
+  // Number of chunks that were excluded by the runtime pruning predicates during the last execution
+  size_t runtime_pruned_chunk_count() const;
+
+  /**
+   * Maps a ChunkID of the stored table to the ChunkID of the same chunk in the output of the last execution. Returns
+   * std::nullopt if the chunk is not part of the output, e.g., because it was pruned, deleted, or added afterwards.
+   * Operators that find rows of the stored table through a TableHashIndex use this to reference the output instead,
+   * which contains the versions of rows updated in place (see RowVersionStore).
+   */
+  std::optional<ChunkID> output_chunk_id(const ChunkID stored_chunk_id) const;
+
   std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_input_left,
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
@@ -46,5 +73,13 @@ class GetTable : public AbstractReadOnlyOperator {
   const std::string _name;
   const std::vector<ChunkID> _pruned_chunk_ids;
   const std::vector<ColumnID> _pruned_column_ids;
+
+  std::vector<std::shared_ptr<AbstractExpression>> _runtime_pruning_predicates;
+  size_t _runtime_pruned_chunk_count{0};
+
+  // Chunk count of the stored table and sorted ChunkIDs of the chunks excluded from the output during the last
+  // execution (see output_chunk_id())
+  ChunkID _stored_chunk_count{0};
+  std::vector<ChunkID> _excluded_chunk_ids;
 };
 }  // namespace opossum
@@ -0,0 +1,361 @@
+#include "group_join.hpp"
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aggregate/aggregate_traits.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "operators/abstract_aggregate_operator.hpp"
+#include "resolve_type.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Offset of a group in the output. Rows of the right input without a join partner are assigned NO_GROUP.
+using GroupOffset = uint32_t;
+constexpr auto NO_GROUP = std::numeric_limits<GroupOffset>::max();
+
+// The group of every row of the right input, indexed by ChunkID and ChunkOffset
+using ProbeGroups = std::vector<std::vector<GroupOffset>>;
+
+// Calls functor(group_offset, value) for all non-NULL values of a column of the right input that have a join partner
+template <typename ColumnDataType, typename Functor>
+void for_each_matched_value(const Table& probe_table, const ColumnID column_id, const ProbeGroups& probe_groups,
+                            const Functor& functor) {
+  const auto chunk_count = probe_table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = probe_table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    const auto& chunk_groups = probe_groups[chunk_id];
+    segment_iterate<ColumnDataType>(*chunk->get_segment(column_id), [&](const auto& position) {
+      const auto group_offset = chunk_groups[position.chunk_offset()];
+      if (group_offset == NO_GROUP || position.is_null()) return;
+      functor(group_offset, position.value());
+    });
+  }
+}
+
+// Accumulates the values of a column of the right input per group. Returns the segment holding the aggregates.
+template <typename ColumnDataType, AggregateFunction function>
+std::shared_ptr<BaseSegment> aggregate_probe_column(const Table& probe_table, const ColumnID column_id,
+                                                    const ProbeGroups& probe_groups, const size_t group_count) {
+  using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
+
+  if constexpr (function == AggregateFunction::Count) {
+    auto counts = pmr_vector<AggregateType>(group_count);
+    for_each_matched_value<ColumnDataType>(probe_table, column_id, probe_groups,
+                                           [&](const auto group_offset, const auto& /*value*/) {
+                                             ++counts[group_offset];
+                                           });
+    return std::make_shared<ValueSegment<AggregateType>>(std::move(counts));
+  } else if constexpr (AggregateTraits<ColumnDataType, function>::AGGREGATE_DATA_TYPE == DataType::Null) {
+    Fail("Cannot calculate SUM or AVG on string column");
+  } else {
+    auto results = std::vector<std::optional<AggregateType>>(group_count);
+    auto value_counts = std::vector<size_t>(function == AggregateFunction::Avg ? group_count : 0);
+
+    // MIN, MAX, SUM, and AVG do not use secondary aggregates
+    auto secondary_aggregates = std::vector<AggregateType>{};
+    const auto aggregate_function =
+        AggregateFunctionBuilder<ColumnDataType, AggregateType, function>{}.get_aggregate_function();
+
+    for_each_matched_value<ColumnDataType>(probe_table, column_id, probe_groups,
+                                           [&](const auto group_offset, const auto& value) {
+                                             aggregate_function(value, results[group_offset], secondary_aggregates);
+                                             if constexpr (function == AggregateFunction::Avg) {
+                                               ++value_counts[group_offset];
+                                             }
+                                           });
+
+    auto values = pmr_vector<AggregateType>(group_count);
+    auto null_values = pmr_vector<bool>(group_count);
+    for (auto group_offset = size_t{0}; group_offset < group_count; ++group_offset) {
+      const auto& result = results[group_offset];
+      if (!result) {
+        null_values[group_offset] = true;
+      } else if constexpr (function == AggregateFunction::Avg) {
+        values[group_offset] = *result / static_cast<AggregateType>(value_counts[group_offset]);
+      } else {
+        values[group_offset] = *result;
+      }
+    }
+
+    return std::make_shared<ValueSegment<AggregateType>>(std::move(values), std::move(null_values));
+  }
+}
+
+// Collects the values of a column of the left input for the rows that form the groups
+std::shared_ptr<BaseSegment> build_column(const Table& build_table, const ColumnID column_id,
+                                          const RowIDPosList& group_rows, const bool nullable) {
+  auto segment = std::shared_ptr<BaseSegment>{};
+
+  resolve_data_type(build_table.column_data_type(column_id), [&](const auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    auto values = pmr_vector<ColumnDataType>(group_rows.size());
+    auto null_values = pmr_vector<bool>(group_rows.size());
+    auto accessors = std::vector<std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>(build_table.chunk_count());
+
+    for (auto group_offset = size_t{0}; group_offset < group_rows.size(); ++group_offset) {
+      const auto& row_id = group_rows[group_offset];
+
+      auto& accessor = accessors[row_id.chunk_id];
+      if (!accessor) {
+        accessor =
+            create_segment_accessor<ColumnDataType>(build_table.get_chunk(row_id.chunk_id)->get_segment(column_id));
+      }
+
+      auto value = accessor->access(row_id.chunk_offset);
+      if (value) {
+        values[group_offset] = std::move(*value);
+      } else {
+        null_values[group_offset] = true;
+      }
+    }
+
+    if (nullable) {
+      segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+    } else {
+      segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+    }
+  });
+
+  return segment;
+}
+
+}  // namespace
+
+namespace opossum {
+
+GroupJoin::GroupJoin(const std::shared_ptr<const AbstractOperator>& left,
+                     const std::shared_ptr<const AbstractOperator>& right, const OperatorJoinPredicate& join_predicate,
+                     const std::vector<std::shared_ptr<AggregateExpression>>& aggregates,
+                     const std::vector<ColumnID>& groupby_column_ids)
+    : AbstractReadOnlyOperator(OperatorType::GroupJoin, left, right),
+      _join_predicate{join_predicate},
+      _aggregates{aggregates},
+      _groupby_column_ids{groupby_column_ids} {
+  Assert(_join_predicate.predicate_condition == PredicateCondition::Equals, "GroupJoin only supports equi joins");
+  Assert(!_groupby_column_ids.empty(), "GroupJoin requires the join column of the left input to be grouped by");
+
+  for (const auto& aggregate : _aggregates) {
+    Assert(std::dynamic_pointer_cast<PQPColumnExpression>(aggregate->argument()),
+           "GroupJoin can only aggregate physical columns");
+    Assert(aggregate->aggregate_function != AggregateFunction::CountDistinct &&
+               aggregate->aggregate_function != AggregateFunction::StandardDeviationSample,
+           "GroupJoin does not support COUNT(DISTINCT) and STDDEV_SAMP");
+  }
+}
+
+const std::string& GroupJoin::name() const {
+  static const auto name = std::string{"GroupJoin"};
+  return name;
+}
+
+std::string GroupJoin::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+  stream << "[" << name() << "]" << separator << "Join ColumnIDs: " << _join_predicate.column_ids.first << " "
+         << _join_predicate.predicate_condition << " " << _join_predicate.column_ids.second << separator
+         << "GroupBy ColumnIDs: ";
+  for (auto groupby_column_idx = size_t{0}; groupby_column_idx < _groupby_column_ids.size(); ++groupby_column_idx) {
+    stream << _groupby_column_ids[groupby_column_idx];
+    if (groupby_column_idx + 1 < _groupby_column_ids.size()) stream << ", ";
+  }
+
+  stream << separator << "Aggregates: ";
+  for (auto expression_idx = size_t{0}; expression_idx < _aggregates.size(); ++expression_idx) {
+    stream << _aggregates[expression_idx]->as_column_name();
+    if (expression_idx + 1 < _aggregates.size()) stream << ", ";
+  }
+
+  return stream.str();
+}
+
+const OperatorJoinPredicate& GroupJoin::join_predicate() const { return _join_predicate; }
+
+const std::vector<std::shared_ptr<AggregateExpression>>& GroupJoin::aggregates() const { return _aggregates; }
+
+const std::vector<ColumnID>& GroupJoin::groupby_column_ids() const { return _groupby_column_ids; }
+
+std::shared_ptr<const Table> GroupJoin::_on_execute() {
+  const auto& build_table = *input_table_left();
+  const auto& probe_table = *input_table_right();
+  const auto build_column_count = build_table.column_count();
+  const auto [build_column_id, probe_column_id] = _join_predicate.column_ids;
+
+  Assert(build_table.column_data_type(build_column_id) == probe_table.column_data_type(probe_column_id),
+         "GroupJoin requires join columns of the same data type");
+
+  // Build a hash table on the join column of the left input that maps every key to its group and probe it with the
+  // right input. For each row of the right input, only its group is stored.
+  auto group_rows = RowIDPosList{};
+  auto match_counts = std::vector<int64_t>{};
+  auto probe_groups = ProbeGroups(probe_table.chunk_count());
+
+  resolve_data_type(build_table.column_data_type(build_column_id), [&](const auto type) {
+    using KeyType = typename decltype(type)::type;
+
+    auto hash_table = std::unordered_map<KeyType, GroupOffset>{};
+    hash_table.reserve(build_table.row_count());
+
+    const auto build_chunk_count = build_table.chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < build_chunk_count; ++chunk_id) {
+      const auto chunk = build_table.get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      segment_iterate<KeyType>(*chunk->get_segment(build_column_id), [&](const auto& position) {
+        if (position.is_null()) return;
+
+        const auto group_offset = static_cast<GroupOffset>(group_rows.size());
+        const auto inserted = hash_table.try_emplace(position.value(), group_offset).second;
+        Assert(inserted, "GroupJoin requires the join column of the left input to be unique");
+        group_rows.emplace_back(RowID{chunk_id, ChunkOffset{position.chunk_offset()}});
+      });
+    }
+
+    match_counts.resize(group_rows.size());
+
+    const auto probe_chunk_count = probe_table.chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < probe_chunk_count; ++chunk_id) {
+      const auto chunk = probe_table.get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      auto& chunk_groups = probe_groups[chunk_id];
+      chunk_groups.resize(chunk->size(), NO_GROUP);
+
+      segment_iterate<KeyType>(*chunk->get_segment(probe_column_id), [&](const auto& position) {
+        if (position.is_null()) return;
+
+        const auto hash_table_iter = hash_table.find(position.value());
+        if (hash_table_iter == hash_table.end()) return;
+
+        chunk_groups[position.chunk_offset()] = hash_table_iter->second;
+        ++match_counts[hash_table_iter->second];
+      });
+    }
+  });
+
+  // As in an inner join, rows of the left input without a join partner are dropped. Renumber the remaining groups so
+  // that they are dense.
+  auto output_offsets = std::vector<GroupOffset>(group_rows.size(), NO_GROUP);
+  auto group_count = size_t{0};
+  for (auto group_offset = size_t{0}; group_offset < group_rows.size(); ++group_offset) {
+    if (match_counts[group_offset] == 0) continue;
+
+    output_offsets[group_offset] = static_cast<GroupOffset>(group_count);
+    group_rows[group_count] = group_rows[group_offset];
+    match_counts[group_count] = match_counts[group_offset];
+    ++group_count;
+  }
+  group_rows.resize(group_count);
+  match_counts.resize(group_count);
+
+  for (auto& chunk_groups : probe_groups) {
+    for (auto& group_offset : chunk_groups) {
+      if (group_offset != NO_GROUP) group_offset = output_offsets[group_offset];
+    }
+  }
+
+  auto output_column_definitions = TableColumnDefinitions{};
+  auto output_segments = Segments{};
+
+  for (const auto column_id : _groupby_column_ids) {
+    Assert(column_id < build_column_count, "GroupJoin can only group by columns of the left input");
+    const auto nullable = build_table.column_is_nullable(column_id);
+    output_column_definitions.emplace_back(build_table.column_name(column_id), build_table.column_data_type(column_id),
+                                           nullable);
+    output_segments.emplace_back(build_column(build_table, column_id, group_rows, nullable));
+  }
+
+  for (const auto& aggregate : _aggregates) {
+    const auto function = aggregate->aggregate_function;
+    const auto column_id = static_cast<const PQPColumnExpression&>(*aggregate->argument()).column_id;
+
+    // COUNT(*) is the number of join partners
+    if (column_id == INVALID_COLUMN_ID) {
+      Assert(function == AggregateFunction::Count, "Asterisk is only valid with COUNT");
+      output_column_definitions.emplace_back(aggregate->as_column_name(), DataType::Long, false);
+      output_segments.emplace_back(
+          std::make_shared<ValueSegment<int64_t>>(pmr_vector<int64_t>(match_counts.begin(), match_counts.end())));
+      continue;
+    }
+
+    // All rows of a group share the same row of the left input. As in the AggregateHash, ANY() is always nullable.
+    if (function == AggregateFunction::Any) {
+      Assert(column_id < build_column_count, "GroupJoin expects the argument of ANY() to stem from the left input");
+      output_column_definitions.emplace_back(aggregate->as_column_name(), build_table.column_data_type(column_id),
+                                             true);
+      output_segments.emplace_back(build_column(build_table, column_id, group_rows, true));
+      continue;
+    }
+
+    Assert(column_id >= build_column_count, "GroupJoin expects aggregate arguments to stem from the right input");
+    const auto aggregate_column_id = static_cast<ColumnID>(column_id - build_column_count);
+
+    auto segment = std::shared_ptr<BaseSegment>{};
+    resolve_data_type(probe_table.column_data_type(aggregate_column_id), [&](const auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      switch (function) {
+        case AggregateFunction::Min:
+          segment = aggregate_probe_column<ColumnDataType, AggregateFunction::Min>(probe_table, aggregate_column_id,
+                                                                                   probe_groups, group_count);
+          break;
+        case AggregateFunction::Max:
+          segment = aggregate_probe_column<ColumnDataType, AggregateFunction::Max>(probe_table, aggregate_column_id,
+                                                                                   probe_groups, group_count);
+          break;
+        case AggregateFunction::Sum:
+          segment = aggregate_probe_column<ColumnDataType, AggregateFunction::Sum>(probe_table, aggregate_column_id,
+                                                                                   probe_groups, group_count);
+          break;
+        case AggregateFunction::Avg:
+          segment = aggregate_probe_column<ColumnDataType, AggregateFunction::Avg>(probe_table, aggregate_column_id,
+                                                                                   probe_groups, group_count);
+          break;
+        case AggregateFunction::Count:
+          segment = aggregate_probe_column<ColumnDataType, AggregateFunction::Count>(probe_table, aggregate_column_id,
+                                                                                     probe_groups, group_count);
+          break;
+        case AggregateFunction::CountDistinct:
+        case AggregateFunction::StandardDeviationSample:
+        case AggregateFunction::Any:
+          Fail("Unsupported aggregate function");
+      }
+    });
+
+    output_column_definitions.emplace_back(aggregate->as_column_name(), segment->data_type(),
+                                           function != AggregateFunction::Count);
+    output_segments.emplace_back(segment);
+  }
+
+  auto output = std::make_shared<Table>(output_column_definitions, TableType::Data);
+  output->append_chunk(output_segments);
+
+  return output;
+}
+
+std::shared_ptr<AbstractOperator> GroupJoin::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  return std::make_shared<GroupJoin>(copied_input_left, copied_input_right, _join_predicate, _aggregates,
+                                     _groupby_column_ids);
+}
+
+void GroupJoin::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
+
+}  // namespace opossum
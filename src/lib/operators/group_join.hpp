@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "expression/aggregate_expression.hpp"
+#include "operator_join_predicate.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Operator that fuses an inner equi hash join with the aggregation on top of it (see GroupJoinRule). Take the
+ * following query as an example:
+ *
+ *   SELECT c_custkey, ANY(c_name), SUM(o_totalprice) FROM customer, orders WHERE c_custkey = o_custkey
+ *   GROUP BY c_custkey
+ *
+ * As c_custkey is unique in customer, every row of the left (build) input forms exactly one group. Thus, the hash table
+ * that the join builds on c_custkey doubles as the aggregation hash table, and the aggregates can be accumulated
+ * directly while probing it with the rows of the right input. The join result is never materialized.
+ *
+ * The group by columns and the arguments of the aggregates are ColumnIDs into the (virtual) join result, i.e., the
+ * columns of the left input are followed by those of the right input. This way, they are the same as for an
+ * AggregateHash on top of the join. The following restrictions apply:
+ *  - The join column of the left input has to be unique (apart from NULLs). This is verified during execution.
+ *  - Both join columns have to be of the same data type.
+ *  - The group by columns and the arguments of ANY() have to stem from the left input. They are functionally
+ *    dependent on the join column.
+ *  - The arguments of all other aggregates (MIN, MAX, SUM, AVG, and COUNT) have to stem from the right input.
+ *
+ * As in an inner join, rows of the left input without a join partner do not produce a group.
+ */
+class GroupJoin : public AbstractReadOnlyOperator {
+ public:
+  GroupJoin(const std::shared_ptr<const AbstractOperator>& left, const std::shared_ptr<const AbstractOperator>& right,
+            const OperatorJoinPredicate& join_predicate,
+            const std::vector<std::shared_ptr<AggregateExpression>>& aggregates,
+            const std::vector<ColumnID>& groupby_column_ids);
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+  const OperatorJoinPredicate& join_predicate() const;
+  const std::vector<std::shared_ptr<AggregateExpression>>& aggregates() const;
+  const std::vector<ColumnID>& groupby_column_ids() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+  const OperatorJoinPredicate _join_predicate;
+  const std::vector<std::shared_ptr<AggregateExpression>> _aggregates;
+  const std::vector<ColumnID> _groupby_column_ids;
+};
+
+}  // namespace opossum
@@ -11,13 +11,15 @@
 namespace opossum {
 
 Import::Import(const std::string& init_filename, const std::string& tablename, const ChunkOffset chunk_size,
-               const FileType file_type, const std::optional<CsvMeta>& csv_meta)
+               const FileType file_type, const std::optional<CsvMeta>& csv_meta,
+               const std::optional<SegmentEncodingSpec>& encoding_spec)
     : AbstractReadOnlyOperator(OperatorType::Import),
       filename(init_filename),
       _tablename(tablename),
       _chunk_size(chunk_size),
       _file_type(file_type),
-      _csv_meta(csv_meta) {
+      _csv_meta(csv_meta),
+      _encoding_spec(encoding_spec) {
   if (_file_type == FileType::Auto) {
     _file_type = file_type_from_filename(filename);
   }
@@ -38,7 +40,7 @@ std::shared_ptr<const Table> Import::_on_execute() {
 
   switch (_file_type) {
     case FileType::Csv:
-      table = CsvParser::parse(filename, _chunk_size, _csv_meta);
+      table = CsvParser::parse(filename, _chunk_size, _csv_meta, _encoding_spec);
       break;
     case FileType::Tbl:
       table = load_table(filename, _chunk_size);
@@ -63,7 +65,7 @@ std::shared_ptr<const Table> Import::_on_execute() {
 std::shared_ptr<AbstractOperator> Import::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<Import>(filename, _tablename, _chunk_size, _file_type, _csv_meta);
+  return std::make_shared<Import>(filename, _tablename, _chunk_size, _file_type, _csv_meta, _encoding_spec);
 }
 
 void Import::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
@@ -4,12 +4,14 @@
 
 #include "expression/between_expression.hpp"
 
+#include "get_table.hpp"
 #include "hyrise.hpp"
 
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 
 #include "storage/index/abstract_index.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
 #include "storage/reference_segment.hpp"
 
 #include "utils/assert.hpp"
@@ -26,12 +28,23 @@ IndexScan::IndexScan(const std::shared_ptr<const AbstractOperator>& in, const Se
       _right_values{right_values},
       _right_values2{right_values2} {}
 
+IndexScan::IndexScan(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& left_column_ids,
+                     const std::vector<AllParameterVariant>& right_values)
+    : AbstractReadOnlyOperator{OperatorType::IndexScan, in},
+      _index_type{SegmentIndexType::Invalid},
+      _left_column_ids{left_column_ids},
+      _predicate_condition{PredicateCondition::Equals},
+      _uses_table_hash_index{true},
+      _table_hash_index_values{right_values} {}
+
 const std::string& IndexScan::name() const {
   static const auto name = std::string{"IndexScan"};
   return name;
 }
 
 std::shared_ptr<const Table> IndexScan::_on_execute() {
+  if (_uses_table_hash_index) return _scan_table_hash_index();
+
   _in_table = input_table_left();
 
   _validate_input();
@@ -67,11 +80,23 @@ std::shared_ptr<const Table> IndexScan::_on_execute() {
 std::shared_ptr<AbstractOperator> IndexScan::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  if (_uses_table_hash_index) {
+    return std::make_shared<IndexScan>(copied_input_left, _left_column_ids, _table_hash_index_values);
+  }
   return std::make_shared<IndexScan>(copied_input_left, _index_type, _left_column_ids, _predicate_condition,
                                      _right_values, _right_values2);
 }
 
-void IndexScan::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
+void IndexScan::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  for (auto& value : _table_hash_index_values) {
+    if (!is_parameter_id(value)) continue;
+
+    const auto parameter_iter = parameters.find(boost::get<ParameterID>(value));
+    if (parameter_iter != parameters.end()) {
+      value = parameter_iter->second;
+    }
+  }
+}
 
 std::shared_ptr<AbstractTask> IndexScan::_create_job_and_schedule(const ChunkID chunk_id, std::mutex& output_mutex) {
   auto job_task = std::make_shared<JobTask>([this, chunk_id, &output_mutex]() {
@@ -201,4 +226,64 @@ RowIDPosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
   return matches_out;
 }
 
+std::shared_ptr<const Table> IndexScan::_scan_table_hash_index() {
+  const auto get_table = std::dynamic_pointer_cast<const GetTable>(input_left());
+  Assert(get_table, "IndexScan on a table hash index requires a GetTable as input");
+
+  const auto stored_table = Hyrise::get().storage_manager.get_table(get_table->table_name());
+
+  // Map the ColumnIDs of the (pruned) input table to those of the stored table
+  const auto stored_column_ids = get_table->unpruned_column_ids();
+
+  auto index_column_ids = std::vector<ColumnID>{};
+  index_column_ids.reserve(_left_column_ids.size());
+  for (const auto column_id : _left_column_ids) {
+    index_column_ids.emplace_back(stored_column_ids[column_id]);
+  }
+
+  const auto table_hash_index = stored_table->get_table_hash_index(index_column_ids);
+  Assert(table_hash_index, "No table hash index found for the scanned columns");
+
+  auto values = std::vector<AllTypeVariant>{};
+  values.reserve(_table_hash_index_values.size());
+  for (const auto& value : _table_hash_index_values) {
+    Assert(is_variant(value), "Parameters of the IndexScan have not been set");
+    values.emplace_back(boost::get<AllTypeVariant>(value));
+  }
+
+  auto stored_matches = RowIDPosList{};
+  table_hash_index->lookup(values, stored_matches);
+
+  // The output references the output of GetTable, not the stored table, so that the columns of rows updated in place
+  // are read in the version the transaction sees. Rows of chunks that GetTable excluded are skipped, as are rows
+  // that were appended to a chunk after its updated segments were reconstructed. Rows that are not visible to the
+  // current transaction are removed by the following Validate operator.
+  const auto input_table = input_table_left();
+  auto matches = std::make_shared<RowIDPosList>();
+  matches->reserve(stored_matches.size());
+  for (const auto& stored_row_id : stored_matches) {
+    const auto chunk_id = get_table->output_chunk_id(stored_row_id.chunk_id);
+    if (!chunk_id || stored_row_id.chunk_offset >= input_table->get_chunk(*chunk_id)->size()) continue;
+
+    matches->emplace_back(*chunk_id, stored_row_id.chunk_offset);
+  }
+  std::sort(matches->begin(), matches->end());
+
+  auto out_table = std::make_shared<Table>(input_table->column_definitions(), TableType::References);
+  if (matches->empty()) return out_table;
+
+  if (matches->front().chunk_id == matches->back().chunk_id) {
+    matches->guarantee_single_chunk();
+  }
+
+  auto segments = Segments{};
+  segments.reserve(input_table->column_count());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    segments.emplace_back(std::make_shared<ReferenceSegment>(input_table, column_id, matches));
+  }
+  out_table->append_chunk(segments);
+
+  return out_table;
+}
+
 }  // namespace opossum
@@ -4,6 +4,7 @@
 
 #include "abstract_read_only_operator.hpp"
 
+#include "all_parameter_variant.hpp"
 #include "all_type_variant.hpp"
 #include "storage/index/segment_index_type.hpp"
 #include "storage/pos_lists/row_id_pos_list.hpp"
@@ -17,6 +18,9 @@ class AbstractTask;
 /**
  * Operator that performs a predicate search using indexes
  *
+ * It either uses the chunk indexes of the given type or performs a point lookup in a table-level hash index (see
+ * TableHashIndex).
+ *
  * Note: Scans only the set of chunks passed to the constructor
  */
 class IndexScan : public AbstractReadOnlyOperator {
@@ -25,6 +29,16 @@ class IndexScan : public AbstractReadOnlyOperator {
             const std::vector<ColumnID>& left_column_ids, const PredicateCondition predicate_condition,
             const std::vector<AllTypeVariant>& right_values, const std::vector<AllTypeVariant>& right_values2 = {});
 
+  /**
+   * Looks up the rows whose left_column_ids are equal to right_values in the table hash index on these columns. `in`
+   * has to be a GetTable operator, whose pruned chunks and columns are respected. The values may be placeholders that
+   * are set via set_parameters(). The output references the output of GetTable, so that rows updated in place are
+   * seen in the version of the current transaction. It contains all matching rows, i.e., it still needs to be
+   * validated.
+   */
+  IndexScan(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& left_column_ids,
+            const std::vector<AllParameterVariant>& right_values);
+
   const std::string& name() const final;
 
   // If set, only the specified chunks will be scanned. See TableScan::excluded_chunk_ids for usage.
@@ -42,6 +56,8 @@ class IndexScan : public AbstractReadOnlyOperator {
   std::shared_ptr<AbstractTask> _create_job_and_schedule(const ChunkID chunk_id, std::mutex& output_mutex);
   RowIDPosList _scan_chunk(const ChunkID chunk_id);
 
+  std::shared_ptr<const Table> _scan_table_hash_index();
+
  private:
   const SegmentIndexType _index_type;
   const std::vector<ColumnID> _left_column_ids;
@@ -49,6 +65,9 @@ class IndexScan : public AbstractReadOnlyOperator {
   const std::vector<AllTypeVariant> _right_values;
   const std::vector<AllTypeVariant> _right_values2;
 
+  const bool _uses_table_hash_index{false};
+  std::vector<AllParameterVariant> _table_hash_index_values;
+
   std::shared_ptr<const Table> _in_table;
   std::shared_ptr<Table> _out_table;
 };
@@ -8,7 +8,9 @@
 #include "concurrency/transaction_context.hpp"
 #include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "statistics/table_statistics_maintainer.hpp"
 #include "storage/base_encoded_segment.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/value_segment.hpp"
 #include "utils/assert.hpp"
@@ -213,6 +215,54 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     }
   }
 
+  /**
+   * 3. Add the new rows to the table-level hash indexes of the target Table. This happens only after the data was
+   *    written so that lookups never return rows with incomplete values. Until this transaction commits, other
+   *    transactions will filter the new rows out during validation. For indexes that back an enforced unique
+   *    constraint, the index returns the rows that share a key with one of the new rows while inserting them. This way,
+   *    the constraint is checked for the entire batch without additional lookups.
+   */
+  const auto& constraints = _target_table->get_soft_unique_constraints();
+  auto existing_row_ids = std::vector<RowID>{};
+  for (const auto& table_hash_index : _target_table->table_hash_indexes()) {
+    const auto enforces_constraint =
+        std::any_of(constraints.begin(), constraints.end(), [&](const auto& constraint) {
+          return constraint.is_enforced == IsEnforced::Yes && constraint.columns == table_hash_index->column_ids();
+        });
+
+    for (const auto& target_chunk_range : _target_chunk_ranges) {
+      const auto target_chunk = _target_table->get_chunk(target_chunk_range.chunk_id);
+      table_hash_index->insert(*target_chunk, target_chunk_range.chunk_id, target_chunk_range.begin_chunk_offset,
+                               target_chunk_range.end_chunk_offset, enforces_constraint ? &existing_row_ids : nullptr);
+    }
+  }
+
+  /**
+   * 4. Check the unique constraints. A row with the same key as one of the new rows violates the constraint unless it
+   *    was deleted or rolled back, or unless it is being deleted by this transaction (as done by Update). Rows of other
+   *    transactions that are still in flight are treated as violations as well, because we cannot know whether these
+   *    transactions will commit. Of two concurrent transactions inserting the same key, at least the one that inserts
+   *    into the index last fails.
+   */
+  const auto transaction_id = context->transaction_id();
+  for (const auto& row_id : existing_row_ids) {
+    const auto chunk = _target_table->get_chunk(row_id.chunk_id);
+    if (!chunk) continue;
+
+    const auto& mvcc_data = chunk->mvcc_data();
+    if (mvcc_data->get_end_cid(row_id.chunk_offset) != MvccData::MAX_COMMIT_ID) continue;
+
+    const auto row_tid = mvcc_data->get_tid(row_id.chunk_offset);
+    const auto is_committed = mvcc_data->get_begin_cid(row_id.chunk_offset) != MvccData::MAX_COMMIT_ID;
+
+    // Rows that this transaction inserted and deleted again have their TID reset (see Delete)
+    if (!is_committed && row_tid == INVALID_TRANSACTION_ID) continue;
+    if (is_committed && row_tid == transaction_id) continue;
+
+    _mark_as_failed();
+    return nullptr;
+  }
+
   return nullptr;
 }
 
@@ -230,6 +280,12 @@ void Insert::_on_commit_records(const CommitID cid) {
     // This fence ensures that the changes to TID (which are not sequentially consistent) are visible to other threads.
     std::atomic_thread_fence(std::memory_order_release);
   }
+
+  auto committed_row_count = int64_t{0};
+  for (const auto& target_chunk_range : _target_chunk_ranges) {
+    committed_row_count += target_chunk_range.end_chunk_offset - target_chunk_range.begin_chunk_offset;
+  }
+  _update_statistics(committed_row_count);
 }
 
 void Insert::_on_rollback_records() {
@@ -271,6 +327,29 @@ void Insert::_on_rollback_records() {
     // This fence ensures that the changes to TID (which are not sequentially consistent) are visible to other threads.
     std::atomic_thread_fence(std::memory_order_release);
   }
+
+  // Rolled back rows still occupy the chunk, which might be full now
+  _update_statistics(0);
+}
+
+void Insert::_update_statistics(const int64_t committed_row_count) const {
+  const auto statistics_maintainer = _target_table->statistics_maintainer();
+  if (!statistics_maintainer) return;
+
+  if (committed_row_count > 0 && statistics_maintainer->update_row_count(committed_row_count)) {
+    TableStatisticsMaintainer::schedule_update(_target_table);
+    return;
+  }
+
+  const auto target_chunk_size = _target_table->target_chunk_size();
+  const auto filled_chunk = std::any_of(
+      _target_chunk_ranges.cbegin(), _target_chunk_ranges.cend(), [&](const auto& target_chunk_range) {
+        return _target_table->get_chunk(target_chunk_range.chunk_id)->size() == target_chunk_size;
+      });
+  if (!filled_chunk) return;
+
+  // Finalizing the chunk and merging its statistics is not part of the commit
+  TableStatisticsMaintainer::schedule_update(_target_table);
 }
 
 std::shared_ptr<AbstractOperator> Insert::_on_deep_copy(
@@ -17,6 +17,9 @@ class TransactionContext;
  * Expects the table name of the table to insert into as a string and
  * the values to insert in a separate table using the same column layout.
  *
+ * If the target table has enforced unique constraints (see Table::add_unique_constraint) and one of the new rows
+ * violates them, the operator fails and the transaction has to be rolled back.
+ *
  * Assumption: The input has been validated before.
  */
 class Insert : public AbstractReadWriteOperator {
@@ -47,6 +50,10 @@ class Insert : public AbstractReadWriteOperator {
   std::vector<ChunkRange> _target_chunk_ranges;
 
   std::shared_ptr<Table> _target_table;
+
+  // Passes the committed rows to the TableStatisticsMaintainer of the target table and, if the row count drifted or the
+  // insert filled a chunk, schedules an update of the statistics.
+  void _update_statistics(const int64_t committed_row_count) const;
 };
 
 }  // namespace opossum
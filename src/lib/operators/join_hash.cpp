@@ -10,9 +10,13 @@
 #include <vector>
 
 #include "bytell_hash_map.hpp"
+#include "concurrency/cancellation_token.hpp"
 #include "hyrise.hpp"
 #include "join_hash/join_hash_steps.hpp"
 #include "join_hash/join_hash_traits.hpp"
+#include "memory/query_memory_budget.hpp"
+#include "operators/spilling/grace_partitioning.hpp"
+#include "operators/table_wrapper.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "type_comparison.hpp"
@@ -173,6 +177,10 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
     output_column_order = OutputColumnOrder::BuildFirstProbeSecond;
   }
 
+  auto memory_budget_reservation = MemoryBudgetReservation{};
+  auto grace_partition_count = std::optional<size_t>{};
+  auto estimated_bytes = size_t{0};
+
   resolve_data_type(build_column_type, [&](const auto build_data_type_t) {
     using BuildColumnDataType = typename decltype(build_data_type_t)::type;
     resolve_data_type(probe_column_type, [&](const auto probe_data_type_t) {
@@ -198,6 +206,28 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
                    max_partition_size,
                "Partition count too small (potential overflows in hash map offsetting).");
 
+        // Estimate the working memory of the materialized and radix-partitioned inputs (RadixContainers) and of the
+        // PosHashTables. If it does not fit into the query's memory budget, fall back to the grace hash join. For
+        // AntiNullAsTrue, this is not possible: A NULL on the build side removes all probe rows, not only those in
+        // its partition.
+        using HashedType = typename JoinHashTraits<BuildColumnDataType, ProbeColumnDataType>::HashType;
+        const auto build_row_count = build_input_table->row_count();
+        const auto probe_row_count = probe_input_table->row_count();
+        estimated_bytes = 2 * build_row_count * (sizeof(BuildColumnDataType) + sizeof(RowID)) +
+                          2 * probe_row_count * (sizeof(ProbeColumnDataType) + sizeof(RowID)) +
+                          static_cast<size_t>(static_cast<double>(build_row_count) *
+                                              static_cast<double>(sizeof(HashedType) + sizeof(RowID)) / 0.8);
+
+        if (_mode == JoinMode::AntiNullAsTrue) {
+          memory_budget_reservation = MemoryBudgetReservation::reserve(memory_budget(), estimated_bytes);
+        } else if (auto reservation = MemoryBudgetReservation::try_reserve(memory_budget(), estimated_bytes)) {
+          memory_budget_reservation = std::move(*reservation);
+        } else {
+          grace_partition_count =
+              GracePartitioning::partition_count_for(estimated_bytes, memory_budget()->available_bytes());
+          return;
+        }
+
         _impl = std::make_unique<JoinHashImpl<BuildColumnDataType, ProbeColumnDataType>>(
             *this, build_input_table, probe_input_table, _mode, adjusted_column_ids,
             _primary_predicate.predicate_condition, output_column_order, *_radix_bits,
@@ -208,9 +238,57 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
     });
   });
 
+  if (grace_partition_count) return _on_execute_grace(*grace_partition_count, estimated_bytes);
+
   return _impl->_on_execute();
 }
 
+std::shared_ptr<const Table> JoinHash::_on_execute_grace(const size_t partition_count, const size_t estimated_bytes) {
+  // Rows with equal join keys end up in partitions with the same id on both sides. Thus, joining the partition pairs
+  // independently yields the complete result for all supported join modes. NULLs never match, but rows with NULL keys
+  // are still kept in one of the partitions so that outer and anti joins emit them.
+  const auto left_partitioning =
+      GracePartitioning{input_table_left(), {_primary_predicate.column_ids.first}, partition_count};
+  const auto right_partitioning =
+      GracePartitioning{input_table_right(), {_primary_predicate.column_ids.second}, partition_count};
+
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
+
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    if (left_partitioning.partition_row_count(partition_id) == 0 &&
+        right_partitioning.partition_row_count(partition_id) == 0) {
+      continue;
+    }
+
+    const auto memory_budget_reservation =
+        MemoryBudgetReservation::reserve(memory_budget(), estimated_bytes / partition_count);
+
+    const auto left_partition = std::make_shared<TableWrapper>(left_partitioning.load_partition(partition_id));
+    const auto right_partition = std::make_shared<TableWrapper>(right_partitioning.load_partition(partition_id));
+    left_partition->execute();
+    right_partition->execute();
+
+    // The partition join does not get a memory budget. Partitioning its inputs again would not help, as all of their
+    // rows have the same partition id.
+    const auto partition_join = std::make_shared<JoinHash>(left_partition, right_partition, _mode, _primary_predicate,
+                                                           _secondary_predicates);
+    partition_join->execute();
+
+    const auto& partition_output = partition_join->get_output();
+    const auto chunk_count = partition_output->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = partition_output->get_chunk(chunk_id);
+      auto segments = Segments{};
+      for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+        segments.emplace_back(chunk->get_segment(column_id));
+      }
+      output_chunks.emplace_back(std::make_shared<Chunk>(std::move(segments)));
+    }
+  }
+
+  return _build_output_table(std::move(output_chunks));
+}
+
 void JoinHash::_on_cleanup() { _impl.reset(); }
 
 template <typename BuildColumnType, typename ProbeColumnType>
@@ -383,6 +461,9 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
     Hyrise::get().scheduler()->wait_for_tasks(jobs);
 
+    // The hash tables might be incomplete if the query was cancelled during the build phase (see build())
+    if (CancellationTokenScope::is_cancelled()) return _join_hash._build_output_table({});
+
     // Short cut for AntiNullAsTrue
     //   If there is any NULL value on the build side, do not bother probing as no tuples can be emitted
     //   anyway (as long as JoinHash/AntiNullAsTrue doesn't support secondary predicates). Doing this early out
@@ -460,6 +541,9 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     radix_build_column.clear();
     radix_probe_column.clear();
 
+    // Partitions that were not probed because the query was cancelled are missing in the position lists
+    if (CancellationTokenScope::is_cancelled()) return _join_hash._build_output_table({});
+
     /**
      * 3. Write output Table
      */
@@ -41,6 +41,10 @@ class JoinHash : public AbstractJoinOperator {
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
   void _on_cleanup() override;
 
+  // Used if the estimated working memory exceeds the query's memory budget. Partitions both inputs by the join key,
+  // spills the partitions to disk, and joins one pair of partitions at a time.
+  std::shared_ptr<const Table> _on_execute_grace(const size_t partition_count, const size_t estimated_bytes);
+
   std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
   std::optional<size_t> _radix_bits;
 
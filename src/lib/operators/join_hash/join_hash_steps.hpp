@@ -5,6 +5,7 @@
 #include <uninitialized_vector.hpp>
 
 #include "bytell_hash_map.hpp"
+#include "concurrency/cancellation_token.hpp"
 #include "hyrise.hpp"
 #include "operators/multi_predicate_join/multi_predicate_join_evaluator.hpp"
 #include "resolve_type.hpp"
@@ -334,6 +335,9 @@ std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<
     }
 
     const auto insert_into_hash_table = [&, partition_idx]() {
+      // JoinHash checks the token after the build phase, so that incomplete hash tables are never probed
+      if (CancellationTokenScope::is_cancelled()) return;
+
       const auto hash_table_idx = radix_bits > 0 ? partition_idx : 0;
       const auto& elements = radix_container[partition_idx].elements;
 
@@ -503,6 +507,9 @@ void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
     }
 
     jobs.emplace_back(std::make_shared<JobTask>([&, partition_idx]() {
+      // JoinHash checks the token after the probe phase and does not write the incomplete position lists
+      if (CancellationTokenScope::is_cancelled()) return;
+
       const auto& partition = probe_radix_container[partition_idx];
       const auto& elements = partition.elements;
       const auto& null_values = partition.null_values;
@@ -643,6 +650,8 @@ void probe_semi_anti(const RadixContainer<ProbeColumnType>& probe_radix_containe
     }
 
     jobs.emplace_back(std::make_shared<JobTask>([&, partition_idx]() {
+      if (CancellationTokenScope::is_cancelled()) return;
+
       // Get information from work queue
       const auto& partition = probe_radix_container[partition_idx];
       const auto& elements = partition.elements;
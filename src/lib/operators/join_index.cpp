@@ -9,14 +9,19 @@
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "concurrency/transaction_context.hpp"
+#include "get_table.hpp"
+#include "hyrise.hpp"
 #include "join_nested_loop.hpp"
 #include "multi_predicate_join/multi_predicate_join_evaluator.hpp"
 #include "resolve_type.hpp"
 #include "storage/index/abstract_index.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
 #include "storage/segment_iterate.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
 #include "utils/performance_warning.hpp"
+#include "validate.hpp"
 
 namespace opossum {
 
@@ -87,6 +92,19 @@ std::shared_ptr<const Table> JoinIndex::_on_execute() {
     _index_input_table = input_table_right();
   }
 
+  // Prefer a table hash index on the stored table of the index side over the chunk indexes. Join modes that need to
+  // emit unmatched index side rows use the chunk indexes, as the table hash index cannot enumerate them.
+  const auto index_input_operator = _index_side == IndexSide::Left ? input_left() : input_right();
+  const auto get_table = std::dynamic_pointer_cast<const GetTable>(index_input_operator);
+  if (get_table && _adjusted_primary_predicate.predicate_condition == PredicateCondition::Equals &&
+      _secondary_predicates.empty() && _supports_table_hash_index()) {
+    const auto stored_table = Hyrise::get().storage_manager.get_table(get_table->table_name());
+    const auto index_column_id = get_table->unpruned_column_ids()[_adjusted_primary_predicate.column_ids.second];
+    const auto table_hash_index = stored_table->get_table_hash_index({index_column_id});
+
+    if (table_hash_index) return _on_execute_with_table_hash_index(*get_table, *table_hash_index);
+  }
+
   _index_matches.resize(_index_input_table->chunk_count());
   _probe_matches.resize(_probe_input_table->chunk_count());
 
@@ -254,6 +272,99 @@ std::shared_ptr<const Table> JoinIndex::_on_execute() {
   return _build_output_table({std::make_shared<Chunk>(output_segments)});
 }
 
+std::shared_ptr<const Table> JoinIndex::_on_execute_with_table_hash_index(
+    const GetTable& get_table, const TableHashIndex& table_hash_index) {
+  DebugAssert(_supports_table_hash_index(), "Join mode not supported by JoinIndex on a table hash index");
+  const auto is_semi_or_anti_join = _mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse;
+  const auto is_probe_side_outer_join = (_mode == JoinMode::Left && _index_side == IndexSide::Right) ||
+                                        (_mode == JoinMode::Right && _index_side == IndexSide::Left);
+
+  // The index side input is not validated as that would require looking at every row of the stored table. Instead, we
+  // check the visibility of the rows found in the index.
+  const auto validate = transaction_context_is_set() && _index_input_table->uses_mvcc() == UseMvcc::Yes;
+  const auto our_tid = validate ? transaction_context()->transaction_id() : INVALID_TRANSACTION_ID;
+  const auto snapshot_commit_id = validate ? transaction_context()->snapshot_commit_id() : MvccData::MAX_COMMIT_ID;
+
+  _probe_pos_list = std::make_shared<RowIDPosList>();
+  _index_pos_list = std::make_shared<RowIDPosList>();
+
+  auto index_matches = RowIDPosList{};
+  const auto probe_chunk_count = _probe_input_table->chunk_count();
+  for (auto probe_chunk_id = ChunkID{0}; probe_chunk_id < probe_chunk_count; ++probe_chunk_id) {
+    const auto probe_chunk = _probe_input_table->get_chunk(probe_chunk_id);
+    Assert(probe_chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    const auto& probe_segment = probe_chunk->get_segment(_adjusted_primary_predicate.column_ids.first);
+    segment_with_iterators(*probe_segment, [&](auto probe_iter, const auto probe_end) {
+      for (; probe_iter != probe_end; ++probe_iter) {
+        const auto probe_side_position = *probe_iter;
+        const auto probe_row_id = RowID{probe_chunk_id, probe_side_position.chunk_offset()};
+
+        index_matches.clear();
+        if (!probe_side_position.is_null()) {
+          table_hash_index.lookup({AllTypeVariant{probe_side_position.value()}}, index_matches);
+        }
+
+        auto has_match = false;
+        for (const auto& stored_row_id : index_matches) {
+          // The index contains RowIDs of the stored table. They are mapped to the output of GetTable, which contains
+          // the versions of rows updated in place. Rows of chunks that GetTable excluded are skipped, as are rows that
+          // were appended to a chunk after its updated segments were reconstructed.
+          const auto index_chunk_id = get_table.output_chunk_id(stored_row_id.chunk_id);
+          if (!index_chunk_id) continue;
+
+          const auto chunk_offset = stored_row_id.chunk_offset;
+          const auto index_chunk = _index_input_table->get_chunk(*index_chunk_id);
+          if (chunk_offset >= index_chunk->size()) continue;
+
+          if (validate) {
+            const auto& mvcc_data = *index_chunk->mvcc_data();
+            if (!Validate::is_row_visible(our_tid, snapshot_commit_id, mvcc_data.get_tid(chunk_offset),
+                                          mvcc_data.get_begin_cid(chunk_offset), mvcc_data.get_end_cid(chunk_offset))) {
+              continue;
+            }
+          }
+
+          has_match = true;
+          if (is_semi_or_anti_join) break;
+
+          _probe_pos_list->emplace_back(probe_row_id);
+          _index_pos_list->emplace_back(*index_chunk_id, chunk_offset);
+        }
+
+        if (is_semi_or_anti_join) {
+          if (has_match == (_mode == JoinMode::Semi)) _probe_pos_list->emplace_back(probe_row_id);
+        } else if (is_probe_side_outer_join && !has_match) {
+          _probe_pos_list->emplace_back(probe_row_id);
+          _index_pos_list->emplace_back(NULL_ROW_ID);
+        }
+      }
+    });
+  }
+
+  auto& performance_data = static_cast<PerformanceData&>(*_performance_data);
+  performance_data.chunks_scanned_with_index = _index_input_table->chunk_count();
+
+  auto output_segments = Segments{};
+  if (_index_side == IndexSide::Left) {
+    _write_output_segments(output_segments, _index_input_table, _index_pos_list);
+    _write_output_segments(output_segments, _probe_input_table, _probe_pos_list);
+  } else {
+    _write_output_segments(output_segments, _probe_input_table, _probe_pos_list);
+    if (!is_semi_or_anti_join) _write_output_segments(output_segments, _index_input_table, _index_pos_list);
+  }
+
+  return _build_output_table({std::make_shared<Chunk>(output_segments)});
+}
+
+bool JoinIndex::_supports_table_hash_index() const {
+  const auto is_semi_or_anti_join = _mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse;
+  const auto is_probe_side_outer_join = (_mode == JoinMode::Left && _index_side == IndexSide::Right) ||
+                                        (_mode == JoinMode::Right && _index_side == IndexSide::Left);
+  return _mode == JoinMode::Inner || is_probe_side_outer_join ||
+         (is_semi_or_anti_join && _index_side == IndexSide::Right);
+}
+
 void JoinIndex::_fallback_nested_loop(const ChunkID index_chunk_id, const bool track_probe_matches,
                                       const bool track_index_matches, const bool is_semi_or_anti_join,
                                       MultiPredicateJoinEvaluator& secondary_predicate_evaluator) {
@@ -13,7 +13,9 @@
 
 namespace opossum {
 
+class GetTable;
 class MultiPredicateJoinEvaluator;
+class TableHashIndex;
 using IndexRange = std::pair<AbstractIndex::Iterator, AbstractIndex::Iterator>;
 
 /**
@@ -27,6 +29,12 @@ using IndexRange = std::pair<AbstractIndex::Iterator, AbstractIndex::Iterator>;
    * scanned with index in the performance data.
    *
    * Note: An index needs to be present on the index side table in order to execute an index join.
+   *
+   * If the index side input is a GetTable operator and the stored table has a table hash index (see TableHashIndex) on
+   * the join column, that index is probed instead of the chunk indexes. In this case, the index side rows are validated
+   * by the join itself (if a transaction context is set). The output references the output of the GetTable operator,
+   * which contains the versions of rows updated in place (see RowVersionStore). Only equi joins
+   * without secondary predicates that do not need to emit unmatched index side rows are supported in this mode.
    */
 class JoinIndex : public AbstractJoinOperator {
  public:
@@ -54,6 +62,13 @@ class JoinIndex : public AbstractJoinOperator {
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
+  // Whether the join mode and index side allow probing a table hash index, i.e., unmatched index side rows need not be
+  // emitted
+  bool _supports_table_hash_index() const;
+
+  std::shared_ptr<const Table> _on_execute_with_table_hash_index(const GetTable& get_table,
+                                                                 const TableHashIndex& table_hash_index);
+
   void _fallback_nested_loop(const ChunkID index_chunk_id, const bool track_probe_matches,
                              const bool track_index_matches, const bool is_semi_or_anti_join,
                              MultiPredicateJoinEvaluator& secondary_predicate_evaluator);
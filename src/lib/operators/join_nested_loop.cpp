@@ -5,6 +5,7 @@
 #include <utility>
 #include <vector>
 
+#include "concurrency/cancellation_token.hpp"
 #include "resolve_type.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/segment_iterables/any_segment_iterable.hpp"
@@ -165,6 +166,9 @@ std::shared_ptr<const Table> JoinNestedLoop::_on_execute() {
     }
 
     for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < chunk_count_right; ++chunk_id_right) {
+      // The result of a cancelled query is discarded anyway
+      if (CancellationTokenScope::is_cancelled()) return _build_output_table({});
+
       const auto chunk_right = right_table->get_chunk(chunk_id_right);
       Assert(chunk_right, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
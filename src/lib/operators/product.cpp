@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "concurrency/cancellation_token.hpp"
 #include "storage/reference_segment.hpp"
 
 namespace opossum {
@@ -40,6 +41,9 @@ std::shared_ptr<const Table> Product::_on_execute() {
     Assert(chunk_left, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
     for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < chunk_count_right_table; ++chunk_id_right) {
+      // The result of a cancelled query is discarded anyway, so the chunks added so far suffice
+      if (CancellationTokenScope::is_cancelled()) return output;
+
       const auto chunk_right = input_table_right()->get_chunk(chunk_id_right);
       Assert(chunk_right, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
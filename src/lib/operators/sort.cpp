@@ -1,5 +1,6 @@
 #include "sort.hpp"
 
+#include "memory/query_memory_budget.hpp"
 #include "storage/segment_iterate.hpp"
 
 namespace {
@@ -145,6 +146,11 @@ std::shared_ptr<const Table> Sort::_on_execute() {
     resolve_data_type(data_type, [&](auto type) {
       using ColumnDataType = typename decltype(type)::type;
 
+      // Account for the materialized sort column. Sort cannot spill, but the reservation reduces the memory left for
+      // the other operators of the query.
+      const auto memory_budget_reservation = MemoryBudgetReservation::reserve(
+          memory_budget(), input_table->row_count() * sizeof(std::pair<RowID, ColumnDataType>));
+
       auto sort_impl = SortImpl<ColumnDataType>(input_table, sort_definition.column, sort_definition.order_by_mode);
       previously_sorted_pos_list = sort_impl.sort(previously_sorted_pos_list);
 
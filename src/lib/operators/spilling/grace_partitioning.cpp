@@ -0,0 +1,150 @@
+#include "grace_partitioning.hpp"
+
+#include <stdlib.h>  // NOLINT
+
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <boost/functional/hash.hpp>
+
+#include "operators/join_hash/join_hash_steps.hpp"
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of RowIDs that are collected per partition before they are appended to the partition's spill file
+constexpr auto SPILL_BUFFER_SIZE = size_t{4'096};
+
+template <typename T>
+size_t partitioning_hash(const T& value) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    return std::hash<std::string_view>{}(std::string_view{value.data(), value.size()});
+  } else {
+    // Hash all numbers as doubles so that equal values of different types end up in the same partition. This mirrors
+    // JoinHash, which also compares, e.g., ints and doubles by converting them to a common type.
+    return std::hash<double>{}(static_cast<double>(value));
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+GracePartitioning::GracePartitioning(const std::shared_ptr<const Table>& table,
+                                     const std::vector<ColumnID>& key_column_ids, const size_t partition_count)
+    : _table(table), _partition_row_counts(partition_count) {
+  Assert(partition_count > 0, "Need at least one partition");
+  Assert(!key_column_ids.empty(), "Need at least one key column to partition by");
+
+  auto directory_template = (std::filesystem::temp_directory_path() / "hyrise_spill_XXXXXX").string();
+  Assert(mkdtemp(directory_template.data()), "Could not create spill directory");
+  _spill_directory = directory_template;
+
+  _partition(key_column_ids);
+}
+
+GracePartitioning::~GracePartitioning() {
+  auto error_code = std::error_code{};
+  std::filesystem::remove_all(_spill_directory, error_code);
+}
+
+size_t GracePartitioning::partition_count() const { return _partition_row_counts.size(); }
+
+size_t GracePartitioning::partition_row_count(const size_t partition_id) const {
+  return _partition_row_counts[partition_id];
+}
+
+std::shared_ptr<const Table> GracePartitioning::load_partition(const size_t partition_id) const {
+  auto partition = std::make_shared<Table>(_table->column_definitions(), TableType::References);
+  const auto row_count = _partition_row_counts[partition_id];
+  if (row_count == 0) return partition;
+
+  auto pos_list = std::make_shared<RowIDPosList>(row_count);
+  auto file = std::ifstream{_partition_path(partition_id), std::ios::binary};
+  file.read(reinterpret_cast<char*>(pos_list->data()), static_cast<std::streamsize>(row_count * sizeof(RowID)));
+  Assert(file.gcount() == static_cast<std::streamsize>(row_count * sizeof(RowID)), "Could not read spill file");
+
+  // Resolve the RowIDs, which point into the partitioned table, to the data tables referenced by it
+  auto pos_lists_by_chunk = PosListsByChunk{};
+  if (_table->type() == TableType::References) {
+    pos_lists_by_chunk = setup_pos_lists_by_chunk(_table);
+  }
+
+  auto segments = Segments{};
+  write_output_segments(segments, _table, pos_lists_by_chunk, pos_list);
+  partition->append_chunk(segments);
+
+  return partition;
+}
+
+size_t GracePartitioning::partition_count_for(const size_t estimated_bytes, const size_t available_bytes) {
+  const auto required_partitions = std::ceil(static_cast<double>(estimated_bytes) /
+                                             static_cast<double>(std::max(available_bytes, size_t{1})));
+  const auto partition_bits = static_cast<size_t>(std::ceil(std::log2(std::max(required_partitions, 2.0))));
+  return std::min(size_t{1} << std::min(partition_bits, size_t{63}), MAX_PARTITION_COUNT);
+}
+
+void GracePartitioning::_partition(const std::vector<ColumnID>& key_column_ids) {
+  const auto partition_count = _partition_row_counts.size();
+  auto spill_buffers = std::vector<std::vector<RowID>>(partition_count);
+
+  const auto flush = [&](const size_t partition_id) {
+    auto& spill_buffer = spill_buffers[partition_id];
+    if (spill_buffer.empty()) return;
+
+    auto file = std::ofstream{_partition_path(partition_id), std::ios::binary | std::ios::app};
+    file.write(reinterpret_cast<const char*>(spill_buffer.data()),
+               static_cast<std::streamsize>(spill_buffer.size() * sizeof(RowID)));
+    Assert(file.good(), "Could not write spill file");
+
+    _partition_row_counts[partition_id] += spill_buffer.size();
+    spill_buffer.clear();
+  };
+
+  auto hashes = std::vector<size_t>{};
+
+  const auto chunk_count = _table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = _table->get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    // Combine the hashes of all key columns, one column at a time, so that each segment is resolved only once
+    hashes.assign(chunk->size(), 0);
+    for (const auto column_id : key_column_ids) {
+      const auto& segment = *chunk->get_segment(column_id);
+      resolve_data_type(_table->column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+
+        segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+          const auto value_hash = position.is_null() ? size_t{0} : partitioning_hash(position.value());
+          boost::hash_combine(hashes[position.chunk_offset()], value_hash);
+        });
+      });
+    }
+
+    const auto chunk_size = static_cast<ChunkOffset>(hashes.size());
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      const auto partition_id = hashes[chunk_offset] % partition_count;
+      spill_buffers[partition_id].push_back(RowID{chunk_id, chunk_offset});
+      if (spill_buffers[partition_id].size() == SPILL_BUFFER_SIZE) flush(partition_id);
+    }
+  }
+
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    flush(partition_id);
+  }
+}
+
+std::filesystem::path GracePartitioning::_partition_path(const size_t partition_id) const {
+  return _spill_directory / ("partition_" + std::to_string(partition_id));
+}
+
+}  // namespace opossum
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Hash-partitions the rows of a table by the values of one or more key columns and spills the partitions to local
+ * disk. This is the first phase of the grace-style (i.e., partition-at-a-time) execution that JoinHash and
+ * AggregateHash fall back to if their query's memory budget is exhausted. Afterwards, the operators load and process
+ * one partition at a time, so that only a fraction of their usual working memory is needed at once.
+ *
+ * As the input table already resides in memory, we do not spill the rows themselves but only their RowIDs. What we
+ * save memory on are the operators' own data structures (hash tables, materialized values, aggregate results), which
+ * are usually several times larger than the RowIDs.
+ *
+ * Rows with equal keys always end up in the same partition, also across tables and across key columns of different
+ * numeric types (e.g., an int and a double column that are joined). NULLs are treated as a regular key.
+ */
+class GracePartitioning : private Noncopyable {
+ public:
+  GracePartitioning(const std::shared_ptr<const Table>& table, const std::vector<ColumnID>& key_column_ids,
+                    const size_t partition_count);
+
+  // Removes the spill files
+  ~GracePartitioning();
+
+  size_t partition_count() const;
+  size_t partition_row_count(const size_t partition_id) const;
+
+  // Loads the partition from disk. Returns a reference table with the same columns as the partitioned table that
+  // directly references the underlying data tables (i.e., no reference segments pointing to reference segments).
+  std::shared_ptr<const Table> load_partition(const size_t partition_id) const;
+
+  // Number of partitions needed so that each partition of an operator with @param estimated_bytes of working memory
+  // fits into @param available_bytes. Always at least two, as we would not need to partition otherwise.
+  static size_t partition_count_for(const size_t estimated_bytes, const size_t available_bytes);
+
+  // Upper bound for partition_count_for(). Beyond that, the overhead of the spill files dominates.
+  static constexpr auto MAX_PARTITION_COUNT = size_t{1'024};
+
+ private:
+  void _partition(const std::vector<ColumnID>& key_column_ids);
+
+  std::filesystem::path _partition_path(const size_t partition_id) const;
+
+  const std::shared_ptr<const Table> _table;
+  std::filesystem::path _spill_directory;
+  std::vector<size_t> _partition_row_counts;
+};
+
+}  // namespace opossum
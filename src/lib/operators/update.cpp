@@ -1,5 +1,8 @@
 #include "update.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
@@ -9,16 +12,40 @@
 #include "delete.hpp"
 #include "hyrise.hpp"
 #include "insert.hpp"
+#include "resolve_type.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
+#include "storage/mvcc_data.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
 #include "table_wrapper.hpp"
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Calls @param functor with the index of each row of @param table (counted across its chunks) and its position
+template <typename T, typename Functor>
+void iterate_column(const Table& table, const ColumnID column_id, const Functor& functor) {
+  auto row_index = size_t{0};
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    segment_iterate<T>(*table.get_chunk(chunk_id)->get_segment(column_id),
+                       [&](const auto& position) { functor(row_index++, position); });
+  }
+}
+
+}  // namespace
+
 namespace opossum {
 
 Update::Update(const std::string& table_to_update_name, const std::shared_ptr<AbstractOperator>& fields_to_update_op,
-               const std::shared_ptr<AbstractOperator>& update_values_op)
+               const std::shared_ptr<AbstractOperator>& update_values_op,
+               const std::optional<UpdateMode>& update_mode)
     : AbstractReadWriteOperator(OperatorType::Update, fields_to_update_op, update_values_op),
-      _table_to_update_name{table_to_update_name} {}
+      _table_to_update_name{table_to_update_name},
+      _update_mode{update_mode} {}
 
 const std::string& Update::name() const {
   static const auto name = std::string{"Update"};
@@ -35,10 +62,152 @@ std::shared_ptr<const Table> Update::_on_execute(std::shared_ptr<TransactionCont
   DebugAssert(input_table_left()->column_data_types() == input_table_right()->column_data_types(),
               "Update required identical layouts from its input tables");
 
-  // 1. Delete obsolete data with the Delete operator.
+  auto fields_to_update_op = std::shared_ptr<const AbstractOperator>{_input_left};
+  auto update_values_op = std::shared_ptr<const AbstractOperator>{_input_right};
+
+  // 1. In place mode: Update the rows that allow it in place. Only the remaining rows are deleted and re-inserted.
+  const auto update_mode = _update_mode.value_or(table_to_update->update_mode());
+  if (update_mode == UpdateMode::InPlace && input_table_left()->row_count() > 0) {
+    Assert(input_table_left()->column_count() == table_to_update->column_count(),
+           "Update in place expects all columns of the table to update");
+
+    _in_place_updatable_columns = std::vector<bool>(table_to_update->column_count(), true);
+    for (const auto& table_hash_index : table_to_update->table_hash_indexes()) {
+      for (const auto column_id : table_hash_index->column_ids()) _in_place_updatable_columns[column_id] = false;
+    }
+    for (const auto& index_statistics : table_to_update->indexes_statistics()) {
+      for (const auto column_id : index_statistics.column_ids) _in_place_updatable_columns[column_id] = false;
+    }
+    for (const auto& constraint : table_to_update->get_soft_unique_constraints()) {
+      if (constraint.is_enforced == IsEnforced::No) continue;
+      for (const auto column_id : constraint.columns) _in_place_updatable_columns[column_id] = false;
+    }
+
+    const auto lowest_active_snapshot_commit_id =
+        Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
+
+    const auto& left_table = input_table_left();
+    const auto& right_table = input_table_right();
+    const auto column_count = left_table->column_count();
+    const auto row_count = left_table->row_count();
+
+    // Compare the old and the new values column by column. Rows of both inputs are matched by their position, as the
+    // chunks of both inputs might differ.
+    auto modified_values = std::vector<RowVersionStore::ColumnValues>(row_count);
+    auto updatable_in_place = std::vector<bool>(row_count, true);
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      resolve_data_type(left_table->column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+
+        auto old_values = std::vector<ColumnDataType>(row_count);
+        auto old_values_are_null = std::vector<bool>(row_count);
+        iterate_column<ColumnDataType>(*left_table, column_id, [&](const auto row_index, const auto& position) {
+          old_values_are_null[row_index] = position.is_null();
+          if (!position.is_null()) old_values[row_index] = position.value();
+        });
+
+        iterate_column<ColumnDataType>(*right_table, column_id, [&](const auto row_index, const auto& position) {
+          if (position.is_null() == old_values_are_null[row_index] &&
+              (position.is_null() || position.value() == old_values[row_index])) {
+            return;
+          }
+
+          updatable_in_place[row_index] = updatable_in_place[row_index] && _in_place_updatable_columns[column_id];
+          modified_values[row_index].emplace_back(
+              column_id, position.is_null() ? NULL_VALUE : AllTypeVariant{position.value()});
+        });
+      });
+    }
+
+    auto remaining_rows_table = std::make_shared<Table>(left_table->column_definitions(), TableType::References);
+    auto remaining_row_indices = std::vector<size_t>{};
+
+    auto row_index = size_t{0};
+    const auto left_chunk_count = left_table->chunk_count();
+    for (auto left_chunk_id = ChunkID{0}; left_chunk_id < left_chunk_count; ++left_chunk_id) {
+      const auto left_chunk = left_table->get_chunk(left_chunk_id);
+      const auto first_segment = std::static_pointer_cast<const ReferenceSegment>(left_chunk->get_segment(ColumnID{0}));
+      const auto& pos_list = *first_segment->pos_list();
+      const auto& referenced_table = first_segment->referenced_table();
+
+      auto remaining_pos_list = std::make_shared<RowIDPosList>();
+
+      for (auto left_chunk_offset = ChunkOffset{0}; left_chunk_offset < pos_list.size();
+           ++left_chunk_offset, ++row_index) {
+        const auto row_id = pos_list[left_chunk_offset];
+        if (updatable_in_place[row_index]) {
+          const auto mvcc_data = referenced_table->get_chunk(row_id.chunk_id)->mvcc_data();
+          const auto result = _try_update_in_place(mvcc_data, row_id.chunk_offset, modified_values[row_index],
+                                                   *context, lowest_active_snapshot_commit_id);
+          if (result == InPlaceUpdateResult::Conflict) {
+            _mark_as_failed();
+            return nullptr;
+          }
+          if (result == InPlaceUpdateResult::Updated) continue;
+        }
+
+        remaining_pos_list->emplace_back(row_id);
+        remaining_row_indices.emplace_back(row_index);
+      }
+
+      if (remaining_pos_list->empty()) continue;
+
+      auto segments = Segments{};
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        const auto reference_segment =
+            std::static_pointer_cast<const ReferenceSegment>(left_chunk->get_segment(column_id));
+        segments.emplace_back(std::make_shared<ReferenceSegment>(
+            reference_segment->referenced_table(), reference_segment->referenced_column_id(), remaining_pos_list));
+      }
+      remaining_rows_table->append_chunk(segments);
+    }
+
+    if (remaining_row_indices.empty()) return nullptr;
+
+    // Gather the new values of the remaining rows column by column
+    auto remaining_values_segments = Segments{};
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      resolve_data_type(right_table->column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+
+        const auto remaining_row_count = remaining_row_indices.size();
+        auto values = pmr_vector<ColumnDataType>(remaining_row_count);
+        auto null_values = pmr_vector<bool>(remaining_row_count);
+        auto remaining_row_iter = remaining_row_indices.cbegin();
+        iterate_column<ColumnDataType>(*right_table, column_id, [&](const auto row_index, const auto& position) {
+          if (remaining_row_iter == remaining_row_indices.cend() || *remaining_row_iter != row_index) return;
+
+          const auto value_index = std::distance(remaining_row_indices.cbegin(), remaining_row_iter);
+          null_values[value_index] = position.is_null();
+          if (!position.is_null()) values[value_index] = position.value();
+          ++remaining_row_iter;
+        });
+
+        if (right_table->column_is_nullable(column_id)) {
+          remaining_values_segments.emplace_back(
+              std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values)));
+        } else {
+          remaining_values_segments.emplace_back(std::make_shared<ValueSegment<ColumnDataType>>(std::move(values)));
+        }
+      });
+    }
+
+    auto remaining_values_table = std::make_shared<Table>(right_table->column_definitions(), TableType::Data);
+    remaining_values_table->append_chunk(remaining_values_segments);
+
+    auto remaining_rows_op = std::make_shared<TableWrapper>(remaining_rows_table);
+    remaining_rows_op->execute();
+    fields_to_update_op = remaining_rows_op;
+
+    auto remaining_values_op = std::make_shared<TableWrapper>(remaining_values_table);
+    remaining_values_op->execute();
+    update_values_op = remaining_values_op;
+  }
+
+  // 2. Delete obsolete data with the Delete operator.
   //    Delete doesn't accept empty input data
-  if (input_table_left()->row_count() > 0) {
-    _delete = std::make_shared<Delete>(_input_left);
+  if (fields_to_update_op->get_output()->row_count() > 0) {
+    _delete = std::make_shared<Delete>(fields_to_update_op);
     _delete->set_transaction_context(context);
     _delete->execute();
 
@@ -48,11 +217,15 @@ std::shared_ptr<const Table> Update::_on_execute(std::shared_ptr<TransactionCont
     }
   }
 
-  // 2. Insert new data with the Insert operator.
-  _insert = std::make_shared<Insert>(_table_to_update_name, _input_right);
+  // 3. Insert new data with the Insert operator.
+  _insert = std::make_shared<Insert>(_table_to_update_name, update_values_op);
   _insert->set_transaction_context(context);
   _insert->execute();
-  // Insert cannot fail in the MVCC sense, no check necessary
+
+  // Insert fails if the new values violate a unique constraint
+  if (_insert->execute_failed()) {
+    _mark_as_failed();
+  }
 
   return nullptr;
 }
@@ -60,9 +233,58 @@ std::shared_ptr<const Table> Update::_on_execute(std::shared_ptr<TransactionCont
 std::shared_ptr<AbstractOperator> Update::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<Update>(_table_to_update_name, copied_input_left, copied_input_right);
+  return std::make_shared<Update>(_table_to_update_name, copied_input_left, copied_input_right, _update_mode);
 }
 
 void Update::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
+void Update::_on_commit_records(const CommitID cid) {
+  for (const auto& [mvcc_data, chunk_offset] : _in_place_updated_rows) {
+    mvcc_data->row_versions()->commit_version(chunk_offset, transaction_context()->transaction_id(), cid);
+  }
+}
+
+void Update::_on_rollback_records() {
+  for (const auto& [mvcc_data, chunk_offset] : _in_place_updated_rows) {
+    mvcc_data->row_versions()->remove_version(chunk_offset, transaction_context()->transaction_id());
+  }
+}
+
+Update::InPlaceUpdateResult Update::_try_update_in_place(
+    const std::shared_ptr<MvccData>& mvcc_data, const ChunkOffset chunk_offset,
+    const RowVersionStore::ColumnValues& modified_values, const TransactionContext& context,
+    const std::optional<CommitID> lowest_active_snapshot_commit_id) {
+  // The segments of finalized chunks might be encoded and their statistics must remain valid. Rows that the
+  // transaction inserted itself are not visible to others yet and can simply be replaced.
+  if (mvcc_data->is_finalized || mvcc_data->get_begin_cid(chunk_offset) == MvccData::MAX_COMMIT_ID) {
+    return InPlaceUpdateResult::NotApplicable;
+  }
+
+  // Another transaction deleted the row or is about to (rows that the transaction deleted itself are not visible). In
+  // the latter case, we might wait for it to roll back.
+  const auto lock_holder = mvcc_data->get_tid(chunk_offset);
+  if (lock_holder != 0u) {
+    const auto lock_wait_timeout = Hyrise::get().transaction_manager.lock_wait_timeout();
+    if (lock_wait_timeout.count() == 0) return InPlaceUpdateResult::Conflict;
+
+    const auto deadline = std::chrono::steady_clock::now() + lock_wait_timeout;
+    if (!_wait_for_row_lock(*mvcc_data, chunk_offset, lock_holder, deadline)) return InPlaceUpdateResult::Conflict;
+  }
+
+  const auto transaction_id = context.transaction_id();
+  const auto row_versions = mvcc_data->get_or_create_row_versions();
+  if (!row_versions->add_version(chunk_offset, transaction_id, context.snapshot_commit_id(), modified_values,
+                                 lowest_active_snapshot_commit_id)) {
+    return InPlaceUpdateResult::Conflict;
+  }
+  _in_place_updated_rows.emplace_back(InPlaceUpdatedRow{mvcc_data, chunk_offset});
+
+  // Check again after adding the version, which pairs with the fence in Delete. A chunk that was finalized in the
+  // meantime aborts the transaction as well, as its statistics might not reflect the new version.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (mvcc_data->get_tid(chunk_offset) != 0u || mvcc_data->is_finalized) return InPlaceUpdateResult::Conflict;
+
+  return InPlaceUpdateResult::Updated;
+}
+
 }  // namespace opossum
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "abstract_read_write_operator.hpp"
+#include "storage/row_version_store.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
 class Delete;
 class Insert;
+class MvccData;
 
 /**
  * Operator that updates a subset of columns of a number of rows and from one table with values supplied in another.
@@ -23,11 +26,19 @@ class Insert;
  * Assumption: The input has been validated before.
  *
  * Note: Update does not support null values at the moment
+ *
+ * With UpdateMode::InPlace, rows of mutable chunks are not invalidated and re-inserted. Instead, the values of the
+ * modified columns are stored as a new version of the row in the chunk's RowVersionStore. Rows that cannot be updated
+ * in place (e.g., rows of finalized chunks, rows inserted by the same transaction, or changes to columns that are
+ * indexed or part of an enforced unique constraint) fall back to Delete and Insert. Unless an UpdateMode is passed to
+ * the constructor, the mode of the table to update is used at the time the operator is executed, so that cached and
+ * prepared plans follow Table::set_update_mode().
  */
 class Update : public AbstractReadWriteOperator {
  public:
   explicit Update(const std::string& table_to_update_name, const std::shared_ptr<AbstractOperator>& fields_to_update_op,
-                  const std::shared_ptr<AbstractOperator>& update_values_op);
+                  const std::shared_ptr<AbstractOperator>& update_values_op,
+                  const std::optional<UpdateMode>& update_mode = std::nullopt);
 
   const std::string& name() const override;
 
@@ -38,15 +49,32 @@ class Update : public AbstractReadWriteOperator {
       const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
-  // Commit happens in Insert and Delete operators
-  void _on_commit_records(const CommitID cid) override {}
+  // Commit and rollback of rows that were not updated in place happen in Insert and Delete operators
+  void _on_commit_records(const CommitID cid) override;
+  void _on_rollback_records() override;
+
+  enum class InPlaceUpdateResult { Updated, NotApplicable, Conflict };
 
-  // Rollback happens in Insert and Delete operators
-  void _on_rollback_records() override {}
+  // Adds a version with the modified values to the row. Rows that cannot be updated in place are deleted and
+  // re-inserted instead.
+  InPlaceUpdateResult _try_update_in_place(const std::shared_ptr<MvccData>& mvcc_data, const ChunkOffset chunk_offset,
+                                           const RowVersionStore::ColumnValues& modified_values,
+                                           const TransactionContext& context,
+                                           const std::optional<CommitID> lowest_active_snapshot_commit_id);
 
  protected:
   const std::string _table_to_update_name;
+  const std::optional<UpdateMode> _update_mode;
   std::shared_ptr<Delete> _delete;
   std::shared_ptr<Insert> _insert;
+
+  // Columns that can be modified without updating an index or checking a unique constraint
+  std::vector<bool> _in_place_updatable_columns;
+
+  struct InPlaceUpdatedRow {
+    std::shared_ptr<MvccData> mvcc_data;
+    ChunkOffset chunk_offset;
+  };
+  std::vector<InPlaceUpdatedRow> _in_place_updated_rows;
 };
 }  // namespace opossum
@@ -19,9 +19,13 @@ namespace {
 
 bool is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id, ChunkOffset chunk_offset,
                     const MvccData& mvcc_data) {
-  const auto row_tid = mvcc_data.get_tid(chunk_offset);
   const auto begin_cid = mvcc_data.get_begin_cid(chunk_offset);
   const auto end_cid = mvcc_data.get_end_cid(chunk_offset);
+
+  // Read-only transactions do not lock rows, so there is no need to look at the TIDs
+  if (our_tid == INVALID_TRANSACTION_ID) return snapshot_commit_id >= begin_cid && snapshot_commit_id < end_cid;
+
+  const auto row_tid = mvcc_data.get_tid(chunk_offset);
   return Validate::is_row_visible(our_tid, snapshot_commit_id, row_tid, begin_cid, end_cid);
 }
 
@@ -34,19 +38,25 @@ bool Validate::is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id
   // auto past_insert = (our_tid != row_tid) && (snapshot_commit_id >= begin_cid) && !(snapshot_commit_id >= end_cid);
   // return own_insert || past_insert;
 
+  // Read-only transactions have no transaction id. As they cannot have locked any rows, unlocked rows (i.e., rows with
+  // INVALID_TRANSACTION_ID) must not be treated as their own.
+  if (our_tid == INVALID_TRANSACTION_ID) return snapshot_commit_id >= begin_cid && snapshot_commit_id < end_cid;
+
   // since gcc and clang are surprisingly bad at optimizing the above boolean expression, lets do that ourselves
   return snapshot_commit_id < end_cid && ((snapshot_commit_id >= begin_cid) != (row_tid == our_tid));
 }
 
 bool Validate::_is_entire_chunk_visible(const std::shared_ptr<const Chunk>& chunk,
                                         const CommitID snapshot_commit_id) const {
-  Assert(
-      _can_use_chunk_shortcut,
-      "This call to _is_entire_chunk_visible is not allowed. Are there any DeleteOperators in the same transaction?");
   DebugAssert(!std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0})),
               "_is_entire_chunk_visible cannot be called on reference chunks.");
 
   const auto& mvcc_data = chunk->mvcc_data();
+
+  // Compacted MVCC data that nobody wrote to holds no in-flight deletes, not even of the current transaction
+  if (mvcc_data->is_compacted_and_entirely_valid()) return snapshot_commit_id >= *mvcc_data->max_begin_cid;
+  if (!_can_use_chunk_shortcut) return false;
+
   const auto max_begin_cid = mvcc_data->max_begin_cid;
   if (!max_begin_cid) return false;
 
@@ -99,6 +109,8 @@ std::shared_ptr<const Table> Validate::_on_execute(std::shared_ptr<TransactionCo
   //     (the max_begin_cid is stored in the chunk, not determined by the ValidateOperator),
   // (4) no rows in the chunk have been invalidated before this transaction was started,
   // (5) the current transaction has no in-flight deletes.
+  // Chunks with compacted MVCC data that no transaction has written to since the compaction fulfill all of these.
+  // Read-only transactions never have in-flight deletes, so (5) holds without looking at the read-write operators.
   const auto& read_write_operators = transaction_context->read_write_operators();
   for (const auto& read_write_operator : read_write_operators) {
     if (read_write_operator->type() == OperatorType::Delete) {
@@ -169,7 +181,7 @@ void Validate::_validate_chunks(const std::shared_ptr<const Table>& in_table, co
         const auto referenced_chunk = referenced_table->get_chunk(pos_list_in->common_chunk_id());
         auto mvcc_data = referenced_chunk->mvcc_data();
 
-        if (_can_use_chunk_shortcut && _is_entire_chunk_visible(referenced_chunk, snapshot_commit_id)) {
+        if (_is_entire_chunk_visible(referenced_chunk, snapshot_commit_id)) {
           // We can reuse the old PosList since it is entirely visible.
           pos_list_out = pos_list_in;
         } else {
@@ -211,7 +223,7 @@ void Validate::_validate_chunks(const std::shared_ptr<const Table>& in_table, co
 
       DebugAssert(chunk_in->has_mvcc_data(), "Trying to use Validate on a table that has no MVCC data");
 
-      if (_can_use_chunk_shortcut && _is_entire_chunk_visible(chunk_in, snapshot_commit_id)) {
+      if (_is_entire_chunk_visible(chunk_in, snapshot_commit_id)) {
         pos_list_out = std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size());
       } else {
         const auto mvcc_data = chunk_in->mvcc_data();
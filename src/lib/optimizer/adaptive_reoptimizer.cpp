@@ -0,0 +1,228 @@
+#include "adaptive_reoptimizer.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/logical_plan_root_node.hpp"
+#include "logical_query_plan/lqp_translator.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/static_table_node.hpp"
+#include "operators/abstract_operator.hpp"
+#include "optimizer/optimizer.hpp"
+#include "optimizer/strategy/group_join_rule.hpp"
+#include "optimizer/strategy/join_ordering_rule.hpp"
+#include "optimizer/strategy/join_predicate_ordering_rule.hpp"
+#include "optimizer/strategy/predicate_placement_rule.hpp"
+#include "optimizer/strategy/predicate_reordering_rule.hpp"
+#include "statistics/base_attribute_statistics.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "statistics/cardinality_feedback.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/settings/integral_setting.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+bool is_checkpoint(const AbstractLQPNode& node) {
+  if (node.type == LQPNodeType::Aggregate) return true;
+  if (node.type != LQPNodeType::Join) return false;
+
+  // A join that is executed together with the aggregate on top of it (see GroupJoinRule) is not materialized
+  const auto outputs = node.outputs();
+  return outputs.size() != 1 || outputs[0]->type != LQPNodeType::Aggregate ||
+         !static_cast<const AggregateNode&>(*outputs[0]).is_group_join;
+}
+
+// Checkpoints of @param lqp in top-down order. Each node is only visited once, so that the last checkpoint has no other
+// checkpoint below it.
+std::vector<std::shared_ptr<AbstractLQPNode>> find_checkpoints(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  auto checkpoints = std::vector<std::shared_ptr<AbstractLQPNode>>{};
+  visit_lqp(lqp, [&](const auto& node) {
+    if (is_checkpoint(*node)) checkpoints.emplace_back(node);
+    return LQPVisitation::VisitInputs;
+  });
+  return checkpoints;
+}
+
+/**
+ * Replaces @param node by a StaticTableNode holding its output @param table. The nodes above @param node refer to the
+ * columns of @param node, which are now provided by the StaticTableNode.
+ */
+void replace_with_static_table(const std::shared_ptr<AbstractLQPNode>& node, const std::shared_ptr<Table>& table) {
+  const auto static_table_node = StaticTableNode::make(table);
+
+  const auto column_expressions = node->column_expressions();
+  const auto static_column_expressions = static_table_node->column_expressions();
+  DebugAssert(column_expressions.size() == static_column_expressions.size(), "Output does not match the node");
+
+  auto replacements = ExpressionUnorderedMap<std::shared_ptr<AbstractExpression>>{};
+  for (auto column_id = ColumnID{0}; column_id < column_expressions.size(); ++column_id) {
+    replacements.emplace(column_expressions[column_id], static_column_expressions[column_id]);
+  }
+
+  visit_lqp_upwards(node, [&](const auto& upper_node) {
+    if (upper_node != node) {
+      for (auto& expression : upper_node->node_expressions) {
+        expression_deep_replace(expression, replacements);
+      }
+    }
+    return LQPUpwardVisitation::VisitOutputs;
+  });
+
+  const auto outputs = node->outputs();
+  const auto input_sides = node->get_input_sides();
+  for (auto output_idx = size_t{0}; output_idx < outputs.size(); ++output_idx) {
+    outputs[output_idx]->set_input(input_sides[output_idx], static_table_node);
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::optional<double> AdaptiveReoptimizer::q_error_threshold_from_settings() {
+  const auto& settings_manager = Hyrise::get().settings_manager;
+  if (!settings_manager.has_setting(SETTING_NAME)) return std::nullopt;
+
+  const auto setting = std::dynamic_pointer_cast<IntegralSetting>(settings_manager.get_setting(SETTING_NAME));
+  Assert(setting, std::string{SETTING_NAME} + " is expected to be an IntegralSetting");
+
+  const auto threshold = setting->value();
+  if (threshold <= 0) return std::nullopt;
+
+  return static_cast<double>(threshold);
+}
+
+bool AdaptiveReoptimizer::is_applicable(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  auto applicable = true;
+  auto checkpoint_count = size_t{0};
+
+  visit_lqp(lqp, [&](const auto& node) {
+    switch (node->type) {
+      case LQPNodeType::Aggregate:
+      case LQPNodeType::Alias:
+      case LQPNodeType::Join:
+      case LQPNodeType::Limit:
+      case LQPNodeType::Predicate:
+      case LQPNodeType::Projection:
+      case LQPNodeType::Sort:
+      case LQPNodeType::StaticTable:
+      case LQPNodeType::StoredTable:
+      case LQPNodeType::Union:
+      case LQPNodeType::Validate:
+        break;
+
+      default:
+        applicable = false;
+    }
+
+    if (is_checkpoint(*node)) ++checkpoint_count;
+
+    // The expressions of the nodes above a checkpoint are rewritten to refer to the checkpoint's output. Subqueries
+    // would have to be rewritten as well.
+    for (const auto& expression : node->node_expressions) {
+      visit_expression(expression, [&](const auto& sub_expression) {
+        if (sub_expression->type == ExpressionType::LQPSubquery ||
+            sub_expression->type == ExpressionType::Placeholder ||
+            sub_expression->type == ExpressionType::CorrelatedParameter) {
+          applicable = false;
+        }
+        return applicable ? ExpressionVisitation::VisitArguments : ExpressionVisitation::DoNotVisitArguments;
+      });
+    }
+
+    return applicable ? LQPVisitation::VisitInputs : LQPVisitation::DoNotVisitInputs;
+  });
+
+  return applicable && checkpoint_count >= 2;
+}
+
+AdaptiveReoptimizer::AdaptiveReoptimizer(const double q_error_threshold, const ExecuteFunction& execute)
+    : _q_error_threshold(q_error_threshold), _execute(execute), _optimizer(std::make_shared<Optimizer>()) {
+  _optimizer->add_rule(std::make_unique<JoinOrderingRule>());
+  _optimizer->add_rule(std::make_unique<PredicatePlacementRule>());
+  _optimizer->add_rule(std::make_unique<JoinPredicateOrderingRule>());
+  _optimizer->add_rule(std::make_unique<PredicateReorderingRule>());
+  // The JoinOrderingRule might have changed the joins below aggregates that were executed as a GroupJoin
+  _optimizer->add_rule(std::make_unique<GroupJoinRule>());
+}
+
+std::shared_ptr<AbstractLQPNode> AdaptiveReoptimizer::execute_checkpoints(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  const auto root_node = LogicalPlanRootNode::make(lqp->deep_copy());
+
+  // The CardinalityFeedback is keyed by the LQPs as they were before the execution started, as later executions of the
+  // same query will not contain the StaticTableNodes. Once the LQP was re-optimized, its nodes do not correspond to the
+  // original ones anymore.
+  const auto original_lqp = lqp->deep_copy();
+  auto original_nodes = lqp_create_node_mapping(root_node->left_input(), original_lqp);
+
+  while (true) {
+    auto is_miss = false;
+
+    {
+      const auto checkpoints = find_checkpoints(root_node->left_input());
+      if (checkpoints.size() < 2) break;
+
+      const auto& checkpoint = checkpoints.back();
+
+      const auto estimated_statistics = CardinalityEstimator{}.estimate_statistics(checkpoint);
+
+      const auto pqp = LQPTranslator{}.translate_node(checkpoint);
+      _execute(pqp);
+
+      // The output is not referenced by anyone else and can thus be given statistics
+      const auto output_table = std::const_pointer_cast<Table>(pqp->get_output());
+      Assert(output_table, "Checkpoint did not produce an output");
+      const auto actual_row_count = static_cast<Cardinality>(output_table->row_count());
+
+      const auto clamped_estimate = std::max(estimated_statistics->row_count, 1.0f);
+      const auto clamped_actual = std::max(actual_row_count, 1.0f);
+      const auto q_error = std::max(clamped_estimate / clamped_actual, clamped_actual / clamped_estimate);
+      is_miss = q_error > _q_error_threshold;
+
+      if (is_miss) {
+        const auto original_node_iter = original_nodes.find(checkpoint);
+        if (original_node_iter != original_nodes.end()) {
+          Hyrise::get().cardinality_feedback->record(original_node_iter->second, actual_row_count);
+        }
+      }
+
+      // Keep the estimated value distributions, but correct the row count
+      const auto selectivity =
+          estimated_statistics->row_count > 0 ? actual_row_count / estimated_statistics->row_count : 0.0f;
+      auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>{};
+      column_statistics.reserve(estimated_statistics->column_statistics.size());
+      for (const auto& estimated_column_statistics : estimated_statistics->column_statistics) {
+        column_statistics.emplace_back(estimated_column_statistics->scaled(selectivity));
+      }
+      output_table->set_table_statistics(
+          std::make_shared<TableStatistics>(std::move(column_statistics), actual_row_count));
+
+      replace_with_static_table(checkpoint, output_table);
+    }
+
+    if (!is_miss) continue;
+
+    // The Optimizer requires exclusive ownership of the LQP
+    original_nodes.clear();
+    auto remaining_lqp = root_node->left_input();
+    root_node->set_left_input(nullptr);
+    root_node->set_left_input(_optimizer->optimize(std::move(remaining_lqp)));
+    ++_reoptimization_count;
+  }
+
+  const auto remaining_lqp = root_node->left_input();
+  root_node->set_left_input(nullptr);
+  return remaining_lqp;
+}
+
+size_t AdaptiveReoptimizer::reoptimization_count() const { return _reoptimization_count; }
+
+}  // namespace opossum
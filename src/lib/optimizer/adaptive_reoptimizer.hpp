@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace opossum {
+
+class AbstractLQPNode;
+class AbstractOperator;
+class Optimizer;
+
+/**
+ * Once translated, a PQP runs to completion, even if an early join produces orders of magnitude more rows than
+ * estimated and the remaining joins are thus executed in a bad order. The AdaptiveReoptimizer executes an optimized LQP
+ * in stages instead. Each stage ends at a checkpoint, i.e., a join or an aggregate, which materializes its output
+ * anyway. Once a checkpoint is executed, it is replaced by a StaticTableNode holding its output, whose statistics have
+ * the actual row count. If the actual row count differs from the estimated one by more than the q-error threshold
+ * (max(estimate / actual, actual / estimate)), the remaining LQP is re-optimized.
+ *
+ * The observed row counts of checkpoints that were estimated badly are stored in the CardinalityFeedback, so that the
+ * next optimization of the same query starts from the corrected estimates.
+ *
+ * The threshold is configured with the IntegralSetting SETTING_NAME (0 disables the adaptive re-optimization). The
+ * SQLPipelineStatement uses the AdaptiveReoptimizer for read-only statements (see is_applicable()).
+ */
+class AdaptiveReoptimizer {
+ public:
+  static constexpr auto SETTING_NAME = "AdaptiveReoptimization.q_error_threshold";
+
+  // Returns std::nullopt if the adaptive re-optimization is disabled
+  static std::optional<double> q_error_threshold_from_settings();
+
+  // Returns true if @param lqp contains at least two checkpoints, only consists of read-only nodes, and does not
+  // contain subqueries or parameters.
+  static bool is_applicable(const std::shared_ptr<AbstractLQPNode>& lqp);
+
+  // @param execute executes a PQP and waits for it to finish, e.g., after setting the transaction context
+  using ExecuteFunction = std::function<void(const std::shared_ptr<AbstractOperator>&)>;
+
+  AdaptiveReoptimizer(const double q_error_threshold, const ExecuteFunction& execute);
+
+  /**
+   * Executes all checkpoints of @param lqp except for the top-most one, as there would be nothing left to re-optimize.
+   * Returns the remaining LQP, in which the executed checkpoints are replaced by StaticTableNodes. @param lqp itself is
+   * not modified.
+   */
+  std::shared_ptr<AbstractLQPNode> execute_checkpoints(const std::shared_ptr<AbstractLQPNode>& lqp);
+
+  // Number of times the remaining LQP was re-optimized by execute_checkpoints()
+  size_t reoptimization_count() const;
+
+ private:
+  const double _q_error_threshold;
+  const ExecuteFunction _execute;
+
+  // Re-orders the joins of the remaining LQP and places the predicates accordingly
+  const std::shared_ptr<Optimizer> _optimizer;
+
+  size_t _reoptimization_count{0};
+};
+
+}  // namespace opossum
@@ -11,7 +11,9 @@
 #include "strategy/chunk_pruning_rule.hpp"
 #include "strategy/column_pruning_rule.hpp"
 #include "strategy/dependent_group_by_reduction_rule.hpp"
+#include "strategy/eager_aggregation_rule.hpp"
 #include "strategy/expression_reduction_rule.hpp"
+#include "strategy/group_join_rule.hpp"
 #include "strategy/in_expression_rewrite_rule.hpp"
 #include "strategy/index_scan_rule.hpp"
 #include "strategy/join_ordering_rule.hpp"
@@ -89,8 +91,10 @@ void collect_subquery_expressions_by_lqp(SubqueryExpressionsByLQP& subquery_expr
 
 namespace opossum {
 
-std::shared_ptr<Optimizer> Optimizer::create_default_optimizer() {
-  const auto optimizer = std::make_shared<Optimizer>();
+std::shared_ptr<Optimizer> Optimizer::create_default_optimizer(
+    const std::optional<JoinSamplingConfig>& join_sampling_config) {
+  const auto optimizer = std::make_shared<Optimizer>(
+      std::make_shared<CostEstimatorLogical>(std::make_shared<CardinalityEstimator>(join_sampling_config)));
 
   optimizer->add_rule(std::make_unique<DependentGroupByReductionRule>());
 
@@ -126,6 +130,10 @@ std::shared_ptr<Optimizer> Optimizer::create_default_optimizer() {
 
   optimizer->add_rule(std::make_unique<JoinPredicateOrderingRule>());
 
+  // Pre-aggregate join inputs once the joins are in their final order and the predicates have been placed, so that
+  // the cost estimation of the rewritten plan is based on the filtered inputs
+  optimizer->add_rule(std::make_unique<EagerAggregationRule>());
+
   // Prune chunks after the BetweenCompositionRule ran, as `a >= 5 AND a <= 7` may not be prunable predicates while
   // `a BETWEEN 5 and 7` is. Also, run it after the PredicatePlacementRule, so that predicates are as close to the
   // StoredTableNode as possible where the ChunkPruningRule can work with them.
@@ -142,6 +150,9 @@ std::shared_ptr<Optimizer> Optimizer::create_default_optimizer() {
 
   optimizer->add_rule(std::make_unique<IndexScanRule>());
 
+  // Run after the IndexScanRule, as joins that probe a table hash index are not executed as a GroupJoin
+  optimizer->add_rule(std::make_unique<GroupJoinRule>());
+
   optimizer->add_rule(std::make_unique<PredicateMergeRule>());
 
   return optimizer;
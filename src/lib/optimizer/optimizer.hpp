@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "cost_estimation/cost_estimator_logical.hpp"
@@ -18,11 +19,13 @@ class AbstractLQPNode;
  * On each invocation of optimize(), these Batches are applied in the same order as they were added
  * to the Optimizer.
  *
- * Optimizer::create_default_optimizer() creates the Optimizer with the default rule set.
+ * Optimizer::create_default_optimizer() creates the Optimizer with the default rule set. If @param join_sampling_config
+ * is set, its CardinalityEstimator samples the joins of large join graphs (see JoinSamplingConfig).
  */
 class Optimizer final {
  public:
-  static std::shared_ptr<Optimizer> create_default_optimizer();
+  static std::shared_ptr<Optimizer> create_default_optimizer(
+      const std::optional<JoinSamplingConfig>& join_sampling_config = std::nullopt);
 
   explicit Optimizer(const std::shared_ptr<AbstractCostEstimator>& cost_estimator =
                          std::make_shared<CostEstimatorLogical>(std::make_shared<CardinalityEstimator>()));
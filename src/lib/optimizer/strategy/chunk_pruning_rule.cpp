@@ -6,15 +6,15 @@
 #include "all_parameter_variant.hpp"
 #include "constant_mappings.hpp"
 #include "expression/expression_utils.hpp"
+#include "expression/in_expression.hpp"
+#include "expression/list_expression.hpp"
+#include "expression/value_expression.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "logical_query_plan/predicate_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
 #include "lossless_cast.hpp"
-#include "resolve_type.hpp"
 #include "statistics/attribute_statistics.hpp"
-#include "statistics/statistics_objects/min_max_filter.hpp"
-#include "statistics/statistics_objects/range_filter.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
@@ -81,6 +81,13 @@ void ChunkPruningRule::apply_to(const std::shared_ptr<AbstractLQPNode>& node) co
 
 std::set<ChunkID> ChunkPruningRule::_compute_exclude_list(const Table& table, const AbstractExpression& predicate,
                                                           const std::shared_ptr<StoredTableNode>& stored_table_node) {
+  if (predicate.type == ExpressionType::Predicate) {
+    const auto& predicate_expression = static_cast<const AbstractPredicateExpression&>(predicate);
+    if (predicate_expression.predicate_condition == PredicateCondition::In) {
+      return _compute_exclude_list_for_in(table, static_cast<const InExpression&>(predicate), stored_table_node);
+    }
+  }
+
   // Hacky:
   // `table->table_statistics()` contains AttributeStatistics for all columns, even those that are pruned in
   // `stored_table_node`.
@@ -167,36 +174,83 @@ std::set<ChunkID> ChunkPruningRule::_compute_exclude_list(const Table& table, co
   return result;
 }
 
-bool ChunkPruningRule::_can_prune(const BaseAttributeStatistics& base_segment_statistics,
-                                  const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
-                                  const std::optional<AllTypeVariant>& variant_value2) {
-  auto can_prune = false;
+std::set<ChunkID> ChunkPruningRule::_compute_exclude_list_for_in(
+    const Table& table, const InExpression& in_expression, const std::shared_ptr<StoredTableNode>& stored_table_node) {
+  if (in_expression.set()->type != ExpressionType::List) return {};
 
-  resolve_data_type(base_segment_statistics.data_type, [&](const auto data_type_t) {
-    using ColumnDataType = typename decltype(data_type_t)::type;
+  // See _compute_exclude_list() on why the ColumnID is resolved on a copy of the StoredTableNode without column pruning
+  auto stored_table_node_without_column_pruning =
+      std::static_pointer_cast<StoredTableNode>(stored_table_node->deep_copy());
+  stored_table_node_without_column_pruning->set_pruned_column_ids({});
+  const auto column_expression = expression_copy_and_adapt_to_different_lqp(
+      *in_expression.value(), {{stored_table_node, stored_table_node_without_column_pruning}});
+  const auto column_id = stored_table_node_without_column_pruning->find_column_id(*column_expression);
+  if (!column_id) return {};
 
-    const auto& segment_statistics = static_cast<const AttributeStatistics<ColumnDataType>&>(base_segment_statistics);
+  const auto column_data_type = column_expression->data_type();
 
-    // Range filters are only available for arithmetic (non-string) types.
-    if constexpr (std::is_arithmetic_v<ColumnDataType>) {  // NOLINT
-      if (segment_statistics.range_filter) {
-        if (segment_statistics.range_filter->does_not_contain(predicate_condition, variant_value, variant_value2)) {
-          can_prune = true;
-        }
-      }
-      // RangeFilters contain all the information stored in a MinMaxFilter. There is no point in having both.
-      DebugAssert(!segment_statistics.min_max_filter,
-                  "Segment should not have a MinMaxFilter and a RangeFilter at the same time");
+  auto values = std::vector<AllTypeVariant>{};
+  for (const auto& element : static_cast<const ListExpression&>(*in_expression.set()).elements()) {
+    if (element->type != ExpressionType::Value) return {};
+
+    // NULL never matches and does not prevent pruning
+    const auto& value = static_cast<const ValueExpression&>(*element).value;
+    if (variant_is_null(value)) continue;
+
+    // As in _compute_exclude_list(), values that cannot be converted losslessly disable pruning
+    const auto column_value = lossless_variant_cast(value, column_data_type);
+    if (!column_value) return {};
+    values.emplace_back(*column_value);
+  }
+
+  std::set<ChunkID> result;
+  auto num_rows_pruned = size_t{0};
+  const auto& already_pruned_chunk_ids = stored_table_node->pruned_chunk_ids();
+
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    const auto pruning_statistics = chunk->pruning_statistics();
+    if (!pruning_statistics) continue;
+
+    const auto& segment_statistics = *(*pruning_statistics)[*column_id];
+    const auto can_prune = std::all_of(values.begin(), values.end(), [&](const auto& value) {
+      return _can_prune(segment_statistics, PredicateCondition::Equals, value, std::nullopt);
+    });
+    if (!can_prune) continue;
+
+    if (std::find(already_pruned_chunk_ids.begin(), already_pruned_chunk_ids.end(), chunk_id) ==
+        already_pruned_chunk_ids.end()) {
+      num_rows_pruned += chunk->size();
     }
+    result.insert(chunk_id);
+  }
 
-    if (segment_statistics.min_max_filter) {
-      if (segment_statistics.min_max_filter->does_not_contain(predicate_condition, variant_value, variant_value2)) {
-        can_prune = true;
-      }
+  if (num_rows_pruned > size_t{0}) {
+    // In contrast to single-value predicates, the statistics of the pruned column cannot be sliced to the remaining
+    // values. All columns are scaled to the reduced table size instead.
+    const auto& old_statistics =
+        stored_table_node->table_statistics ? stored_table_node->table_statistics : table.table_statistics();
+    const auto scale = 1 - (static_cast<float>(num_rows_pruned) / old_statistics->row_count);
+
+    auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>{};
+    column_statistics.reserve(old_statistics->column_statistics.size());
+    for (const auto& old_column_statistics : old_statistics->column_statistics) {
+      column_statistics.emplace_back(old_column_statistics->scaled(scale));
     }
-  });
+    stored_table_node->table_statistics = std::make_shared<TableStatistics>(
+        std::move(column_statistics), old_statistics->row_count - static_cast<float>(num_rows_pruned));
+  }
 
-  return can_prune;
+  return result;
+}
+
+bool ChunkPruningRule::_can_prune(const BaseAttributeStatistics& base_segment_statistics,
+                                  const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+                                  const std::optional<AllTypeVariant>& variant_value2) {
+  return base_segment_statistics.does_not_contain(predicate_condition, variant_value, variant_value2);
 }
 
 bool ChunkPruningRule::_is_non_filtering_node(const AbstractLQPNode& node) {
@@ -15,6 +15,7 @@ namespace opossum {
 class AbstractLQPNode;
 class ChunkStatistics;
 class AbstractExpression;
+class InExpression;
 class StoredTableNode;
 class PredicateNode;
 class Table;
@@ -32,6 +33,10 @@ class ChunkPruningRule : public AbstractRule {
   static std::set<ChunkID> _compute_exclude_list(const Table& table, const AbstractExpression& predicate,
                                                  const std::shared_ptr<StoredTableNode>& stored_table_node);
 
+  // Prunes the chunks that contain none of the values of `column IN (value, ...)`
+  static std::set<ChunkID> _compute_exclude_list_for_in(const Table& table, const InExpression& in_expression,
+                                                        const std::shared_ptr<StoredTableNode>& stored_table_node);
+
   // Check whether any of the statistics objects available for this Segment identify the predicate as prunable
   static bool _can_prune(const BaseAttributeStatistics& base_segment_statistics,
                          const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
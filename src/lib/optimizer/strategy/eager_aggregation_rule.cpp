@@ -0,0 +1,335 @@
+#include "eager_aggregation_rule.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "cost_estimation/abstract_cost_estimator.hpp"
+#include "expression/aggregate_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/expression_utils.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/alias_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/projection_node.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+using namespace opossum::expression_functional;  // NOLINT
+
+// An AggregateNode on top of an inner equi join. The SQLTranslator places a ProjectionNode that computes the aggregate
+// arguments (e.g., `a * b` for SUM(a * b)) in between.
+struct Candidate {
+  std::shared_ptr<AggregateNode> aggregate_node;
+  std::shared_ptr<ProjectionNode> projection_node;
+  std::shared_ptr<JoinNode> join_node;
+};
+
+// The nodes of a (not yet applied) rewrite
+struct EagerAggregation {
+  std::shared_ptr<AbstractLQPNode> pushed_input;
+  std::shared_ptr<ProjectionNode> partial_projection_node;
+  std::shared_ptr<AggregateNode> partial_aggregate_node;
+  std::shared_ptr<AggregateNode> final_aggregate_node;
+  std::shared_ptr<ProjectionNode> final_projection_node;
+
+  // Maps the aggregate expressions of the original AggregateNode to the expressions that replace them
+  ExpressionUnorderedMap<std::shared_ptr<AbstractExpression>> replacements;
+
+  std::shared_ptr<AbstractLQPNode> top_node() const {
+    if (final_projection_node) return final_projection_node;
+    return final_aggregate_node;
+  }
+};
+
+// Adds @param expression to @param expressions unless an equal expression is already contained. Returns the contained
+// expression.
+std::shared_ptr<AbstractExpression> add_unique(std::vector<std::shared_ptr<AbstractExpression>>& expressions,
+                                               const std::shared_ptr<AbstractExpression>& expression) {
+  const auto iter = std::find_if(expressions.begin(), expressions.end(),
+                                 [&](const auto& contained) { return *contained == *expression; });
+  if (iter != expressions.end()) return *iter;
+  expressions.emplace_back(expression);
+  return expression;
+}
+
+std::optional<Candidate> find_candidate(const std::shared_ptr<AbstractLQPNode>& node) {
+  if (node->type != LQPNodeType::Aggregate) return std::nullopt;
+  const auto aggregate_node = std::static_pointer_cast<AggregateNode>(node);
+  if (aggregate_node->aggregate_expressions_begin_idx == 0) return std::nullopt;
+
+  auto projection_node = std::shared_ptr<ProjectionNode>{};
+  auto input_node = aggregate_node->left_input();
+  if (input_node->type == LQPNodeType::Projection && input_node->output_count() == 1) {
+    projection_node = std::static_pointer_cast<ProjectionNode>(input_node);
+    input_node = input_node->left_input();
+  }
+
+  if (input_node->type != LQPNodeType::Join || input_node->output_count() != 1) return std::nullopt;
+  const auto join_node = std::static_pointer_cast<JoinNode>(input_node);
+  if (join_node->join_mode != JoinMode::Inner) return std::nullopt;
+
+  for (const auto& join_predicate : join_node->join_predicates()) {
+    const auto binary_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(join_predicate);
+    if (!binary_predicate || binary_predicate->predicate_condition != PredicateCondition::Equals) return std::nullopt;
+  }
+
+  // The AggregateNode expects its group-by columns to be computed by its input. As the ProjectionNode will be removed,
+  // they have to be join output columns.
+  for (auto expression_idx = size_t{0}; expression_idx < aggregate_node->aggregate_expressions_begin_idx;
+       ++expression_idx) {
+    if (!join_node->find_column_id(*aggregate_node->node_expressions[expression_idx])) return std::nullopt;
+  }
+
+  return Candidate{aggregate_node, projection_node, join_node};
+}
+
+// Builds the partial aggregate for the @param side of the candidate's join and the final aggregate. Returns
+// std::nullopt if the aggregate cannot be split. The nodes are not yet connected with the LQP.
+std::optional<EagerAggregation> plan_eager_aggregation(const Candidate& candidate, const LQPInputSide side) {
+  const auto& aggregate_node = *candidate.aggregate_node;
+  const auto& join_node = *candidate.join_node;
+  const auto pushed_input = join_node.input(side);
+  const auto other_input = join_node.input(side == LQPInputSide::Left ? LQPInputSide::Right : LQPInputSide::Left);
+
+  const auto group_by_expressions = std::vector<std::shared_ptr<AbstractExpression>>(
+      aggregate_node.node_expressions.begin(),
+      aggregate_node.node_expressions.begin() + aggregate_node.aggregate_expressions_begin_idx);
+
+  // The partial aggregate groups by the join keys and all group-by columns of its side
+  auto partial_group_by_expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
+  for (const auto& join_predicate : join_node.join_predicates()) {
+    const auto& binary_predicate = static_cast<const BinaryPredicateExpression&>(*join_predicate);
+    if (pushed_input->find_column_id(*binary_predicate.left_operand())) {
+      add_unique(partial_group_by_expressions, binary_predicate.left_operand());
+    } else if (pushed_input->find_column_id(*binary_predicate.right_operand())) {
+      add_unique(partial_group_by_expressions, binary_predicate.right_operand());
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  for (const auto& group_by_expression : group_by_expressions) {
+    if (pushed_input->find_column_id(*group_by_expression)) {
+      add_unique(partial_group_by_expressions, group_by_expression);
+    } else if (!other_input->find_column_id(*group_by_expression)) {
+      return std::nullopt;
+    }
+  }
+
+  // Split the aggregates. Arguments that are not columns of the pushed input (e.g., `a * b`) are computed by a
+  // ProjectionNode below the partial aggregate.
+  auto partial_aggregate_expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
+  auto final_aggregate_expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
+  auto partial_projection_expressions = pushed_input->column_expressions();
+  auto requires_partial_projection = false;
+  auto requires_final_projection = false;
+
+  auto eager_aggregation = EagerAggregation{};
+  eager_aggregation.pushed_input = pushed_input;
+
+  for (auto expression_idx = aggregate_node.aggregate_expressions_begin_idx;
+       expression_idx < aggregate_node.node_expressions.size(); ++expression_idx) {
+    const auto& expression = aggregate_node.node_expressions[expression_idx];
+    const auto& aggregate_expression = static_cast<const AggregateExpression&>(*expression);
+
+    if (AggregateExpression::is_count_star(aggregate_expression)) {
+      // The original COUNT(*) might refer to a leaf of the other input. Count the rows of the pushed input instead.
+      auto leaf_node = std::shared_ptr<AbstractLQPNode>{};
+      visit_lqp(pushed_input, [&](const auto& node) {
+        if (node->left_input() || node->right_input()) return LQPVisitation::VisitInputs;
+        leaf_node = node;
+        return LQPVisitation::DoNotVisitInputs;
+      });
+
+      const auto partial_count = add_unique(partial_aggregate_expressions, count_star_(leaf_node));
+      eager_aggregation.replacements.emplace(expression, add_unique(final_aggregate_expressions, sum_(partial_count)));
+      continue;
+    }
+
+    const auto& argument = aggregate_expression.argument();
+    if (!expression_evaluable_on_lqp(argument, *pushed_input)) return std::nullopt;
+    if (!pushed_input->find_column_id(*argument)) {
+      add_unique(partial_projection_expressions, argument);
+      requires_partial_projection = true;
+    }
+
+    switch (aggregate_expression.aggregate_function) {
+      case AggregateFunction::Sum:
+      case AggregateFunction::Count: {
+        const auto partial_aggregate = add_unique(partial_aggregate_expressions, expression);
+        const auto final_aggregate = add_unique(final_aggregate_expressions, sum_(partial_aggregate));
+        eager_aggregation.replacements.emplace(expression, final_aggregate);
+      } break;
+
+      case AggregateFunction::Min:
+      case AggregateFunction::Max:
+      case AggregateFunction::Any: {
+        const auto partial_aggregate = add_unique(partial_aggregate_expressions, expression);
+        const auto final_aggregate = add_unique(
+            final_aggregate_expressions,
+            std::make_shared<AggregateExpression>(aggregate_expression.aggregate_function, partial_aggregate));
+        eager_aggregation.replacements.emplace(expression, final_aggregate);
+      } break;
+
+      case AggregateFunction::Avg: {
+        const auto partial_sum = add_unique(partial_aggregate_expressions, sum_(argument));
+        const auto partial_count = add_unique(partial_aggregate_expressions, count_(argument));
+        const auto final_sum = add_unique(final_aggregate_expressions, sum_(partial_sum));
+        const auto final_count = add_unique(final_aggregate_expressions, sum_(partial_count));
+        // Dividing by a count of zero (i.e., all arguments were NULL) yields NULL, as AVG does
+        eager_aggregation.replacements.emplace(expression, div_(cast_(final_sum, DataType::Double), final_count));
+        requires_final_projection = true;
+      } break;
+
+      case AggregateFunction::CountDistinct:
+      case AggregateFunction::StandardDeviationSample:
+        return std::nullopt;
+    }
+  }
+
+  if (requires_partial_projection) {
+    eager_aggregation.partial_projection_node = ProjectionNode::make(partial_projection_expressions);
+  }
+  eager_aggregation.partial_aggregate_node =
+      AggregateNode::make(partial_group_by_expressions, partial_aggregate_expressions);
+  eager_aggregation.final_aggregate_node = AggregateNode::make(group_by_expressions, final_aggregate_expressions);
+
+  if (requires_final_projection) {
+    // Restore the column order of the original AggregateNode
+    auto final_projection_expressions = group_by_expressions;
+    for (auto expression_idx = aggregate_node.aggregate_expressions_begin_idx;
+         expression_idx < aggregate_node.node_expressions.size(); ++expression_idx) {
+      final_projection_expressions.emplace_back(
+          eager_aggregation.replacements.at(aggregate_node.node_expressions[expression_idx]));
+    }
+    eager_aggregation.final_projection_node = ProjectionNode::make(final_projection_expressions);
+  }
+
+  return eager_aggregation;
+}
+
+void connect(const Candidate& candidate, const LQPInputSide side, const EagerAggregation& eager_aggregation) {
+  if (eager_aggregation.partial_projection_node) {
+    eager_aggregation.partial_projection_node->set_left_input(eager_aggregation.pushed_input);
+    eager_aggregation.partial_aggregate_node->set_left_input(eager_aggregation.partial_projection_node);
+  } else {
+    eager_aggregation.partial_aggregate_node->set_left_input(eager_aggregation.pushed_input);
+  }
+  candidate.join_node->set_input(side, eager_aggregation.partial_aggregate_node);
+
+  eager_aggregation.final_aggregate_node->set_left_input(candidate.join_node);
+  if (eager_aggregation.final_projection_node) {
+    eager_aggregation.final_projection_node->set_left_input(eager_aggregation.final_aggregate_node);
+  }
+}
+
+void disconnect(const Candidate& candidate, const LQPInputSide side, const EagerAggregation& eager_aggregation) {
+  if (eager_aggregation.final_projection_node) eager_aggregation.final_projection_node->set_left_input(nullptr);
+  eager_aggregation.final_aggregate_node->set_left_input(nullptr);
+
+  candidate.join_node->set_input(side, eager_aggregation.pushed_input);
+  eager_aggregation.partial_aggregate_node->set_left_input(nullptr);
+  if (eager_aggregation.partial_projection_node) eager_aggregation.partial_projection_node->set_left_input(nullptr);
+}
+
+// Replaces the original aggregate (and its ProjectionNode) with the connected rewrite and updates the expressions of
+// all nodes above it
+void apply(const Candidate& candidate, const EagerAggregation& eager_aggregation) {
+  const auto top_node = eager_aggregation.top_node();
+  const auto outputs = candidate.aggregate_node->outputs();
+  const auto input_sides = candidate.aggregate_node->get_input_sides();
+  for (auto output_idx = size_t{0}; output_idx < outputs.size(); ++output_idx) {
+    outputs[output_idx]->set_input(input_sides[output_idx], top_node);
+  }
+
+  candidate.aggregate_node->set_left_input(nullptr);
+  if (candidate.projection_node) candidate.projection_node->set_left_input(nullptr);
+
+  auto visited_nodes = std::unordered_set<std::shared_ptr<AbstractLQPNode>>{};
+  auto node_queue = std::queue<std::shared_ptr<AbstractLQPNode>>{};
+  for (const auto& output : outputs) node_queue.push(output);
+
+  while (!node_queue.empty()) {
+    const auto node = node_queue.front();
+    node_queue.pop();
+    if (!visited_nodes.emplace(node).second) continue;
+
+    for (auto& expression : node->node_expressions) {
+      expression_deep_replace(expression, eager_aggregation.replacements);
+    }
+    for (const auto& output : node->outputs()) node_queue.push(output);
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+void EagerAggregationRule::apply_to(const std::shared_ptr<AbstractLQPNode>& root) const {
+  Assert(root->type == LQPNodeType::Root, "EagerAggregationRule needs root to hold onto");
+  Assert(cost_estimator, "EagerAggregationRule requires a cost estimator");
+
+  // Rewriting the plan inside visit_lqp might lead to visiting the new nodes. Thus, collect the candidates first.
+  auto candidates = std::vector<Candidate>{};
+  visit_lqp(root, [&](const auto& node) {
+    const auto candidate = find_candidate(node);
+    if (candidate) candidates.emplace_back(*candidate);
+    return LQPVisitation::VisitInputs;
+  });
+  if (candidates.empty()) return;
+
+  const auto original_output_expressions = root->left_input()->column_expressions();
+  auto original_column_names = std::vector<std::string>{};
+  for (const auto& expression : original_output_expressions) {
+    original_column_names.emplace_back(expression->as_column_name());
+  }
+
+  const auto local_cost_estimator = cost_estimator->new_instance();
+
+  for (const auto& candidate : candidates) {
+    const auto original_cost = local_cost_estimator->estimate_plan_cost(candidate.aggregate_node);
+
+    // Try both inputs of the join and keep the cheapest rewrite
+    auto best_side = std::optional<LQPInputSide>{};
+    auto best_eager_aggregation = std::optional<EagerAggregation>{};
+    auto best_cost = original_cost;
+
+    for (const auto side : {LQPInputSide::Left, LQPInputSide::Right}) {
+      const auto eager_aggregation = plan_eager_aggregation(candidate, side);
+      if (!eager_aggregation) continue;
+
+      connect(candidate, side, *eager_aggregation);
+      const auto cost = local_cost_estimator->estimate_plan_cost(eager_aggregation->top_node());
+      disconnect(candidate, side, *eager_aggregation);
+
+      if (cost < best_cost) {
+        best_side = side;
+        best_eager_aggregation = eager_aggregation;
+        best_cost = cost;
+      }
+    }
+
+    if (!best_side) continue;
+
+    connect(candidate, *best_side, *best_eager_aggregation);
+    apply(candidate, *best_eager_aggregation);
+  }
+
+  // Nodes above the aggregate now refer to different expressions (e.g., SUM(SUM(a)) instead of SUM(a)). Keep the
+  // column names of the result.
+  const auto output_expressions = root->left_input()->column_expressions();
+  if (root->left_input()->type != LQPNodeType::Alias &&
+      !expressions_equal(output_expressions, original_output_expressions)) {
+    lqp_insert_node(root, LQPInputSide::Left, AliasNode::make(output_expressions, original_column_names));
+  }
+}
+
+}  // namespace opossum
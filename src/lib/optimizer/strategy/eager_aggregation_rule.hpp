@@ -0,0 +1,41 @@
+#pragma once
+
+#include "abstract_rule.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+
+/**
+ * Eager aggregation (Yan and Larson, "Eager Aggregation and Lazy Aggregation", VLDB 1995) pre-aggregates one input of
+ * a join before the join is executed. Take the following query as an example:
+ *
+ *   SELECT d_category, SUM(f_price) FROM fact, dimension WHERE f_dimension_id = d_id GROUP BY d_category
+ *
+ * Without this rule, every row of the (large) fact table is joined with the dimension table before the result is
+ * aggregated. Instead, the fact table can be aggregated on the join key first. The join then only produces one row
+ * per distinct key, and a final aggregation combines the partial results:
+ *
+ * [ fact ] -> [ Aggregate SUM(f_price) GROUP BY f_dimension_id ] -> [ Join f_dimension_id = d_id ] -> [ Aggregate
+ *                                                                  /     SUM(SUM(f_price)) GROUP BY d_category ]
+ * [ dimension ] ---------------------------------------------------
+ *
+ * The partial aggregate groups by the join keys of its side and by the group-by columns of the original aggregate that
+ * stem from that side. This is only possible for decomposable aggregate functions: SUM and COUNT are summed up, MIN,
+ * MAX, and ANY are applied again, and AVG is computed from a partial SUM and COUNT. All aggregate arguments have to
+ * stem from the pre-aggregated side. As partial aggregates might not reduce the number of rows much, the rewrite is
+ * only applied if the cost estimator considers the resulting plan to be cheaper.
+ *
+ * Currently, only inner equi joins directly below the AggregateNode (optionally with a ProjectionNode that computes
+ * the aggregate arguments in between) are considered. Aggregates without a GROUP BY clause are not rewritten, as they
+ * return a row even for an empty input, where SUM(COUNT(*)) would be NULL instead of 0.
+ *
+ * Nodes above the aggregate refer to its output by the original aggregate expressions (e.g., SUM(f_price)). These are
+ * replaced with the new expressions. If this changes the output of the LQP, an AliasNode retains the column names.
+ */
+class EagerAggregationRule : public AbstractRule {
+ public:
+  void apply_to(const std::shared_ptr<AbstractLQPNode>& root) const override;
+};
+
+}  // namespace opossum
@@ -0,0 +1,137 @@
+#include "group_join_rule.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "expression/aggregate_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+
+namespace {
+using namespace opossum;  // NOLINT
+
+// Returns true if the values of @param column_expression are unique in the output of @param node
+bool is_unique_column(const std::shared_ptr<AbstractLQPNode>& node, const LQPColumnExpression& column_expression) {
+  const auto stored_table_node =
+      std::dynamic_pointer_cast<const StoredTableNode>(column_expression.column_reference.original_node());
+  if (!stored_table_node) return false;
+
+  // Predicates and validates only remove rows. Other nodes (e.g., joins) might duplicate them.
+  auto current_node = node;
+  auto validated = false;
+  while (current_node->type == LQPNodeType::Predicate || current_node->type == LQPNodeType::Validate) {
+    validated |= current_node->type == LQPNodeType::Validate;
+    current_node = current_node->left_input();
+  }
+  if (current_node != stored_table_node) return false;
+
+  // Without validation, outdated versions of updated rows might duplicate a key
+  const auto& table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+  if (table->uses_mvcc() == UseMvcc::Yes && !validated) return false;
+
+  const auto column_id = column_expression.column_reference.original_column_id();
+  for (const auto& table_constraint : table->get_soft_unique_constraints()) {
+    if (table_constraint.columns.size() == 1 && table_constraint.columns.front() == column_id) return true;
+  }
+
+  return false;
+}
+
+// Returns true if the aggregate can be executed as a GroupJoin that builds its hash table on @param build_key
+bool is_group_join_applicable(const AggregateNode& aggregate_node, const JoinNode& join_node,
+                              const std::shared_ptr<AbstractLQPNode>& build_input,
+                              const std::shared_ptr<AbstractLQPNode>& probe_input,
+                              const std::shared_ptr<LQPColumnExpression>& build_key) {
+  auto build_key_grouped = false;
+  for (auto expression_idx = size_t{0}; expression_idx < aggregate_node.aggregate_expressions_begin_idx;
+       ++expression_idx) {
+    const auto& expression = aggregate_node.node_expressions[expression_idx];
+    if (!join_node.find_column_id(*expression) || !expression_evaluable_on_lqp(expression, *build_input)) return false;
+    if (*expression == *build_key) build_key_grouped = true;
+  }
+  if (!build_key_grouped) return false;
+
+  for (auto expression_idx = aggregate_node.aggregate_expressions_begin_idx;
+       expression_idx < aggregate_node.node_expressions.size(); ++expression_idx) {
+    const auto& expression = aggregate_node.node_expressions[expression_idx];
+    if (AggregateExpression::is_count_star(*expression)) continue;
+
+    const auto& aggregate_expression = static_cast<const AggregateExpression&>(*expression);
+    const auto argument = aggregate_expression.argument();
+    if (!join_node.find_column_id(*argument)) return false;
+
+    switch (aggregate_expression.aggregate_function) {
+      case AggregateFunction::Any:
+        if (!expression_evaluable_on_lqp(argument, *build_input)) return false;
+        break;
+      case AggregateFunction::Min:
+      case AggregateFunction::Max:
+      case AggregateFunction::Sum:
+      case AggregateFunction::Avg:
+      case AggregateFunction::Count:
+        if (!expression_evaluable_on_lqp(argument, *probe_input)) return false;
+        break;
+      case AggregateFunction::CountDistinct:
+      case AggregateFunction::StandardDeviationSample:
+        return false;
+    }
+  }
+
+  return is_unique_column(build_input, *build_key);
+}
+
+}  // namespace
+
+namespace opossum {
+
+void GroupJoinRule::apply_to(const std::shared_ptr<AbstractLQPNode>& root) const {
+  visit_lqp(root, [&](const auto& node) {
+    if (node->type != LQPNodeType::Aggregate) return LQPVisitation::VisitInputs;
+
+    // Aggregates are re-examined when an already optimized LQP is optimized again
+    auto& aggregate_node = static_cast<AggregateNode&>(*node);
+    aggregate_node.is_group_join = false;
+
+    const auto join_node = std::dynamic_pointer_cast<JoinNode>(node->left_input());
+
+    // The join result must not be used by other nodes, as it is never materialized. Joins that the IndexScanRule
+    // marked for probing a table hash index are left untouched.
+    if (!join_node || join_node->join_mode != JoinMode::Inner || join_node->join_predicates().size() != 1 ||
+        join_node->output_count() != 1 || join_node->table_hash_index_side) {
+      return LQPVisitation::VisitInputs;
+    }
+
+    const auto join_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(join_node->join_predicates()[0]);
+    if (!join_predicate || join_predicate->predicate_condition != PredicateCondition::Equals) {
+      return LQPVisitation::VisitInputs;
+    }
+
+    auto left_key = std::dynamic_pointer_cast<LQPColumnExpression>(join_predicate->left_operand());
+    auto right_key = std::dynamic_pointer_cast<LQPColumnExpression>(join_predicate->right_operand());
+    if (!left_key || !right_key || left_key->data_type() != right_key->data_type()) return LQPVisitation::VisitInputs;
+    if (!expression_evaluable_on_lqp(left_key, *join_node->left_input())) std::swap(left_key, right_key);
+
+    const auto left_input = join_node->left_input();
+    const auto right_input = join_node->right_input();
+
+    if (is_group_join_applicable(aggregate_node, *join_node, left_input, right_input, left_key)) {
+      aggregate_node.is_group_join = true;
+    } else if (is_group_join_applicable(aggregate_node, *join_node, right_input, left_input, right_key)) {
+      // The GroupJoin builds its hash table on the left input
+      join_node->set_left_input(right_input);
+      join_node->set_right_input(left_input);
+      aggregate_node.is_group_join = true;
+    }
+
+    return LQPVisitation::VisitInputs;
+  });
+}
+
+}  // namespace opossum
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "abstract_rule.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+
+/**
+ * Marks AggregateNodes that can be executed together with the join below them as a GroupJoin (see group_join.hpp).
+ * Take the following query as an example:
+ *
+ *   SELECT c_custkey, c_name, SUM(o_totalprice) FROM customer, orders WHERE c_custkey = o_custkey
+ *   GROUP BY c_custkey, c_name
+ *
+ * The DependentGroupByReductionRule turns c_name into ANY(c_name), as it is functionally dependent on the primary key
+ * c_custkey. As c_custkey is also the join key, each customer forms exactly one group. Instead of materializing the
+ * join result and building a second hash table to aggregate it, the GroupJoin accumulates the aggregates while
+ * probing the join's hash table on c_custkey.
+ *
+ * The rule applies to AggregateNodes directly on top of an inner join with a single equality predicate on two
+ * columns of the same data type if one input of the join (the build side) satisfies the following conditions:
+ *  - Its join column is unique: It has a single-column unique constraint in its stored table, and only predicates and
+ *    validates lie in between (as these do not duplicate rows).
+ *  - Its join column is grouped by, and all other group by expressions and the arguments of ANY() stem from it.
+ *  - All other aggregates are COUNT(*) or MIN, MAX, SUM, AVG, or COUNT on columns of the other input.
+ *
+ * The build side becomes the left input of the join, which is not used by any other node.
+ */
+class GroupJoinRule : public AbstractRule {
+ public:
+  void apply_to(const std::shared_ptr<AbstractLQPNode>& root) const override;
+};
+
+}  // namespace opossum
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,7 +10,11 @@
 #include "all_parameter_variant.hpp"
 #include "constant_mappings.hpp"
 #include "cost_estimation/abstract_cost_estimator.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/logical_expression.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/join_node.hpp"
 #include "logical_query_plan/lqp_utils.hpp"
 #include "logical_query_plan/predicate_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
@@ -33,7 +38,15 @@ void IndexScanRule::apply_to(const std::shared_ptr<AbstractLQPNode>& root) const
   Assert(root->type == LQPNodeType::Root, "ExpressionReductionRule needs root to hold onto");
 
   visit_lqp(root, [&](const auto& node) {
+    if (node->type == LQPNodeType::Join) {
+      _apply_table_hash_index_join(std::static_pointer_cast<JoinNode>(node));
+    }
+
     if (node->type == LQPNodeType::Predicate) {
+      if (_apply_table_hash_index_scan(std::static_pointer_cast<PredicateNode>(node))) {
+        return LQPVisitation::DoNotVisitInputs;
+      }
+
       const auto& child = node->left_input();
 
       if (child->type == LQPNodeType::StoredTable) {
@@ -85,4 +98,126 @@ bool IndexScanRule::_is_single_segment_index(const IndexStatistics& index_statis
   return index_statistics.column_ids.size() == 1;
 }
 
+bool IndexScanRule::_apply_table_hash_index_scan(const std::shared_ptr<PredicateNode>& predicate_node) {
+  // Gather the chain of PredicateNodes on top of a StoredTableNode. Nodes further down the chain must not have other
+  // outputs, as we move predicates within the chain.
+  auto predicate_nodes = std::vector<std::shared_ptr<PredicateNode>>{predicate_node};
+  auto current_node = predicate_node->left_input();
+  while (current_node->type == LQPNodeType::Predicate && current_node->output_count() == 1) {
+    predicate_nodes.emplace_back(std::static_pointer_cast<PredicateNode>(current_node));
+    current_node = current_node->left_input();
+  }
+
+  if (current_node->type != LQPNodeType::StoredTable) return false;
+  const auto stored_table_node = std::static_pointer_cast<StoredTableNode>(current_node);
+
+  const auto indexes_column_ids = stored_table_node->table_hash_indexes_column_ids();
+  if (indexes_column_ids.empty()) return false;
+
+  // Find the equality predicates of the form `<column> = <value or parameter>`, one per column
+  auto equality_predicate_nodes = std::map<ColumnID, std::shared_ptr<PredicateNode>>{};
+  for (const auto& current_predicate_node : predicate_nodes) {
+    const auto operator_predicates =
+        OperatorScanPredicate::from_expression(*current_predicate_node->predicate(), *current_predicate_node);
+    if (!operator_predicates || operator_predicates->size() != 1) continue;
+
+    const auto& operator_predicate = operator_predicates->front();
+    if (operator_predicate.predicate_condition != PredicateCondition::Equals) continue;
+    if (is_column_id(operator_predicate.value)) continue;
+
+    equality_predicate_nodes.emplace(operator_predicate.column_id, current_predicate_node);
+  }
+
+  // Use the index with the most key columns that are all covered by the predicates
+  const auto* best_index_column_ids = static_cast<const std::vector<ColumnID>*>(nullptr);
+  for (const auto& index_column_ids : indexes_column_ids) {
+    const auto is_covered = std::all_of(index_column_ids.begin(), index_column_ids.end(), [&](const auto column_id) {
+      return equality_predicate_nodes.count(column_id);
+    });
+
+    if (is_covered && (!best_index_column_ids || index_column_ids.size() > best_index_column_ids->size())) {
+      best_index_column_ids = &index_column_ids;
+    }
+  }
+  if (!best_index_column_ids) return false;
+
+  // Merge the predicates on the key columns into a single PredicateNode directly on top of the StoredTableNode
+  auto key_predicate_nodes = std::vector<std::shared_ptr<PredicateNode>>{};
+  auto key_predicates = std::vector<std::shared_ptr<AbstractExpression>>{};
+  for (const auto column_id : *best_index_column_ids) {
+    key_predicate_nodes.emplace_back(equality_predicate_nodes[column_id]);
+    key_predicates.emplace_back(key_predicate_nodes.back()->predicate());
+  }
+
+  const auto index_scan_node = PredicateNode::make(inflate_logical_expressions(key_predicates, LogicalOperator::And));
+  index_scan_node->scan_type = ScanType::IndexScan;
+
+  lqp_insert_node(predicate_nodes.back(), LQPInputSide::Left, index_scan_node);
+  for (const auto& key_predicate_node : key_predicate_nodes) {
+    lqp_remove_node(key_predicate_node);
+  }
+
+  return true;
+}
+
+void IndexScanRule::_apply_table_hash_index_join(const std::shared_ptr<JoinNode>& join_node) const {
+  if (join_node->join_predicates().size() != 1) return;
+
+  const auto join_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(join_node->join_predicates()[0]);
+  if (!join_predicate || join_predicate->predicate_condition != PredicateCondition::Equals) return;
+
+  // The JoinIndex cannot emit unmatched rows of the index side
+  auto index_sides = std::vector<IndexSide>{};
+  switch (join_node->join_mode) {
+    case JoinMode::Inner:
+      index_sides = {IndexSide::Right, IndexSide::Left};
+      break;
+    case JoinMode::Left:
+    case JoinMode::Semi:
+    case JoinMode::AntiNullAsFalse:
+      index_sides = {IndexSide::Right};
+      break;
+    case JoinMode::Right:
+      index_sides = {IndexSide::Left};
+      break;
+    default:
+      return;
+  }
+
+  for (const auto index_side : index_sides) {
+    const auto& index_side_input = index_side == IndexSide::Left ? join_node->left_input() : join_node->right_input();
+    const auto& probe_side_input = index_side == IndexSide::Left ? join_node->right_input() : join_node->left_input();
+
+    auto stored_table_node = std::shared_ptr<StoredTableNode>{};
+    if (index_side_input->type == LQPNodeType::StoredTable) {
+      stored_table_node = std::static_pointer_cast<StoredTableNode>(index_side_input);
+    } else if (index_side_input->type == LQPNodeType::Validate &&
+               index_side_input->left_input()->type == LQPNodeType::StoredTable) {
+      stored_table_node = std::static_pointer_cast<StoredTableNode>(index_side_input->left_input());
+    } else {
+      continue;
+    }
+
+    auto column_id = stored_table_node->find_column_id(*join_predicate->left_operand());
+    if (!column_id) column_id = stored_table_node->find_column_id(*join_predicate->right_operand());
+    if (!column_id) continue;
+
+    const auto indexes_column_ids = stored_table_node->table_hash_indexes_column_ids();
+    if (std::find(indexes_column_ids.begin(), indexes_column_ids.end(), std::vector<ColumnID>{*column_id}) ==
+        indexes_column_ids.end()) {
+      continue;
+    }
+
+    // Probing the index pays off if it saves us from looking at the (larger) index side
+    const auto index_side_row_count = cost_estimator->cardinality_estimator->estimate_cardinality(index_side_input);
+    const auto probe_side_row_count = cost_estimator->cardinality_estimator->estimate_cardinality(probe_side_input);
+    if (index_side_row_count < INDEX_SCAN_ROW_COUNT_THRESHOLD || probe_side_row_count >= index_side_row_count) {
+      continue;
+    }
+
+    join_node->table_hash_index_side = index_side;
+    return;
+  }
+}
+
 }  // namespace opossum
@@ -11,6 +11,7 @@
 namespace opossum {
 
 class AbstractLQPNode;
+class JoinNode;
 class PredicateNode;
 
 /**
@@ -23,6 +24,15 @@ class PredicateNode;
  * not supported. We also assume that if chunks have an index, all of them are of the same type, we do not mix GroupKey
  * and ART indexes. In addition, chains of IndexScans are not possible since an IndexScan's input must be a GetTable.
  * Currently, only GroupKeyIndexes are supported.
+ *
+ * Table hash indexes (see TableHashIndex) are handled separately, as they answer point lookups independent of the
+ * number of chunks:
+ *  - If a chain of PredicateNodes on top of a StoredTableNode contains equality predicates on all key columns of a
+ *    table hash index (e.g., `w_id = ? AND d_id = ?`), these predicates are merged into a single PredicateNode directly
+ *    on top of the StoredTableNode, which is executed as a single index lookup. No selectivity threshold applies.
+ *  - If one input of an equi join is a (validated) StoredTableNode with a table hash index on the join column and the
+ *    other input is expected to be smaller, the join is marked to be executed as an index nested loop join probing
+ *    that index (see JoinIndex).
  */
 
 class IndexScanRule : public AbstractRule {
@@ -33,6 +43,10 @@ class IndexScanRule : public AbstractRule {
   bool _is_index_scan_applicable(const IndexStatistics& index_statistics,
                                  const std::shared_ptr<PredicateNode>& predicate_node) const;
   static bool _is_single_segment_index(const IndexStatistics& index_statistics);
+
+  // Returns true if the predicate chain starting at predicate_node was rewritten to use a table hash index
+  static bool _apply_table_hash_index_scan(const std::shared_ptr<PredicateNode>& predicate_node);
+  void _apply_table_hash_index_join(const std::shared_ptr<JoinNode>& join_node) const;
 };
 
 }  // namespace opossum
@@ -6,7 +6,10 @@
 #include <vector>
 
 #include "abstract_scheduler.hpp"
+#include "concurrency/cancellation_token.hpp"
 #include "hyrise.hpp"
+#include "memory/query_memory_resource.hpp"
+#include "schedule_priority_scope.hpp"
 #include "task_queue.hpp"
 #include "utils/tracing/probes.hpp"
 #include "worker.hpp"
@@ -15,7 +18,11 @@
 
 namespace opossum {
 
-AbstractTask::AbstractTask(SchedulePriority priority, bool stealable) : _priority(priority), _stealable(stealable) {}
+AbstractTask::AbstractTask(SchedulePriority priority, bool stealable)
+    : _priority(priority == SchedulePriority::Default ? SchedulePriorityScope::current() : priority),
+      _stealable(stealable),
+      _memory_resource(DefaultMemoryResourceScope::current()),
+      _cancellation_token(CancellationTokenScope::current()) {}
 
 TaskID AbstractTask::id() const { return _id; }
 
@@ -27,6 +34,8 @@ bool AbstractTask::is_done() const { return _done; }
 
 bool AbstractTask::is_stealable() const { return _stealable; }
 
+SchedulePriority AbstractTask::priority() const { return _priority; }
+
 bool AbstractTask::is_scheduled() const { return _is_scheduled; }
 
 std::string AbstractTask::description() const {
@@ -57,6 +66,22 @@ void AbstractTask::set_done_callback(const std::function<void()>& done_callback)
   _done_callback = done_callback;
 }
 
+void AbstractTask::set_memory_resource(boost::container::pmr::memory_resource* memory_resource) {
+  DebugAssert((!_is_scheduled), "Possible race: Don't set memory resource after the Task was scheduled");
+
+  _memory_resource = memory_resource;
+}
+
+boost::container::pmr::memory_resource* AbstractTask::memory_resource() const { return _memory_resource; }
+
+void AbstractTask::set_cancellation_token(const std::shared_ptr<CancellationToken>& cancellation_token) {
+  DebugAssert((!_is_scheduled), "Possible race: Don't set cancellation token after the Task was scheduled");
+
+  _cancellation_token = cancellation_token;
+}
+
+const std::shared_ptr<CancellationToken>& AbstractTask::cancellation_token() const { return _cancellation_token; }
+
 void AbstractTask::schedule(NodeID preferred_node_id) {
   // We need to make sure that data written by the scheduling thread is visible in the thread executing the task. While
   // spawning a thread is an implicit barrier, we have no such guarantee when we simply add a task to a queue and it is
@@ -91,7 +116,15 @@ void AbstractTask::execute() {
   // spawned the task are pushed down to a point where this thread is already running.
   Assert(_is_scheduled, "Task should be have been scheduled before being executed");
 
-  _on_execute();
+  {
+    // The scope is set even if _memory_resource is nullptr. Otherwise, a task of another query that a waiting worker
+    // executes in between would inherit the arena of the waiting task.
+    const auto memory_resource_scope = DefaultMemoryResourceScope{_memory_resource};
+    const auto priority_scope =
+        SchedulePriorityScope{_priority == SchedulePriority::Low ? SchedulePriority::Low : SchedulePriority::Default};
+    const auto cancellation_token_scope = CancellationTokenScope{_cancellation_token};
+    _on_execute();
+  }
 
   for (auto& successor : _successors) {
     successor->_on_predecessor_done();
@@ -124,7 +157,10 @@ void AbstractTask::_on_predecessor_done() {
       // the sake of a clearly defined life cycle, we wait for the task to be scheduled.
       if (!_is_scheduled) return;
 
-      worker->queue()->push(shared_from_this(), static_cast<uint32_t>(SchedulePriority::High));
+      // Ready successors are started right away to finish running queries first. Low-priority tasks stay behind the
+      // other tasks, though.
+      const auto priority = _priority == SchedulePriority::Low ? SchedulePriority::Low : SchedulePriority::High;
+      worker->queue()->push(shared_from_this(), static_cast<uint32_t>(priority));
     } else {
       if (_is_scheduled) execute();
       // Otherwise it will get execute()d once it is scheduled. It is entirely possible for Tasks to "become ready"
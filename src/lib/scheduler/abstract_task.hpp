@@ -10,8 +10,13 @@
 
 #include "types.hpp"
 
+namespace boost::container::pmr {
+class memory_resource;
+}  // namespace boost::container::pmr
+
 namespace opossum {
 
+class CancellationToken;
 class Worker;
 
 /**
@@ -23,6 +28,7 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
   friend class AbstractScheduler;
 
  public:
+  // Tasks created with SchedulePriority::Default get the priority of the current SchedulePriorityScope
   explicit AbstractTask(SchedulePriority priority = SchedulePriority::Default, bool stealable = true);
   virtual ~AbstractTask() = default;
 
@@ -47,6 +53,11 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
    */
   bool is_stealable() const;
 
+  /**
+   * @return The priority the task is scheduled with, after applying the SchedulePriorityScope
+   */
+  SchedulePriority priority() const;
+
   /**
    * Description for debugging purposes
    */
@@ -85,6 +96,23 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
    */
   void set_done_callback(const std::function<void()>& done_callback);
 
+  /**
+   * Memory resource that default-constructed PolymorphicAllocators use while the Task is executed (see
+   * DefaultMemoryResourceScope). By default, this is the resource that was active when the Task was created. Thus,
+   * JobTasks spawned by an operator allocate from the same per-query arena as the operator itself.
+   * The resource has to outlive the Task.
+   */
+  void set_memory_resource(boost::container::pmr::memory_resource* memory_resource);
+  boost::container::pmr::memory_resource* memory_resource() const;
+
+  /**
+   * Token of the query the Task belongs to (see CancellationTokenScope). Like the memory resource, this defaults to the
+   * token that was active when the Task was created. OperatorTasks are released without executing their operator once
+   * the token is cancelled.
+   */
+  void set_cancellation_token(const std::shared_ptr<CancellationToken>& cancellation_token);
+  const std::shared_ptr<CancellationToken>& cancellation_token() const;
+
   /**
    * Schedules the task if a Scheduler is available, otherwise just executes it on the current Thread
    */
@@ -133,6 +161,8 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
   std::atomic<bool> _stealable;
   std::atomic_bool _done{false};
   std::function<void()> _done_callback;
+  boost::container::pmr::memory_resource* _memory_resource;
+  std::shared_ptr<CancellationToken> _cancellation_token;
 
   // For dependencies
   std::atomic_uint _pending_predecessors{0};
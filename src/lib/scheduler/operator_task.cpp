@@ -4,6 +4,7 @@
 #include <utility>
 #include <vector>
 
+#include "concurrency/cancellation_token.hpp"
 #include "operators/abstract_operator.hpp"
 #include "operators/abstract_read_write_operator.hpp"
 
@@ -55,6 +56,9 @@ std::shared_ptr<OperatorTask> OperatorTask::_add_tasks_from_operator(
 const std::shared_ptr<AbstractOperator>& OperatorTask::get_operator() const { return _op; }
 
 void OperatorTask::_on_execute() {
+  // Tasks of a cancelled query are released right away. The SQLPipelineStatement rolls back the transaction.
+  if (cancellation_token() && cancellation_token()->is_cancelled()) return;
+
   auto context = _op->transaction_context();
   if (context) {
     switch (context->phase()) {
@@ -0,0 +1,20 @@
+#include "schedule_priority_scope.hpp"
+
+namespace {
+
+thread_local opossum::SchedulePriority scoped_schedule_priority = opossum::SchedulePriority::Default;
+
+}  // namespace
+
+namespace opossum {
+
+SchedulePriorityScope::SchedulePriorityScope(const SchedulePriority priority)
+    : _previous_priority(scoped_schedule_priority) {
+  scoped_schedule_priority = priority;
+}
+
+SchedulePriorityScope::~SchedulePriorityScope() { scoped_schedule_priority = _previous_priority; }
+
+SchedulePriority SchedulePriorityScope::current() { return scoped_schedule_priority; }
+
+}  // namespace opossum
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Sets the priority that tasks created by the calling thread get when they are created with
+ * SchedulePriority::Default, as long as the scope is alive. Scopes can be nested, the previous priority is restored on
+ * destruction.
+ *
+ * AbstractTask::execute() opens a scope for low-priority tasks. Thus, JobTasks spawned by an operator of a low-priority
+ * query are low-priority tasks as well and do not crowd out the tasks of other queries. SchedulePriority::High is not
+ * inherited, as it marks single tasks that should be started right away.
+ */
+class SchedulePriorityScope : private Noncopyable {
+ public:
+  explicit SchedulePriorityScope(const SchedulePriority priority);
+  ~SchedulePriorityScope();
+
+  // Returns the priority of the innermost scope of the calling thread, or SchedulePriority::Default without a scope
+  static SchedulePriority current();
+
+ private:
+  const SchedulePriority _previous_priority;
+};
+
+}  // namespace opossum
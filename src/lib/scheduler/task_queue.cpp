@@ -33,11 +33,18 @@ void TaskQueue::push(const std::shared_ptr<AbstractTask>& task, uint32_t priorit
 
 std::shared_ptr<AbstractTask> TaskQueue::pull() {
   std::shared_ptr<AbstractTask> task;
-  for (auto& queue : _queues) {
-    if (queue.try_pop(task)) {
-      return task;
-    }
+  auto& high_priority_queue = _queues[static_cast<uint32_t>(SchedulePriority::High)];
+  auto& default_priority_queue = _queues[static_cast<uint32_t>(SchedulePriority::Default)];
+  auto& low_priority_queue = _queues[static_cast<uint32_t>(SchedulePriority::Low)];
+
+  if (high_priority_queue.try_pop(task)) return task;
+
+  if (_pull_count.fetch_add(1, std::memory_order_relaxed) % LOW_PRIORITY_SHARE == 0) {
+    if (low_priority_queue.try_pop(task) || default_priority_queue.try_pop(task)) return task;
+  } else {
+    if (default_priority_queue.try_pop(task) || low_priority_queue.try_pop(task)) return task;
   }
+
   return nullptr;
 }
 
@@ -15,10 +15,15 @@ class AbstractTask;
 
 /**
  * Holds a queue of AbstractTasks, usually one of these exists per node
+ *
+ * High-priority tasks are always pulled first. Low-priority tasks are pulled after default-priority tasks, but every
+ * LOW_PRIORITY_SHARE-th pull prefers them. Thus, a stream of default-priority tasks cannot starve them, and a flood of
+ * low-priority tasks (e.g., of long-running analytical queries) gets only a proportional share of the workers.
  */
 class TaskQueue {
  public:
-  static constexpr uint32_t NUM_PRIORITY_LEVELS = 2;
+  static constexpr uint32_t NUM_PRIORITY_LEVELS = 3;
+  static constexpr uint32_t LOW_PRIORITY_SHARE = 5;
 
   explicit TaskQueue(NodeID node_id);
 
@@ -51,6 +56,7 @@ class TaskQueue {
  private:
   NodeID _node_id;
   std::array<tbb::concurrent_queue<std::shared_ptr<AbstractTask>>, NUM_PRIORITY_LEVELS> _queues;
+  std::atomic<uint32_t> _pull_count{0};
 };
 
 }  // namespace opossum
@@ -0,0 +1,80 @@
+#include "admission_control.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "hyrise.hpp"
+#include "utils/assert.hpp"
+#include "utils/settings/integral_setting.hpp"
+
+namespace opossum {
+
+AdmissionControl::Admission::Admission(AdmissionControl& admission_control, const WorkloadClass workload_class)
+    : _admission_control(admission_control), _workload_class(workload_class) {
+  auto lock = std::unique_lock{_admission_control._mutex};
+  auto& state = _admission_control._state(_workload_class);
+  const auto ticket = state.next_ticket++;
+
+  // The limit is re-read periodically so that raising it also admits statements that are already waiting
+  while (true) {
+    const auto concurrency_limit = _concurrency_limit(_workload_class);
+    if (state.next_admitted_ticket == ticket && (concurrency_limit == 0 || state.running_count < concurrency_limit)) {
+      break;
+    }
+    _admission_control._condition_variable.wait_for(lock, std::chrono::milliseconds{10});
+  }
+
+  ++state.next_admitted_ticket;
+  ++state.running_count;
+
+  // The next ticket might be admissible as well
+  _admission_control._condition_variable.notify_all();
+}
+
+AdmissionControl::Admission::~Admission() {
+  {
+    const auto lock = std::lock_guard{_admission_control._mutex};
+    auto& state = _admission_control._state(_workload_class);
+    DebugAssert(state.running_count > 0, "Admission released more often than granted");
+    --state.running_count;
+  }
+  _admission_control._condition_variable.notify_all();
+}
+
+size_t AdmissionControl::running_count(const WorkloadClass workload_class) const {
+  const auto lock = std::lock_guard{_mutex};
+  return _state(workload_class).running_count;
+}
+
+size_t AdmissionControl::waiting_count(const WorkloadClass workload_class) const {
+  const auto lock = std::lock_guard{_mutex};
+  const auto& state = _state(workload_class);
+  return state.next_ticket - state.next_admitted_ticket;
+}
+
+SchedulePriority AdmissionControl::schedule_priority(const WorkloadClass workload_class) {
+  return workload_class == WorkloadClass::Analytical ? SchedulePriority::Low : SchedulePriority::Default;
+}
+
+size_t AdmissionControl::_concurrency_limit(const WorkloadClass workload_class) {
+  const auto setting_name = workload_class == WorkloadClass::Transactional ? MAX_CONCURRENT_TRANSACTIONAL_SETTING_NAME
+                                                                           : MAX_CONCURRENT_ANALYTICAL_SETTING_NAME;
+  const auto& settings_manager = Hyrise::get().settings_manager;
+  if (!settings_manager.has_setting(setting_name)) return 0;
+
+  const auto setting = std::dynamic_pointer_cast<IntegralSetting>(settings_manager.get_setting(setting_name));
+  Assert(setting, std::string{setting_name} + " is expected to be an IntegralSetting");
+
+  return static_cast<size_t>(std::max(setting->value(), int64_t{0}));
+}
+
+AdmissionControl::WorkloadClassState& AdmissionControl::_state(const WorkloadClass workload_class) {
+  return _states[static_cast<size_t>(workload_class)];
+}
+
+const AdmissionControl::WorkloadClassState& AdmissionControl::_state(const WorkloadClass workload_class) const {
+  return _states[static_cast<size_t>(workload_class)];
+}
+
+}  // namespace opossum
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+
+#include "server_types.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Limits the number of statements per WorkloadClass that are executed concurrently. Statements that exceed the limit
+// of their class are queued and admitted in the order of their arrival. The limits are read from the settings
+// `Server.max_concurrent_transactional_statements` and `Server.max_concurrent_analytical_statements`, where 0 (the
+// default) means that the class is not limited. Changes of the limits take effect for the next admission.
+class AdmissionControl : private Noncopyable {
+ public:
+  static constexpr auto MAX_CONCURRENT_TRANSACTIONAL_SETTING_NAME = "Server.max_concurrent_transactional_statements";
+  static constexpr auto MAX_CONCURRENT_ANALYTICAL_SETTING_NAME = "Server.max_concurrent_analytical_statements";
+
+  // Holds the admission of a single statement. Blocks on construction until the statement may be executed and lets
+  // the next queued statement of the same class in on destruction.
+  class Admission : private Noncopyable {
+   public:
+    Admission(AdmissionControl& admission_control, const WorkloadClass workload_class);
+    ~Admission();
+
+   private:
+    AdmissionControl& _admission_control;
+    const WorkloadClass _workload_class;
+  };
+
+  // Number of statements of @param workload_class that are currently admitted or still waiting for their admission
+  size_t running_count(const WorkloadClass workload_class) const;
+  size_t waiting_count(const WorkloadClass workload_class) const;
+
+  // Analytical statements are scheduled with SchedulePriority::Low, which guarantees them only a share of the workers
+  static SchedulePriority schedule_priority(const WorkloadClass workload_class);
+
+ private:
+  struct WorkloadClassState {
+    size_t running_count{0};
+    // Tickets are handed out on arrival and admitted in order to prevent starvation of waiting statements
+    uint64_t next_ticket{0};
+    uint64_t next_admitted_ticket{0};
+  };
+
+  static size_t _concurrency_limit(const WorkloadClass workload_class);
+
+  WorkloadClassState& _state(const WorkloadClass workload_class);
+  const WorkloadClassState& _state(const WorkloadClass workload_class) const;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _condition_variable;
+  std::array<WorkloadClassState, 2> _states;
+};
+
+}  // namespace opossum
@@ -22,6 +22,8 @@ enum class PostgresMessageType : unsigned char {
   ReadyForQuery = 'Z',
   RowDescription = 'T',
   DataRow = 'D',
+  CopyInResponse = 'G',
+  BackendKeyData = 'K',
 
   // Selection of error and notice message fields. All possible fields are documented at:
   // https://www.postgresql.org/docs/12/protocol-error-fields.html
@@ -39,6 +41,11 @@ enum class PostgresMessageType : unsigned char {
   SimpleQueryCommand = 'Q',
   CloseCommand = 'C',
 
+  // Messages of the COPY sub-protocol that are sent by the client
+  CopyData = 'd',
+  CopyDone = 'c',
+  CopyFail = 'f',
+
   // SSL willingness
   SslYes = 'S',
   SslNo = 'N',
@@ -53,5 +60,6 @@ enum class TransactionStatusIndicator : unsigned char {
 
 // SQL error codes
 constexpr char TRANSACTION_CONFLICT[] = "40001";
+constexpr char QUERY_CANCELED[] = "57014";
 
 }  // namespace opossum
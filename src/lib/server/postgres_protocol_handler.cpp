@@ -7,9 +7,11 @@ PostgresProtocolHandler<SocketType>::PostgresProtocolHandler(const std::shared_p
     : _read_buffer(socket), _write_buffer(socket) {}
 
 template <typename SocketType>
-uint32_t PostgresProtocolHandler<SocketType>::read_startup_packet_header() {
+StartupPacketHeader PostgresProtocolHandler<SocketType>::read_startup_packet_header() {
   // Special SSL version number that we catch to deny SSL support
   constexpr auto SSL_REQUEST_CODE = 80877103u;
+  // Special version number of CancelRequests
+  constexpr auto CANCEL_REQUEST_CODE = 80877102u;
 
   const auto body_length = _read_buffer.template get_value<uint32_t>();
   const auto protocol_version = _read_buffer.template get_value<uint32_t>();
@@ -20,7 +22,7 @@ uint32_t PostgresProtocolHandler<SocketType>::read_startup_packet_header() {
     return read_startup_packet_header();
   } else {
     // Subtract uint32_t twice, since both packet length and protocol version have been read already
-    return body_length - 2 * LENGTH_FIELD_SIZE;
+    return {body_length - 2 * LENGTH_FIELD_SIZE, protocol_version == CANCEL_REQUEST_CODE};
   }
 }
 
@@ -32,6 +34,13 @@ void PostgresProtocolHandler<SocketType>::read_startup_packet_body(const uint32_
   _read_buffer.get_string(size, HasNullTerminator::No);
 }
 
+template <typename SocketType>
+BackendKeyData PostgresProtocolHandler<SocketType>::read_cancel_request_body() {
+  const auto process_id = _read_buffer.template get_value<int32_t>();
+  const auto secret_key = _read_buffer.template get_value<int32_t>();
+  return {process_id, secret_key};
+}
+
 template <typename SocketType>
 void PostgresProtocolHandler<SocketType>::send_authentication_response() {
   _write_buffer.template put_value(PostgresMessageType::AuthenticationRequest);
@@ -51,6 +60,14 @@ void PostgresProtocolHandler<SocketType>::send_parameter(const std::string& key,
   _write_buffer.put_string(value);
 }
 
+template <typename SocketType>
+void PostgresProtocolHandler<SocketType>::send_backend_key_data(const BackendKeyData& backend_key_data) {
+  _write_buffer.template put_value(PostgresMessageType::BackendKeyData);
+  _write_buffer.template put_value<uint32_t>(LENGTH_FIELD_SIZE + 2 * sizeof(int32_t));
+  _write_buffer.template put_value<int32_t>(backend_key_data.process_id);
+  _write_buffer.template put_value<int32_t>(backend_key_data.secret_key);
+}
+
 template <typename SocketType>
 void PostgresProtocolHandler<SocketType>::send_ready_for_query() {
   _write_buffer.template put_value(PostgresMessageType::ReadyForQuery);
@@ -227,6 +244,40 @@ std::string PostgresProtocolHandler<SocketType>::read_execute_packet() {
   return portal;
 }
 
+template <typename SocketType>
+void PostgresProtocolHandler<SocketType>::send_copy_in_response(const uint16_t column_count) {
+  // Overall format (0 = text) and column count, followed by the format code of each column
+  const auto packet_size = LENGTH_FIELD_SIZE + sizeof(int8_t) + sizeof(uint16_t) + column_count * sizeof(uint16_t);
+  _write_buffer.template put_value(PostgresMessageType::CopyInResponse);
+  _write_buffer.template put_value<uint32_t>(static_cast<uint32_t>(packet_size));
+  _write_buffer.template put_value<int8_t>(0);
+  _write_buffer.template put_value<uint16_t>(column_count);
+  for (auto column_idx = uint16_t{0}; column_idx < column_count; ++column_idx) {
+    _write_buffer.template put_value<uint16_t>(0);
+  }
+
+  // The client does not send any data before it received this message
+  _write_buffer.flush();
+}
+
+template <typename SocketType>
+std::string PostgresProtocolHandler<SocketType>::read_copy_data_packet() {
+  const auto packet_size = _read_buffer.template get_value<uint32_t>();
+  return _read_buffer.get_string(packet_size - LENGTH_FIELD_SIZE, HasNullTerminator::No);
+}
+
+template <typename SocketType>
+void PostgresProtocolHandler<SocketType>::read_copy_done_packet() {
+  // This packet has no body. Hence, only read and ignore its size.
+  _read_buffer.template get_value<uint32_t>();
+}
+
+template <typename SocketType>
+std::string PostgresProtocolHandler<SocketType>::read_copy_fail_packet() {
+  _read_buffer.template get_value<uint32_t>();  // Ignore packet size
+  return _read_buffer.get_string();
+}
+
 template <typename SocketType>
 void PostgresProtocolHandler<SocketType>::send_error_message(const ErrorMessage& error_message) {
   _write_buffer.template put_value(PostgresMessageType::ErrorResponse);
@@ -246,9 +297,9 @@ void PostgresProtocolHandler<SocketType>::send_error_message(const ErrorMessage&
     _write_buffer.put_string(content);
   }
 
-  // We need an additional null terminator to terminate whole message
+  // We need an additional null terminator to terminate whole message. The message is flushed together with the
+  // following ReadyForQuery message.
   _write_buffer.template put_value('\0');
-  _write_buffer.flush();
 }
 
 template <typename SocketType>
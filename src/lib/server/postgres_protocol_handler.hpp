@@ -18,6 +18,20 @@ struct PreparedStatementDetails {
   std::vector<AllTypeVariant> parameters;
 };
 
+// Identifies a session towards its client. Clients send it back within a CancelRequest to cancel the running statement
+// of the session.
+struct BackendKeyData {
+  int32_t process_id;
+  int32_t secret_key;
+};
+
+// Header of the first packet that a client sends on a new connection. Besides the regular startup packet, this can be a
+// CancelRequest, which clients send on a separate connection.
+struct StartupPacketHeader {
+  uint32_t body_length;
+  bool is_cancel_request;
+};
+
 // This class extracts information from client messages and serializes the response data according to the PostgreSQL
 // Wire Protocol.
 template <typename SocketType>
@@ -26,12 +40,14 @@ class PostgresProtocolHandler {
   explicit PostgresProtocolHandler(const std::shared_ptr<SocketType>& socket);
 
   // Handle the startup packet header returning the body's size
-  uint32_t read_startup_packet_header();
+  StartupPacketHeader read_startup_packet_header();
   void read_startup_packet_body(const uint32_t size);
+  BackendKeyData read_cancel_request_body();
 
   // Setup new connection: successful authentication + sending parameters
   void send_authentication_response();
   void send_parameter(const std::string& key, const std::string& value);
+  void send_backend_key_data(const BackendKeyData& backend_key_data);
 
   // Ready to receive a new packet
   void send_ready_for_query();
@@ -61,6 +77,13 @@ class PostgresProtocolHandler {
   PreparedStatementDetails read_bind_packet();
   std::string read_execute_packet();
 
+  // Messages of the COPY FROM STDIN sub-protocol. All columns are transferred in text format.
+  void send_copy_in_response(const uint16_t column_count);
+  std::string read_copy_data_packet();
+  void read_copy_done_packet();
+  // Returns the error message of the client
+  std::string read_copy_fail_packet();
+
   // Send error message to client if there is an error during parsing or execution
   void send_error_message(const ErrorMessage& error_message);
 
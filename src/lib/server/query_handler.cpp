@@ -1,6 +1,14 @@
 #include "query_handler.hpp"
 
-#include "expression/value_expression.hpp"
+#include <regex>
+
+#include <boost/algorithm/string.hpp>
+
+#include "concurrency/cancellation_token.hpp"
+#include "expression/correlated_parameter_expression.hpp"
+#include "import_export/csv/csv_parser.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_translator.hpp"
 
@@ -8,7 +16,8 @@ namespace opossum {
 
 std::pair<ExecutionInformation, std::shared_ptr<TransactionContext>> QueryHandler::execute_pipeline(
     const std::string& query, const SendExecutionInfo send_execution_info,
-    const std::shared_ptr<TransactionContext>& transaction_context) {
+    const std::shared_ptr<TransactionContext>& transaction_context,
+    const std::shared_ptr<CancellationToken>& cancellation_token) {
   // A simple query command invalidates unnamed statements
   // See: https://postgresql.org/docs/12/protocol-flow.html#PROTOCOL-FLOW-EXT-QUERY
   if (Hyrise::get().storage_manager.has_prepared_plan("")) Hyrise::get().storage_manager.drop_prepared_plan("");
@@ -17,7 +26,9 @@ std::pair<ExecutionInformation, std::shared_ptr<TransactionContext>> QueryHandle
               "Auto-commit transaction contexts should not be passed around this far");
 
   auto execution_info = ExecutionInformation();
-  auto sql_pipeline = SQLPipelineBuilder{query}.with_transaction_context(transaction_context).create_pipeline();
+  auto sql_pipeline_builder = SQLPipelineBuilder{query}.with_transaction_context(transaction_context);
+  if (cancellation_token) sql_pipeline_builder.with_cancellation_token(cancellation_token);
+  auto sql_pipeline = sql_pipeline_builder.create_pipeline();
 
   const auto [pipeline_status, result_table] = sql_pipeline.get_result_table();
 
@@ -33,12 +44,22 @@ std::pair<ExecutionInformation, std::shared_ptr<TransactionContext>> QueryHandle
       execution_info.pipeline_metrics = stream.str();
     }
   } else if (pipeline_status == SQLPipelineStatus::Failure) {
-    const std::string failed_statement = sql_pipeline.failed_pipeline_statement()->get_sql_string();
-    execution_info.error_message = {{PostgresMessageType::HumanReadableError,
-                                     "Transaction conflict, transaction was rolled back. Following statements might "
-                                     "have still been sent and executed. Failed statement: " +
-                                         failed_statement},
-                                    {PostgresMessageType::SqlstateCodeError, TRANSACTION_CONFLICT}};
+    const auto& failed_pipeline_statement = sql_pipeline.failed_pipeline_statement();
+    const std::string failed_statement = failed_pipeline_statement->get_sql_string();
+    const auto& statement_cancellation_token = failed_pipeline_statement->cancellation_token();
+    if (statement_cancellation_token && statement_cancellation_token->is_cancelled()) {
+      execution_info.error_message = {
+          {PostgresMessageType::HumanReadableError,
+           CancellationToken::reason_message(*statement_cancellation_token->reason()) +
+               ", transaction was rolled back. Failed statement: " + failed_statement},
+          {PostgresMessageType::SqlstateCodeError, QUERY_CANCELED}};
+    } else {
+      execution_info.error_message = {{PostgresMessageType::HumanReadableError,
+                                       "Transaction conflict, transaction was rolled back. Following statements might "
+                                       "have still been sent and executed. Failed statement: " +
+                                           failed_statement},
+                                      {PostgresMessageType::SqlstateCodeError, TRANSACTION_CONFLICT}};
+    }
   }
   return {execution_info, sql_pipeline.transaction_context()};
 }
@@ -69,20 +90,41 @@ void QueryHandler::setup_prepared_plan(const std::string& statement_name, const
   Hyrise::get().storage_manager.add_prepared_plan(statement_name, prepared_plan);
 }
 
-std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const PreparedStatementDetails& statement_details) {
+std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const PreparedStatementDetails& statement_details,
+                                                                  PreparedPQPCache& prepared_pqps) {
   AssertInput(Hyrise::get().storage_manager.has_prepared_plan(statement_details.statement_name),
               "The specified statement does not exist.");
 
   const auto prepared_plan = Hyrise::get().storage_manager.get_prepared_plan(statement_details.statement_name);
+  const auto& parameter_ids = prepared_plan->parameter_ids;
+  AssertInput(statement_details.parameters.size() == parameter_ids.size(),
+              "Incorrect number of parameters supplied - expected " + std::to_string(parameter_ids.size()) + " got " +
+                  std::to_string(statement_details.parameters.size()));
+
+  auto prepared_pqp_iter = prepared_pqps.find(statement_details.statement_name);
+  if (prepared_pqp_iter == prepared_pqps.end() || prepared_pqp_iter->second.prepared_plan != prepared_plan) {
+    // Parameters are transmitted in text format, so the placeholders are translated as string parameters
+    auto placeholder_expressions = std::vector<std::shared_ptr<AbstractExpression>>{parameter_ids.size()};
+    for (auto parameter_idx = size_t{0}; parameter_idx < parameter_ids.size(); ++parameter_idx) {
+      placeholder_expressions[parameter_idx] = std::make_shared<CorrelatedParameterExpression>(
+          parameter_ids[parameter_idx],
+          CorrelatedParameterExpression::ReferencedExpressionInfo{DataType::String, "?"});
+    }
 
-  auto parameter_expressions = std::vector<std::shared_ptr<AbstractExpression>>{statement_details.parameters.size()};
-  for (auto parameter_idx = size_t{0}; parameter_idx < statement_details.parameters.size(); ++parameter_idx) {
-    parameter_expressions[parameter_idx] =
-        std::make_shared<ValueExpression>(statement_details.parameters[parameter_idx]);
+    const auto pqp_template = LQPTranslator{}.translate_node(prepared_plan->instantiate(placeholder_expressions));
+    prepared_pqp_iter =
+        prepared_pqps.insert_or_assign(statement_details.statement_name, PreparedPQP{prepared_plan, pqp_template})
+            .first;
   }
 
-  const auto lqp = prepared_plan->instantiate(parameter_expressions);
-  return LQPTranslator{}.translate_node(lqp);
+  auto parameters = std::unordered_map<ParameterID, AllTypeVariant>{};
+  for (auto parameter_idx = size_t{0}; parameter_idx < parameter_ids.size(); ++parameter_idx) {
+    parameters.emplace(parameter_ids[parameter_idx], statement_details.parameters[parameter_idx]);
+  }
+
+  const auto pqp = prepared_pqp_iter->second.pqp_template->deep_copy();
+  pqp->set_parameters(parameters);
+  return pqp;
 }
 
 std::shared_ptr<const Table> QueryHandler::execute_prepared_plan(
@@ -92,6 +134,119 @@ std::shared_ptr<const Table> QueryHandler::execute_prepared_plan(
   return tasks.back()->get_operator()->get_output();
 }
 
+std::optional<CopyFromStdinInformation> QueryHandler::parse_copy_from_stdin_statement(const std::string& query) {
+  // Cheap check first, as every simple query passes through here
+  if (!boost::algorithm::istarts_with(boost::algorithm::trim_left_copy(query), "copy")) return std::nullopt;
+
+  static const auto copy_regex =
+      std::regex{R"(^\s*COPY\s+(\w+)\s+FROM\s+STDIN\b\s*(?:WITH\b)?\s*(.*?)\s*;?\s*$)", std::regex::icase};
+  auto match = std::smatch{};
+  if (!std::regex_match(query, match, copy_regex)) return std::nullopt;
+
+  // Both the option list (e.g., `(FORMAT csv, HEADER)`) and the legacy syntax (e.g., `CSV HEADER`) are split into
+  // words and quoted strings
+  static const auto token_regex = std::regex{R"('(?:[^']|'')*'|[^\s,()']+)"};
+  const auto options = match[2].str();
+  auto tokens = std::vector<std::string>{};
+  for (auto token_iter = std::sregex_iterator{options.cbegin(), options.cend(), token_regex};
+       token_iter != std::sregex_iterator{}; ++token_iter) {
+    auto token = token_iter->str();
+    if (token.front() == '\'') {
+      token = token.substr(1, token.size() - 2);
+      boost::algorithm::replace_all(token, "''", "'");
+    } else {
+      boost::algorithm::to_lower(token);
+      if (token == "as") continue;
+    }
+    tokens.emplace_back(std::move(token));
+  }
+
+  auto copy_information = CopyFromStdinInformation{};
+  copy_information.table_name = match[1].str();
+
+  auto csv_format = false;
+  auto delimiter = std::optional<char>{};
+  auto quote = std::optional<char>{};
+  auto escape = std::optional<char>{};
+
+  const auto character_option = [&](auto& token_iter, const std::string& option) {
+    AssertInput(token_iter + 1 != tokens.end() && (token_iter + 1)->size() == 1,
+                "COPY option " + option + " requires a single character");
+    return (*++token_iter)[0];
+  };
+
+  for (auto token_iter = tokens.begin(); token_iter != tokens.end(); ++token_iter) {
+    const auto& option = *token_iter;
+    if (option == "format") {
+      AssertInput(token_iter + 1 != tokens.end(), "COPY option FORMAT requires a value");
+      const auto format = boost::algorithm::to_lower_copy(*++token_iter);
+      AssertInput(format != "binary", "The binary COPY format is not supported yet");
+      AssertInput(format == "text" || format == "csv", "Unknown COPY format " + format);
+      csv_format = format == "csv";
+    } else if (option == "csv") {
+      csv_format = true;
+    } else if (option == "header") {
+      copy_information.header = true;
+      if (token_iter + 1 != tokens.end()) {
+        const auto value = boost::algorithm::to_lower_copy(*(token_iter + 1));
+        if (value == "true" || value == "on" || value == "1") {
+          ++token_iter;
+        } else if (value == "false" || value == "off" || value == "0") {
+          copy_information.header = false;
+          ++token_iter;
+        }
+      }
+    } else if (option == "delimiter") {
+      delimiter = character_option(token_iter, "DELIMITER");
+    } else if (option == "quote") {
+      quote = character_option(token_iter, "QUOTE");
+    } else if (option == "escape") {
+      escape = character_option(token_iter, "ESCAPE");
+    } else {
+      FailInput("Unsupported COPY option " + option);
+    }
+  }
+
+  auto& config = copy_information.parse_config;
+  if (csv_format) {
+    // Unlike in CSV files of Hyrise, quoted numbers and unquoted "null" strings are plain values in PostgreSQL's CSV
+    config.separator = delimiter.value_or(',');
+    config.quote = quote.value_or('"');
+    config.escape = escape.value_or(config.quote);
+    config.reject_quoted_nonstrings = false;
+    config.null_handling = NullHandling::NullStringAsValue;
+  } else {
+    AssertInput(!quote && !escape, "QUOTE and ESCAPE are only available in the CSV format");
+    config.separator = delimiter.value_or('\t');
+    config.postgres_text_format = true;
+  }
+  AssertInput(config.separator != config.delimiter, "The COPY delimiter cannot be a newline");
+
+  return copy_information;
+}
+
+uint64_t QueryHandler::copy_rows_into_table(std::string_view content,
+                                            const CopyFromStdinInformation& copy_information,
+                                            const std::shared_ptr<TransactionContext>& transaction_context) {
+  const auto target_table = Hyrise::get().storage_manager.get_table(copy_information.table_name);
+  const auto rows = std::make_shared<Table>(target_table->column_definitions(), TableType::Data,
+                                            target_table->target_chunk_size(), UseMvcc::No);
+
+  auto csv_meta = CsvMeta{};
+  csv_meta.config = copy_information.parse_config;
+  const auto row_count = CsvParser::parse_into_table(content, *rows, csv_meta);
+  if (row_count == 0) return 0;
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(rows);
+  table_wrapper->execute();
+
+  const auto insert = std::make_shared<Insert>(copy_information.table_name, table_wrapper);
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+
+  return row_count;
+}
+
 void QueryHandler::_handle_transaction_statement_message(ExecutionInformation& execution_info,
                                                          SQLPipeline& sql_pipeline) {
   // handle custom user feedback (command complete messages) for transaction statements
@@ -121,4 +276,30 @@ void QueryHandler::_handle_transaction_statement_message(ExecutionInformation& e
     }
   }
 }
+std::optional<WorkloadClassSetting> QueryHandler::parse_workload_class_statement(const std::string& query) {
+  if (!boost::algorithm::istarts_with(boost::algorithm::trim_left_copy(query), "set")) return std::nullopt;
+
+  static const auto set_regex =
+      std::regex{R"(^\s*SET\s+(?:SESSION\s+)?workload_class\s*(?:TO|=)\s*'?(\w+)'?\s*;?\s*$)", std::regex::icase};
+  auto match = std::smatch{};
+  if (!std::regex_match(query, match, set_regex)) return std::nullopt;
+
+  const auto value = boost::algorithm::to_lower_copy(match[1].str());
+  if (value == "transactional") return WorkloadClassSetting{WorkloadClass::Transactional};
+  if (value == "analytical") return WorkloadClassSetting{WorkloadClass::Analytical};
+  AssertInput(value == "default", "Unknown workload class '" + value + "'. Use transactional, analytical, or default.");
+  return WorkloadClassSetting{std::nullopt};
+}
+
+WorkloadClass QueryHandler::classify_statement(const std::string& query, const bool in_transaction_block) {
+  if (in_transaction_block) return WorkloadClass::Transactional;
+
+  const auto statement = boost::algorithm::trim_left_copy_if(query, boost::algorithm::is_space() ||
+                                                                         boost::algorithm::is_any_of("("));
+  if (boost::algorithm::istarts_with(statement, "select") || boost::algorithm::istarts_with(statement, "with")) {
+    return WorkloadClass::Analytical;
+  }
+  return WorkloadClass::Transactional;
+}
+
 }  // namespace opossum
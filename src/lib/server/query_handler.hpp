@@ -1,10 +1,15 @@
 #pragma once
 
+#include <unordered_map>
 #include <variant>
+
 #include "hyrise.hpp"
+#include "import_export/csv/csv_meta.hpp"
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
+#include "server_types.hpp"
 #include "sql/sql_pipeline.hpp"
+#include "storage/prepared_plan.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -20,20 +25,69 @@ struct ExecutionInformation {
   std::optional<std::string> custom_command_complete_message;
 };
 
+// A prepared statement that has been translated into a PQP. The placeholders of the PQP template are
+// CorrelatedParameterExpressions, so that binding parameters only copies the template and sets their values. The
+// PreparedPlan is kept to notice when the statement was redefined.
+struct PreparedPQP {
+  std::shared_ptr<PreparedPlan> prepared_plan;
+  std::shared_ptr<AbstractOperator> pqp_template;
+};
+
+// Per-session cache of translated prepared statements, keyed by statement name
+using PreparedPQPCache = std::unordered_map<std::string, PreparedPQP>;
+
+// Target and format of a `COPY <table> FROM STDIN` statement. The SQL parser does not support these statements, so the
+// QueryHandler recognizes them before a simple query is passed to the SQLPipeline.
+struct CopyFromStdinInformation {
+  std::string table_name;
+  ParseConfig parse_config;
+  bool header = false;
+};
+
+// Value of a `SET workload_class TO ...` statement, which the SQL parser does not support either. std::nullopt (for
+// `SET workload_class TO DEFAULT`) lets the statement type determine the workload class again.
+struct WorkloadClassSetting {
+  std::optional<WorkloadClass> workload_class;
+};
+
 // This class manages the interaction between the server and the database component. Furthermore, most of the SQL-based
 // error handling happens in this class.
 class QueryHandler {
  public:
+  // Executes @param query. Once @param cancellation_token is cancelled, the execution stops and the transaction is
+  // rolled back. Without a token, the query is only cancelled after the statement timeout.
   static std::pair<ExecutionInformation, std::shared_ptr<TransactionContext>> execute_pipeline(
       const std::string& query, const SendExecutionInfo send_execution_info,
-      const std::shared_ptr<TransactionContext>& transaction_context);
+      const std::shared_ptr<TransactionContext>& transaction_context,
+      const std::shared_ptr<CancellationToken>& cancellation_token = nullptr);
 
   static void setup_prepared_plan(const std::string& statement_name, const std::string& query);
 
-  static std::shared_ptr<AbstractOperator> bind_prepared_plan(const PreparedStatementDetails& statement_details);
+  // Returns a PQP for the prepared statement with the parameters of @param statement_details filled in. The statement
+  // is translated only on its first Bind (or after it was redefined) and cached in @param prepared_pqps. The LQP is
+  // not optimized so that binding stays cheap for point queries.
+  static std::shared_ptr<AbstractOperator> bind_prepared_plan(const PreparedStatementDetails& statement_details,
+                                                              PreparedPQPCache& prepared_pqps);
 
   static std::shared_ptr<const Table> execute_prepared_plan(const std::shared_ptr<AbstractOperator>& physical_plan);
 
+  // Returns the information of @param query if it is a COPY FROM STDIN statement, std::nullopt otherwise. Supports the
+  // text and the CSV format with the options FORMAT, DELIMITER, HEADER, QUOTE, and ESCAPE.
+  static std::optional<CopyFromStdinInformation> parse_copy_from_stdin_statement(const std::string& query);
+
+  // Parses the complete rows in @param content in parallel and inserts them into the target table of the COPY
+  // statement within @param transaction_context. Returns the number of inserted rows.
+  static uint64_t copy_rows_into_table(std::string_view content, const CopyFromStdinInformation& copy_information,
+                                       const std::shared_ptr<TransactionContext>& transaction_context);
+
+  // Returns the setting of @param query if it is a `SET [SESSION] workload_class {TO | =} value` statement, where value
+  // is transactional, analytical, or default. Returns std::nullopt for all other queries.
+  static std::optional<WorkloadClassSetting> parse_workload_class_statement(const std::string& query);
+
+  // Returns the workload class of a simple query for sessions that did not set one. Read-only queries (SELECT and
+  // WITH) outside of transaction blocks are analytical, everything else is transactional.
+  static WorkloadClass classify_statement(const std::string& query, const bool in_transaction_block);
+
  private:
   static void _handle_transaction_statement_message(ExecutionInformation& execution_info, SQLPipeline& sql_pipeline);
 };
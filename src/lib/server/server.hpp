@@ -3,8 +3,10 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
+#include "admission_control.hpp"
 #include "server_types.hpp"
 #include "session.hpp"
+#include "session_registry.hpp"
 
 namespace opossum {
 
@@ -13,6 +15,8 @@ namespace opossum {
 *  Server - Opens and binds a server socket. Starts a new session per client.
 *  Session - Creates a data socket for client server communication. It is responsible for the message flow and holds
 *            session-specific data.
+*  AdmissionControl - Limits the number of concurrently executed statements per workload class. Shared by all sessions.
+*  SessionRegistry - Cancels the statements of sessions on CancelRequests and client disconnects.
 *  PostgresProtocolHandler - This class operates on the message level. It serializes and de-serializes information from
 *                            messages.
 *  PostgresMessageTypes - Set of different message types supported by Hyrise.
@@ -55,6 +59,8 @@ class Server {
   boost::asio::io_service _io_service;
   boost::asio::ip::tcp::acceptor _acceptor;
   const SendExecutionInfo _send_execution_info;
+  AdmissionControl _admission_control;
+  SessionRegistry _session_registry;
   std::atomic_bool _is_initialized{false};
 };
 }  // namespace opossum
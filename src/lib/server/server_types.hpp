@@ -10,4 +10,9 @@ enum class HasNullTerminator : bool { Yes = true, No = false };
 
 enum class SendExecutionInfo : bool { Yes = true, No = false };
 
+// Statements are assigned to workload classes, either by the session setting `workload_class` or by their type. Each
+// class has its own concurrency limit in the AdmissionControl and is scheduled with its own SchedulePriority, so that
+// long-running analytical statements do not starve short transactions.
+enum class WorkloadClass { Transactional, Analytical };
+
 }  // namespace opossum
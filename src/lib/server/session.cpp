@@ -1,19 +1,53 @@
 #include "session.hpp"
 
+#include <sys/socket.h>
+
+#include <cerrno>
+
+#include <boost/algorithm/string.hpp>
+
 #include "client_disconnect_exception.hpp"
+#include "import_export/csv/csv_parser.hpp"
 #include "postgres_message_type.hpp"
 #include "query_handler.hpp"
 #include "result_serializer.hpp"
+#include "scheduler/schedule_priority_scope.hpp"
 
 namespace opossum {
 
-Session::Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info)
+Session::Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info,
+                 AdmissionControl& admission_control, SessionRegistry& session_registry)
     : _socket(std::make_shared<Socket>(io_service)),
       _postgres_protocol_handler(std::make_shared<PostgresProtocolHandler<Socket>>(_socket)),
-      _send_execution_info(send_execution_info) {}
+      _send_execution_info(send_execution_info),
+      _admission_control(admission_control),
+      _session_registry(session_registry) {}
+
+Session::~Session() {
+  if (_backend_key_data) _session_registry.unregister_session(*_backend_key_data);
+}
 
 std::shared_ptr<Socket> Session::socket() { return _socket; }
 
+void Session::cancel_statement(const CancellationReason reason) {
+  const auto lock = std::lock_guard{_statement_mutex};
+  if (_statement_cancellation_token) _statement_cancellation_token->cancel(reason);
+}
+
+void Session::cancel_statement_if_client_disconnected() {
+  const auto lock = std::lock_guard{_statement_mutex};
+  if (!_statement_cancellation_token || _statement_cancellation_token->is_cancelled()) return;
+
+  // The session thread does not read from the socket while a statement is executed. Peeking without blocking returns
+  // 0 once the client closed the connection. Data that a client sent before disconnecting hides the disconnect, but is
+  // not expected while the client waits for the result.
+  auto buffer = char{};
+  const auto received_bytes = recv(_socket->native_handle(), &buffer, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (received_bytes == 0 || (received_bytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+    _statement_cancellation_token->cancel(CancellationReason::ClientDisconnect);
+  }
+}
+
 void Session::run() {
   // Set TCP_NODELAY in order to disable Nagle's algorithm. It handles congestion control in TCP networks. Therefore,
   // small packets are buffered and sent out later as one large packet. This might introduce a delay of up to 40 ms
@@ -41,15 +75,24 @@ void Session::run() {
 }
 
 void Session::_establish_connection() {
-  const auto body_length = _postgres_protocol_handler->read_startup_packet_header();
+  const auto startup_packet_header = _postgres_protocol_handler->read_startup_packet_header();
+
+  // Clients send CancelRequests on a new connection, which they close without waiting for a response
+  if (startup_packet_header.is_cancel_request) {
+    _session_registry.cancel_statement(_postgres_protocol_handler->read_cancel_request_body());
+    _terminate_session = true;
+    return;
+  }
 
   // Currently, the information available in the start up packet body (such as db name, user name) is ignored
-  _postgres_protocol_handler->read_startup_packet_body(body_length);
+  _postgres_protocol_handler->read_startup_packet_body(startup_packet_header.body_length);
   _postgres_protocol_handler->send_authentication_response();
   _postgres_protocol_handler->send_parameter("server_version", "12");
   _postgres_protocol_handler->send_parameter("server_encoding", "UTF8");
   _postgres_protocol_handler->send_parameter("client_encoding", "UTF8");
   _postgres_protocol_handler->send_parameter("DateStyle", "ISO, DMY");
+  _backend_key_data = _session_registry.register_session(*this);
+  _postgres_protocol_handler->send_backend_key_data(*_backend_key_data);
   _postgres_protocol_handler->send_ready_for_query();
 }
 
@@ -94,6 +137,13 @@ void Session::_handle_request() {
       _handle_execute();
       break;
     }
+    case PostgresMessageType::CopyData:
+    case PostgresMessageType::CopyDone:
+    case PostgresMessageType::CopyFail: {
+      // After an error during COPY FROM STDIN, the remaining messages of the client are dropped
+      _postgres_protocol_handler->read_copy_data_packet();
+      break;
+    }
     default:
       Fail("Unknown packet type");
   }
@@ -105,10 +155,30 @@ void Session::_handle_simple_query() {
   // A simple query command invalidates unnamed portals
   _portals.erase("");
 
+  if (const auto workload_class_setting = QueryHandler::parse_workload_class_statement(query)) {
+    _workload_class = workload_class_setting->workload_class;
+    _postgres_protocol_handler->send_command_complete("SET");
+    _postgres_protocol_handler->send_ready_for_query();
+    return;
+  }
+
+  if (const auto copy_information = QueryHandler::parse_copy_from_stdin_statement(query)) {
+    _handle_copy_from_stdin(*copy_information);
+    return;
+  }
+
   ExecutionInformation execution_information;
 
-  std::tie(execution_information, _transaction_context) =
-      QueryHandler::execute_pipeline(query, _send_execution_info, _transaction_context);
+  {
+    // The tasks of the statement inherit the priority of its workload class from the scope
+    const auto workload_class =
+        _workload_class_or(QueryHandler::classify_statement(query, static_cast<bool>(_transaction_context)));
+    const auto admission = AdmissionControl::Admission{_admission_control, workload_class};
+    const auto schedule_priority_scope = SchedulePriorityScope{AdmissionControl::schedule_priority(workload_class)};
+    const auto statement_scope = StatementScope{*this};
+    std::tie(execution_information, _transaction_context) = QueryHandler::execute_pipeline(
+        query, _send_execution_info, _transaction_context, statement_scope.cancellation_token);
+  }
 
   if (!execution_information.error_message.empty()) {
     _postgres_protocol_handler->send_error_message(execution_information.error_message);
@@ -131,6 +201,108 @@ void Session::_handle_simple_query() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
+void Session::_handle_copy_from_stdin(const CopyFromStdinInformation& copy_information) {
+  auto& storage_manager = Hyrise::get().storage_manager;
+  AssertInput(storage_manager.has_table(copy_information.table_name),
+              "Table " + copy_information.table_name + " does not exist.");
+  const auto column_count = storage_manager.get_table(copy_information.table_name)->column_count();
+
+  // Outside of a transaction block, all rows are loaded within a single transaction that commits after the last row
+  const auto transaction_context =
+      _transaction_context ? _transaction_context
+                           : Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  _postgres_protocol_handler->send_copy_in_response(static_cast<uint16_t>(column_count));
+
+  // The statement is cancelled between two batches. A disconnecting client is noticed when reading the next message.
+  auto statement_scope = std::optional<StatementScope>{};
+  statement_scope.emplace(*this);
+  const auto cancellation_token = statement_scope->cancellation_token;
+
+  // Each batch is admitted on its own, so that waiting for the CopyData messages of a slow client does not occupy a
+  // slot of the admission control
+  const auto workload_class = _workload_class_or(WorkloadClass::Transactional);
+
+  const auto& parse_config = copy_information.parse_config;
+  auto content = std::string{};
+  auto skip_header = copy_information.header;
+  auto row_count = uint64_t{0};
+
+  // Loads the complete rows received so far. The rest is kept until the next CopyData message arrives.
+  const auto load_rows = [&](const bool copy_done) {
+    if (copy_done) {
+      // Older clients terminate the text format with an end-of-data marker
+      if (parse_config.postgres_text_format && boost::algorithm::ends_with(content, "\\.\n") &&
+          (content.size() == 3 || content[content.size() - 4] == '\n')) {
+        content.resize(content.size() - 3);
+      }
+      if (!content.empty() && content.back() != parse_config.delimiter) content.push_back(parse_config.delimiter);
+    }
+
+    const auto rows_length = copy_done ? content.size() : CsvParser::complete_rows_length(content, parse_config);
+    auto rows = std::string_view{content}.substr(0, rows_length);
+
+    if (skip_header) {
+      const auto header_end = rows.find(parse_config.delimiter);
+      if (header_end == std::string_view::npos) return;
+      rows.remove_prefix(header_end + 1);
+      skip_header = false;
+    }
+
+    AssertInput(!cancellation_token->is_cancelled(),
+                CancellationToken::reason_message(*cancellation_token->reason()));
+    const auto admission = AdmissionControl::Admission{_admission_control, workload_class};
+    const auto schedule_priority_scope = SchedulePriorityScope{AdmissionControl::schedule_priority(workload_class)};
+    row_count += QueryHandler::copy_rows_into_table(rows, copy_information, transaction_context);
+    content.erase(0, rows_length);
+  };
+
+  try {
+    auto copy_done = false;
+    while (!copy_done) {
+      switch (_postgres_protocol_handler->read_packet_type()) {
+        case PostgresMessageType::CopyData: {
+          content += _postgres_protocol_handler->read_copy_data_packet();
+          if (content.size() >= COPY_BATCH_SIZE) load_rows(false);
+          break;
+        }
+        case PostgresMessageType::CopyDone: {
+          _postgres_protocol_handler->read_copy_done_packet();
+          copy_done = true;
+          break;
+        }
+        case PostgresMessageType::CopyFail: {
+          FailInput("COPY from stdin failed: " + _postgres_protocol_handler->read_copy_fail_packet());
+        }
+        case PostgresMessageType::FlushCommand:
+        case PostgresMessageType::SyncCommand: {
+          // Both are ignored during COPY, but might be sent by clients using the extended query protocol
+          _postgres_protocol_handler->read_sync_packet();
+          break;
+        }
+        default:
+          Fail("Unexpected packet type during COPY FROM STDIN");
+      }
+    }
+
+    load_rows(true);
+  } catch (const std::exception&) {
+    statement_scope.reset();
+    if (transaction_context->phase() == TransactionPhase::Active) {
+      transaction_context->rollback(RollbackReason::User);
+    }
+    _transaction_context.reset();
+    throw;
+  }
+
+  statement_scope.reset();
+
+  if (!_transaction_context) transaction_context->commit();
+
+  _postgres_protocol_handler->send_command_complete("COPY " + std::to_string(row_count));
+  _postgres_protocol_handler->send_ready_for_query();
+}
+
 void Session::_handle_parse_command() {
   const auto [statement_name, query] = _postgres_protocol_handler->read_parse_packet();
   QueryHandler::setup_prepared_plan(statement_name, query);
@@ -157,7 +329,7 @@ void Session::_handle_bind_command() {
   // this nullptr gets replaced by the correct pqp. Before executing the prepared statement we make a check for errors.
   _portals.emplace(parameters.portal, nullptr);
 
-  const auto pqp = QueryHandler::bind_prepared_plan(parameters);
+  const auto pqp = QueryHandler::bind_prepared_plan(parameters, _prepared_pqps);
 
   _portals[parameters.portal] = pqp;
   _postgres_protocol_handler->send_status_message(PostgresMessageType::BindComplete);
@@ -174,6 +346,34 @@ void Session::_sync() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
+WorkloadClass Session::_workload_class_or(const WorkloadClass statement_workload_class) const {
+  return _workload_class ? *_workload_class : statement_workload_class;
+}
+
+Session::StatementScope::StatementScope(Session& session)
+    : cancellation_token(CancellationToken::create_from_settings()), _session(session) {
+  const auto lock = std::lock_guard{_session._statement_mutex};
+  _session._statement_cancellation_token = cancellation_token;
+}
+
+Session::StatementScope::~StatementScope() {
+  const auto lock = std::lock_guard{_session._statement_mutex};
+  _session._statement_cancellation_token = nullptr;
+}
+
+void Session::_send_cancellation_error(const CancellationToken& cancellation_token) {
+  const auto error_message =
+      ErrorMessage{{PostgresMessageType::HumanReadableError,
+                    CancellationToken::reason_message(*cancellation_token.reason()) + ", transaction was rolled back"},
+                   {PostgresMessageType::SqlstateCodeError, QUERY_CANCELED}};
+  _postgres_protocol_handler->send_error_message(error_message);
+
+  // As after other errors in the extended query protocol (see run()), the following Sync does not send another
+  // ReadyForQuery
+  _postgres_protocol_handler->send_ready_for_query();
+  _sync_send_after_error = true;
+}
+
 void Session::_handle_execute() {
   const std::string& portal_name = _postgres_protocol_handler->read_execute_packet();
 
@@ -196,7 +396,29 @@ void Session::_handle_execute() {
   }
   physical_plan->set_transaction_context_recursively(_transaction_context);
 
-  const auto result_table = QueryHandler::execute_prepared_plan(physical_plan);
+  // Prepared statements are mostly the short statements of transactional workloads
+  auto result_table = std::shared_ptr<const Table>{};
+  auto cancellation_token = std::shared_ptr<CancellationToken>{};
+  {
+    // As for simple queries, the statement timeout starts once the statement is admitted
+    const auto workload_class = _workload_class_or(WorkloadClass::Transactional);
+    const auto admission = AdmissionControl::Admission{_admission_control, workload_class};
+    const auto schedule_priority_scope = SchedulePriorityScope{AdmissionControl::schedule_priority(workload_class)};
+    const auto statement_scope = StatementScope{*this};
+    cancellation_token = statement_scope.cancellation_token;
+    // The OperatorTasks take the token from the scope
+    const auto cancellation_token_scope = CancellationTokenScope{cancellation_token};
+    result_table = QueryHandler::execute_prepared_plan(physical_plan);
+  }
+
+  if (cancellation_token->is_cancelled()) {
+    if (_transaction_context->phase() == TransactionPhase::Active) {
+      _transaction_context->rollback(RollbackReason::Conflict);
+    }
+    _transaction_context.reset();
+    _send_cancellation_error(*cancellation_token);
+    return;
+  }
 
   uint64_t row_count = 0;
   // If there is no result table, e.g. after an INSERT command, we cannot send row data
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <mutex>
+
+#include "admission_control.hpp"
+#include "concurrency/cancellation_token.hpp"
 #include "concurrency/transaction_context.hpp"
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
+#include "query_handler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "session_registry.hpp"
 
 namespace opossum {
 
@@ -14,13 +20,19 @@ namespace opossum {
 // Example usage can be found here: https://stackoverflow.com/questions/52479293/postgresql-refcursor-and-portal-name
 class Session {
  public:
-  explicit Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info);
+  Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info,
+          AdmissionControl& admission_control, SessionRegistry& session_registry);
+  ~Session();
 
   // Start new session.
   void run();
 
   std::shared_ptr<Socket> socket();
 
+  // Cancel the running statement, if any. Both are called by the SessionRegistry from other threads.
+  void cancel_statement(const CancellationReason reason);
+  void cancel_statement_if_client_disconnected();
+
  private:
   // Establish new connection by exchanging parameters.
   void _establish_connection();
@@ -31,6 +43,9 @@ class Session {
   // Execute plain SQL statement.
   void _handle_simple_query();
 
+  // Receive the rows of a COPY FROM STDIN statement and load them in batches, each of which is admitted separately.
+  void _handle_copy_from_stdin(const CopyFromStdinInformation& copy_information);
+
   // Parse prepared statement.
   void _handle_parse_command();
 
@@ -46,6 +61,29 @@ class Session {
   // Commit current transaction.
   void _sync();
 
+  // Returns the workload class set for this session, or @param statement_workload_class if there is none.
+  WorkloadClass _workload_class_or(const WorkloadClass statement_workload_class) const;
+
+  // Holds the token of a running statement. The token expires after the statement timeout and can be cancelled
+  // through the SessionRegistry until the scope is destroyed.
+  class StatementScope : private Noncopyable {
+   public:
+    explicit StatementScope(Session& session);
+    ~StatementScope();
+
+    const std::shared_ptr<CancellationToken> cancellation_token;
+
+   private:
+    Session& _session;
+  };
+
+  // Sends the error of a cancelled statement, whose transaction has been rolled back
+  void _send_cancellation_error(const CancellationToken& cancellation_token);
+
+  // Received rows are parsed and inserted once this many bytes have arrived. A batch spans several chunks, which are
+  // parsed in parallel.
+  static constexpr auto COPY_BATCH_SIZE = size_t{64} * 1024 * 1024;
+
   const std::shared_ptr<Socket> _socket;
   const std::shared_ptr<PostgresProtocolHandler<Socket>> _postgres_protocol_handler;
   const SendExecutionInfo _send_execution_info;
@@ -53,5 +91,13 @@ class Session {
   bool _sync_send_after_error = false;
   std::shared_ptr<TransactionContext> _transaction_context;
   std::unordered_map<std::string, std::shared_ptr<AbstractOperator>> _portals;
+  PreparedPQPCache _prepared_pqps;
+  AdmissionControl& _admission_control;
+  std::optional<WorkloadClass> _workload_class;
+
+  SessionRegistry& _session_registry;
+  std::optional<BackendKeyData> _backend_key_data;
+  std::mutex _statement_mutex;
+  std::shared_ptr<CancellationToken> _statement_cancellation_token;
 };
 }  // namespace opossum
@@ -0,0 +1,54 @@
+#include "session_registry.hpp"
+
+#include "concurrency/cancellation_token.hpp"
+#include "session.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+SessionRegistry::SessionRegistry() : _disconnect_check_thread(&SessionRegistry::_check_for_disconnects, this) {}
+
+SessionRegistry::~SessionRegistry() {
+  {
+    const auto lock = std::lock_guard{_mutex};
+    _shutdown = true;
+  }
+  _shutdown_condition_variable.notify_all();
+  _disconnect_check_thread.join();
+}
+
+BackendKeyData SessionRegistry::register_session(Session& session) {
+  const auto lock = std::lock_guard{_mutex};
+  const auto process_id = _next_process_id++;
+  const auto secret_key = std::uniform_int_distribution<int32_t>{}(_random_engine);
+  _sessions.emplace(process_id, RegisteredSession{secret_key, &session});
+  return {process_id, secret_key};
+}
+
+void SessionRegistry::unregister_session(const BackendKeyData& backend_key_data) {
+  const auto lock = std::lock_guard{_mutex};
+  const auto erased_count = _sessions.erase(backend_key_data.process_id);
+  DebugAssert(erased_count == 1, "Session was not registered");
+}
+
+bool SessionRegistry::cancel_statement(const BackendKeyData& backend_key_data) {
+  // The session cannot unregister (and be destroyed) while the lock is held
+  const auto lock = std::lock_guard{_mutex};
+  const auto session_iter = _sessions.find(backend_key_data.process_id);
+  if (session_iter == _sessions.end() || session_iter->second.secret_key != backend_key_data.secret_key) return false;
+
+  session_iter->second.session->cancel_statement(CancellationReason::User);
+  return true;
+}
+
+void SessionRegistry::_check_for_disconnects() {
+  auto lock = std::unique_lock{_mutex};
+  while (!_shutdown) {
+    for (const auto& [_, registered_session] : _sessions) {
+      registered_session.session->cancel_statement_if_client_disconnected();
+    }
+    _shutdown_condition_variable.wait_for(lock, DISCONNECT_CHECK_INTERVAL, [&]() { return _shutdown; });
+  }
+}
+
+}  // namespace opossum
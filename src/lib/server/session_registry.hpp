@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#include "postgres_protocol_handler.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Session;
+
+// Keeps track of the running sessions of a Server. PostgreSQL clients cancel a statement by sending a CancelRequest on
+// a separate connection, which carries the BackendKeyData of the session to cancel. Furthermore, a background thread
+// periodically cancels the statements of sessions whose client disconnected, as the session threads do not read from
+// their sockets while a statement is executed.
+class SessionRegistry : private Noncopyable {
+ public:
+  SessionRegistry();
+  ~SessionRegistry();
+
+  // Returns the key that the client of @param session uses to cancel its statements
+  BackendKeyData register_session(Session& session);
+  void unregister_session(const BackendKeyData& backend_key_data);
+
+  // Cancels the running statement of the session identified by @param backend_key_data. Returns false if there is no
+  // such session, e.g., because the secret key does not match.
+  bool cancel_statement(const BackendKeyData& backend_key_data);
+
+  static constexpr auto DISCONNECT_CHECK_INTERVAL = std::chrono::milliseconds{100};
+
+ private:
+  void _check_for_disconnects();
+
+  struct RegisteredSession {
+    int32_t secret_key;
+    Session* session;
+  };
+
+  std::mutex _mutex;
+  std::unordered_map<int32_t, RegisteredSession> _sessions;
+  int32_t _next_process_id{1};
+  std::mt19937 _random_engine{std::random_device{}()};
+
+  std::condition_variable _shutdown_condition_variable;
+  bool _shutdown{false};
+  std::thread _disconnect_check_thread;
+};
+
+}  // namespace opossum
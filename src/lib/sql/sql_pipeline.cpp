@@ -16,7 +16,10 @@
 namespace opossum {
 
 SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<TransactionContext>& transaction_context,
-                         const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
+                         const UseMvcc use_mvcc, const UseQueryArena use_query_arena,
+                         const TransactionMode transaction_mode,
+                         const std::shared_ptr<CancellationToken>& cancellation_token,
+                         const std::shared_ptr<Optimizer>& optimizer,
                          const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
                          const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache)
     : pqp_cache(init_pqp_cache),
@@ -34,7 +37,8 @@ SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<Transacti
   hsql::SQLParserResult parse_result;
 
   const auto start = std::chrono::high_resolution_clock::now();
-  hsql::SQLParser::parse(sql, &parse_result);
+  const auto masked_sql = SQLPipelineStatement::mask_read_only_modifiers(sql);
+  hsql::SQLParser::parse(masked_sql ? *masked_sql : sql, &parse_result);
 
   const auto done = std::chrono::high_resolution_clock::now();
   _metrics.parse_time_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(done - start);
@@ -82,8 +86,9 @@ SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<Transacti
     const auto statement_string = boost::trim_copy(sql.substr(sql_string_offset, statement_string_length));
     sql_string_offset += statement_string_length;
 
-    auto pipeline_statement = std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement),
-                                                                     use_mvcc, optimizer, pqp_cache, lqp_cache);
+    auto pipeline_statement =
+        std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement), use_mvcc, use_query_arena,
+                                               transaction_mode, cancellation_token, optimizer, pqp_cache, lqp_cache);
     _sql_pipeline_statements.push_back(std::move(pipeline_statement));
   }
 
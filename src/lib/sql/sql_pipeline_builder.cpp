@@ -35,12 +35,30 @@ SQLPipelineBuilder& SQLPipelineBuilder::with_lqp_cache(const std::shared_ptr<SQL
   return *this;
 }
 
+SQLPipelineBuilder& SQLPipelineBuilder::with_query_arena(const UseQueryArena use_query_arena) {
+  _use_query_arena = use_query_arena;
+  return *this;
+}
+
+SQLPipelineBuilder& SQLPipelineBuilder::with_transaction_mode(const TransactionMode transaction_mode) {
+  _transaction_mode = transaction_mode;
+  return *this;
+}
+
+SQLPipelineBuilder& SQLPipelineBuilder::with_cancellation_token(
+    const std::shared_ptr<CancellationToken>& cancellation_token) {
+  _cancellation_token = cancellation_token;
+  return *this;
+}
+
 SQLPipelineBuilder& SQLPipelineBuilder::disable_mvcc() { return with_mvcc(UseMvcc::No); }
 
 SQLPipeline SQLPipelineBuilder::create_pipeline() const {
   DTRACE_PROBE1(HYRISE, CREATE_PIPELINE, reinterpret_cast<uintptr_t>(this));
   auto optimizer = _optimizer ? _optimizer : Optimizer::create_default_optimizer();
-  auto pipeline = SQLPipeline(_sql, _transaction_context, _use_mvcc, optimizer, _pqp_cache, _lqp_cache);
+  auto cancellation_token = _cancellation_token ? _cancellation_token : CancellationToken::create_from_settings();
+  auto pipeline = SQLPipeline(_sql, _transaction_context, _use_mvcc, _use_query_arena, _transaction_mode,
+                              cancellation_token, optimizer, _pqp_cache, _lqp_cache);
   DTRACE_PROBE3(HYRISE, PIPELINE_CREATION_DONE, pipeline.get_sql_per_statement().size(), _sql.c_str(),
                 reinterpret_cast<uintptr_t>(this));
   return pipeline;
@@ -50,7 +68,17 @@ SQLPipelineStatement SQLPipelineBuilder::create_pipeline_statement(
     std::shared_ptr<hsql::SQLParserResult> parsed_sql) const {
   auto optimizer = _optimizer ? _optimizer : Optimizer::create_default_optimizer();
 
-  SQLPipelineStatement pipeline_statement{_sql, std::move(parsed_sql), _use_mvcc, optimizer, _pqp_cache, _lqp_cache};
+  auto cancellation_token = _cancellation_token ? _cancellation_token : CancellationToken::create_from_settings();
+
+  SQLPipelineStatement pipeline_statement{_sql,
+                                          std::move(parsed_sql),
+                                          _use_mvcc,
+                                          _use_query_arena,
+                                          _transaction_mode,
+                                          cancellation_token,
+                                          optimizer,
+                                          _pqp_cache,
+                                          _lqp_cache};
   pipeline_statement.set_transaction_context(_transaction_context);
 
   return pipeline_statement;
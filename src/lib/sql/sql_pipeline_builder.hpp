@@ -27,6 +27,9 @@ class Optimizer;
  *
  * Defaults:
  *  - MVCC is enabled
+ *  - Intermediate results are allocated using the default memory resource (i.e., no query arena)
+ *  - Transactions are created in read-write mode
+ *  - Statements are cancelled after the statement timeout from the settings (if any)
  *  - The default Optimizer (Optimizer::create_default_optimizer()) is used.
  *
  * Favour this interface over calling the SQLPipeline[Statement] constructors with their long parameter list.
@@ -43,6 +46,25 @@ class SQLPipelineBuilder final {
   SQLPipelineBuilder& with_pqp_cache(const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache);
   SQLPipelineBuilder& with_lqp_cache(const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache);
 
+  /**
+   * Allocate the intermediate results of each statement from a per-statement arena (see QueryMemoryResource) that is
+   * released at once when the result table is no longer used. Only applies to statements that do not modify data.
+   */
+  SQLPipelineBuilder& with_query_arena(const UseQueryArena use_query_arena);
+
+  /**
+   * Sets the mode of the transactions that the pipeline creates, i.e., of auto-commit transactions and of those started
+   * by BEGIN. Has no effect on a transaction context that is passed in. Read-only transactions fail on statements
+   * that modify data, but can skip large parts of the MVCC bookkeeping (see TransactionContext::is_read_only).
+   */
+  SQLPipelineBuilder& with_transaction_mode(const TransactionMode transaction_mode);
+
+  /**
+   * Sets the token that cancels the execution of all statements of the pipeline (see CancellationToken). Without it,
+   * the pipeline creates a token that expires after the configured statement timeout.
+   */
+  SQLPipelineBuilder& with_cancellation_token(const std::shared_ptr<CancellationToken>& cancellation_token);
+
   /**
    * Short for with_mvcc(UseMvcc::No)
    */
@@ -60,6 +82,9 @@ class SQLPipelineBuilder final {
   const std::string _sql;
 
   UseMvcc _use_mvcc{UseMvcc::Yes};
+  UseQueryArena _use_query_arena{UseQueryArena::No};
+  TransactionMode _transaction_mode{TransactionMode::ReadWrite};
+  std::shared_ptr<CancellationToken> _cancellation_token;
   std::shared_ptr<TransactionContext> _transaction_context;
   std::shared_ptr<Optimizer> _optimizer;
   std::shared_ptr<SQLPhysicalPlanCache> _pqp_cache;
@@ -1,7 +1,9 @@
 #include "sql_pipeline_statement.hpp"
 
+#include <cctype>
 #include <fstream>
 #include <iomanip>
+#include <regex>
 #include <utility>
 
 #include <boost/algorithm/string.hpp>
@@ -11,6 +13,7 @@
 #include "expression/value_expression.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/lqp_utils.hpp"
+#include "memory/query_memory_budget.hpp"
 #include "operators/export.hpp"
 #include "operators/import.hpp"
 #include "operators/maintenance/create_prepared_plan.hpp"
@@ -18,6 +21,7 @@
 #include "operators/maintenance/create_view.hpp"
 #include "operators/maintenance/drop_table.hpp"
 #include "operators/maintenance/drop_view.hpp"
+#include "optimizer/adaptive_reoptimizer.hpp"
 #include "optimizer/optimizer.hpp"
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
@@ -26,16 +30,29 @@
 #include "utils/assert.hpp"
 #include "utils/tracing/probes.hpp"
 
+namespace {
+
+// Stops the AdaptiveReoptimizer, which cannot continue with the missing results of cancelled checkpoints
+class StatementCancelledException : public std::exception {};
+
+}  // namespace
+
 namespace opossum {
 
 SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
-                                           const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
+                                           const UseMvcc use_mvcc, const UseQueryArena use_query_arena,
+                                           const TransactionMode transaction_mode,
+                                           const std::shared_ptr<CancellationToken>& cancellation_token,
+                                           const std::shared_ptr<Optimizer>& optimizer,
                                            const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
                                            const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache)
     : pqp_cache(init_pqp_cache),
       lqp_cache(init_lqp_cache),
       _sql_string(sql),
       _use_mvcc(use_mvcc),
+      _use_query_arena(use_query_arena),
+      _transaction_mode(transaction_mode),
+      _cancellation_token(cancellation_token),
       _optimizer(optimizer),
       _parsed_sql_statement(std::move(parsed_sql)),
       _metrics(std::make_shared<SQLPipelineStatementMetrics>()) {
@@ -64,7 +81,8 @@ const std::shared_ptr<hsql::SQLParserResult>& SQLPipelineStatement::get_parsed_s
 
   _parsed_sql_statement = std::make_shared<hsql::SQLParserResult>();
 
-  hsql::SQLParser::parse(_sql_string, _parsed_sql_statement.get());
+  const auto masked_sql_string = mask_read_only_modifiers(_sql_string);
+  hsql::SQLParser::parse(masked_sql_string ? *masked_sql_string : _sql_string, _parsed_sql_statement.get());
 
   AssertInput(_parsed_sql_statement->isValid(), create_sql_parser_error_message(_sql_string, *_parsed_sql_statement));
 
@@ -149,7 +167,8 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
 
   // If we need a transaction context but haven't passed one in, this is the last point where we can create it
   if (!_transaction_context && _use_mvcc == UseMvcc::Yes) {
-    _transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
+    _transaction_context =
+        Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes, _transaction_mode);
   }
 
   // Stores when the actual compilation started/ended
@@ -183,9 +202,20 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
 
   if (_use_mvcc == UseMvcc::Yes) _physical_plan->set_transaction_context_recursively(_transaction_context);
 
+  // Each execution gets a fresh budget, which is why it is not part of the cached plan's deep copy
+  if (const auto memory_budget = QueryMemoryBudget::create_from_settings()) {
+    _physical_plan->set_memory_budget_recursively(memory_budget);
+  }
+
+  if (_use_query_arena == UseQueryArena::Yes && _supports_query_arena(_physical_plan)) {
+    _query_memory_resource = std::make_shared<QueryMemoryResource>();
+  }
+
   // Cache newly created plan for the according sql statement (only if not already cached)
   if (pqp_cache && !_metrics->query_plan_cache_hit && _translation_info.cacheable) {
-    pqp_cache->set(_sql_string, _physical_plan);
+    // The cached plan must not hold on to results allocated from the arena once this statement is gone. As the
+    // operators keep their outputs (and other state) after the execution, we cache an unexecuted copy instead.
+    pqp_cache->set(_sql_string, _query_memory_resource ? _physical_plan->deep_copy() : _physical_plan);
   }
 
   _metrics->lqp_translation_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
@@ -202,24 +232,45 @@ const std::vector<std::shared_ptr<AbstractTask>>& SQLPipelineStatement::get_task
     _tasks = _get_transaction_tasks();
   } else {
     _precheck_ddl_operators(get_physical_plan());
+    if (_transaction_context && _transaction_context->is_read_only()) {
+      _precheck_read_only_transaction(get_physical_plan());
+    }
     auto operator_tasks = OperatorTask::make_tasks_from_operator(get_physical_plan());
     _tasks = std::vector<std::shared_ptr<AbstractTask>>(operator_tasks.cbegin(), operator_tasks.cend());
+
+    if (_query_memory_resource) {
+      for (const auto& task : _tasks) {
+        task->set_memory_resource(_query_memory_resource.get());
+      }
+    }
+
+    for (const auto& task : _tasks) {
+      task->set_cancellation_token(_cancellation_token);
+    }
   }
   return _tasks;
 }
 
+const std::shared_ptr<QueryMemoryResource>& SQLPipelineStatement::query_memory_resource() const {
+  return _query_memory_resource;
+}
+
 std::vector<std::shared_ptr<AbstractTask>> SQLPipelineStatement::_get_transaction_tasks() {
   const auto& sql_statement = get_parsed_sql_statement();
   const std::vector<hsql::SQLStatement*>& statements = sql_statement->getStatements();
   const auto& transaction_statement = static_cast<const hsql::TransactionStatement&>(*statements.front());
 
   switch (transaction_statement.command) {
-    case hsql::kBeginTransaction:
+    case hsql::kBeginTransaction: {
       AssertInput(!_transaction_context || _transaction_context->is_auto_commit(),
                   "Cannot begin transaction inside an active transaction.");
-      return {std::make_shared<JobTask>([this] {
-        _transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+      const auto transaction_mode =
+          mask_read_only_modifiers(_sql_string) ? TransactionMode::ReadOnly : _transaction_mode;
+      return {std::make_shared<JobTask>([this, transaction_mode] {
+        _transaction_context =
+            Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No, transaction_mode);
       })};
+    }
     case hsql::kCommitTransaction:
       AssertInput(_transaction_context && !_transaction_context->is_auto_commit(),
                   "Cannot commit since there is no active transaction.");
@@ -255,6 +306,17 @@ std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> SQLPipelineSta
     return {SQLPipelineStatus::Success, _result_table};
   }
 
+  // Time spent on executing the checkpoints of an adaptively executed statement
+  auto adaptive_execution_duration = std::chrono::nanoseconds{};
+  if (_use_adaptive_reoptimization()) {
+    const auto adaptive_execution_started = std::chrono::high_resolution_clock::now();
+    if (!_execute_adaptively(*AdaptiveReoptimizer::q_error_threshold_from_settings())) {
+      return _fail_cancelled_statement();
+    }
+    adaptive_execution_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - adaptive_execution_started);
+  }
+
   const auto& tasks = get_tasks();
 
   const auto started = std::chrono::high_resolution_clock::now();
@@ -264,6 +326,8 @@ std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> SQLPipelineSta
 
   Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
 
+  if (!_is_transaction_statement() && _is_cancelled()) return _fail_cancelled_statement();
+
   if (has_failed()) {
     return {SQLPipelineStatus::Failure, _result_table};
   }
@@ -280,11 +344,30 @@ std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> SQLPipelineSta
   }
 
   const auto done = std::chrono::high_resolution_clock::now();
-  _metrics->plan_execution_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
+  _metrics->plan_execution_duration =
+      adaptive_execution_duration + std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
 
   // Get output from the last task if the task was an actual operator and not a transaction statement
   if (!_is_transaction_statement()) {
-    _result_table = static_cast<const OperatorTask&>(*tasks.back()).get_operator()->get_output();
+    const auto& root_operator = static_cast<const OperatorTask&>(*tasks.back()).get_operator();
+    _result_table = root_operator->get_output();
+
+    if (_result_table && _query_memory_resource) {
+      // The result table (and the tables it references) might have been allocated from the arena. The returned
+      // pointer shares the ownership of the arena so that the arena is released in bulk once the result has been
+      // delivered and the last reference to the result table is gone. Members of a struct are destroyed in reverse
+      // order, so the table is destroyed before the arena.
+      struct ResultTableWithArena {
+        std::shared_ptr<QueryMemoryResource> query_memory_resource;
+        std::shared_ptr<const Table> result_table;
+      };
+      const auto result_with_arena =
+          std::make_shared<ResultTableWithArena>(ResultTableWithArena{_query_memory_resource, _result_table});
+      _result_table = std::shared_ptr<const Table>(result_with_arena, result_with_arena->result_table.get());
+
+      // The root operator would otherwise keep its output alive after the arena has been released.
+      root_operator->clear_output();
+    }
   }
 
   if (!_result_table) _query_has_output = false;
@@ -303,6 +386,10 @@ const std::shared_ptr<TransactionContext>& SQLPipelineStatement::transaction_con
 
 const std::shared_ptr<SQLPipelineStatementMetrics>& SQLPipelineStatement::metrics() const { return _metrics; }
 
+const std::shared_ptr<CancellationToken>& SQLPipelineStatement::cancellation_token() const {
+  return _cancellation_token;
+}
+
 void SQLPipelineStatement::_precheck_ddl_operators(const std::shared_ptr<AbstractOperator>& pqp) {
   const auto& storage_manager = Hyrise::get().storage_manager;
 
@@ -352,6 +439,183 @@ void SQLPipelineStatement::_precheck_ddl_operators(const std::shared_ptr<Abstrac
   }
 }
 
+bool SQLPipelineStatement::_supports_query_arena(const std::shared_ptr<const AbstractOperator>& pqp) {
+  switch (pqp->type()) {
+    case OperatorType::Aggregate:
+    case OperatorType::Alias:
+    case OperatorType::Difference:
+    case OperatorType::GetTable:
+    case OperatorType::GroupJoin:
+    case OperatorType::IndexScan:
+    case OperatorType::JoinHash:
+    case OperatorType::JoinIndex:
+    case OperatorType::JoinNestedLoop:
+    case OperatorType::JoinSortMerge:
+    case OperatorType::JoinVerification:
+    case OperatorType::Limit:
+    case OperatorType::Product:
+    case OperatorType::Projection:
+    case OperatorType::Sort:
+    case OperatorType::TableScan:
+    case OperatorType::TableWrapper:
+    case OperatorType::UnionAll:
+    case OperatorType::UnionPositions:
+    case OperatorType::Validate:
+      break;
+    default:
+      return false;
+  }
+
+  if (pqp->input_left() && !_supports_query_arena(pqp->input_left())) return false;
+  if (pqp->input_right() && !_supports_query_arena(pqp->input_right())) return false;
+  return true;
+}
+
+bool SQLPipelineStatement::_use_adaptive_reoptimization() {
+  if (_physical_plan || _use_query_arena == UseQueryArena::Yes || _is_transaction_statement()) return false;
+  if (!AdaptiveReoptimizer::q_error_threshold_from_settings()) return false;
+
+  // Cached physical plans are executed as they are. If the cached plan was created after a re-optimization, it already
+  // reflects the observed cardinalities.
+  if (pqp_cache && pqp_cache->has(_sql_string)) return false;
+
+  return AdaptiveReoptimizer::is_applicable(get_optimized_logical_plan());
+}
+
+bool SQLPipelineStatement::_is_cancelled() const { return _cancellation_token && _cancellation_token->is_cancelled(); }
+
+std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> SQLPipelineStatement::_fail_cancelled_statement() {
+  // Operators of a cancelled statement were skipped or stopped early, so that their results are incomplete. Like after
+  // a conflict, the modifications of the transaction are rolled back.
+  if (_transaction_context && _transaction_context->phase() == TransactionPhase::Active) {
+    _transaction_context->rollback(RollbackReason::Conflict);
+  }
+  _result_table = nullptr;
+  return {SQLPipelineStatus::Failure, _result_table};
+}
+
+bool SQLPipelineStatement::_execute_adaptively(const double q_error_threshold) {
+  if (!_transaction_context && _use_mvcc == UseMvcc::Yes) {
+    _transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
+  }
+
+  // All stages of the statement share one budget
+  const auto memory_budget = QueryMemoryBudget::create_from_settings();
+
+  const auto prepare_plan = [&](const std::shared_ptr<AbstractOperator>& pqp) {
+    if (_use_mvcc == UseMvcc::Yes) pqp->set_transaction_context_recursively(_transaction_context);
+    if (memory_budget) pqp->set_memory_budget_recursively(memory_budget);
+  };
+
+  auto reoptimizer = AdaptiveReoptimizer{q_error_threshold, [&](const std::shared_ptr<AbstractOperator>& pqp) {
+                                           prepare_plan(pqp);
+                                           const auto tasks = OperatorTask::make_tasks_from_operator(pqp);
+                                           for (const auto& task : tasks) {
+                                             task->set_cancellation_token(_cancellation_token);
+                                           }
+                                           Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+                                           if (_is_cancelled()) throw StatementCancelledException{};
+                                         }};
+  auto remaining_lqp = std::shared_ptr<AbstractLQPNode>{};
+  try {
+    remaining_lqp = reoptimizer.execute_checkpoints(get_optimized_logical_plan());
+  } catch (const StatementCancelledException&) {
+    return false;
+  }
+  _metrics->reoptimization_count = reoptimizer.reoptimization_count();
+
+  const auto started = std::chrono::high_resolution_clock::now();
+  _physical_plan = LQPTranslator{}.translate_node(remaining_lqp);
+  prepare_plan(_physical_plan);
+  const auto done = std::chrono::high_resolution_clock::now();
+  _metrics->lqp_translation_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
+
+  if (!pqp_cache || !_translation_info.cacheable) return true;
+
+  /**
+   * The remaining plan holds intermediate results and cannot be cached. If the estimates were good, the plan that
+   * would have been executed without the AdaptiveReoptimizer is cached. Otherwise, the statement is optimized once
+   * more. Now that the observed cardinalities are part of the CardinalityFeedback, the next execution starts with a
+   * plan that is based on them.
+   */
+  auto cached_lqp = get_optimized_logical_plan();
+  if (_metrics->reoptimization_count > 0) {
+    auto unoptimized_lqp = SQLTranslator{_use_mvcc}.translate_parser_result(*get_parsed_sql_statement()).lqp_nodes;
+    DebugAssert(unoptimized_lqp.size() == 1, "Expected exactly one LQP root for a single statement");
+    cached_lqp = _optimizer->optimize(std::move(unoptimized_lqp.front()));
+    if (lqp_cache) lqp_cache->set(_sql_string, cached_lqp);
+  }
+
+  const auto cached_pqp = LQPTranslator{}.translate_node(cached_lqp);
+  if (_use_mvcc == UseMvcc::Yes) cached_pqp->set_transaction_context_recursively(_transaction_context);
+  pqp_cache->set(_sql_string, cached_pqp);
+  return true;
+}
+
+std::optional<std::string> SQLPipelineStatement::mask_read_only_modifiers(const std::string& sql) {
+  // Avoid running the regex for the vast majority of statements
+  if (!boost::algorithm::icontains(sql, "only")) return std::nullopt;
+
+  // Matched only at the beginning of a statement
+  static const auto read_only_regex =
+      std::regex{R"(BEGIN(\s+TRANSACTION)?\s+(READ\s+ONLY)\b)", std::regex_constants::icase};
+
+  auto masked_sql = std::optional<std::string>{};
+  auto at_statement_begin = true;
+  const auto sql_size = sql.size();
+  for (auto position = size_t{0}; position < sql_size; ++position) {
+    const auto character = sql[position];
+
+    // Skip string literals, quoted identifiers, and comments. Doubled quotes (i.e., escaped ones) are skipped as two
+    // adjacent quoted texts.
+    if (character == '\'' || character == '"') {
+      const auto closing_quote = sql.find(character, position + 1);
+      position = closing_quote == std::string::npos ? sql_size : closing_quote;
+      at_statement_begin = false;
+      continue;
+    }
+    if (character == '-' && position + 1 < sql_size && sql[position + 1] == '-') {
+      const auto line_end = sql.find('\n', position);
+      position = line_end == std::string::npos ? sql_size : line_end;
+      continue;
+    }
+
+    if (character == ';') {
+      at_statement_begin = true;
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(character)) || !at_statement_begin) continue;
+
+    at_statement_begin = false;
+    auto match = std::smatch{};
+    if (std::regex_search(sql.cbegin() + position, sql.cend(), match, read_only_regex,
+                          std::regex_constants::match_continuous)) {
+      if (!masked_sql) masked_sql = sql;
+      masked_sql->replace(position + match.position(2), match.length(2), match.length(2), ' ');
+    }
+  }
+
+  return masked_sql;
+}
+
+void SQLPipelineStatement::_precheck_read_only_transaction(const std::shared_ptr<const AbstractOperator>& pqp) {
+  // As for DDL operators, only the root operator needs to be looked at (see _precheck_ddl_operators)
+  switch (pqp->type()) {
+    case OperatorType::ChangeMetaTable:
+    case OperatorType::CreateTable:
+    case OperatorType::CreateView:
+    case OperatorType::Delete:
+    case OperatorType::DropTable:
+    case OperatorType::DropView:
+    case OperatorType::Import:
+    case OperatorType::Insert:
+    case OperatorType::Update:
+      FailInput("Cannot execute " + pqp->name() + " in a read-only transaction.");
+    default:
+      break;
+  }
+}
+
 bool SQLPipelineStatement::_is_transaction_statement() {
   return get_parsed_sql_statement()->getStatements().front()->isType(hsql::kStmtTransaction);
 }
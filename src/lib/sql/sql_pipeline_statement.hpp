@@ -1,12 +1,15 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "SQLParserResult.h"
 #include "cache/cache.hpp"
+#include "concurrency/cancellation_token.hpp"
 #include "concurrency/transaction_context.hpp"
 #include "logical_query_plan/lqp_translator.hpp"
+#include "memory/query_memory_resource.hpp"
 #include "optimizer/optimizer.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
@@ -25,6 +28,9 @@ struct SQLPipelineStatementMetrics {
   std::chrono::nanoseconds plan_execution_duration{};
 
   bool query_plan_cache_hit = false;
+
+  // Number of times the remaining plan was re-optimized during the execution, see AdaptiveReoptimizer
+  size_t reoptimization_count = 0;
 };
 
 enum class SQLPipelineStatus {
@@ -33,7 +39,8 @@ enum class SQLPipelineStatus {
                 //     rollbacks, conforming to PostgreSQL's behavior. If use_mvcc is set but no transaction_context
                 //     was supplied, the statement has been auto-committed. If a context was supplied, that context
                 //     continues to be active (i.e., is not yet committed).
-  Failure       // The pipeline or the pipeline statement caused a transaction conflict and has been rolled back.
+  Failure       // The pipeline or the pipeline statement caused a transaction conflict or was cancelled (see
+                //     CancellationToken) and has been rolled back.
 };
 
 /**
@@ -54,7 +61,10 @@ class SQLPipelineStatement : public Noncopyable {
  public:
   // Prefer using the SQLPipelineBuilder for constructing SQLPipelineStatements conveniently
   SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
-                       const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
+                       const UseMvcc use_mvcc, const UseQueryArena use_query_arena,
+                       const TransactionMode transaction_mode,
+                       const std::shared_ptr<CancellationToken>& cancellation_token,
+                       const std::shared_ptr<Optimizer>& optimizer,
                        const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
                        const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache);
 
@@ -81,10 +91,14 @@ class SQLPipelineStatement : public Noncopyable {
   // Returns all tasks that need to be executed for this query.
   const std::vector<std::shared_ptr<AbstractTask>>& get_tasks();
 
+  // Returns the arena that the intermediate results of this statement are allocated from. nullptr if the statement
+  // does not use an arena, either because it was not requested or because the statement modifies data.
+  const std::shared_ptr<QueryMemoryResource>& query_memory_resource() const;
+
   // Executes all tasks, waits for them to finish, and returns
   //   - {Success, table}       if the statement was successful and returned a table
   //   - {Success, nullptr}     if the statement was successful but did not return a table (e.g., UPDATE)
-  //   - {Failure, nullptr}     if the transaction failed
+  //   - {Failure, nullptr}     if the transaction failed or the statement was cancelled
   // The transaction status is somewhat redundant, as it could also be retrieved from the transaction_context. We
   // explicitly return it as part of get_result_table to force the caller to take the possibility of a failed
   // transaction into account.
@@ -96,12 +110,34 @@ class SQLPipelineStatement : public Noncopyable {
 
   const std::shared_ptr<SQLPipelineStatementMetrics>& metrics() const;
 
+  // Token shared by the tasks of this statement. nullptr if the statement cannot be cancelled.
+  const std::shared_ptr<CancellationToken>& cancellation_token() const;
+
   const std::shared_ptr<SQLPhysicalPlanCache> pqp_cache;
   const std::shared_ptr<SQLLogicalPlanCache> lqp_cache;
 
+  // The SQL parser does not know about transaction modes. If @param sql begins a read-only transaction (i.e., one of
+  // its statements is BEGIN [TRANSACTION] READ ONLY), this returns a copy in which the READ ONLY modifiers are replaced
+  // by whitespace. Thus, the copy can be parsed and the statements keep their offsets within the string. Otherwise,
+  // std::nullopt is returned. Quoted text and comments are not matched.
+  static std::optional<std::string> mask_read_only_modifiers(const std::string& sql);
+
  private:
   bool _is_transaction_statement();
 
+  // Returns true if the statement is executed by the AdaptiveReoptimizer, see _execute_adaptively()
+  bool _use_adaptive_reoptimization();
+
+  // Executes the joins and aggregates of the optimized LQP one after another and re-optimizes the remaining LQP if an
+  // estimate turns out to be wrong. Afterwards, the physical plan holds the remaining part of the query. Returns false
+  // if the statement was cancelled in between.
+  bool _execute_adaptively(const double q_error_threshold);
+
+  bool _is_cancelled() const;
+
+  // Rolls back the transaction of a cancelled statement and returns the Failure status
+  std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> _fail_cancelled_statement();
+
   // Returns the tasks that execute transaction statements
   std::vector<std::shared_ptr<AbstractTask>> _get_transaction_tasks();
 
@@ -110,8 +146,18 @@ class SQLPipelineStatement : public Noncopyable {
   // Throws an InvalidInputException if an invalid PQP is detected.
   static void _precheck_ddl_operators(const std::shared_ptr<AbstractOperator>& pqp);
 
+  // Returns true if the PQP only consists of operators whose results do not outlive the statement (i.e., it neither
+  // modifies nor creates stored data). Only those can allocate their intermediates from a QueryMemoryResource.
+  static bool _supports_query_arena(const std::shared_ptr<const AbstractOperator>& pqp);
+
+  // Throws an InvalidInputException if the PQP modifies data, which read-only transactions must not do.
+  static void _precheck_read_only_transaction(const std::shared_ptr<const AbstractOperator>& pqp);
+
   const std::string _sql_string;
   const UseMvcc _use_mvcc;
+  const UseQueryArena _use_query_arena;
+  const TransactionMode _transaction_mode;
+  const std::shared_ptr<CancellationToken> _cancellation_token;
 
   const std::shared_ptr<Optimizer> _optimizer;
 
@@ -119,6 +165,9 @@ class SQLPipelineStatement : public Noncopyable {
   std::shared_ptr<hsql::SQLParserResult> _parsed_sql_statement;
   std::shared_ptr<AbstractLQPNode> _unoptimized_logical_plan;
   std::shared_ptr<AbstractLQPNode> _optimized_logical_plan;
+  // Declared before the physical plan and the tasks so that these (and the intermediate results held by them) are
+  // destroyed first. The result table shares the ownership of the arena, see get_result_table().
+  std::shared_ptr<QueryMemoryResource> _query_memory_resource;
   std::shared_ptr<AbstractOperator> _physical_plan;
   std::vector<std::shared_ptr<AbstractTask>> _tasks;
   std::shared_ptr<const Table> _result_table;
@@ -4,7 +4,9 @@
 
 #include "resolve_type.hpp"
 #include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "statistics/statistics_objects/bloom_filter.hpp"
 #include "statistics/statistics_objects/counting_quotient_filter.hpp"
+#include "statistics/statistics_objects/distinct_count_sketch.hpp"
 #include "statistics/statistics_objects/generic_histogram.hpp"
 #include "statistics/statistics_objects/min_max_filter.hpp"
 #include "statistics/statistics_objects/range_filter.hpp"
@@ -29,9 +31,14 @@ void AttributeStatistics<T>::set_statistics_object(const std::shared_ptr<Abstrac
   } else if (const auto counting_quotient_filter_object =
                  std::dynamic_pointer_cast<CountingQuotientFilter<T>>(statistics_object)) {
     counting_quotient_filter = counting_quotient_filter_object;
+  } else if (const auto bloom_filter_object = std::dynamic_pointer_cast<BloomFilter<T>>(statistics_object)) {
+    bloom_filter = bloom_filter_object;
   } else if (const auto null_value_ratio_object =
                  std::dynamic_pointer_cast<NullValueRatioStatistics>(statistics_object)) {
     null_value_ratio = null_value_ratio_object;
+  } else if (const auto distinct_count_sketch_object =
+                 std::dynamic_pointer_cast<DistinctCountSketch<T>>(statistics_object)) {
+    distinct_count_sketch = distinct_count_sketch_object;
   } else {
     if constexpr (std::is_arithmetic_v<
                       T>) {  // NOLINT clang-tidy is crazy and sees a "potentially unintended semicolon" here...
@@ -65,6 +72,10 @@ std::shared_ptr<BaseAttributeStatistics> AttributeStatistics<T>::scaled(const Se
     statistics->set_statistics_object(counting_quotient_filter->scaled(selectivity));
   }
 
+  if (bloom_filter) {
+    statistics->set_statistics_object(bloom_filter->scaled(selectivity));
+  }
+
   // NOLINTNEXTLINE clang-tidy is crazy and sees a "potentially unintended semicolon" here...
   if constexpr (std::is_arithmetic_v<T>) {
     if (range_filter) {
@@ -98,6 +109,10 @@ std::shared_ptr<BaseAttributeStatistics> AttributeStatistics<T>::sliced(
         counting_quotient_filter->sliced(predicate_condition, variant_value, variant_value2));
   }
 
+  if (bloom_filter) {
+    statistics->set_statistics_object(bloom_filter->sliced(predicate_condition, variant_value, variant_value2));
+  }
+
   // NOLINTNEXTLINE clang-tidy is crazy and sees a "potentially unintended semicolon" here...
   if constexpr (std::is_arithmetic_v<T>) {
     if (range_filter) {
@@ -135,6 +150,10 @@ std::shared_ptr<BaseAttributeStatistics> AttributeStatistics<T>::pruned(
     Fail("Pruning not implemented for counting quotient filters");
   }
 
+  if (bloom_filter) {
+    Fail("Pruning not implemented for Bloom filters");
+  }
+
   // NOLINTNEXTLINE clang-tidy is crazy and sees a "potentially unintended semicolon" here...
   if constexpr (std::is_arithmetic_v<T>) {
     if (range_filter) {
@@ -145,6 +164,33 @@ std::shared_ptr<BaseAttributeStatistics> AttributeStatistics<T>::pruned(
   return statistics;
 }
 
+template <typename T>
+bool AttributeStatistics<T>::does_not_contain(const PredicateCondition predicate_condition,
+                                              const AllTypeVariant& variant_value,
+                                              const std::optional<AllTypeVariant>& variant_value2) const {
+  // Range filters are only available for arithmetic (non-string) types.
+  // NOLINTNEXTLINE clang-tidy is crazy and sees a "potentially unintended semicolon" here...
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (range_filter && range_filter->does_not_contain(predicate_condition, variant_value, variant_value2)) {
+      return true;
+    }
+    // RangeFilters contain all the information stored in a MinMaxFilter. There is no point in having both.
+    DebugAssert(!range_filter || !min_max_filter,
+                "Segment should not have a MinMaxFilter and a RangeFilter at the same time");
+  }
+
+  if (min_max_filter && min_max_filter->does_not_contain(predicate_condition, variant_value, variant_value2)) {
+    return true;
+  }
+
+  // Only prunes equality predicates on values within the range of the segment
+  if (bloom_filter && bloom_filter->does_not_contain(predicate_condition, variant_value, variant_value2)) {
+    return true;
+  }
+
+  return false;
+}
+
 EXPLICITLY_INSTANTIATE_DATA_TYPES(AttributeStatistics);
 
 }  // namespace opossum
@@ -52,6 +52,13 @@ class BaseAttributeStatistics {
       const size_t num_values_pruned, const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
       const std::optional<AllTypeVariant>& variant_value2 = std::nullopt) const;
 
+  /**
+   * Checks whether any of the filters of a segment (see generate_chunk_pruning_statistics()) guarantees that no value
+   * satisfies the predicate. The caller has to convert the values to the data type of the statistics.
+   */
+  virtual bool does_not_contain(const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+                                const std::optional<AllTypeVariant>& variant_value2 = std::nullopt) const = 0;
+
   const DataType data_type;
 };
 
@@ -11,6 +11,9 @@ class CardinalityEstimationCache {
 
   using StatisticsByLQP = std::unordered_map<std::shared_ptr<AbstractLQPNode>, std::shared_ptr<TableStatistics>>;
   std::optional<StatisticsByLQP> statistics_by_lqp;
+
+  // TableStatisticsMaintainer::statistics_epoch() at the time the cached statistics were estimated
+  size_t statistics_epoch{0};
 };
 
 }  // namespace opossum
@@ -1,13 +1,16 @@
 #include "cardinality_estimator.hpp"
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 
 #include "attribute_statistics.hpp"
 #include "expression/abstract_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
 #include "expression/expression_functional.hpp"
 #include "expression/expression_utils.hpp"
 #include "expression/logical_expression.hpp"
+#include "expression/lqp_column_expression.hpp"
 #include "expression/lqp_subquery_expression.hpp"
 #include "expression/value_expression.hpp"
 #include "hyrise.hpp"
@@ -30,11 +33,15 @@
 #include "resolve_type.hpp"
 #include "statistics/attribute_statistics.hpp"
 #include "statistics/cardinality_estimation_cache.hpp"
+#include "statistics/cardinality_feedback.hpp"
+#include "statistics/column_pair_statistics.hpp"
+#include "statistics/join_sampling.hpp"
 #include "statistics/statistics_objects/equal_distinct_count_histogram.hpp"
 #include "statistics/statistics_objects/generic_histogram.hpp"
 #include "statistics/statistics_objects/generic_histogram_builder.hpp"
 #include "storage/table.hpp"
 #include "table_statistics.hpp"
+#include "table_statistics_maintainer.hpp"
 #include "utils/assert.hpp"
 
 namespace {
@@ -65,14 +72,125 @@ std::optional<float> estimate_null_value_ratio_of_column(const TableStatistics&
   return std::nullopt;
 }
 
+using StoredTableColumn = std::pair<std::shared_ptr<const StoredTableNode>, ColumnID>;
+
+// Returns the StoredTableNode and the ColumnID of the stored table that @param expression refers to, if any
+std::optional<StoredTableColumn> stored_table_column(const AbstractExpression& expression) {
+  if (expression.type != ExpressionType::LQPColumn) return std::nullopt;
+
+  const auto& column_reference = static_cast<const LQPColumnExpression&>(expression).column_reference;
+  const auto stored_table_node = std::dynamic_pointer_cast<const StoredTableNode>(column_reference.original_node());
+  if (!stored_table_node) return std::nullopt;
+
+  return StoredTableColumn{stored_table_node, column_reference.original_column_id()};
+}
+
+// Returns the column of a stored table if it is the only column that @param predicate references
+std::optional<StoredTableColumn> single_stored_table_column(const std::shared_ptr<AbstractExpression>& predicate) {
+  auto column_expression = std::shared_ptr<AbstractExpression>{};
+  auto is_single_column = true;
+  visit_expression(predicate, [&](const auto& sub_expression) {
+    if (sub_expression->type == ExpressionType::LQPSubquery) {
+      is_single_column = false;
+    } else if (sub_expression->type == ExpressionType::LQPColumn) {
+      if (column_expression && *column_expression != *sub_expression) is_single_column = false;
+      column_expression = sub_expression;
+    }
+    return is_single_column ? ExpressionVisitation::VisitArguments : ExpressionVisitation::DoNotVisitArguments;
+  });
+
+  if (!is_single_column || !column_expression) return std::nullopt;
+  return stored_table_column(*column_expression);
+}
+
+// Checks whether @param expression refers to a column of a stored table that has a single-column unique constraint
+bool has_unique_constraint(const AbstractExpression& expression) {
+  const auto column = stored_table_column(expression);
+  if (!column) return false;
+
+  const auto table = Hyrise::get().storage_manager.get_table(column->first->table_name);
+  const auto& constraints = table->get_soft_unique_constraints();
+  return std::any_of(constraints.cbegin(), constraints.cend(), [&](const auto& constraint) {
+    return constraint.columns == std::vector<ColumnID>{column->second};
+  });
+}
+
+/**
+ * Checks whether the values of @param expression, a column with a unique constraint, are still unique in the output of
+ * @param lqp. This is the case if no row of its stored table occurs more than once, e.g., after predicates or after
+ * joins on a unique column of the other input.
+ */
+bool is_unique_in(const AbstractLQPNode& lqp, const std::shared_ptr<AbstractExpression>& expression) {
+  switch (lqp.type) {
+    case LQPNodeType::StoredTable:
+      return stored_table_column(*expression)->first.get() == &lqp;
+
+    case LQPNodeType::Alias:
+    case LQPNodeType::Limit:
+    case LQPNodeType::Predicate:
+    case LQPNodeType::Projection:
+    case LQPNodeType::Sort:
+    case LQPNodeType::Validate:
+      return is_unique_in(*lqp.left_input(), expression);
+
+    case LQPNodeType::Join: {
+      const auto& join_node = static_cast<const JoinNode&>(lqp);
+      const auto from_left_input = join_node.left_input()->find_column_id(*expression).has_value();
+      const auto& input = from_left_input ? join_node.left_input() : join_node.right_input();
+      const auto& other_input = from_left_input ? join_node.right_input() : join_node.left_input();
+      if (!is_unique_in(*input, expression)) return false;
+
+      if (join_node.join_mode == JoinMode::Semi || join_node.join_mode == JoinMode::AntiNullAsTrue ||
+          join_node.join_mode == JoinMode::AntiNullAsFalse) {
+        return true;
+      }
+      if (join_node.join_mode == JoinMode::Cross) return false;
+
+      // Each row of the input has at most one join partner if the other input's side of an equi predicate is unique
+      for (const auto& join_predicate : join_node.join_predicates()) {
+        const auto binary_predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(join_predicate);
+        if (!binary_predicate || binary_predicate->predicate_condition != PredicateCondition::Equals) continue;
+
+        for (const auto& operand : {binary_predicate->left_operand(), binary_predicate->right_operand()}) {
+          if (other_input->find_column_id(*operand) && has_unique_constraint(*operand) &&
+              is_unique_in(*other_input, operand)) {
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    default:
+      return false;
+  }
+}
+
+// Scales all column statistics so that @param table_statistics have @param row_count rows
+std::shared_ptr<TableStatistics> scale_to_row_count(const TableStatistics& table_statistics,
+                                                    const Cardinality row_count) {
+  const auto selectivity = table_statistics.row_count > 0 ? row_count / table_statistics.row_count : 0.0f;
+
+  auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>{};
+  column_statistics.reserve(table_statistics.column_statistics.size());
+  for (const auto& base_column_statistics : table_statistics.column_statistics) {
+    column_statistics.emplace_back(base_column_statistics->scaled(selectivity));
+  }
+
+  return std::make_shared<TableStatistics>(std::move(column_statistics), row_count);
+}
+
 }  // namespace
 
 namespace opossum {
 
 using namespace opossum::expression_functional;  // NOLINT
 
+CardinalityEstimator::CardinalityEstimator(const std::optional<JoinSamplingConfig>& init_join_sampling_config)
+    : join_sampling_config(init_join_sampling_config) {}
+
 std::shared_ptr<AbstractCardinalityEstimator> CardinalityEstimator::new_instance() const {
-  return std::make_shared<CardinalityEstimator>();
+  return std::make_shared<CardinalityEstimator>(join_sampling_config);
 }
 
 Cardinality CardinalityEstimator::estimate_cardinality(const std::shared_ptr<AbstractLQPNode>& lqp) const {
@@ -82,6 +200,21 @@ Cardinality CardinalityEstimator::estimate_cardinality(const std::shared_ptr<Abs
 
 std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_statistics(
     const std::shared_ptr<AbstractLQPNode>& lqp) const {
+  /**
+   * 0. Drop cached statistics if the statistics of a stored table drifted since they were estimated (see
+   *    TableStatisticsMaintainer).
+   */
+  const auto statistics_epoch = TableStatisticsMaintainer::statistics_epoch();
+  if (cardinality_estimation_cache.statistics_epoch != statistics_epoch) {
+    if (cardinality_estimation_cache.join_graph_statistics_cache) {
+      cardinality_estimation_cache.join_graph_statistics_cache->clear();
+    }
+    if (cardinality_estimation_cache.statistics_by_lqp) {
+      cardinality_estimation_cache.statistics_by_lqp->clear();
+    }
+    cardinality_estimation_cache.statistics_epoch = statistics_epoch;
+  }
+
   /**
    * 1. Try a cache lookup for requested LQP.
    *
@@ -227,7 +360,40 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_statistics(
   }
 
   /**
-   * 3. Store output_table_statistics in cache
+   * 3. Use the row count observed during a previous execution of the same LQP, if any (see CardinalityFeedback). Only
+   *    joins and aggregates are recorded, so the LQPs of other nodes are not hashed for the lookup.
+   */
+  auto observed_row_count = std::optional<Cardinality>{};
+  const auto& cardinality_feedback = Hyrise::get().cardinality_feedback;
+  if (CardinalityFeedback::is_recordable(*lqp) && cardinality_feedback && !cardinality_feedback->empty()) {
+    observed_row_count = cardinality_feedback->lookup(lqp);
+    if (observed_row_count) {
+      output_table_statistics = scale_to_row_count(*output_table_statistics, *observed_row_count);
+    }
+  }
+
+  /**
+   * 4. For joins in large join graphs, replace the estimated row count with the one of a sampled execution, as long as
+   *    the time budget allows it. Caching the result in the JoinGraphStatisticsCache makes it available to all plans
+   *    joining the same subgraph.
+   */
+  if (!observed_row_count && join_sampling_config && join_graph_bitmask && lqp->type == LQPNodeType::Join &&
+      cardinality_estimation_cache.join_graph_statistics_cache->vertex_count() >=
+          join_sampling_config->min_vertex_count &&
+      _join_sampling_duration < join_sampling_config->time_budget) {
+    const auto sampling_begin = std::chrono::steady_clock::now();
+    const auto sampled_row_count =
+        sample_cardinality(lqp, *join_sampling_config, output_table_statistics->row_count);
+    _join_sampling_duration += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - sampling_begin);
+
+    if (sampled_row_count) {
+      output_table_statistics = scale_to_row_count(*output_table_statistics, *sampled_row_count);
+    }
+  }
+
+  /**
+   * 5. Store output_table_statistics in cache
    */
   if (join_graph_bitmask) {
     cardinality_estimation_cache.join_graph_statistics_cache->set(*join_graph_bitmask, lqp->column_expressions(),
@@ -288,6 +454,43 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_aggregate_node(
   // For AggregateNodes, statistics from group-by columns are forwarded and for the aggregate columns
   // dummy statistics are created for now.
 
+  // If all group-by expressions are input columns with histograms, the number of groups is bounded by the product of
+  // their distinct counts (assuming independence). Otherwise, we pessimistically assume one group per input row.
+  auto row_count = input_table_statistics->row_count;
+  auto group_count = Cardinality{1.0f};
+  for (auto expression_idx = size_t{0}; expression_idx < aggregate_node.aggregate_expressions_begin_idx;
+       ++expression_idx) {
+    const auto& group_by_expression = *aggregate_node.node_expressions[expression_idx];
+    const auto input_column_id = aggregate_node.left_input()->find_column_id(group_by_expression);
+    if (!input_column_id) {
+      group_count = row_count;
+      break;
+    }
+
+    auto distinct_count = std::optional<HistogramCountType>{};
+    resolve_data_type(group_by_expression.data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      const auto input_column_statistics = std::dynamic_pointer_cast<AttributeStatistics<ColumnDataType>>(
+          input_table_statistics->column_statistics[*input_column_id]);
+      if (input_column_statistics && input_column_statistics->histogram) {
+        // NULL forms a group of its own
+        distinct_count = input_column_statistics->histogram->total_distinct_count() +
+                         (aggregate_node.left_input()->is_column_nullable(*input_column_id) ? 1.0f : 0.0f);
+      }
+    });
+    if (!distinct_count) {
+      group_count = row_count;
+      break;
+    }
+    group_count *= std::max(*distinct_count, HistogramCountType{1.0f});
+  }
+  row_count = std::min(row_count, group_count);
+
+  // Each group-by value occurs once per group. Thus, if the aggregation reduces the number of rows, the statistics of
+  // the group-by columns are scaled down accordingly.
+  const auto selectivity =
+      input_table_statistics->row_count > 0.0f ? row_count / input_table_statistics->row_count : 1.0f;
+
   auto column_statistics =
       std::vector<std::shared_ptr<BaseAttributeStatistics>>{aggregate_node.column_expressions().size()};
 
@@ -295,7 +498,9 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_aggregate_node(
     const auto& expression = *aggregate_node.column_expressions()[expression_idx];
     const auto input_column_id = aggregate_node.left_input()->find_column_id(expression);
     if (input_column_id) {
-      column_statistics[expression_idx] = input_table_statistics->column_statistics[*input_column_id];
+      const auto& input_column_statistics = input_table_statistics->column_statistics[*input_column_id];
+      column_statistics[expression_idx] =
+          selectivity < 1.0f ? input_column_statistics->scaled(selectivity) : input_column_statistics;
     } else {
       resolve_data_type(expression.data_type(), [&](const auto data_type_t) {
         using ColumnDataType = typename decltype(data_type_t)::type;
@@ -304,7 +509,7 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_aggregate_node(
     }
   }
 
-  return std::make_shared<TableStatistics>(std::move(column_statistics), input_table_statistics->row_count);
+  return std::make_shared<TableStatistics>(std::move(column_statistics), row_count);
 }
 
 std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_validate_node(
@@ -416,8 +621,67 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_predicate_node(
       output_table_statistics = estimate_operator_scan_predicate(output_table_statistics, operator_scan_predicate);
     }
 
-    return output_table_statistics;
+    return estimate_correlated_predicate(predicate_node, input_table_statistics, output_table_statistics);
+  }
+}
+
+std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_correlated_predicate(
+    const PredicateNode& predicate_node, const std::shared_ptr<TableStatistics>& input_table_statistics,
+    const std::shared_ptr<TableStatistics>& output_table_statistics) {
+  if (output_table_statistics->row_count == 0.0f) return output_table_statistics;
+
+  const auto column = single_stored_table_column(predicate_node.predicate());
+  if (!column) return output_table_statistics;
+
+  const auto& [stored_table_node, column_id] = *column;
+  const auto stored_table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+  const auto stored_table_statistics = stored_table->table_statistics();
+  if (stored_table_statistics->column_pair_statistics_list.empty()) return output_table_statistics;
+
+  // Selectivity of a predicate on the (unpruned) stored table. As the predicate is estimated directly on top of the
+  // StoredTableNode, this does not recurse into estimate_correlated_predicate() again.
+  const auto stored_table_node_input = std::const_pointer_cast<StoredTableNode>(stored_table_node);
+  const auto base_table_statistics =
+      prune_column_statistics(stored_table_node->table_statistics ? stored_table_node->table_statistics
+                                                                  : stored_table_statistics,
+                              stored_table_node->pruned_column_ids());
+  if (base_table_statistics->row_count == 0.0f) return output_table_statistics;
+
+  const auto base_selectivity = [&](const std::shared_ptr<AbstractExpression>& predicate) {
+    const auto base_predicate_node = PredicateNode::make(predicate, stored_table_node_input);
+    return estimate_predicate_node(*base_predicate_node, base_table_statistics)->row_count /
+           base_table_statistics->row_count;
+  };
+
+  /**
+   * Look for predicates on other columns of the same stored table that were applied before this one. Of the columns
+   * with ColumnPairStatistics, the strongest correlation determines the selectivity.
+   */
+  auto selectivity = std::optional<Selectivity>{};
+  auto conditional_selectivity = Selectivity{0};
+  for (auto node = predicate_node.left_input(); node; node = node->left_input()) {
+    if (node->type == LQPNodeType::Validate) continue;
+    if (node->type != LQPNodeType::Predicate) break;
+
+    const auto& other_predicate = static_cast<const PredicateNode&>(*node).predicate();
+    const auto other_column = single_stored_table_column(other_predicate);
+    if (!other_column || other_column->first != stored_table_node || other_column->second == column_id) continue;
+
+    const auto column_pair_statistics =
+        stored_table_statistics->column_pair_statistics(column_id, other_column->second);
+    if (!column_pair_statistics) continue;
+
+    if (!selectivity) selectivity = base_selectivity(predicate_node.predicate());
+    conditional_selectivity =
+        std::max(conditional_selectivity, column_pair_statistics->estimate_conditional_selectivity(
+                                              column_id, *selectivity, base_selectivity(other_predicate)));
   }
+
+  if (!selectivity) return output_table_statistics;
+
+  const auto row_count = std::min(input_table_statistics->row_count * conditional_selectivity,
+                                  input_table_statistics->row_count);
+  return scale_to_row_count(*output_table_statistics, row_count);
 }
 
 std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_join_node(
@@ -444,9 +708,12 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_join_node(
         case JoinMode::Inner:
           switch (primary_operator_join_predicate->predicate_condition) {
             case PredicateCondition::Equals:
-              return estimate_inner_equi_join(primary_operator_join_predicate->column_ids.first,
-                                              primary_operator_join_predicate->column_ids.second,
-                                              *left_input_table_statistics, *right_input_table_statistics);
+              return estimate_foreign_key_join(
+                  join_node, *primary_operator_join_predicate, *left_input_table_statistics,
+                  *right_input_table_statistics,
+                  estimate_inner_equi_join(primary_operator_join_predicate->column_ids.first,
+                                           primary_operator_join_predicate->column_ids.second,
+                                           *left_input_table_statistics, *right_input_table_statistics));
 
             // TODO(anybody) Implement estimation for non-equi joins. #1830
             case PredicateCondition::NotEquals:
@@ -474,10 +741,16 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_join_node(
           // Should have been forwarded to estimate_cross_join()
           Fail("Cross join is not a predicated join");
 
-        case JoinMode::Semi:
-          return estimate_semi_join(primary_operator_join_predicate->column_ids.first,
-                                    primary_operator_join_predicate->column_ids.second, *left_input_table_statistics,
-                                    *right_input_table_statistics);
+        case JoinMode::Semi: {
+          const auto semi_join_statistics = estimate_semi_join(
+              primary_operator_join_predicate->column_ids.first, primary_operator_join_predicate->column_ids.second,
+              *left_input_table_statistics, *right_input_table_statistics);
+          if (primary_operator_join_predicate->predicate_condition != PredicateCondition::Equals) {
+            return semi_join_statistics;
+          }
+          return estimate_foreign_key_join(join_node, *primary_operator_join_predicate, *left_input_table_statistics,
+                                           *right_input_table_statistics, semi_join_statistics);
+        }
 
         case JoinMode::AntiNullAsTrue:
         case JoinMode::AntiNullAsFalse:
@@ -492,6 +765,56 @@ std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_join_node(
   Fail("Invalid enum value");
 }
 
+std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_foreign_key_join(
+    const JoinNode& join_node, const OperatorJoinPredicate& join_predicate,
+    const TableStatistics& left_input_table_statistics, const TableStatistics& right_input_table_statistics,
+    const std::shared_ptr<TableStatistics>& output_table_statistics) {
+  DebugAssert(join_predicate.predicate_condition == PredicateCondition::Equals, "Expected equi join");
+
+  // Outer joins keep the rows without join partners
+  if (join_node.join_mode != JoinMode::Inner && join_node.join_mode != JoinMode::Semi) return output_table_statistics;
+
+  /**
+   * For a join between a column and a unique column it references (e.g., a foreign key and a primary key), each row
+   * of the referencing input finds its join partner if that partner survived the predicates on the unique column's
+   * input. Assuming independence between the referencing rows and those predicates, the share of surviving partners is
+   * the ratio of the unique input's row count to the row count of its stored table.
+   */
+  const auto foreign_key_join_row_count =
+      [&](const std::shared_ptr<AbstractLQPNode>& unique_input, const ColumnID unique_column_id,
+          const Cardinality unique_row_count, const Cardinality referencing_row_count) -> std::optional<Cardinality> {
+    const auto unique_expression = unique_input->column_expressions()[unique_column_id];
+    if (!has_unique_constraint(*unique_expression) || !is_unique_in(*unique_input, unique_expression)) {
+      return std::nullopt;
+    }
+
+    const auto stored_table_name = stored_table_column(*unique_expression)->first->table_name;
+    const auto stored_row_count =
+        Hyrise::get().storage_manager.get_table(stored_table_name)->table_statistics()->row_count;
+    if (stored_row_count == 0.0f) return std::nullopt;
+
+    return referencing_row_count * std::min(unique_row_count / stored_row_count, 1.0f);
+  };
+
+  auto row_count = output_table_statistics->row_count;
+
+  const auto right_unique_row_count =
+      foreign_key_join_row_count(join_node.right_input(), join_predicate.column_ids.second,
+                                 right_input_table_statistics.row_count, left_input_table_statistics.row_count);
+  if (right_unique_row_count) row_count = std::min(row_count, *right_unique_row_count);
+
+  // For semi joins, only the right input filters the left one
+  if (join_node.join_mode != JoinMode::Semi) {
+    const auto left_unique_row_count =
+        foreign_key_join_row_count(join_node.left_input(), join_predicate.column_ids.first,
+                                   left_input_table_statistics.row_count, right_input_table_statistics.row_count);
+    if (left_unique_row_count) row_count = std::min(row_count, *left_unique_row_count);
+  }
+
+  if (row_count == output_table_statistics->row_count) return output_table_statistics;
+  return scale_to_row_count(*output_table_statistics, row_count);
+}
+
 std::shared_ptr<TableStatistics> CardinalityEstimator::estimate_union_node(
     const UnionNode& union_node, const std::shared_ptr<TableStatistics>& left_input_table_statistics,
     const std::shared_ptr<TableStatistics>& right_input_table_statistics) {
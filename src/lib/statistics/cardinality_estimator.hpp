@@ -1,11 +1,15 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <optional>
 
 #include "boost/dynamic_bitset.hpp"
 
 #include "abstract_cardinality_estimator.hpp"
+#include "operators/operator_join_predicate.hpp"
 #include "operators/operator_scan_predicate.hpp"
+#include "statistics/join_sampling.hpp"
 #include "statistics/statistics_objects/abstract_histogram.hpp"
 
 namespace opossum {
@@ -27,9 +31,15 @@ class LimitNode;
 
 /**
  * Hyrise's default, statistics-based cardinality estimator
+ *
+ * If a JoinSamplingConfig is given, the cardinalities of joins in large join graphs are estimated by executing them on
+ * a sample (see sample_cardinality()). This requires guarantee_join_graph() to be called, as the JoinOrderingRule
+ * does, so that the sampled cardinalities are cached per join subgraph.
  */
 class CardinalityEstimator : public AbstractCardinalityEstimator {
  public:
+  explicit CardinalityEstimator(const std::optional<JoinSamplingConfig>& init_join_sampling_config = std::nullopt);
+
   std::shared_ptr<AbstractCardinalityEstimator> new_instance() const override;
 
   Cardinality estimate_cardinality(const std::shared_ptr<AbstractLQPNode>& lqp) const override;
@@ -78,6 +88,15 @@ class CardinalityEstimator : public AbstractCardinalityEstimator {
   static std::shared_ptr<TableStatistics> estimate_operator_scan_predicate(
       const std::shared_ptr<TableStatistics>& input_table_statistics, const OperatorScanPredicate& predicate);
 
+  /**
+   * Corrects the estimation of a predicate on a column of a stored table (@param output_table_statistics) for the
+   * correlation with predicates on other columns of that table that were applied before. Requires the stored table's
+   * statistics to have ColumnPairStatistics for the columns, otherwise the predicates are assumed to be independent.
+   */
+  static std::shared_ptr<TableStatistics> estimate_correlated_predicate(
+      const PredicateNode& predicate_node, const std::shared_ptr<TableStatistics>& input_table_statistics,
+      const std::shared_ptr<TableStatistics>& output_table_statistics);
+
   /**
    * Estimation of an equi scan between two histograms. Estimating equi scans without correlation information is
    * impossible, so this function is restricted to computing an upper bound of the resulting histogram.
@@ -101,6 +120,16 @@ class CardinalityEstimator : public AbstractCardinalityEstimator {
                                                              const TableStatistics& left_input_table_statistics,
                                                              const TableStatistics& right_input_table_statistics);
 
+  /**
+   * Limits the estimation of an inner or semi equi join (@param output_table_statistics) if one of the join columns is
+   * unique, i.e., it has a single-column unique constraint (see TableConstraintDefinition) and the rows of its stored
+   * table are not duplicated in the input. The other join column is assumed to reference it like a foreign key.
+   */
+  static std::shared_ptr<TableStatistics> estimate_foreign_key_join(
+      const JoinNode& join_node, const OperatorJoinPredicate& join_predicate,
+      const TableStatistics& left_input_table_statistics, const TableStatistics& right_input_table_statistics,
+      const std::shared_ptr<TableStatistics>& output_table_statistics);
+
   static std::shared_ptr<TableStatistics> estimate_cross_join(const TableStatistics& left_input_table_statistics,
                                                               const TableStatistics& right_input_table_statistics);
   template <typename T>
@@ -126,5 +155,11 @@ class CardinalityEstimator : public AbstractCardinalityEstimator {
       const std::shared_ptr<TableStatistics>& table_statistics, const std::vector<ColumnID>& pruned_column_ids);
 
   /** @} */
+
+  const std::optional<JoinSamplingConfig> join_sampling_config;
+
+ private:
+  // Time spent on join sampling by this instance, limited by JoinSamplingConfig::time_budget
+  mutable std::chrono::microseconds _join_sampling_duration{0};
 };
 }  // namespace opossum
@@ -0,0 +1,43 @@
+#include "cardinality_feedback.hpp"
+
+#include <mutex>
+
+#include "statistics/table_statistics_maintainer.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+bool CardinalityFeedback::is_recordable(const AbstractLQPNode& node) {
+  return node.type == LQPNodeType::Join || node.type == LQPNodeType::Aggregate;
+}
+
+void CardinalityFeedback::record(const std::shared_ptr<AbstractLQPNode>& lqp, const Cardinality row_count) {
+  DebugAssert(is_recordable(*lqp), "Only joins and aggregates can be recorded");
+
+  const auto entry = Entry{row_count, TableStatisticsMaintainer::statistics_epoch()};
+
+  const auto lock = std::unique_lock{_mutex};
+  if (_entries.size() >= MAX_ENTRY_COUNT) _entries.clear();
+
+  _entries.insert_or_assign(lqp, entry);
+  _entry_count = _entries.size();
+}
+
+std::optional<Cardinality> CardinalityFeedback::lookup(const std::shared_ptr<AbstractLQPNode>& lqp) const {
+  const auto lock = std::shared_lock{_mutex};
+  const auto entry_iter = _entries.find(lqp);
+  if (entry_iter == _entries.end()) return std::nullopt;
+  if (entry_iter->second.statistics_epoch != TableStatisticsMaintainer::statistics_epoch()) return std::nullopt;
+
+  return entry_iter->second.row_count;
+}
+
+bool CardinalityFeedback::empty() const { return _entry_count == 0; }
+
+void CardinalityFeedback::clear() {
+  const auto lock = std::unique_lock{_mutex};
+  _entries.clear();
+  _entry_count = 0;
+}
+
+}  // namespace opossum
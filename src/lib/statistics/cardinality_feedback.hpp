@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Row counts observed during the execution of LQPs whose estimate was far off (see AdaptiveReoptimizer). The
+ * CardinalityEstimator uses them in place of its estimates for structurally equal LQPs, so that further optimizations
+ * of the same query start from the corrected cardinalities.
+ *
+ * The row counts are only valid as long as the statistics of the stored tables do not drift (see
+ * TableStatisticsMaintainer::statistics_epoch()). Older entries are ignored.
+ */
+class CardinalityFeedback {
+ public:
+  // Once exceeded, all entries are removed
+  static constexpr auto MAX_ENTRY_COUNT = size_t{10'000};
+
+  // Only the checkpoints of the AdaptiveReoptimizer, i.e., joins and aggregates, are recorded. Looking up other nodes
+  // would only hash their LQPs in vain.
+  static bool is_recordable(const AbstractLQPNode& node);
+
+  // @param lqp must not be modified afterwards
+  void record(const std::shared_ptr<AbstractLQPNode>& lqp, const Cardinality row_count);
+
+  std::optional<Cardinality> lookup(const std::shared_ptr<AbstractLQPNode>& lqp) const;
+
+  // Cheap check so that the CardinalityEstimator does not need to hash LQPs if there is no feedback
+  bool empty() const;
+
+  void clear();
+
+ private:
+  struct Entry {
+    Cardinality row_count;
+    size_t statistics_epoch;
+  };
+
+  mutable std::shared_mutex _mutex;
+  LQPNodeUnorderedMap<Entry> _entries;
+  std::atomic<size_t> _entry_count{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,167 @@
+#include "column_pair_statistics.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "resolve_type.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of rows per combination of the hashed values of both columns
+using Combination = std::pair<size_t, size_t>;
+using RowCountsByCombination = std::unordered_map<Combination, size_t, boost::hash<Combination>>;
+
+// Hashes the values of a segment. NULLs are marked in @param is_null.
+void hash_segment(const BaseSegment& segment, std::vector<size_t>& hashes, std::vector<bool>& is_null) {
+  hashes.resize(segment.size());
+  is_null.resize(segment.size());
+
+  resolve_data_type(segment.data_type(), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+      is_null[position.chunk_offset()] = position.is_null();
+      if (!position.is_null()) {
+        hashes[position.chunk_offset()] = std::hash<ColumnDataType>{}(position.value());
+      }
+    });
+  });
+}
+
+/**
+ * Computes the degree of the functional dependency `determinant -> dependent` from the number of rows per combination
+ * of values: a value of the determinant supports the dependency if it occurs with a single dependent value only.
+ */
+float dependency_degree(const RowCountsByCombination& row_counts_by_combination,
+                        const bool first_is_determinant, const size_t row_count) {
+  if (row_count == 0) return 0.0f;
+
+  // Number of rows and of distinct dependent values per determinant value
+  auto row_counts_and_dependent_counts = std::unordered_map<size_t, std::pair<size_t, size_t>>{};
+  for (const auto& [combination, combination_row_count] : row_counts_by_combination) {
+    auto& [determinant_row_count, dependent_count] =
+        row_counts_and_dependent_counts[first_is_determinant ? combination.first : combination.second];
+    determinant_row_count += combination_row_count;
+    ++dependent_count;
+  }
+
+  auto supporting_row_count = size_t{0};
+  for (const auto& [determinant, counts] : row_counts_and_dependent_counts) {
+    if (counts.second == 1) supporting_row_count += counts.first;
+  }
+
+  return static_cast<float>(supporting_row_count) / static_cast<float>(row_count);
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::shared_ptr<ColumnPairStatistics> ColumnPairStatistics::from_table(const Table& table,
+                                                                       const ColumnID first_column_id,
+                                                                       const ColumnID second_column_id,
+                                                                       const std::optional<size_t>& sample_row_count) {
+  Assert(first_column_id != second_column_id, "ColumnPairStatistics require two different columns");
+
+  const auto chunk_ids = TableStatistics::sample_chunk_ids(
+      table, sample_row_count.value_or(
+                 table.statistics_sample_row_count().value_or(DEFAULT_STATISTICS_SAMPLE_ROW_COUNT)));
+
+  auto row_counts_by_combination = RowCountsByCombination{};
+  auto row_count = size_t{0};
+
+  auto first_hashes = std::vector<size_t>{};
+  auto second_hashes = std::vector<size_t>{};
+  auto first_is_null = std::vector<bool>{};
+  auto second_is_null = std::vector<bool>{};
+  for (const auto chunk_id : chunk_ids) {
+    const auto chunk = table.get_chunk(chunk_id);
+    hash_segment(*chunk->get_segment(first_column_id), first_hashes, first_is_null);
+    hash_segment(*chunk->get_segment(second_column_id), second_hashes, second_is_null);
+
+    const auto chunk_size = chunk->size();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      if (first_is_null[chunk_offset] || second_is_null[chunk_offset]) continue;
+
+      ++row_counts_by_combination[{first_hashes[chunk_offset], second_hashes[chunk_offset]}];
+      ++row_count;
+    }
+  }
+
+  return std::make_shared<ColumnPairStatistics>(first_column_id, second_column_id,
+                                                dependency_degree(row_counts_by_combination, true, row_count),
+                                                dependency_degree(row_counts_by_combination, false, row_count));
+}
+
+ColumnPairStatistics::ColumnPairStatistics(const ColumnID init_first_column_id, const ColumnID init_second_column_id,
+                                           const float init_first_determines_second,
+                                           const float init_second_determines_first)
+    : first_column_id(init_first_column_id),
+      second_column_id(init_second_column_id),
+      first_determines_second(init_first_determines_second),
+      second_determines_first(init_second_determines_first) {}
+
+Selectivity ColumnPairStatistics::estimate_conditional_selectivity(const ColumnID column_id,
+                                                                   const Selectivity selectivity,
+                                                                   const Selectivity other_selectivity) const {
+  DebugAssert(column_id == first_column_id || column_id == second_column_id, "Column is not part of the pair");
+  if (other_selectivity <= 0.0f) return selectivity;
+
+  // Use the stronger of the two dependencies. If `other -> column` holds, the rows that pass the predicate on the
+  // other column most likely pass the predicate on this column as well, and vice versa.
+  const auto column_is_second = column_id == second_column_id;
+  const auto other_determines_column = column_is_second ? first_determines_second : second_determines_first;
+  const auto column_determines_other = column_is_second ? second_determines_first : first_determines_second;
+
+  auto conjunction_selectivity = Selectivity{0};
+  if (other_determines_column >= column_determines_other) {
+    conjunction_selectivity =
+        other_selectivity * (other_determines_column + (1.0f - other_determines_column) * selectivity);
+  } else {
+    conjunction_selectivity =
+        selectivity * (column_determines_other + (1.0f - column_determines_other) * other_selectivity);
+  }
+
+  // The conjunction cannot be more selective than assumed by independence or less selective than either predicate
+  conjunction_selectivity = std::clamp(conjunction_selectivity, selectivity * other_selectivity,
+                                       std::min(selectivity, other_selectivity));
+
+  return conjunction_selectivity / other_selectivity;
+}
+
+void add_column_pair_statistics(Table& table, const std::vector<std::pair<ColumnID, ColumnID>>& column_pairs) {
+  const auto table_statistics = table.table_statistics();
+  Assert(table_statistics, "Table must have statistics");
+
+  auto column_statistics = table_statistics->column_statistics;
+  const auto new_table_statistics =
+      std::make_shared<TableStatistics>(std::move(column_statistics), table_statistics->row_count);
+
+  for (const auto& existing_statistics : table_statistics->column_pair_statistics_list) {
+    const auto replaced = std::any_of(column_pairs.cbegin(), column_pairs.cend(), [&](const auto& column_pair) {
+      return std::minmax(column_pair.first, column_pair.second) ==
+             std::minmax(existing_statistics->first_column_id, existing_statistics->second_column_id);
+    });
+    if (!replaced) new_table_statistics->column_pair_statistics_list.emplace_back(existing_statistics);
+  }
+
+  for (const auto& [first_column_id, second_column_id] : column_pairs) {
+    new_table_statistics->column_pair_statistics_list.emplace_back(
+        ColumnPairStatistics::from_table(table, first_column_id, second_column_id));
+  }
+
+  table.set_table_statistics(new_table_statistics);
+}
+
+}  // namespace opossum
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Statistics on the correlation of two columns of a stored table, used by the CardinalityEstimator for conjunctions of
+ * predicates on both columns. Without them, predicates are assumed to be independent, which underestimates
+ * correlated predicates (e.g., `production_year > 2000 AND kind_id = 1`) by orders of magnitude.
+ *
+ * The correlation is captured as the degree of the functional dependencies between the columns in both directions,
+ * similar to PostgreSQL's extended statistics: The degree of `a -> b` is the share of rows whose value of `a` always
+ * occurs with the same value of `b`. Given the degree d, the selectivity of a conjunction is estimated as
+ * P(a AND b) = P(a) * (d + (1 - d) * P(b)). Other than a two-dimensional histogram, this applies to all kinds of
+ * predicates and only needs two numbers per column pair.
+ */
+class ColumnPairStatistics {
+ public:
+  /**
+   * Computes the dependency degrees from a block sample of @param table (see TableStatistics::sample_chunk_ids()). The
+   * sample size defaults to the one of the TableStatistics. Rows with NULLs in either column are ignored.
+   */
+  static std::shared_ptr<ColumnPairStatistics> from_table(const Table& table, const ColumnID first_column_id,
+                                                          const ColumnID second_column_id,
+                                                          const std::optional<size_t>& sample_row_count = std::nullopt);
+
+  ColumnPairStatistics(const ColumnID init_first_column_id, const ColumnID init_second_column_id,
+                       const float init_first_determines_second, const float init_second_determines_first);
+
+  /**
+   * Estimates the selectivity of a predicate on @param column_id on rows that passed a predicate on the other column
+   * of the pair. @param selectivity and @param other_selectivity are the selectivities of the two predicates on the
+   * entire table.
+   */
+  Selectivity estimate_conditional_selectivity(const ColumnID column_id, const Selectivity selectivity,
+                                               const Selectivity other_selectivity) const;
+
+  const ColumnID first_column_id;
+  const ColumnID second_column_id;
+
+  // Degrees of the functional dependencies `first -> second` and `second -> first`, between 0 and 1
+  const float first_determines_second;
+  const float second_determines_first;
+};
+
+/**
+ * Computes the ColumnPairStatistics for @param column_pairs and publishes a copy of the TableStatistics of @param
+ * table that includes them. Existing statistics on the same pairs are replaced.
+ */
+void add_column_pair_statistics(Table& table, const std::vector<std::pair<ColumnID, ColumnID>>& column_pairs);
+
+}  // namespace opossum
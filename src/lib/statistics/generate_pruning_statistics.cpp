@@ -1,26 +1,34 @@
 #include "generate_pruning_statistics.hpp"
 
-#include <atomic>
-#include <iostream>
-#include <thread>
-#include <unordered_set>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-#include "operators/table_wrapper.hpp"
+#include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
 #include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/bloom_filter.hpp"
+#include "statistics/statistics_objects/distinct_count_sketch.hpp"
 #include "statistics/statistics_objects/equal_distinct_count_histogram.hpp"
-#include "statistics/statistics_objects/generic_histogram_builder.hpp"
 #include "statistics/statistics_objects/min_max_filter.hpp"
 #include "statistics/statistics_objects/null_value_ratio_statistics.hpp"
 #include "statistics/statistics_objects/range_filter.hpp"
-#include "statistics/table_statistics.hpp"
-#include "storage/create_iterable_from_segment.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/row_version_store.hpp"
+#include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 
 namespace {
 
 using namespace opossum;  // NOLINT
 
+// The histograms of chunks only need to be precise enough to be merged into the histograms of their tables
+constexpr auto CHUNK_HISTOGRAM_BIN_COUNT = BinID{10};
+
 template <typename T>
 void create_pruning_statistics_for_segment(AttributeStatistics<T>& segment_statistics,
                                            const pmr_vector<T>& dictionary) {
@@ -36,6 +44,52 @@ void create_pruning_statistics_for_segment(AttributeStatistics<T>& segment_stati
   if (pruning_statistics) {
     segment_statistics.set_statistics_object(pruning_statistics);
   }
+
+  // Equality predicates on a single value are already answered exactly by the filters above
+  if (dictionary.size() > 1) {
+    segment_statistics.set_statistics_object(BloomFilter<T>::build_filter(dictionary));
+  }
+}
+
+/**
+ * Creates the statistics of a segment from its sorted, distinct non-null values and the number of occurrences of each
+ * of them. The histogram, the null value ratio, and the distinct count sketch of the segment are not used for
+ * pruning. The TableStatisticsMaintainer merges them into the statistics of the table when the chunk is added.
+ */
+template <typename T>
+void create_statistics_for_segment(AttributeStatistics<T>& segment_statistics, const pmr_vector<T>& dictionary,
+                                   const std::vector<HistogramCountType>& value_counts, const size_t segment_size) {
+  create_pruning_statistics_for_segment(segment_statistics, dictionary);
+
+  const auto distinct_count_sketch = std::make_shared<DistinctCountSketch<T>>();
+  auto value_count = HistogramCountType{0};
+  auto value_distribution = std::vector<std::pair<T, HistogramCountType>>{};
+  value_distribution.reserve(dictionary.size());
+  for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+    distinct_count_sketch->add(dictionary[value_id]);
+    value_distribution.emplace_back(dictionary[value_id], value_counts[value_id]);
+    value_count += value_counts[value_id];
+  }
+
+  // Strings are not mapped into the histogram domain before, as the pruning filters have to contain the actual values
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    const auto domain = HistogramDomain<pmr_string>{};
+    auto domain_value_counts = std::unordered_map<pmr_string, HistogramCountType>{};
+    for (const auto& [value, count] : value_distribution) {
+      domain_value_counts[domain.contains(value) ? value : domain.string_to_domain(value)] += count;
+    }
+    value_distribution.assign(domain_value_counts.begin(), domain_value_counts.end());
+    std::sort(value_distribution.begin(), value_distribution.end(),
+              [&](const auto& l, const auto& r) { return l.first < r.first; });
+  }
+
+  segment_statistics.set_statistics_object(
+      EqualDistinctCountHistogram<T>::from_distribution(std::move(value_distribution), CHUNK_HISTOGRAM_BIN_COUNT));
+  segment_statistics.set_statistics_object(distinct_count_sketch);
+
+  const auto null_value_ratio =
+      segment_size == 0 ? 0.0f : 1.0f - static_cast<float>(value_count) / static_cast<float>(segment_size);
+  segment_statistics.set_statistics_object(std::make_shared<NullValueRatioStatistics>(null_value_ratio));
 }
 
 }  // namespace
@@ -49,6 +103,13 @@ void generate_chunk_pruning_statistics(const std::shared_ptr<Chunk>& chunk) {
     return;
   }
 
+  // The segments of chunks with rows that were updated in place do not contain the current values of these rows (see
+  // RowVersionStore). Thus, such chunks must not be pruned based on their segments.
+  if (chunk->has_mvcc_data()) {
+    const auto row_versions = chunk->mvcc_data()->row_versions();
+    if (row_versions && !row_versions->empty()) return;
+  }
+
   auto chunk_statistics = ChunkPruningStatistics{chunk->column_count()};
 
   for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
@@ -61,22 +122,37 @@ void generate_chunk_pruning_statistics(const std::shared_ptr<Chunk>& chunk) {
       const auto segment_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
 
       if constexpr (std::is_same_v<SegmentType, DictionarySegment<ColumnDataType>>) {
-        // we can use the fact that dictionary segments have an accessor for the dictionary
+        // We can use the fact that dictionary segments have an accessor for the dictionary. The occurrences of the
+        // values are counted on the attribute vector.
         const auto& dictionary = *typed_segment.dictionary();
-        create_pruning_statistics_for_segment(*segment_statistics, dictionary);
-      } else {
-        // if we have a generic segment we create the dictionary ourselves
-        auto iterable = create_iterable_from_segment<ColumnDataType>(typed_segment);
-        std::unordered_set<ColumnDataType> values;
-        iterable.for_each([&](const auto& value) {
-          // we are only interested in non-null values
-          if (!value.is_null()) {
-            values.insert(value.value());
+        const auto null_value_id = typed_segment.null_value_id();
+        auto value_counts = std::vector<HistogramCountType>(dictionary.size());
+        resolve_compressed_vector_type(*typed_segment.attribute_vector(), [&](const auto& attribute_vector) {
+          for (const auto value_id : attribute_vector) {
+            if (static_cast<ValueID>(value_id) != null_value_id) ++value_counts[value_id];
           }
         });
-        pmr_vector<ColumnDataType> dictionary{values.cbegin(), values.cend()};
+        create_statistics_for_segment(*segment_statistics, dictionary, value_counts, typed_segment.size());
+      } else {
+        // If we have a generic segment, we create the dictionary ourselves
+        auto value_counts_by_value = std::unordered_map<ColumnDataType, HistogramCountType>{};
+        segment_iterate<ColumnDataType>(typed_segment, [&](const auto& position) {
+          if (!position.is_null()) ++value_counts_by_value[position.value()];
+        });
+
+        auto dictionary = pmr_vector<ColumnDataType>{};
+        dictionary.reserve(value_counts_by_value.size());
+        for (const auto& [value, count] : value_counts_by_value) {
+          dictionary.emplace_back(value);
+        }
         std::sort(dictionary.begin(), dictionary.end());
-        create_pruning_statistics_for_segment(*segment_statistics, dictionary);
+
+        auto value_counts = std::vector<HistogramCountType>{};
+        value_counts.reserve(dictionary.size());
+        for (const auto& value : dictionary) {
+          value_counts.emplace_back(value_counts_by_value[value]);
+        }
+        create_statistics_for_segment(*segment_statistics, dictionary, value_counts, typed_segment.size());
       }
 
       chunk_statistics[column_id] = segment_statistics;
@@ -87,6 +163,8 @@ void generate_chunk_pruning_statistics(const std::shared_ptr<Chunk>& chunk) {
 }
 
 void generate_chunk_pruning_statistics(const std::shared_ptr<Table>& table) {
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+
   const auto chunk_count = table->chunk_count();
   for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
     const auto chunk = table->get_chunk(chunk_id);
@@ -95,8 +173,10 @@ void generate_chunk_pruning_statistics(const std::shared_ptr<Table>& table) {
       continue;
     }
 
-    generate_chunk_pruning_statistics(chunk);
+    jobs.emplace_back(std::make_shared<JobTask>([chunk]() { generate_chunk_pruning_statistics(chunk); }));
   }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 }
 
 }  // namespace opossum
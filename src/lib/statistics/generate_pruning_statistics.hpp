@@ -9,12 +9,14 @@ class Chunk;
 class Table;
 
 /**
- * Generate Pruning Filters for an immutable Chunk
+ * Generate Pruning Filters for an immutable Chunk. Next to the filters, the statistics of each segment contain a small
+ * histogram, the null value ratio, and a DistinctCountSketch. These are not used for pruning, but to update the
+ * statistics of the table when the chunk is added to it (see TableStatisticsMaintainer).
  */
 void generate_chunk_pruning_statistics(const std::shared_ptr<Chunk>& chunk);
 
 /**
- * Generate Pruning Filters for all immutable Chunks in this Table
+ * Generate Pruning Filters for all immutable Chunks in this Table. The chunks are processed in parallel.
  */
 void generate_chunk_pruning_statistics(const std::shared_ptr<Table>& table);
 
@@ -140,4 +140,9 @@ void JoinGraphStatisticsCache::set(const Bitmask& bitmask,
 
   _cache.emplace(bitmask, std::move(cache_entry));
 }
+
+size_t JoinGraphStatisticsCache::vertex_count() const { return _vertex_indices.size(); }
+
+void JoinGraphStatisticsCache::clear() { _cache.clear(); }
+
 }  // namespace opossum
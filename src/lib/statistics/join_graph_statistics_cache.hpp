@@ -65,6 +65,12 @@ class JoinGraphStatisticsCache {
   void set(const Bitmask& bitmask, const std::vector<std::shared_ptr<AbstractExpression>>& column_order,
            const std::shared_ptr<TableStatistics>& table_statistics);
 
+  // Number of vertices of the JoinGraph
+  size_t vertex_count() const;
+
+  // Removes all entries, e.g., because the statistics of a stored table changed. The bitmasks remain valid.
+  void clear();
+
  private:
   const VertexIndexMap _vertex_indices;
   const PredicateIndexMap _predicate_indices;
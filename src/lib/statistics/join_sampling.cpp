@@ -0,0 +1,151 @@
+#include "join_sampling.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/lqp_translator.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/abstract_operator.hpp"
+#include "scheduler/operator_task.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Checks whether executing @param lqp on samples of its stored tables yields a sample of its output
+bool is_sampleable(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  auto sampleable = true;
+
+  visit_lqp(lqp, [&](const auto& node) {
+    switch (node->type) {
+      case LQPNodeType::Join: {
+        const auto join_mode = static_cast<const JoinNode&>(*node).join_mode;
+        // Semi and anti joins filter their left input depending on the right one, which is sampled as well. Outer
+        // joins add rows that do not have a join partner in the sample.
+        if (join_mode != JoinMode::Inner && join_mode != JoinMode::Cross) sampleable = false;
+      } break;
+
+      case LQPNodeType::Alias:
+      case LQPNodeType::Predicate:
+      case LQPNodeType::Projection:
+      case LQPNodeType::Sort:
+      case LQPNodeType::StoredTable:
+      case LQPNodeType::Validate:
+        break;
+
+      default:
+        sampleable = false;
+    }
+
+    // Subqueries would be executed on the full data, parameters have no values during optimization
+    for (const auto& expression : node->node_expressions) {
+      visit_expression(expression, [&](const auto& sub_expression) {
+        if (sub_expression->type == ExpressionType::LQPSubquery ||
+            sub_expression->type == ExpressionType::Placeholder ||
+            sub_expression->type == ExpressionType::CorrelatedParameter) {
+          sampleable = false;
+        }
+        return sampleable ? ExpressionVisitation::VisitArguments : ExpressionVisitation::DoNotVisitArguments;
+      });
+    }
+
+    return sampleable ? LQPVisitation::VisitInputs : LQPVisitation::DoNotVisitInputs;
+  });
+
+  return sampleable;
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::optional<Cardinality> sample_cardinality(const std::shared_ptr<AbstractLQPNode>& lqp,
+                                              const JoinSamplingConfig& config,
+                                              const Cardinality estimated_cardinality) {
+  if (!is_sampleable(lqp)) return std::nullopt;
+
+  auto sample_lqp = lqp->deep_copy();
+
+  auto validate_nodes = std::vector<std::shared_ptr<AbstractLQPNode>>{};
+  auto stored_table_nodes = std::vector<std::shared_ptr<StoredTableNode>>{};
+  visit_lqp(sample_lqp, [&](const auto& node) {
+    if (node->type == LQPNodeType::Validate) validate_nodes.emplace_back(node);
+    if (node->type == LQPNodeType::StoredTable) {
+      stored_table_nodes.emplace_back(std::static_pointer_cast<StoredTableNode>(node));
+    }
+    return LQPVisitation::VisitInputs;
+  });
+
+  // Without ValidateNodes, the sampled plan can be executed without a transaction. Invalidated rows are rare enough to
+  // be neglected for the estimation.
+  for (const auto& validate_node : validate_nodes) {
+    if (validate_node == sample_lqp) {
+      sample_lqp = sample_lqp->left_input();
+    } else {
+      lqp_remove_node(validate_node);
+    }
+  }
+
+  /**
+   * Restrict each stored table to a block sample by pruning all other chunks. The sampled output row count is scaled by
+   * the inverse of the product of all sampling rates.
+   */
+  auto scale_factor = 1.0;
+  for (const auto& stored_table_node : stored_table_nodes) {
+    const auto table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+    const auto& pruned_chunk_ids = stored_table_node->pruned_chunk_ids();
+    const auto is_pruned = [&](const auto chunk_id) {
+      return std::binary_search(pruned_chunk_ids.begin(), pruned_chunk_ids.end(), chunk_id);
+    };
+
+    auto available_row_count = size_t{0};
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (chunk && !is_pruned(chunk_id)) available_row_count += chunk->size();
+    }
+    if (available_row_count <= config.sample_row_count) continue;
+
+    auto sampled_chunk_ids = TableStatistics::sample_chunk_ids(*table, config.sample_row_count);
+    sampled_chunk_ids.erase(std::remove_if(sampled_chunk_ids.begin(), sampled_chunk_ids.end(), is_pruned),
+                            sampled_chunk_ids.end());
+
+    auto sampled_row_count = size_t{0};
+    for (const auto chunk_id : sampled_chunk_ids) {
+      sampled_row_count += table->get_chunk(chunk_id)->size();
+    }
+    if (sampled_row_count == 0) return std::nullopt;
+
+    scale_factor *= static_cast<double>(available_row_count) / static_cast<double>(sampled_row_count);
+
+    auto sample_pruned_chunk_ids = std::vector<ChunkID>{};
+    auto sampled_chunk_iter = sampled_chunk_ids.begin();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      if (sampled_chunk_iter != sampled_chunk_ids.end() && *sampled_chunk_iter == chunk_id) {
+        ++sampled_chunk_iter;
+        continue;
+      }
+      sample_pruned_chunk_ids.emplace_back(chunk_id);
+    }
+    stored_table_node->set_pruned_chunk_ids(sample_pruned_chunk_ids);
+  }
+
+  if (estimated_cardinality / scale_factor > config.max_sample_output_row_count) return std::nullopt;
+
+  const auto pqp = LQPTranslator{}.translate_node(sample_lqp);
+  const auto tasks = OperatorTask::make_tasks_from_operator(pqp);
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+  const auto sampled_output_row_count = pqp->get_output()->row_count();
+  if (sampled_output_row_count == 0 && scale_factor > 1.0) return std::nullopt;
+
+  return static_cast<Cardinality>(static_cast<double>(sampled_output_row_count) * scale_factor);
+}
+
+}  // namespace opossum
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+
+/**
+ * Configures the estimation of join cardinalities by executing the joins on a sample of the data (see
+ * sample_cardinality()). Histogram-based estimates of join chains multiply their errors, so that the estimates for
+ * large join graphs are often off by orders of magnitude. Join sampling avoids this at the cost of executing joins
+ * during optimization, which is why it is limited to large join graphs and to a time budget.
+ *
+ * Join sampling is enabled by creating the optimizer with a JoinSamplingConfig (see
+ * Optimizer::create_default_optimizer()) and passing it to the SQLPipelineBuilder, e.g., for selected queries only.
+ */
+struct JoinSamplingConfig {
+  // Join graphs with fewer vertices are estimated with histograms only
+  size_t min_vertex_count{6};
+
+  // Maximum number of rows sampled per stored table. The sample consists of entire chunks.
+  size_t sample_row_count{100'000};
+
+  // Time that the estimation of a single join graph may spend on sampling. Once it is used up, the remaining joins are
+  // estimated with histograms.
+  std::chrono::microseconds time_budget{std::chrono::milliseconds{200}};
+
+  // Plans whose output on the sample is expected to exceed this number of rows are not sampled, as executing them
+  // would take too long
+  Cardinality max_sample_output_row_count{1'000'000};
+};
+
+/**
+ * Estimates the output cardinality of @param lqp by executing it on a sample of each stored table it reads. The result
+ * is scaled by the inverse sampling rates. ValidateNodes are ignored.
+ *
+ * Returns std::nullopt if the plan cannot be sampled, i.e., if it contains nodes other than inner and cross joins,
+ * predicates without subqueries or parameters, projections, aliases, sorts, validates, and stored tables, or if its
+ * output on the sample, based on @param estimated_cardinality, would be too large. If the sampled output is empty even
+ * though not all rows were sampled, std::nullopt is returned as well, as zero is unlikely to be a good estimate.
+ */
+std::optional<Cardinality> sample_cardinality(const std::shared_ptr<AbstractLQPNode>& lqp,
+                                              const JoinSamplingConfig& config,
+                                              const Cardinality estimated_cardinality);
+
+}  // namespace opossum
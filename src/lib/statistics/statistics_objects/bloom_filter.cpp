@@ -0,0 +1,109 @@
+#include "bloom_filter.hpp"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Odd constants that derive the eight bit positions of a value from a single 32-bit hash (as in Impala's and Parquet's
+// split block Bloom filters)
+constexpr auto SALTS = std::array<uint32_t, 8>{0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                               0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+template <typename T>
+uint64_t mixed_hash(const T& value) {
+  // std::hash is the identity for integers. Thus, the bits of the hash are mixed using the finalizer of MurmurHash3.
+  auto hash = static_cast<uint64_t>(std::hash<T>{}(value));
+  hash ^= hash >> 33u;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33u;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33u;
+  return hash;
+}
+
+// The upper 32 bits of the hash select the block, the lower 32 bits select one bit in each word of the block
+size_t block_index(const uint64_t hash, const size_t block_count) {
+  return static_cast<size_t>(((hash >> 32u) * static_cast<uint64_t>(block_count)) >> 32u);
+}
+
+uint64_t word_mask(const uint64_t hash, const size_t word_index) {
+  return uint64_t{1} << ((static_cast<uint32_t>(hash) * SALTS[word_index]) >> 26u);
+}
+
+}  // namespace
+
+namespace opossum {
+
+template <typename T>
+BloomFilter<T>::BloomFilter(std::shared_ptr<const std::vector<Block>> init_blocks)
+    : AbstractStatisticsObject(data_type_from_type<T>()), blocks(std::move(init_blocks)) {
+  DebugAssert(blocks && !blocks->empty(), "BloomFilter needs at least one block");
+}
+
+template <typename T>
+std::unique_ptr<BloomFilter<T>> BloomFilter<T>::build_filter(const pmr_vector<T>& dictionary) {
+  if (dictionary.empty()) return nullptr;
+
+  constexpr auto BITS_PER_BLOCK = sizeof(Block::words) * 8;
+  const auto block_count = (dictionary.size() * BITS_PER_VALUE + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+
+  auto filter_blocks = std::vector<Block>(block_count);
+  for (const auto& value : dictionary) {
+    const auto hash = mixed_hash(value);
+    auto& block = filter_blocks[block_index(hash, block_count)];
+    for (auto word_index = size_t{0}; word_index < block.words.size(); ++word_index) {
+      block.words[word_index] |= word_mask(hash, word_index);
+    }
+  }
+
+  return std::make_unique<BloomFilter<T>>(std::make_shared<const std::vector<Block>>(std::move(filter_blocks)));
+}
+
+template <typename T>
+bool BloomFilter<T>::may_contain(const T& value) const {
+  const auto hash = mixed_hash(value);
+  const auto& block = (*blocks)[block_index(hash, blocks->size())];
+  for (auto word_index = size_t{0}; word_index < block.words.size(); ++word_index) {
+    const auto mask = word_mask(hash, word_index);
+    if ((block.words[word_index] & mask) != mask) return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool BloomFilter<T>::does_not_contain(const PredicateCondition predicate_condition,
+                                      const AllTypeVariant& variant_value,
+                                      const std::optional<AllTypeVariant>& variant_value2) const {
+  if (predicate_condition != PredicateCondition::Equals || variant_is_null(variant_value)) return false;
+
+  // We expect the caller (e.g., the ChunkPruningRule) to handle type-safe conversions. Boost will throw an exception
+  // if this was not done.
+  return !may_contain(boost::get<T>(variant_value));
+}
+
+template <typename T>
+std::shared_ptr<AbstractStatisticsObject> BloomFilter<T>::sliced(
+    const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+    const std::optional<AllTypeVariant>& variant_value2) const {
+  if (does_not_contain(predicate_condition, variant_value, variant_value2)) {
+    return nullptr;
+  }
+
+  return std::make_shared<BloomFilter<T>>(blocks);
+}
+
+template <typename T>
+std::shared_ptr<AbstractStatisticsObject> BloomFilter<T>::scaled(const Selectivity /*selectivity*/) const {
+  return std::make_shared<BloomFilter<T>>(blocks);
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(BloomFilter);
+
+}  // namespace opossum
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "abstract_statistics_object.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Filters are data structures that are primarily used for probabilistic membership queries. In Hyrise, they are
+ * typically created on a single segment. They can then be used to check whether a certain value exists in the segment.
+ *
+ * The BloomFilter answers equality lookups. MinMaxFilters and RangeFilters can only prune values outside the range of
+ * a segment, which does not help for unsorted columns with a large value range (e.g., customer ids). If the filter
+ * claims that a value is not contained, it is guaranteed not to be. Otherwise, the value is contained with a false
+ * positive rate of about 1% for BITS_PER_VALUE = 10.
+ *
+ * The filter is blocked (Putze et al., "Cache-, Hash- and Space-Efficient Bloom Filters", 2007): each value sets one
+ * bit in each of the eight words of a single 512-bit block, so that a lookup touches one cache line only.
+ */
+template <typename T>
+class BloomFilter : public AbstractStatisticsObject {
+ public:
+  static constexpr auto BITS_PER_VALUE = size_t{10};
+
+  struct alignas(64) Block {
+    std::array<uint64_t, 8> words{};
+  };
+
+  explicit BloomFilter(std::shared_ptr<const std::vector<Block>> init_blocks);
+
+  // Builds a filter that holds all values of @param dictionary. Returns nullptr if @param dictionary is empty.
+  static std::unique_ptr<BloomFilter<T>> build_filter(const pmr_vector<T>& dictionary);
+
+  bool may_contain(const T& value) const;
+
+  // Returns true only for Equals predicates on values that are guaranteed not to be contained
+  bool does_not_contain(const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+                        const std::optional<AllTypeVariant>& variant_value2 = std::nullopt) const;
+
+  // As the filter cannot remove values, slicing only checks whether the result is empty (then, nullptr is returned)
+  std::shared_ptr<AbstractStatisticsObject> sliced(
+      const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+      const std::optional<AllTypeVariant>& variant_value2 = std::nullopt) const override;
+
+  std::shared_ptr<AbstractStatisticsObject> scaled(const Selectivity selectivity) const override;
+
+  // The blocks are never modified after the filter was built, so sliced and scaled filters share them
+  const std::shared_ptr<const std::vector<Block>> blocks;
+};
+
+}  // namespace opossum
@@ -0,0 +1,79 @@
+#include "distinct_count_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+template <typename T>
+DistinctCountSketch<T>::DistinctCountSketch()
+    : AbstractStatisticsObject(data_type_from_type<T>()), _registers(size_t{1} << PRECISION) {}
+
+template <typename T>
+void DistinctCountSketch<T>::add(const T& value) {
+  // std::hash is the identity for integers. Thus, the bits of the hash are mixed using the finalizer of MurmurHash3.
+  auto hash = static_cast<uint64_t>(std::hash<T>{}(value));
+  hash ^= hash >> 33u;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33u;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33u;
+
+  // The first PRECISION bits select the register, the remaining bits determine the rank
+  const auto register_id = hash >> (64 - PRECISION);
+  const auto remaining_bits = hash << PRECISION;
+  const auto rank =
+      static_cast<uint8_t>(remaining_bits == 0 ? 64 - PRECISION + 1 : __builtin_clzll(remaining_bits) + 1);
+
+  _registers[register_id] = std::max(_registers[register_id], rank);
+}
+
+template <typename T>
+void DistinctCountSketch<T>::merge(const DistinctCountSketch<T>& other) {
+  for (auto register_id = size_t{0}; register_id < _registers.size(); ++register_id) {
+    _registers[register_id] = std::max(_registers[register_id], other._registers[register_id]);
+  }
+}
+
+template <typename T>
+Cardinality DistinctCountSketch<T>::estimate_distinct_count() const {
+  const auto register_count = static_cast<double>(_registers.size());
+
+  auto inverse_sum = 0.0;
+  auto empty_register_count = size_t{0};
+  for (const auto rank : _registers) {
+    inverse_sum += std::ldexp(1.0, -rank);
+    if (rank == 0) ++empty_register_count;
+  }
+
+  const auto alpha = 0.7213 / (1.0 + 1.079 / register_count);
+  const auto estimate = alpha * register_count * register_count / inverse_sum;
+
+  // For small cardinalities, where many registers are still empty, linear counting is more accurate
+  if (estimate <= 2.5 * register_count && empty_register_count > 0) {
+    return static_cast<Cardinality>(register_count *
+                                    std::log(register_count / static_cast<double>(empty_register_count)));
+  }
+
+  return static_cast<Cardinality>(estimate);
+}
+
+template <typename T>
+std::shared_ptr<AbstractStatisticsObject> DistinctCountSketch<T>::sliced(
+    const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+    const std::optional<AllTypeVariant>& variant_value2) const {
+  return nullptr;
+}
+
+template <typename T>
+std::shared_ptr<AbstractStatisticsObject> DistinctCountSketch<T>::scaled(const Selectivity selectivity) const {
+  return nullptr;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(DistinctCountSketch);
+
+}  // namespace opossum
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "abstract_statistics_object.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * HyperLogLog sketch (Flajolet et al., "HyperLogLog: the analysis of a near-optimal cardinality estimation
+ * algorithm", 2007) that estimates the number of distinct values of a segment or column. In contrast to the distinct
+ * counts of histograms, the sketches of multiple segments can be merged into a sketch of their union. Chunks carry
+ * them so that the TableStatisticsMaintainer can update the distinct counts of a table when chunks are added.
+ *
+ * With 2^PRECISION registers of one byte each, the standard error of the estimation is 1.04 / sqrt(2^PRECISION), i.e.,
+ * about 3%.
+ */
+template <typename T>
+class DistinctCountSketch : public AbstractStatisticsObject {
+ public:
+  static constexpr auto PRECISION = size_t{10};
+
+  DistinctCountSketch();
+
+  void add(const T& value);
+
+  // Adds the values of @param other to this sketch
+  void merge(const DistinctCountSketch<T>& other);
+
+  Cardinality estimate_distinct_count() const;
+
+  // The values that a sketch represents cannot be sliced or scaled. Both return nullptr.
+  std::shared_ptr<AbstractStatisticsObject> sliced(
+      const PredicateCondition predicate_condition, const AllTypeVariant& variant_value,
+      const std::optional<AllTypeVariant>& variant_value2 = std::nullopt) const override;
+
+  std::shared_ptr<AbstractStatisticsObject> scaled(const Selectivity selectivity) const override;
+
+ private:
+  // Each register holds the highest rank (i.e., the position of the first set bit) of the hashes assigned to it
+  std::vector<uint8_t> _registers;
+};
+
+}  // namespace opossum
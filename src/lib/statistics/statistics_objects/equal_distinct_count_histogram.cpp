@@ -16,26 +16,6 @@ namespace {
 
 using namespace opossum;  // NOLINT
 
-template <typename T>
-void add_segment_to_value_distribution(const BaseSegment& segment,
-                                       std::unordered_map<T, HistogramCountType>& value_distribution,
-                                       const HistogramDomain<T>& domain) {
-  segment_iterate<T>(segment, [&](const auto& iterator_value) {
-    if (iterator_value.is_null()) return;
-
-    if constexpr (std::is_same_v<T, pmr_string>) {
-      // Do "contains()" check first to avoid the string copy incurred by string_to_domain() where possible
-      if (domain.contains(iterator_value.value())) {
-        ++value_distribution[iterator_value.value()];
-      } else {
-        ++value_distribution[domain.string_to_domain(iterator_value.value())];
-      }
-    } else {
-      ++value_distribution[iterator_value.value()];
-    }
-  });
-}
-
 template <typename T>
 std::vector<std::pair<T, HistogramCountType>> value_distribution_from_column(const Table& table,
                                                                              const ColumnID column_id,
@@ -49,7 +29,8 @@ std::vector<std::pair<T, HistogramCountType>> value_distribution_from_column(con
     const auto chunk = table.get_chunk(chunk_id);
     if (!chunk) continue;
 
-    add_segment_to_value_distribution<T>(*chunk->get_segment(column_id), value_distribution_map, domain);
+    EqualDistinctCountHistogram<T>::add_segment_to_value_distribution(*chunk->get_segment(column_id),
+                                                                      value_distribution_map, domain);
   }
 
   auto value_distribution =
@@ -90,9 +71,14 @@ EqualDistinctCountHistogram<T>::EqualDistinctCountHistogram(std::vector<T>&& bin
 template <typename T>
 std::shared_ptr<EqualDistinctCountHistogram<T>> EqualDistinctCountHistogram<T>::from_column(
     const Table& table, const ColumnID column_id, const BinID max_bin_count, const HistogramDomain<T>& domain) {
-  Assert(max_bin_count > 0, "max_bin_count must be greater than zero ");
+  return from_distribution(value_distribution_from_column(table, column_id, domain), max_bin_count);
+}
 
-  const auto value_distribution = value_distribution_from_column(table, column_id, domain);
+template <typename T>
+std::shared_ptr<EqualDistinctCountHistogram<T>> EqualDistinctCountHistogram<T>::from_distribution(
+    std::vector<std::pair<T, HistogramCountType>>&& value_distribution, const BinID max_bin_count,
+    const std::optional<HistogramCountType>& total_distinct_count) {
+  Assert(max_bin_count > 0, "max_bin_count must be greater than zero ");
 
   if (value_distribution.empty()) {
     return nullptr;
@@ -136,9 +122,39 @@ std::shared_ptr<EqualDistinctCountHistogram<T>> EqualDistinctCountHistogram<T>::
     min_value_idx = max_value_idx + 1;
   }
 
+  if (!total_distinct_count) {
+    return std::make_shared<EqualDistinctCountHistogram<T>>(
+        std::move(bin_minima), std::move(bin_maxima), std::move(bin_heights),
+        static_cast<HistogramCountType>(distinct_count_per_bin), bin_count_with_extra_value);
+  }
+
+  // Spread the given distinct count evenly among the bins. Each bin keeps at least the distinct values it contains.
+  const auto scaled_distinct_count = std::max(static_cast<size_t>(std::round(*total_distinct_count)),
+                                              static_cast<size_t>(value_distribution.size()));
   return std::make_shared<EqualDistinctCountHistogram<T>>(
       std::move(bin_minima), std::move(bin_maxima), std::move(bin_heights),
-      static_cast<HistogramCountType>(distinct_count_per_bin), bin_count_with_extra_value);
+      static_cast<HistogramCountType>(scaled_distinct_count / bin_count),
+      static_cast<BinID>(scaled_distinct_count % bin_count));
+}
+
+template <typename T>
+void EqualDistinctCountHistogram<T>::add_segment_to_value_distribution(
+    const BaseSegment& segment, std::unordered_map<T, HistogramCountType>& value_distribution,
+    const HistogramDomain<T>& domain) {
+  segment_iterate<T>(segment, [&](const auto& iterator_value) {
+    if (iterator_value.is_null()) return;
+
+    if constexpr (std::is_same_v<T, pmr_string>) {
+      // Do "contains()" check first to avoid the string copy incurred by string_to_domain() where possible
+      if (domain.contains(iterator_value.value())) {
+        ++value_distribution[iterator_value.value()];
+      } else {
+        ++value_distribution[domain.string_to_domain(iterator_value.value())];
+      }
+    } else {
+      ++value_distribution[iterator_value.value()];
+    }
+  });
 }
 
 template <typename T>
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -10,6 +12,7 @@
 
 namespace opossum {
 
+class BaseSegment;
 class Table;
 
 /**
@@ -36,6 +39,24 @@ class EqualDistinctCountHistogram : public AbstractHistogram<T> {
                                                                      const BinID max_bin_count,
                                                                      const HistogramDomain<T>& domain = {});
 
+  /**
+   * Create an EqualDistinctCountHistogram from a value distribution, i.e., the distinct values of a column, sorted
+   * ascendingly, and how often each of them occurs. Returns nullptr if the distribution is empty.
+   * @param total_distinct_count   Number of distinct values represented by the histogram. Defaults to the size of the
+   *                               value distribution. Used by histograms built from a sample, where the sample misses
+   *                               some of the distinct values of the column.
+   */
+  static std::shared_ptr<EqualDistinctCountHistogram<T>> from_distribution(
+      std::vector<std::pair<T, HistogramCountType>>&& value_distribution, const BinID max_bin_count,
+      const std::optional<HistogramCountType>& total_distinct_count = std::nullopt);
+
+  /**
+   * Counts the non-null values of @param segment into @param value_distribution. Strings are mapped into @param domain.
+   */
+  static void add_segment_to_value_distribution(const BaseSegment& segment,
+                                                std::unordered_map<T, HistogramCountType>& value_distribution,
+                                                const HistogramDomain<T>& domain = {});
+
   std::string name() const override;
   std::shared_ptr<AbstractHistogram<T>> clone() const override;
   HistogramCountType total_distinct_count() const override;
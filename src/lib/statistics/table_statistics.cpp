@@ -1,79 +1,204 @@
 #include "table_statistics.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <numeric>
-#include <thread>
+#include <unordered_map>
+#include <utility>
 
 #include "attribute_statistics.hpp"
+#include "column_pair_statistics.hpp"
+#include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
 #include "statistics/statistics_objects/abstract_histogram.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Each job counts the values of one column in consecutive sampled chunks with about this many rows
+constexpr auto ROWS_PER_JOB = size_t{1'000'000};
+
+/**
+ * Estimates the number of distinct values of a column from the value distribution of a sample, using the Duj1
+ * estimator by Haas et al. ("Sampling-Based Estimation of the Number of Distinct Values of an Attribute", VLDB 1995).
+ * Values that occur only once in the sample hint at distinct values that the sample missed: If all sampled values are
+ * unique, the distinct count is scaled like the row count. If every value occurs multiple times, the sample most likely
+ * contains all distinct values.
+ */
+template <typename T>
+HistogramCountType estimate_distinct_count(const std::vector<std::pair<T, HistogramCountType>>& value_distribution,
+                                           const double sampling_rate) {
+  auto value_count = 0.0;
+  auto singleton_count = 0.0;
+  for (const auto& [value, count] : value_distribution) {
+    value_count += count;
+    if (count == 1) ++singleton_count;
+  }
+
+  // The column cannot contain more distinct values than (estimated) non-null values
+  const auto max_distinct_count = value_count / sampling_rate;
+
+  const auto denominator = 1.0 - (1.0 - sampling_rate) * singleton_count / value_count;
+  if (denominator <= 0.0) return static_cast<HistogramCountType>(max_distinct_count);
+
+  return static_cast<HistogramCountType>(
+      std::min(static_cast<double>(value_distribution.size()) / denominator, max_distinct_count));
+}
+
+}  // namespace
+
 namespace opossum {
 
-std::shared_ptr<TableStatistics> TableStatistics::from_table(const Table& table) {
+std::shared_ptr<TableStatistics> TableStatistics::from_table(const Table& table,
+                                                             const std::optional<size_t>& sample_row_count) {
   std::vector<std::shared_ptr<BaseAttributeStatistics>> column_statistics(table.column_count());
 
+  const auto max_bin_count = TableStatistics::histogram_bin_count(table.row_count());
+
+  const auto max_sample_row_count =
+      sample_row_count ? *sample_row_count
+                       : table.statistics_sample_row_count().value_or(DEFAULT_STATISTICS_SAMPLE_ROW_COUNT);
+  Assert(max_sample_row_count > 0, "Statistics sample must not be empty");
+
+  const auto chunk_ids = sample_chunk_ids(table, max_sample_row_count);
+
   /**
-   * Determine bin count, within mostly arbitrarily chosen bounds: 5 (for tables with <=2k rows) up to 100 bins
-   * (for tables with >= 200m rows) are created.
+   * Split the sampled chunks into ranges of about ROWS_PER_JOB rows. The ranges are given as [begin, end) indices into
+   * chunk_ids.
    */
-  const auto histogram_bin_count = std::min<size_t>(100, std::max<size_t>(5, table.row_count() / 2'000));
+  auto chunk_ranges = std::vector<std::pair<size_t, size_t>>{};
+  auto sampled_row_count = size_t{0};
+  auto range_row_count = size_t{0};
+  for (auto chunk_idx = size_t{0}; chunk_idx < chunk_ids.size(); ++chunk_idx) {
+    if (range_row_count == 0) chunk_ranges.emplace_back(chunk_idx, chunk_idx);
+
+    const auto chunk_size = table.get_chunk(chunk_ids[chunk_idx])->size();
+    sampled_row_count += chunk_size;
+    range_row_count += chunk_size;
+    chunk_ranges.back().second = chunk_idx + 1;
+
+    if (range_row_count >= ROWS_PER_JOB) range_row_count = 0;
+  }
 
-  auto next_column_id = std::atomic<size_t>{0u};
-  auto threads = std::vector<std::thread>{};
+  // The counts of the sampled values are scaled by the inverse sampling rate
+  const auto sampling_rate = sampled_row_count == 0 || sampled_row_count >= table.row_count()
+                                 ? 1.0
+                                 : static_cast<double>(sampled_row_count) / static_cast<double>(table.row_count());
 
   /**
-   * Parallely create statistics objects for the Table's columns
+   * For each column, one job per chunk range counts the sampled values. Once they are done, a final job merges their
+   * value distributions and creates the column's statistics objects.
    */
-  for (auto thread_id = 0u;
-       thread_id < std::min(static_cast<uint>(table.column_count()), std::thread::hardware_concurrency() + 1);
-       ++thread_id) {
-    threads.emplace_back([&] {
-      while (true) {
-        auto my_column_id = ColumnID{static_cast<ColumnID::base_type>(next_column_id++)};
-        if (static_cast<ColumnCount>(my_column_id) >= table.column_count()) return;
-
-        const auto column_data_type = table.column_data_type(my_column_id);
-
-        resolve_data_type(column_data_type, [&](auto type) {
-          using ColumnDataType = typename decltype(type)::type;
-
-          const auto output_column_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
-
-          const auto histogram =
-              EqualDistinctCountHistogram<ColumnDataType>::from_column(table, my_column_id, histogram_bin_count);
-
-          if (histogram) {
-            output_column_statistics->set_statistics_object(histogram);
-
-            // Use the insight that the histogram will only contain non-null values to generate the NullValueRatio
-            // property
-            const auto null_value_ratio =
-                table.row_count() == 0
-                    ? 0.0f
-                    : 1.0f - (static_cast<float>(histogram->total_count()) / static_cast<float>(table.row_count()));
-            output_column_statistics->set_statistics_object(
-                std::make_shared<NullValueRatioStatistics>(null_value_ratio));
-          } else {
-            // Failure to generate a histogram currently only stems from all-null segments.
-            // TODO(anybody) this is a slippery assumption. But the alternative would be a full segment scan...
-            output_column_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(1.0f));
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      using ValueDistributionMap = std::unordered_map<ColumnDataType, HistogramCountType>;
+
+      const auto range_value_distributions = std::make_shared<std::vector<ValueDistributionMap>>(chunk_ranges.size());
+
+      const auto merge_job = std::make_shared<JobTask>([&, column_id, range_value_distributions]() {
+        auto value_distribution_map = ValueDistributionMap{};
+        for (auto& range_value_distribution : *range_value_distributions) {
+          if (value_distribution_map.empty()) {
+            value_distribution_map = std::move(range_value_distribution);
+            continue;
+          }
+          for (const auto& [value, count] : range_value_distribution) {
+            value_distribution_map[value] += count;
+          }
+        }
+
+        auto value_distribution = std::vector<std::pair<ColumnDataType, HistogramCountType>>{
+            value_distribution_map.begin(), value_distribution_map.end()};
+        std::sort(value_distribution.begin(), value_distribution.end(),
+                  [&](const auto& l, const auto& r) { return l.first < r.first; });
+
+        auto total_distinct_count = std::optional<HistogramCountType>{};
+        if (sampling_rate < 1.0 && !value_distribution.empty()) {
+          total_distinct_count = estimate_distinct_count(value_distribution, sampling_rate);
+          for (auto& [value, count] : value_distribution) {
+            count = static_cast<HistogramCountType>(count / sampling_rate);
+          }
+        }
+
+        const auto output_column_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
+
+        const auto histogram = EqualDistinctCountHistogram<ColumnDataType>::from_distribution(
+            std::move(value_distribution), max_bin_count, total_distinct_count);
+
+        if (histogram) {
+          output_column_statistics->set_statistics_object(histogram);
+
+          // Use the insight that the histogram will only contain non-null values to generate the NullValueRatio
+          // property
+          const auto null_value_ratio =
+              table.row_count() == 0
+                  ? 0.0f
+                  : std::max(0.0f, 1.0f - (static_cast<float>(histogram->total_count()) /
+                                           static_cast<float>(table.row_count())));
+          output_column_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(null_value_ratio));
+        } else {
+          // Failure to generate a histogram currently only stems from all-null segments.
+          // TODO(anybody) this is a slippery assumption. But the alternative would be a full segment scan...
+          output_column_statistics->set_statistics_object(std::make_shared<NullValueRatioStatistics>(1.0f));
+        }
+
+        column_statistics[column_id] = output_column_statistics;
+      });
+
+      for (auto range_idx = size_t{0}; range_idx < chunk_ranges.size(); ++range_idx) {
+        const auto range_job = std::make_shared<JobTask>([&, column_id, range_idx, range_value_distributions]() {
+          auto& range_value_distribution = (*range_value_distributions)[range_idx];
+          for (auto chunk_idx = chunk_ranges[range_idx].first; chunk_idx < chunk_ranges[range_idx].second;
+               ++chunk_idx) {
+            const auto& segment = *table.get_chunk(chunk_ids[chunk_idx])->get_segment(column_id);
+            EqualDistinctCountHistogram<ColumnDataType>::add_segment_to_value_distribution(segment,
+                                                                                           range_value_distribution);
           }
-
-          column_statistics[my_column_id] = output_column_statistics;
         });
+        range_job->set_as_predecessor_of(merge_job);
+        jobs.emplace_back(range_job);
       }
+
+      // The merge job is scheduled after its predecessors
+      jobs.emplace_back(merge_job);
     });
   }
 
-  for (auto& thread : threads) {
-    thread.join();
-  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
   return std::make_shared<TableStatistics>(std::move(column_statistics), table.row_count());
 }
 
+std::vector<ChunkID> TableStatistics::sample_chunk_ids(const Table& table, const size_t sample_row_count) {
+  const auto row_count = table.row_count();
+  const auto sampling_rate =
+      row_count <= sample_row_count ? 1.0 : static_cast<double>(sample_row_count) / static_cast<double>(row_count);
+
+  // The first chunk is always selected
+  auto chunk_ids = std::vector<ChunkID>{};
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    if (std::ceil(chunk_id * sampling_rate) < std::ceil((chunk_id + 1) * sampling_rate)) {
+      chunk_ids.emplace_back(chunk_id);
+    }
+  }
+
+  return chunk_ids;
+}
+
+size_t TableStatistics::histogram_bin_count(const size_t row_count) {
+  return std::min<size_t>(100, std::max<size_t>(5, row_count / 2'000));
+}
+
 TableStatistics::TableStatistics(std::vector<std::shared_ptr<BaseAttributeStatistics>>&& init_column_statistics,
                                  const Cardinality init_row_count)
     : column_statistics(std::move(init_column_statistics)), row_count(init_row_count) {}
@@ -83,6 +208,19 @@ DataType TableStatistics::column_data_type(const ColumnID column_id) const {
   return column_statistics[column_id]->data_type;
 }
 
+std::shared_ptr<const ColumnPairStatistics> TableStatistics::column_pair_statistics(const ColumnID column_id_a,
+                                                                                    const ColumnID column_id_b) const {
+  for (const auto& column_pair_statistics : column_pair_statistics_list) {
+    if ((column_pair_statistics->first_column_id == column_id_a &&
+         column_pair_statistics->second_column_id == column_id_b) ||
+        (column_pair_statistics->first_column_id == column_id_b &&
+         column_pair_statistics->second_column_id == column_id_a)) {
+      return column_pair_statistics;
+    }
+  }
+  return nullptr;
+}
+
 std::ostream& operator<<(std::ostream& stream, const TableStatistics& table_statistics) {
   stream << "TableStatistics {" << std::endl;
   stream << "  RowCount: " << table_statistics.row_count << "; " << std::endl;
@@ -12,8 +12,12 @@
 namespace opossum {
 
 class BaseAttributeStatistics;
+class ColumnPairStatistics;
 class Table;
 
+// Statistics of tables with more rows are built from a sample, unless the table defines its own sample size.
+constexpr auto DEFAULT_STATISTICS_SAMPLE_ROW_COUNT = size_t{10'000'000};
+
 /**
  * Container for all cardinality estimation statistics gathered about a Table. Also used to represent the estimation of
  * a temporary Table during Optimization.
@@ -23,8 +27,22 @@ class TableStatistics {
   /**
    * Creates statistics objects for cardinality estimation for all Columns in @param table. See implementation for
    * which statistics objects are created.
+   *
+   * The statistics are built from a block sample of about @param sample_row_count rows, i.e., from whole chunks that
+   * are evenly spread over the table. If not given, the table's statistics_sample_row_count() or, if that is unset,
+   * DEFAULT_STATISTICS_SAMPLE_ROW_COUNT is used. Tables that are not larger than the sample are read entirely.
    */
-  static std::shared_ptr<TableStatistics> from_table(const Table& table);
+  static std::shared_ptr<TableStatistics> from_table(const Table& table,
+                                                     const std::optional<size_t>& sample_row_count = std::nullopt);
+
+  // Selects the chunks of a block sample of about @param sample_row_count rows, evenly spread over @param table
+  static std::vector<ChunkID> sample_chunk_ids(const Table& table, const size_t sample_row_count);
+
+  /**
+   * Determines the bin count of the histograms of a table, within mostly arbitrarily chosen bounds: 5 (for tables with
+   * <=2k rows) up to 100 bins (for tables with >= 200m rows) are created.
+   */
+  static size_t histogram_bin_count(const size_t row_count);
 
   TableStatistics(std::vector<std::shared_ptr<BaseAttributeStatistics>>&& init_column_statistics,
                   const Cardinality init_row_count);
@@ -34,8 +52,16 @@ class TableStatistics {
    */
   DataType column_data_type(const ColumnID column_id) const;
 
+  // @return the ColumnPairStatistics on the two columns (in any order) or nullptr if there are none
+  std::shared_ptr<const ColumnPairStatistics> column_pair_statistics(const ColumnID column_id_a,
+                                                                     const ColumnID column_id_b) const;
+
   const std::vector<std::shared_ptr<BaseAttributeStatistics>> column_statistics;
   Cardinality row_count;
+
+  // Optional statistics on the correlation of column pairs. Only the statistics of stored tables carry them, see
+  // add_column_pair_statistics().
+  std::vector<std::shared_ptr<const ColumnPairStatistics>> column_pair_statistics_list;
 };
 
 std::ostream& operator<<(std::ostream& stream, const TableStatistics& table_statistics);
@@ -0,0 +1,414 @@
+#include "table_statistics_maintainer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "statistics/statistics_objects/distinct_count_sketch.hpp"
+#include "statistics/statistics_objects/generic_histogram_builder.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// A bin of a merged histogram. The distinct count of a bin lies between the larger of the distinct counts of the
+// merged bins (if they share all values) and their sum (if they share no values).
+template <typename T>
+struct MergedBin {
+  T minimum;
+  T maximum;
+  HistogramCountType height;
+  HistogramCountType min_distinct_count;
+  HistogramCountType max_distinct_count;
+};
+
+// Applies the predicates to @param histogram one after another. Returns nullptr if no values remain.
+template <typename T>
+std::shared_ptr<AbstractHistogram<T>> slice_histogram(
+    const std::shared_ptr<AbstractHistogram<T>>& histogram,
+    const std::vector<std::pair<PredicateCondition, T>>& predicates) {
+  auto sliced_histogram = histogram;
+  for (const auto& [predicate_condition, value] : predicates) {
+    sliced_histogram = std::static_pointer_cast<AbstractHistogram<T>>(
+        sliced_histogram->sliced(predicate_condition, AllTypeVariant{value}));
+    if (!sliced_histogram || sliced_histogram->bin_count() == 0) return nullptr;
+  }
+  return sliced_histogram;
+}
+
+/**
+ * Merges the histogram of a segment into the histogram of its table. The bins of the table histogram are kept. The
+ * values of the segment are added to the bins they fall into, values in gaps between the bins become new bins. If
+ * there are more than @param max_bin_count bins afterwards, neighboring bins are combined. The distinct counts of the
+ * bins are chosen so that they sum up to @param distinct_count, as far as possible.
+ */
+template <typename T>
+std::shared_ptr<AbstractHistogram<T>> merge_histograms(const std::shared_ptr<AbstractHistogram<T>>& histogram,
+                                                       const std::shared_ptr<AbstractHistogram<T>>& segment_histogram,
+                                                       const Cardinality distinct_count, const size_t max_bin_count) {
+  auto bins = std::vector<MergedBin<T>>{};
+
+  // Bins that overlap the previous bin are combined with it. This only happens for strings, because slicing them with
+  // `< value` keeps `value` as the bin maximum.
+  const auto add_bin = [&](MergedBin<T>&& bin) {
+    if (!bins.empty() && bin.minimum <= bins.back().maximum) {
+      auto& previous_bin = bins.back();
+      previous_bin.maximum = std::max(previous_bin.maximum, bin.maximum);
+      previous_bin.height += bin.height;
+      previous_bin.min_distinct_count += bin.min_distinct_count;
+      previous_bin.max_distinct_count += bin.max_distinct_count;
+      return;
+    }
+    bins.emplace_back(std::move(bin));
+  };
+
+  const auto add_segment_bins = [&](const std::shared_ptr<AbstractHistogram<T>>& segment_slice) {
+    if (!segment_slice) return;
+    for (auto bin_id = BinID{0}; bin_id < segment_slice->bin_count(); ++bin_id) {
+      const auto bin_distinct_count = segment_slice->bin_distinct_count(bin_id);
+      add_bin({segment_slice->bin_minimum(bin_id), segment_slice->bin_maximum(bin_id),
+               segment_slice->bin_height(bin_id), bin_distinct_count, bin_distinct_count});
+    }
+  };
+
+  if (!histogram) {
+    add_segment_bins(segment_histogram);
+  } else {
+    const auto bin_count = histogram->bin_count();
+    for (auto bin_id = BinID{0}; bin_id < bin_count; ++bin_id) {
+      const auto& bin_minimum = histogram->bin_minimum(bin_id);
+      const auto& bin_maximum = histogram->bin_maximum(bin_id);
+
+      if (bin_id == 0) {
+        add_segment_bins(slice_histogram(segment_histogram, {{PredicateCondition::LessThan, bin_minimum}}));
+      } else {
+        add_segment_bins(
+            slice_histogram(segment_histogram, {{PredicateCondition::GreaterThan, histogram->bin_maximum(bin_id - 1)},
+                                                {PredicateCondition::LessThan, bin_minimum}}));
+      }
+
+      const auto segment_slice =
+          slice_histogram(segment_histogram, {{PredicateCondition::GreaterThanEquals, bin_minimum},
+                                              {PredicateCondition::LessThanEquals, bin_maximum}});
+      const auto segment_height = segment_slice ? segment_slice->total_count() : HistogramCountType{0};
+      const auto segment_distinct_count = segment_slice ? segment_slice->total_distinct_count() : HistogramCountType{0};
+      const auto bin_distinct_count = histogram->bin_distinct_count(bin_id);
+
+      add_bin({bin_minimum, bin_maximum, histogram->bin_height(bin_id) + segment_height,
+               std::max(bin_distinct_count, segment_distinct_count), bin_distinct_count + segment_distinct_count});
+    }
+
+    add_segment_bins(
+        slice_histogram(segment_histogram, {{PredicateCondition::GreaterThan, histogram->bin_maximum(bin_count - 1)}}));
+  }
+
+  if (bins.size() > max_bin_count) {
+    // Combine neighboring bins into bins of roughly equal height
+    auto total_height = HistogramCountType{0};
+    for (const auto& bin : bins) {
+      total_height += bin.height;
+    }
+    const auto target_height = total_height / static_cast<HistogramCountType>(max_bin_count);
+
+    auto combined_bins = std::vector<MergedBin<T>>{};
+    for (auto& bin : bins) {
+      if (combined_bins.empty() || combined_bins.back().height >= target_height) {
+        combined_bins.emplace_back(std::move(bin));
+        continue;
+      }
+      auto& combined_bin = combined_bins.back();
+      combined_bin.maximum = std::move(bin.maximum);
+      combined_bin.height += bin.height;
+      combined_bin.min_distinct_count += bin.min_distinct_count;
+      combined_bin.max_distinct_count += bin.max_distinct_count;
+    }
+    bins = std::move(combined_bins);
+  }
+
+  auto min_distinct_count = HistogramCountType{0};
+  auto max_distinct_count = HistogramCountType{0};
+  for (const auto& bin : bins) {
+    min_distinct_count += bin.min_distinct_count;
+    max_distinct_count += bin.max_distinct_count;
+  }
+  const auto target_distinct_count = std::clamp(distinct_count, min_distinct_count, max_distinct_count);
+  const auto distinct_count_range = max_distinct_count - min_distinct_count;
+  const auto overlap_ratio =
+      distinct_count_range > 0.0f ? (target_distinct_count - min_distinct_count) / distinct_count_range : 0.0f;
+
+  auto builder = GenericHistogramBuilder<T>{bins.size()};
+  for (const auto& bin : bins) {
+    builder.add_bin(bin.minimum, bin.maximum, bin.height,
+                    bin.min_distinct_count + overlap_ratio * (bin.max_distinct_count - bin.min_distinct_count));
+  }
+  return builder.build();
+}
+
+std::optional<Cardinality> distinct_count(const BaseAttributeStatistics& base_attribute_statistics) {
+  auto result = std::optional<Cardinality>{};
+  resolve_data_type(base_attribute_statistics.data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto& attribute_statistics =
+        static_cast<const AttributeStatistics<ColumnDataType>&>(base_attribute_statistics);
+    if (attribute_statistics.histogram) {
+      result = attribute_statistics.histogram->total_distinct_count();
+    }
+  });
+  return result;
+}
+
+double q_error(const Cardinality a, const Cardinality b) {
+  const auto clamped_a = std::max(a, 1.0f);
+  const auto clamped_b = std::max(b, 1.0f);
+  return std::max(clamped_a / clamped_b, clamped_b / clamped_a);
+}
+
+bool chunk_is_completed(const Chunk& chunk) {
+  const auto& mvcc_data = chunk.mvcc_data();
+  if (!mvcc_data) return true;
+
+  // Rows of inserts that have not committed or rolled back yet have no begin CommitID
+  const auto chunk_size = chunk.size();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    if (mvcc_data->get_begin_cid(chunk_offset) == MvccData::MAX_COMMIT_ID) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::atomic<size_t> TableStatisticsMaintainer::_statistics_epoch{0};
+
+TableStatisticsMaintainer::TableStatisticsMaintainer(Table& table) : _table(table) {
+  const auto table_statistics = table.table_statistics();
+  Assert(table_statistics, "Table must have statistics");
+
+  _merged_row_count = table_statistics->row_count;
+  _row_count = static_cast<int64_t>(table_statistics->row_count);
+  _published_row_count = _row_count.load();
+  _reference_statistics = table_statistics;
+
+  const auto chunk_count = table.chunk_count();
+  _chunk_is_merged.resize(chunk_count);
+  _initial_row_counts.resize(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (chunk && chunk->is_mutable()) {
+      _initial_row_counts[chunk_id] = chunk->size();
+    } else {
+      _chunk_is_merged[chunk_id] = true;
+    }
+  }
+  while (_first_unmerged_chunk_id < chunk_count && _chunk_is_merged[_first_unmerged_chunk_id]) {
+    ++_first_unmerged_chunk_id;
+  }
+
+  _column_statistics.resize(table.column_count());
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto& initial_statistics =
+          static_cast<const AttributeStatistics<ColumnDataType>&>(*table_statistics->column_statistics[column_id]);
+      const auto column_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
+      column_statistics->histogram = initial_statistics.histogram;
+      column_statistics->null_value_ratio = initial_statistics.null_value_ratio;
+
+      // The initial statistics have no sketch, so it is built from the sketches of the immutable chunks
+      column_statistics->distinct_count_sketch = std::make_shared<DistinctCountSketch<ColumnDataType>>();
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto chunk = table.get_chunk(chunk_id);
+        if (!chunk || !chunk->pruning_statistics()) continue;
+
+        const auto& segment_statistics =
+            static_cast<const AttributeStatistics<ColumnDataType>&>(*(*chunk->pruning_statistics())[column_id]);
+        if (segment_statistics.distinct_count_sketch) {
+          column_statistics->distinct_count_sketch->merge(*segment_statistics.distinct_count_sketch);
+        }
+      }
+
+      _column_statistics[column_id] = column_statistics;
+    });
+  }
+}
+
+bool TableStatisticsMaintainer::update_row_count(const int64_t row_count_delta) {
+  const auto row_count = _row_count += row_count_delta;
+  const auto published_row_count = _published_row_count.load();
+
+  return static_cast<double>(std::abs(row_count - published_row_count)) >
+         ROW_COUNT_REFRESH_THRESHOLD * static_cast<double>(std::max(published_row_count, int64_t{1}));
+}
+
+void TableStatisticsMaintainer::update() {
+  _update_requested = true;
+
+  // If another thread holds the lock, it repeats its update once it is done. Requests that arrive after it checked
+  // _update_requested for the last time, but before it released the lock, are handled by the outer loop.
+  while (_update_requested) {
+    auto lock = std::unique_lock<std::mutex>{_mutex, std::try_to_lock};
+    if (!lock.owns_lock()) return;
+
+    while (_update_requested.exchange(false)) {
+      _merge_completed_chunks();
+      _publish();
+    }
+  }
+}
+
+void TableStatisticsMaintainer::schedule_update(const std::shared_ptr<const Table>& table) {
+  const auto statistics_maintainer = table->statistics_maintainer();
+  if (!statistics_maintainer || statistics_maintainer->_update_scheduled.exchange(true)) return;
+
+  // The task keeps the table alive, which the maintainer only references. The flag is reset before updating so that
+  // row count changes recorded during the update schedule another one.
+  std::make_shared<JobTask>([table, statistics_maintainer]() {
+    statistics_maintainer->_update_scheduled = false;
+    statistics_maintainer->update();
+  })->schedule();
+}
+
+size_t TableStatisticsMaintainer::statistics_epoch() { return _statistics_epoch; }
+
+void TableStatisticsMaintainer::_merge_completed_chunks() {
+  const auto chunk_count = _table.chunk_count();
+  const auto target_chunk_size = _table.target_chunk_size();
+  _chunk_is_merged.resize(chunk_count);
+  _initial_row_counts.resize(chunk_count);
+
+  for (auto chunk_id = _first_unmerged_chunk_id; chunk_id < chunk_count; ++chunk_id) {
+    if (_chunk_is_merged[chunk_id]) continue;
+
+    const auto chunk = _table.get_chunk(chunk_id);
+    if (!chunk) {
+      _chunk_is_merged[chunk_id] = true;
+      continue;
+    }
+
+    if (chunk->is_mutable()) {
+      // Inserts only append new chunks once the last chunk is full. Thus, full chunks do not receive further inserts.
+      if (chunk->size() < target_chunk_size || !chunk_is_completed(*chunk)) continue;
+      chunk->finalize();
+    }
+    generate_chunk_pruning_statistics(chunk);
+
+    // Chunks with rows that were updated in place do not get pruning statistics. Their rows are not merged into the
+    // table statistics, which remain an estimation anyway.
+    if (!chunk->pruning_statistics()) {
+      _chunk_is_merged[chunk_id] = true;
+      continue;
+    }
+
+    // Rows that were already part of the initial statistics are not merged again
+    const auto chunk_size = chunk->size();
+    const auto new_row_count = chunk_size - _initial_row_counts[chunk_id];
+    const auto new_row_ratio = static_cast<Selectivity>(new_row_count) / static_cast<Selectivity>(chunk_size);
+    const auto merged_row_count = _merged_row_count + static_cast<Cardinality>(new_row_count);
+
+    for (auto column_id = ColumnID{0}; column_id < _table.column_count(); ++column_id) {
+      resolve_data_type(_table.column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+
+        auto& column_statistics = static_cast<AttributeStatistics<ColumnDataType>&>(*_column_statistics[column_id]);
+        const auto& segment_statistics =
+            static_cast<const AttributeStatistics<ColumnDataType>&>(*(*chunk->pruning_statistics())[column_id]);
+
+        if (segment_statistics.distinct_count_sketch) {
+          column_statistics.distinct_count_sketch->merge(*segment_statistics.distinct_count_sketch);
+        }
+
+        if (new_row_count == 0) return;
+
+        const auto null_value_count =
+            (column_statistics.null_value_ratio ? column_statistics.null_value_ratio->ratio : 0.0f) *
+                _merged_row_count +
+            (segment_statistics.null_value_ratio ? segment_statistics.null_value_ratio->ratio : 0.0f) *
+                static_cast<float>(new_row_count);
+        column_statistics.null_value_ratio =
+            std::make_shared<NullValueRatioStatistics>(null_value_count / merged_row_count);
+
+        if (!segment_statistics.histogram) return;
+
+        auto segment_histogram = segment_statistics.histogram;
+        if (new_row_ratio < 1.0f) {
+          segment_histogram =
+              std::static_pointer_cast<AbstractHistogram<ColumnDataType>>(segment_histogram->scaled(new_row_ratio));
+        }
+
+        column_statistics.histogram =
+            merge_histograms(column_statistics.histogram, segment_histogram,
+                             column_statistics.distinct_count_sketch->estimate_distinct_count(),
+                             TableStatistics::histogram_bin_count(static_cast<size_t>(merged_row_count)));
+      });
+    }
+
+    _merged_row_count = merged_row_count;
+    _chunk_is_merged[chunk_id] = true;
+  }
+
+  while (_first_unmerged_chunk_id < chunk_count && _chunk_is_merged[_first_unmerged_chunk_id]) {
+    ++_first_unmerged_chunk_id;
+  }
+}
+
+void TableStatisticsMaintainer::_publish() {
+  const auto row_count = std::max(_row_count.load(), int64_t{0});
+
+  /**
+   * The merged statistics are scaled to the current row count, which also covers the rows of chunks that are not
+   * merged yet and the rows that were deleted. Without any merged rows (e.g., for tables that were empty when they
+   * were added), there is nothing to scale and the columns remain without statistics.
+   */
+  auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>(_column_statistics.size());
+  for (auto column_id = ColumnID{0}; column_id < _column_statistics.size(); ++column_id) {
+    resolve_data_type(_table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      if (_merged_row_count > 0) {
+        column_statistics[column_id] = _column_statistics[column_id]->scaled(static_cast<Selectivity>(row_count) /
+                                                                             _merged_row_count);
+      } else {
+        column_statistics[column_id] = std::make_shared<AttributeStatistics<ColumnDataType>>();
+      }
+    });
+  }
+
+  const auto table_statistics =
+      std::make_shared<TableStatistics>(std::move(column_statistics), static_cast<Cardinality>(row_count));
+  table_statistics->column_pair_statistics_list = _table.table_statistics()->column_pair_statistics_list;
+  _table.set_table_statistics(table_statistics);
+  _published_row_count = row_count;
+
+  auto drift = q_error(table_statistics->row_count, _reference_statistics->row_count);
+  for (auto column_id = ColumnID{0}; column_id < _column_statistics.size(); ++column_id) {
+    const auto distinct_count_before = distinct_count(*_reference_statistics->column_statistics[column_id]);
+    const auto distinct_count_after = distinct_count(*table_statistics->column_statistics[column_id]);
+    if (distinct_count_before && distinct_count_after) {
+      drift = std::max(drift, q_error(*distinct_count_after, *distinct_count_before));
+    }
+  }
+
+  if (drift > DRIFT_THRESHOLD) {
+    _reference_statistics = table_statistics;
+    ++_statistics_epoch;
+
+    if (Hyrise::get().default_pqp_cache) {
+      Hyrise::get().default_pqp_cache->clear();
+    }
+    if (Hyrise::get().default_lqp_cache) {
+      Hyrise::get().default_lqp_cache->clear();
+    }
+  }
+}
+
+}  // namespace opossum
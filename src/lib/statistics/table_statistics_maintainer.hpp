@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseAttributeStatistics;
+class Table;
+class TableStatistics;
+
+/**
+ * Keeps the TableStatistics of a stored table current while Insert and Delete modify the table. The StorageManager
+ * creates one maintainer per table (see Table::statistics_maintainer()).
+ *
+ * Two things are maintained:
+ *   - The row count is adjusted whenever inserts or deletes commit. Once it differs from the published statistics by
+ *     more than ROW_COUNT_REFRESH_THRESHOLD, new statistics with the current row count are published.
+ *   - Chunks that were filled by inserts are finalized once all of their inserts committed or rolled back. The
+ *     histogram, null value ratio, and DistinctCountSketch of each of their segments (see
+ *     generate_chunk_pruning_statistics()) are merged into the statistics of the table.
+ *
+ * Plans and statistics derived from the previous statistics of the table might be far off now. Once the row count or
+ * a distinct count of a column drifted by a factor of more than DRIFT_THRESHOLD since the last time, the default plan
+ * caches are cleared and the statistics epoch is incremented, which invalidates the CardinalityEstimationCaches.
+ *
+ * Statistics are published as new TableStatistics objects so that concurrent optimizations never observe partially
+ * updated statistics. Committing transactions only record their row count changes. Everything else happens in
+ * update(), which they schedule as a JobTask (see schedule_update()) so that it does not delay the commit.
+ */
+class TableStatisticsMaintainer {
+ public:
+  static constexpr auto ROW_COUNT_REFRESH_THRESHOLD = 0.1;
+  static constexpr auto DRIFT_THRESHOLD = 2.0;
+
+  // Takes over the current statistics of @param table. Expects the pruning statistics of its immutable chunks to exist.
+  explicit TableStatisticsMaintainer(Table& table);
+
+  // Called when inserts (positive delta) or deletes (negative delta) commit. Returns true if the row count differs from
+  // the published one by more than ROW_COUNT_REFRESH_THRESHOLD, i.e., if an update should be scheduled.
+  bool update_row_count(const int64_t row_count_delta);
+
+  /**
+   * Finalizes the full chunks whose inserts have all completed, merges their statistics into the table statistics,
+   * and publishes the result. If another thread is currently updating, it repeats the update instead.
+   */
+  void update();
+
+  // Runs update() for the maintainer of @param table in a JobTask, unless such a task is already pending
+  static void schedule_update(const std::shared_ptr<const Table>& table);
+
+  // Incremented whenever the statistics of a table drift past DRIFT_THRESHOLD
+  static size_t statistics_epoch();
+
+ private:
+  // Both expect _mutex to be held
+  void _merge_completed_chunks();
+  void _publish();
+
+  Table& _table;
+
+  std::mutex _mutex;
+  std::atomic_bool _update_requested{false};
+  std::atomic_bool _update_scheduled{false};
+
+  // Statistics of all rows that were merged so far. Besides the histogram and the null value ratio, they contain the
+  // DistinctCountSketch of each column.
+  std::vector<std::shared_ptr<BaseAttributeStatistics>> _column_statistics;
+  Cardinality _merged_row_count{0};
+
+  // Chunks before this one are merged. Chunks after it might already have been merged if their inserts completed
+  // earlier, as indicated by _chunk_is_merged.
+  ChunkID _first_unmerged_chunk_id{0};
+  std::vector<bool> _chunk_is_merged;
+
+  // Rows of chunks that were mutable when the maintainer was created. These rows are already part of the initial
+  // statistics and must not be merged a second time.
+  std::vector<ChunkOffset> _initial_row_counts;
+
+  std::atomic<int64_t> _row_count;
+  std::atomic<int64_t> _published_row_count;
+
+  // Statistics at the time the caches were last invalidated
+  std::shared_ptr<TableStatistics> _reference_statistics;
+
+  static std::atomic<size_t> _statistics_epoch;
+};
+
+}  // namespace opossum
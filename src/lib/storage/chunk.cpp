@@ -13,6 +13,7 @@
 #include "index/abstract_index.hpp"
 #include "reference_segment.hpp"
 #include "resolve_type.hpp"
+#include "row_version_store.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
@@ -80,9 +81,49 @@ ChunkOffset Chunk::size() const {
   return static_cast<ChunkOffset>(first_segment->size());
 }
 
-bool Chunk::has_mvcc_data() const { return _mvcc_data != nullptr; }
+bool Chunk::has_mvcc_data() const { return mvcc_data() != nullptr; }
+
+std::shared_ptr<MvccData> Chunk::mvcc_data() const { return std::atomic_load(&_mvcc_data); }
+
+bool Chunk::try_compact_mvcc_data(const CommitID lowest_active_snapshot_commit_id) {
+  const auto mvcc_data = this->mvcc_data();
+  if (is_mutable() || !mvcc_data || mvcc_data->is_compacted()) return false;
+  if (!mvcc_data->max_begin_cid || *mvcc_data->max_begin_cid > lowest_active_snapshot_commit_id) return false;
+
+  const auto row_versions = mvcc_data->row_versions();
+  if (row_versions && !row_versions->empty()) return false;
+
+  // Announce the compaction before looking at the locks. A Delete that locks a row afterwards notices the compaction
+  // and fails (see Delete::_on_execute), one that locked the row before is noticed here.
+  if (mvcc_data->is_compacting.exchange(true)) return false;
+
+  const auto chunk_size = size();
+  auto invalidated_rows = std::vector<bool>(chunk_size);
+  auto has_invalidated_rows = false;
+  auto max_end_cid = CommitID{0};
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    const auto end_cid = mvcc_data->get_end_cid(chunk_offset);
+    if (end_cid == MvccData::MAX_COMMIT_ID) {
+      if (mvcc_data->get_tid(chunk_offset) == INVALID_TRANSACTION_ID) continue;
+    } else if (end_cid <= lowest_active_snapshot_commit_id) {
+      // Deleted rows stay locked by the deleting transaction, but are not visible to any transaction anymore
+      invalidated_rows[chunk_offset] = true;
+      has_invalidated_rows = true;
+      max_end_cid = std::max(max_end_cid, end_cid);
+      continue;
+    }
+
+    // The row is locked by an in-flight delete or its deletion is not visible to all active transactions yet
+    mvcc_data->is_compacting = false;
+    return false;
+  }
 
-std::shared_ptr<MvccData> Chunk::mvcc_data() const { return _mvcc_data; }
+  if (!has_invalidated_rows) invalidated_rows.clear();
+  std::atomic_store(&_mvcc_data, std::make_shared<MvccData>(chunk_size, *mvcc_data->max_begin_cid, max_end_cid,
+                                                            std::move(invalidated_rows)));
+  return true;
+}
 
 std::vector<std::shared_ptr<AbstractIndex>> Chunk::get_indexes(
     const std::vector<std::shared_ptr<const BaseSegment>>& segments) const {
@@ -107,6 +148,8 @@ void Chunk::finalize() {
     Assert(_mvcc_data->max_begin_cid != MvccData::MAX_COMMIT_ID,
            "max_begin_cid should not be MAX_COMMIT_ID when finalizing a chunk. This probably means the chunk was "
            "finalized before all transactions committed/rolled back.");
+
+    _mvcc_data->is_finalized = true;
   }
 }
 
@@ -181,8 +224,8 @@ size_t Chunk::memory_usage(const MemoryUsageCalculationMode mode) const {
 
   // TODO(anybody) Index memory usage missing
 
-  if (_mvcc_data) {
-    bytes += _mvcc_data->memory_usage();
+  if (const auto mvcc_data = this->mvcc_data()) {
+    bytes += mvcc_data->memory_usage();
   }
 
   return bytes;
@@ -85,8 +85,20 @@ class Chunk : private Noncopyable {
 
   bool has_mvcc_data() const;
 
+  /**
+   * The MVCC data might be replaced by a compacted one at any time (see try_compact_mvcc_data()). Operators that keep
+   * the returned pointer continue to see valid, though no longer modifiable, visibility information.
+   */
   std::shared_ptr<MvccData> mvcc_data() const;
 
+  /**
+   * Replaces the MVCC data of an immutable chunk by compacted MVCC data (see MvccData), if all of its rows have been
+   * committed at or before @param lowest_active_snapshot_commit_id and no transaction holds a lock on a row.
+   * Deleted rows must have been deleted at or before that commit id as well. Returns true if the MVCC data was
+   * compacted.
+   */
+  bool try_compact_mvcc_data(const CommitID lowest_active_snapshot_commit_id);
+
   std::vector<std::shared_ptr<AbstractIndex>> get_indexes(
       const std::vector<std::shared_ptr<const BaseSegment>>& segments) const;
   std::vector<std::shared_ptr<AbstractIndex>> get_indexes(const std::vector<ColumnID>& column_ids) const;
@@ -0,0 +1,147 @@
+#include "table_hash_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "lossless_cast.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_iterate.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+TableHashIndex::TableHashIndex(const std::vector<ColumnID>& column_ids, const std::vector<DataType>& data_types)
+    : _column_ids(column_ids), _data_types(data_types) {
+  Assert(!_column_ids.empty(), "TableHashIndex requires at least one key column");
+  Assert(_column_ids.size() == _data_types.size(), "Expected one data type per key column");
+}
+
+const std::vector<ColumnID>& TableHashIndex::column_ids() const { return _column_ids; }
+
+void TableHashIndex::insert(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffset begin_offset,
+                            const ChunkOffset end_offset, std::vector<RowID>* existing_row_ids) {
+  DebugAssert(begin_offset <= end_offset && end_offset <= chunk.size(), "Invalid chunk offsets");
+  const auto row_count = static_cast<size_t>(end_offset - begin_offset);
+  if (row_count == 0) return;
+
+  // Materialize the keys of all rows first. This way, each shard has to be locked only once.
+  auto keys = std::vector<Key>(row_count, Key(_column_ids.size()));
+  auto has_null = std::vector<bool>(row_count);
+
+  for (auto key_column_idx = size_t{0}; key_column_idx < _column_ids.size(); ++key_column_idx) {
+    const auto& segment = *chunk.get_segment(_column_ids[key_column_idx]);
+    segment_with_iterators(segment, [&](auto it, [[maybe_unused]] const auto end) {
+      std::advance(it, begin_offset);
+      for (auto row_idx = size_t{0}; row_idx < row_count; ++row_idx, ++it) {
+        const auto position = *it;
+        if (position.is_null()) {
+          has_null[row_idx] = true;
+          continue;
+        }
+        keys[row_idx][key_column_idx] = position.value();
+      }
+    });
+  }
+
+  auto row_indices_by_shard = std::vector<std::vector<size_t>>(SHARD_COUNT);
+  for (auto row_idx = size_t{0}; row_idx < row_count; ++row_idx) {
+    if (has_null[row_idx]) continue;
+    row_indices_by_shard[KeyHash{}(keys[row_idx]) % SHARD_COUNT].emplace_back(row_idx);
+  }
+
+  for (auto shard_id = size_t{0}; shard_id < SHARD_COUNT; ++shard_id) {
+    const auto& row_indices = row_indices_by_shard[shard_id];
+    if (row_indices.empty()) continue;
+
+    auto& shard = _shards[shard_id];
+    const auto lock = std::unique_lock<std::shared_mutex>{shard.mutex};
+    for (const auto row_idx : row_indices) {
+      auto& row_ids = shard.entries[std::move(keys[row_idx])];
+      if (existing_row_ids) existing_row_ids->insert(existing_row_ids->end(), row_ids.begin(), row_ids.end());
+      row_ids.emplace_back(RowID{chunk_id, static_cast<ChunkOffset>(begin_offset + row_idx)});
+    }
+  }
+}
+
+void TableHashIndex::remove_chunk(const ChunkID chunk_id) {
+  for (auto& shard : _shards) {
+    const auto lock = std::unique_lock<std::shared_mutex>{shard.mutex};
+    for (auto entry_iter = shard.entries.begin(); entry_iter != shard.entries.end();) {
+      auto& row_ids = entry_iter->second;
+      row_ids.erase(std::remove_if(row_ids.begin(), row_ids.end(),
+                                   [&](const auto& row_id) { return row_id.chunk_id == chunk_id; }),
+                    row_ids.end());
+
+      if (row_ids.empty()) {
+        entry_iter = shard.entries.erase(entry_iter);
+      } else {
+        ++entry_iter;
+      }
+    }
+  }
+}
+
+void TableHashIndex::lookup(const std::vector<AllTypeVariant>& values, RowIDPosList& matches) const {
+  Assert(values.size() == _column_ids.size(), "Expected one value per key column");
+
+  auto key = Key(values.size());
+  for (auto key_column_idx = size_t{0}; key_column_idx < values.size(); ++key_column_idx) {
+    if (variant_is_null(values[key_column_idx])) return;
+
+    const auto casted_value = lossless_variant_cast(values[key_column_idx], _data_types[key_column_idx]);
+    if (!casted_value) return;
+    key[key_column_idx] = *casted_value;
+  }
+
+  const auto key_hash = KeyHash{}(key);
+  const auto& shard = _shard_for(key_hash);
+
+  const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+  const auto entry_iter = shard.entries.find(key);
+  if (entry_iter == shard.entries.end()) return;
+
+  matches.insert(matches.end(), entry_iter->second.begin(), entry_iter->second.end());
+}
+
+size_t TableHashIndex::row_count() const {
+  auto row_count = size_t{0};
+  for (const auto& shard : _shards) {
+    const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+    for (const auto& [key, row_ids] : shard.entries) {
+      row_count += row_ids.size();
+    }
+  }
+  return row_count;
+}
+
+size_t TableHashIndex::memory_usage() const {
+  auto bytes = sizeof(*this);
+  for (const auto& shard : _shards) {
+    const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+    bytes += shard.entries.bucket_count() * sizeof(void*);
+    for (const auto& [key, row_ids] : shard.entries) {
+      bytes += sizeof(Key) + key.capacity() * sizeof(AllTypeVariant) + sizeof(std::vector<RowID>) +
+               row_ids.capacity() * sizeof(RowID);
+    }
+  }
+  return bytes;
+}
+
+size_t TableHashIndex::KeyHash::operator()(const Key& key) const {
+  auto hash = size_t{0};
+  for (const auto& value : key) {
+    boost::hash_combine(hash, std::hash<AllTypeVariant>{}(value));
+  }
+  return hash;
+}
+
+const TableHashIndex::Shard& TableHashIndex::_shard_for(const size_t key_hash) const {
+  return _shards[key_hash % SHARD_COUNT];
+}
+
+}  // namespace opossum
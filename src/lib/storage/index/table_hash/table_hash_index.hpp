@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+/**
+ * Hash index that spans all chunks of a table, including the mutable ones. It maps the values of one or more key
+ * columns to the RowIDs of all rows holding them. In contrast to the chunk indexes (see AbstractIndex), a point lookup
+ * does not have to visit every chunk.
+ *
+ * The index is created with Table::create_table_hash_index and is maintained by the Insert operator (and, as updates
+ * are implemented as a delete followed by an insert, by Update). Entries are not removed when rows are deleted or when
+ * inserts are rolled back, as older transactions might still see these rows. Thus, lookup() returns all versions of
+ * matching rows and visibility has to be checked by the user of the index, usually by a Validate operator. Entries of
+ * a chunk are only removed when the chunk is physically deleted (see Table::remove_chunk).
+ *
+ * Rows with a NULL value in any of the key columns are not indexed, as NULL never matches an equality predicate.
+ *
+ * The entries are distributed over SHARD_COUNT shards with separate locks so that concurrent inserts and lookups
+ * rarely have to wait for each other.
+ */
+class TableHashIndex : private Noncopyable {
+ public:
+  // data_types holds the data types of the key columns, in the order given by column_ids
+  TableHashIndex(const std::vector<ColumnID>& column_ids, const std::vector<DataType>& data_types);
+
+  const std::vector<ColumnID>& column_ids() const;
+
+  /**
+   * Adds the rows [begin_offset, end_offset) of the given chunk. The values of these rows must have been written.
+   * If `existing_row_ids` is given, the RowIDs of all rows that were indexed before and share their key with one of the
+   * added rows are appended to it. This includes rows added earlier in the same call. It is used to check unique
+   * constraints without a separate lookup per row (see Insert).
+   */
+  void insert(const Chunk& chunk, const ChunkID chunk_id, const ChunkOffset begin_offset, const ChunkOffset end_offset,
+              std::vector<RowID>* existing_row_ids = nullptr);
+
+  // Removes all entries pointing into the given chunk
+  void remove_chunk(const ChunkID chunk_id);
+
+  /**
+   * Appends the RowIDs of all rows whose key columns are equal to `values` to `matches`. The values are converted to
+   * the data types of the key columns first. If this is not possible without loss (e.g., 1.5 for an int column) or if
+   * a value is NULL, no row matches.
+   */
+  void lookup(const std::vector<AllTypeVariant>& values, RowIDPosList& matches) const;
+
+  // Number of indexed rows
+  size_t row_count() const;
+
+  size_t memory_usage() const;
+
+ protected:
+  using Key = std::vector<AllTypeVariant>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<Key, std::vector<RowID>, KeyHash> entries;
+  };
+
+  static constexpr auto SHARD_COUNT = size_t{64};
+
+  const Shard& _shard_for(const size_t key_hash) const;
+
+  const std::vector<ColumnID> _column_ids;
+  const std::vector<DataType> _data_types;
+
+  std::array<Shard, SHARD_COUNT> _shards;
+};
+
+}  // namespace opossum
@@ -1,5 +1,9 @@
 #include "mvcc_data.hpp"
 
+#include <algorithm>
+#include <climits>
+
+#include "storage/row_version_store.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
@@ -13,7 +17,38 @@ MvccData::MvccData(const size_t size, CommitID begin_commit_id) {
   std::atomic_thread_fence(std::memory_order_seq_cst);
 }
 
+MvccData::MvccData(const size_t size, const CommitID begin_commit_id, const CommitID end_commit_id,
+                   std::vector<bool>&& invalidated_rows)
+    : max_begin_cid{begin_commit_id},
+      is_finalized{true},
+      _is_compacted{true},
+      _compacted_size{size},
+      _compacted_begin_cid{begin_commit_id},
+      _compacted_end_cid{end_commit_id},
+      _compacted_invalidated_rows{std::move(invalidated_rows)} {
+  DebugAssert(size > 0, "No point in having empty MVCC data");
+  DebugAssert(_compacted_invalidated_rows.empty() || _compacted_invalidated_rows.size() == size,
+              "Invalidated rows do not match the size");
+}
+
+bool MvccData::is_compacted() const { return _is_compacted; }
+
+bool MvccData::is_compacted_and_entirely_valid() const {
+  return _is_compacted && _compacted_invalidated_rows.empty() && !_expanded_mvcc_data.load();
+}
+
 std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data) {
+  if (const auto expanded_mvcc_data = mvcc_data._expanded_mvcc_data.load()) return stream << *expanded_mvcc_data;
+
+  if (mvcc_data._is_compacted) {
+    stream << "Compacted: BeginCID " << mvcc_data._compacted_begin_cid << ", EndCID " << mvcc_data._compacted_end_cid
+           << " for ";
+    const auto& invalidated_rows = mvcc_data._compacted_invalidated_rows;
+    stream << std::count(invalidated_rows.cbegin(), invalidated_rows.cend(), true) << " of "
+           << mvcc_data._compacted_size << " rows" << std::endl;
+    return stream;
+  }
+
   stream << "TIDs: ";
   for (const auto& tid : mvcc_data._tids) stream << tid.load() << ", ";
   stream << std::endl;
@@ -30,32 +65,54 @@ std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data) {
 }
 
 CommitID MvccData::get_begin_cid(const ChunkOffset offset) const {
+  // Deletes do not change the begin_cids, so there is no need to look at the expanded MVCC data
+  if (_is_compacted) return _compacted_begin_cid;
+
   DebugAssert(offset < _begin_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   return _begin_cids[offset];
 }
 
 void MvccData::set_begin_cid(const ChunkOffset offset, const CommitID commit_id) {
+  if (_is_compacted) return _expanded().set_begin_cid(offset, commit_id);
+
   DebugAssert(offset < _begin_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   _begin_cids[offset] = commit_id;
 }
 
 CommitID MvccData::get_end_cid(const ChunkOffset offset) const {
+  if (_is_compacted) {
+    if (const auto expanded_mvcc_data = _expanded_mvcc_data.load()) return expanded_mvcc_data->get_end_cid(offset);
+    DebugAssert(offset < _compacted_size, "offset out of bounds");
+    if (_compacted_invalidated_rows.empty() || !_compacted_invalidated_rows[offset]) return MAX_COMMIT_ID;
+    return _compacted_end_cid;
+  }
+
   DebugAssert(offset < _end_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   return _end_cids[offset];
 }
 
 void MvccData::set_end_cid(const ChunkOffset offset, const CommitID commit_id) {
+  if (_is_compacted) return _expanded().set_end_cid(offset, commit_id);
+
   DebugAssert(offset < _end_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   _end_cids[offset] = commit_id;
 }
 
 TransactionID MvccData::get_tid(const ChunkOffset offset) const {
+  // No row of compacted MVCC data is locked until a transaction writes to it
+  if (_is_compacted) {
+    if (const auto expanded_mvcc_data = _expanded_mvcc_data.load()) return expanded_mvcc_data->get_tid(offset);
+    return INVALID_TRANSACTION_ID;
+  }
+
   DebugAssert(offset < _tids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   return _tids[offset];
 }
 
 void MvccData::set_tid(const ChunkOffset offset, const TransactionID new_transaction_id,
                        const std::memory_order memory_order) {
+  if (_is_compacted) return _expanded().set_tid(offset, new_transaction_id, memory_order);
+
   DebugAssert(offset < _tids.size(), "offset out of bounds; MvccData insufficently preallocated?");
 
   _tids[offset].store(new_transaction_id, memory_order);
@@ -63,18 +120,59 @@ void MvccData::set_tid(const ChunkOffset offset, const TransactionID new_transac
 
 bool MvccData::compare_exchange_tid(const ChunkOffset offset, TransactionID expected_transaction_id,
                                     TransactionID new_transaction_id) {
+  if (_is_compacted) return _expanded().compare_exchange_tid(offset, expected_transaction_id, new_transaction_id);
+
   DebugAssert(offset < _tids.size(), "offset out of bounds; MvccData insufficently preallocated?");
 
   return _tids[offset].compare_exchange_strong(expected_transaction_id, new_transaction_id);
 }
 
+std::shared_ptr<RowVersionStore> MvccData::row_versions() const { return std::atomic_load(&_row_versions); }
+
+std::shared_ptr<RowVersionStore> MvccData::get_or_create_row_versions() {
+  auto row_versions = std::atomic_load(&_row_versions);
+  if (row_versions) return row_versions;
+
+  // If another thread created the store in the meantime, the compare-exchange fails and loads that store instead
+  const auto new_row_versions = std::make_shared<RowVersionStore>();
+  if (std::atomic_compare_exchange_strong(&_row_versions, &row_versions, new_row_versions)) return new_row_versions;
+  return row_versions;
+}
+
 size_t MvccData::memory_usage() const {
   auto bytes = size_t{0};
+  if (_is_compacted) {
+    bytes += sizeof(_compacted_invalidated_rows) + _compacted_invalidated_rows.capacity() / CHAR_BIT;
+    if (const auto expanded_mvcc_data = _expanded_mvcc_data.load()) bytes += expanded_mvcc_data->memory_usage();
+    return bytes;
+  }
+
   bytes += sizeof(_tids) + sizeof(_begin_cids) + sizeof(_end_cids);  // NOLINT
   bytes += _tids.size() * sizeof(decltype(_tids)::value_type);
   bytes += _begin_cids.size() * sizeof(decltype(_begin_cids)::value_type);
   bytes += _end_cids.size() * sizeof(decltype(_end_cids)::value_type);
+
+  const auto row_versions = this->row_versions();
+  if (row_versions) bytes += row_versions->memory_usage();
   return bytes;
 }
 
+MvccData& MvccData::_expanded() {
+  if (const auto expanded_mvcc_data = _expanded_mvcc_data.load()) return *expanded_mvcc_data;
+
+  std::lock_guard<std::mutex> lock(_expand_mutex);
+  if (!_expanded_mvcc_data_owner) {
+    auto expanded_mvcc_data = std::make_unique<MvccData>(_compacted_size, _compacted_begin_cid);
+    expanded_mvcc_data->max_begin_cid = max_begin_cid;
+    expanded_mvcc_data->is_finalized = true;
+    for (auto offset = ChunkOffset{0}; offset < _compacted_invalidated_rows.size(); ++offset) {
+      if (_compacted_invalidated_rows[offset]) expanded_mvcc_data->set_end_cid(offset, _compacted_end_cid);
+    }
+
+    _expanded_mvcc_data_owner = std::move(expanded_mvcc_data);
+    _expanded_mvcc_data = _expanded_mvcc_data_owner.get();
+  }
+  return *_expanded_mvcc_data_owner;
+}
+
 }  // namespace opossum
@@ -1,15 +1,26 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>  // NOLINT lint thinks this is a C header or something
+#include <vector>
 
 #include "types.hpp"
 #include "utils/copyable_atomic.hpp"
 
 namespace opossum {
 
+class RowVersionStore;
+
 /**
  * Stores visibility information for multiversion concurrency control.
+ *
+ * Immutable chunks whose rows are visible to all active transactions can replace their MVCC data with a compacted one
+ * (see Chunk::try_compact_mvcc_data()). Compacted MVCC data does not store per-row commit and transaction ids. It only
+ * knows that all rows were inserted at or before a single commit id and, if rows were deleted, which of them were
+ * deleted at or before a second commit id. When a transaction deletes a row of a chunk with compacted MVCC data, the
+ * MVCC data is expanded into per-row vectors again, to which all accessors forward from then on.
  */
 struct MvccData {
   friend class Chunk;
@@ -23,10 +34,29 @@ struct MvccData {
   // Validate::_on_execute for further details.
   std::optional<CommitID> max_begin_cid;
 
+  // Set during Chunk::finalize(). Rows of finalized chunks are not updated in place anymore (see UpdateMode::InPlace),
+  // so that pruning statistics and indexes, which are built for immutable chunks, reflect the segments' values.
+  std::atomic<bool> is_finalized{false};
+
+  // Set when a chunk attempts to replace this MVCC data with a compacted one, and reset if the attempt fails. Rows
+  // must not be locked anymore once it is set (see Delete), as the lock would not be part of the compacted data.
+  std::atomic<bool> is_compacting{false};
+
   // Creates MVCC data that supports a maximum of `size` rows. If the underlying chunk has less rows, the extra rows
   // here are ignored. This is to avoid resizing the vectors, which would cause reallocations and require locking.
   explicit MvccData(const size_t size, CommitID begin_commit_id);
 
+  // Creates compacted MVCC data for `size` rows, which were all inserted at or before `begin_commit_id`. Set rows in
+  // `invalidated_rows` were deleted at or before `end_commit_id`. An empty `invalidated_rows` means no deleted rows.
+  MvccData(const size_t size, const CommitID begin_commit_id, const CommitID end_commit_id,
+           std::vector<bool>&& invalidated_rows);
+
+  bool is_compacted() const;
+
+  // Returns true if the MVCC data is compacted, contains no deleted rows, and no transaction has written to it since.
+  // All of its rows are then visible to every transaction with a snapshot at or after max_begin_cid.
+  bool is_compacted_and_entirely_valid() const;
+
   /**
    * The thread sanitizer (tsan) complains about concurrent writes and reads to begin/end_cids. That is because it is
    * unaware of their thread-safety being guaranteed by the update of the global last_cid. Furthermore, we exploit that
@@ -45,13 +75,36 @@ struct MvccData {
   bool compare_exchange_tid(const ChunkOffset offset, TransactionID expected_transaction_id,
                             TransactionID new_transaction_id);
 
+  /**
+   * Newer versions of rows that were updated in place (see RowVersionStore). The store is created by the first
+   * in-place update of a row in the chunk, row_versions() returns nullptr before that.
+   */
+  std::shared_ptr<RowVersionStore> row_versions() const;
+  std::shared_ptr<RowVersionStore> get_or_create_row_versions();
+
   size_t memory_usage() const;
 
  private:
+  // Returns the expanded MVCC data of compacted MVCC data, expanding it if that did not happen yet
+  MvccData& _expanded();
+
   // These vectors are pre-allocated. Do not resize them as someone might be reading them concurrently.
   pmr_vector<CommitID> _begin_cids;                  // < commit id when record was added
   pmr_vector<CommitID> _end_cids;                    // < commit id when record was deleted
   pmr_vector<copyable_atomic<TransactionID>> _tids;  // < 0 unless locked by a transaction
+
+  std::shared_ptr<RowVersionStore> _row_versions;
+
+  // Only used by compacted MVCC data
+  bool _is_compacted{false};
+  size_t _compacted_size{0};
+  CommitID _compacted_begin_cid{0};
+  CommitID _compacted_end_cid{MAX_COMMIT_ID};
+  std::vector<bool> _compacted_invalidated_rows;
+
+  std::mutex _expand_mutex;
+  std::unique_ptr<MvccData> _expanded_mvcc_data_owner;
+  std::atomic<MvccData*> _expanded_mvcc_data{nullptr};
 };
 
 std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data);
@@ -0,0 +1,181 @@
+#include "row_version_store.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "storage/mvcc_data.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+bool RowVersionStore::add_version(const ChunkOffset chunk_offset, const TransactionID transaction_id,
+                                  const CommitID snapshot_commit_id, const ColumnValues& values,
+                                  const std::optional<CommitID> lowest_active_snapshot_commit_id) {
+  DebugAssert(transaction_id != INVALID_TRANSACTION_ID, "Versions must be created by a transaction");
+
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+
+  auto& versions = _versions[chunk_offset];
+  if (_has_conflicting_version(versions, transaction_id, snapshot_commit_id)) {
+    if (versions.empty()) _versions.erase(chunk_offset);
+    return false;
+  }
+
+  for (const auto& [column_id, value] : values) {
+    _modified_column_ids.emplace(column_id);
+  }
+
+  if (!versions.empty() && versions.back().begin_cid == MvccData::MAX_COMMIT_ID) {
+    auto& own_version = versions.back();
+    for (const auto& [column_id, value] : values) {
+      const auto value_it =
+          std::find_if(own_version.values.begin(), own_version.values.end(),
+                       [column_id = column_id](const auto& column_value) { return column_value.first == column_id; });
+      if (value_it != own_version.values.end()) {
+        value_it->second = value;
+      } else {
+        own_version.values.emplace_back(column_id, value);
+      }
+    }
+    return true;
+  }
+
+  versions.emplace_back(RowVersion{transaction_id, MvccData::MAX_COMMIT_ID, values});
+
+  if (!lowest_active_snapshot_commit_id) return true;
+
+  // Find the newest committed version that all active (and future) transactions see. Older versions are only
+  // needed for the values of columns that the newer versions did not modify. We merge these values into the version
+  // and remove the older ones.
+  auto visible_version_idx = std::optional<size_t>{};
+  for (auto version_idx = size_t{0}; version_idx < versions.size(); ++version_idx) {
+    if (versions[version_idx].begin_cid <= *lowest_active_snapshot_commit_id) visible_version_idx = version_idx;
+  }
+  if (!visible_version_idx || *visible_version_idx == 0) return true;
+
+  auto& visible_version = versions[*visible_version_idx];
+  for (auto version_idx = *visible_version_idx; version_idx > 0; --version_idx) {
+    for (const auto& [column_id, value] : versions[version_idx - 1].values) {
+      const auto value_it =
+          std::find_if(visible_version.values.cbegin(), visible_version.values.cend(),
+                       [column_id = column_id](const auto& column_value) { return column_value.first == column_id; });
+      if (value_it == visible_version.values.cend()) visible_version.values.emplace_back(column_id, value);
+    }
+  }
+  versions.erase(versions.begin(), versions.begin() + *visible_version_idx);
+  return true;
+}
+
+void RowVersionStore::commit_version(const ChunkOffset chunk_offset, const TransactionID transaction_id,
+                                     const CommitID commit_id) {
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+
+  const auto versions_it = _versions.find(chunk_offset);
+  if (versions_it == _versions.end()) return;
+
+  auto& newest_version = versions_it->second.back();
+  if (newest_version.begin_cid == MvccData::MAX_COMMIT_ID && newest_version.transaction_id == transaction_id) {
+    newest_version.begin_cid = commit_id;
+  }
+}
+
+void RowVersionStore::remove_version(const ChunkOffset chunk_offset, const TransactionID transaction_id) {
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+
+  const auto versions_it = _versions.find(chunk_offset);
+  if (versions_it == _versions.end()) return;
+
+  auto& versions = versions_it->second;
+  if (versions.back().begin_cid == MvccData::MAX_COMMIT_ID && versions.back().transaction_id == transaction_id) {
+    versions.pop_back();
+    if (versions.empty()) _versions.erase(versions_it);
+  }
+}
+
+bool RowVersionStore::has_conflicting_version(const ChunkOffset chunk_offset, const TransactionID transaction_id,
+                                              const CommitID snapshot_commit_id) const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+
+  const auto versions_it = _versions.find(chunk_offset);
+  if (versions_it == _versions.end()) return false;
+
+  return _has_conflicting_version(versions_it->second, transaction_id, snapshot_commit_id);
+}
+
+std::vector<std::pair<ChunkOffset, AllTypeVariant>> RowVersionStore::visible_values(
+    const ColumnID column_id, const TransactionID transaction_id, const CommitID snapshot_commit_id) const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+
+  auto visible_values = std::vector<std::pair<ChunkOffset, AllTypeVariant>>{};
+  if (!_modified_column_ids.contains(column_id)) return visible_values;
+
+  for (const auto& [chunk_offset, versions] : _versions) {
+    // The newest visible version that modified the column determines the value
+    for (auto version_it = versions.crbegin(); version_it != versions.crend(); ++version_it) {
+      if (!_is_visible(*version_it, transaction_id, snapshot_commit_id)) continue;
+
+      const auto value_it =
+          std::find_if(version_it->values.cbegin(), version_it->values.cend(),
+                       [&](const auto& column_value) { return column_value.first == column_id; });
+      if (value_it != version_it->values.cend()) {
+        visible_values.emplace_back(chunk_offset, value_it->second);
+        break;
+      }
+    }
+  }
+
+  return visible_values;
+}
+
+bool RowVersionStore::modifies_column(const ColumnID column_id) const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return _modified_column_ids.contains(column_id);
+}
+
+bool RowVersionStore::empty() const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return _versions.empty();
+}
+
+size_t RowVersionStore::version_count() const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+
+  auto version_count = size_t{0};
+  for (const auto& [chunk_offset, versions] : _versions) {
+    version_count += versions.size();
+  }
+  return version_count;
+}
+
+size_t RowVersionStore::memory_usage() const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+
+  auto bytes = sizeof(*this);
+  for (const auto& [chunk_offset, versions] : _versions) {
+    bytes += sizeof(chunk_offset) + sizeof(versions) + versions.capacity() * sizeof(RowVersion);
+    for (const auto& version : versions) {
+      bytes += version.values.capacity() * sizeof(ColumnValues::value_type);
+    }
+  }
+  return bytes;
+}
+
+bool RowVersionStore::_has_conflicting_version(const std::vector<RowVersion>& versions,
+                                               const TransactionID transaction_id, const CommitID snapshot_commit_id) {
+  // Versions are ordered, so only the newest one can be uncommitted or invisible to the snapshot
+  if (versions.empty()) return false;
+
+  const auto& newest_version = versions.back();
+  if (newest_version.begin_cid == MvccData::MAX_COMMIT_ID) return newest_version.transaction_id != transaction_id;
+  return newest_version.begin_cid > snapshot_commit_id;
+}
+
+bool RowVersionStore::_is_visible(const RowVersion& version, const TransactionID transaction_id,
+                                  const CommitID snapshot_commit_id) {
+  if (version.begin_cid == MvccData::MAX_COMMIT_ID) {
+    return transaction_id != INVALID_TRANSACTION_ID && version.transaction_id == transaction_id;
+  }
+  return version.begin_cid <= snapshot_commit_id;
+}
+
+}  // namespace opossum
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <shared_mutex>  // NOLINT lint thinks this is a C header or something
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Stores the newer versions of rows that were updated in place (see UpdateMode::InPlace). The segments of the chunk
+ * keep the values that the rows were inserted with. Each version only holds the values of the columns that the
+ * update modified. GetTable reconstructs the values that are visible to a transaction from the versions.
+ *
+ * Only the transaction that added an uncommitted version commits or removes it.
+ */
+class RowVersionStore : private Noncopyable {
+ public:
+  using ColumnValues = std::vector<std::pair<ColumnID, AllTypeVariant>>;
+
+  struct RowVersion {
+    // Transaction that created the version
+    TransactionID transaction_id;
+
+    // MvccData::MAX_COMMIT_ID until the transaction has committed
+    CommitID begin_cid;
+
+    ColumnValues values;
+  };
+
+  /**
+   * Adds a version of the row at @param chunk_offset. If the transaction has already created an uncommitted version
+   * of the row, the values are merged into it. Versions that are not visible to any transaction at or after
+   * @param lowest_active_snapshot_commit_id anymore are merged into their successor and removed.
+   * Returns false without adding the version if the row has a conflicting version (see has_conflicting_version).
+   */
+  bool add_version(const ChunkOffset chunk_offset, const TransactionID transaction_id,
+                   const CommitID snapshot_commit_id, const ColumnValues& values,
+                   const std::optional<CommitID> lowest_active_snapshot_commit_id);
+
+  // Sets the begin_cid of the transaction's uncommitted version (if any)
+  void commit_version(const ChunkOffset chunk_offset, const TransactionID transaction_id, const CommitID commit_id);
+
+  // Removes the transaction's uncommitted version (if any)
+  void remove_version(const ChunkOffset chunk_offset, const TransactionID transaction_id);
+
+  /**
+   * Returns true if another transaction holds an uncommitted version of the row or committed a version that is not
+   * visible at @param snapshot_commit_id. The uncommitted version acts as the row's lock for in-place updates, as
+   * the row's TID cannot be used without hiding the row from the updating transaction (see Validate::is_row_visible).
+   */
+  bool has_conflicting_version(const ChunkOffset chunk_offset, const TransactionID transaction_id,
+                               const CommitID snapshot_commit_id) const;
+
+  /**
+   * Returns the values of @param column_id that are visible to the given transaction and differ from those in the
+   * segment. Pass INVALID_TRANSACTION_ID if there is no transaction.
+   */
+  std::vector<std::pair<ChunkOffset, AllTypeVariant>> visible_values(const ColumnID column_id,
+                                                                     const TransactionID transaction_id,
+                                                                     const CommitID snapshot_commit_id) const;
+
+  // Returns true if any version holds a value for @param column_id
+  bool modifies_column(const ColumnID column_id) const;
+
+  bool empty() const;
+
+  size_t version_count() const;
+
+  size_t memory_usage() const;
+
+ private:
+  static bool _has_conflicting_version(const std::vector<RowVersion>& versions, const TransactionID transaction_id,
+                                       const CommitID snapshot_commit_id);
+  static bool _is_visible(const RowVersion& version, const TransactionID transaction_id,
+                          const CommitID snapshot_commit_id);
+
+  mutable std::shared_mutex _mutex;
+
+  // Versions of each row, from the oldest to the newest one
+  std::unordered_map<ChunkOffset, std::vector<RowVersion>> _versions;
+  std::set<ColumnID> _modified_column_ids;
+};
+
+}  // namespace opossum
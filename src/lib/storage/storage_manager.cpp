@@ -13,6 +13,7 @@
 #include "scheduler/job_task.hpp"
 #include "statistics/generate_pruning_statistics.hpp"
 #include "statistics/table_statistics.hpp"
+#include "statistics/table_statistics_maintainer.hpp"
 #include "utils/assert.hpp"
 #include "utils/meta_table_manager.hpp"
 
@@ -37,6 +38,7 @@ void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> t
 
   table->set_table_statistics(TableStatistics::from_table(*table));
   generate_chunk_pruning_statistics(table);
+  table->set_statistics_maintainer(std::make_shared<TableStatisticsMaintainer>(*table));
 
   _tables[name] = std::move(table);
 }
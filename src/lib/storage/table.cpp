@@ -12,6 +12,7 @@
 #include "resolve_type.hpp"
 #include "statistics/attribute_statistics.hpp"
 #include "statistics/table_statistics.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
 #include "storage/segment_iterate.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -65,6 +66,14 @@ TableType Table::type() const { return _type; }
 
 UseMvcc Table::uses_mvcc() const { return _use_mvcc; }
 
+UpdateMode Table::update_mode() const { return _update_mode; }
+
+void Table::set_update_mode(const UpdateMode update_mode) {
+  Assert(update_mode == UpdateMode::DeleteInsert || _use_mvcc == UseMvcc::Yes,
+         "In-place updates require MVCC to keep the previous versions of rows");
+  _update_mode = update_mode;
+}
+
 ColumnCount Table::column_count() const {
   return ColumnCount{static_cast<ColumnCount::base_type>(_column_definitions.size())};
 }
@@ -222,6 +231,10 @@ void Table::remove_chunk(ChunkID chunk_id) {
               "Physical delete of chunk prevented: Chunk needs to be fully invalidated before.");
   Assert(_type == TableType::Data, "Removing chunks from other tables than data tables is not intended yet.");
   std::atomic_store(&_chunks[chunk_id], std::shared_ptr<Chunk>(nullptr));
+
+  for (const auto& table_hash_index : _table_hash_indexes) {
+    table_hash_index->remove_chunk(chunk_id);
+  }
 }
 
 void Table::append_chunk(const Segments& segments, std::shared_ptr<MvccData> mvcc_data,  // NOLINT
@@ -303,19 +316,112 @@ std::vector<std::vector<AllTypeVariant>> Table::get_rows() const {
 
 std::unique_lock<std::mutex> Table::acquire_append_mutex() { return std::unique_lock<std::mutex>(*_append_mutex); }
 
-std::shared_ptr<TableStatistics> Table::table_statistics() const { return _table_statistics; }
+std::shared_ptr<TableStatistics> Table::table_statistics() const { return std::atomic_load(&_table_statistics); }
 
 void Table::set_table_statistics(const std::shared_ptr<TableStatistics>& table_statistics) {
-  _table_statistics = table_statistics;
+  std::atomic_store(&_table_statistics, table_statistics);
+}
+
+std::optional<size_t> Table::statistics_sample_row_count() const { return _statistics_sample_row_count; }
+
+void Table::set_statistics_sample_row_count(const std::optional<size_t>& statistics_sample_row_count) {
+  Assert(!statistics_sample_row_count || *statistics_sample_row_count > 0, "Statistics sample must not be empty");
+  _statistics_sample_row_count = statistics_sample_row_count;
+}
+
+std::shared_ptr<TableStatisticsMaintainer> Table::statistics_maintainer() const { return _statistics_maintainer; }
+
+void Table::set_statistics_maintainer(const std::shared_ptr<TableStatisticsMaintainer>& statistics_maintainer) {
+  _statistics_maintainer = statistics_maintainer;
 }
 
 std::vector<IndexStatistics> Table::indexes_statistics() const { return _indexes; }
 
+std::shared_ptr<TableHashIndex> Table::create_table_hash_index(const std::vector<ColumnID>& column_ids) {
+  Assert(_type == TableType::Data, "Table hash indexes can only be created on data tables");
+  Assert(!get_table_hash_index(column_ids), "Table hash index on these columns already exists");
+
+  auto data_types = std::vector<DataType>{};
+  data_types.reserve(column_ids.size());
+  for (const auto column_id : column_ids) {
+    Assert(column_id < column_count(), "ColumnID out of range");
+    data_types.emplace_back(column_data_type(column_id));
+  }
+
+  const auto table_hash_index = std::make_shared<TableHashIndex>(column_ids, data_types);
+
+  const auto chunk_count = _chunks.size();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    table_hash_index->insert(*chunk, chunk_id, ChunkOffset{0}, chunk->size());
+  }
+
+  _table_hash_indexes.emplace_back(table_hash_index);
+  return table_hash_index;
+}
+
+const std::vector<std::shared_ptr<TableHashIndex>>& Table::table_hash_indexes() const { return _table_hash_indexes; }
+
+std::shared_ptr<TableHashIndex> Table::get_table_hash_index(const std::vector<ColumnID>& column_ids) const {
+  for (const auto& table_hash_index : _table_hash_indexes) {
+    if (table_hash_index->column_ids() == column_ids) return table_hash_index;
+  }
+  return nullptr;
+}
+
 const std::vector<TableConstraintDefinition>& Table::get_soft_unique_constraints() const {
   return _constraint_definitions;
 }
 
 void Table::add_soft_unique_constraint(const std::vector<ColumnID>& column_ids, const IsPrimaryKey is_primary_key) {
+  _add_unique_constraint(column_ids, is_primary_key, IsEnforced::No);
+}
+
+void Table::add_unique_constraint(const std::vector<ColumnID>& column_ids, const IsPrimaryKey is_primary_key) {
+  Assert(_use_mvcc == UseMvcc::Yes, "Unique constraints can only be enforced for tables with MVCC data");
+
+  auto sorted_column_ids = column_ids;
+  std::sort(sorted_column_ids.begin(), sorted_column_ids.end());
+
+  auto table_hash_index = get_table_hash_index(sorted_column_ids);
+  if (!table_hash_index) table_hash_index = create_table_hash_index(sorted_column_ids);
+
+  // Check that no two rows that have not been deleted share a key. As modifications must not happen concurrently, we
+  // do not need to consider transactions that are in flight.
+  auto matches = RowIDPosList{};
+  auto key = std::vector<AllTypeVariant>(sorted_column_ids.size());
+  const auto chunk_count = _chunks.size();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    const auto& mvcc_data = chunk->mvcc_data();
+    const auto chunk_size = chunk->size();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      if (mvcc_data->get_end_cid(chunk_offset) != MvccData::MAX_COMMIT_ID) continue;
+
+      for (auto key_column_idx = size_t{0}; key_column_idx < sorted_column_ids.size(); ++key_column_idx) {
+        key[key_column_idx] = (*chunk->get_segment(sorted_column_ids[key_column_idx]))[chunk_offset];
+      }
+
+      matches.clear();
+      table_hash_index->lookup(key, matches);
+      const auto live_match_count = std::count_if(matches.begin(), matches.end(), [&](const auto& row_id) {
+        const auto matching_chunk = get_chunk(row_id.chunk_id);
+        return matching_chunk &&
+               matching_chunk->mvcc_data()->get_end_cid(row_id.chunk_offset) == MvccData::MAX_COMMIT_ID;
+      });
+      Assert(live_match_count <= 1, "Existing rows violate the unique constraint");
+    }
+  }
+
+  _add_unique_constraint(sorted_column_ids, is_primary_key, IsEnforced::Yes);
+}
+
+void Table::_add_unique_constraint(const std::vector<ColumnID>& column_ids, const IsPrimaryKey is_primary_key,
+                                   const IsEnforced is_enforced) {
   for (const auto& column_id : column_ids) {
     Assert(column_id < column_count(), "ColumnID out of range");
     Assert(is_primary_key == IsPrimaryKey::No || !column_is_nullable(column_id),
@@ -333,7 +439,7 @@ void Table::add_soft_unique_constraint(const std::vector<ColumnID>& column_ids,
 
     auto sorted_columns_ids = column_ids;
     std::sort(sorted_columns_ids.begin(), sorted_columns_ids.end());
-    TableConstraintDefinition new_constraint{sorted_columns_ids, is_primary_key};
+    TableConstraintDefinition new_constraint{sorted_columns_ids, is_primary_key, is_enforced};
 
     Assert(std::find_if(_constraint_definitions.begin(), _constraint_definitions.end(),
                         [&new_constraint](const auto& existing_constraint) {
@@ -360,6 +466,10 @@ size_t Table::memory_usage(const MemoryUsageCalculationMode mode) const {
     bytes += column_definition.name.size();
   }
 
+  for (const auto& table_hash_index : _table_hash_indexes) {
+    bytes += table_hash_index->memory_usage();
+  }
+
   // TODO(anybody) Statistics and Indexes missing from Memory Usage Estimation
   // TODO(anybody) TableLayout missing
 
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,7 +19,9 @@
 
 namespace opossum {
 
+class TableHashIndex;
 class TableStatistics;
+class TableStatisticsMaintainer;
 
 /**
  * A Table is partitioned horizontally into a number of chunks.
@@ -65,6 +68,10 @@ class Table : private Noncopyable {
 
   UseMvcc uses_mvcc() const;
 
+  // How the LQPTranslator translates UPDATE statements on this table. InPlace requires MVCC.
+  UpdateMode update_mode() const;
+  void set_update_mode(const UpdateMode update_mode);
+
   // For data tables, returns the target chunk size (i.e., the number of rows pre-allocated in the ValueSegment).
   ChunkOffset target_chunk_size() const;
 
@@ -177,6 +184,16 @@ class Table : private Noncopyable {
   std::shared_ptr<TableStatistics> table_statistics() const;
 
   void set_table_statistics(const std::shared_ptr<TableStatistics>& table_statistics);
+
+  // Number of rows sampled by TableStatistics::from_table. If unset, DEFAULT_STATISTICS_SAMPLE_ROW_COUNT is used.
+  std::optional<size_t> statistics_sample_row_count() const;
+
+  void set_statistics_sample_row_count(const std::optional<size_t>& statistics_sample_row_count);
+
+  // Keeps the statistics current under inserts and deletes. Set by the StorageManager, nullptr for other tables.
+  std::shared_ptr<TableStatisticsMaintainer> statistics_maintainer() const;
+
+  void set_statistics_maintainer(const std::shared_ptr<TableStatisticsMaintainer>& statistics_maintainer);
   /** @} */
 
   std::vector<IndexStatistics> indexes_statistics() const;
@@ -196,6 +213,20 @@ class Table : private Noncopyable {
     _indexes.emplace_back(index_statistics);
   }
 
+  /**
+   * Table-level hash indexes span all chunks of the table, see TableHashIndex. They are kept up to date by the Insert
+   * operator. Creating an index indexes all existing rows; like create_index, this must not happen concurrently with
+   * modifications of the table.
+   * @{
+   */
+  std::shared_ptr<TableHashIndex> create_table_hash_index(const std::vector<ColumnID>& column_ids);
+
+  const std::vector<std::shared_ptr<TableHashIndex>>& table_hash_indexes() const;
+
+  // Returns the index on exactly the given columns (in this order) or nullptr if there is none
+  std::shared_ptr<TableHashIndex> get_table_hash_index(const std::vector<ColumnID>& column_ids) const;
+  /** @} */
+
   /**
    * Add a unique constraint. The column IDs can be passed in an arbitrary order, they will be sorted
    * by this method. Constraint column IDs will always be sorted from here on.
@@ -203,6 +234,16 @@ class Table : private Noncopyable {
    * We call them "soft" constraints to draw attention to that.
    */
   void add_soft_unique_constraint(const std::vector<ColumnID>& column_ids, const IsPrimaryKey is_primary_key);
+
+  /**
+   * Add a unique constraint that is enforced: Insert (and thus Update) fails the transaction if it would add a row with
+   * the same key as a committed row or a row inserted by a transaction that is still in flight. NULL keys are exempt.
+   * The constraint is backed by a table hash index on the sorted column IDs, which is created if it does not exist
+   * yet. The existing rows must satisfy the constraint. This must not happen concurrently with modifications.
+   */
+  void add_unique_constraint(const std::vector<ColumnID>& column_ids, const IsPrimaryKey is_primary_key);
+
+  // Returns both soft and enforced constraints
   const std::vector<TableConstraintDefinition>& get_soft_unique_constraints() const;
 
   /**
@@ -211,10 +252,14 @@ class Table : private Noncopyable {
   size_t memory_usage(const MemoryUsageCalculationMode mode) const;
 
  protected:
+  void _add_unique_constraint(const std::vector<ColumnID>& column_ids, const IsPrimaryKey is_primary_key,
+                              const IsEnforced is_enforced);
+
   const TableColumnDefinitions _column_definitions;
   const TableType _type;
   const UseMvcc _use_mvcc;
   const ChunkOffset _target_chunk_size;
+  UpdateMode _update_mode{UpdateMode::DeleteInsert};
 
   /**
    * To prevent data races for TableType::Data tables, we must access _chunks atomically.
@@ -229,9 +274,14 @@ class Table : private Noncopyable {
 
   std::vector<TableConstraintDefinition> _constraint_definitions;
 
+  // Accessed with std::atomic_load() and std::atomic_store(), as the TableStatisticsMaintainer replaces the statistics
+  // while they are being used for optimization.
   std::shared_ptr<TableStatistics> _table_statistics;
+  std::optional<size_t> _statistics_sample_row_count;
+  std::shared_ptr<TableStatisticsMaintainer> _statistics_maintainer;
   std::unique_ptr<std::mutex> _append_mutex;
   std::vector<IndexStatistics> _indexes;
+  std::vector<std::shared_ptr<TableHashIndex>> _table_hash_indexes;
 
   // For tables with _type==Reference, the row count will not vary. As such, there is no need to iterate over all
   // chunks more than once.
@@ -153,7 +153,8 @@ constexpr ValueID INVALID_VALUE_ID{std::numeric_limits<ValueID::base_type>::max(
 // The Scheduler currently supports just these 3 priorities, subject to change.
 enum class SchedulePriority {
   Default = 1,  // Schedule task at the end of the queue
-  High = 0      // Schedule task at the beginning of the queue
+  High = 0,     // Schedule task at the beginning of the queue
+  Low = 2       // Schedule task behind default tasks, but with a guaranteed share of the workers (see TaskQueue)
 };
 
 enum class PredicateCondition {
@@ -206,6 +207,9 @@ PredicateCondition conditions_to_between(const PredicateCondition lower, const P
 //                      dropped. This behavior mirrors NOT EXISTS
 enum class JoinMode { Inner, Left, Right, FullOuter, Cross, Semi, AntiNullAsTrue, AntiNullAsFalse };
 
+// Input of an index join whose index is used to find the join partners of the other input's rows
+enum class IndexSide { Left, Right };
+
 // SQL set operations come in two flavors, with and without `ALL`, e.g., `UNION` and `UNION ALL`.
 // We have a third mode (Positions) that is used to intersect position lists that point to the same table,
 // see union_positions.hpp for details.
@@ -219,6 +223,8 @@ enum class DescriptionMode { SingleLine, MultiLine };
 
 enum class UseMvcc : bool { Yes = true, No = false };
 
+enum class UseQueryArena : bool { Yes = true, No = false };
+
 enum class RollbackReason : bool { User, Conflict };
 
 enum class MemoryUsageCalculationMode { Sampled, Full };
@@ -229,6 +235,13 @@ enum class MetaTableChangeType { Insert, Delete, Update };
 
 enum class AutoCommit : bool { Yes = true, No = false };
 
+// ReadOnly transactions read a snapshot of the database without acquiring a transaction id and cannot modify data
+enum class TransactionMode : bool { ReadWrite, ReadOnly };
+
+// DeleteInsert invalidates the updated rows and inserts new ones, InPlace stores the modified values as new versions
+// of the updated rows (see RowVersionStore)
+enum class UpdateMode { DeleteInsert, InPlace };
+
 enum class LogLevel { Debug, Info, Warning };
 
 // Used as a template parameter that is passed whenever we conditionally erase the type of a template. This is done to
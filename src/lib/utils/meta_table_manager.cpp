@@ -9,6 +9,7 @@
 #include "utils/meta_tables/meta_segments_table.hpp"
 #include "utils/meta_tables/meta_settings_table.hpp"
 #include "utils/meta_tables/meta_tables_table.hpp"
+#include "utils/meta_tables/meta_transactions_table.hpp"
 
 namespace opossum {
 
@@ -21,7 +22,8 @@ MetaTableManager::MetaTableManager() {
                                                                        std::make_shared<MetaSegmentsTable>(),
                                                                        std::make_shared<MetaSegmentsAccurateTable>(),
                                                                        std::make_shared<MetaPluginsTable>(),
-                                                                       std::make_shared<MetaSettingsTable>()};
+                                                                       std::make_shared<MetaSettingsTable>(),
+                                                                       std::make_shared<MetaTransactionsTable>()};
 
   _table_names.reserve(_meta_tables.size());
   for (const auto& table : meta_tables) {
@@ -0,0 +1,38 @@
+#include "meta_transactions_table.hpp"
+
+#include "hyrise.hpp"
+
+namespace opossum {
+
+MetaTransactionsTable::MetaTransactionsTable()
+    : AbstractMetaTable(TableColumnDefinitions{{"committed", DataType::Long, false},
+                                               {"rolled_back_by_user", DataType::Long, false},
+                                               {"rolled_back_after_conflict", DataType::Long, false},
+                                               {"abort_rate", DataType::Double, false},
+                                               {"lock_waits", DataType::Long, false},
+                                               {"failed_lock_waits", DataType::Long, false}}) {}
+
+const std::string& MetaTransactionsTable::name() const {
+  static const auto name = std::string{"transactions"};
+  return name;
+}
+
+std::shared_ptr<Table> MetaTransactionsTable::_on_generate() const {
+  auto output_table = std::make_shared<Table>(_column_definitions, TableType::Data, std::nullopt, UseMvcc::Yes);
+
+  const auto statistics = Hyrise::get().transaction_manager.statistics();
+  const auto finished_count = statistics.committed_count + statistics.rolled_back_by_user_count +
+                              statistics.rolled_back_after_conflict_count;
+  const auto abort_rate =
+      finished_count > 0 ? static_cast<double>(statistics.rolled_back_after_conflict_count) / finished_count : 0.0;
+
+  output_table->append({static_cast<int64_t>(statistics.committed_count),
+                        static_cast<int64_t>(statistics.rolled_back_by_user_count),
+                        static_cast<int64_t>(statistics.rolled_back_after_conflict_count), abort_rate,
+                        static_cast<int64_t>(statistics.lock_wait_count),
+                        static_cast<int64_t>(statistics.failed_lock_wait_count)});
+
+  return output_table;
+}
+
+}  // namespace opossum
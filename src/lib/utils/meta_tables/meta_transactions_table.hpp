@@ -0,0 +1,23 @@
+#pragma once
+
+#include "utils/meta_tables/abstract_meta_table.hpp"
+
+namespace opossum {
+
+/**
+ * This is a class for showing how many transactions committed or were rolled back since the start of the database,
+ * e.g., to monitor the abort rate under contention. The abort rate is the share of finished transactions that were
+ * rolled back due to a conflict. Lock waits are described in TransactionManager::lock_wait_timeout().
+ */
+class MetaTransactionsTable : public AbstractMetaTable {
+ public:
+  MetaTransactionsTable();
+
+  const std::string& name() const final;
+
+ protected:
+  friend class MetaTransactionsTest;
+  std::shared_ptr<Table> _on_generate() const final;
+};
+
+}  // namespace opossum
@@ -28,7 +28,7 @@ class AbstractSetting : public Noncopyable, public std::enable_shared_from_this<
 
   virtual const std::string& description() const = 0;
 
-  virtual const std::string& get() = 0;
+  virtual std::string get() = 0;
 
   virtual void set(const std::string& value) = 0;
 
@@ -0,0 +1,38 @@
+#include "integral_setting.hpp"
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+IntegralSetting::IntegralSetting(const std::string& init_name, const int64_t init_value,
+                                 const std::string& init_description)
+    : AbstractSetting(init_name),
+      _description(init_description),
+      _value(init_value),
+      _string_value(std::to_string(init_value)) {}
+
+const std::string& IntegralSetting::description() const { return _description; }
+
+std::string IntegralSetting::get() {
+  const auto lock = std::lock_guard<std::mutex>{_string_value_mutex};
+  return _string_value;
+}
+
+void IntegralSetting::set(const std::string& value) {
+  auto parsed_value = int64_t{0};
+  auto parsed_characters = size_t{0};
+  try {
+    parsed_value = std::stoll(value, &parsed_characters);
+  } catch (const std::logic_error&) {
+    AssertInput(false, "Value '" + value + "' of setting " + name + " is not an integer");
+  }
+  AssertInput(parsed_characters == value.size(), "Value '" + value + "' of setting " + name + " is not an integer");
+
+  const auto lock = std::lock_guard<std::mutex>{_string_value_mutex};
+  _value = parsed_value;
+  _string_value = std::to_string(parsed_value);
+}
+
+int64_t IntegralSetting::value() const { return _value.load(); }
+
+}  // namespace opossum
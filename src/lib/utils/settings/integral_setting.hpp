@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "utils/settings/abstract_setting.hpp"
+
+namespace opossum {
+
+/**
+ * Setting holding a single integer, e.g., a limit or a threshold. Components that read the value on hot paths should
+ * use value(), which is a cheap atomic load, instead of parsing the string returned by get().
+ */
+class IntegralSetting : public AbstractSetting {
+ public:
+  IntegralSetting(const std::string& init_name, const int64_t init_value, const std::string& init_description);
+
+  const std::string& description() const final;
+
+  std::string get() final;
+
+  // Throws an InvalidInputException if the value is not an integer.
+  void set(const std::string& value) final;
+
+  int64_t value() const;
+
+ private:
+  const std::string _description;
+  std::atomic<int64_t> _value;
+
+  // Serializes set() and get() so that _value and _string_value stay consistent and get() never reads a string that
+  // is being assigned
+  std::mutex _string_value_mutex;
+  std::string _string_value;
+};
+
+}  // namespace opossum
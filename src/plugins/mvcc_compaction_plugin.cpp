@@ -0,0 +1,61 @@
+#include "mvcc_compaction_plugin.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "storage/table.hpp"
+
+namespace opossum {
+
+const std::string MvccCompactionPlugin::description() const { return "MVCC data compaction plugin"; }
+
+void MvccCompactionPlugin::start() {
+  _loop_thread_compaction =
+      std::make_unique<PausableLoopThread>(IDLE_DELAY_COMPACTION, [&](size_t) { _compaction_loop(); });
+}
+
+void MvccCompactionPlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_compaction.reset();
+}
+
+void MvccCompactionPlugin::_compaction_loop() {
+  // Read the last commit ID before scanning the active snapshots. If it were read afterwards (or only when no snapshot
+  // is active), transactions that began during the scan could hold a snapshot older than the compaction horizon.
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  const auto last_commit_id = transaction_manager.last_commit_id();
+  const auto lowest_active_snapshot_commit_id = transaction_manager.get_lowest_active_snapshot_commit_id();
+  const auto lowest_snapshot_commit_id =
+      lowest_active_snapshot_commit_id ? std::min(*lowest_active_snapshot_commit_id, last_commit_id) : last_commit_id;
+
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    if (table->uses_mvcc() != UseMvcc::Yes) continue;
+    auto saved_memory = int64_t{0};
+    auto num_chunks = size_t{0};
+
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk || chunk->is_mutable() || chunk->mvcc_data()->is_compacted()) continue;
+
+      const auto previous_memory = static_cast<int64_t>(chunk->mvcc_data()->memory_usage());
+      if (chunk->try_compact_mvcc_data(lowest_snapshot_commit_id)) {
+        saved_memory += previous_memory - static_cast<int64_t>(chunk->mvcc_data()->memory_usage());
+        ++num_chunks;
+      }
+    }
+
+    if (num_chunks > 0) {
+      std::ostringstream message;
+      const auto saved_mb = static_cast<double>(saved_memory) / (1000.0 * 1000.0);
+      message << "Compacted the MVCC data of " << num_chunks << " chunk(s) of " << table_name << ", saved approx. "
+              << std::setprecision(2) << saved_mb << " MB";
+      Hyrise::get().log_manager.add_message("MvccCompactionPlugin", message.str(), LogLevel::Info);
+    }
+  }
+}
+
+EXPORT_PLUGIN(MvccCompactionPlugin)
+
+}  // namespace opossum
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "hyrise.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace opossum {
+
+/*
+ * Most chunks of read-mostly tables are never modified after they have been loaded. Still, their MVCC data stores a
+ * begin and end commit id as well as a transaction id for every row, and Validate looks at these for chunks with
+ * deleted rows. This plugin periodically replaces the MVCC data of immutable chunks whose rows are visible to all
+ * active transactions with compacted MVCC data (see Chunk::try_compact_mvcc_data()), which only keeps a bitmap of the
+ * deleted rows.
+ */
+class MvccCompactionPlugin : public AbstractPlugin {
+  friend class MvccCompactionPluginTest;
+
+ public:
+  const std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  // IDLE_DELAY_COMPACTION: sleep after each pass over all tables
+  constexpr static std::chrono::milliseconds IDLE_DELAY_COMPACTION = std::chrono::milliseconds(1000);
+
+ private:
+  void _compaction_loop();
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_compaction;
+};
+
+}  // namespace opossum
@@ -0,0 +1,50 @@
+#include <sstream>
+
+#include "../base_test.hpp"
+
+#include "cardinality_estimation_evaluation.hpp"
+#include "hyrise.hpp"
+#include "statistics/column_pair_statistics.hpp"
+#include "statistics/table_statistics.hpp"
+
+namespace opossum {
+
+class CardinalityEstimationEvaluationTest : public BaseTest {
+ public:
+  void SetUp() override {
+    Hyrise::get().storage_manager.add_table("int_int_int", load_table("resources/test_data/tbl/int_int_int.tbl", 2));
+    Hyrise::get().storage_manager.add_table("int_float", load_table("resources/test_data/tbl/int_float.tbl", 2));
+  }
+};
+
+TEST_F(CardinalityEstimationEvaluationTest, AddColumnPairStatisticsForQueries) {
+  add_column_pair_statistics_for_queries(
+      {"SELECT * FROM int_int_int WHERE a > 1 AND b < 20",
+       "SELECT * FROM int_int_int AS x, int_float AS y WHERE x.a = y.a AND x.c = 5 AND x.a < 100 AND y.b > 1.0"});
+
+  const auto statistics = Hyrise::get().storage_manager.get_table("int_int_int")->table_statistics();
+  EXPECT_TRUE(statistics->column_pair_statistics(ColumnID{0}, ColumnID{1}));
+  EXPECT_TRUE(statistics->column_pair_statistics(ColumnID{0}, ColumnID{2}));
+
+  // b and c are not filtered on by the same query
+  EXPECT_FALSE(statistics->column_pair_statistics(ColumnID{1}, ColumnID{2}));
+
+  // y.b is the only filtered column of int_float
+  const auto other_statistics = Hyrise::get().storage_manager.get_table("int_float")->table_statistics();
+  EXPECT_TRUE(other_statistics->column_pair_statistics_list.empty());
+}
+
+TEST_F(CardinalityEstimationEvaluationTest, ReportCardinalityEstimationErrors) {
+  auto stream = std::stringstream{};
+  report_cardinality_estimation_errors({{"q1", "SELECT * FROM int_int_int WHERE a > 1"},
+                                        {"q2", "SELECT * FROM int_int_int AS x, int_float AS y WHERE x.a = y.a"}},
+                                       stream);
+
+  const auto report = stream.str();
+  EXPECT_NE(report.find("q1"), std::string::npos);
+  EXPECT_NE(report.find("q2"), std::string::npos);
+  EXPECT_NE(report.find("All operators"), std::string::npos);
+  EXPECT_EQ(report.find("Joins: none"), std::string::npos);
+}
+
+}  // namespace opossum
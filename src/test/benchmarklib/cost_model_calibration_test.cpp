@@ -0,0 +1,40 @@
+#include "../base_test.hpp"
+
+#include "cost_model_calibration.hpp"
+
+namespace opossum {
+
+class CostModelCalibrationTest : public BaseTest {};
+
+TEST_F(CostModelCalibrationTest, FitCoefficients) {
+  // runtime = 2 * x + 3 * y
+  const auto features = std::vector<std::vector<double>>{{1, 0}, {0, 1}, {10, 5}, {100, 1000}};
+  const auto runtimes = std::vector<double>{2, 3, 35, 3200};
+
+  const auto coefficients = CostModelCalibration::fit_coefficients(features, runtimes);
+  ASSERT_TRUE(coefficients);
+  ASSERT_EQ(coefficients->size(), size_t{2});
+  EXPECT_NEAR((*coefficients)[0], 2.0, 1e-6);
+  EXPECT_NEAR((*coefficients)[1], 3.0, 1e-6);
+}
+
+TEST_F(CostModelCalibrationTest, FitCoefficientsNonNegative) {
+  // The unconstrained fit of runtime = 4 * x - y would give the second feature a negative coefficient
+  const auto features = std::vector<std::vector<double>>{{1, 1}, {2, 1}, {4, 2}, {8, 1}};
+  const auto runtimes = std::vector<double>{3, 7, 14, 31};
+
+  const auto coefficients = CostModelCalibration::fit_coefficients(features, runtimes);
+  ASSERT_TRUE(coefficients);
+  EXPECT_GT((*coefficients)[0], 0.0);
+  EXPECT_EQ((*coefficients)[1], 0.0);
+}
+
+TEST_F(CostModelCalibrationTest, FitCoefficientsUnderdetermined) {
+  // Linearly dependent features
+  EXPECT_FALSE(CostModelCalibration::fit_coefficients({{1, 2}, {2, 4}, {3, 6}}, {1, 2, 3}));
+
+  // Fewer measurements than features
+  EXPECT_FALSE(CostModelCalibration::fit_coefficients({{1, 2}}, {1}));
+}
+
+}  // namespace opossum
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "concurrency/cancellation_token.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/product.hpp"
+#include "operators/table_wrapper.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class CancellationTokenTest : public BaseTest {};
+
+TEST_F(CancellationTokenTest, CancelKeepsFirstReason) {
+  auto token = CancellationToken{};
+  EXPECT_FALSE(token.is_cancelled());
+  EXPECT_FALSE(token.reason());
+
+  token.cancel(CancellationReason::User);
+  token.cancel(CancellationReason::ClientDisconnect);
+  EXPECT_TRUE(token.is_cancelled());
+  EXPECT_EQ(token.reason(), CancellationReason::User);
+}
+
+TEST_F(CancellationTokenTest, Deadline) {
+  const auto passed_token = CancellationToken{std::chrono::steady_clock::now() - std::chrono::milliseconds{1}};
+  EXPECT_TRUE(passed_token.is_cancelled());
+  EXPECT_EQ(passed_token.reason(), CancellationReason::Timeout);
+
+  const auto future_token = CancellationToken{std::chrono::steady_clock::now() + std::chrono::hours{1}};
+  EXPECT_FALSE(future_token.is_cancelled());
+}
+
+TEST_F(CancellationTokenTest, CreateFromSettings) {
+  EXPECT_FALSE(CancellationToken::create_from_settings()->deadline());
+
+  Hyrise::get().settings_manager.get_setting(CancellationToken::STATEMENT_TIMEOUT_SETTING_NAME)->set("60000");
+
+  const auto token = CancellationToken::create_from_settings();
+  ASSERT_TRUE(token->deadline());
+  EXPECT_GT(*token->deadline(), std::chrono::steady_clock::now());
+  EXPECT_FALSE(token->is_cancelled());
+}
+
+TEST_F(CancellationTokenTest, NestedScopes) {
+  EXPECT_EQ(CancellationTokenScope::current(), nullptr);
+  EXPECT_FALSE(CancellationTokenScope::is_cancelled());
+
+  const auto outer_token = std::make_shared<CancellationToken>();
+  const auto inner_token = std::make_shared<CancellationToken>();
+  inner_token->cancel(CancellationReason::User);
+
+  {
+    const auto outer_scope = CancellationTokenScope{outer_token};
+    EXPECT_EQ(CancellationTokenScope::current(), outer_token);
+    EXPECT_FALSE(CancellationTokenScope::is_cancelled());
+
+    {
+      const auto inner_scope = CancellationTokenScope{inner_token};
+      EXPECT_EQ(CancellationTokenScope::current(), inner_token);
+      EXPECT_TRUE(CancellationTokenScope::is_cancelled());
+    }
+
+    EXPECT_EQ(CancellationTokenScope::current(), outer_token);
+  }
+
+  EXPECT_EQ(CancellationTokenScope::current(), nullptr);
+}
+
+TEST_F(CancellationTokenTest, OperatorStopsAtChunkBoundary) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int.tbl", 1));
+  table_wrapper->execute();
+
+  const auto token = std::make_shared<CancellationToken>();
+  token->cancel(CancellationReason::User);
+  const auto scope = CancellationTokenScope{token};
+
+  const auto product = std::make_shared<Product>(table_wrapper, table_wrapper);
+  product->execute();
+  EXPECT_EQ(product->get_output()->row_count(), 0u);
+}
+
+TEST_F(CancellationTokenTest, JobTasksSkipWork) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int.tbl", 1));
+  table_wrapper->execute();
+  const auto table = table_wrapper->get_output();
+
+  const auto token = std::make_shared<CancellationToken>();
+  token->cancel(CancellationReason::User);
+  const auto scope = CancellationTokenScope{token};
+
+  // Both operators return well-formed, but empty results
+  const auto join_hash =
+      std::make_shared<JoinHash>(table_wrapper, table_wrapper, JoinMode::Inner,
+                                 OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+  join_hash->execute();
+  EXPECT_EQ(join_hash->get_output()->row_count(), 0u);
+  EXPECT_EQ(join_hash->get_output()->column_count(), 4u);
+
+  const auto aggregate_hash = std::make_shared<AggregateHash>(
+      table_wrapper,
+      std::vector<std::shared_ptr<AggregateExpression>>{
+          sum_(pqp_column_(ColumnID{1}, table->column_data_type(ColumnID{1}), table->column_is_nullable(ColumnID{1}),
+                           table->column_name(ColumnID{1})))},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate_hash->execute();
+  EXPECT_EQ(aggregate_hash->get_output()->row_count(), 0u);
+  EXPECT_EQ(aggregate_hash->get_output()->column_count(), 2u);
+}
+
+}  // namespace opossum
@@ -44,4 +44,23 @@ TEST_F(CommitContextTest, TrySetNextFailsIfNotNullptr) {
   EXPECT_FALSE(context->try_set_next(next_context));
 }
 
+TEST_F(CommitContextTest, PendingOnceAllTransactionsArePending) {
+  auto context = std::make_unique<CommitContext>(0u);
+  context->add_transaction();
+  context->add_transaction();
+  EXPECT_EQ(context->transaction_count(), 2u);
+
+  auto committed_transaction_ids = std::vector<TransactionID>{};
+  const auto callback = [&](TransactionID transaction_id) { committed_transaction_ids.emplace_back(transaction_id); };
+
+  context->make_pending(TransactionID{1}, callback);
+  EXPECT_FALSE(context->is_pending());
+
+  context->make_pending(TransactionID{2}, callback);
+  EXPECT_TRUE(context->is_pending());
+
+  context->fire_callbacks();
+  EXPECT_EQ(committed_transaction_ids, std::vector<TransactionID>({TransactionID{1}, TransactionID{2}}));
+}
+
 }  // namespace opossum
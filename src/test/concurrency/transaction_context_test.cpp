@@ -97,6 +97,38 @@ TEST_F(TransactionContextTest, CommitShouldCommitAllFollowingPendingTransactions
   EXPECT_EQ(context_2->commit_id(), manager().last_commit_id());
 }
 
+TEST_F(TransactionContextTest, TransactionsWaitingForTheSameCommitShareCommitID) {
+  const auto empty_callback = [](TransactionID) {};
+
+  auto context_1 = manager().new_transaction_context(AutoCommit::No);
+  auto context_2 = manager().new_transaction_context(AutoCommit::No);
+  auto context_3 = manager().new_transaction_context(AutoCommit::No);
+
+  const auto prev_last_commit_id = manager().last_commit_id();
+
+  // While context_1 commits its records, context_2 and context_3 are ready to commit and form a group
+  auto commit_contexts_2_and_3 = [&]() {
+    context_2->commit_async(empty_callback);
+    context_3->commit_async(empty_callback);
+
+    EXPECT_EQ(context_2->commit_id(), context_3->commit_id());
+    EXPECT_EQ(prev_last_commit_id, manager().last_commit_id());
+    EXPECT_EQ(context_3->phase(), TransactionPhase::Committing);
+  };
+
+  auto commit_op = std::make_shared<CommitFuncOp>(commit_contexts_2_and_3);
+  commit_op->set_transaction_context(context_1);
+  commit_op->execute();
+
+  context_1->commit_async(empty_callback);
+
+  EXPECT_EQ(context_1->commit_id(), prev_last_commit_id + 1);
+  EXPECT_EQ(context_2->commit_id(), prev_last_commit_id + 2);
+  EXPECT_EQ(manager().last_commit_id(), prev_last_commit_id + 2);
+  EXPECT_EQ(context_2->phase(), TransactionPhase::Committed);
+  EXPECT_EQ(context_3->phase(), TransactionPhase::Committed);
+}
+
 TEST_F(TransactionContextTest, CommitShouldIncreaseCommitIDIfReadWrite) {
   auto context = manager().new_transaction_context(AutoCommit::No);
 
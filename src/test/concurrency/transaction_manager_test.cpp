@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <thread>
 #include <vector>
 
 #include "base_test.hpp"
@@ -12,76 +13,188 @@ class TransactionManagerTest : public BaseTest {
  protected:
   void SetUp() override {}
 
-  static std::unordered_multiset<CommitID>& get_active_snapshot_commit_ids() {
-    return Hyrise::get().transaction_manager._active_snapshot_commit_ids;
+  static std::vector<CommitID> get_active_snapshot_commit_ids() {
+    const auto& manager = Hyrise::get().transaction_manager;
+
+    auto active_snapshot_commit_ids = std::vector<CommitID>{};
+    for (const auto& slot : manager._snapshot_slots) {
+      const auto snapshot_commit_id = slot.snapshot_commit_id.load();
+      if (snapshot_commit_id != TransactionManager::FREE_SNAPSHOT_SLOT) {
+        active_snapshot_commit_ids.emplace_back(snapshot_commit_id);
+      }
+    }
+    active_snapshot_commit_ids.insert(active_snapshot_commit_ids.end(), manager._overflow_snapshot_commit_ids.cbegin(),
+                                      manager._overflow_snapshot_commit_ids.cend());
+    return active_snapshot_commit_ids;
   }
 
-  static void register_transaction(CommitID snapshot_commit_id) {
-    Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
+  static bool is_active(CommitID snapshot_commit_id) {
+    const auto active_snapshot_commit_ids = get_active_snapshot_commit_ids();
+    return std::find(active_snapshot_commit_ids.cbegin(), active_snapshot_commit_ids.cend(), snapshot_commit_id) !=
+           active_snapshot_commit_ids.cend();
   }
-  static void deregister_transaction(CommitID snapshot_commit_id) {
-    Hyrise::get().transaction_manager._deregister_transaction(snapshot_commit_id);
+
+  static size_t register_transaction(CommitID snapshot_commit_id) {
+    return Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
+  }
+  static void deregister_transaction(CommitID snapshot_commit_id, size_t snapshot_slot) {
+    Hyrise::get().transaction_manager._deregister_transaction(snapshot_commit_id, snapshot_slot);
   }
+
+  static constexpr auto SNAPSHOT_SLOT_COUNT = TransactionManager::SNAPSHOT_SLOT_COUNT;
+  static constexpr auto OVERFLOW_SNAPSHOT_SLOT = TransactionManager::OVERFLOW_SNAPSHOT_SLOT;
 };
 
 /** Check if all active snapshot commit ids of uncommitted
  * transaction contexts are tracked correctly.
- * Normally, deregister_transaction() is called in the
- * destructor of the transaction context but is called
- * manually for this test.
+ * The transactions are deregistered when their contexts
+ * are destroyed.
  */
 TEST_F(TransactionManagerTest, TrackActiveCommitIDs) {
   auto& manager = Hyrise::get().transaction_manager;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0);
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0u);
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
 
-  const auto t1_context = manager.new_transaction_context(AutoCommit::No);
-  const auto t2_context = manager.new_transaction_context(AutoCommit::No);
-  const auto t3_context = manager.new_transaction_context(AutoCommit::No);
+  auto t1_context = manager.new_transaction_context(AutoCommit::No);
+  auto t2_context = manager.new_transaction_context(AutoCommit::No);
+  auto t3_context = manager.new_transaction_context(AutoCommit::No);
 
-  const CommitID t1_snapshot_commit_id = t1_context->snapshot_commit_id();
-  const CommitID t2_snapshot_commit_id = t2_context->snapshot_commit_id();
-  const CommitID t3_snapshot_commit_id = t3_context->snapshot_commit_id();
+  const auto t1_snapshot_commit_id = t1_context->snapshot_commit_id();
+  const auto t2_snapshot_commit_id = t2_context->snapshot_commit_id();
+  const auto t3_snapshot_commit_id = t3_context->snapshot_commit_id();
   const auto vec = std::vector<CommitID>{t1_snapshot_commit_id, t2_snapshot_commit_id, t3_snapshot_commit_id};
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 3);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 3u);
+  EXPECT_TRUE(is_active(t1_snapshot_commit_id));
+  EXPECT_TRUE(is_active(t2_snapshot_commit_id));
+  EXPECT_TRUE(is_active(t3_snapshot_commit_id));
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), *std::min_element(vec.cbegin(), vec.cend()));
 
   t1_context->commit();
-  deregister_transaction(t1_context->snapshot_commit_id());
+  t1_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 2);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 2u);
+  EXPECT_TRUE(is_active(t3_snapshot_commit_id));
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
 
   t3_context->commit();
-  deregister_transaction(t3_context->snapshot_commit_id());
+  t3_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1u);
+  EXPECT_TRUE(is_active(t2_snapshot_commit_id));
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
 
   t2_context->commit();
-  deregister_transaction(t2_context->snapshot_commit_id());
+  t2_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0);
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0u);
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+}
+
+TEST_F(TransactionManagerTest, ReadOnlyTransactions) {
+  auto& manager = Hyrise::get().transaction_manager;
+
+  const auto read_write_context = manager.new_transaction_context(AutoCommit::No);
+  auto read_only_context = manager.new_transaction_context(AutoCommit::No, TransactionMode::ReadOnly);
+
+  // Read-only transactions do not draw a transaction id, but their snapshots are tracked
+  EXPECT_FALSE(read_write_context->is_read_only());
+  EXPECT_TRUE(read_only_context->is_read_only());
+  EXPECT_EQ(read_only_context->transaction_id(), INVALID_TRANSACTION_ID);
+  EXPECT_EQ(manager.new_transaction_context(AutoCommit::No)->transaction_id(),
+            read_write_context->transaction_id() + 1);
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 2u);
+
+  read_only_context->commit();
+  EXPECT_EQ(read_only_context->phase(), TransactionPhase::Committed);
+  read_only_context = nullptr;
+
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1u);
+  read_write_context->commit();
+}
+
+TEST_F(TransactionManagerTest, RegisterMoreTransactionsThanSlots) {
+  auto& manager = Hyrise::get().transaction_manager;
+
+  // Once all slots are taken, snapshot commit ids are registered in the overflow set
+  auto snapshot_slots = std::vector<size_t>{};
+  for (auto snapshot_commit_id = CommitID{10}; snapshot_commit_id < SNAPSHOT_SLOT_COUNT + 12; ++snapshot_commit_id) {
+    snapshot_slots.emplace_back(register_transaction(snapshot_commit_id));
+  }
+
+  EXPECT_EQ(std::count(snapshot_slots.cbegin(), snapshot_slots.cend(), OVERFLOW_SNAPSHOT_SLOT), 2);
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), SNAPSHOT_SLOT_COUNT + 2);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), CommitID{10});
+
+  // Deregister all slots but the last one, which is an overflow slot
+  for (auto index = size_t{0}; index < snapshot_slots.size() - 1; ++index) {
+    deregister_transaction(static_cast<CommitID>(index + 10), snapshot_slots[index]);
+  }
+
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), CommitID{SNAPSHOT_SLOT_COUNT + 11});
+  deregister_transaction(CommitID{SNAPSHOT_SLOT_COUNT + 11}, snapshot_slots.back());
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+
+  // Slots can be reused
+  const auto snapshot_slot = register_transaction(CommitID{3});
+  EXPECT_NE(snapshot_slot, OVERFLOW_SNAPSHOT_SLOT);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), CommitID{3});
+  deregister_transaction(CommitID{3}, snapshot_slot);
+}
+
+TEST_F(TransactionManagerTest, ConcurrentTransactions) {
+  auto& manager = Hyrise::get().transaction_manager;
+
+  // A long-running transaction keeps the lowest snapshot commit id stable while other threads register newer snapshots
+  auto blocker_context = manager.new_transaction_context(AutoCommit::No);
+  const auto blocker_snapshot_commit_id = blocker_context->snapshot_commit_id();
+
+  constexpr auto THREAD_COUNT = 8u;
+  constexpr auto TRANSACTIONS_PER_THREAD = 200u;
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0u; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([&]() {
+      for (auto transaction_idx = 0u; transaction_idx < TRANSACTIONS_PER_THREAD; ++transaction_idx) {
+        const auto snapshot_commit_id = CommitID{blocker_snapshot_commit_id + 1 + transaction_idx};
+        const auto snapshot_slot = register_transaction(snapshot_commit_id);
+        deregister_transaction(snapshot_commit_id, snapshot_slot);
+      }
+    });
+  }
+
+  for (auto iteration = 0u; iteration < 100u; ++iteration) {
+    EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), blocker_snapshot_commit_id);
+  }
+
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1u);
+
+  blocker_context->commit();
+  blocker_context = nullptr;
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+}
+
+TEST_F(TransactionManagerTest, TransactionStatistics) {
+  auto& manager = Hyrise::get().transaction_manager;
 
-  // To prevent exceptions in TransactionContext destructor
-  register_transaction(t1_snapshot_commit_id);
-  register_transaction(t2_snapshot_commit_id);
-  register_transaction(t3_snapshot_commit_id);
+  manager.new_transaction_context(AutoCommit::No)->commit();
+  manager.new_transaction_context(AutoCommit::No)->commit();
+  manager.new_transaction_context(AutoCommit::No)->rollback(RollbackReason::User);
+  manager.new_transaction_context(AutoCommit::No)->rollback(RollbackReason::Conflict);
+  manager.register_lock_wait(false);
+
+  // Transactions that are still active are not counted
+  const auto active_context = manager.new_transaction_context(AutoCommit::No);
+
+  const auto statistics = manager.statistics();
+  EXPECT_EQ(statistics.committed_count, 2u);
+  EXPECT_EQ(statistics.rolled_back_by_user_count, 1u);
+  EXPECT_EQ(statistics.rolled_back_after_conflict_count, 1u);
+  EXPECT_EQ(statistics.lock_wait_count, 1u);
+  EXPECT_EQ(statistics.failed_lock_wait_count, 1u);
 }
 
 }  // namespace opossum
@@ -0,0 +1,129 @@
+#include "base_test.hpp"
+
+#include "cost_estimation/cost_estimator_physical.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "storage/chunk_encoder.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class CostEstimatorPhysicalTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Three chunks with a single row each
+    _table_a = load_table("resources/test_data/tbl/int_float.tbl", 1);
+    ChunkEncoder::encode_chunks(_table_a, {ChunkID{0}}, SegmentEncodingSpec{EncodingType::Dictionary});
+    ChunkEncoder::encode_chunks(_table_a, {ChunkID{1}}, SegmentEncodingSpec{EncodingType::RunLength});
+    Hyrise::get().storage_manager.add_table("table_a", _table_a);
+    Hyrise::get().storage_manager.add_table("table_b", load_table("resources/test_data/tbl/int_float2.tbl"));
+
+    _node_a = StoredTableNode::make("table_a");
+    _a_a = _node_a->get_column("a");
+    _node_b = StoredTableNode::make("table_b");
+    _b_a = _node_b->get_column("a");
+
+    // Only the first coefficient of each function is set, so that the costs are easy to compute by hand
+    auto coefficients = CostModelCoefficients{};
+    coefficients.table_scan = {{EncodingType::Unencoded, {1.0, 0.0}},
+                               {EncodingType::Dictionary, {10.0, 0.0}},
+                               {EncodingType::RunLength, {100.0, 0.0}}};
+    coefficients.table_scan_sorted = {1000.0, 0.0};
+    coefficients.index_scan = {7.0, 0.0};
+    coefficients.join_hash = {1.0, 0.0, 0.0};
+    _coefficients = std::make_shared<CostModelCoefficients>(coefficients);
+    _cost_estimator = std::make_shared<CostEstimatorPhysical>(std::make_shared<CardinalityEstimator>(), _coefficients);
+  }
+
+  std::shared_ptr<Table> _table_a;
+  std::shared_ptr<StoredTableNode> _node_a, _node_b;
+  LQPColumnReference _a_a, _b_a;
+  std::shared_ptr<CostModelCoefficients> _coefficients;
+  std::shared_ptr<CostEstimatorPhysical> _cost_estimator;
+};
+
+TEST_F(CostEstimatorPhysicalTest, CoefficientsJson) {
+  const auto json = _coefficients->to_json();
+  const auto loaded_coefficients = CostModelCoefficients::from_json(json);
+  EXPECT_EQ(loaded_coefficients.table_scan, _coefficients->table_scan);
+  EXPECT_EQ(loaded_coefficients.join_hash, _coefficients->join_hash);
+  EXPECT_EQ(loaded_coefficients.sort, _coefficients->sort);
+
+  // Missing cost functions keep their defaults
+  const auto partial_coefficients = CostModelCoefficients::from_json({{"join_hash", {1.0, 2.0, 3.0}}});
+  EXPECT_EQ(partial_coefficients.join_hash, CostFunctionCoefficients({1.0, 2.0, 3.0}));
+  EXPECT_EQ(partial_coefficients.join_sort_merge, CostModelCoefficients{}.join_sort_merge);
+
+  EXPECT_THROW(CostModelCoefficients::from_json({{"join_hash", {1.0}}}), std::logic_error);
+}
+
+TEST_F(CostEstimatorPhysicalTest, TableScanByEncodingAndSortedness) {
+  // One row is scanned per encoding: 1 * 1 (Unencoded) + 1 * 10 (Dictionary) + 1 * 100 (RunLength)
+  const auto predicate_node = PredicateNode::make(greater_than_(_a_a, 0), _node_a);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_table_scan_cost(predicate_node), 111.0f);
+
+  // A TableScan on the stored table searches the sorted RunLength chunk instead of scanning it
+  _table_a->get_chunk(ChunkID{1})->set_ordered_by({ColumnID{0}, OrderByMode::Ascending});
+  const auto sorted_predicate_node = PredicateNode::make(greater_than_(_a_a, 0), _node_a);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_table_scan_cost(sorted_predicate_node), 1011.0f);
+
+  // Scans on references do not exploit the sort order
+  const auto validated_predicate_node = PredicateNode::make(greater_than_(_a_a, 0), ValidateNode::make(_node_a));
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_table_scan_cost(validated_predicate_node), 111.0f);
+}
+
+TEST_F(CostEstimatorPhysicalTest, IndexScan) {
+  const auto predicate_node = PredicateNode::make(equals_(_a_a, 123), _node_a);
+  predicate_node->scan_type = ScanType::IndexScan;
+
+  // Without any index, the IndexScan falls back to scanning the table
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_index_scan_cost(predicate_node), 111.0f);
+
+  // A table hash index on the scanned column is looked up once
+  _table_a->create_table_hash_index({ColumnID{0}});
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_index_scan_cost(predicate_node), 7.0f);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_node_cost(predicate_node), 7.0f);
+}
+
+TEST_F(CostEstimatorPhysicalTest, JoinHashBuildSide) {
+  // table_a has three rows, table_b has four. The cost of JoinHash only depends on the build side here.
+  const auto inner_join_node = JoinNode::make(JoinMode::Inner, equals_(_a_a, _b_a), _node_a, _node_b);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_join_cost(inner_join_node, OperatorType::JoinHash), 3.0f);
+
+  const auto left_join_node = JoinNode::make(JoinMode::Left, equals_(_a_a, _b_a), _node_a, _node_b);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_join_cost(left_join_node, OperatorType::JoinHash), 4.0f);
+
+  const auto right_join_node = JoinNode::make(JoinMode::Right, equals_(_a_a, _b_a), _node_a, _node_b);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_join_cost(right_join_node, OperatorType::JoinHash), 3.0f);
+}
+
+TEST_F(CostEstimatorPhysicalTest, NodeCostIsCheapestImplementation) {
+  const auto equi_join_node = JoinNode::make(JoinMode::Inner, equals_(_a_a, _b_a), _node_a, _node_b);
+  EXPECT_EQ(CostEstimatorPhysical::supported_join_types(*equi_join_node),
+            std::vector<OperatorType>({OperatorType::JoinHash, OperatorType::JoinSortMerge,
+                                       OperatorType::JoinNestedLoop}));
+
+  const auto join_cost = _cost_estimator->estimate_node_cost(equi_join_node);
+  EXPECT_LE(join_cost, _cost_estimator->estimate_join_cost(equi_join_node, OperatorType::JoinHash));
+  EXPECT_LE(join_cost, _cost_estimator->estimate_join_cost(equi_join_node, OperatorType::JoinSortMerge));
+  EXPECT_LE(join_cost, _cost_estimator->estimate_join_cost(equi_join_node, OperatorType::JoinNestedLoop));
+
+  // JoinHash does not support non-equi joins
+  const auto non_equi_join_node = JoinNode::make(JoinMode::Inner, less_than_(_a_a, _b_a), _node_a, _node_b);
+  const auto non_equi_join_types = CostEstimatorPhysical::supported_join_types(*non_equi_join_node);
+  EXPECT_EQ(std::count(non_equi_join_types.begin(), non_equi_join_types.end(), OperatorType::JoinHash), 0);
+
+  const auto aggregate_node = AggregateNode::make(expression_vector(_a_a), expression_vector(), _node_a);
+  EXPECT_FLOAT_EQ(_cost_estimator->estimate_node_cost(aggregate_node),
+                  std::min(_cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateOperatorType::Hash),
+                           _cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateOperatorType::Sort)));
+}
+
+}  // namespace opossum
@@ -5,6 +5,7 @@
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -52,6 +53,42 @@ TEST_F(CsvParserTest, StringEscaping) {
   EXPECT_TABLE_EQ_ORDERED(table, expected_table);
 }
 
+TEST_F(CsvParserTest, SmallBuffer) {
+  // Rows and quoted fields span multiple blocks, and the buffer has to be enlarged to hold a chunk of rows
+  Hyrise::get().settings_manager.get_setting(CsvParser::BUFFER_SIZE_SETTING_NAME)->set("4");
+  auto table = CsvParser::parse("resources/test_data/csv/string_escaped.csv", ChunkOffset{2});
+
+  auto expected_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::String, false}}, TableType::Data, 2);
+  expected_table->append({"aa\"\"aa"});
+  expected_table->append({"xx\"x"});
+  expected_table->append({"yy,y"});
+  expected_table->append({"zz\nz"});
+
+  EXPECT_EQ(table->chunk_count(), 2u);
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, EncodeChunks) {
+  Hyrise::get().settings_manager.get_setting(CsvParser::BUFFER_SIZE_SETTING_NAME)->set("100");
+  auto table = CsvParser::parse("resources/test_data/csv/float_int_large.csv", ChunkOffset{20}, std::nullopt,
+                                SegmentEncodingSpec{EncodingType::Dictionary});
+
+  TableColumnDefinitions column_definitions{{"b", DataType::Float, false}, {"a", DataType::Int, false}};
+  auto expected_table = std::make_shared<Table>(column_definitions, TableType::Data, 20);
+  for (int i = 0; i < 100; ++i) {
+    expected_table->append({458.7f, 12345});
+  }
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+}
+
 TEST_F(CsvParserTest, NoRows) {
   auto table = CsvParser::parse("resources/test_data/csv/float_int_empty.csv");
   std::shared_ptr<Table> expected_table = load_table("resources/test_data/tbl/float_int_empty.tbl", 2);
@@ -289,4 +326,55 @@ TEST_F(CsvParserTest, WithScheduler) {
   Hyrise::get().set_scheduler(scheduler);
 }
 
+TEST_F(CsvParserTest, ParseIntoTable) {
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, true}}, TableType::Data, 2);
+
+  auto csv_meta = CsvMeta{};
+  const auto content = std::string{"1,\"x\ny\"\n2,\n3,z\n"};
+  EXPECT_EQ(CsvParser::parse_into_table(content, *table, csv_meta), 3u);
+  EXPECT_EQ(CsvParser::parse_into_table("4,w\n", *table, csv_meta), 1u);
+
+  const auto expected_table = std::make_shared<Table>(table->column_definitions(), TableType::Data, 2);
+  expected_table->append({1, "x\ny"});
+  expected_table->append({2, NULL_VALUE});
+  expected_table->append({3, "z"});
+  expected_table->append({4, "w"});
+
+  EXPECT_EQ(table->chunk_count(), 3u);
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, PostgresTextFormat) {
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String, true}}, TableType::Data);
+
+  auto csv_meta = CsvMeta{};
+  csv_meta.config.separator = '\t';
+  csv_meta.config.postgres_text_format = true;
+  CsvParser::parse_into_table("1\ta\\tb\\\\c\n\\N\t\"quoted\"\n3\t\n4\t\\N\n", *table, csv_meta);
+
+  const auto expected_table = std::make_shared<Table>(table->column_definitions(), TableType::Data);
+  expected_table->append({1, "a\tb\\c"});
+  expected_table->append({NULL_VALUE, "\"quoted\""});
+  expected_table->append({3, ""});
+  expected_table->append({4, NULL_VALUE});
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, CompleteRowsLength) {
+  const auto config = ParseConfig{};
+  EXPECT_EQ(CsvParser::complete_rows_length("", config), 0u);
+  EXPECT_EQ(CsvParser::complete_rows_length("1,a", config), 0u);
+  EXPECT_EQ(CsvParser::complete_rows_length("1,a\n2,b", config), 4u);
+  // Row delimiters in quoted fields do not end a row
+  EXPECT_EQ(CsvParser::complete_rows_length("1,a\n2,\"b\nc", config), 4u);
+  EXPECT_EQ(CsvParser::complete_rows_length("1,a\n2,\"b\nc\"\"\"\n3", config), 14u);
+
+  auto text_config = ParseConfig{};
+  text_config.postgres_text_format = true;
+  EXPECT_EQ(CsvParser::complete_rows_length("1\t\"a\n2\tb", text_config), 5u);
+}
+
 }  // namespace opossum
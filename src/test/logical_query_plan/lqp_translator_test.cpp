@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "base_test.hpp"
+#include "cost_estimation/cost_model_coefficients.hpp"
 #include "expression/aggregate_expression.hpp"
 #include "expression/arithmetic_expression.hpp"
 #include "expression/expression_functional.hpp"
@@ -33,9 +34,11 @@
 #include "logical_query_plan/union_node.hpp"
 #include "logical_query_plan/validate_node.hpp"
 #include "operators/aggregate_hash.hpp"
+#include "operators/aggregate_sort.hpp"
 #include "operators/change_meta_table.hpp"
 #include "operators/export.hpp"
 #include "operators/get_table.hpp"
+#include "operators/group_join.hpp"
 #include "operators/import.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/join_hash.hpp"
@@ -182,6 +185,89 @@ TEST_F(LQPTranslatorTest, PredicateNodeSimpleBinary) {
   EXPECT_EQ(get_table_op->table_name(), "table_int_float");
 }
 
+TEST_F(LQPTranslatorTest, PredicateNodeRuntimePruning) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * LQP resembles the inner plan of a correlated subquery:
+   *   SELECT * FROM int_float WHERE a > <outer value> AND b < 500.0;
+   */
+  const auto parameter = correlated_parameter_(ParameterID{0}, int_float_a);
+
+  // clang-format off
+  const auto lqp =
+  PredicateNode::make(greater_than_(int_float_a, parameter),
+    PredicateNode::make(less_than_(int_float_b, 500.0f),
+      int_float_node));
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP
+   */
+  const auto table_scan_op = std::dynamic_pointer_cast<TableScan>(pqp);
+  ASSERT_TRUE(table_scan_op);
+  const auto get_table_op = std::dynamic_pointer_cast<const GetTable>(pqp->input_left()->input_left());
+  ASSERT_TRUE(get_table_op);
+
+  // Only the predicate whose value is not known before the execution is forwarded to the GetTable
+  ASSERT_EQ(get_table_op->runtime_pruning_predicates().size(), 1u);
+  EXPECT_EQ(*get_table_op->runtime_pruning_predicates().front(), *table_scan_op->predicate());
+  EXPECT_NE(get_table_op->runtime_pruning_predicates().front(), table_scan_op->predicate());
+}
+
+TEST_F(LQPTranslatorTest, PredicateNodeNoRuntimePruningForSharedInput) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * The StoredTableNode is consumed twice, so its GetTable must not drop chunks for one of the consumers
+   */
+  const auto parameter = correlated_parameter_(ParameterID{0}, int_float_a);
+
+  // clang-format off
+  const auto lqp =
+  UnionNode::make(SetOperationMode::Positions,
+    PredicateNode::make(greater_than_(int_float_a, parameter),
+      int_float_node),
+    PredicateNode::make(less_than_(int_float_b, parameter),
+      int_float_node));
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  const auto get_table_op = std::dynamic_pointer_cast<const GetTable>(pqp->input_left()->input_left());
+  ASSERT_TRUE(get_table_op);
+  EXPECT_TRUE(get_table_op->runtime_pruning_predicates().empty());
+}
+
+TEST_F(LQPTranslatorTest, PredicateNodeRuntimePruningSelfJoin) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * The StoredTableNodes of a self-join are equal and thus translated into a shared GetTable. The runtime pruning
+   * predicate of one side must not prune the chunks of the other side.
+   */
+  const auto other_int_float_node = StoredTableNode::make("table_int_float");
+  const auto other_int_float_a = other_int_float_node->get_column("a");
+
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_a, other_int_float_a),
+    PredicateNode::make(greater_than_(int_float_b, placeholder_(ParameterID{0})),
+      int_float_node),
+    other_int_float_node);
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  const auto pruned_get_table_op = std::dynamic_pointer_cast<const GetTable>(pqp->input_left()->input_left());
+  ASSERT_TRUE(pruned_get_table_op);
+  EXPECT_EQ(pruned_get_table_op->runtime_pruning_predicates().size(), 1u);
+
+  const auto other_get_table_op = std::dynamic_pointer_cast<const GetTable>(pqp->input_right());
+  ASSERT_TRUE(other_get_table_op);
+  EXPECT_NE(other_get_table_op, pruned_get_table_op);
+  EXPECT_TRUE(other_get_table_op->runtime_pruning_predicates().empty());
+}
+
 TEST_F(LQPTranslatorTest, PredicateNodeLike) {
   /**
    * Build LQP and translate to PQP
@@ -625,6 +711,38 @@ TEST_F(LQPTranslatorTest, JoinNodeToJoinNestedLoop) {
   EXPECT_EQ(join_op->mode(), JoinMode::Inner);
 }
 
+TEST_F(LQPTranslatorTest, CostBasedOperatorSelection) {
+  const auto join_node =
+      JoinNode::make(JoinMode::Inner, equals_(int_float2_b, int_float_b), int_float_node, int_float2_node);
+  const auto aggregate_node =
+      AggregateNode::make(expression_vector(int_float_a), expression_vector(sum_(int_float_b)), int_float_node);
+
+  const auto chunked_table_node = StoredTableNode::make("int_float_chunked");
+  const auto predicate_node =
+      PredicateNode::make(equals_(chunked_table_node->get_column("a"), 123), chunked_table_node);
+  predicate_node->scan_type = ScanType::IndexScan;
+  Hyrise::get().storage_manager.get_table("int_float_chunked")->create_table_hash_index({ColumnID{0}});
+
+  // Without cost model coefficients, the fixed preference order is used
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node)));
+  EXPECT_TRUE(std::dynamic_pointer_cast<AggregateHash>(LQPTranslator{}.translate_node(aggregate_node)));
+  EXPECT_TRUE(std::dynamic_pointer_cast<IndexScan>(LQPTranslator{}.translate_node(predicate_node)));
+
+  // With coefficients that make the default operators expensive, the alternatives are chosen
+  const auto coefficients = std::make_shared<CostModelCoefficients>();
+  coefficients->join_hash = {1e6, 1e6, 1e6};
+  coefficients->join_nested_loop = {1e6, 1e6};
+  coefficients->aggregate_hash = {1e6, 1e6};
+  coefficients->index_scan = {1e6, 1e6};
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinSortMerge>(LQPTranslator{coefficients}.translate_node(join_node)));
+  EXPECT_TRUE(std::dynamic_pointer_cast<AggregateSort>(LQPTranslator{coefficients}.translate_node(aggregate_node)));
+  EXPECT_TRUE(std::dynamic_pointer_cast<TableScan>(LQPTranslator{coefficients}.translate_node(predicate_node)));
+
+  // By default, the translator uses the coefficients set in the Hyrise singleton
+  Hyrise::get().cost_model_coefficients = coefficients;
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinSortMerge>(LQPTranslator{}.translate_node(join_node)));
+}
+
 TEST_F(LQPTranslatorTest, AggregateNodeSimple) {
   /**
    * Build LQP and translate to PQP
@@ -653,6 +771,28 @@ TEST_F(LQPTranslatorTest, AggregateNodeSimple) {
   EXPECT_EQ(*count, *count_(pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*")));
 }
 
+TEST_F(LQPTranslatorTest, AggregateNodeGroupJoin) {
+  // clang-format off
+  const auto aggregate_node =
+  AggregateNode::make(expression_vector(int_float_a), expression_vector(sum_(int_float2_b)),
+    JoinNode::make(JoinMode::Inner, equals_(int_float2_a, int_float_a),
+      int_float_node,
+      int_float2_node));
+  // clang-format on
+  aggregate_node->is_group_join = true;
+
+  const auto group_join = std::dynamic_pointer_cast<GroupJoin>(LQPTranslator{}.translate_node(aggregate_node));
+  ASSERT_TRUE(group_join);
+  EXPECT_EQ(group_join->input_left()->type(), OperatorType::GetTable);
+  EXPECT_EQ(group_join->input_right()->type(), OperatorType::GetTable);
+  EXPECT_EQ(group_join->join_predicate().column_ids, ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(group_join->groupby_column_ids(), std::vector<ColumnID>{ColumnID{0}});
+
+  // Aggregate arguments refer to the join result
+  ASSERT_EQ(group_join->aggregates().size(), 1u);
+  EXPECT_EQ(*group_join->aggregates()[0], *sum_(pqp_column_(ColumnID{3}, DataType::Float, false, "b")));
+}
+
 TEST_F(LQPTranslatorTest, JoinAndPredicates) {
   /**
    * Build LQP and translate to PQP
@@ -0,0 +1,84 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "memory/query_memory_budget.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "utils/settings/integral_setting.hpp"
+
+namespace opossum {
+
+class QueryMemoryBudgetTest : public BaseTest {};
+
+TEST_F(QueryMemoryBudgetTest, ReserveAndRelease) {
+  auto budget = QueryMemoryBudget{100};
+
+  EXPECT_TRUE(budget.try_reserve(60));
+  EXPECT_FALSE(budget.try_reserve(50));
+  EXPECT_EQ(budget.available_bytes(), size_t{40});
+
+  // Unconditional reservations may exceed the budget
+  budget.reserve(50);
+  EXPECT_EQ(budget.reserved_bytes(), size_t{110});
+  EXPECT_EQ(budget.available_bytes(), size_t{0});
+  EXPECT_FALSE(budget.try_reserve(1));
+
+  budget.release(110);
+  EXPECT_EQ(budget.reserved_bytes(), size_t{0});
+  EXPECT_EQ(budget.peak_reserved_bytes(), size_t{110});
+  EXPECT_TRUE(budget.try_reserve(100));
+}
+
+TEST_F(QueryMemoryBudgetTest, ReservationReleasesBytes) {
+  const auto budget = std::make_shared<QueryMemoryBudget>(100);
+
+  {
+    auto reservation = MemoryBudgetReservation::try_reserve(budget, 80);
+    ASSERT_TRUE(reservation);
+    EXPECT_FALSE(MemoryBudgetReservation::try_reserve(budget, 80));
+
+    const auto moved_reservation = std::move(*reservation);
+    EXPECT_EQ(moved_reservation.bytes(), size_t{80});
+    EXPECT_EQ(budget->reserved_bytes(), size_t{80});
+  }
+
+  EXPECT_EQ(budget->reserved_bytes(), size_t{0});
+
+  // Without a budget, all reservations succeed
+  EXPECT_TRUE(MemoryBudgetReservation::try_reserve(nullptr, 1'000'000));
+}
+
+TEST_F(QueryMemoryBudgetTest, BudgetIsConfiguredThroughSetting) {
+  EXPECT_FALSE(QueryMemoryBudget::create_from_settings());
+
+  const auto setting = Hyrise::get().settings_manager.get_setting(QueryMemoryBudget::SETTING_NAME);
+  EXPECT_EQ(setting->get(), "0");
+  EXPECT_THROW(setting->set("1MB"), InvalidInputException);
+
+  setting->set("1000");
+  const auto budget = QueryMemoryBudget::create_from_settings();
+  ASSERT_TRUE(budget);
+  EXPECT_EQ(budget->limit(), size_t{1'000});
+  EXPECT_EQ(setting->get(), "1000");
+}
+
+TEST_F(QueryMemoryBudgetTest, QueriesSpillUnderTightBudget) {
+  Hyrise::get().storage_manager.add_table("customer", load_table("resources/test_data/tbl/tpch/sf-0.001/customer.tbl"));
+  Hyrise::get().storage_manager.add_table("orders", load_table("resources/test_data/tbl/tpch/sf-0.001/orders.tbl"));
+
+  const auto query = std::string{
+      "SELECT c_custkey, c_name, COUNT(*), SUM(o_totalprice) FROM customer LEFT JOIN orders ON c_custkey = o_custkey "
+      "GROUP BY c_custkey, c_name"};
+
+  const auto [expected_status, expected_result] = SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+  ASSERT_EQ(expected_status, SQLPipelineStatus::Success);
+
+  Hyrise::get().settings_manager.get_setting(QueryMemoryBudget::SETTING_NAME)->set("4096");
+  const auto [status, result] = SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+  ASSERT_EQ(status, SQLPipelineStatus::Success);
+
+  EXPECT_TABLE_EQ_UNORDERED(result, expected_result);
+}
+
+}  // namespace opossum
@@ -0,0 +1,133 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "memory/query_memory_resource.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class QueryMemoryResourceTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+    Hyrise::get().storage_manager.add_table("table_b", load_table("resources/test_data/tbl/int_float2.tbl", 2));
+  }
+
+  const std::string _join_query =
+      "SELECT table_a.a, table_a.b, table_b.b AS bb FROM table_a, table_b WHERE table_a.a = table_b.a ORDER BY bb";
+};
+
+TEST_F(QueryMemoryResourceTest, DefaultResourceIsScoped) {
+  auto memory_resource = QueryMemoryResource{};
+  const auto* const global_default_resource = boost::container::pmr::get_default_resource();
+
+  {
+    const auto scope = DefaultMemoryResourceScope{&memory_resource};
+    EXPECT_EQ(boost::container::pmr::get_default_resource(), &memory_resource);
+
+    auto vector = pmr_vector<int32_t>(1'000, 17);
+    EXPECT_EQ(vector.get_allocator().resource(), &memory_resource);
+    EXPECT_EQ(vector[999], 17);
+
+    {
+      // A nullptr restores the global default resource
+      const auto inner_scope = DefaultMemoryResourceScope{nullptr};
+      EXPECT_EQ(boost::container::pmr::get_default_resource(), global_default_resource);
+    }
+
+    EXPECT_EQ(boost::container::pmr::get_default_resource(), &memory_resource);
+  }
+
+  EXPECT_EQ(boost::container::pmr::get_default_resource(), global_default_resource);
+  EXPECT_EQ(memory_resource.sub_arena_count(), size_t{1});
+}
+
+TEST_F(QueryMemoryResourceTest, JobTasksInheritResource) {
+  Hyrise::get().topology.use_fake_numa_topology(4, 2);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  auto memory_resource = QueryMemoryResource{};
+  auto allocated_resources = std::vector<boost::container::pmr::memory_resource*>(8);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  {
+    const auto scope = DefaultMemoryResourceScope{&memory_resource};
+    for (auto job_id = size_t{0}; job_id < allocated_resources.size(); ++job_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, job_id]() {
+        auto vector = pmr_vector<int64_t>(128);
+        allocated_resources[job_id] = vector.get_allocator().resource();
+      }));
+    }
+  }
+
+  // Jobs created outside of the scope use the global default resource
+  auto unscoped_allocated_resource = static_cast<boost::container::pmr::memory_resource*>(nullptr);
+  jobs.emplace_back(std::make_shared<JobTask>([&]() {
+    auto vector = pmr_vector<int64_t>(128);
+    unscoped_allocated_resource = vector.get_allocator().resource();
+  }));
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  for (const auto* allocated_resource : allocated_resources) {
+    EXPECT_EQ(allocated_resource, &memory_resource);
+  }
+  EXPECT_NE(unscoped_allocated_resource, &memory_resource);
+  EXPECT_GE(memory_resource.sub_arena_count(), size_t{1});
+
+  Hyrise::get().scheduler()->finish();
+}
+
+TEST_F(QueryMemoryResourceTest, ResultTableOutlivesPipeline) {
+  const auto expected_result = SQLPipelineBuilder{_join_query}.create_pipeline().get_result_table().second;
+
+  auto result = std::shared_ptr<const Table>{};
+  auto weak_memory_resource = std::weak_ptr<QueryMemoryResource>{};
+  {
+    auto statement = SQLPipelineBuilder{_join_query}.with_query_arena(UseQueryArena::Yes).create_pipeline_statement();
+    const auto [status, table] = statement.get_result_table();
+    EXPECT_EQ(status, SQLPipelineStatus::Success);
+    ASSERT_TRUE(statement.query_memory_resource());
+
+    weak_memory_resource = statement.query_memory_resource();
+    result = table;
+  }
+
+  // The arena is kept alive by the result table and released together with it
+  EXPECT_FALSE(weak_memory_resource.expired());
+  EXPECT_TABLE_EQ_ORDERED(result, expected_result);
+
+  result = nullptr;
+  EXPECT_TRUE(weak_memory_resource.expired());
+}
+
+TEST_F(QueryMemoryResourceTest, NoArenaForModifyingStatements) {
+  auto statement = SQLPipelineBuilder{"INSERT INTO table_a (a, b) VALUES (1, 2.0)"}
+                       .with_query_arena(UseQueryArena::Yes)
+                       .create_pipeline_statement();
+  statement.get_result_table();
+
+  EXPECT_FALSE(statement.query_memory_resource());
+}
+
+TEST_F(QueryMemoryResourceTest, CachedPlanIsNotExecuted) {
+  const auto pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
+  {
+    auto statement = SQLPipelineBuilder{_join_query}
+                         .with_query_arena(UseQueryArena::Yes)
+                         .with_pqp_cache(pqp_cache)
+                         .create_pipeline_statement();
+    statement.get_result_table();
+  }
+
+  const auto cached_plan = pqp_cache->try_get(_join_query);
+  ASSERT_TRUE(cached_plan);
+  EXPECT_FALSE((*cached_plan)->get_output());
+}
+
+}  // namespace opossum
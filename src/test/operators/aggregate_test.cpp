@@ -10,6 +10,7 @@
 #include "base_test.hpp"
 
 #include "expression/aggregate_expression.hpp"
+#include "memory/query_memory_budget.hpp"
 #include "operators/abstract_read_only_operator.hpp"
 #include "operators/aggregate_hash.hpp"
 #include "operators/aggregate_sort.hpp"
@@ -152,6 +153,18 @@ class OperatorsAggregateTest : public BaseTest {
       aggregate->execute();
       EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected_result);
     }
+
+    if constexpr (std::is_same_v<T, AggregateHash>) {
+      // Perform the Aggregate with a memory budget that is too small for it, forcing it to spill. The input is wrapped
+      // again, so that the budget is not set on the shared input operator.
+      const auto input = std::make_shared<TableWrapper>(in->get_output());
+      input->execute();
+
+      const auto aggregate = std::make_shared<T>(input, aggregates, groupby_column_ids);
+      aggregate->set_memory_budget_recursively(std::make_shared<QueryMemoryBudget>(1));
+      aggregate->execute();
+      EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected_result);
+    }
   }
 
   inline static std::shared_ptr<TableWrapper> _table_wrapper_1_0, _table_wrapper_1_0_null, _table_wrapper_1_1,
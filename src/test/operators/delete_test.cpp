@@ -1,6 +1,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
 
@@ -84,6 +86,44 @@ TEST_F(OperatorsDeleteTest, ExecuteAndCommit) { helper(true); }
 
 TEST_F(OperatorsDeleteTest, ExecuteAndAbort) { helper(false); }
 
+TEST_F(OperatorsDeleteTest, ExecuteAndCommitOnCompactedMvccData) {
+  // Deleting rows expands the compacted MVCC data, to which the compacted one forwards
+  const auto chunk = _table->get_chunk(ChunkID{0});
+  ASSERT_TRUE(chunk->try_compact_mvcc_data(Hyrise::get().transaction_manager.last_commit_id()));
+  helper(true);
+  EXPECT_TRUE(chunk->mvcc_data()->is_compacted());
+  EXPECT_FALSE(chunk->mvcc_data()->is_compacted_and_entirely_valid());
+}
+
+TEST_F(OperatorsDeleteTest, ExecuteAndAbortOnCompactedMvccData) {
+  ASSERT_TRUE(_table->get_chunk(ChunkID{0})->try_compact_mvcc_data(Hyrise::get().transaction_manager.last_commit_id()));
+  helper(false);
+}
+
+TEST_F(OperatorsDeleteTest, FailDuringCompaction) {
+  // Locks would get lost when the chunk replaces its MVCC data by a compacted one
+  const auto mvcc_data = _table->get_chunk(ChunkID{0})->mvcc_data();
+  mvcc_data->is_compacting = true;
+
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  auto gt = std::make_shared<GetTable>(_table_name);
+  gt->execute();
+
+  auto table_scan = create_table_scan(gt, ColumnID{1}, PredicateCondition::GreaterThan, 456.7f);
+  table_scan->execute();
+
+  auto delete_op = std::make_shared<Delete>(table_scan);
+  delete_op->set_transaction_context(transaction_context);
+  delete_op->execute();
+  EXPECT_TRUE(delete_op->execute_failed());
+
+  transaction_context->rollback(RollbackReason::Conflict);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 3; ++chunk_offset) {
+    EXPECT_EQ(mvcc_data->get_tid(chunk_offset), 0u);
+  }
+}
+
 TEST_F(OperatorsDeleteTest, DetectDirtyWrite) {
   auto t1_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
   auto t2_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
@@ -370,4 +410,90 @@ TEST_F(OperatorsDeleteTest, PrunedInputTable) {
   EXPECT_EQ(_table2->get_chunk(ChunkID{2})->mvcc_data()->get_end_cid(1u), expected_end_cid);
 }
 
+TEST_F(OperatorsDeleteTest, LockRowsInRowIDOrder) {
+  // The rows are referenced in reverse order, but locked in the order of their RowIDs. Thus, the delete fails when
+  // reaching the second row, and only the first row needs to be unlocked again.
+  const auto pos_list = std::make_shared<RowIDPosList>(RowIDPosList{
+      RowID{ChunkID{0}, ChunkOffset{2}}, RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{0}, ChunkOffset{0}}});
+  const auto referencing_table = std::make_shared<Table>(_table->column_definitions(), TableType::References);
+  referencing_table->append_chunk(Segments{std::make_shared<ReferenceSegment>(_table, ColumnID{0}, pos_list),
+                                           std::make_shared<ReferenceSegment>(_table, ColumnID{1}, pos_list)});
+  const auto table_wrapper = std::make_shared<TableWrapper>(referencing_table);
+  table_wrapper->execute();
+
+  const auto mvcc_data = _table->get_chunk(ChunkID{0})->mvcc_data();
+  mvcc_data->set_tid(1u, TransactionID{17});
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto delete_op = std::make_shared<Delete>(table_wrapper);
+  delete_op->set_transaction_context(transaction_context);
+  delete_op->execute();
+  EXPECT_TRUE(delete_op->execute_failed());
+
+  transaction_context->rollback(RollbackReason::Conflict);
+
+  EXPECT_EQ(mvcc_data->get_tid(0u), 0u);
+  EXPECT_EQ(mvcc_data->get_tid(1u), 17u);
+  EXPECT_EQ(mvcc_data->get_tid(2u), 0u);
+}
+
+TEST_F(OperatorsDeleteTest, WaitForRolledBackLock) {
+  Hyrise::get().settings_manager.get_setting(TransactionManager::LOCK_WAIT_TIMEOUT_SETTING_NAME)->set("10000");
+
+  auto t1_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto t2_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  auto gt = std::make_shared<GetTable>(_table_name);
+  gt->execute();
+
+  auto delete_op1 = std::make_shared<Delete>(gt);
+  delete_op1->set_transaction_context(t1_context);
+  delete_op1->execute();
+  EXPECT_FALSE(delete_op1->execute_failed());
+
+  // The second delete waits until the first transaction releases its locks
+  auto rollback_thread = std::thread{[&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    t1_context->rollback(RollbackReason::User);
+  }};
+
+  auto delete_op2 = std::make_shared<Delete>(gt);
+  delete_op2->set_transaction_context(t2_context);
+  delete_op2->execute();
+  rollback_thread.join();
+
+  EXPECT_FALSE(delete_op2->execute_failed());
+  t2_context->commit();
+
+  const auto statistics = Hyrise::get().transaction_manager.statistics();
+  EXPECT_GE(statistics.lock_wait_count, 1u);
+  EXPECT_EQ(statistics.failed_lock_wait_count, 0u);
+}
+
+TEST_F(OperatorsDeleteTest, LockWaitTimesOut) {
+  Hyrise::get().settings_manager.get_setting(TransactionManager::LOCK_WAIT_TIMEOUT_SETTING_NAME)->set("10");
+
+  auto t1_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto t2_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  auto gt = std::make_shared<GetTable>(_table_name);
+  gt->execute();
+
+  auto delete_op1 = std::make_shared<Delete>(gt);
+  delete_op1->set_transaction_context(t1_context);
+  delete_op1->execute();
+
+  auto delete_op2 = std::make_shared<Delete>(gt);
+  delete_op2->set_transaction_context(t2_context);
+  delete_op2->execute();
+  EXPECT_TRUE(delete_op2->execute_failed());
+
+  t2_context->rollback(RollbackReason::Conflict);
+  t1_context->commit();
+
+  const auto statistics = Hyrise::get().transaction_manager.statistics();
+  EXPECT_EQ(statistics.lock_wait_count, 1u);
+  EXPECT_EQ(statistics.failed_lock_wait_count, 1u);
+}
+
 }  // namespace opossum
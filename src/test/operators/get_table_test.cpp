@@ -3,6 +3,7 @@
 #include "base_test.hpp"
 
 #include "concurrency/transaction_context.hpp"
+#include "expression/expression_functional.hpp"
 #include "hyrise.hpp"
 #include "operators/delete.hpp"
 #include "operators/get_table.hpp"
@@ -11,6 +12,8 @@
 #include "storage/index/group_key/group_key_index.hpp"
 #include "storage/table.hpp"
 
+using namespace opossum::expression_functional;  // NOLINT
+
 namespace opossum {
 
 class OperatorsGetTableTest : public BaseTest {
@@ -285,6 +288,68 @@ TEST_F(OperatorsGetTableTest, Copy) {
   EXPECT_EQ(get_table_b_copy->pruned_column_ids(), std::vector{ColumnID{0}});
 }
 
+TEST_F(OperatorsGetTableTest, RuntimePruningPredicates) {
+  // Column a holds 9, 10, 11, 9 in chunks of size one
+  const auto a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+  const auto parameter = correlated_parameter_(ParameterID{0}, a);
+
+  auto get_table = std::make_shared<GetTable>("int_int_float");
+  get_table->set_runtime_pruning_predicates({greater_than_(a, parameter), less_than_equals_(parameter, a)});
+  EXPECT_EQ(get_table->description(DescriptionMode::SingleLine),
+            "GetTable (int_int_float) pruned: 0/4 chunk(s), 0/3 column(s), 2 runtime pruning predicate(s)");
+
+  // Without a value for the parameter, nothing is pruned
+  const auto unparameterized_get_table = std::dynamic_pointer_cast<GetTable>(get_table->deep_copy());
+  unparameterized_get_table->execute();
+  EXPECT_EQ(unparameterized_get_table->runtime_pruned_chunk_count(), 0u);
+  EXPECT_EQ(unparameterized_get_table->get_output()->chunk_count(), 4u);
+
+  get_table->set_parameters({{ParameterID{0}, AllTypeVariant{10}}});
+  get_table->execute();
+  EXPECT_EQ(get_table->runtime_pruned_chunk_count(), 3u);
+  EXPECT_EQ(get_table->get_output()->chunk_count(), 1u);
+  EXPECT_EQ(get_table->get_output()->get_value<int32_t>(ColumnID{0}, 0u), 11);
+
+  // Copies are parameterized independently of the original
+  const auto copied_get_table = std::dynamic_pointer_cast<GetTable>(get_table->deep_copy());
+  copied_get_table->set_parameters({{ParameterID{0}, AllTypeVariant{8}}});
+  copied_get_table->execute();
+  EXPECT_EQ(copied_get_table->runtime_pruned_chunk_count(), 0u);
+}
+
+TEST_F(OperatorsGetTableTest, RuntimePruningPredicatesOnPrunedColumns) {
+  // With column a pruned, column b (all 10) is the first output column
+  const auto b = pqp_column_(ColumnID{0}, DataType::Int, false, "b");
+  const auto parameter = correlated_parameter_(ParameterID{0}, b);
+
+  auto get_table = std::make_shared<GetTable>("int_int_float", std::vector{ChunkID{1}}, std::vector{ColumnID{0}});
+  get_table->set_runtime_pruning_predicates({between_inclusive_(b, parameter, 20)});
+  get_table->set_parameters({{ParameterID{0}, AllTypeVariant{11}}});
+  get_table->execute();
+  EXPECT_EQ(get_table->runtime_pruned_chunk_count(), 3u);
+  EXPECT_EQ(get_table->get_output()->chunk_count(), 0u);
+
+  // NULL values are never used for pruning
+  get_table = std::make_shared<GetTable>("int_int_float", std::vector<ChunkID>{}, std::vector{ColumnID{0}});
+  get_table->set_runtime_pruning_predicates({equals_(b, parameter)});
+  get_table->set_parameters({{ParameterID{0}, NULL_VALUE}});
+  get_table->execute();
+  EXPECT_EQ(get_table->runtime_pruned_chunk_count(), 0u);
+}
+
+TEST_F(OperatorsGetTableTest, RuntimePruningPredicatesWithoutColumnOperand) {
+  const auto a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+  const auto parameter = correlated_parameter_(ParameterID{0}, a);
+
+  // Neither an expression on a column nor a condition that cannot be flipped is used for pruning
+  auto get_table = std::make_shared<GetTable>("int_int_float");
+  get_table->set_runtime_pruning_predicates({like_(parameter, a), equals_(add_(a, 1), parameter)});
+  get_table->set_parameters({{ParameterID{0}, AllTypeVariant{10}}});
+  get_table->execute();
+  EXPECT_EQ(get_table->runtime_pruned_chunk_count(), 0u);
+  EXPECT_EQ(get_table->get_output()->chunk_count(), 4u);
+}
+
 TEST_F(OperatorsGetTableTest, AdaptOrderByInformation) {
   auto table = Hyrise::get().storage_manager.get_table("int_int_float");
   table->get_chunk(ChunkID{0})->set_ordered_by({ColumnID{0}, OrderByMode::Ascending});
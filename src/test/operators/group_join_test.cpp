@@ -0,0 +1,105 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/group_join.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsGroupJoinTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _build_wrapper = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/group_join/build.tbl", 2));
+    _build_wrapper->execute();
+    _probe_wrapper = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/group_join/probe.tbl", 2));
+    _probe_wrapper->execute();
+
+    // ColumnIDs refer to the join result, i.e., id, name, build_id, price, quantity
+    const auto count_star = std::make_shared<AggregateExpression>(
+        AggregateFunction::Count, pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*"));
+    const auto name = pqp_column_(ColumnID{1}, DataType::String, false, "name");
+    const auto price = pqp_column_(ColumnID{3}, DataType::Float, true, "price");
+    const auto quantity = pqp_column_(ColumnID{4}, DataType::Int, false, "quantity");
+
+    _aggregates = {any_(name), count_star, sum_(price), count_(price), avg_(price), min_(quantity), max_(quantity)};
+  }
+
+ protected:
+  const OperatorJoinPredicate _join_predicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  const std::vector<ColumnID> _groupby_column_ids{ColumnID{0}};
+
+  std::shared_ptr<TableWrapper> _build_wrapper, _probe_wrapper;
+  std::vector<std::shared_ptr<AggregateExpression>> _aggregates;
+};
+
+TEST_F(OperatorsGroupJoinTest, OperatorName) {
+  const auto group_join =
+      std::make_shared<GroupJoin>(_build_wrapper, _probe_wrapper, _join_predicate, _aggregates, _groupby_column_ids);
+  EXPECT_EQ(group_join->name(), "GroupJoin");
+}
+
+TEST_F(OperatorsGroupJoinTest, AggregateWhileProbing) {
+  // Rows without a join partner (id 4, build_id 5) and NULL keys do not contribute to the result
+  const auto group_join =
+      std::make_shared<GroupJoin>(_build_wrapper, _probe_wrapper, _join_predicate, _aggregates, _groupby_column_ids);
+  group_join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(group_join->get_output(), load_table("resources/test_data/tbl/group_join/result.tbl"));
+}
+
+TEST_F(OperatorsGroupJoinTest, MatchesJoinAndAggregate) {
+  // Probe with reference segments that point to different chunks
+  const auto table_scan = create_table_scan(_probe_wrapper, ColumnID{2}, PredicateCondition::GreaterThan, 2);
+  table_scan->execute();
+
+  const auto group_join =
+      std::make_shared<GroupJoin>(_build_wrapper, table_scan, _join_predicate, _aggregates, _groupby_column_ids);
+  group_join->execute();
+
+  const auto join = std::make_shared<JoinHash>(_build_wrapper, table_scan, JoinMode::Inner, _join_predicate);
+  join->execute();
+  const auto aggregate = std::make_shared<AggregateHash>(join, _aggregates, _groupby_column_ids);
+  aggregate->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(group_join->get_output(), aggregate->get_output());
+}
+
+TEST_F(OperatorsGroupJoinTest, NoJoinPartners) {
+  const auto table_scan = create_table_scan(_probe_wrapper, ColumnID{0}, PredicateCondition::GreaterThan, 4);
+  table_scan->execute();
+
+  const auto group_join =
+      std::make_shared<GroupJoin>(_build_wrapper, table_scan, _join_predicate, _aggregates, _groupby_column_ids);
+  group_join->execute();
+
+  EXPECT_EQ(group_join->get_output()->row_count(), 0u);
+  EXPECT_EQ(group_join->get_output()->column_count(), 8u);
+}
+
+TEST_F(OperatorsGroupJoinTest, ForbidDuplicateBuildKeys) {
+  const auto build_wrapper =
+      std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/group_join/build_duplicate.tbl", 2));
+  build_wrapper->execute();
+
+  const auto group_join =
+      std::make_shared<GroupJoin>(build_wrapper, _probe_wrapper, _join_predicate, _aggregates, _groupby_column_ids);
+  EXPECT_THROW(group_join->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsGroupJoinTest, ForbidUnsupportedAggregates) {
+  const auto price = pqp_column_(ColumnID{3}, DataType::Float, true, "price");
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{count_distinct_(price)};
+
+  EXPECT_THROW(GroupJoin(_build_wrapper, _probe_wrapper, _join_predicate, aggregates, _groupby_column_ids),
+               std::logic_error);
+}
+
+}  // namespace opossum
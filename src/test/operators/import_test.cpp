@@ -9,7 +9,9 @@
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/frame_of_reference_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
 
 namespace opossum {
 
@@ -136,4 +138,21 @@ TEST_F(OperatorsImportTest, TargetChunkSize) {
   EXPECT_TABLE_EQ_ORDERED(Hyrise::get().storage_manager.get_table("a"), expected_table);
 }
 
+TEST_F(OperatorsImportTest, EncodingSpec) {
+  auto importer = std::make_shared<Import>("resources/test_data/csv/float_int_large.csv", "a", ChunkOffset{20},
+                                           FileType::Auto, std::nullopt, EncodingType::FrameOfReference);
+  importer->execute();
+
+  // FrameOfReference does not support floats, so the float column is left unencoded
+  const auto table = Hyrise::get().storage_manager.get_table("a");
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<FrameOfReferenceSegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+
+  EXPECT_EQ(table->row_count(), 100U);
+}
+
 }  // namespace opossum
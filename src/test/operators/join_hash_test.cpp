@@ -1,5 +1,6 @@
 #include "../base_test.hpp"
 
+#include "memory/query_memory_budget.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/table_wrapper.hpp"
 #include "types.hpp"
@@ -117,4 +118,58 @@ TEST_F(OperatorsJoinHashTest, RadixBitCalculation) {
                                                   std::numeric_limits<size_t>::max()) > 0ul);
 }
 
+TEST_F(OperatorsJoinHashTest, SpillsIfMemoryBudgetIsExceeded) {
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  const auto secondary_predicates =
+      std::vector<OperatorJoinPredicate>{{{ColumnID{1}, ColumnID{1}}, PredicateCondition::NotEquals}};
+
+  const auto test_join = [&](const auto& left, const auto& right, const JoinMode mode, const auto& secondary) {
+    SCOPED_TRACE(join_mode_to_string.left.at(mode));
+
+    const auto join = std::make_shared<JoinHash>(left, right, mode, primary_predicate, secondary);
+    join->execute();
+
+    // Wrap the inputs again, so that the budget is not set on the shared input operators
+    const auto left_input = std::make_shared<TableWrapper>(left->get_output());
+    const auto right_input = std::make_shared<TableWrapper>(right->get_output());
+    left_input->execute();
+    right_input->execute();
+
+    // The budget is about a fourth of the join's estimated working memory
+    const auto memory_budget = std::make_shared<QueryMemoryBudget>(50'000);
+    const auto spilling_join = std::make_shared<JoinHash>(left_input, right_input, mode, primary_predicate, secondary);
+    spilling_join->set_memory_budget_recursively(memory_budget);
+    spilling_join->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(spilling_join->get_output(), join->get_output());
+    EXPECT_GT(memory_budget->peak_reserved_bytes(), size_t{0});
+    EXPECT_LE(memory_budget->peak_reserved_bytes(), memory_budget->limit());
+    EXPECT_EQ(memory_budget->reserved_bytes(), size_t{0});
+  };
+
+  const auto join_modes = {JoinMode::Inner, JoinMode::Left, JoinMode::Right, JoinMode::Semi, JoinMode::AntiNullAsFalse};
+  for (const auto mode : join_modes) {
+    test_join(_table_tpch_orders_scanned, _table_tpch_lineitems_scanned, mode, std::vector<OperatorJoinPredicate>{});
+    test_join(_table_tpch_lineitems, _table_tpch_orders, mode, secondary_predicates);
+  }
+}
+
+TEST_F(OperatorsJoinHashTest, SpillingKeepsNullsOfOuterRelation) {
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{1}, ColumnID{1}}, PredicateCondition::Equals};
+
+  for (const auto mode : {JoinMode::Left, JoinMode::AntiNullAsFalse}) {
+    const auto join = std::make_shared<JoinHash>(_table_with_nulls, _table_with_nulls, mode, primary_predicate);
+    join->execute();
+
+    const auto input = std::make_shared<TableWrapper>(_table_with_nulls->get_output());
+    input->execute();
+
+    const auto spilling_join = std::make_shared<JoinHash>(input, input, mode, primary_predicate);
+    spilling_join->set_memory_budget_recursively(std::make_shared<QueryMemoryBudget>(1));
+    spilling_join->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(spilling_join->get_output(), join->get_output());
+  }
+}
+
 }  // namespace opossum
@@ -7,11 +7,13 @@
 #include "expression/expression_functional.hpp"
 #include "expression/pqp_column_expression.hpp"
 #include "hyrise.hpp"
+#include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "sql/sql_pipeline_builder.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/table.hpp"
 
@@ -61,6 +63,45 @@ class OperatorsUpdateTest : public BaseTest {
     EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), load_table(expected_result_path));
   }
 
+  // Sets b to @param new_value for all rows with a > 100 that are visible to the transaction
+  std::shared_ptr<Update> update_in_place(const std::shared_ptr<TransactionContext>& transaction_context,
+                                          const float new_value) {
+    const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    const auto where_scan = std::make_shared<TableScan>(validate, greater_than_(column_a, 100));
+    const auto updated_values_projection =
+        std::make_shared<Projection>(where_scan, expression_vector(column_a, new_value));
+    const auto update =
+        std::make_shared<Update>(table_to_update_name, where_scan, updated_values_projection, UpdateMode::InPlace);
+
+    for (const auto& op : std::vector<std::shared_ptr<AbstractOperator>>{get_table, validate, where_scan,
+                                                                         updated_values_projection, update}) {
+      op->set_transaction_context(transaction_context);
+      op->execute();
+    }
+    return update;
+  }
+
+  std::shared_ptr<const Table> validated_table(const std::shared_ptr<TransactionContext>& transaction_context) {
+    const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    get_table->set_transaction_context(transaction_context);
+    validate->set_transaction_context(transaction_context);
+    get_table->execute();
+    validate->execute();
+    return validate->get_output();
+  }
+
+  // Replaces the test table with one whose rows are stored in a single mutable chunk
+  std::shared_ptr<Table> add_mutable_table() {
+    const auto table =
+        load_table("resources/test_data/tbl/int_float2.tbl", Chunk::DEFAULT_SIZE, FinalizeLastChunk::No);
+    table->set_update_mode(UpdateMode::InPlace);
+    Hyrise::get().storage_manager.drop_table(table_to_update_name);
+    Hyrise::get().storage_manager.add_table(table_to_update_name, table);
+    return table;
+  }
+
   std::string table_to_update_name{"updateTestTable"};
   inline static std::shared_ptr<AbstractExpression> column_a, column_b;
 };
@@ -83,4 +124,114 @@ TEST_F(OperatorsUpdateTest, UpdateNone) {
   helper(greater_than_(column_a, 100'000), expression_vector(1, 1.5f), "resources/test_data/tbl/int_float2.tbl");
 }
 
+TEST_F(OperatorsUpdateTest, UpdateInPlace) {
+  const auto table = add_mutable_table();
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  const auto old_transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+
+  const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto update = update_in_place(transaction_context, 7.5f);
+  EXPECT_FALSE(update->execute_failed());
+
+  // The transaction sees its own update, others do not until it has committed
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(transaction_context),
+                            load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(old_transaction_context),
+                            load_table("resources/test_data/tbl/int_float2.tbl"));
+  transaction_context->commit();
+
+  // No rows were invalidated or inserted
+  EXPECT_EQ(table->row_count(), 4u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->invalid_row_count(), 0u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->mvcc_data()->row_versions()->version_count(), 3u);
+
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(old_transaction_context),
+                            load_table("resources/test_data/tbl/int_float2.tbl"));
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(transaction_manager.new_transaction_context(AutoCommit::No)),
+                            load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+}
+
+TEST_F(OperatorsUpdateTest, UpdateModeIsReadAtExecution) {
+  const auto table = add_mutable_table();
+  table->set_update_mode(UpdateMode::DeleteInsert);
+
+  // The PQP is translated before the update mode changes, as it would be for a cached or prepared plan
+  auto pipeline = SQLPipelineBuilder{"UPDATE " + table_to_update_name + " SET b = 7.5 WHERE a > 100"}.create_pipeline();
+  pipeline.get_physical_plans();
+  table->set_update_mode(UpdateMode::InPlace);
+  EXPECT_EQ(pipeline.get_result_table().first, SQLPipelineStatus::Success);
+
+  EXPECT_EQ(table->row_count(), 4u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->mvcc_data()->row_versions()->version_count(), 3u);
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)),
+                            load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+}
+
+TEST_F(OperatorsUpdateTest, UpdateInPlaceRollback) {
+  const auto table = add_mutable_table();
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+  update_in_place(transaction_context, 7.5f);
+  transaction_context->rollback(RollbackReason::User);
+
+  EXPECT_TRUE(table->get_chunk(ChunkID{0})->mvcc_data()->row_versions()->empty());
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(transaction_manager.new_transaction_context(AutoCommit::No)),
+                            load_table("resources/test_data/tbl/int_float2.tbl"));
+}
+
+TEST_F(OperatorsUpdateTest, UpdateInPlaceConflicts) {
+  add_mutable_table();
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  // Concurrent update of the same rows
+  const auto transaction_context_1 = transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto transaction_context_2 = transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_FALSE(update_in_place(transaction_context_1, 7.5f)->execute_failed());
+  EXPECT_TRUE(update_in_place(transaction_context_2, 8.5f)->execute_failed());
+  transaction_context_2->rollback(RollbackReason::Conflict);
+
+  // Updates that are not visible to the snapshot
+  const auto transaction_context_3 = transaction_manager.new_transaction_context(AutoCommit::No);
+  transaction_context_1->commit();
+  EXPECT_TRUE(update_in_place(transaction_context_3, 8.5f)->execute_failed());
+  transaction_context_3->rollback(RollbackReason::Conflict);
+
+  // Delete of an updated row
+  const auto transaction_context_4 = transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto transaction_context_5 = transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_FALSE(update_in_place(transaction_context_4, 9.5f)->execute_failed());
+
+  const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+  const auto validate = std::make_shared<Validate>(get_table);
+  const auto where_scan = std::make_shared<TableScan>(validate, greater_than_(column_a, 200));
+  const auto delete_op = std::make_shared<Delete>(where_scan);
+  for (const auto& op : std::vector<std::shared_ptr<AbstractOperator>>{get_table, validate, where_scan, delete_op}) {
+    op->set_transaction_context(transaction_context_5);
+    op->execute();
+  }
+  EXPECT_TRUE(delete_op->execute_failed());
+  transaction_context_5->rollback(RollbackReason::Conflict);
+  transaction_context_4->commit();
+
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(transaction_manager.new_transaction_context(AutoCommit::No)),
+                            load_table("resources/test_data/tbl/int_float2_updated_2.tbl"));
+}
+
+TEST_F(OperatorsUpdateTest, UpdateInPlaceFallsBackForFinalizedChunks) {
+  // The rows of the finalized chunks are deleted and re-inserted
+  const auto table = Hyrise::get().storage_manager.get_table(table_to_update_name);
+  table->set_update_mode(UpdateMode::InPlace);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_FALSE(update_in_place(transaction_context, 7.5f)->execute_failed());
+  transaction_context->commit();
+
+  EXPECT_EQ(table->row_count(), 7u);
+  EXPECT_TABLE_EQ_UNORDERED(
+      validated_table(Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)),
+      load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+}
+
 }  // namespace opossum
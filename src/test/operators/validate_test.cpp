@@ -88,6 +88,25 @@ TEST_F(OperatorsValidateTest, SimpleValidate) {
   EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), expected_result);
 }
 
+TEST_F(OperatorsValidateTest, ReadOnlyValidate) {
+  // Rows that are locked by another transaction (e.g., for a delete that has not been committed yet) remain visible
+  _test_table->get_chunk(ChunkID{0})->mvcc_data()->set_tid(0, TransactionID{17});
+
+  // Unlocked rows have INVALID_TRANSACTION_ID, which must not be mistaken for the read-only transaction's own TID
+  auto context =
+      std::make_shared<TransactionContext>(INVALID_TRANSACTION_ID, 3u, AutoCommit::No, TransactionMode::ReadOnly);
+
+  auto validate = std::make_shared<Validate>(_table_wrapper);
+  validate->set_transaction_context(context);
+  validate->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(validate->get_output(),
+                            load_table("resources/test_data/tbl/validate_output_validated.tbl", 2u));
+  EXPECT_TRUE(Validate::is_row_visible(INVALID_TRANSACTION_ID, 3u, INVALID_TRANSACTION_ID, 1u, 4u));
+  EXPECT_FALSE(Validate::is_row_visible(INVALID_TRANSACTION_ID, 3u, INVALID_TRANSACTION_ID, 1u, 3u));
+  EXPECT_FALSE(Validate::is_row_visible(INVALID_TRANSACTION_ID, 3u, INVALID_TRANSACTION_ID, 4u, 5u));
+}
+
 TEST_F(OperatorsValidateTest, ScanValidate) {
   auto context = std::make_shared<TransactionContext>(1u, 3u, AutoCommit::No);
 
@@ -202,6 +221,43 @@ TEST_F(OperatorsValidateTest, ChunkEntirelyVisible) {
   EXPECT_TRUE(forward_is_entire_chunk_visible(validate, chunk, snapshot_cid));
 }
 
+TEST_F(OperatorsValidateTest, ChunkEntirelyVisibleWithCompactedMvccData) {
+  auto vs_int = std::make_shared<ValueSegment<int32_t>>();
+  vs_int->append(4);
+  auto chunk = std::make_shared<Chunk>(Segments{vs_int}, std::make_shared<MvccData>(1, CommitID{1}));
+  chunk->finalize();
+  ASSERT_TRUE(chunk->try_compact_mvcc_data(CommitID{1}));
+
+  auto validate = std::make_shared<Validate>(nullptr);
+
+  EXPECT_FALSE(forward_is_entire_chunk_visible(validate, chunk, CommitID{0}));
+  EXPECT_TRUE(forward_is_entire_chunk_visible(validate, chunk, CommitID{1}));
+
+  // Once written to, the compacted MVCC data is subject to the regular conditions
+  chunk->mvcc_data()->set_tid(0, TransactionID{5});
+  chunk->mvcc_data()->set_end_cid(0, CommitID{2});
+  chunk->increase_invalid_row_count(1);
+  EXPECT_FALSE(forward_is_entire_chunk_visible(validate, chunk, CommitID{2}));
+}
+
+TEST_F(OperatorsValidateTest, ValidateCompactedMvccData) {
+  // The invalidated row of the second chunk is part of the compacted MVCC data
+  for (ChunkID chunk_id{0}; chunk_id < _test_table->chunk_count(); ++chunk_id) {
+    EXPECT_TRUE(_test_table->get_chunk(chunk_id)->try_compact_mvcc_data(CommitID{2}));
+  }
+  EXPECT_TRUE(_test_table->get_chunk(ChunkID{0})->mvcc_data()->is_compacted_and_entirely_valid());
+  EXPECT_FALSE(_test_table->get_chunk(ChunkID{1})->mvcc_data()->is_compacted_and_entirely_valid());
+
+  auto context = std::make_shared<TransactionContext>(1u, 3u, AutoCommit::No);
+
+  auto validate = std::make_shared<Validate>(_table_wrapper);
+  validate->set_transaction_context(context);
+  validate->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(validate->get_output(),
+                            load_table("resources/test_data/tbl/validate_output_validated.tbl", 2u));
+}
+
 TEST_F(OperatorsValidateTest, ValidateReferenceSegmentWithMultipleChunks) {
   // If Validate has a reference table as input, it can usually optimize the evaluation of the MVCC data.
   // This optimization is possible, if a PosList of a reference segment references only one chunk.
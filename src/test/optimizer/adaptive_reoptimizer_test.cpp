@@ -0,0 +1,152 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/abstract_operator.hpp"
+#include "optimizer/adaptive_reoptimizer.hpp"
+#include "scheduler/operator_task.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "sql/sql_pipeline_statement.hpp"
+#include "sql/sql_plan_cache.hpp"
+#include "statistics/cardinality_feedback.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class AdaptiveReoptimizerTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // x and y are perfectly correlated. Thus, a conjunction of predicates on both is estimated to be far more
+    // selective than it is.
+    for (const auto& table_name : {"table_a", "table_b", "table_c"}) {
+      const auto table = std::make_shared<Table>(
+          TableColumnDefinitions{{"x", DataType::Int, false}, {"y", DataType::Int, false}}, TableType::Data, 100,
+          UseMvcc::Yes);
+      for (auto row_id = int32_t{0}; row_id < 1000; ++row_id) {
+        table->append({row_id % 100, row_id % 100});
+      }
+      Hyrise::get().storage_manager.add_table(table_name, table);
+    }
+
+    node_a = StoredTableNode::make("table_a");
+    node_b = StoredTableNode::make("table_b");
+    node_c = StoredTableNode::make("table_c");
+    a_x = node_a->get_column("x");
+    b_x = node_b->get_column("x");
+    c_x = node_c->get_column("x");
+  }
+
+  std::shared_ptr<const Table> execute(const std::string& query, const std::string& q_error_threshold,
+                                       std::shared_ptr<SQLPipelineStatementMetrics>* metrics = nullptr) {
+    Hyrise::get().settings_manager.get_setting(AdaptiveReoptimizer::SETTING_NAME)->set(q_error_threshold);
+
+    auto statement =
+        SQLPipelineBuilder{query}.with_pqp_cache(pqp_cache).with_lqp_cache(lqp_cache).create_pipeline_statement();
+    const auto [status, table] = statement.get_result_table();
+    EXPECT_EQ(status, SQLPipelineStatus::Success);
+    if (metrics) *metrics = statement.metrics();
+    return table;
+  }
+
+  const std::string query =
+      "SELECT a.x, COUNT(*) FROM table_a a, table_b b, table_c c "
+      "WHERE a.x = b.x AND b.x = c.x AND a.x < 10 AND a.y < 10 GROUP BY a.x";
+
+  std::shared_ptr<SQLPhysicalPlanCache> pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
+  std::shared_ptr<SQLLogicalPlanCache> lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+
+  std::shared_ptr<StoredTableNode> node_a, node_b, node_c;
+  LQPColumnReference a_x, b_x, c_x;
+};
+
+TEST_F(AdaptiveReoptimizerTest, DisabledByDefault) {
+  EXPECT_EQ(AdaptiveReoptimizer::q_error_threshold_from_settings(), std::nullopt);
+
+  Hyrise::get().settings_manager.get_setting(AdaptiveReoptimizer::SETTING_NAME)->set("3");
+  EXPECT_EQ(AdaptiveReoptimizer::q_error_threshold_from_settings(), 3.0);
+}
+
+TEST_F(AdaptiveReoptimizerTest, IsApplicable) {
+  const auto single_join = JoinNode::make(JoinMode::Inner, equals_(a_x, b_x), node_a, node_b);
+  EXPECT_FALSE(AdaptiveReoptimizer::is_applicable(single_join));
+
+  const auto two_joins = JoinNode::make(JoinMode::Inner, equals_(b_x, c_x), single_join, node_c);
+  EXPECT_TRUE(AdaptiveReoptimizer::is_applicable(two_joins));
+
+  const auto placeholder = PredicateNode::make(less_than_(a_x, placeholder_(ParameterID{0})), two_joins);
+  EXPECT_FALSE(AdaptiveReoptimizer::is_applicable(placeholder));
+}
+
+TEST_F(AdaptiveReoptimizerTest, ExecuteCheckpoints) {
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(b_x, c_x),
+    JoinNode::make(JoinMode::Inner, equals_(a_x, b_x),
+      PredicateNode::make(less_than_(a_x, 10),
+        node_a),
+      node_b),
+    node_c);
+  // clang-format on
+
+  const auto lqp_copy = lqp->deep_copy();
+
+  auto executed_operators = std::vector<std::shared_ptr<AbstractOperator>>{};
+  auto reoptimizer = AdaptiveReoptimizer{2.0, [&](const std::shared_ptr<AbstractOperator>& pqp) {
+                                           executed_operators.emplace_back(pqp);
+                                           const auto tasks = OperatorTask::make_tasks_from_operator(pqp);
+                                           Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+                                         }};
+  const auto remaining_lqp = reoptimizer.execute_checkpoints(lqp);
+
+  // The lower join is executed, the upper one reads its output from a StaticTableNode
+  ASSERT_EQ(executed_operators.size(), 1u);
+  EXPECT_EQ(executed_operators.front()->get_output()->row_count(), 1'000u);
+  ASSERT_EQ(remaining_lqp->type, LQPNodeType::Join);
+  EXPECT_TRUE(remaining_lqp->left_input()->type == LQPNodeType::StaticTable ||
+              remaining_lqp->right_input()->type == LQPNodeType::StaticTable);
+
+  // The input LQP is not modified
+  EXPECT_LQP_EQ(lqp, lqp_copy);
+}
+
+TEST_F(AdaptiveReoptimizerTest, ReoptimizeOnMisestimate) {
+  const auto expected_table = execute(query, "0");
+
+  std::shared_ptr<SQLPipelineStatementMetrics> metrics;
+  pqp_cache->clear();
+  lqp_cache->clear();
+  const auto adaptive_table = execute(query, "2", &metrics);
+
+  EXPECT_TABLE_EQ_UNORDERED(adaptive_table, expected_table);
+  EXPECT_GT(metrics->reoptimization_count, 0u);
+  EXPECT_FALSE(Hyrise::get().cardinality_feedback->empty());
+
+  // The next execution uses the cached plan, which was optimized based on the feedback
+  const auto cached_table = execute(query, "2", &metrics);
+  EXPECT_TRUE(metrics->query_plan_cache_hit);
+  EXPECT_EQ(metrics->reoptimization_count, 0u);
+  EXPECT_TABLE_EQ_UNORDERED(cached_table, expected_table);
+}
+
+TEST_F(AdaptiveReoptimizerTest, NoReoptimizationForGoodEstimates) {
+  const auto expected_table = execute(query, "0");
+
+  std::shared_ptr<SQLPipelineStatementMetrics> metrics;
+  pqp_cache->clear();
+  lqp_cache->clear();
+  const auto adaptive_table = execute(query, "1000000", &metrics);
+
+  EXPECT_TABLE_EQ_UNORDERED(adaptive_table, expected_table);
+  EXPECT_EQ(metrics->reoptimization_count, 0u);
+  EXPECT_TRUE(Hyrise::get().cardinality_feedback->empty());
+}
+
+}  // namespace opossum
@@ -54,6 +54,15 @@ class ChunkPruningRuleTest : public StrategyBaseTest {
                                     SegmentEncodingSpec{EncodingType::FixedStringDictionary});
     storage_manager.add_table("fixed_string_compressed", fixed_string_compressed_table);
 
+    // The values are too dense for range filters, but each chunk only contains even values
+    auto even_values_table =
+        std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data, 100u);
+    for (auto value = int32_t{0}; value < 400; value += 2) {
+      even_values_table->append({value});
+    }
+    ChunkEncoder::encode_all_chunks(even_values_table, SegmentEncodingSpec{EncodingType::Dictionary});
+    storage_manager.add_table("even_values", even_values_table);
+
     for (const auto& [name, table] : storage_manager.tables()) {
       generate_chunk_pruning_statistics(table);
     }
@@ -319,6 +328,59 @@ TEST_F(ChunkPruningRuleTest, FixedStringPruningTest) {
   EXPECT_EQ(pruned_chunk_ids, expected_chunk_ids);
 }
 
+TEST_F(ChunkPruningRuleTest, BloomFilterPruningTest) {
+  // Odd values lie within the range of the first chunk, but are not contained in it. Allow for false positives of the
+  // Bloom filter.
+  auto pruned_count = size_t{0};
+  for (auto value = int32_t{1}; value < 200; value += 2) {
+    const auto stored_table_node = StoredTableNode::make("even_values");
+    const auto column = stored_table_node->get_column("a");
+    const auto predicate_node = PredicateNode::make(equals_(column, value), stored_table_node);
+
+    StrategyBaseTest::apply_rule(_rule, predicate_node);
+
+    const auto& pruned_chunk_ids = stored_table_node->pruned_chunk_ids();
+    EXPECT_NE(std::find(pruned_chunk_ids.begin(), pruned_chunk_ids.end(), ChunkID{1}), pruned_chunk_ids.end());
+    if (pruned_chunk_ids.size() == 2) ++pruned_count;
+  }
+  EXPECT_GE(pruned_count, 90u);
+
+  // Contained values are never pruned
+  const auto stored_table_node = StoredTableNode::make("even_values");
+  const auto predicate_node = PredicateNode::make(equals_(stored_table_node->get_column("a"), 42), stored_table_node);
+  StrategyBaseTest::apply_rule(_rule, predicate_node);
+  EXPECT_EQ(stored_table_node->pruned_chunk_ids(), std::vector<ChunkID>{ChunkID{1}});
+}
+
+TEST_F(ChunkPruningRuleTest, InPruningTest) {
+  auto stored_table_node = StoredTableNode::make("compressed");
+  const auto column = LQPColumnReference(stored_table_node, ColumnID{0});
+
+  auto predicate_node = PredicateNode::make(in_(column, list_(12, 99999)), stored_table_node);
+  StrategyBaseTest::apply_rule(_rule, predicate_node);
+  EXPECT_EQ(stored_table_node->pruned_chunk_ids(), std::vector<ChunkID>{ChunkID{0}});
+  ASSERT_TRUE(stored_table_node->table_statistics);
+  EXPECT_FLOAT_EQ(stored_table_node->table_statistics->row_count, 2.0f);
+
+  // NULLs never match
+  stored_table_node = StoredTableNode::make("compressed");
+  predicate_node = PredicateNode::make(in_(column, list_(50, NullValue{})), stored_table_node);
+  StrategyBaseTest::apply_rule(_rule, predicate_node);
+  EXPECT_EQ(stored_table_node->pruned_chunk_ids(), (std::vector<ChunkID>{ChunkID{0}, ChunkID{1}}));
+
+  // NOT IN and INs with non-literal elements are not pruned
+  stored_table_node = StoredTableNode::make("compressed");
+  predicate_node = PredicateNode::make(not_in_(column, list_(50, 60)), stored_table_node);
+  StrategyBaseTest::apply_rule(_rule, predicate_node);
+  EXPECT_TRUE(stored_table_node->pruned_chunk_ids().empty());
+
+  stored_table_node = StoredTableNode::make("compressed");
+  const auto other_column = LQPColumnReference(stored_table_node, ColumnID{1});
+  predicate_node = PredicateNode::make(in_(column, list_(50, other_column)), stored_table_node);
+  StrategyBaseTest::apply_rule(_rule, predicate_node);
+  EXPECT_TRUE(stored_table_node->pruned_chunk_ids().empty());
+}
+
 TEST_F(ChunkPruningRuleTest, PrunePastNonFilteringNodes) {
   auto stored_table_node = std::make_shared<StoredTableNode>("compressed");
 
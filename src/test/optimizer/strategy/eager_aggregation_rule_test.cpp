@@ -0,0 +1,186 @@
+#include "optimizer/strategy/strategy_base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/alias_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/mock_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+#include "optimizer/strategy/eager_aggregation_rule.hpp"
+#include "statistics/statistics_objects/generic_histogram.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class EagerAggregationRuleTest : public StrategyBaseTest {
+ protected:
+  void SetUp() override {
+    // A fact table with a million rows that references the 100 rows of the dimension table
+    _fact_node = create_mock_node_with_statistics(
+        {{DataType::Int, "dimension_id"}, {DataType::Int, "price"}}, 1'000'000,
+        {GenericHistogram<int32_t>::with_single_bin(1, 100, 1'000'000, 100),
+         GenericHistogram<int32_t>::with_single_bin(1, 1'000, 1'000'000, 1'000)});
+    _dimension_id = _fact_node->get_column("dimension_id");
+    _price = _fact_node->get_column("price");
+
+    _dimension_node = create_mock_node_with_statistics(
+        {{DataType::Int, "id"}, {DataType::Int, "category"}}, 100,
+        {GenericHistogram<int32_t>::with_single_bin(1, 100, 100, 100),
+         GenericHistogram<int32_t>::with_single_bin(1, 10, 100, 10)});
+    _id = _dimension_node->get_column("id");
+    _category = _dimension_node->get_column("category");
+  }
+
+  // Returns the column names that the AliasNode on top of the rewritten LQP retains
+  static std::vector<std::string> column_names(const std::vector<std::shared_ptr<AbstractExpression>>& expressions) {
+    auto names = std::vector<std::string>{};
+    for (const auto& expression : expressions) names.emplace_back(expression->as_column_name());
+    return names;
+  }
+
+  std::shared_ptr<MockNode> _fact_node, _dimension_node;
+  LQPColumnReference _dimension_id, _price, _id, _category;
+  std::shared_ptr<EagerAggregationRule> _rule{std::make_shared<EagerAggregationRule>()};
+};
+
+TEST_F(EagerAggregationRuleTest, PreAggregateFactTable) {
+  // clang-format off
+  const auto input_lqp =
+  AggregateNode::make(expression_vector(_category), expression_vector(sum_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+      _fact_node,
+      _dimension_node));
+
+  const auto original_column_names = column_names(input_lqp->column_expressions());
+
+  const auto expected_lqp =
+  AliasNode::make(expression_vector(_category, sum_(sum_(_price))), original_column_names,
+    AggregateNode::make(expression_vector(_category), expression_vector(sum_(sum_(_price))),
+      JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+        AggregateNode::make(expression_vector(_dimension_id), expression_vector(sum_(_price)),
+          _fact_node),
+        _dimension_node)));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(_rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(EagerAggregationRuleTest, SplitAverageAndCount) {
+  // The nodes above the aggregate refer to the new expressions
+  // clang-format off
+  const auto input_lqp =
+  ProjectionNode::make(expression_vector(add_(avg_(_price), 1), count_star_(_dimension_node)),
+    AggregateNode::make(expression_vector(_category), expression_vector(avg_(_price), count_star_(_dimension_node)),
+      JoinNode::make(JoinMode::Inner, equals_(_id, _dimension_id),
+        _dimension_node,
+        _fact_node)));
+
+  const auto partial_aggregates = expression_vector(sum_(_price), count_(_price), count_star_(_fact_node));
+  const auto final_count = sum_(count_star_(_fact_node));
+  const auto final_aggregates = expression_vector(sum_(sum_(_price)), sum_(count_(_price)), final_count);
+  const auto final_avg = div_(cast_(sum_(sum_(_price)), DataType::Double), sum_(count_(_price)));
+
+  const auto expected_lqp =
+  AliasNode::make(expression_vector(add_(final_avg, 1), final_count), column_names(input_lqp->column_expressions()),
+    ProjectionNode::make(expression_vector(add_(final_avg, 1), final_count),
+      ProjectionNode::make(expression_vector(_category, final_avg, final_count),
+        AggregateNode::make(expression_vector(_category), final_aggregates,
+          JoinNode::make(JoinMode::Inner, equals_(_id, _dimension_id),
+            _dimension_node,
+            AggregateNode::make(expression_vector(_dimension_id), partial_aggregates,
+              _fact_node))))));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(_rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(EagerAggregationRuleTest, ComputeArgumentsBelowPartialAggregate) {
+  // The SQLTranslator computes complex aggregate arguments in a ProjectionNode below the AggregateNode
+  // clang-format off
+  const auto input_lqp =
+  AggregateNode::make(expression_vector(_category), expression_vector(max_(mul_(_price, 2))),
+    ProjectionNode::make(expression_vector(_dimension_id, _price, _id, _category, mul_(_price, 2)),
+      JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+        _fact_node,
+        _dimension_node)));
+
+  const auto original_column_names = column_names(input_lqp->column_expressions());
+
+  const auto expected_lqp =
+  AliasNode::make(expression_vector(_category, max_(max_(mul_(_price, 2)))), original_column_names,
+    AggregateNode::make(expression_vector(_category), expression_vector(max_(max_(mul_(_price, 2)))),
+      JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+        AggregateNode::make(expression_vector(_dimension_id), expression_vector(max_(mul_(_price, 2))),
+          ProjectionNode::make(expression_vector(_dimension_id, _price, mul_(_price, 2)),
+            _fact_node)),
+        _dimension_node)));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(_rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(EagerAggregationRuleTest, NoRewriteIfNotBeneficial) {
+  // Every fact row has a different join key, so pre-aggregating the fact table does not reduce its size
+  const auto fact_node = create_mock_node_with_statistics(
+      {{DataType::Int, "order_id"}, {DataType::Int, "price"}}, 1'000,
+      {GenericHistogram<int32_t>::with_single_bin(1, 1'000, 1'000, 1'000),
+       GenericHistogram<int32_t>::with_single_bin(1, 10, 1'000, 10)});
+  const auto order_id = fact_node->get_column("order_id");
+  const auto price = fact_node->get_column("price");
+
+  // clang-format off
+  const auto input_lqp =
+  AggregateNode::make(expression_vector(_category), expression_vector(sum_(price)),
+    JoinNode::make(JoinMode::Inner, equals_(order_id, _id),
+      fact_node,
+      _dimension_node));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(_rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(EagerAggregationRuleTest, NoRewriteForUnsupportedAggregates) {
+  // clang-format off
+  // Aggregate on both inputs of the join
+  const auto arguments_from_both_inputs =
+  AggregateNode::make(expression_vector(_category), expression_vector(sum_(_price), sum_(_id)),
+    JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+      _fact_node,
+      _dimension_node));
+
+  // No GROUP BY
+  const auto no_group_by =
+  AggregateNode::make(expression_vector(), expression_vector(sum_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+      _fact_node,
+      _dimension_node));
+
+  // Not decomposable
+  const auto count_distinct =
+  AggregateNode::make(expression_vector(_category), expression_vector(count_distinct_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_dimension_id, _id),
+      _fact_node,
+      _dimension_node));
+
+  // Not an inner join
+  const auto left_join =
+  AggregateNode::make(expression_vector(_category), expression_vector(sum_(_price)),
+    JoinNode::make(JoinMode::Left, equals_(_dimension_id, _id),
+      _fact_node,
+      _dimension_node));
+  // clang-format on
+
+  for (const auto& input_lqp : {arguments_from_both_inputs, no_group_by, count_distinct, left_join}) {
+    const auto expected_lqp = input_lqp->deep_copy();
+    const auto actual_lqp = apply_rule(_rule, input_lqp);
+    EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,141 @@
+#include "optimizer/strategy/strategy_base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
+#include "optimizer/strategy/group_join_rule.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class GroupJoinRuleTest : public StrategyBaseTest {
+ public:
+  void SetUp() override {
+    auto& storage_manager = Hyrise::get().storage_manager;
+
+    const auto customer_table = std::make_shared<Table>(
+        TableColumnDefinitions{{"id", DataType::Int, false}, {"name", DataType::String, false}}, TableType::Data, 2,
+        UseMvcc::Yes);
+    customer_table->add_soft_unique_constraint({ColumnID{0}}, IsPrimaryKey::Yes);
+    storage_manager.add_table("customer", customer_table);
+
+    const auto orders_table = std::make_shared<Table>(
+        TableColumnDefinitions{{"customer_id", DataType::Int, false}, {"price", DataType::Float, false}},
+        TableType::Data, 2, UseMvcc::Yes);
+    storage_manager.add_table("orders", orders_table);
+
+    _customer_node = StoredTableNode::make("customer");
+    _id = _customer_node->get_column("id");
+    _name = _customer_node->get_column("name");
+
+    _orders_node = StoredTableNode::make("orders");
+    _customer_id = _orders_node->get_column("customer_id");
+    _price = _orders_node->get_column("price");
+  }
+
+  std::shared_ptr<StoredTableNode> _customer_node, _orders_node;
+  LQPColumnReference _id, _name, _customer_id, _price;
+  std::shared_ptr<GroupJoinRule> _rule{std::make_shared<GroupJoinRule>()};
+};
+
+TEST_F(GroupJoinRuleTest, MarkAggregateAndMoveUniqueSideToTheLeft) {
+  // clang-format off
+  const auto input_lqp =
+  AggregateNode::make(expression_vector(_id), expression_vector(any_(_name), sum_(_price), count_star_(_orders_node)),
+    JoinNode::make(JoinMode::Inner, equals_(_customer_id, _id),
+      ValidateNode::make(
+        _orders_node),
+      PredicateNode::make(greater_than_(_id, 5),
+        ValidateNode::make(
+          _customer_node))));
+
+  const auto expected_lqp =
+  AggregateNode::make(expression_vector(_id), expression_vector(any_(_name), sum_(_price), count_star_(_orders_node)),
+    JoinNode::make(JoinMode::Inner, equals_(_customer_id, _id),
+      PredicateNode::make(greater_than_(_id, 5),
+        ValidateNode::make(
+          _customer_node)),
+      ValidateNode::make(
+        _orders_node)));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(_rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+  EXPECT_TRUE(std::static_pointer_cast<AggregateNode>(actual_lqp)->is_group_join);
+}
+
+TEST_F(GroupJoinRuleTest, NoGroupJoinWithoutUniqueJoinColumn) {
+  // clang-format off
+  // The join column of orders is not unique
+  const auto not_unique =
+  AggregateNode::make(expression_vector(_customer_id), expression_vector(max_(_id)),
+    JoinNode::make(JoinMode::Inner, equals_(_customer_id, _id),
+      ValidateNode::make(_orders_node),
+      ValidateNode::make(_customer_node)));
+
+  // Without a ValidateNode, outdated row versions might duplicate the key
+  const auto not_validated =
+  AggregateNode::make(expression_vector(_id), expression_vector(sum_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_customer_id, _id),
+      ValidateNode::make(_orders_node),
+      _customer_node));
+
+  // The projection might duplicate rows
+  const auto projected =
+  AggregateNode::make(expression_vector(_id), expression_vector(sum_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_customer_id, _id),
+      ValidateNode::make(_orders_node),
+      ProjectionNode::make(expression_vector(_id),
+        ValidateNode::make(_customer_node))));
+  // clang-format on
+
+  for (const auto& input_lqp : {not_unique, not_validated, projected}) {
+    const auto actual_lqp = apply_rule(_rule, input_lqp);
+    EXPECT_FALSE(std::static_pointer_cast<AggregateNode>(actual_lqp)->is_group_join);
+  }
+}
+
+TEST_F(GroupJoinRuleTest, NoGroupJoinForUnsupportedAggregates) {
+  const auto customer = ValidateNode::make(_customer_node);
+  const auto orders = ValidateNode::make(_orders_node);
+
+  // clang-format off
+  // The join column is not grouped by
+  const auto key_not_grouped =
+  AggregateNode::make(expression_vector(_name), expression_vector(sum_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_id, _customer_id), customer, orders));
+
+  // Grouping by a column of the other input
+  const auto group_by_other_input =
+  AggregateNode::make(expression_vector(_id, _price), expression_vector(count_star_(_orders_node)),
+    JoinNode::make(JoinMode::Inner, equals_(_id, _customer_id), customer, orders));
+
+  // Aggregating a column of the unique input
+  const auto aggregate_unique_input =
+  AggregateNode::make(expression_vector(_id), expression_vector(max_(_name)),
+    JoinNode::make(JoinMode::Inner, equals_(_id, _customer_id), customer, orders));
+
+  // Not decomposable into a single pass
+  const auto count_distinct =
+  AggregateNode::make(expression_vector(_id), expression_vector(count_distinct_(_price)),
+    JoinNode::make(JoinMode::Inner, equals_(_id, _customer_id), customer, orders));
+
+  // Not an inner join
+  const auto semi_join =
+  AggregateNode::make(expression_vector(_id), expression_vector(any_(_name)),
+    JoinNode::make(JoinMode::Semi, equals_(_id, _customer_id), customer, orders));
+  // clang-format on
+
+  for (const auto& input_lqp :
+       {key_not_grouped, group_by_other_input, aggregate_unique_input, count_distinct, semi_join}) {
+    const auto actual_lqp = apply_rule(_rule, input_lqp);
+    EXPECT_FALSE(std::static_pointer_cast<AggregateNode>(actual_lqp)->is_group_join);
+  }
+}
+
+}  // namespace opossum
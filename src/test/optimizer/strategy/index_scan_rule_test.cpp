@@ -10,9 +10,11 @@
 #include "expression/abstract_expression.hpp"
 #include "expression/expression_functional.hpp"
 #include "hyrise.hpp"
+#include "logical_query_plan/join_node.hpp"
 #include "logical_query_plan/mock_node.hpp"
 #include "logical_query_plan/predicate_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
 #include "optimizer/strategy/index_scan_rule.hpp"
 #include "optimizer/strategy/strategy_base_test.hpp"
 #include "statistics/attribute_statistics.hpp"
@@ -177,4 +179,72 @@ TEST_F(IndexScanRuleTest, IndexScanOnlyOnOutputOfStoredTableNode) {
   EXPECT_EQ(predicate_node_1->scan_type, ScanType::TableScan);
 }
 
+TEST_F(IndexScanRuleTest, TableHashIndexMergesKeyPredicates) {
+  table->create_table_hash_index({ColumnID{0}, ColumnID{1}});
+
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(greater_than_(c, 5),
+    PredicateNode::make(equals_(b, 3),
+      PredicateNode::make(equals_(a, 2),
+        stored_table_node)));
+
+  const auto expected_lqp =
+  PredicateNode::make(greater_than_(c, 5),
+    PredicateNode::make(and_(equals_(a, 2), equals_(b, 3)),
+      stored_table_node));
+  // clang-format on
+
+  const auto actual_lqp = StrategyBaseTest::apply_rule(rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+
+  const auto index_scan_node = std::static_pointer_cast<PredicateNode>(actual_lqp->left_input());
+  EXPECT_EQ(index_scan_node->scan_type, ScanType::IndexScan);
+  EXPECT_EQ(std::static_pointer_cast<PredicateNode>(actual_lqp)->scan_type, ScanType::TableScan);
+}
+
+TEST_F(IndexScanRuleTest, TableHashIndexRequiresAllKeyColumns) {
+  table->create_table_hash_index({ColumnID{0}, ColumnID{1}});
+
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(equals_(b, 3),
+    PredicateNode::make(greater_than_(a, 2),
+      stored_table_node));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = StrategyBaseTest::apply_rule(rule, input_lqp);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+  EXPECT_EQ(std::static_pointer_cast<PredicateNode>(actual_lqp)->scan_type, ScanType::TableScan);
+}
+
+TEST_F(IndexScanRuleTest, TableHashIndexJoin) {
+  table->create_table_hash_index({ColumnID{0}});
+  generate_mock_statistics(1'000'000);
+
+  const auto probe_node = create_mock_node_with_statistics({{DataType::Int, "x"}}, 10,
+                                                           {GenericHistogram<int32_t>::with_single_bin(0, 20, 10, 10)});
+  const auto x = probe_node->get_column("x");
+
+  const auto join_node =
+      JoinNode::make(JoinMode::Inner, equals_(x, a), probe_node, ValidateNode::make(stored_table_node));
+  StrategyBaseTest::apply_rule(rule, join_node);
+  EXPECT_EQ(join_node->table_hash_index_side, IndexSide::Right);
+
+  // If the probe side is larger than the index side, a regular join is used
+  const auto large_probe_node = create_mock_node_with_statistics(
+      {{DataType::Int, "x"}}, 10'000'000, {GenericHistogram<int32_t>::with_single_bin(0, 20, 10'000'000, 10)});
+  const auto large_x = large_probe_node->get_column("x");
+
+  const auto join_node_2 = JoinNode::make(JoinMode::Inner, equals_(a, large_x), stored_table_node, large_probe_node);
+  StrategyBaseTest::apply_rule(rule, join_node_2);
+  EXPECT_FALSE(join_node_2->table_hash_index_side);
+
+  // Unmatched rows of the index side cannot be emitted
+  const auto right_join_node = JoinNode::make(JoinMode::Right, equals_(x, a), probe_node, stored_table_node);
+  StrategyBaseTest::apply_rule(rule, right_join_node);
+  EXPECT_FALSE(right_join_node->table_hash_index_side);
+}
+
 }  // namespace opossum
@@ -0,0 +1,84 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "../../plugins/mvcc_compaction_plugin.hpp"
+#include "../utils/plugin_test_utils.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/validate.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+#include "utils/plugin_manager.hpp"
+
+namespace opossum {
+
+class MvccCompactionPluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _table = load_table("resources/test_data/tbl/int3.tbl", 2);
+    Hyrise::get().storage_manager.add_table(_table_name, _table);
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  static void _compaction_loop() {
+    auto plugin = MvccCompactionPlugin{};
+    plugin._compaction_loop();
+  }
+
+  void _delete_rows_greater_than(const int value) {
+    const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    const auto get_table = std::make_shared<GetTable>(_table_name);
+    const auto validate = std::make_shared<Validate>(get_table);
+    const auto table_scan = create_table_scan(validate, ColumnID{0}, PredicateCondition::GreaterThan, value);
+    const auto delete_op = std::make_shared<Delete>(table_scan);
+
+    for (const auto& op : std::vector<std::shared_ptr<AbstractOperator>>{get_table, validate, table_scan, delete_op}) {
+      op->set_transaction_context(transaction_context);
+      op->execute();
+    }
+    transaction_context->commit();
+  }
+
+  const std::string _table_name{"compactionTestTable"};
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(MvccCompactionPluginTest, LoadUnloadPlugin) {
+  auto& pm = Hyrise::get().plugin_manager;
+  pm.load_plugin(build_dylib_path("libMvccCompactionPlugin"));
+  pm.unload_plugin("MvccCompactionPlugin");
+}
+
+TEST_F(MvccCompactionPluginTest, CompactChunksVisibleToAllTransactions) {
+  // The transaction still sees the row that is deleted afterwards
+  const auto old_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  _delete_rows_greater_than(2);
+
+  _compaction_loop();
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->mvcc_data()->is_compacted_and_entirely_valid());
+  EXPECT_FALSE(_table->get_chunk(ChunkID{1})->mvcc_data()->is_compacted());
+
+  old_transaction_context->commit();
+  _compaction_loop();
+  const auto mvcc_data = _table->get_chunk(ChunkID{1})->mvcc_data();
+  EXPECT_TRUE(mvcc_data->is_compacted());
+  EXPECT_NE(mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
+
+  // The rows of both chunks are still visible as before
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto get_table = std::make_shared<GetTable>(_table_name);
+  const auto validate = std::make_shared<Validate>(get_table);
+  get_table->execute();
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+  EXPECT_EQ(validate->get_output()->row_count(), 2u);
+}
+
+}  // namespace opossum
@@ -13,6 +13,8 @@
 #include "scheduler/job_task.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "scheduler/schedule_priority_scope.hpp"
+#include "scheduler/task_queue.hpp"
 
 using namespace opossum::expression_functional;  // NOLINT
 
@@ -257,4 +259,60 @@ TEST_F(SchedulerTest, SingleWorkerGuaranteeProgress) {
   Hyrise::get().scheduler()->finish();
 }
 
+TEST_F(SchedulerTest, SchedulePriorityScope) {
+  EXPECT_EQ(std::make_shared<JobTask>([]() {})->priority(), SchedulePriority::Default);
+
+  auto subtask_priority = SchedulePriority::Default;
+  auto task = std::shared_ptr<JobTask>{};
+  {
+    const auto schedule_priority_scope = SchedulePriorityScope{SchedulePriority::Low};
+    EXPECT_EQ(SchedulePriorityScope::current(), SchedulePriority::Low);
+
+    // Explicit priorities are kept
+    EXPECT_EQ(std::make_shared<JobTask>([]() {}, SchedulePriority::High)->priority(), SchedulePriority::High);
+
+    // Tasks spawned by a low-priority task are low-priority tasks as well
+    task = std::make_shared<JobTask>(
+        [&]() { subtask_priority = std::make_shared<JobTask>([]() {})->priority(); });
+  }
+  EXPECT_EQ(SchedulePriorityScope::current(), SchedulePriority::Default);
+  EXPECT_EQ(task->priority(), SchedulePriority::Low);
+
+  task->schedule();
+  EXPECT_EQ(subtask_priority, SchedulePriority::Low);
+}
+
+TEST_F(SchedulerTest, TaskQueueLowPriorityShare) {
+  auto task_queue = TaskQueue{NodeID{0}};
+
+  auto low_priority_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto default_priority_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto task_id = size_t{0}; task_id < 2 * TaskQueue::LOW_PRIORITY_SHARE; ++task_id) {
+    low_priority_tasks.emplace_back(std::make_shared<JobTask>([]() {}, SchedulePriority::Low));
+    task_queue.push(low_priority_tasks.back(), static_cast<uint32_t>(SchedulePriority::Low));
+    default_priority_tasks.emplace_back(std::make_shared<JobTask>([]() {}));
+    task_queue.push(default_priority_tasks.back(), static_cast<uint32_t>(SchedulePriority::Default));
+  }
+  const auto high_priority_task = std::make_shared<JobTask>([]() {}, SchedulePriority::High);
+  task_queue.push(high_priority_task, static_cast<uint32_t>(SchedulePriority::High));
+
+  // High-priority tasks are always pulled first
+  EXPECT_EQ(task_queue.pull(), high_priority_task);
+
+  // Low-priority tasks get one pull out of LOW_PRIORITY_SHARE while default-priority tasks are waiting
+  auto low_priority_pull_count = size_t{0};
+  for (auto pull_id = size_t{0}; pull_id < 2 * TaskQueue::LOW_PRIORITY_SHARE; ++pull_id) {
+    const auto task = task_queue.pull();
+    if (task->priority() == SchedulePriority::Low) ++low_priority_pull_count;
+  }
+  EXPECT_EQ(low_priority_pull_count, 2u);
+
+  // Once no default-priority tasks are left, low-priority tasks take all pulls
+  while (const auto task = task_queue.pull()) {
+    if (task->priority() == SchedulePriority::Low) ++low_priority_pull_count;
+  }
+  EXPECT_EQ(low_priority_pull_count, 2 * TaskQueue::LOW_PRIORITY_SHARE);
+  EXPECT_TRUE(task_queue.empty());
+}
+
 }  // namespace opossum
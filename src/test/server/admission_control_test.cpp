@@ -0,0 +1,57 @@
+#include <thread>
+
+#include "base_test.hpp"
+
+#include "server/admission_control.hpp"
+
+namespace opossum {
+
+class AdmissionControlTest : public BaseTest {};
+
+TEST_F(AdmissionControlTest, UnlimitedByDefault) {
+  auto admission_control = AdmissionControl{};
+  {
+    const auto admission_a = AdmissionControl::Admission{admission_control, WorkloadClass::Analytical};
+    const auto admission_b = AdmissionControl::Admission{admission_control, WorkloadClass::Analytical};
+    const auto admission_c = AdmissionControl::Admission{admission_control, WorkloadClass::Transactional};
+    EXPECT_EQ(admission_control.running_count(WorkloadClass::Analytical), 2u);
+    EXPECT_EQ(admission_control.running_count(WorkloadClass::Transactional), 1u);
+  }
+  EXPECT_EQ(admission_control.running_count(WorkloadClass::Analytical), 0u);
+  EXPECT_EQ(admission_control.running_count(WorkloadClass::Transactional), 0u);
+}
+
+TEST_F(AdmissionControlTest, QueueAtLimit) {
+  Hyrise::get().settings_manager.get_setting(AdmissionControl::MAX_CONCURRENT_ANALYTICAL_SETTING_NAME)->set("1");
+
+  auto admission_control = AdmissionControl{};
+  auto second_admitted = std::atomic_bool{false};
+  auto waiting_thread = std::thread{};
+  {
+    const auto admission = AdmissionControl::Admission{admission_control, WorkloadClass::Analytical};
+
+    waiting_thread = std::thread{[&]() {
+      const auto second_admission = AdmissionControl::Admission{admission_control, WorkloadClass::Analytical};
+      second_admitted = true;
+    }};
+
+    while (admission_control.waiting_count(WorkloadClass::Analytical) == 0) std::this_thread::yield();
+    EXPECT_FALSE(second_admitted);
+
+    // Other workload classes are not affected by the limit
+    const auto transactional_admission = AdmissionControl::Admission{admission_control, WorkloadClass::Transactional};
+    EXPECT_EQ(admission_control.running_count(WorkloadClass::Transactional), 1u);
+  }
+
+  waiting_thread.join();
+  EXPECT_TRUE(second_admitted);
+  EXPECT_EQ(admission_control.waiting_count(WorkloadClass::Analytical), 0u);
+  EXPECT_EQ(admission_control.running_count(WorkloadClass::Analytical), 0u);
+}
+
+TEST_F(AdmissionControlTest, SchedulePriority) {
+  EXPECT_EQ(AdmissionControl::schedule_priority(WorkloadClass::Transactional), SchedulePriority::Default);
+  EXPECT_EQ(AdmissionControl::schedule_priority(WorkloadClass::Analytical), SchedulePriority::Low);
+}
+
+}  // namespace opossum
@@ -23,18 +23,34 @@ TEST_F(PostgresProtocolHandlerTest, ReadStartupMessage) {
   // No SSL request, just length (8 Byte) and no SSL (0)
   // Values must be converted to network byte order
   _mocked_socket->write(std::string{'\0', '\0', '\0', '\b', '\0', '\0', '\0', '\0'});
-  EXPECT_EQ(_protocol_handler->read_startup_packet_header(), 0);
+  EXPECT_EQ(_protocol_handler->read_startup_packet_header().body_length, 0);
 
   // SSL request contains length (8 B) and SSL request code 80877103
   _mocked_socket->write(std::string{'\0', '\0', '\0', '\b', '\x04', '\xd2', '\x16', '\x2f'});
   // Server will wait for new message with authentication details. Message contains length (12 B), protocol (0) and
   // body (4 B). No body provided here, since we throw it away anyway.
   _mocked_socket->write(std::string{'\0', '\0', '\0', '\f', '\0', '\0', '\0', '\0'});
-  EXPECT_EQ(_protocol_handler->read_startup_packet_header(), 4);
+  const auto startup_packet_header = _protocol_handler->read_startup_packet_header();
+  EXPECT_EQ(startup_packet_header.body_length, 4u);
+  EXPECT_FALSE(startup_packet_header.is_cancel_request);
   const std::string file_content = _mocked_socket->read();
   EXPECT_EQ(file_content.back(), 'N');
 }
 
+TEST_F(PostgresProtocolHandlerTest, ReadCancelRequest) {
+  // Length (16 B), cancel request code 80877102, process id 7, and secret key 258
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x10', '\x04', '\xd2', '\x16', '\x2e'});
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x07', '\0', '\0', '\x01', '\x02'});
+
+  const auto startup_packet_header = _protocol_handler->read_startup_packet_header();
+  EXPECT_TRUE(startup_packet_header.is_cancel_request);
+  EXPECT_EQ(startup_packet_header.body_length, 8u);
+
+  const auto backend_key_data = _protocol_handler->read_cancel_request_body();
+  EXPECT_EQ(backend_key_data.process_id, 7);
+  EXPECT_EQ(backend_key_data.secret_key, 258);
+}
+
 TEST_F(PostgresProtocolHandlerTest, DiscardStartupPacketBody) {
   // Write string including type of new packet, discard them, and see if packet type get correctly detected
   const std::string content = "garbageQ";
@@ -43,6 +59,17 @@ TEST_F(PostgresProtocolHandlerTest, DiscardStartupPacketBody) {
   EXPECT_EQ(_protocol_handler->read_packet_type(), PostgresMessageType::SimpleQueryCommand);
 }
 
+TEST_F(PostgresProtocolHandlerTest, SendBackendKeyData) {
+  _protocol_handler->send_backend_key_data({7, 258});
+  _protocol_handler->force_flush();
+  const std::string file_content = _mocked_socket->read();
+
+  EXPECT_EQ(static_cast<PostgresMessageType>(file_content.front()), PostgresMessageType::BackendKeyData);
+  EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + 1), 12u);
+  EXPECT_EQ(file_content.size(), 13u);
+  EXPECT_EQ(file_content.substr(5), (std::string{'\0', '\0', '\0', '\x07', '\0', '\0', '\x01', '\x02'}));
+}
+
 TEST_F(PostgresProtocolHandlerTest, SendAuthenticationResponse) {
   _protocol_handler->send_authentication_response();
   _protocol_handler->force_flush();
@@ -261,10 +288,34 @@ TEST_F(PostgresProtocolHandlerTest, ReadExecutePacket) {
   EXPECT_EQ(_protocol_handler->read_execute_packet(), portal_name);
 }
 
+TEST_F(PostgresProtocolHandlerTest, SendCopyInResponse) {
+  _protocol_handler->send_copy_in_response(2);
+  const std::string file_content = _mocked_socket->read();
+
+  // Type, length, overall format, column count, and one format code per column
+  EXPECT_EQ(static_cast<PostgresMessageType>(file_content.front()), PostgresMessageType::CopyInResponse);
+  EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + 1), file_content.size() - 1);
+  EXPECT_EQ(file_content.size(), 1u + 4u + 1u + 2u + 2u * 2u);
+}
+
+TEST_F(PostgresProtocolHandlerTest, ReadCopyPackets) {
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x0a'});
+  _mocked_socket->write("1,a\n2,");
+  EXPECT_EQ(_protocol_handler->read_copy_data_packet(), "1,a\n2,");
+
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x04'});
+  EXPECT_NO_THROW(_protocol_handler->read_copy_done_packet());
+
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x0a'});
+  _mocked_socket->write(std::string{"abort\0", 6});
+  EXPECT_EQ(_protocol_handler->read_copy_fail_packet(), "abort");
+}
+
 TEST_F(PostgresProtocolHandlerTest, SendErrorMessage) {
   const std::string error_description = "error";
   const auto error_message = ErrorMessage{{PostgresMessageType::HumanReadableError, error_description}};
   _protocol_handler->send_error_message(error_message);
+  _protocol_handler->force_flush();
   const std::string file_content = _mocked_socket->read();
 
   auto start = 0;
@@ -1,6 +1,13 @@
 #include "base_test.hpp"
 
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
 #include "server/query_handler.hpp"
+#include "storage/index/group_key/group_key_index.hpp"
+#include "storage/prepared_plan.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
 
 namespace opossum {
 
@@ -35,14 +42,17 @@ TEST_F(QueryHandlerTest, BindParameters) {
   QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a > ?");
   const auto specification = PreparedStatementDetails{"test_statement", "", {123}};
 
-  const auto result = QueryHandler::bind_prepared_plan(specification);
+  auto prepared_pqps = PreparedPQPCache{};
+
+  const auto result = QueryHandler::bind_prepared_plan(specification, prepared_pqps);
   EXPECT_EQ(result->type(), OperatorType::TableScan);
 }
 
 TEST_F(QueryHandlerTest, ExecutePreparedStatement) {
   QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a > ?");
   const auto specification = PreparedStatementDetails{"test_statement", "", {123}};
-  const auto pqp = QueryHandler::bind_prepared_plan(specification);
+  auto prepared_pqps = PreparedPQPCache{};
+  const auto pqp = QueryHandler::bind_prepared_plan(specification, prepared_pqps);
 
   auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
   pqp->set_transaction_context_recursively(transaction_context);
@@ -52,6 +62,59 @@ TEST_F(QueryHandlerTest, ExecutePreparedStatement) {
   EXPECT_EQ(result_table->column_count(), 2u);
 }
 
+TEST_F(QueryHandlerTest, CachePreparedPQP) {
+  QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a > ?");
+  auto prepared_pqps = PreparedPQPCache{};
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  // The statement is translated on the first Bind only. Every Bind receives its own copy of the PQP template.
+  const auto pqp_a = QueryHandler::bind_prepared_plan({"test_statement", "", {123}}, prepared_pqps);
+  ASSERT_EQ(prepared_pqps.size(), 1u);
+  const auto pqp_template = prepared_pqps.at("test_statement").pqp_template;
+
+  const auto pqp_b = QueryHandler::bind_prepared_plan({"test_statement", "", {12344}}, prepared_pqps);
+  EXPECT_EQ(prepared_pqps.at("test_statement").pqp_template, pqp_template);
+  EXPECT_NE(pqp_a, pqp_b);
+  EXPECT_NE(pqp_a, pqp_template);
+
+  pqp_a->set_transaction_context_recursively(transaction_context);
+  pqp_b->set_transaction_context_recursively(transaction_context);
+  EXPECT_EQ(QueryHandler::execute_prepared_plan(pqp_a)->row_count(), 2u);
+  EXPECT_EQ(QueryHandler::execute_prepared_plan(pqp_b)->row_count(), 1u);
+
+  EXPECT_THROW(QueryHandler::bind_prepared_plan({"test_statement", "", {1, 2}}, prepared_pqps), InvalidInputException);
+
+  // Redefining the statement invalidates the cached PQP
+  Hyrise::get().storage_manager.drop_prepared_plan("test_statement");
+  QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a < ?");
+  const auto pqp_c = QueryHandler::bind_prepared_plan({"test_statement", "", {12344}}, prepared_pqps);
+  EXPECT_NE(prepared_pqps.at("test_statement").pqp_template, pqp_template);
+
+  pqp_c->set_transaction_context_recursively(transaction_context);
+  EXPECT_EQ(QueryHandler::execute_prepared_plan(pqp_c)->row_count(), 2u);
+}
+
+TEST_F(QueryHandlerTest, BindPreparedPlanWithIndexScan) {
+  const auto table_a = Hyrise::get().storage_manager.get_table("table_a");
+  table_a->create_index<GroupKeyIndex>({ColumnID{0}}, "i_a");
+
+  // The IndexScanRule marks predicates with placeholders on indexed columns, too
+  const auto stored_table_node = StoredTableNode::make("table_a");
+  const auto predicate_node =
+      PredicateNode::make(greater_than_(stored_table_node->get_column("a"), placeholder_(ParameterID{0})),
+                          stored_table_node);
+  predicate_node->scan_type = ScanType::IndexScan;
+  Hyrise::get().storage_manager.add_prepared_plan(
+      "index_statement", std::make_shared<PreparedPlan>(predicate_node, std::vector{ParameterID{0}}));
+
+  auto prepared_pqps = PreparedPQPCache{};
+  const auto pqp = QueryHandler::bind_prepared_plan({"index_statement", "", {123}}, prepared_pqps);
+
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
+  pqp->set_transaction_context_recursively(transaction_context);
+  EXPECT_EQ(QueryHandler::execute_prepared_plan(pqp)->row_count(), 2u);
+}
+
 TEST_F(QueryHandlerTest, CorrectlyInvalidateStatements) {
   QueryHandler::setup_prepared_plan("", "SELECT * FROM table_a WHERE a > ?");
   const auto old_plan = Hyrise::get().storage_manager.get_prepared_plan("");
@@ -69,4 +132,85 @@ TEST_F(QueryHandlerTest, CorrectlyInvalidateStatements) {
   EXPECT_FALSE(Hyrise::get().storage_manager.has_prepared_plan(""));
 }
 
+TEST_F(QueryHandlerTest, ParseCopyFromStdinStatement) {
+  EXPECT_FALSE(QueryHandler::parse_copy_from_stdin_statement("SELECT 1;"));
+  EXPECT_FALSE(QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM 'file.csv';"));
+
+  const auto text = QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM STDIN;");
+  ASSERT_TRUE(text);
+  EXPECT_EQ(text->table_name, "table_a");
+  EXPECT_TRUE(text->parse_config.postgres_text_format);
+  EXPECT_EQ(text->parse_config.separator, '\t');
+  EXPECT_FALSE(text->header);
+
+  const auto csv = QueryHandler::parse_copy_from_stdin_statement(
+      "copy table_a from stdin with (format csv, delimiter ',', header true, quote '''')");
+  ASSERT_TRUE(csv);
+  EXPECT_FALSE(csv->parse_config.postgres_text_format);
+  EXPECT_EQ(csv->parse_config.separator, ',');
+  EXPECT_EQ(csv->parse_config.quote, '\'');
+  EXPECT_EQ(csv->parse_config.escape, '\'');
+  EXPECT_TRUE(csv->header);
+
+  const auto legacy_csv =
+      QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM STDIN DELIMITER AS '|' CSV HEADER");
+  ASSERT_TRUE(legacy_csv);
+  EXPECT_FALSE(legacy_csv->parse_config.postgres_text_format);
+  EXPECT_EQ(legacy_csv->parse_config.separator, '|');
+  EXPECT_TRUE(legacy_csv->header);
+
+  EXPECT_THROW(QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM STDIN (FORMAT binary)"),
+               InvalidInputException);
+  EXPECT_THROW(QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM STDIN (QUOTE '\"')"),
+               InvalidInputException);
+  EXPECT_THROW(QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM STDIN (FREEZE)"),
+               InvalidInputException);
+}
+
+TEST_F(QueryHandlerTest, CopyRowsIntoTable) {
+  const auto copy_information = QueryHandler::parse_copy_from_stdin_statement("COPY table_a FROM STDIN (FORMAT csv)");
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  EXPECT_EQ(QueryHandler::copy_rows_into_table("1,1.5\n2,\"2.5\"\n", *copy_information, transaction_context), 2u);
+  EXPECT_EQ(QueryHandler::copy_rows_into_table("", *copy_information, transaction_context), 0u);
+  transaction_context->commit();
+
+  const auto [execution_information, _] =
+      QueryHandler::execute_pipeline("SELECT * FROM table_a WHERE a < 100", SendExecutionInfo::No, nullptr);
+  const auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Float, false}}, TableType::Data);
+  expected_table->append({1, 1.5f});
+  expected_table->append({2, 2.5f});
+  EXPECT_TABLE_EQ_UNORDERED(execution_information.result_table, expected_table);
+}
+
+TEST_F(QueryHandlerTest, ParseWorkloadClassStatement) {
+  EXPECT_FALSE(QueryHandler::parse_workload_class_statement("SELECT 1;"));
+  EXPECT_FALSE(QueryHandler::parse_workload_class_statement("SET search_path TO public;"));
+
+  const auto analytical = QueryHandler::parse_workload_class_statement("SET workload_class TO analytical;");
+  ASSERT_TRUE(analytical);
+  EXPECT_EQ(analytical->workload_class, WorkloadClass::Analytical);
+
+  const auto quoted = QueryHandler::parse_workload_class_statement("set session workload_class = 'transactional'");
+  ASSERT_TRUE(quoted);
+  EXPECT_EQ(quoted->workload_class, WorkloadClass::Transactional);
+
+  const auto reset = QueryHandler::parse_workload_class_statement("SET workload_class TO DEFAULT");
+  ASSERT_TRUE(reset);
+  EXPECT_FALSE(reset->workload_class);
+
+  EXPECT_THROW(QueryHandler::parse_workload_class_statement("SET workload_class TO batch"), InvalidInputException);
+}
+
+TEST_F(QueryHandlerTest, ClassifyStatement) {
+  EXPECT_EQ(QueryHandler::classify_statement("SELECT * FROM table_a", false), WorkloadClass::Analytical);
+  EXPECT_EQ(QueryHandler::classify_statement(" (select 1)", false), WorkloadClass::Analytical);
+  EXPECT_EQ(QueryHandler::classify_statement("WITH t AS (SELECT 1) SELECT * FROM t", false),
+            WorkloadClass::Analytical);
+  EXPECT_EQ(QueryHandler::classify_statement("INSERT INTO table_a VALUES (1, 1.0)", false),
+            WorkloadClass::Transactional);
+  EXPECT_EQ(QueryHandler::classify_statement("SELECT * FROM table_a", true), WorkloadClass::Transactional);
+}
+
 }  // namespace opossum
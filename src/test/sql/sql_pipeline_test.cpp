@@ -7,6 +7,7 @@
 #include "SQLParser.h"
 #include "SQLParserResult.h"
 
+#include "concurrency/cancellation_token.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/join_node.hpp"
 #include "operators/abstract_join_operator.hpp"
@@ -452,6 +453,27 @@ TEST_F(SQLPipelineTest, UpdateWithTransactionFailure) {
   EXPECT_EQ(second_chunk_mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
 }
 
+TEST_F(SQLPipelineTest, CancelledStatementRollsBack) {
+  const auto cancellation_token = std::make_shared<CancellationToken>();
+  cancellation_token->cancel(CancellationReason::User);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto sql_pipeline = SQLPipelineBuilder{"UPDATE table_a SET a = 1 WHERE a = 123"}
+                          .with_transaction_context(transaction_context)
+                          .with_cancellation_token(cancellation_token)
+                          .create_pipeline();
+
+  const auto [pipeline_status, tables] = sql_pipeline.get_result_tables();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Failure);
+  EXPECT_EQ(sql_pipeline.failed_pipeline_statement()->cancellation_token(), cancellation_token);
+  EXPECT_TRUE(transaction_context->aborted());
+
+  // No row should have been touched
+  const auto mvcc_data = _table_a->get_chunk(ChunkID{0})->mvcc_data();
+  EXPECT_EQ(mvcc_data->get_tid(1), TransactionID{0});
+  EXPECT_EQ(mvcc_data->get_end_cid(1), MvccData::MAX_COMMIT_ID);
+}
+
 TEST_F(SQLPipelineTest, UpdateWithTransactionFailureAutoCommit) {
   // Similar to UpdateWithTransactionFailure, but without explicit transaction context
 
@@ -485,6 +507,71 @@ TEST_F(SQLPipelineTest, UpdateWithTransactionFailureAutoCommit) {
   EXPECT_EQ(second_chunk_mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
 }
 
+TEST_F(SQLPipelineTest, ReadOnlyTransaction) {
+  auto sql_pipeline = SQLPipelineBuilder{"BEGIN READ ONLY; SELECT * FROM table_a;"}.create_pipeline();
+
+  const auto& [pipeline_status, tables] = sql_pipeline.get_result_tables();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+  EXPECT_TABLE_EQ_UNORDERED(tables.back(), _table_a);
+  EXPECT_EQ(sql_pipeline.get_sql_per_statement().front(), "BEGIN READ ONLY;");
+
+  const auto transaction_context = sql_pipeline.transaction_context();
+  ASSERT_TRUE(transaction_context);
+  EXPECT_TRUE(transaction_context->is_read_only());
+  EXPECT_EQ(transaction_context->transaction_id(), INVALID_TRANSACTION_ID);
+
+  auto insert_pipeline = SQLPipelineBuilder{"INSERT INTO table_a VALUES (11, 11.11);"}
+                             .with_transaction_context(transaction_context)
+                             .create_pipeline();
+  EXPECT_THROW(insert_pipeline.get_result_table(), InvalidInputException);
+
+  auto commit_pipeline = SQLPipelineBuilder{"COMMIT;"}.with_transaction_context(transaction_context).create_pipeline();
+  EXPECT_EQ(commit_pipeline.get_result_table().first, SQLPipelineStatus::Success);
+  EXPECT_EQ(transaction_context->phase(), TransactionPhase::Committed);
+  EXPECT_EQ(_table_a->row_count(), 3);
+}
+
+TEST_F(SQLPipelineTest, ReadOnlyTransactionMode) {
+  auto select_pipeline =
+      SQLPipelineBuilder{_select_query_a}.with_transaction_mode(TransactionMode::ReadOnly).create_pipeline();
+  const auto& [pipeline_status, table] = select_pipeline.get_result_table();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+  EXPECT_TABLE_EQ_UNORDERED(table, _table_a);
+
+  auto update_pipeline =
+      SQLPipelineBuilder{"UPDATE table_a SET a = 1"}.with_transaction_mode(TransactionMode::ReadOnly).create_pipeline();
+  EXPECT_THROW(update_pipeline.get_result_table(), InvalidInputException);
+
+  // Transactions started by BEGIN are read-only, too
+  auto begin_pipeline =
+      SQLPipelineBuilder{"BEGIN TRANSACTION;"}.with_transaction_mode(TransactionMode::ReadOnly).create_pipeline();
+  EXPECT_EQ(begin_pipeline.get_result_table().first, SQLPipelineStatus::Success);
+  EXPECT_TRUE(begin_pipeline.transaction_context()->is_read_only());
+  begin_pipeline.transaction_context()->commit();
+}
+
+TEST_F(SQLPipelineTest, MaskReadOnlyModifiers) {
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("SELECT * FROM table_a"), std::nullopt);
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("BEGIN; SELECT 'read only'"), std::nullopt);
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("BEGIN READ ONLY; SELECT 1;"), "BEGIN          ; SELECT 1;");
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("begin transaction read\nonly;"),
+            "begin transaction          ;");
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("SELECT 1; -- x\n BEGIN READ ONLY;"),
+            "SELECT 1; -- x\n BEGIN          ;");
+
+  // Quoted text and comments are left as they are
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("SELECT ' BEGIN READ ONLY' AS \"BEGIN READ ONLY\""),
+            std::nullopt);
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("SELECT 'it''s'; SELECT '; BEGIN READ ONLY'"), std::nullopt);
+  EXPECT_EQ(SQLPipelineStatement::mask_read_only_modifiers("-- BEGIN READ ONLY\nSELECT 1"), std::nullopt);
+
+  // A statement with a literal that looks like the modifier is not altered and runs outside of a read-only transaction
+  auto sql_pipeline = SQLPipelineBuilder{"SELECT 'begin read only' AS a"}.create_pipeline();
+  const auto [pipeline_status, table] = sql_pipeline.get_result_table();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+  EXPECT_EQ(table->get_value<pmr_string>(ColumnID{0}, 0), "begin read only");
+}
+
 TEST_F(SQLPipelineTest, GetTimes) {
   auto sql_pipeline = SQLPipelineBuilder{_select_query_a}.create_pipeline();
 
@@ -28,6 +28,7 @@
 #include "logical_query_plan/validate_node.hpp"
 #include "statistics/attribute_statistics.hpp"
 #include "statistics/cardinality_estimator.hpp"
+#include "statistics/column_pair_statistics.hpp"
 #include "statistics/statistics_objects/equal_distinct_count_histogram.hpp"
 #include "statistics/statistics_objects/generic_histogram.hpp"
 #include "statistics/table_statistics.hpp"
@@ -164,6 +165,25 @@ TEST_F(CardinalityEstimatorTest, Aggregate) {
   EXPECT_TRUE(result_table_statistics->column_statistics.at(2));
 }
 
+TEST_F(CardinalityEstimatorTest, AggregateGroupCount) {
+  // The number of groups is bounded by the distinct counts of the group-by columns and by the input row count
+  const auto group_by_a = AggregateNode::make(expression_vector(a_a), expression_vector(sum_(a_b)), node_a);
+  const auto group_by_a_statistics = estimator.estimate_statistics(group_by_a);
+  EXPECT_FLOAT_EQ(group_by_a_statistics->row_count, 10.0f);
+
+  // The statistics of the group-by column are scaled down to one row per group
+  const auto a_statistics = std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(
+      group_by_a_statistics->column_statistics.at(0));
+  ASSERT_TRUE(a_statistics && a_statistics->histogram);
+  EXPECT_FLOAT_EQ(a_statistics->histogram->total_count(), 10.0f);
+
+  const auto group_by_a_b = AggregateNode::make(expression_vector(a_a, a_b), expression_vector(), node_a);
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(group_by_a_b), 100.0f);
+
+  const auto no_group_by = AggregateNode::make(expression_vector(), expression_vector(sum_(a_b)), node_a);
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(no_group_by), 1.0f);
+}
+
 TEST_F(CardinalityEstimatorTest, Alias) {
   // clang-format off
   const auto input_lqp =
@@ -846,6 +866,93 @@ TEST_F(CardinalityEstimatorTest, StoredTable) {
   EXPECT_EQ(estimator.estimate_cardinality(StoredTableNode::make("t")), 3);
 }
 
+TEST_F(CardinalityEstimatorTest, StoredTableCorrelatedPredicates) {
+  // Column a has 100 distinct values, each occurring 10 times. Column b = a / 10, i.e., a determines b.
+  const auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}}, TableType::Data, 100,
+      UseMvcc::Yes);
+  for (auto row_id = int32_t{0}; row_id < 1000; ++row_id) {
+    table->append({row_id % 100, row_id % 100 / 10});
+  }
+  Hyrise::get().storage_manager.add_table("t", table);
+
+  const auto stored_table_node = StoredTableNode::make("t");
+  const auto a = stored_table_node->get_column("a");
+  const auto b = stored_table_node->get_column("b");
+
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(equals_(b, 3),
+    ValidateNode::make(
+      PredicateNode::make(equals_(a, 35),
+        stored_table_node)));
+  // clang-format on
+
+  // Without ColumnPairStatistics, the predicates are assumed to be independent
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(input_lqp), 1.0f);
+
+  add_column_pair_statistics(*table, {{ColumnID{0}, ColumnID{1}}});
+  EXPECT_FLOAT_EQ(estimator.new_instance()->estimate_cardinality(input_lqp), 10.0f);
+}
+
+TEST_F(CardinalityEstimatorTest, StoredTableForeignKeyJoin) {
+  // String join columns cannot be estimated with histograms, so that the estimation relies on the unique constraint
+  const auto primary_key_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"id", DataType::String, false}, {"v", DataType::Int, false}}, TableType::Data, 100,
+      UseMvcc::Yes);
+  for (auto row_id = int32_t{0}; row_id < 100; ++row_id) {
+    primary_key_table->append({pmr_string{"k" + std::to_string(row_id)}, row_id % 2});
+  }
+  primary_key_table->add_soft_unique_constraint({ColumnID{0}}, IsPrimaryKey::Yes);
+  Hyrise::get().storage_manager.add_table("primary_key_table", primary_key_table);
+
+  const auto foreign_key_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"ref", DataType::String, false}}, TableType::Data, 100,
+                              UseMvcc::Yes);
+  for (auto row_id = int32_t{0}; row_id < 1000; ++row_id) {
+    foreign_key_table->append({pmr_string{"k" + std::to_string(row_id % 100)}});
+  }
+  Hyrise::get().storage_manager.add_table("foreign_key_table", foreign_key_table);
+
+  const auto primary_key_node = StoredTableNode::make("primary_key_table");
+  const auto foreign_key_node = StoredTableNode::make("foreign_key_table");
+  const auto id = primary_key_node->get_column("id");
+  const auto v = primary_key_node->get_column("v");
+  const auto ref = foreign_key_node->get_column("ref");
+
+  // clang-format off
+  const auto inner_join_lqp =
+  JoinNode::make(JoinMode::Inner, equals_(ref, id),
+    foreign_key_node,
+    PredicateNode::make(equals_(v, 0),
+      primary_key_node));
+  // clang-format on
+
+  // Half of the primary keys remain, so half of the foreign keys find a join partner
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(inner_join_lqp), 500.0f);
+
+  // Left outer joins keep all rows of the left input
+  const auto left_join_lqp =
+      JoinNode::make(JoinMode::Left, equals_(ref, id), foreign_key_node, inner_join_lqp->right_input());
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(left_join_lqp), 50'000.0f);
+
+  // After a join with foreign keys, the primary keys are not unique anymore
+  const auto other_foreign_key_node = StoredTableNode::make("foreign_key_table");
+  const auto other_ref = other_foreign_key_node->get_column("ref");
+
+  // clang-format off
+  const auto duplicated_primary_key_lqp =
+  JoinNode::make(JoinMode::Inner, equals_(ref, id),
+    foreign_key_node,
+    JoinNode::make(JoinMode::Inner, equals_(id, other_ref),
+      primary_key_node,
+      other_foreign_key_node));
+  // clang-format on
+
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(duplicated_primary_key_lqp->right_input()), 1'000.0f);
+  EXPECT_FLOAT_EQ(estimator.estimate_cardinality(duplicated_primary_key_lqp), 1'000'000.0f);
+}
+
 TEST_F(CardinalityEstimatorTest, Validate) {
   // Test Validate doesn't break the TableStatistics. The CardinalityEstimator is not estimating anything for Validate
   // as there are no statistics available atm to base such an estimation on.
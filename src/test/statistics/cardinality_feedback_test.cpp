@@ -0,0 +1,84 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "statistics/cardinality_feedback.hpp"
+#include "statistics/table_statistics.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class CardinalityFeedbackTest : public BaseTest {
+ public:
+  void SetUp() override {
+    Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_int.tbl"));
+    Hyrise::get().storage_manager.add_table("table_b", load_table("resources/test_data/tbl/int_int.tbl"));
+
+    node_a = StoredTableNode::make("table_a");
+    node_b = StoredTableNode::make("table_b");
+    a_a = node_a->get_column("a");
+    b_a = node_b->get_column("a");
+  }
+
+  std::shared_ptr<StoredTableNode> node_a, node_b;
+  LQPColumnReference a_a, b_a;
+};
+
+TEST_F(CardinalityFeedbackTest, RecordAndLookup) {
+  const auto lqp = JoinNode::make(JoinMode::Inner, equals_(a_a, b_a), node_a, node_b);
+
+  auto feedback = CardinalityFeedback{};
+  EXPECT_TRUE(feedback.empty());
+  EXPECT_EQ(feedback.lookup(lqp), std::nullopt);
+
+  feedback.record(lqp, 1234.0f);
+  EXPECT_FALSE(feedback.empty());
+
+  // Lookups are based on the structure of the LQP, not on the node instances
+  EXPECT_EQ(feedback.lookup(lqp->deep_copy()), 1234.0f);
+  EXPECT_EQ(feedback.lookup(JoinNode::make(JoinMode::Inner, equals_(a_a, b_a), node_b, node_a)), std::nullopt);
+
+  feedback.record(lqp, 42.0f);
+  EXPECT_EQ(feedback.lookup(lqp), 42.0f);
+
+  feedback.clear();
+  EXPECT_TRUE(feedback.empty());
+  EXPECT_EQ(feedback.lookup(lqp), std::nullopt);
+}
+
+TEST_F(CardinalityFeedbackTest, IsRecordable) {
+  EXPECT_TRUE(CardinalityFeedback::is_recordable(*JoinNode::make(JoinMode::Inner, equals_(a_a, b_a), node_a, node_b)));
+  EXPECT_FALSE(CardinalityFeedback::is_recordable(*PredicateNode::make(greater_than_(a_a, 0), node_a)));
+  EXPECT_FALSE(CardinalityFeedback::is_recordable(*node_a));
+}
+
+TEST_F(CardinalityFeedbackTest, UsedByCardinalityEstimator) {
+  // clang-format off
+  const auto lqp =
+  PredicateNode::make(greater_than_(a_a, 0),
+    JoinNode::make(JoinMode::Inner, equals_(a_a, b_a),
+      node_a,
+      node_b));
+  // clang-format on
+
+  const auto estimated_row_count = CardinalityEstimator{}.estimate_cardinality(lqp->left_input());
+  const auto estimated_predicate_row_count = CardinalityEstimator{}.estimate_cardinality(lqp);
+  ASSERT_GT(estimated_row_count, 0.0f);
+
+  Hyrise::get().cardinality_feedback->record(lqp->left_input()->deep_copy(), estimated_row_count * 10.0f);
+
+  EXPECT_FLOAT_EQ(CardinalityEstimator{}.estimate_cardinality(lqp->left_input()), estimated_row_count * 10.0f);
+
+  // The estimates of the nodes above build on the observed row count
+  EXPECT_NEAR(CardinalityEstimator{}.estimate_cardinality(lqp), estimated_predicate_row_count * 10.0f,
+              estimated_predicate_row_count * 0.01f);
+}
+
+}  // namespace opossum
@@ -0,0 +1,77 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "statistics/column_pair_statistics.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class ColumnPairStatisticsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // a has 100 distinct values, b = a / 10 has 10, c is independent of a and b, and d is NULL for some values of a
+    table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false},
+                                                           {"b", DataType::Int, false},
+                                                           {"c", DataType::Int, false},
+                                                           {"d", DataType::String, true}},
+                                    TableType::Data, 100, UseMvcc::Yes);
+    for (auto row_id = int32_t{0}; row_id < 1000; ++row_id) {
+      const auto a = row_id % 100;
+      const auto d = a < 50 ? AllTypeVariant{pmr_string{"x"}} : NULL_VALUE;
+      table->append({a, a / 10, row_id % 7, d});
+    }
+  }
+
+  std::shared_ptr<Table> table;
+};
+
+TEST_F(ColumnPairStatisticsTest, FromTable) {
+  const auto dependent_statistics = ColumnPairStatistics::from_table(*table, ColumnID{0}, ColumnID{1});
+  EXPECT_EQ(dependent_statistics->first_column_id, ColumnID{0});
+  EXPECT_EQ(dependent_statistics->second_column_id, ColumnID{1});
+  EXPECT_FLOAT_EQ(dependent_statistics->first_determines_second, 1.0f);
+  EXPECT_FLOAT_EQ(dependent_statistics->second_determines_first, 0.0f);
+
+  const auto independent_statistics = ColumnPairStatistics::from_table(*table, ColumnID{0}, ColumnID{2});
+  EXPECT_FLOAT_EQ(independent_statistics->first_determines_second, 0.0f);
+  EXPECT_FLOAT_EQ(independent_statistics->second_determines_first, 0.0f);
+
+  // Rows with NULLs are ignored, the remaining rows have a single value of d
+  const auto nullable_statistics = ColumnPairStatistics::from_table(*table, ColumnID{3}, ColumnID{0});
+  EXPECT_FLOAT_EQ(nullable_statistics->first_determines_second, 0.0f);
+  EXPECT_FLOAT_EQ(nullable_statistics->second_determines_first, 1.0f);
+}
+
+TEST_F(ColumnPairStatisticsTest, EstimateConditionalSelectivity) {
+  const auto statistics = ColumnPairStatistics{ColumnID{0}, ColumnID{1}, 1.0f, 0.5f};
+
+  // The rows that pass a predicate on the first column all pass the predicate on the second one
+  EXPECT_FLOAT_EQ(statistics.estimate_conditional_selectivity(ColumnID{1}, 0.1f, 0.01f), 1.0f);
+
+  // The conjunction is never more selective than under independence and never less selective than either predicate
+  EXPECT_FLOAT_EQ(statistics.estimate_conditional_selectivity(ColumnID{0}, 0.01f, 0.1f), 0.1f);
+  EXPECT_FLOAT_EQ(ColumnPairStatistics(ColumnID{0}, ColumnID{1}, 0.0f, 0.0f)
+                      .estimate_conditional_selectivity(ColumnID{0}, 0.2f, 0.5f),
+                  0.2f);
+}
+
+TEST_F(ColumnPairStatisticsTest, AddToTableStatistics) {
+  table->set_table_statistics(TableStatistics::from_table(*table));
+  EXPECT_FALSE(table->table_statistics()->column_pair_statistics(ColumnID{0}, ColumnID{1}));
+
+  add_column_pair_statistics(*table, {{ColumnID{0}, ColumnID{1}}});
+  const auto column_pair_statistics = table->table_statistics()->column_pair_statistics(ColumnID{1}, ColumnID{0});
+  ASSERT_TRUE(column_pair_statistics);
+  EXPECT_FLOAT_EQ(column_pair_statistics->first_determines_second, 1.0f);
+  EXPECT_EQ(table->table_statistics()->column_pair_statistics_list.size(), 1u);
+
+  // Statistics on the same pair are replaced
+  add_column_pair_statistics(*table, {{ColumnID{1}, ColumnID{0}}, {ColumnID{0}, ColumnID{2}}});
+  EXPECT_EQ(table->table_statistics()->column_pair_statistics_list.size(), 2u);
+  EXPECT_EQ(table->table_statistics()->column_pair_statistics(ColumnID{0}, ColumnID{1})->first_column_id,
+            ColumnID{1});
+}
+
+}  // namespace opossum
@@ -0,0 +1,140 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
+#include "optimizer/join_ordering/join_graph.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "statistics/join_sampling.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class JoinSamplingTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Each chunk contains every value of x exactly once, y equals x
+    for (const auto& table_name : {"table_a", "table_b"}) {
+      const auto table = std::make_shared<Table>(
+          TableColumnDefinitions{{"x", DataType::Int, false}, {"y", DataType::Int, false}}, TableType::Data, 100,
+          UseMvcc::Yes);
+      for (auto row_id = int32_t{0}; row_id < 1000; ++row_id) {
+        table->append({row_id % 100, row_id % 100});
+      }
+      Hyrise::get().storage_manager.add_table(table_name, table);
+    }
+
+    node_a = StoredTableNode::make("table_a");
+    node_b = StoredTableNode::make("table_b");
+    a_x = node_a->get_column("x");
+    a_y = node_a->get_column("y");
+    b_x = node_b->get_column("x");
+  }
+
+  std::shared_ptr<StoredTableNode> node_a, node_b;
+  LQPColumnReference a_x, a_y, b_x;
+};
+
+TEST_F(JoinSamplingTest, SampleAllRows) {
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(a_x, b_x),
+    PredicateNode::make(less_than_(a_x, 10),
+      ValidateNode::make(
+        node_a)),
+    node_b);
+  // clang-format on
+
+  EXPECT_EQ(sample_cardinality(lqp, JoinSamplingConfig{}, 1.0f), 1'000.0f);
+
+  // The original plan is not modified
+  EXPECT_EQ(lqp->left_input()->left_input()->type, LQPNodeType::Validate);
+}
+
+TEST_F(JoinSamplingTest, SampleChunks) {
+  const auto lqp = JoinNode::make(JoinMode::Inner, equals_(a_x, b_x), node_a, node_b);
+
+  auto config = JoinSamplingConfig{};
+  config.sample_row_count = 500;
+
+  // 500 rows of each table are sampled, the 2'500 result rows are scaled by a factor of four
+  EXPECT_EQ(sample_cardinality(lqp, config, 10'000.0f), 10'000.0f);
+
+  // The expected output on the sample is too large
+  config.max_sample_output_row_count = 1'000;
+  EXPECT_EQ(sample_cardinality(lqp, config, 10'000.0f), std::nullopt);
+}
+
+TEST_F(JoinSamplingTest, EmptySample) {
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(a_x, b_x),
+    PredicateNode::make(less_than_(a_x, 50),
+      node_a),
+    PredicateNode::make(greater_than_equals_(b_x, 50),
+      node_b));
+  // clang-format on
+
+  // An empty result of a sample is not used as an estimate, an empty result of all rows is
+  auto config = JoinSamplingConfig{};
+  config.sample_row_count = 500;
+  EXPECT_EQ(sample_cardinality(lqp, config, 1.0f), std::nullopt);
+  EXPECT_EQ(sample_cardinality(lqp, JoinSamplingConfig{}, 1.0f), 0.0f);
+}
+
+TEST_F(JoinSamplingTest, NotSampleable) {
+  const auto semi_join_lqp = JoinNode::make(JoinMode::Semi, equals_(a_x, b_x), node_a, node_b);
+  EXPECT_EQ(sample_cardinality(semi_join_lqp, JoinSamplingConfig{}, 1.0f), std::nullopt);
+
+  const auto aggregate_lqp = AggregateNode::make(expression_vector(a_x), expression_vector(), node_a);
+  EXPECT_EQ(sample_cardinality(aggregate_lqp, JoinSamplingConfig{}, 1.0f), std::nullopt);
+
+  const auto placeholder_lqp = PredicateNode::make(equals_(a_x, placeholder_(ParameterID{0})), node_a);
+  EXPECT_EQ(sample_cardinality(placeholder_lqp, JoinSamplingConfig{}, 1.0f), std::nullopt);
+}
+
+TEST_F(JoinSamplingTest, CardinalityEstimator) {
+  // The histograms cannot know that a predicate on y removes all join partners of table_b
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(a_x, b_x),
+    PredicateNode::make(less_than_(a_y, 50),
+      node_a),
+    PredicateNode::make(greater_than_equals_(b_x, 50),
+      node_b));
+  // clang-format on
+
+  const auto join_graph = JoinGraph::build_from_lqp(lqp);
+  ASSERT_TRUE(join_graph);
+
+  auto config = JoinSamplingConfig{};
+  config.min_vertex_count = 2;
+
+  const auto histogram_estimator = CardinalityEstimator{}.new_instance();
+  histogram_estimator->guarantee_join_graph(*join_graph);
+  EXPECT_GT(histogram_estimator->estimate_cardinality(lqp), 100.0f);
+
+  const auto sampling_estimator = CardinalityEstimator{config}.new_instance();
+  sampling_estimator->guarantee_join_graph(*join_graph);
+  EXPECT_EQ(sampling_estimator->estimate_cardinality(lqp), 0.0f);
+
+  // Small join graphs are not sampled
+  config.min_vertex_count = 3;
+  const auto small_graph_estimator = CardinalityEstimator{config}.new_instance();
+  small_graph_estimator->guarantee_join_graph(*join_graph);
+  EXPECT_GT(small_graph_estimator->estimate_cardinality(lqp), 100.0f);
+
+  // Without guarantee_join_graph(), there are no join subgraphs to cache the sampled cardinalities for
+  config.min_vertex_count = 2;
+  EXPECT_GT(CardinalityEstimator{config}.estimate_cardinality(lqp), 100.0f);
+}
+
+}  // namespace opossum
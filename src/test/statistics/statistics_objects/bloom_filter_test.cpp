@@ -0,0 +1,88 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "statistics/statistics_objects/bloom_filter.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+template <typename T>
+class BloomFilterTest : public BaseTest {
+ protected:
+  // Even values are contained, odd values are not
+  static T value(const int32_t index) {
+    if constexpr (std::is_same_v<T, pmr_string>) {
+      return pmr_string{"value" + std::to_string(index)};
+    } else {
+      return static_cast<T>(index);
+    }
+  }
+
+  void SetUp() override {
+    for (auto index = int32_t{0}; index < 2'000; index += 2) {
+      _values.emplace_back(value(index));
+    }
+  }
+
+  pmr_vector<T> _values;
+};
+
+using BloomFilterTypes = ::testing::Types<int32_t, int64_t, float, double, pmr_string>;
+TYPED_TEST_SUITE(BloomFilterTest, BloomFilterTypes, );  // NOLINT(whitespace/parens)
+
+TYPED_TEST(BloomFilterTest, NoFalseNegatives) {
+  const auto filter = BloomFilter<TypeParam>::build_filter(this->_values);
+  ASSERT_TRUE(filter);
+
+  for (const auto& value : this->_values) {
+    EXPECT_TRUE(filter->may_contain(value));
+    EXPECT_FALSE(filter->does_not_contain(PredicateCondition::Equals, AllTypeVariant{value}));
+  }
+}
+
+TYPED_TEST(BloomFilterTest, FalsePositiveRate) {
+  const auto filter = BloomFilter<TypeParam>::build_filter(this->_values);
+
+  auto false_positive_count = size_t{0};
+  for (auto index = int32_t{1}; index < 2'000; index += 2) {
+    if (filter->may_contain(this->value(index))) ++false_positive_count;
+  }
+
+  // The expected rate is about 1%. Allow for some variance.
+  EXPECT_LT(false_positive_count, this->_values.size() / 20);
+}
+
+TYPED_TEST(BloomFilterTest, OnlyEqualsIsPruned) {
+  const auto filter = BloomFilter<TypeParam>::build_filter(this->_values);
+
+  for (auto index = int32_t{1}; index < 2'000; index += 2) {
+    const auto value = AllTypeVariant{this->value(index)};
+    EXPECT_FALSE(filter->does_not_contain(PredicateCondition::LessThan, value));
+    EXPECT_FALSE(filter->does_not_contain(PredicateCondition::NotEquals, value));
+  }
+
+  EXPECT_FALSE(filter->does_not_contain(PredicateCondition::Equals, NULL_VALUE));
+}
+
+TYPED_TEST(BloomFilterTest, EmptyDictionary) {
+  EXPECT_FALSE(BloomFilter<TypeParam>::build_filter(pmr_vector<TypeParam>{}));
+}
+
+TYPED_TEST(BloomFilterTest, SlicedAndScaled) {
+  const auto filter = BloomFilter<TypeParam>::build_filter(this->_values);
+
+  const auto scaled = std::dynamic_pointer_cast<BloomFilter<TypeParam>>(filter->scaled(0.5f));
+  ASSERT_TRUE(scaled);
+  EXPECT_TRUE(scaled->may_contain(this->_values.front()));
+  EXPECT_EQ(scaled->blocks, filter->blocks);
+
+  const auto sliced = std::dynamic_pointer_cast<BloomFilter<TypeParam>>(
+      filter->sliced(PredicateCondition::Equals, AllTypeVariant{this->_values.front()}));
+  ASSERT_TRUE(sliced);
+  EXPECT_TRUE(sliced->may_contain(this->_values.front()));
+  EXPECT_EQ(sliced->blocks, filter->blocks);
+}
+
+}  // namespace opossum
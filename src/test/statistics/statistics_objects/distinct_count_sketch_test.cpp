@@ -0,0 +1,58 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "statistics/statistics_objects/distinct_count_sketch.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class DistinctCountSketchTest : public BaseTest {};
+
+TEST_F(DistinctCountSketchTest, EstimateDistinctCount) {
+  auto sketch = DistinctCountSketch<int32_t>{};
+  EXPECT_FLOAT_EQ(sketch.estimate_distinct_count(), 0.0f);
+
+  // Small distinct counts are estimated (almost) exactly
+  for (auto value = int32_t{0}; value < 10; ++value) {
+    sketch.add(value);
+    sketch.add(value);
+  }
+  EXPECT_NEAR(sketch.estimate_distinct_count(), 10.0f, 1.0f);
+
+  for (auto value = int32_t{0}; value < 100'000; ++value) {
+    sketch.add(value);
+  }
+  EXPECT_NEAR(sketch.estimate_distinct_count(), 100'000.0f, 10'000.0f);
+}
+
+TEST_F(DistinctCountSketchTest, EstimateDistinctCountString) {
+  auto sketch = DistinctCountSketch<pmr_string>{};
+  for (auto value = 0; value < 10'000; ++value) {
+    sketch.add(pmr_string{"value" + std::to_string(value % 5'000)});
+  }
+  EXPECT_NEAR(sketch.estimate_distinct_count(), 5'000.0f, 500.0f);
+}
+
+TEST_F(DistinctCountSketchTest, Merge) {
+  auto sketch_a = DistinctCountSketch<int64_t>{};
+  auto sketch_b = DistinctCountSketch<int64_t>{};
+  for (auto value = int64_t{0}; value < 20'000; ++value) {
+    sketch_a.add(value);
+    sketch_b.add(value + 10'000);
+  }
+
+  sketch_a.merge(sketch_b);
+  EXPECT_NEAR(sketch_a.estimate_distinct_count(), 30'000.0f, 3'000.0f);
+  EXPECT_NEAR(sketch_b.estimate_distinct_count(), 20'000.0f, 2'000.0f);
+}
+
+TEST_F(DistinctCountSketchTest, SlicedAndScaled) {
+  auto sketch = DistinctCountSketch<float>{};
+  sketch.add(1.0f);
+
+  EXPECT_FALSE(sketch.sliced(PredicateCondition::Equals, 1.0f));
+  EXPECT_FALSE(sketch.scaled(0.5f));
+}
+
+}  // namespace opossum
@@ -60,4 +60,25 @@ TEST_F(EqualDistinctCountHistogramTest, FromColumnFloat) {
   EXPECT_EQ(hist->bin(BinID{2}), HistogramBin<float>(3.6f, 6.1f, 4, 3));
 }
 
+TEST_F(EqualDistinctCountHistogramTest, FromDistribution) {
+  auto value_distribution = std::vector<std::pair<int32_t, HistogramCountType>>{{1, 4}, {2, 2}, {5, 1}, {7, 3}, {8, 1}};
+  const auto hist = EqualDistinctCountHistogram<int32_t>::from_distribution(std::move(value_distribution), 2u);
+
+  ASSERT_EQ(hist->bin_count(), 2u);
+  EXPECT_EQ(hist->bin(BinID{0}), HistogramBin<int32_t>(1, 5, 7, 3));
+  EXPECT_EQ(hist->bin(BinID{1}), HistogramBin<int32_t>(7, 8, 4, 2));
+
+  // A sample of the values represents 11 distinct values
+  auto sampled_value_distribution = std::vector<std::pair<int32_t, HistogramCountType>>{{1, 4}, {2, 2}, {5, 1}};
+  const auto sampled_hist =
+      EqualDistinctCountHistogram<int32_t>::from_distribution(std::move(sampled_value_distribution), 2u, 11.0f);
+
+  ASSERT_EQ(sampled_hist->bin_count(), 2u);
+  EXPECT_EQ(sampled_hist->bin(BinID{0}), HistogramBin<int32_t>(1, 2, 6, 6));
+  EXPECT_EQ(sampled_hist->bin(BinID{1}), HistogramBin<int32_t>(5, 5, 1, 5));
+  EXPECT_FLOAT_EQ(sampled_hist->total_distinct_count(), 11.0f);
+
+  EXPECT_FALSE(EqualDistinctCountHistogram<int32_t>::from_distribution({}, 2u));
+}
+
 }  // namespace opossum
@@ -0,0 +1,104 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "sql/sql_plan_cache.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/abstract_histogram.hpp"
+#include "statistics/table_statistics.hpp"
+#include "statistics/table_statistics_maintainer.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class TableStatisticsMaintainerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // 10 rows with 8 distinct values in two immutable chunks
+    _table = load_table("resources/test_data/tbl/10_ints.tbl", 5);
+    Hyrise::get().storage_manager.add_table("table_a", _table);
+    Hyrise::get().storage_manager.add_table("table_b", load_table("resources/test_data/tbl/10_ints.tbl"));
+  }
+
+  void insert() {
+    SQLPipelineBuilder{"INSERT INTO table_a SELECT * FROM table_b"}.create_pipeline().get_result_table();
+  }
+
+  std::shared_ptr<AbstractHistogram<int32_t>> histogram() const {
+    const auto column_statistics =
+        std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(_table->table_statistics()->column_statistics[0]);
+    return column_statistics->histogram;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(TableStatisticsMaintainerTest, CreatedByStorageManager) {
+  ASSERT_TRUE(_table->statistics_maintainer());
+  EXPECT_FLOAT_EQ(_table->table_statistics()->row_count, 10.0f);
+  EXPECT_FLOAT_EQ(histogram()->total_count(), 10.0f);
+}
+
+TEST_F(TableStatisticsMaintainerTest, MergeInsertedChunks) {
+  insert();
+
+  // The inserted rows filled two new chunks, which were finalized and merged
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  for (auto chunk_id = ChunkID{2}; chunk_id < 4; ++chunk_id) {
+    const auto chunk = _table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    ASSERT_TRUE(chunk->pruning_statistics());
+
+    const auto segment_statistics =
+        std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(chunk->pruning_statistics()->at(0));
+    EXPECT_TRUE(segment_statistics->histogram);
+    EXPECT_TRUE(segment_statistics->distinct_count_sketch);
+  }
+
+  EXPECT_FLOAT_EQ(_table->table_statistics()->row_count, 20.0f);
+  EXPECT_FLOAT_EQ(histogram()->total_count(), 20.0f);
+  EXPECT_NEAR(histogram()->total_distinct_count(), 8.0f, 1.0f);
+  EXPECT_NEAR(histogram()->estimate_cardinality(PredicateCondition::Equals, 234), 6.0f, 0.5f);
+}
+
+TEST_F(TableStatisticsMaintainerTest, RowCount) {
+  const auto statistics_maintainer = _table->statistics_maintainer();
+
+  // Small changes of the row count do not require an update
+  EXPECT_FALSE(statistics_maintainer->update_row_count(1));
+  EXPECT_FLOAT_EQ(_table->table_statistics()->row_count, 10.0f);
+
+  // Recording the row count does not publish it, the update does
+  EXPECT_TRUE(statistics_maintainer->update_row_count(-4));
+  EXPECT_FLOAT_EQ(_table->table_statistics()->row_count, 10.0f);
+  TableStatisticsMaintainer::schedule_update(_table);
+  EXPECT_FLOAT_EQ(_table->table_statistics()->row_count, 7.0f);
+  EXPECT_FLOAT_EQ(histogram()->total_count(), 7.0f);
+
+  // Deletes are passed to the maintainer
+  SQLPipelineBuilder{"DELETE FROM table_a WHERE a = 234"}.create_pipeline().get_result_table();
+  EXPECT_FLOAT_EQ(_table->table_statistics()->row_count, 4.0f);
+}
+
+TEST_F(TableStatisticsMaintainerTest, InvalidateCachesOnDrift) {
+  Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
+  const auto query = std::string{"SELECT * FROM table_a WHERE a = 234"};
+  SQLPipelineBuilder{query}.create_pipeline().get_result_table();
+  EXPECT_TRUE(Hyrise::get().default_pqp_cache->has(query));
+
+  const auto statistics_epoch = TableStatisticsMaintainer::statistics_epoch();
+
+  // Doubling the row count does not exceed the DRIFT_THRESHOLD
+  insert();
+  EXPECT_EQ(TableStatisticsMaintainer::statistics_epoch(), statistics_epoch);
+  EXPECT_TRUE(Hyrise::get().default_pqp_cache->has(query));
+
+  insert();
+  EXPECT_EQ(TableStatisticsMaintainer::statistics_epoch(), statistics_epoch + 1);
+  EXPECT_FALSE(Hyrise::get().default_pqp_cache->has(query));
+}
+
+}  // namespace opossum
@@ -41,4 +41,50 @@ TEST_F(TableStatisticsTest, FromTable) {
   EXPECT_FLOAT_EQ(histogram_b->total_distinct_count(), 190);
 }
 
+TEST_F(TableStatisticsTest, FromTableSampled) {
+  // 10 chunks with 20 rows each. Every other chunk is sampled.
+  const auto table = load_table("resources/test_data/tbl/int_with_nulls_large.tbl", 20);
+
+  const auto table_statistics = TableStatistics::from_table(*table, 100);
+  ASSERT_EQ(table_statistics->row_count, 200u);
+
+  const auto column_statistics_a =
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(table_statistics->column_statistics.at(0));
+  const auto histogram_a = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(column_statistics_a->histogram);
+  ASSERT_TRUE(histogram_a);
+
+  // The sample contains 84 non-null values of column a, which are scaled to the size of the table. Most of the nine
+  // sampled distinct values occur multiple times, so the sample is assumed to contain almost all distinct values.
+  EXPECT_FLOAT_EQ(histogram_a->total_count(), 168);
+  EXPECT_FLOAT_EQ(histogram_a->total_distinct_count(), 9);
+  EXPECT_FLOAT_EQ(column_statistics_a->null_value_ratio->ratio, 1.0f - 168.0f / 200.0f);
+
+  // All 95 sampled values of column b are unique. Thus, its distinct count is scaled like the row count.
+  const auto column_statistics_b =
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(table_statistics->column_statistics.at(1));
+  const auto histogram_b = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(column_statistics_b->histogram);
+  ASSERT_TRUE(histogram_b);
+  EXPECT_FLOAT_EQ(histogram_b->total_count(), 190);
+  EXPECT_FLOAT_EQ(histogram_b->total_distinct_count(), 190);
+}
+
+TEST_F(TableStatisticsTest, SampleRowCountPerTable) {
+  const auto table = load_table("resources/test_data/tbl/int_with_nulls_large.tbl", 20);
+  table->set_statistics_sample_row_count(100);
+
+  const auto table_statistics = TableStatistics::from_table(*table);
+  const auto histogram_a = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(table_statistics->column_statistics.at(0))->histogram);
+  EXPECT_FLOAT_EQ(histogram_a->total_count(), 168);
+
+  // An explicitly given sample size overrides the one of the table
+  const auto full_table_statistics = TableStatistics::from_table(*table, 200);
+  const auto full_histogram_a = std::dynamic_pointer_cast<AbstractHistogram<int32_t>>(
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(full_table_statistics->column_statistics.at(0))
+          ->histogram);
+  EXPECT_FLOAT_EQ(full_histogram_a->total_count(), 173);
+
+  EXPECT_THROW(table->set_statistics_sample_row_count(0), std::logic_error);
+}
+
 }  // namespace opossum
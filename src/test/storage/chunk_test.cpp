@@ -224,4 +224,61 @@ TEST_F(StorageChunkTest, OrderedBy) {
   EXPECT_EQ(chunk->ordered_by(), ordered_by);
 }
 
+TEST_F(StorageChunkTest, CompactMvccData) {
+  chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}), std::make_shared<MvccData>(3, CommitID{1}));
+  const auto mvcc_data = chunk->mvcc_data();
+
+  // Only immutable chunks whose rows are visible to all transactions are compacted
+  EXPECT_FALSE(chunk->try_compact_mvcc_data(CommitID{1}));
+  chunk->finalize();
+  EXPECT_FALSE(chunk->try_compact_mvcc_data(CommitID{0}));
+
+  // Locked rows and deletes that are not visible to all transactions prevent the compaction
+  mvcc_data->set_tid(1, TransactionID{5});
+  EXPECT_FALSE(chunk->try_compact_mvcc_data(CommitID{1}));
+  EXPECT_FALSE(mvcc_data->is_compacting);
+  mvcc_data->set_end_cid(1, CommitID{2});
+  EXPECT_FALSE(chunk->try_compact_mvcc_data(CommitID{1}));
+
+  EXPECT_TRUE(chunk->try_compact_mvcc_data(CommitID{2}));
+  EXPECT_TRUE(mvcc_data->is_compacting);
+  EXPECT_FALSE(chunk->try_compact_mvcc_data(CommitID{2}));
+
+  const auto compacted_mvcc_data = chunk->mvcc_data();
+  EXPECT_NE(compacted_mvcc_data, mvcc_data);
+  EXPECT_TRUE(compacted_mvcc_data->is_compacted());
+  EXPECT_FALSE(compacted_mvcc_data->is_compacted_and_entirely_valid());
+  EXPECT_LT(compacted_mvcc_data->memory_usage(), mvcc_data->memory_usage());
+  EXPECT_EQ(compacted_mvcc_data->max_begin_cid, CommitID{1});
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 3; ++chunk_offset) {
+    EXPECT_EQ(compacted_mvcc_data->get_begin_cid(chunk_offset), CommitID{1});
+    EXPECT_EQ(compacted_mvcc_data->get_tid(chunk_offset), 0u);
+  }
+  EXPECT_EQ(compacted_mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
+  EXPECT_EQ(compacted_mvcc_data->get_end_cid(1), CommitID{2});
+  EXPECT_EQ(compacted_mvcc_data->get_end_cid(2), MvccData::MAX_COMMIT_ID);
+}
+
+TEST_F(StorageChunkTest, WriteToCompactedMvccData) {
+  chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}), std::make_shared<MvccData>(3, CommitID{0}));
+  chunk->finalize();
+  ASSERT_TRUE(chunk->try_compact_mvcc_data(CommitID{0}));
+
+  const auto mvcc_data = chunk->mvcc_data();
+  EXPECT_TRUE(mvcc_data->is_compacted_and_entirely_valid());
+
+  // Writes expand the compacted MVCC data
+  EXPECT_TRUE(mvcc_data->compare_exchange_tid(2, 0u, TransactionID{7}));
+  EXPECT_FALSE(mvcc_data->compare_exchange_tid(2, 0u, TransactionID{8}));
+  mvcc_data->set_end_cid(2, CommitID{3});
+  EXPECT_FALSE(mvcc_data->is_compacted_and_entirely_valid());
+
+  EXPECT_EQ(mvcc_data->get_tid(2), TransactionID{7});
+  EXPECT_EQ(mvcc_data->get_end_cid(2), CommitID{3});
+  EXPECT_EQ(mvcc_data->get_tid(0), 0u);
+  EXPECT_EQ(mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
+  EXPECT_EQ(mvcc_data->get_begin_cid(0), CommitID{0});
+}
+
 }  // namespace opossum
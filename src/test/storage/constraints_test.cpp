@@ -14,6 +14,8 @@
 #include "operators/table_scan.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -46,6 +48,41 @@ class ConstraintsTest : public BaseTest {
 
       table->add_soft_unique_constraint({ColumnID{0}}, IsPrimaryKey::No);
     }
+
+    {
+      TableColumnDefinitions column_definitions;
+      column_definitions.emplace_back("a", DataType::Int, false);
+      column_definitions.emplace_back("b", DataType::Int, true);
+      column_definitions.emplace_back("c", DataType::Int, false);
+      auto table = std::make_shared<Table>(column_definitions, TableType::Data, 2, UseMvcc::Yes);
+      append_committed(table, {1, 1, 1});
+      append_committed(table, {2, NullValue{}, 2});
+
+      auto& sm = Hyrise::get().storage_manager;
+      sm.add_table("table_enforced", table);
+
+      table->add_unique_constraint({ColumnID{0}}, IsPrimaryKey::Yes);
+      table->add_unique_constraint({ColumnID{2}, ColumnID{1}}, IsPrimaryKey::No);
+    }
+  }
+
+  // Appends a row that is visible to all transactions, as done by load_table
+  static void append_committed(const std::shared_ptr<Table>& table, const std::vector<AllTypeVariant>& values) {
+    table->append(values);
+    const auto chunk = table->last_chunk();
+    chunk->mvcc_data()->set_begin_cid(chunk->size() - 1, CommitID{0});
+  }
+
+  static SQLPipelineStatus execute_sql(const std::string& sql,
+                                       const std::shared_ptr<TransactionContext>& transaction_context = nullptr) {
+    auto builder = SQLPipelineBuilder{sql};
+    if (transaction_context) builder.with_transaction_context(transaction_context);
+    return builder.create_pipeline().get_result_table().first;
+  }
+
+  static size_t row_count(const std::string& table_name) {
+    auto pipeline = SQLPipelineBuilder{"SELECT * FROM " + table_name}.create_pipeline();
+    return pipeline.get_result_table().second->row_count();
   }
 };
 
@@ -82,4 +119,92 @@ TEST_F(ConstraintsTest, InvalidConstraintAdd) {
   EXPECT_THROW(table->add_soft_unique_constraint({ColumnID{0}, ColumnID{2}}, IsPrimaryKey::Yes), std::logic_error);
 }
 
+TEST_F(ConstraintsTest, EnforcedConstraintAdd) {
+  const auto table = Hyrise::get().storage_manager.get_table("table_enforced");
+
+  // Constraint column IDs are sorted and backed by a table hash index
+  const auto& constraints = table->get_soft_unique_constraints();
+  ASSERT_EQ(constraints.size(), 2);
+  EXPECT_EQ(constraints[1].columns, std::vector<ColumnID>({ColumnID{1}, ColumnID{2}}));
+  EXPECT_EQ(constraints[1].is_enforced, IsEnforced::Yes);
+  EXPECT_TRUE(table->get_table_hash_index({ColumnID{1}, ColumnID{2}}));
+
+  // Invalid because the existing rows are not unique
+  append_committed(table, {3, 1, 1});
+  EXPECT_THROW(table->add_unique_constraint({ColumnID{1}}, IsPrimaryKey::No), std::logic_error);
+
+  // Deleted rows do not count
+  EXPECT_EQ(execute_sql("DELETE FROM table_enforced WHERE a = 3"), SQLPipelineStatus::Success);
+  table->add_unique_constraint({ColumnID{0}, ColumnID{1}}, IsPrimaryKey::No);
+}
+
+TEST_F(ConstraintsTest, EnforcedConstraintInsert) {
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced SELECT a + 2, b + 2, c + 2 FROM table_enforced"),
+            SQLPipelineStatus::Success);
+
+  // Duplicate of a committed row in one of the inserted rows
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced SELECT a + 10, b, c FROM table_enforced WHERE a < 3"),
+            SQLPipelineStatus::Failure);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (4, 5, 5)"), SQLPipelineStatus::Failure);
+
+  // Duplicate within the same batch
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced SELECT a + 10, b + 10, c FROM table_enforced UNION ALL "
+                        "SELECT a + 10, b + 20, c FROM table_enforced"),
+            SQLPipelineStatus::Failure);
+
+  // Multi-column constraint: (b, c) = (1, 1) exists, (2, 1) does not, NULL keys are exempt
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (7, 1, 1)"), SQLPipelineStatus::Failure);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (7, 2, 1)"), SQLPipelineStatus::Success);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (8, NULL, 2)"), SQLPipelineStatus::Success);
+
+  EXPECT_EQ(row_count("table_enforced"), 6);
+}
+
+TEST_F(ConstraintsTest, EnforcedConstraintConcurrentInsert) {
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  const auto transaction_context_1 = transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto transaction_context_2 = transaction_manager.new_transaction_context(AutoCommit::No);
+
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (3, 3, 3)", transaction_context_1),
+            SQLPipelineStatus::Success);
+
+  // The row inserted by the first transaction is not visible to the second one, but still conflicts
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (3, 4, 4)", transaction_context_2),
+            SQLPipelineStatus::Failure);
+  EXPECT_EQ(transaction_context_2->phase(), TransactionPhase::RolledBackAfterConflict);
+
+  transaction_context_1->commit();
+  EXPECT_EQ(row_count("table_enforced"), 3);
+
+  // Rows of rolled back transactions do not conflict
+  const auto transaction_context_3 = transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (4, 4, 4)", transaction_context_3),
+            SQLPipelineStatus::Success);
+  transaction_context_3->rollback(RollbackReason::User);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (4, 4, 4)"), SQLPipelineStatus::Success);
+}
+
+TEST_F(ConstraintsTest, EnforcedConstraintUpdateAndDelete) {
+  // Updates keep the key of the updated row
+  EXPECT_EQ(execute_sql("UPDATE table_enforced SET c = 5 WHERE a = 1"), SQLPipelineStatus::Success);
+
+  // Updates must not introduce duplicates
+  EXPECT_EQ(execute_sql("UPDATE table_enforced SET a = 2 WHERE a = 1"), SQLPipelineStatus::Failure);
+  EXPECT_EQ(execute_sql("UPDATE table_enforced SET a = 3"), SQLPipelineStatus::Failure);
+
+  // Keys of deleted rows can be reused, both within the deleting transaction and afterwards
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_EQ(execute_sql("DELETE FROM table_enforced WHERE a = 1", transaction_context), SQLPipelineStatus::Success);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (1, 1, 1)", transaction_context),
+            SQLPipelineStatus::Success);
+  EXPECT_EQ(execute_sql("DELETE FROM table_enforced WHERE a = 1", transaction_context), SQLPipelineStatus::Success);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (1, 1, 1)", transaction_context),
+            SQLPipelineStatus::Success);
+  transaction_context->commit();
+
+  EXPECT_EQ(execute_sql("DELETE FROM table_enforced WHERE a = 2"), SQLPipelineStatus::Success);
+  EXPECT_EQ(execute_sql("INSERT INTO table_enforced VALUES (2, NULL, 2)"), SQLPipelineStatus::Success);
+  EXPECT_EQ(row_count("table_enforced"), 2);
+}
+
 }  // namespace opossum
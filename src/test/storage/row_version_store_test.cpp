@@ -0,0 +1,86 @@
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/mvcc_data.hpp"
+#include "storage/row_version_store.hpp"
+
+namespace opossum {
+
+class StorageRowVersionStoreTest : public BaseTest {
+ protected:
+  RowVersionStore row_versions;
+};
+
+TEST_F(StorageRowVersionStoreTest, VisibleValues) {
+  EXPECT_TRUE(row_versions.empty());
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{3}, TransactionID{1}, CommitID{0}, {{ColumnID{1}, 7}}, {}));
+  EXPECT_FALSE(row_versions.empty());
+  EXPECT_TRUE(row_versions.modifies_column(ColumnID{1}));
+  EXPECT_FALSE(row_versions.modifies_column(ColumnID{0}));
+
+  // Uncommitted versions are only visible to their transaction
+  using Values = std::vector<std::pair<ChunkOffset, AllTypeVariant>>;
+  EXPECT_EQ(row_versions.visible_values(ColumnID{1}, TransactionID{1}, CommitID{0}), (Values{{ChunkOffset{3}, 7}}));
+  EXPECT_TRUE(row_versions.visible_values(ColumnID{1}, TransactionID{2}, CommitID{0}).empty());
+  EXPECT_TRUE(row_versions.visible_values(ColumnID{1}, INVALID_TRANSACTION_ID, CommitID{5}).empty());
+
+  row_versions.commit_version(ChunkOffset{3}, TransactionID{1}, CommitID{2});
+  EXPECT_TRUE(row_versions.visible_values(ColumnID{1}, TransactionID{2}, CommitID{1}).empty());
+  EXPECT_EQ(row_versions.visible_values(ColumnID{1}, TransactionID{2}, CommitID{2}), (Values{{ChunkOffset{3}, 7}}));
+  EXPECT_TRUE(row_versions.visible_values(ColumnID{0}, TransactionID{2}, CommitID{2}).empty());
+}
+
+TEST_F(StorageRowVersionStoreTest, Conflicts) {
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{1}, CommitID{0}, {{ColumnID{0}, 1}}, {}));
+  EXPECT_FALSE(row_versions.has_conflicting_version(ChunkOffset{0}, TransactionID{1}, CommitID{0}));
+  EXPECT_TRUE(row_versions.has_conflicting_version(ChunkOffset{0}, TransactionID{2}, CommitID{0}));
+  EXPECT_FALSE(row_versions.add_version(ChunkOffset{0}, TransactionID{2}, CommitID{0}, {{ColumnID{0}, 2}}, {}));
+
+  // Versions of the same transaction are merged
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{1}, CommitID{0}, {{ColumnID{1}, 3}}, {}));
+  EXPECT_EQ(row_versions.version_count(), 1u);
+
+  row_versions.commit_version(ChunkOffset{0}, TransactionID{1}, CommitID{1});
+  EXPECT_TRUE(row_versions.has_conflicting_version(ChunkOffset{0}, TransactionID{2}, CommitID{0}));
+  EXPECT_FALSE(row_versions.has_conflicting_version(ChunkOffset{0}, TransactionID{2}, CommitID{1}));
+  EXPECT_FALSE(row_versions.has_conflicting_version(ChunkOffset{1}, TransactionID{2}, CommitID{0}));
+}
+
+TEST_F(StorageRowVersionStoreTest, RemoveVersion) {
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{1}, CommitID{0}, {{ColumnID{0}, 1}}, {}));
+  row_versions.commit_version(ChunkOffset{0}, TransactionID{1}, CommitID{1});
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{2}, CommitID{1}, {{ColumnID{0}, 2}}, {}));
+
+  // Committed versions and versions of other transactions are kept
+  row_versions.remove_version(ChunkOffset{0}, TransactionID{3});
+  row_versions.remove_version(ChunkOffset{0}, TransactionID{2});
+  row_versions.remove_version(ChunkOffset{0}, TransactionID{2});
+  EXPECT_EQ(row_versions.version_count(), 1u);
+  EXPECT_FALSE(row_versions.has_conflicting_version(ChunkOffset{0}, TransactionID{3}, CommitID{1}));
+}
+
+TEST_F(StorageRowVersionStoreTest, PruneOutdatedVersions) {
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{1}, CommitID{0}, {{ColumnID{0}, 1}}, {}));
+  row_versions.commit_version(ChunkOffset{0}, TransactionID{1}, CommitID{1});
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{2}, CommitID{1}, {{ColumnID{1}, 2}}, {}));
+  row_versions.commit_version(ChunkOffset{0}, TransactionID{2}, CommitID{2});
+
+  // A transaction with snapshot 1 is still active, so both versions are needed
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{3}, CommitID{2}, {{ColumnID{0}, 3}}, CommitID{1}));
+  EXPECT_EQ(row_versions.version_count(), 3u);
+  row_versions.commit_version(ChunkOffset{0}, TransactionID{3}, CommitID{3});
+
+  // All transactions see the second version, the first one is merged into it
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{0}, TransactionID{4}, CommitID{3}, {{ColumnID{1}, 4}}, CommitID{2}));
+  EXPECT_EQ(row_versions.version_count(), 3u);
+
+  using Values = std::vector<std::pair<ChunkOffset, AllTypeVariant>>;
+  EXPECT_EQ(row_versions.visible_values(ColumnID{0}, TransactionID{5}, CommitID{2}), (Values{{ChunkOffset{0}, 1}}));
+  EXPECT_EQ(row_versions.visible_values(ColumnID{1}, TransactionID{5}, CommitID{2}), (Values{{ChunkOffset{0}, 2}}));
+  EXPECT_EQ(row_versions.visible_values(ColumnID{0}, TransactionID{5}, CommitID{3}), (Values{{ChunkOffset{0}, 3}}));
+  EXPECT_EQ(row_versions.visible_values(ColumnID{1}, TransactionID{4}, CommitID{3}), (Values{{ChunkOffset{0}, 4}}));
+}
+
+}  // namespace opossum
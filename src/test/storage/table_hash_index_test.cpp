@@ -0,0 +1,339 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/lqp_translator.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
+#include "operators/get_table.hpp"
+#include "operators/index_scan.hpp"
+#include "operators/join_index.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/operator_task.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/index/table_hash/table_hash_index.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class TableHashIndexTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Rows: (9, 10, 11), (10, 10, 10) | (11, 10, 11), (9, 10, 9)
+    _table = load_table("resources/test_data/tbl/int_int_int.tbl", 2);
+    Hyrise::get().storage_manager.add_table("table_a", _table);
+  }
+
+  static bool pqp_contains(const std::shared_ptr<const AbstractOperator>& pqp, const OperatorType type) {
+    if (!pqp) return false;
+    if (pqp->type() == type) return true;
+    return pqp_contains(pqp->input_left(), type) || pqp_contains(pqp->input_right(), type);
+  }
+
+  static std::shared_ptr<const Table> execute_sql(const std::string& sql) {
+    auto pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    const auto [status, table] = pipeline.get_result_table();
+    EXPECT_EQ(status, SQLPipelineStatus::Success);
+    return table;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(TableHashIndexTest, Lookup) {
+  const auto index = _table->create_table_hash_index({ColumnID{0}});
+  EXPECT_EQ(index->row_count(), 4);
+  EXPECT_EQ(_table->get_table_hash_index({ColumnID{0}}), index);
+  EXPECT_FALSE(_table->get_table_hash_index({ColumnID{1}}));
+
+  auto matches = RowIDPosList{};
+  index->lookup({9}, matches);
+  EXPECT_EQ(matches, RowIDPosList({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{1}, ChunkOffset{1}}}));
+
+  // Values are casted to the column type if this is possible without loss
+  matches.clear();
+  index->lookup({int64_t{10}}, matches);
+  EXPECT_EQ(matches, RowIDPosList({RowID{ChunkID{0}, ChunkOffset{1}}}));
+
+  matches.clear();
+  index->lookup({9.5f}, matches);
+  index->lookup({NullValue{}}, matches);
+  index->lookup({12}, matches);
+  EXPECT_TRUE(matches.empty());
+
+  EXPECT_THROW(_table->create_table_hash_index({ColumnID{0}}), std::logic_error);
+}
+
+TEST_F(TableHashIndexTest, MultiColumnKeyWithNulls) {
+  const auto column_definitions =
+      TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String, false}};
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+  table->append({1, "x"});
+  table->append({NullValue{}, "y"});
+  table->append({1, "y"});
+
+  const auto index = table->create_table_hash_index({ColumnID{0}, ColumnID{1}});
+
+  // Rows with NULL keys are not indexed
+  EXPECT_EQ(index->row_count(), 2);
+
+  auto matches = RowIDPosList{};
+  index->lookup({1, "y"}, matches);
+  EXPECT_EQ(matches, RowIDPosList({RowID{ChunkID{1}, ChunkOffset{0}}}));
+
+  index->remove_chunk(ChunkID{1});
+  matches.clear();
+  index->lookup({1, "y"}, matches);
+  EXPECT_TRUE(matches.empty());
+  EXPECT_EQ(index->row_count(), 1);
+}
+
+TEST_F(TableHashIndexTest, IndexScanWithParameterAndPruning) {
+  _table->create_table_hash_index({ColumnID{0}});
+
+  const auto get_table = std::make_shared<GetTable>("table_a", std::vector<ChunkID>{},
+                                                    std::vector<ColumnID>{ColumnID{1}});
+  const auto index_scan =
+      std::make_shared<IndexScan>(get_table, std::vector<ColumnID>{ColumnID{0}},
+                                  std::vector<AllParameterVariant>{ParameterID{3}});
+  index_scan->set_parameters({{ParameterID{3}, 9}});
+  get_table->execute();
+  index_scan->execute();
+
+  const auto expected_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}, {"c", DataType::Int, false}},
+                              TableType::Data);
+  expected_table->append({9, 11});
+  expected_table->append({9, 9});
+  EXPECT_TABLE_EQ_UNORDERED(index_scan->get_output(), expected_table);
+
+  // Rows of pruned chunks are skipped
+  const auto pruned_get_table = std::make_shared<GetTable>("table_a", std::vector<ChunkID>{ChunkID{0}},
+                                                           std::vector<ColumnID>{ColumnID{1}});
+  const auto pruned_index_scan = std::make_shared<IndexScan>(pruned_get_table, std::vector<ColumnID>{ColumnID{0}},
+                                                             std::vector<AllParameterVariant>{AllTypeVariant{9}});
+  pruned_get_table->execute();
+  pruned_index_scan->execute();
+  EXPECT_EQ(pruned_index_scan->get_output()->row_count(), 1);
+}
+
+TEST_F(TableHashIndexTest, MaintainedByModifications) {
+  _table->create_table_hash_index({ColumnID{0}, ColumnID{1}});
+  const auto select = std::string{"SELECT * FROM table_a WHERE b = 10 AND a = 9"};
+
+  {
+    auto pipeline = SQLPipelineBuilder{select}.create_pipeline();
+    const auto [status, table] = pipeline.get_result_table();
+    EXPECT_EQ(status, SQLPipelineStatus::Success);
+    EXPECT_TRUE(pqp_contains(pipeline.get_physical_plans().front(), OperatorType::IndexScan));
+
+    const auto expected_table = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+    expected_table->append({9, 10, 11});
+    expected_table->append({9, 10, 9});
+    EXPECT_TABLE_EQ_UNORDERED(table, expected_table);
+  }
+
+  // An uncommitted insert is only visible to its own transaction
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  SQLPipelineBuilder{"INSERT INTO table_a VALUES (9, 10, 5)"}
+      .with_transaction_context(transaction_context)
+      .create_pipeline()
+      .get_result_table();
+  EXPECT_EQ(execute_sql(select)->row_count(), 2);
+  {
+    auto pipeline = SQLPipelineBuilder{select}.with_transaction_context(transaction_context).create_pipeline();
+    EXPECT_EQ(pipeline.get_result_table().second->row_count(), 3);
+  }
+  transaction_context->rollback(RollbackReason::User);
+  EXPECT_EQ(execute_sql(select)->row_count(), 2);
+
+  // Updated rows are found in their new version only, deleted rows not at all
+  execute_sql("UPDATE table_a SET c = 12 WHERE a = 9 AND b = 10");
+  const auto updated_table = execute_sql(select);
+  EXPECT_EQ(updated_table->row_count(), 2);
+  EXPECT_EQ(updated_table->get_value<int32_t>(ColumnID{2}, 0), 12);
+  EXPECT_EQ(updated_table->get_value<int32_t>(ColumnID{2}, 1), 12);
+
+  execute_sql("DELETE FROM table_a WHERE a = 9 AND b = 10");
+  EXPECT_EQ(execute_sql(select)->row_count(), 0);
+
+  // The index still holds all versions: 4 initial rows, the rolled back insert, and 2 updated rows
+  EXPECT_EQ(_table->get_table_hash_index({ColumnID{0}, ColumnID{1}})->row_count(), 7);
+}
+
+TEST_F(TableHashIndexTest, JoinIndex) {
+  _table->create_table_hash_index({ColumnID{0}});
+
+  const auto probe_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"x", DataType::Int, false}}, TableType::Data);
+  probe_table->append({9});
+  probe_table->append({11});
+  probe_table->append({12});
+  const auto probe_table_wrapper = std::make_shared<TableWrapper>(probe_table);
+  probe_table_wrapper->execute();
+
+  const auto join = [&](const JoinMode mode) {
+    const auto get_table = std::make_shared<GetTable>("table_a");
+    const auto join_index =
+        std::make_shared<JoinIndex>(probe_table_wrapper, get_table, mode,
+                                    OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals},
+                                    std::vector<OperatorJoinPredicate>{}, IndexSide::Right);
+    const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
+    join_index->set_transaction_context_recursively(transaction_context);
+    get_table->execute();
+    join_index->execute();
+
+    const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join_index->performance_data());
+    EXPECT_EQ(performance_data.chunks_scanned_without_index, 0);
+    return join_index->get_output();
+  };
+
+  const auto inner_join_result = join(JoinMode::Inner);
+  EXPECT_EQ(inner_join_result->row_count(), 3);
+  EXPECT_EQ(inner_join_result->column_count(), 4);
+  EXPECT_EQ(join(JoinMode::Semi)->row_count(), 2);
+  EXPECT_EQ(join(JoinMode::AntiNullAsFalse)->row_count(), 1);
+
+  // Join modes that emit unmatched index side rows fall back to the chunk indexes (here: the nested loop fallback)
+  {
+    const auto get_table = std::make_shared<GetTable>("table_a");
+    const auto join_index =
+        std::make_shared<JoinIndex>(probe_table_wrapper, get_table, JoinMode::FullOuter,
+                                    OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals},
+                                    std::vector<OperatorJoinPredicate>{}, IndexSide::Right);
+    get_table->execute();
+    join_index->execute();
+
+    const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join_index->performance_data());
+    EXPECT_EQ(performance_data.chunks_scanned_without_index, 2);
+    EXPECT_EQ(join_index->get_output()->row_count(), 5);
+  }
+
+  // Rows deleted by committed transactions are not joined
+  execute_sql("DELETE FROM table_a WHERE a = 11");
+  EXPECT_EQ(join(JoinMode::Inner)->row_count(), 2);
+  EXPECT_EQ(join(JoinMode::AntiNullAsFalse)->row_count(), 2);
+}
+
+TEST_F(TableHashIndexTest, IndexScanTranslationWithoutMatchingIndex) {
+  // E.g., the LQP was optimized for a table that had a table hash index on (a, b)
+  const auto stored_table_node = StoredTableNode::make("table_a");
+  const auto predicate_node =
+      PredicateNode::make(and_(equals_(stored_table_node->get_column("a"), 9),
+                               equals_(stored_table_node->get_column("b"), 10)),
+                          stored_table_node);
+  predicate_node->scan_type = ScanType::IndexScan;
+
+  const auto pqp = LQPTranslator{}.translate_node(predicate_node);
+  EXPECT_EQ(pqp->type(), OperatorType::TableScan);
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(pqp));
+  EXPECT_EQ(pqp->get_output()->row_count(), 2);
+}
+
+TEST_F(TableHashIndexTest, UpdateInPlace) {
+  // The rows are stored in a single mutable chunk, so that the non-indexed columns are updated in place
+  const auto table = load_table("resources/test_data/tbl/int_int_int.tbl", Chunk::DEFAULT_SIZE, FinalizeLastChunk::No);
+  table->set_update_mode(UpdateMode::InPlace);
+  table->create_table_hash_index({ColumnID{0}});
+  Hyrise::get().storage_manager.drop_table("table_a");
+  Hyrise::get().storage_manager.add_table("table_a", table);
+
+  const auto probe_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"x", DataType::Int, false}}, TableType::Data);
+  probe_table->append({11});
+  const auto probe_table_wrapper = std::make_shared<TableWrapper>(probe_table);
+  probe_table_wrapper->execute();
+
+  const auto select = [&](const std::shared_ptr<TransactionContext>& transaction_context) {
+    auto pipeline = SQLPipelineBuilder{"SELECT c FROM table_a WHERE a = 11"}
+                        .with_transaction_context(transaction_context)
+                        .create_pipeline();
+    const auto [status, result_table] = pipeline.get_result_table();
+    EXPECT_TRUE(pqp_contains(pipeline.get_physical_plans().front(), OperatorType::IndexScan));
+    EXPECT_EQ(result_table->row_count(), 1);
+    return result_table->get_value<int32_t>(ColumnID{0}, 0);
+  };
+
+  const auto join = [&](const std::shared_ptr<TransactionContext>& transaction_context) {
+    const auto get_table = std::make_shared<GetTable>("table_a");
+    const auto join_index =
+        std::make_shared<JoinIndex>(probe_table_wrapper, get_table, JoinMode::Inner,
+                                    OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals},
+                                    std::vector<OperatorJoinPredicate>{}, IndexSide::Right);
+    join_index->set_transaction_context_recursively(transaction_context);
+    get_table->execute();
+    join_index->execute();
+
+    const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join_index->performance_data());
+    EXPECT_EQ(performance_data.chunks_scanned_without_index, 0);
+    EXPECT_EQ(join_index->get_output()->row_count(), 1);
+    return join_index->get_output()->get_value<int32_t>(ColumnID{3}, 0);
+  };
+
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  const auto update_transaction_context = transaction_manager.new_transaction_context(AutoCommit::No);
+  SQLPipelineBuilder{"UPDATE table_a SET c = 12 WHERE a = 11"}
+      .with_transaction_context(update_transaction_context)
+      .create_pipeline()
+      .get_result_table();
+  EXPECT_EQ(table->row_count(), 4);
+
+  // The updating transaction sees its own update, other transactions the previous value
+  EXPECT_EQ(select(update_transaction_context), 12);
+  EXPECT_EQ(join(update_transaction_context), 12);
+  EXPECT_EQ(select(transaction_manager.new_transaction_context(AutoCommit::No)), 11);
+  EXPECT_EQ(join(transaction_manager.new_transaction_context(AutoCommit::No)), 11);
+
+  update_transaction_context->commit();
+  EXPECT_EQ(select(transaction_manager.new_transaction_context(AutoCommit::No)), 12);
+  EXPECT_EQ(join(transaction_manager.new_transaction_context(AutoCommit::No)), 12);
+}
+
+TEST_F(TableHashIndexTest, JoinIndexTranslation) {
+  const auto probe_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"x", DataType::Int, false}}, TableType::Data);
+  probe_table->append({9});
+  probe_table->append({11});
+  probe_table->append({12});
+  Hyrise::get().storage_manager.add_table("table_b", probe_table);
+
+  execute_sql("DELETE FROM table_a WHERE a = 11");
+
+  const auto join = [&]() {
+    const auto probe_node = StoredTableNode::make("table_b");
+    const auto stored_table_node = StoredTableNode::make("table_a");
+    const auto join_node = JoinNode::make(JoinMode::Inner, equals_(probe_node->get_column("x"),
+                                                                   stored_table_node->get_column("a")),
+                                          probe_node, ValidateNode::make(stored_table_node));
+    join_node->table_hash_index_side = IndexSide::Right;
+
+    const auto pqp = LQPTranslator{}.translate_node(join_node);
+    pqp->set_transaction_context_recursively(
+        Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes));
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(pqp));
+    return pqp;
+  };
+
+  // Without the table hash index, the ValidateNode is kept and a regular join is used
+  const auto regular_join = join();
+  EXPECT_FALSE(pqp_contains(regular_join, OperatorType::JoinIndex));
+  EXPECT_TRUE(pqp_contains(regular_join, OperatorType::Validate));
+  EXPECT_EQ(regular_join->get_output()->row_count(), 2);
+
+  // The JoinIndex skips the deleted row when probing the table hash index
+  _table->create_table_hash_index({ColumnID{0}});
+  const auto index_join = join();
+  EXPECT_TRUE(pqp_contains(index_join, OperatorType::JoinIndex));
+  EXPECT_FALSE(pqp_contains(index_join, OperatorType::Validate));
+  EXPECT_EQ(index_join->get_output()->row_count(), 2);
+}
+
+}  // namespace opossum
@@ -14,6 +14,7 @@
 #include "utils/meta_tables/meta_segments_table.hpp"
 #include "utils/meta_tables/meta_settings_table.hpp"
 #include "utils/meta_tables/meta_tables_table.hpp"
+#include "utils/meta_tables/meta_transactions_table.hpp"
 
 namespace opossum {
 
@@ -28,7 +29,7 @@ class MetaTableManagerTest : public BaseTest {
             std::make_shared<MetaChunksTable>(),   std::make_shared<MetaChunkSortOrdersTable>(),
             std::make_shared<MetaSegmentsTable>(), std::make_shared<MetaSegmentsAccurateTable>(),
             std::make_shared<MetaPluginsTable>(),  std::make_shared<MetaSettingsTable>(),
-            std::make_shared<MetaLogTable>()};
+            std::make_shared<MetaLogTable>(),      std::make_shared<MetaTransactionsTable>()};
   }
 
   static MetaTableNames meta_table_names() {
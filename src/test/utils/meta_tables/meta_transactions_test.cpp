@@ -0,0 +1,54 @@
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "utils/meta_tables/meta_transactions_table.hpp"
+
+namespace opossum {
+
+class MetaTransactionsTest : public BaseTest {
+ protected:
+  void SetUp() { meta_transactions_table = std::make_shared<MetaTransactionsTable>(); }
+
+  void TearDown() { Hyrise::reset(); }
+
+  const std::shared_ptr<Table> generate_meta_table() const { return meta_transactions_table->_on_generate(); }
+
+  std::shared_ptr<MetaTransactionsTable> meta_transactions_table;
+};
+
+TEST_F(MetaTransactionsTest, IsImmutable) {
+  EXPECT_FALSE(meta_transactions_table->can_insert());
+  EXPECT_FALSE(meta_transactions_table->can_update());
+  EXPECT_FALSE(meta_transactions_table->can_delete());
+}
+
+TEST_F(MetaTransactionsTest, TableGeneration) {
+  const auto column_definitions = TableColumnDefinitions{{"committed", DataType::Long, false},
+                                                         {"rolled_back_by_user", DataType::Long, false},
+                                                         {"rolled_back_after_conflict", DataType::Long, false},
+                                                         {"abort_rate", DataType::Double, false},
+                                                         {"lock_waits", DataType::Long, false},
+                                                         {"failed_lock_waits", DataType::Long, false}};
+  EXPECT_EQ(meta_transactions_table->column_definitions(), column_definitions);
+
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  for (auto transaction_idx = 0; transaction_idx < 3; ++transaction_idx) {
+    transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  }
+  transaction_manager.new_transaction_context(AutoCommit::No)->rollback(RollbackReason::Conflict);
+  transaction_manager.register_lock_wait(true);
+  transaction_manager.register_lock_wait(false);
+
+  const auto meta_table = generate_meta_table();
+  EXPECT_EQ(meta_table->row_count(), 1);
+
+  const auto values = meta_table->get_row(0);
+  EXPECT_EQ(values[0], AllTypeVariant{int64_t{3}});
+  EXPECT_EQ(values[1], AllTypeVariant{int64_t{0}});
+  EXPECT_EQ(values[2], AllTypeVariant{int64_t{1}});
+  EXPECT_EQ(values[3], AllTypeVariant{0.25});
+  EXPECT_EQ(values[4], AllTypeVariant{int64_t{2}});
+  EXPECT_EQ(values[5], AllTypeVariant{int64_t{1}});
+}
+
+}  // namespace opossum